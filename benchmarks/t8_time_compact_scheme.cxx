@@ -0,0 +1,193 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+#include <sc_flops.h>
+#include <sc_options.h>
+#include <sc_statistics.h>
+
+#include <t8.h>
+#include <t8_cmesh.h>
+#include <t8_eclass.h>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_forest/t8_forest_general.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+
+/* This file compares the default scheme to the compact scheme, which stores
+ * quads and hexes as a single 64-bit key. For both schemes the same forest is
+ * built from a uniform forest by refining and coarsening along the space-filling
+ * curve and its ghost layer is created. We report the memory used by the leaf
+ * elements and the runtime of the adaptation and of the ghost creation.
+ */
+
+/* The level up to which the elements are refined, passed as user data. */
+typedef struct
+{
+  int max_level;
+} t8_time_compact_adapt_data_t;
+
+/* Refine the first and the last child of each family up to the maximum level.
+ * The criterion only uses the scheme, so that the runtime is dominated by the
+ * element operations. */
+static int
+t8_time_compact_refine (t8_forest_t forest, t8_forest_t forest_from, t8_locidx_t which_tree, t8_locidx_t lelement_id,
+                        t8_eclass_scheme_c *ts, const int is_family, const int num_elements, t8_element_t *elements[])
+{
+  const t8_time_compact_adapt_data_t *data = (const t8_time_compact_adapt_data_t *) t8_forest_get_user_data (forest);
+  const int level = ts->t8_element_level (elements[0]);
+  const int child_id = ts->t8_element_child_id (elements[0]);
+
+  if (level < data->max_level && (child_id == 0 || child_id == ts->t8_element_num_siblings (elements[0]) - 1)) {
+    return 1;
+  }
+  return 0;
+}
+
+/* Coarsen each family whose first element is a descendant of the first child of its tree. */
+static int
+t8_time_compact_coarsen (t8_forest_t forest, t8_forest_t forest_from, t8_locidx_t which_tree, t8_locidx_t lelement_id,
+                         t8_eclass_scheme_c *ts, const int is_family, const int num_elements, t8_element_t *elements[])
+{
+  if (is_family && ts->t8_element_level (elements[0]) > 1 && ts->t8_element_ancestor_id (elements[0], 1) == 0) {
+    return -1;
+  }
+  return 0;
+}
+
+static void
+t8_time_compact_scheme (t8_eclass_t eclass, int level, int refine_levels, int num_trees)
+{
+  const char *scheme_names[2] = { "default", "compact" };
+  sc_statinfo_t stats[6];
+  t8_gloidx_t num_elements[2];
+
+  t8_global_productionf ("Comparing schemes for %s elements of level %i with %i additional levels.\n",
+                         t8_eclass_to_string[eclass], level, refine_levels);
+
+  for (int ischeme = 0; ischeme < 2; ischeme++) {
+    t8_scheme_cxx_t *scheme = ischeme == 0 ? t8_scheme_new_default_cxx () : t8_scheme_new_compact_cxx ();
+    t8_cmesh_t cmesh = t8_cmesh_new_bigmesh (eclass, num_trees, sc_MPI_COMM_WORLD);
+    t8_forest_t forest = t8_forest_new_uniform (cmesh, scheme, level, 0, sc_MPI_COMM_WORLD);
+    t8_time_compact_adapt_data_t data = { level + refine_levels };
+    sc_flopinfo_t fi, snapshot;
+
+    /* Refine recursively and coarsen again */
+    sc_flops_start (&fi);
+    sc_flops_snap (&fi, &snapshot);
+    forest = t8_forest_new_adapt (forest, t8_time_compact_refine, 1, 0, &data);
+    forest = t8_forest_new_adapt (forest, t8_time_compact_coarsen, 0, 0, &data);
+    sc_flops_shot (&fi, &snapshot);
+    sc_stats_set1 (&stats[3 * ischeme], snapshot.iwtime, ischeme == 0 ? "Default adapt" : "Compact adapt");
+
+    /* Partition, then create the ghost layer of a copy of the partitioned forest */
+    t8_forest_t forest_partition;
+    t8_forest_init (&forest_partition);
+    t8_forest_set_partition (forest_partition, forest, 0);
+    t8_forest_commit (forest_partition);
+    t8_forest_t forest_ghost;
+    t8_forest_init (&forest_ghost);
+    t8_forest_set_copy (forest_ghost, forest_partition);
+    t8_forest_set_ghost (forest_ghost, 1, T8_GHOST_FACES);
+    sc_flops_snap (&fi, &snapshot);
+    t8_forest_commit (forest_ghost);
+    sc_flops_shot (&fi, &snapshot);
+    sc_stats_set1 (&stats[3 * ischeme + 1], snapshot.iwtime, ischeme == 0 ? "Default ghost" : "Compact ghost");
+
+    /* The memory of the leaf elements */
+    const t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest_ghost, eclass);
+    const t8_locidx_t num_local = t8_forest_get_local_num_elements (forest_ghost);
+    const t8_locidx_t num_ghosts = t8_forest_get_num_ghosts (forest_ghost);
+    sc_stats_set1 (&stats[3 * ischeme + 2], (double) (num_local + num_ghosts) * ts->t8_element_size (),
+                   ischeme == 0 ? "Default element bytes" : "Compact element bytes");
+    num_elements[ischeme] = t8_forest_get_global_num_elements (forest_ghost);
+    t8_global_productionf ("The %s forest has %lli global elements of %zd bytes each.\n", scheme_names[ischeme],
+                           (long long) num_elements[ischeme], ts->t8_element_size ());
+
+    t8_forest_unref (&forest_ghost);
+  }
+  /* Both schemes must produce the same forest. */
+  SC_CHECK_ABORT (num_elements[0] == num_elements[1], "The default and the compact forest differ.");
+
+  sc_stats_compute (sc_MPI_COMM_WORLD, 6, stats);
+  sc_stats_print (t8_get_package_id (), SC_LP_STATISTICS, 6, stats, 1, 1);
+}
+
+int
+main (int argc, char **argv)
+{
+  char usage[BUFSIZ];
+  /* brief help message */
+  int sreturnA = snprintf (usage, BUFSIZ,
+                           "Usage:\t%s <OPTIONS>\n\t%s -h\t"
+                           "for a brief overview of all options.",
+                           basename (argv[0]), basename (argv[0]));
+
+  char help[BUFSIZ];
+  /* long help message */
+  int sreturnB = snprintf (help, BUFSIZ,
+                           "Compare memory usage and adapt and ghost runtimes of the default and the compact "
+                           "scheme for quads and hexes.\n\n%s\n",
+                           usage);
+
+  if (sreturnA > BUFSIZ || sreturnB > BUFSIZ) {
+    /* The usage string or help message was truncated */
+    /* Note: gcc >= 7.1 prints a warning if we
+     * do not check the return value of snprintf. */
+    t8_debugf ("Warning: Truncated usage string and help message to '%s' and '%s'\n", usage, help);
+  }
+
+  int mpiret = sc_MPI_Init (&argc, &argv);
+  SC_CHECK_MPI (mpiret);
+
+  sc_init (sc_MPI_COMM_WORLD, 1, 1, NULL, SC_LP_ESSENTIAL);
+  t8_init (SC_LP_DEFAULT);
+
+  int helpme;
+  int level;
+  int refine_levels;
+  int num_trees;
+
+  /* initialize command line argument parser */
+  sc_options_t *opt = sc_options_new (argv[0]);
+  sc_options_add_switch (opt, 'h', "help", &helpme, "Display a short help message.");
+  sc_options_add_int (opt, 'l', "level", &level, 4, "The uniform refinement level of the initial forest. Default: 4");
+  sc_options_add_int (opt, 'r', "refine", &refine_levels, 4, "The number of additional refinement levels. Default: 4");
+  sc_options_add_int (opt, 't', "trees", &num_trees, 4, "The number of trees of the coarse mesh. Default: 4");
+
+  int parsed = sc_options_parse (t8_get_package_id (), SC_LP_ERROR, opt, argc, argv);
+
+  if (parsed >= 0 && !helpme && level >= 0 && refine_levels >= 0 && num_trees > 0) {
+    t8_time_compact_scheme (T8_ECLASS_QUAD, level, refine_levels, num_trees);
+    t8_time_compact_scheme (T8_ECLASS_HEX, level, refine_levels, num_trees);
+  }
+  else {
+    /* Display help message and usage. */
+    t8_global_productionf ("%s\n", help);
+    sc_options_print_usage (t8_get_package_id (), SC_LP_ERROR, opt, NULL);
+  }
+
+  sc_options_destroy (opt);
+  sc_finalize ();
+
+  mpiret = sc_MPI_Finalize ();
+  SC_CHECK_MPI (mpiret);
+
+  return 0;
+}
@@ -0,0 +1,169 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+#include <sc_flops.h>
+#include <sc_options.h>
+#include <sc_statistics.h>
+
+#include <t8.h>
+#include <t8_cmesh.h>
+#include <t8_eclass.h>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_forest/t8_forest_general.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+/* This file measures the construction of a uniform forest with an increasing
+ * number of threads per process. For each number of threads the same uniform
+ * forest is committed and we report the runtime and the number of elements
+ * created per second on each process.
+ */
+
+/* Commit a uniform forest of the given level with num_threads threads and return the runtime. */
+static double
+t8_time_new_uniform (t8_cmesh_t cmesh, t8_scheme_cxx_t *scheme, const int level, const int num_threads,
+                     t8_locidx_t *num_local_elements)
+{
+  sc_flopinfo_t fi, snapshot;
+  t8_forest_t forest;
+
+  t8_cmesh_ref (cmesh);
+  t8_scheme_cxx_ref (scheme);
+  t8_forest_init (&forest);
+  t8_forest_set_cmesh (forest, cmesh, sc_MPI_COMM_WORLD);
+  t8_forest_set_scheme (forest, scheme);
+  t8_forest_set_level (forest, level);
+  t8_forest_set_num_threads (forest, num_threads);
+
+  sc_flops_start (&fi);
+  sc_flops_snap (&fi, &snapshot);
+  t8_forest_commit (forest);
+  sc_flops_shot (&fi, &snapshot);
+
+  *num_local_elements = t8_forest_get_local_num_elements (forest);
+  t8_global_productionf ("Constructed uniform forest with %lli global elements using %i threads.\n",
+                         (long long) t8_forest_get_global_num_elements (forest), num_threads);
+  t8_forest_unref (&forest);
+  return snapshot.iwtime;
+}
+
+static void
+t8_time_new_uniform_threads (t8_eclass_t eclass, const int level, const int num_trees, const int max_threads)
+{
+  t8_cmesh_t cmesh = t8_cmesh_new_bigmesh (eclass, num_trees, sc_MPI_COMM_WORLD);
+  t8_scheme_cxx_t *scheme = t8_scheme_new_default_cxx ();
+
+  /* Use 1, 2, 4, ... threads and max_threads threads. */
+  std::vector<int> thread_counts;
+  for (int num_threads = 1; num_threads < max_threads; num_threads *= 2) {
+    thread_counts.push_back (num_threads);
+  }
+  thread_counts.push_back (max_threads);
+
+  const int num_stats = 2 * thread_counts.size ();
+  std::vector<sc_statinfo_t> stats (num_stats);
+  std::vector<std::string> names (num_stats);
+  for (size_t icount = 0; icount < thread_counts.size (); icount++) {
+    t8_locidx_t num_local_elements;
+    const double runtime = t8_time_new_uniform (cmesh, scheme, level, thread_counts[icount], &num_local_elements);
+    names[2 * icount] = "New uniform " + std::to_string (thread_counts[icount]) + " threads";
+    names[2 * icount + 1] = "Elements/s " + std::to_string (thread_counts[icount]) + " threads";
+    sc_stats_set1 (&stats[2 * icount], runtime, names[2 * icount].c_str ());
+    sc_stats_set1 (&stats[2 * icount + 1], runtime > 0 ? num_local_elements / runtime : 0,
+                   names[2 * icount + 1].c_str ());
+  }
+
+  sc_stats_compute (sc_MPI_COMM_WORLD, num_stats, stats.data ());
+  sc_stats_print (t8_get_package_id (), SC_LP_STATISTICS, num_stats, stats.data (), 1, 1);
+
+  t8_scheme_cxx_unref (&scheme);
+  t8_cmesh_destroy (&cmesh);
+}
+
+int
+main (int argc, char **argv)
+{
+  char usage[BUFSIZ];
+  /* brief help message */
+  int sreturnA = snprintf (usage, BUFSIZ,
+                           "Usage:\t%s <OPTIONS>\n\t%s -h\t"
+                           "for a brief overview of all options.",
+                           basename (argv[0]), basename (argv[0]));
+
+  char help[BUFSIZ];
+  /* long help message */
+  int sreturnB = snprintf (help, BUFSIZ,
+                           "Measure the runtime and the elements per second of the construction of a "
+                           "uniform forest with an increasing number of threads per process.\n\n%s\n",
+                           usage);
+
+  if (sreturnA > BUFSIZ || sreturnB > BUFSIZ) {
+    /* The usage string or help message was truncated */
+    /* Note: gcc >= 7.1 prints a warning if we
+     * do not check the return value of snprintf. */
+    t8_debugf ("Warning: Truncated usage string and help message to '%s' and '%s'\n", usage, help);
+  }
+
+  int mpiret = sc_MPI_Init (&argc, &argv);
+  SC_CHECK_MPI (mpiret);
+
+  sc_init (sc_MPI_COMM_WORLD, 1, 1, NULL, SC_LP_ESSENTIAL);
+  t8_init (SC_LP_DEFAULT);
+
+  int helpme;
+  int level;
+  int num_trees;
+  int max_threads;
+  int eclass_int;
+
+  /* initialize command line argument parser */
+  sc_options_t *opt = sc_options_new (argv[0]);
+  sc_options_add_switch (opt, 'h', "help", &helpme, "Display a short help message.");
+  sc_options_add_int (opt, 'l', "level", &level, 6, "The uniform refinement level of the forest. Default: 6");
+  sc_options_add_int (opt, 't', "trees", &num_trees, 1, "The number of trees of the coarse mesh. Default: 1");
+  sc_options_add_int (opt, 'e', "elements", &eclass_int, T8_ECLASS_HEX,
+                      "The element class of the coarse mesh, see t8_eclass_t. Default: hex");
+  sc_options_add_int (opt, 'T', "threads", &max_threads, SC_MAX (1, (int) std::thread::hardware_concurrency ()),
+                      "The maximum number of threads. Default: the number of hardware threads");
+
+  int parsed = sc_options_parse (t8_get_package_id (), SC_LP_ERROR, opt, argc, argv);
+
+  if (parsed >= 0 && !helpme && level >= 0 && num_trees > 0 && max_threads > 0 && T8_ECLASS_ZERO <= eclass_int
+      && eclass_int < T8_ECLASS_COUNT) {
+    t8_time_new_uniform_threads ((t8_eclass_t) eclass_int, level, num_trees, max_threads);
+  }
+  else {
+    /* Display help message and usage. */
+    t8_global_productionf ("%s\n", help);
+    sc_options_print_usage (t8_get_package_id (), SC_LP_ERROR, opt, NULL);
+  }
+
+  sc_options_destroy (opt);
+  sc_finalize ();
+
+  mpiret = sc_MPI_Finalize ();
+  SC_CHECK_MPI (mpiret);
+
+  return 0;
+}
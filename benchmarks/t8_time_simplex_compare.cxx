@@ -0,0 +1,170 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+#include <sc_flops.h>
+#include <sc_options.h>
+#include <sc_statistics.h>
+
+#include <t8.h>
+#include <t8_cmesh.h>
+#include <t8_eclass.h>
+#include <t8_element_c_interface.h>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_forest/t8_forest_general.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+
+/* This file benchmarks `t8_element_compare` for triangles and tetrahedra.
+ * The leaves of a uniform forest are compared pairwise, once with neighboring
+ * leaves along the space-filling curve and once with pseudo-random pairs.
+ * As a reference, the same comparisons are carried out by computing the
+ * linear ids of both elements on the maximum level, which is how the
+ * elements used to be compared.
+ */
+
+/* Compare two elements via their linear ids on the maximum refinement level. */
+static int
+t8_time_compare_by_linear_id (const t8_eclass_scheme_c *ts, const t8_element_t *elem1, const t8_element_t *elem2,
+                              const int maxlevel)
+{
+  const t8_linearidx_t id1 = t8_element_get_linear_id (ts, elem1, maxlevel);
+  const t8_linearidx_t id2 = t8_element_get_linear_id (ts, elem2, maxlevel);
+  if (id1 == id2) {
+    return t8_element_level (ts, elem1) - t8_element_level (ts, elem2);
+  }
+  return id1 < id2 ? -1 : 1;
+}
+
+static void
+t8_time_simplex_compare (t8_eclass_t eclass, int level, int num_repetitions)
+{
+  t8_cmesh_t cmesh = t8_cmesh_new_hypercube (eclass, sc_MPI_COMM_WORLD, 0, 0, 0);
+  t8_forest_t forest = t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), level, 0, sc_MPI_COMM_WORLD);
+
+  const t8_locidx_t num_trees = t8_forest_get_num_local_trees (forest);
+  const t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, eclass);
+  const int maxlevel = t8_element_maxlevel (ts);
+
+  t8_global_productionf ("Comparing %s elements of level %i, %i repetitions.\n", t8_eclass_to_string[eclass], level,
+                         num_repetitions);
+
+  sc_flopinfo_t fi, snapshot;
+  sc_statinfo_t stats[4];
+  /* Sum up the results so that the compiler cannot drop the comparisons. */
+  long checksum[4] = { 0, 0, 0, 0 };
+
+  for (int ivariant = 0; ivariant < 4; ivariant++) {
+    const int use_linear_id = ivariant % 2;
+    const int random_pairs = ivariant / 2;
+    sc_flops_start (&fi);
+    sc_flops_snap (&fi, &snapshot);
+    for (int irep = 0; irep < num_repetitions; irep++) {
+      for (t8_locidx_t itree = 0; itree < num_trees; itree++) {
+        const t8_locidx_t num_elements = t8_forest_get_tree_num_elements (forest, itree);
+        /* A linear congruential generator, restarted for every tree so that all variants see the same pairs. */
+        unsigned long state = 1;
+        for (t8_locidx_t ielem = 0; ielem + 1 < num_elements; ielem++) {
+          t8_locidx_t other = ielem + 1;
+          if (random_pairs) {
+            state = state * 6364136223846793005UL + 1442695040888963407UL;
+            other = (t8_locidx_t) ((state >> 33) % (unsigned long) num_elements);
+          }
+          const t8_element_t *elem1 = t8_forest_get_element_in_tree (forest, itree, ielem);
+          const t8_element_t *elem2 = t8_forest_get_element_in_tree (forest, itree, other);
+          checksum[ivariant] += use_linear_id ? t8_time_compare_by_linear_id (ts, elem1, elem2, maxlevel)
+                                              : t8_element_compare (ts, elem1, elem2);
+        }
+      }
+    }
+    sc_flops_shot (&fi, &snapshot);
+    sc_stats_set1 (&stats[ivariant], snapshot.iwtime,
+                   ivariant == 0   ? "Compare neighbors"
+                   : ivariant == 1 ? "Compare neighbors by linear id"
+                   : ivariant == 2 ? "Compare random pairs"
+                                   : "Compare random pairs by linear id");
+  }
+  /* Both comparisons must agree in sign, which for the sums means they are equal. */
+  SC_CHECK_ABORT (checksum[0] == checksum[1] && checksum[2] == checksum[3], "Element comparisons do not agree.");
+
+  sc_stats_compute (sc_MPI_COMM_WORLD, 4, stats);
+  sc_stats_print (t8_get_package_id (), SC_LP_STATISTICS, 4, stats, 1, 1);
+
+  t8_forest_unref (&forest);
+}
+
+int
+main (int argc, char **argv)
+{
+  char usage[BUFSIZ];
+  /* brief help message */
+  int sreturnA = snprintf (usage, BUFSIZ,
+                           "Usage:\t%s <OPTIONS>\n\t%s -h\t"
+                           "for a brief overview of all options.",
+                           basename (argv[0]), basename (argv[0]));
+
+  char help[BUFSIZ];
+  /* long help message */
+  int sreturnB = snprintf (help, BUFSIZ, "Profile `t8_element_compare` for triangles and tetrahedra.\n\n%s\n", usage);
+
+  if (sreturnA > BUFSIZ || sreturnB > BUFSIZ) {
+    /* The usage string or help message was truncated */
+    /* Note: gcc >= 7.1 prints a warning if we
+     * do not check the return value of snprintf. */
+    t8_debugf ("Warning: Truncated usage string and help message to '%s' and '%s'\n", usage, help);
+  }
+
+  int mpiret = sc_MPI_Init (&argc, &argv);
+  SC_CHECK_MPI (mpiret);
+
+  sc_init (sc_MPI_COMM_WORLD, 1, 1, NULL, SC_LP_ESSENTIAL);
+  t8_init (SC_LP_DEFAULT);
+
+  int helpme;
+  int level;
+  int num_repetitions;
+
+  /* initialize command line argument parser */
+  sc_options_t *opt = sc_options_new (argv[0]);
+  sc_options_add_switch (opt, 'h', "help", &helpme, "Display a short help message.");
+  sc_options_add_int (opt, 'l', "level", &level, 6, "The uniform refinement level of the forests. Default: 6");
+  sc_options_add_int (opt, 'r', "repetitions", &num_repetitions, 10,
+                      "How often each comparison is repeated. Default: 10");
+
+  int parsed = sc_options_parse (t8_get_package_id (), SC_LP_ERROR, opt, argc, argv);
+
+  if (parsed >= 0 && !helpme && level >= 0 && num_repetitions > 0) {
+    t8_time_simplex_compare (T8_ECLASS_TRIANGLE, level, num_repetitions);
+    t8_time_simplex_compare (T8_ECLASS_TET, level, num_repetitions);
+  }
+  else {
+    /* Display help message and usage. */
+    t8_global_productionf ("%s\n", help);
+    sc_options_print_usage (t8_get_package_id (), SC_LP_ERROR, opt, NULL);
+  }
+
+  sc_options_destroy (opt);
+  sc_finalize ();
+
+  mpiret = sc_MPI_Finalize ();
+  SC_CHECK_MPI (mpiret);
+
+  return 0;
+}
@@ -102,7 +102,7 @@ t8_forest_construct_from_vtk (const char *prefix, sc_MPI_Comm comm, const int va
 
   /* Write the forest */
   snprintf (out_file, BUFSIZ - 7, "%s_forest", out_prefix);
-  t8_forest_write_vtk_ext (forest, out_file, 1, 1, 1, 1, 1, 0, 1, values_per_cell, vtk_data);
+  t8_forest_write_vtk_ext (forest, out_file, 1, 1, 1, 1, 1, 0, 1, 0, values_per_cell, vtk_data);
 
   /* Free the cell-data */
   if (values_per_cell > 0) {
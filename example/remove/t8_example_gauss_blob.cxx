@@ -91,7 +91,7 @@ t8_output_data_to_vtu (t8_forest_t forest, double *data, const char *prefix)
   int write_element_id = 1;
   int write_ghosts = 0;
   t8_forest_write_vtk_ext (forest, prefix, write_treeid, write_mpirank, write_level, write_element_id, write_ghosts, 0,
-                           0, num_data, &vtk_data);
+                           0, 0, num_data, &vtk_data);
 }
 
 /* Refine, if element is within a given radius. */
@@ -132,6 +132,14 @@ typedef enum {
   T8_MPI_PARTITION_FOREST,              /**< Used for forest partitioning */
   T8_MPI_GHOST_FOREST,                  /**< Used for for ghost layer creation */
   T8_MPI_GHOST_EXC_FOREST,              /**< Used for ghost data exchange */
+  T8_MPI_CMESH_READ_MSH_FILE,           /**< Used for reading .msh files in parallel */
+  T8_MPI_LOCATE_POINTS,                 /**< Used for sending points to their candidate owners */
+  T8_MPI_LOCATE_POINTS_RESULT,          /**< Used for returning the located points */
+  T8_MPI_CMESH_JOIN_FACES,              /**< Used for sending tree faces to the owners of their keys */
+  T8_MPI_CMESH_JOIN_RESULT,             /**< Used for returning the face connections */
+  T8_MPI_CMESH_REORDER,                 /**< Used for reordering a cmesh along a space-filling curve */
+  T8_MPI_GHOST_HALO,                    /**< Used for growing the ghost layer to a larger width */
+  T8_MPI_VERTEX_NUMBERING,              /**< Used for computing the global vertex numbering of a forest */
   T8_MPI_TEST_ELEMENT_PACK_TAG,         /**< Used for testing mpi pack and unpack functionality */
   T8_MPI_TAG_LAST
 } t8_MPI_tag_t;
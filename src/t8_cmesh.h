@@ -342,6 +342,26 @@ t8_cmesh_set_join (t8_cmesh_t cmesh, t8_gloidx_t gtree1, t8_gloidx_t gtree2, int
 void
 t8_cmesh_set_profiling (t8_cmesh_t cmesh, int set_profiling);
 
+/** Store the trees of a replicated cmesh once per node in shared memory.
+ * After commit, the processes of a node hold read-only views on the same trees,
+ * face neighbors and attributes, such that the memory of the cmesh scales with
+ * the number of nodes rather than with the number of processes.
+ * \param [in,out] cmesh          The cmesh to be updated.
+ * \param [in]     set_shmem      If true, the trees are stored in shared memory, if false
+ *                                each process stores its own copy.
+ *
+ * This is disabled by default and has no effect on partitioned cmeshes.
+ * The cmesh must not be committed before calling this function.
+ * The trees of a committed shared cmesh must not be modified.
+ * The communicator used to commit the cmesh must be valid until the cmesh is destroyed
+ * and destroying the cmesh is MPI collective.
+ * The setting is kept by \ref t8_cmesh_bcast, which then broadcasts
+ * a committed cmesh directly into the shared memory of each node.
+ * \see t8_cmesh_uses_shared_memory
+ */
+void
+t8_cmesh_set_shared_memory (t8_cmesh_t cmesh, int set_shmem);
+
 /* returns true if cmesh_a equals cmesh_b */
 /* TODO: document
  * collective or serial */
@@ -388,6 +408,7 @@ t8_cmesh_bcast (t8_cmesh_t cmesh_in, int root, sc_MPI_Comm comm);
 #ifdef T8_WITH_METIS
 /* TODO: document this. */
 /* TODO: think about making this a pre-commit set_reorder function. */
+/* For a reordering without METIS see t8_cmesh_new_reorder_sfc in t8_cmesh/t8_cmesh_reorder.h. */
 void
 t8_cmesh_reorder (t8_cmesh_t cmesh, sc_MPI_Comm comm);
 
@@ -461,6 +482,16 @@ t8_cmesh_comm_is_valid (t8_cmesh_t cmesh, sc_MPI_Comm comm);
 int
 t8_cmesh_is_partitioned (t8_cmesh_t cmesh);
 
+/** Query whether the trees of a committed cmesh are stored in shared memory.
+ * \param [in] cmesh       A committed cmesh.
+ * \return                 True if the trees of \a cmesh are stored once per node.
+ *                         False otherwise.
+ * \a cmesh must be committed before calling this function.
+ * \see t8_cmesh_set_shared_memory
+ */
+int
+t8_cmesh_uses_shared_memory (t8_cmesh_t cmesh);
+
 /** Return the global number of trees in a cmesh.
  * \param [in] cmesh       The cmesh to be considered.
  * \return                 The number of trees associated to \a cmesh.
@@ -621,6 +621,14 @@ t8_cmesh_set_profiling (t8_cmesh_t cmesh, int set_profiling)
   }
 }
 
+void
+t8_cmesh_set_shared_memory (t8_cmesh_t cmesh, int set_shmem)
+{
+  T8_ASSERT (t8_cmesh_is_initialized (cmesh));
+
+  cmesh->set_shmem = set_shmem != 0;
+}
+
 /* returns true if cmesh_a equals cmesh_b */
 int
 t8_cmesh_is_equal (t8_cmesh_t cmesh_a, t8_cmesh_t cmesh_b)
@@ -765,6 +773,7 @@ t8_cmesh_bcast (t8_cmesh_t cmesh_in, int root, sc_MPI_Comm comm)
     cmesh_out->face_knowledge = meta_info.cmesh.face_knowledge;
     cmesh_out->set_partition = meta_info.cmesh.set_partition;
     cmesh_out->set_partition_level = meta_info.cmesh.set_partition_level;
+    cmesh_out->set_shmem = meta_info.cmesh.set_shmem;
     cmesh_out->num_trees = meta_info.cmesh.num_trees;
     cmesh_out->num_local_trees = cmesh_out->num_trees;
     cmesh_out->first_tree = 0;
@@ -926,6 +935,14 @@ t8_cmesh_is_partitioned (t8_cmesh_t cmesh)
   return cmesh->set_partition != 0;
 }
 
+int
+t8_cmesh_uses_shared_memory (t8_cmesh_t cmesh)
+{
+  T8_ASSERT (t8_cmesh_is_committed (cmesh));
+
+  return cmesh->trees != NULL && cmesh->trees->shmem != NULL;
+}
+
 t8_gloidx_t
 t8_cmesh_get_num_trees (t8_cmesh_t cmesh)
 {
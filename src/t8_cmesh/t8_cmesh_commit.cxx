@@ -562,6 +562,11 @@ t8_cmesh_commit (t8_cmesh_t cmesh, sc_MPI_Comm comm)
   }
   cmesh->committed = 1;
 
+  if (cmesh->set_shmem && !cmesh->set_partition) {
+    /* Store the trees of the replicated cmesh once per node */
+    t8_cmesh_trees_share (cmesh->trees, cmesh->num_trees, -1, comm);
+  }
+
   /* Compute trees_per_eclass */
   t8_cmesh_gather_trees_per_eclass (cmesh, comm);
 
@@ -31,200 +31,410 @@
 #include <t8_cmesh/t8_cmesh_types.h>
 #include <t8_cmesh/t8_cmesh_stash.h>
 #include <t8_cmesh/t8_cmesh_helpers.h>
+#include <algorithm>
+#include <thread>
+#include <tuple>
 #include <vector>
-#include <map>
 
-void
-t8_cmesh_set_join_by_vertices (t8_cmesh_t cmesh, const t8_gloidx_t ntrees, const t8_eclass_t *eclasses,
-                               const double *vertices, int **connectivity, const int do_both_directions)
-{
-  /* If `connectivity` is NULL then the following array gets freed at the end of this routine. */
-  int *conn = T8_ALLOC (int, ntrees *T8_ECLASS_MAX_FACES * 3);
-  for (int i = 0; i < ntrees * T8_ECLASS_MAX_FACES * 3; i++) {
-    conn[i] = -1;
-  }
+/* The number of bins per coordinate direction used to quantize the vertices. */
+#define T8_CMESH_JOIN_NUM_BINS 1073741824.0 /* 2^30 */
 
-  /* Compute minimum and maximum of the cmesh domain. */
-  double min_coord = vertices[0];
-  double max_coord = vertices[0];
-
-  for (int itree = 0; itree < ntrees; itree++) {
-    const t8_eclass_t eclass = eclasses[itree];
-    const int nverts = t8_eclass_num_vertices[eclass];
-    const int edim = t8_eclass_to_dimension[eclass];
+/* Two vertices are identified if all their coordinates differ by less than this tolerance. */
+#define T8_CMESH_JOIN_TOLERANCE (10.0 * T8_PRECISION_EPS)
 
+/* A face of a tree together with its vertices.
+ * Each vertex coordinate is quantized to a bin. If the coordinate lies closer than
+ * T8_CMESH_JOIN_TOLERANCE to the boundary of its bin, an equal vertex of another face
+ * might lie in the neighboring bin, which is stored as well. */
+typedef struct
+{
+  t8_gloidx_t tree;                                 /* The global id of the tree. */
+  uint64_t hash;                                    /* The hash of the quantized vertices. */
+  double coords[T8_ECLASS_MAX_CORNERS_2D][3];       /* The coordinates of the face vertices. */
+  uint32_t vertices[T8_ECLASS_MAX_CORNERS_2D][3];   /* The quantized face vertices. */
+  int8_t neighbor_bin[T8_ECLASS_MAX_CORNERS_2D][3]; /* -1 or +1 if the coordinate lies close to the lower or
+                                                       upper bin boundary, 0 otherwise. */
+  int8_t face;                                      /* The face number in the tree. */
+  int8_t eclass;                                    /* The eclass of the tree. */
+  int8_t num_vertices;                              /* The number of vertices of the face. */
+  int8_t num_ambiguous;                             /* The number of coordinates close to a bin boundary. */
+} t8_cmesh_join_face_t;
+
+/* A face-to-face connection found by the owner of the face key. */
+typedef struct
+{
+  t8_gloidx_t tree;       /* The tree of the face that comes later in the tree order. */
+  t8_gloidx_t neigh_tree; /* The tree of the face that comes first in the tree order. */
+  int face;
+  int neigh_face;
+  int orientation;
+} t8_cmesh_join_result_t;
+
+/* Compute the bounding interval of all coordinates of the given trees. */
+static void
+t8_cmesh_join_bounds (const t8_gloidx_t ntrees, const t8_eclass_t *eclasses, const double *vertices, double *min_coord,
+                      double *max_coord)
+{
+  for (t8_gloidx_t itree = 0; itree < ntrees; itree++) {
+    const int nverts = t8_eclass_num_vertices[eclasses[itree]];
     for (int ivert = 0; ivert < nverts; ivert++) {
-      for (int icoord = 0; icoord < edim; icoord++) {
+      for (int icoord = 0; icoord < T8_ECLASS_MAX_DIM; icoord++) {
         const double coord
           = vertices[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_CORNERS, T8_ECLASS_MAX_DIM, itree, ivert, icoord)];
+        *min_coord = SC_MIN (*min_coord, coord);
+        *max_coord = SC_MAX (*max_coord, coord);
+      }
+    }
+  }
+}
 
-        if (coord < min_coord) {
-          min_coord = coord;
-        }
+/* Mix the bits of a 64-bit integer (the finalizer of splitmix64). */
+static inline uint64_t
+t8_cmesh_join_mix (uint64_t x)
+{
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
 
-        if (coord > max_coord) {
-          max_coord = coord;
+/* Compute a key of a face from its quantized vertices. The ambiguous coordinates whose bit
+ * is set in mask are moved to their neighboring bin. Mask 0 gives the key of the face itself,
+ * the other masks the keys under which faces with equal vertices might be stored.
+ * The vertices are sorted, such that the key does not depend on their order. */
+static uint64_t
+t8_cmesh_join_face_hash (const t8_cmesh_join_face_t *face, const unsigned mask)
+{
+  uint32_t vertices[T8_ECLASS_MAX_CORNERS_2D][3];
+  int iambiguous = 0;
+
+  for (int ivert = 0; ivert < face->num_vertices; ivert++) {
+    for (int icoord = 0; icoord < T8_ECLASS_MAX_DIM; icoord++) {
+      vertices[ivert][icoord] = face->vertices[ivert][icoord];
+      if (face->neighbor_bin[ivert][icoord] != 0) {
+        if ((mask >> iambiguous) & 1) {
+          vertices[ivert][icoord] += face->neighbor_bin[ivert][icoord];
         }
+        iambiguous++;
       }
     }
   }
+  /* Sort the vertices lexicographically (insertion sort on at most 4) */
+  for (int i = 1; i < face->num_vertices; i++) {
+    for (int j = i;
+         j > 0 && std::lexicographical_compare (vertices[j], vertices[j] + 3, vertices[j - 1], vertices[j - 1] + 3);
+         j--) {
+      std::swap_ranges (vertices[j], vertices[j] + 3, vertices[j - 1]);
+    }
+  }
+  uint64_t hash = face->num_vertices;
+  for (int ivert = 0; ivert < face->num_vertices; ivert++) {
+    for (int icoord = 0; icoord < T8_ECLASS_MAX_DIM; icoord++) {
+      hash = t8_cmesh_join_mix (hash ^ vertices[ivert][icoord]);
+    }
+  }
+  return hash;
+}
 
-  /* Setup hash table `faces` mapping a hash key to a pair containing `(itree, iface)`. */
-  std::multimap<unsigned long, std::pair<int, int>> faces;
-
-  /* `num_bins` should be more than enough for (almost) all cases.
-   * I.e., 2^P4EST_QMAXLEVEL =~ 1.073e9.
-   */
-  const double num_bins = 1e9; /* Number of bins. */
-  const double inverse_bin_size = num_bins / (max_coord - min_coord);
+/* Call key_fn (key) for each key under which a face with the same vertices as face might be stored,
+ * except for the key of face itself. */
+template <typename F>
+static void
+t8_cmesh_join_face_neighbor_keys (const t8_cmesh_join_face_t *face, F key_fn)
+{
+  for (unsigned mask = 1; mask < (1u << face->num_ambiguous); mask++) {
+    key_fn (t8_cmesh_join_face_hash (face, mask));
+  }
+}
 
-  for (int itree = 0; itree < ntrees; itree++) {
+/* Compute the faces of the trees first_local ... last_local - 1 and store them starting at faces.
+ * The trees have the global ids tree_offset + itree. */
+static void
+t8_cmesh_join_compute_faces (const t8_gloidx_t ntrees, const t8_eclass_t *eclasses, const double *vertices,
+                             const t8_gloidx_t tree_offset, const t8_gloidx_t first_local, const t8_gloidx_t last_local,
+                             const double min_coord, const double bin_size, t8_cmesh_join_face_t *faces)
+{
+  size_t iface_total = 0;
+  for (t8_gloidx_t itree = first_local; itree < last_local; itree++) {
     const t8_eclass_t eclass = eclasses[itree];
-
-    /* Get the number of faces of this element. */
     const int nfaces = t8_eclass_num_faces[eclass];
 
-    /* Loop over all faces of the current cmesh element. */
     for (int iface = 0; iface < nfaces; iface++) {
-      /* Get the number of vertices per face of this element. */
+      t8_cmesh_join_face_t *face = faces + iface_total++;
       const int nface_verts = t8_eclass_num_vertices[t8_eclass_face_types[eclass][iface]];
 
-      /* Compute the hash key. The idea is to convert the rescaled vertices of a tree face to
-       * long integers and add them up. We apply a bit of seeding by also adding `icoord`. See below. */
-      unsigned long hash = 0;
-
-      /* Loop over the vertices of the current element's face. */
+      memset (face, 0, sizeof (t8_cmesh_join_face_t));
+      face->tree = tree_offset + itree;
+      face->face = iface;
+      face->eclass = eclass;
+      face->num_vertices = nface_verts;
+      /* Quantize the face vertices */
       for (int iface_vert = 0; iface_vert < nface_verts; iface_vert++) {
-        /* Map from a face vertex id to the element vertex id. */
         const int ivert = t8_face_vertex_to_tree_vertex[eclass][iface][iface_vert];
-
         for (int icoord = 0; icoord < T8_ECLASS_MAX_DIM; icoord++) {
           const int index = T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_CORNERS, T8_ECLASS_MAX_DIM, itree, ivert, icoord);
-          const double rescaled = (vertices[index] - min_coord) * inverse_bin_size;
-
-          /* Simple hash function. */
-          hash = hash + icoord + static_cast<unsigned long> (rescaled + 0.5);
+          const double scaled = (vertices[index] - min_coord) / bin_size + 0.5;
+          const uint32_t bin = (uint32_t) scaled;
+          face->coords[iface_vert][icoord] = vertices[index];
+          face->vertices[iface_vert][icoord] = bin;
+          /* Since the bins are larger than twice the tolerance, at most one neighboring bin is close. */
+          if ((scaled - bin) * bin_size < T8_CMESH_JOIN_TOLERANCE && bin > 0) {
+            face->neighbor_bin[iface_vert][icoord] = -1;
+            face->num_ambiguous++;
+          }
+          else if ((bin + 1 - scaled) * bin_size < T8_CMESH_JOIN_TOLERANCE) {
+            face->neighbor_bin[iface_vert][icoord] = 1;
+            face->num_ambiguous++;
+          }
         }
       }
+      face->hash = t8_cmesh_join_face_hash (face, 0);
+    }
+  }
+}
 
-      /* Loop over all pre-registered faces with the same hash. */
-      auto range = faces.equal_range (hash);
-      for (auto it = range.first; it != range.second; ++it) {
-        /* Query potentially neighboring `itree` and `iface`. */
-        const int neigh_itree = std::get<0> (it->second);
-        const int neigh_iface = std::get<1> (it->second);
+/* Compute the faces of all given trees, using up to num_threads threads.
+ * The faces are ordered by tree and face number. */
+static void
+t8_cmesh_join_faces_from_trees (const t8_gloidx_t ntrees, const t8_eclass_t *eclasses, const double *vertices,
+                                const t8_gloidx_t tree_offset, const double min_coord, const double max_coord,
+                                const int num_threads, std::vector<t8_cmesh_join_face_t> &faces)
+{
+  /* The bins are at least twice as large as the tolerance, see t8_cmesh_join_compute_faces. */
+  const double bin_size = SC_MAX ((max_coord - min_coord) / T8_CMESH_JOIN_NUM_BINS, 4 * T8_CMESH_JOIN_TOLERANCE);
+  std::vector<size_t> face_offsets (ntrees + 1, 0);
 
-        /* Retrieve the potentially neighboring element class. */
-        const t8_eclass_t neigh_eclass = eclasses[neigh_itree];
+  for (t8_gloidx_t itree = 0; itree < ntrees; itree++) {
+    face_offsets[itree + 1] = face_offsets[itree] + t8_eclass_num_faces[eclasses[itree]];
+  }
+  faces.resize (face_offsets[ntrees]);
+
+  /* Each thread computes the faces of a contiguous range of trees. */
+  const int used_threads = (int) SC_MAX (1, SC_MIN ((t8_gloidx_t) num_threads, ntrees));
+  std::vector<std::thread> threads;
+  for (int ithread = 0; ithread < used_threads; ithread++) {
+    const t8_gloidx_t first = ntrees * ithread / used_threads;
+    const t8_gloidx_t last = ntrees * (ithread + 1) / used_threads;
+    auto compute = [&, first, last] () {
+      t8_cmesh_join_compute_faces (ntrees, eclasses, vertices, tree_offset, first, last, min_coord, bin_size,
+                                   faces.data () + face_offsets[first]);
+    };
+    if (ithread + 1 < used_threads) {
+      threads.emplace_back (compute);
+    }
+    else {
+      compute ();
+    }
+  }
+  for (auto &thread : threads) {
+    thread.join ();
+  }
+}
 
-        /* Get the number of vertices per face of potentially neighboring element. */
-        const int neigh_nface_verts = t8_eclass_num_vertices[t8_eclass_face_types[neigh_eclass][neigh_iface]];
+/* Return true if two faces consist of the same vertices up to T8_CMESH_JOIN_TOLERANCE.
+ * If vertex_map is not NULL, it is filled with the face vertex of face2 that equals each face vertex of face1. */
+static inline int
+t8_cmesh_join_faces_equal (const t8_cmesh_join_face_t *face1, const t8_cmesh_join_face_t *face2, int *vertex_map)
+{
+  if (face1->num_vertices != face2->num_vertices) {
+    return 0;
+  }
+  for (int ivert = 0; ivert < face1->num_vertices; ivert++) {
+    int ineigh_vert = 0;
+    for (; ineigh_vert < face2->num_vertices; ineigh_vert++) {
+      int icoord = 0;
+      while (icoord < T8_ECLASS_MAX_DIM
+             && fabs (face1->coords[ivert][icoord] - face2->coords[ineigh_vert][icoord]) < T8_CMESH_JOIN_TOLERANCE) {
+        icoord++;
+      }
+      if (icoord == T8_ECLASS_MAX_DIM) {
+        break;
+      }
+    }
+    if (ineigh_vert == face2->num_vertices) {
+      return 0;
+    }
+    if (vertex_map != NULL) {
+      vertex_map[ivert] = ineigh_vert;
+    }
+  }
+  return 1;
+}
 
-        /* If the number of face vertices do not match we can skip. */
-        if (nface_verts != neigh_nface_verts) {
-          continue;
-        }
+/* Find all pairs of faces with the same vertices. For each face, the first face before it
+ * with the same vertices is its neighbor. The pairs (face, neighbor) are returned in
+ * the order of the faces.
+ * Only the keys k with k % mpisize == mpirank are handled, the faces stored under other keys
+ * are matched by other processes. The keys are split into num_threads parts. The faces of each
+ * part are sorted into a bucket first, which is then matched by one thread using an
+ * open-addressing hash table with linear probing. The faces with vertices close to a bin boundary
+ * are additionally looked up under the keys of the neighboring bins. */
+static void
+t8_cmesh_join_match_faces (const std::vector<t8_cmesh_join_face_t> &faces, const int num_threads, const int mpirank,
+                           const int mpisize, std::vector<std::pair<size_t, size_t>> &matches)
+{
+  const int used_threads = (int) SC_MAX (1, SC_MIN ((size_t) num_threads, faces.size () / 1024 + 1));
+  /* The lower bits of a key select the owner process, thus the part and the slot use the upper bits. */
+  auto key_part = [used_threads] (const uint64_t key) -> int { return (key >> 32) % used_threads; };
+
+  /* Sort the faces into the buckets of the threads. Each face is stored under its own key,
+   * and searched for under the keys of the neighboring bins. */
+  std::vector<std::vector<size_t>> part_faces (used_threads);
+  std::vector<std::vector<std::pair<size_t, uint64_t>>> part_queries (used_threads);
+  for (size_t iface = 0; iface < faces.size (); iface++) {
+    const t8_cmesh_join_face_t *face = &faces[iface];
+    if (face->hash % mpisize == (uint64_t) mpirank) {
+      part_faces[key_part (face->hash)].push_back (iface);
+    }
+    t8_cmesh_join_face_neighbor_keys (face, [&] (const uint64_t key) {
+      if (key % mpisize == (uint64_t) mpirank) {
+        part_queries[key_part (key)].emplace_back (iface, key);
+      }
+    });
+  }
 
-        /* The order of the encountered face vertices is needed for computing
-         * the orientation later on. Prepare the array for that here. */
-        int face_vert_order[T8_ECLASS_MAX_EDGES_2D];
-        for (int i = 0; i < T8_ECLASS_MAX_EDGES_2D; i++) {
-          face_vert_order[i] = -1;
+  std::vector<std::vector<std::pair<size_t, size_t>>> thread_matches (used_threads);
+  std::vector<std::thread> threads;
+  for (int ithread = 0; ithread < used_threads; ithread++) {
+    auto match = [&, ithread] () {
+      int capacity_bits = 4;
+      while (((size_t) 1 << capacity_bits) < 2 * part_faces[ithread].size ()) {
+        capacity_bits++;
+      }
+      /* Each slot stores the index of a face plus one, zero marks an empty slot. */
+      std::vector<size_t> table ((size_t) 1 << capacity_bits, 0);
+      const size_t mask = table.size () - 1;
+      auto first_slot = [capacity_bits] (const uint64_t key) -> size_t {
+        return (key * 0x9e3779b97f4a7c15ULL) >> (64 - capacity_bits);
+      };
+      /* The faces are inserted in their order, thus the stored face comes first. */
+      for (const size_t iface : part_faces[ithread]) {
+        const t8_cmesh_join_face_t *face = &faces[iface];
+        size_t slot = first_slot (face->hash);
+        while (table[slot] != 0 && !t8_cmesh_join_faces_equal (&faces[table[slot] - 1], face, NULL)) {
+          slot = (slot + 1) & mask;
         }
-
-        int match_count = 0; /* This tracks the number of matching vertices. */
-        /* Loop over the vertices of the current element's face. */
-        for (int iface_vert = 0; iface_vert < nface_verts; iface_vert++) {
-          /* Map from a face vertex id to the element vertex id. */
-          const int ivert = t8_face_vertex_to_tree_vertex[eclass][iface][iface_vert];
-
-          /* Loop over the vertices of the potentially neighboring element's face. */
-          for (int neigh_iface_vert = 0; neigh_iface_vert < neigh_nface_verts; neigh_iface_vert++) {
-            /* Map from a face vertex id to the element vertex id. */
-            const int neigh_ivert = t8_face_vertex_to_tree_vertex[neigh_eclass][neigh_iface][neigh_iface_vert];
-
-            int match_count_per_coord = 0; /* Tracks the matching of x, y and z coordinates of two vertices. */
-            for (int icoord = 0; icoord < T8_ECLASS_MAX_DIM; icoord++) {
-              /* Retrieve the x, y or z component of the face vertex
-               * coordinate from the vertices array. */
-
-              const double face_vert
-                = vertices[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_CORNERS, T8_ECLASS_MAX_DIM, itree, ivert, icoord)];
-              const double neigh_face_vert = vertices[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_CORNERS, T8_ECLASS_MAX_DIM,
-                                                                   neigh_itree, neigh_ivert, icoord)];
-
-              /* Compare the coordinates with some tolerance. */
-              if (fabs (face_vert - neigh_face_vert) < 10.0 * T8_PRECISION_EPS) {
-                match_count_per_coord++;
-              }
-            }
-
-            /* In case all x, y and z components match we increase the match_count variable. */
-            if (match_count_per_coord == T8_ECLASS_MAX_DIM) {
-              match_count++;
-              /* Store the encountered face vertex order for later use. */
-              face_vert_order[iface_vert] = neigh_iface_vert;
-              continue;
-            }
-          }
+        if (table[slot] == 0) {
+          table[slot] = iface + 1;
         }
-
-        /* If the number of matching face vertices is equal to the actual number of the face's vertices
-         * we interpret this as a face-to-face connection between two elements. */
-        if (match_count == nface_verts) {
-          /* Compute the orientation of the face-to-face connection.
-           * Face corner 0 of the face with the lower face direction connects
-           * to a corner of the other face. The number of this corner is the
-           * orientation code. */
-          int orientation = -1;
-          int smaller_bigger_face_condition = -1;
-
-          const int compare = t8_eclass_compare (eclass, neigh_eclass);
-          if (compare < 0) {
-            /* This tree class is smaller than neigh. tree class. */
-            smaller_bigger_face_condition = 1;
-          }
-          else if (compare > 0) {
-            /* This tree class is bigger than neigh. tree class. */
-            smaller_bigger_face_condition = 0;
-          }
-          else {
-            /* This tree class is the same as the neigh. tree class. 
-               Then the face with the smaller face id is the smaller one. */
-            smaller_bigger_face_condition = iface < neigh_iface;
+        else {
+          thread_matches[ithread].emplace_back (iface, table[slot] - 1);
+        }
+      }
+      /* Search the faces close to a bin boundary under the keys of the neighboring bins. */
+      for (const auto &query : part_queries[ithread]) {
+        const size_t iface = query.first;
+        for (size_t slot = first_slot (query.second); table[slot] != 0; slot = (slot + 1) & mask) {
+          const size_t ineigh = table[slot] - 1;
+          if (ineigh < iface && t8_cmesh_join_faces_equal (&faces[ineigh], &faces[iface], NULL)) {
+            thread_matches[ithread].emplace_back (iface, ineigh);
+            break;
           }
+        }
+      }
+    };
+    if (ithread + 1 < used_threads) {
+      threads.emplace_back (match);
+    }
+    else {
+      match ();
+    }
+  }
+  for (auto &thread : threads) {
+    thread.join ();
+  }
 
-          if (smaller_bigger_face_condition) {
-            orientation = face_vert_order[0];
-          }
-          else {
-            for (int iface_vert = 0; iface_vert < nface_verts; iface_vert++) {
-              if (0 == face_vert_order[iface_vert]) {
-                orientation = iface_vert;
-                break;
-              }
-            }
-          }
+  /* Keep the first neighbor of each face. */
+  matches.clear ();
+  for (const auto &part : thread_matches) {
+    matches.insert (matches.end (), part.begin (), part.end ());
+  }
+  std::sort (matches.begin (), matches.end ());
+  matches.erase (std::unique (matches.begin (), matches.end (),
+                              [] (const std::pair<size_t, size_t> &match1, const std::pair<size_t, size_t> &match2) {
+                                return match1.first == match2.first;
+                              }),
+                 matches.end ());
+}
 
-          /* Store the results. */
-          conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, itree, iface, 0)] = neigh_itree;
-          conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, itree, iface, 1)] = neigh_iface;
-          conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, itree, iface, 2)] = orientation;
+/* Compute the orientation of the connection of a face to the earlier neighbor face with the same vertices.
+ * Face corner 0 of the face with the lower face direction connects to a corner of the other face.
+ * The number of this corner is the orientation code. */
+static int
+t8_cmesh_join_orientation (const t8_cmesh_join_face_t *face, const t8_cmesh_join_face_t *neigh)
+{
+  /* The face vertex of neigh that matches each face vertex of face */
+  int face_vert_order[T8_ECLASS_MAX_CORNERS_2D];
+  const int equal = t8_cmesh_join_faces_equal (face, neigh, face_vert_order);
+  T8_ASSERT (equal);
+  (void) equal;
+
+  int smaller_bigger_face_condition;
+  const int compare = t8_eclass_compare ((t8_eclass_t) face->eclass, (t8_eclass_t) neigh->eclass);
+  if (compare < 0) {
+    /* This tree class is smaller than neigh. tree class. */
+    smaller_bigger_face_condition = 1;
+  }
+  else if (compare > 0) {
+    /* This tree class is bigger than neigh. tree class. */
+    smaller_bigger_face_condition = 0;
+  }
+  else {
+    /* This tree class is the same as the neigh. tree class.
+       Then the face with the smaller face id is the smaller one. */
+    smaller_bigger_face_condition = face->face < neigh->face;
+  }
 
-          if (do_both_directions) {
-            conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, neigh_itree, neigh_iface, 0)] = itree;
-            conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, neigh_itree, neigh_iface, 1)] = iface;
-            conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, neigh_itree, neigh_iface, 2)] = orientation;
-          }
+  if (smaller_bigger_face_condition) {
+    return face_vert_order[0];
+  }
+  for (int iface_vert = 0; iface_vert < face->num_vertices; iface_vert++) {
+    if (0 == face_vert_order[iface_vert]) {
+      return iface_vert;
+    }
+  }
+  return -1;
+}
 
-          break;
-        }
-      } /* Loop over faces with identical hash. */
+void
+t8_cmesh_set_join_by_vertices (t8_cmesh_t cmesh, const t8_gloidx_t ntrees, const t8_eclass_t *eclasses,
+                               const double *vertices, int **connectivity, const int do_both_directions)
+{
+  /* If `connectivity` is NULL then the following array gets freed at the end of this routine. */
+  int *conn = T8_ALLOC (int, ntrees *T8_ECLASS_MAX_FACES * 3);
+  for (int i = 0; i < ntrees * T8_ECLASS_MAX_FACES * 3; i++) {
+    conn[i] = -1;
+  }
 
-      /* Register the current pair of `itree` and `iface` with given `hash` in the hash table. */
-      faces.insert (std::make_pair (hash, std::make_pair (itree, iface)));
-    } /* Loop over faces. */
-  }   /* Loop over trees. */
+  /* Compute minimum and maximum of the cmesh domain. */
+  double min_coord = ntrees > 0 ? vertices[0] : 0;
+  double max_coord = min_coord;
+  t8_cmesh_join_bounds (ntrees, eclasses, vertices, &min_coord, &max_coord);
+
+  /* Compute the keys of all faces and find the faces with the same vertices. */
+  std::vector<t8_cmesh_join_face_t> faces;
+  std::vector<std::pair<size_t, size_t>> matches;
+  t8_cmesh_join_faces_from_trees (ntrees, eclasses, vertices, 0, min_coord, max_coord, 1, faces);
+  t8_cmesh_join_match_faces (faces, 1, 0, 1, matches);
+
+  for (const auto &match : matches) {
+    const t8_cmesh_join_face_t *face = &faces[match.first];
+    const t8_cmesh_join_face_t *neigh = &faces[match.second];
+    const int orientation = t8_cmesh_join_orientation (face, neigh);
+
+    /* Store the results. */
+    conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, face->tree, face->face, 0)] = neigh->tree;
+    conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, face->tree, face->face, 1)] = neigh->face;
+    conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, face->tree, face->face, 2)] = orientation;
+
+    if (do_both_directions) {
+      conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, neigh->tree, neigh->face, 0)] = face->tree;
+      conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, neigh->tree, neigh->face, 1)] = face->face;
+      conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, neigh->tree, neigh->face, 2)] = orientation;
+    }
+  }
 
   /* Transfer the computed face connectivity to the `cmesh` object. */
   if (cmesh != NULL) {
@@ -253,6 +463,205 @@ t8_cmesh_set_join_by_vertices (t8_cmesh_t cmesh, const t8_gloidx_t ntrees, const
   }
 }
 
+void
+t8_cmesh_set_join_by_vertices_parallel (t8_cmesh_t cmesh, const t8_gloidx_t first_tree,
+                                        const t8_locidx_t num_local_trees, const t8_eclass_t *eclasses,
+                                        const double *vertices, t8_gloidx_t **connectivity, const int num_threads,
+                                        sc_MPI_Comm comm)
+{
+  int mpisize, mpirank, mpiret;
+
+  T8_ASSERT (num_threads >= 1);
+  T8_ASSERT (num_local_trees >= 0);
+  mpiret = sc_MPI_Comm_size (comm, &mpisize);
+  SC_CHECK_MPI (mpiret);
+  mpiret = sc_MPI_Comm_rank (comm, &mpirank);
+  SC_CHECK_MPI (mpiret);
+
+  /* The first global tree of each process, to find the owner of a tree. */
+  std::vector<t8_gloidx_t> tree_offsets (mpisize + 1);
+  mpiret = sc_MPI_Allgather ((void *) &first_tree, 1, T8_MPI_GLOIDX, tree_offsets.data (), 1, T8_MPI_GLOIDX, comm);
+  SC_CHECK_MPI (mpiret);
+  const t8_gloidx_t last_tree = first_tree + num_local_trees;
+  mpiret = sc_MPI_Allreduce ((void *) &last_tree, &tree_offsets[mpisize], 1, T8_MPI_GLOIDX, sc_MPI_MAX, comm);
+  SC_CHECK_MPI (mpiret);
+
+  /* The bounds of all coordinates of all processes. We negate the minimum to compute both with one reduction. */
+  double local_bounds[2] = { -1e300, -1e300 }, bounds[2];
+  if (num_local_trees > 0) {
+    double min_coord = vertices[0], max_coord = vertices[0];
+    t8_cmesh_join_bounds (num_local_trees, eclasses, vertices, &min_coord, &max_coord);
+    local_bounds[0] = -min_coord;
+    local_bounds[1] = max_coord;
+  }
+  mpiret = sc_MPI_Allreduce (local_bounds, bounds, 2, sc_MPI_DOUBLE, sc_MPI_MAX, comm);
+  SC_CHECK_MPI (mpiret);
+
+  /* Compute the keys of the local faces and send each face to the owner of its key. Faces with vertices
+   * close to a bin boundary are also sent to the owners of the keys of the neighboring bins. */
+  std::vector<t8_cmesh_join_face_t> local_faces;
+  t8_cmesh_join_faces_from_trees (num_local_trees, eclasses, vertices, first_tree, -bounds[0], bounds[1], num_threads,
+                                  local_faces);
+  std::vector<int> send_counts (mpisize, 0), recv_counts (mpisize), send_offsets (mpisize + 1, 0),
+    recv_offsets (mpisize + 1, 0);
+  /* The receivers of each face, stored as pairs (rank, face index) and sorted by rank. */
+  std::vector<std::pair<int, size_t>> face_receivers;
+  for (size_t iface = 0; iface < local_faces.size (); iface++) {
+    const size_t first_receiver = face_receivers.size ();
+    face_receivers.emplace_back (local_faces[iface].hash % mpisize, iface);
+    t8_cmesh_join_face_neighbor_keys (&local_faces[iface], [&] (const uint64_t key) {
+      face_receivers.emplace_back (key % mpisize, iface);
+    });
+    /* Send each face at most once to each process */
+    std::sort (face_receivers.begin () + first_receiver, face_receivers.end ());
+    face_receivers.erase (std::unique (face_receivers.begin () + first_receiver, face_receivers.end ()),
+                          face_receivers.end ());
+  }
+  std::stable_sort (face_receivers.begin (), face_receivers.end (),
+                    [] (const std::pair<int, size_t> &receiver1, const std::pair<int, size_t> &receiver2) {
+                      return receiver1.first < receiver2.first;
+                    });
+  std::vector<t8_cmesh_join_face_t> send_faces (face_receivers.size ());
+  for (size_t isend = 0; isend < face_receivers.size (); isend++) {
+    send_counts[face_receivers[isend].first]++;
+    send_faces[isend] = local_faces[face_receivers[isend].second];
+  }
+  for (int irank = 0; irank < mpisize; irank++) {
+    send_offsets[irank + 1] = send_offsets[irank] + send_counts[irank];
+  }
+  face_receivers.clear ();
+  face_receivers.shrink_to_fit ();
+  local_faces.clear ();
+  local_faces.shrink_to_fit ();
+  mpiret = sc_MPI_Alltoall (send_counts.data (), 1, sc_MPI_INT, recv_counts.data (), 1, sc_MPI_INT, comm);
+  SC_CHECK_MPI (mpiret);
+  for (int irank = 0; irank < mpisize; irank++) {
+    recv_offsets[irank + 1] = recv_offsets[irank] + recv_counts[irank];
+  }
+
+  std::vector<t8_cmesh_join_face_t> faces (recv_offsets[mpisize]);
+  std::vector<sc_MPI_Request> requests;
+  const int face_size = sizeof (t8_cmesh_join_face_t);
+  for (int irank = 0; irank < mpisize; irank++) {
+    if (recv_counts[irank] > 0) {
+      requests.emplace_back ();
+      mpiret = sc_MPI_Irecv (faces.data () + recv_offsets[irank], face_size * recv_counts[irank], sc_MPI_BYTE, irank,
+                             T8_MPI_CMESH_JOIN_FACES, comm, &requests.back ());
+      SC_CHECK_MPI (mpiret);
+    }
+  }
+  for (int irank = 0; irank < mpisize; irank++) {
+    if (send_counts[irank] > 0) {
+      requests.emplace_back ();
+      mpiret = sc_MPI_Isend (send_faces.data () + send_offsets[irank], face_size * send_counts[irank], sc_MPI_BYTE,
+                             irank, T8_MPI_CMESH_JOIN_FACES, comm, &requests.back ());
+      SC_CHECK_MPI (mpiret);
+    }
+  }
+  mpiret = sc_MPI_Waitall (requests.size (), requests.data (), sc_MPI_STATUSES_IGNORE);
+  SC_CHECK_MPI (mpiret);
+  requests.clear ();
+  send_faces.clear ();
+  send_faces.shrink_to_fit ();
+
+  /* Match the received faces. We order them by tree and face, such that the result
+   * does not depend on the number of processes. */
+  std::sort (faces.begin (), faces.end (), [] (const t8_cmesh_join_face_t &face1, const t8_cmesh_join_face_t &face2) {
+    return face1.tree < face2.tree || (face1.tree == face2.tree && face1.face < face2.face);
+  });
+  std::vector<std::pair<size_t, size_t>> matches;
+  t8_cmesh_join_match_faces (faces, num_threads, mpirank, mpisize, matches);
+
+  /* Send each connection to the owners of both trees. */
+  auto tree_owner = [&tree_offsets] (const t8_gloidx_t tree) -> int {
+    return std::upper_bound (tree_offsets.begin (), tree_offsets.end () - 1, tree) - tree_offsets.begin () - 1;
+  };
+  std::vector<std::vector<t8_cmesh_join_result_t>> send_results (mpisize);
+  for (const auto &match : matches) {
+    const t8_cmesh_join_face_t *face = &faces[match.first];
+    const t8_cmesh_join_face_t *neigh = &faces[match.second];
+    const t8_cmesh_join_result_t result
+      = { face->tree, neigh->tree, face->face, neigh->face, t8_cmesh_join_orientation (face, neigh) };
+    const int face_owner = tree_owner (face->tree);
+    const int neigh_owner = tree_owner (neigh->tree);
+    send_results[face_owner].push_back (result);
+    if (neigh_owner != face_owner) {
+      send_results[neigh_owner].push_back (result);
+    }
+  }
+  faces.clear ();
+  faces.shrink_to_fit ();
+  for (int irank = 0; irank < mpisize; irank++) {
+    send_counts[irank] = send_results[irank].size ();
+  }
+  mpiret = sc_MPI_Alltoall (send_counts.data (), 1, sc_MPI_INT, recv_counts.data (), 1, sc_MPI_INT, comm);
+  SC_CHECK_MPI (mpiret);
+  for (int irank = 0; irank < mpisize; irank++) {
+    recv_offsets[irank + 1] = recv_offsets[irank] + recv_counts[irank];
+  }
+  std::vector<t8_cmesh_join_result_t> results (recv_offsets[mpisize]);
+  const int result_size = sizeof (t8_cmesh_join_result_t);
+  for (int irank = 0; irank < mpisize; irank++) {
+    if (recv_counts[irank] > 0) {
+      requests.emplace_back ();
+      mpiret = sc_MPI_Irecv (results.data () + recv_offsets[irank], result_size * recv_counts[irank], sc_MPI_BYTE,
+                             irank, T8_MPI_CMESH_JOIN_RESULT, comm, &requests.back ());
+      SC_CHECK_MPI (mpiret);
+    }
+  }
+  for (int irank = 0; irank < mpisize; irank++) {
+    if (send_counts[irank] > 0) {
+      requests.emplace_back ();
+      mpiret = sc_MPI_Isend (send_results[irank].data (), result_size * send_counts[irank], sc_MPI_BYTE, irank,
+                             T8_MPI_CMESH_JOIN_RESULT, comm, &requests.back ());
+      SC_CHECK_MPI (mpiret);
+    }
+  }
+  mpiret = sc_MPI_Waitall (requests.size (), requests.data (), sc_MPI_STATUSES_IGNORE);
+  SC_CHECK_MPI (mpiret);
+
+  /* Apply the connections in the order of the later face, as in the serial version. A face close to a bin
+   * boundary might have been matched by several processes, then we keep its first neighbor. */
+  std::sort (results.begin (), results.end (),
+             [] (const t8_cmesh_join_result_t &result1, const t8_cmesh_join_result_t &result2) {
+               return std::make_tuple (result1.tree, result1.face, result1.neigh_tree, result1.neigh_face)
+                      < std::make_tuple (result2.tree, result2.face, result2.neigh_tree, result2.neigh_face);
+             });
+  results.erase (std::unique (results.begin (), results.end (),
+                              [] (const t8_cmesh_join_result_t &result1, const t8_cmesh_join_result_t &result2) {
+                                return result1.tree == result2.tree && result1.face == result2.face;
+                              }),
+                 results.end ());
+  t8_gloidx_t *conn = NULL;
+  if (connectivity != NULL) {
+    conn = T8_ALLOC (t8_gloidx_t, (size_t) num_local_trees * T8_ECLASS_MAX_FACES * 3);
+    std::fill (conn, conn + (size_t) num_local_trees * T8_ECLASS_MAX_FACES * 3, -1);
+  }
+  for (const t8_cmesh_join_result_t &result : results) {
+    if (cmesh != NULL) {
+      t8_cmesh_set_join (cmesh, result.tree, result.neigh_tree, result.face, result.neigh_face, result.orientation);
+    }
+    if (conn == NULL) {
+      continue;
+    }
+    if (first_tree <= result.tree && result.tree < last_tree) {
+      const t8_gloidx_t itree = result.tree - first_tree;
+      conn[T8_3D_TO_1D (num_local_trees, T8_ECLASS_MAX_FACES, 3, itree, result.face, 0)] = result.neigh_tree;
+      conn[T8_3D_TO_1D (num_local_trees, T8_ECLASS_MAX_FACES, 3, itree, result.face, 1)] = result.neigh_face;
+      conn[T8_3D_TO_1D (num_local_trees, T8_ECLASS_MAX_FACES, 3, itree, result.face, 2)] = result.orientation;
+    }
+    if (first_tree <= result.neigh_tree && result.neigh_tree < last_tree) {
+      const t8_gloidx_t itree = result.neigh_tree - first_tree;
+      conn[T8_3D_TO_1D (num_local_trees, T8_ECLASS_MAX_FACES, 3, itree, result.neigh_face, 0)] = result.tree;
+      conn[T8_3D_TO_1D (num_local_trees, T8_ECLASS_MAX_FACES, 3, itree, result.neigh_face, 1)] = result.face;
+      conn[T8_3D_TO_1D (num_local_trees, T8_ECLASS_MAX_FACES, 3, itree, result.neigh_face, 2)] = result.orientation;
+    }
+  }
+  if (connectivity != NULL) {
+    *connectivity = conn;
+  }
+}
+
 void
 t8_cmesh_set_join_by_stash (t8_cmesh_t cmesh, int **connectivity, const int do_both_directions)
 {
@@ -48,10 +48,9 @@ T8_EXTERN_C_BEGIN ();
  *                                      For each element and each face the following is stored:
  *                                      neighbor_tree_id, neighbor_dual_face_id, orientation
  * \param[in]       do_both_directions  Compute the connectivity from both neighboring sides.
- *                                      Takes much longer to compute.
  *
- * \warning  This routine might be too expensive for very large meshes. In this case, 
- *           consider to use a fully featured mesh generator.
+ * \warning  This routine needs the vertices of all trees. For very large meshes consider
+ *           \ref t8_cmesh_set_join_by_vertices_parallel.
  *
  * \note This routine does not detect periodic boundaries.
  */
@@ -59,6 +58,39 @@ void
 t8_cmesh_set_join_by_vertices (t8_cmesh_t cmesh, const t8_gloidx_t ntrees, const t8_eclass_t *eclasses,
                                const double *vertices, int **connectivity, const int do_both_directions);
 
+/** Sets the face connectivity information of an un-committed, possibly partitioned \cmesh based on
+ * the vertices of the local trees of each process.
+ * Each face is identified by the sorted tuple of its quantized vertices. The faces are sent to the
+ * process owning the hash of their key, which matches them with an open-addressing hash table and
+ * returns each connection to the processes owning the two trees. Thus, no process needs to know
+ * the vertices of all trees.
+ * The connections are the same as those of \ref t8_cmesh_set_join_by_vertices with \a do_both_directions
+ * set, independent of the number of processes.
+ * \param[in,out]   cmesh               Pointer to a t8code cmesh object. If set to NULL this argument is ignored.
+ *                                      Otherwise \ref t8_cmesh_set_join is called for each connection with a
+ *                                      local tree, once per process.
+ * \param[in]       first_tree          The global id of the first local tree. The local trees of the processes
+ *                                      must be ordered by rank.
+ * \param[in]       num_local_trees     The number of local trees.
+ * \param[in]       eclasses            The element classes of the local trees, length [num_local_trees].
+ * \param[in]       vertices            List of per element vertices of the local trees with dimensions
+ *                                      [num_local_trees,T8_ECLASS_MAX_CORNERS,T8_ECLASS_MAX_DIM].
+ * \param[in,out]   connectivity        If not NULL, filled with an allocated array of dimensions
+ *                                      [num_local_trees,T8_ECLASS_MAX_FACES,3] that stores for each local tree
+ *                                      and face the global neighbor tree id, its dual face and the orientation,
+ *                                      or -1 if there is no neighbor. The ownership goes to the caller.
+ * \param[in]       num_threads         The number of threads used to compute and match the faces on each process.
+ * \param[in]       comm                The MPI communicator. This function is collective.
+ *
+ * \note Vertices are identified if their coordinates differ by less than 10 * T8_PRECISION_EPS.
+ * \note This routine does not detect periodic boundaries.
+ */
+void
+t8_cmesh_set_join_by_vertices_parallel (t8_cmesh_t cmesh, const t8_gloidx_t first_tree,
+                                        const t8_locidx_t num_local_trees, const t8_eclass_t *eclasses,
+                                        const double *vertices, t8_gloidx_t **connectivity, const int num_threads,
+                                        sc_MPI_Comm comm);
+
 /** Sets the face connectivity information of an un-committed \cmesh based on the cmesh stash.
  * \param[in,out]   cmesh               An uncommitted cmesh. The trees eclasses and vertices do need to be set.
  * \param[in,out]   connectivity        If connectivity is not NULL the variable is filled with a pointer to an
@@ -28,6 +28,8 @@
 #include <t8_geometry/t8_geometry_implementations/t8_geometry_cad.h>
 #include "t8_cmesh_types.h"
 #include "t8_cmesh_stash.h"
+#include <algorithm>
+#include <vector>
 
 #ifdef _WIN32
 #include "t8_windows.h"
@@ -159,9 +161,10 @@ t8_msh_file_node_compare (const void *node_a, const void *node_b, const void *u_
   return Node_a->index == Node_b->index;
 }
 
-/* Reads an open msh-file and checks whether the MeshFormat-Version is supported by t8code or not. */
+/* Reads an open msh-file and checks whether the MeshFormat-Version is supported by t8code or not.
+ * On success, is_binary is set to true if the file is a binary file and to false if it is an ASCII file. */
 static int
-t8_cmesh_check_version_of_msh_file (FILE *fp)
+t8_cmesh_check_version_of_msh_file (FILE *fp, int *is_binary)
 {
   char *line = (char *) malloc (1024);
   char first_word[2048] = "\0";
@@ -199,9 +202,11 @@ t8_cmesh_check_version_of_msh_file (FILE *fp)
     goto die_format;
   }
 
-  /* Checks if the file is of Binary-type. */
-  if (check_format) {
-    t8_global_errorf ("Incompatible file-type. t8code works with ASCII-type msh-files with the versions:\n");
+  /* Checks if the file is of Binary-type. Binary files are only supported in version 4.1. */
+  *is_binary = check_format;
+  if (check_format && (version_number != 4 || sub_version_number != 1)) {
+    t8_global_errorf ("Incompatible file-type. t8code works with binary-type msh-files of version 4.1 and "
+                      "ASCII-type msh-files with the versions:\n");
     for (int n_versions = 0; n_versions < T8_CMESH_N_SUPPORTED_MSH_FILE_VERSIONS; ++n_versions) {
       t8_global_errorf ("%d.X\n", t8_cmesh_supported_msh_file_versions[n_versions]);
     }
@@ -238,6 +243,45 @@ die_format:
   return -1;
 }
 
+/* Compute which vertices of a 3D tree with negative volume have to be switched to
+ * obtain a tree with positive volume.
+ * For tets we switch 0 and 3.
+ * For prisms we switch 0 and 3, 1 and 4, 2 and 5.
+ * For hexahedra we switch 0 and 4, 1 and 5, 2 and 6, 3 and 7.
+ * For pyramids we switch 0 and 4.
+ * \param [in]  eclass          The class of the tree.
+ * \param [out] switch_indices  Vertex i is to be switched with vertex \a switch_indices[i].
+ * \return                      The number of switches.
+ */
+static int
+t8_msh_file_negative_volume_switches (const t8_eclass_t eclass, int switch_indices[4])
+{
+  T8_ASSERT (t8_eclass_to_dimension[eclass] == 3);
+  switch (eclass) {
+  case T8_ECLASS_TET:
+    /* We switch vertex 0 and vertex 3 */
+    switch_indices[0] = 3;
+    return 1;
+  case T8_ECLASS_PRISM:
+    switch_indices[0] = 3;
+    switch_indices[1] = 4;
+    switch_indices[2] = 5;
+    return 3;
+  case T8_ECLASS_HEX:
+    switch_indices[0] = 4;
+    switch_indices[1] = 5;
+    switch_indices[2] = 6;
+    switch_indices[3] = 7;
+    return 4;
+  case T8_ECLASS_PYRAMID:
+    switch_indices[0] = 4;
+    return 1;
+  default:
+    SC_ABORT_NOT_REACHED ();
+  }
+  return 0;
+}
+
 /* Read an open .msh file of version 2 and parse the nodes into a hash table. */
 static sc_hash_t *
 t8_msh_file_2_read_nodes (FILE *fp, t8_locidx_t *num_nodes, sc_mempool_t **node_mempool)
@@ -619,37 +663,10 @@ t8_cmesh_msh_file_2_read_eles (t8_cmesh_t cmesh, FILE *fp, sc_hash_t *vertices,
          * For hexahedra we switch 0 and 4, 1 and 5, 2 and 6, 3 and 7.
          * For pyramids we switch 0 and 4 */
         double temp;
-        int num_switches = 0;
         int switch_indices[4] = { 0 };
         int iswitch;
-        T8_ASSERT (t8_eclass_to_dimension[eclass] == 3);
         t8_debugf ("Correcting negative volume of tree %li\n", tree_count);
-        switch (eclass) {
-        case T8_ECLASS_TET:
-          /* We switch vertex 0 and vertex 3 */
-          num_switches = 1;
-          switch_indices[0] = 3;
-          break;
-        case T8_ECLASS_PRISM:
-          num_switches = 3;
-          switch_indices[0] = 3;
-          switch_indices[1] = 4;
-          switch_indices[2] = 5;
-          break;
-        case T8_ECLASS_HEX:
-          num_switches = 4;
-          switch_indices[0] = 4;
-          switch_indices[1] = 5;
-          switch_indices[2] = 6;
-          switch_indices[3] = 7;
-          break;
-        case T8_ECLASS_PYRAMID:
-          num_switches = 1;
-          switch_indices[0] = 4;
-          break;
-        default:
-          SC_ABORT_NOT_REACHED ();
-        }
+        const int num_switches = t8_msh_file_negative_volume_switches (eclass, switch_indices);
 
         for (iswitch = 0; iswitch < num_switches; ++iswitch) {
           /* We switch vertex 0 + iswitch and vertex switch_indices[iswitch] */
@@ -945,37 +962,10 @@ t8_cmesh_msh_file_4_read_eles (t8_cmesh_t cmesh, FILE *fp, sc_hash_t *vertices,
            * For pyramids we switch 0 and 4 */
           double temp;
           t8_msh_file_node_parametric_t temp_node;
-          int num_switches = 0;
           int switch_indices[4] = { 0 };
           int iswitch;
-          T8_ASSERT (t8_eclass_to_dimension[eclass] == 3);
           t8_debugf ("Correcting negative volume of tree %li\n", tree_count);
-          switch (eclass) {
-          case T8_ECLASS_TET:
-            /* We switch vertex 0 and vertex 3 */
-            num_switches = 1;
-            switch_indices[0] = 3;
-            break;
-          case T8_ECLASS_PRISM:
-            num_switches = 3;
-            switch_indices[0] = 3;
-            switch_indices[1] = 4;
-            switch_indices[2] = 5;
-            break;
-          case T8_ECLASS_HEX:
-            num_switches = 4;
-            switch_indices[0] = 4;
-            switch_indices[1] = 5;
-            switch_indices[2] = 6;
-            switch_indices[3] = 7;
-            break;
-          case T8_ECLASS_PYRAMID:
-            num_switches = 1;
-            switch_indices[0] = 4;
-            break;
-          default:
-            SC_ABORT_NOT_REACHED ();
-          }
+          const int num_switches = t8_msh_file_negative_volume_switches (eclass, switch_indices);
 
           for (iswitch = 0; iswitch < num_switches; ++iswitch) {
             /* We switch vertex 0 + iswitch and vertex switch_indices[iswitch] */
@@ -1722,6 +1712,819 @@ t8_cmesh_msh_file_find_neighbors (t8_cmesh_t cmesh, sc_array_t *vertex_indices)
   t8_debugf ("Done finding tree neighbors.\n");
 }
 
+/* The binary .msh format of version 4.1 stores all counts and tags as size_t.
+ * We only support files that were written with 8 byte size_t. */
+#define T8_MSH_FILE_BINARY_DATA_SIZE 8
+
+/* Describes one entity block in the $Nodes or $Elements section of a binary .msh file. */
+typedef struct
+{
+  t8_gloidx_t data_offset; /* The byte offset of the first node tag or element record of this block in the file. */
+  t8_gloidx_t num_entries; /* The number of nodes or elements in this block. */
+  int entity_dim;          /* The dimension of the entity this block belongs to. */
+  int type;                /* For nodes the number of parameters per node, for elements the gmsh element type. */
+} t8_msh_file_binary_block_t;
+
+/* A node as it is communicated during the distributed lookup of the node coordinates. */
+typedef struct
+{
+  t8_gloidx_t tag;
+  double coordinates[3];
+} t8_msh_file_binary_node_t;
+
+/* A tree face as it is communicated during the distributed search for face neighbors.
+ * The vertices are stored in t8code order and additionally in ascending order,
+ * which we use to identify the face. */
+typedef struct
+{
+  t8_gloidx_t gtree_id;
+  t8_gloidx_t vertices[T8_ECLASS_MAX_CORNERS_2D];
+  t8_gloidx_t sorted_vertices[T8_ECLASS_MAX_CORNERS_2D];
+  int8_t face_number;
+  int8_t eclass;
+  int8_t num_vertices;
+} t8_msh_file_binary_face_t;
+
+/* A face connection between two trees. */
+typedef struct
+{
+  t8_gloidx_t gtree_id1;
+  t8_gloidx_t gtree_id2;
+  int face1;
+  int face2;
+  int orientation;
+} t8_msh_file_binary_join_t;
+
+/* A tree as it is sent to the processes that have it as a ghost. */
+typedef struct
+{
+  t8_gloidx_t gtree_id;
+  int eclass;
+  double vertices[T8_ECLASS_MAX_CORNERS * 3];
+} t8_msh_file_binary_ghost_t;
+
+/* Set the position of a file stream to a byte offset that may exceed the range of long.
+ * Returns 0 on success. */
+static int
+t8_msh_file_binary_seek (FILE *fp, const t8_gloidx_t offset, const int whence)
+{
+#ifdef _WIN32
+  return _fseeki64 (fp, offset, whence);
+#else
+  return fseeko (fp, (off_t) offset, whence);
+#endif
+}
+
+/* Return the current byte position of a file stream. */
+static t8_gloidx_t
+t8_msh_file_binary_tell (FILE *fp)
+{
+#ifdef _WIN32
+  return _ftelli64 (fp);
+#else
+  return ftello (fp);
+#endif
+}
+
+/* Read \a count items of \a size bytes each, starting at the byte \a offset of the file.
+ * Each process reads a few contiguous ranges once, so we use positioned stdio reads, which are
+ * available whether or not t8code is configured with MPI-IO (T8_ENABLE_MPIIO).
+ * Returns 0 on success and -1 on failure. */
+static int
+t8_msh_file_binary_read_at (FILE *fp, const t8_gloidx_t offset, void *buffer, const size_t size, const size_t count)
+{
+  if (count == 0) {
+    return 0;
+  }
+  if (t8_msh_file_binary_seek (fp, offset, SEEK_SET)) {
+    return -1;
+  }
+  return fread (buffer, size, count, fp) == count ? 0 : -1;
+}
+
+/* Skip the binary $Entities section of a .msh file of version 4.1.
+ * fp must be positioned directly after the line "$Entities".
+ * Returns 0 on success and -1 on failure. */
+static int
+t8_msh_file_binary_skip_entities (FILE *fp)
+{
+  uint64_t num_entities[4];
+  uint64_t num_tags;
+
+  if (fread (num_entities, sizeof (uint64_t), 4, fp) != 4) {
+    return -1;
+  }
+  for (int entity_dim = 0; entity_dim < 4; ++entity_dim) {
+    for (uint64_t ientity = 0; ientity < num_entities[entity_dim]; ++ientity) {
+      /* Points store their tag and coordinates, all other entities their tag and bounding box.
+       * Then follow the physical tags and, except for points, the tags of the bounding entities. */
+      const int num_doubles = entity_dim == 0 ? 3 : 6;
+      if (t8_msh_file_binary_seek (fp, sizeof (int) + num_doubles * sizeof (double), SEEK_CUR)
+          || fread (&num_tags, sizeof (uint64_t), 1, fp) != 1
+          || t8_msh_file_binary_seek (fp, num_tags * sizeof (int), SEEK_CUR)) {
+        return -1;
+      }
+      if (entity_dim > 0) {
+        if (fread (&num_tags, sizeof (uint64_t), 1, fp) != 1
+            || t8_msh_file_binary_seek (fp, num_tags * sizeof (int), SEEK_CUR)) {
+          return -1;
+        }
+      }
+    }
+  }
+  return 0;
+}
+
+/* Read the block headers of a binary $Nodes or $Elements section of a .msh file of version 4.1.
+ * fp must be positioned directly after the line starting the section.
+ * The data of the blocks is skipped, we only store where it is located in the file.
+ * \param [in]  fp          The file.
+ * \param [in]  read_nodes  True if the section is the $Nodes section, false if it is the $Elements section.
+ * \param [out] header      The header of the section: The number of blocks, the number of entries and
+ *                          the minimal and maximal tag.
+ * \param [out] blocks      The blocks of the section.
+ * \return                  0 on success and -1 on failure.
+ */
+static int
+t8_msh_file_binary_read_blocks (FILE *fp, const int read_nodes, uint64_t header[4],
+                                std::vector<t8_msh_file_binary_block_t> &blocks)
+{
+  int block_info[3];
+  uint64_t num_entries;
+  t8_gloidx_t entry_size;
+
+  if (fread (header, sizeof (uint64_t), 4, fp) != 4) {
+    return -1;
+  }
+  for (uint64_t iblock = 0; iblock < header[0]; ++iblock) {
+    /* The block header is entityDim entityTag parametric/elementType numEntriesInBlock */
+    if (fread (block_info, sizeof (int), 3, fp) != 3 || fread (&num_entries, sizeof (uint64_t), 1, fp) != 1) {
+      return -1;
+    }
+    t8_msh_file_binary_block_t block;
+    block.data_offset = t8_msh_file_binary_tell (fp);
+    block.num_entries = num_entries;
+    block.entity_dim = block_info[0];
+    if (read_nodes) {
+      /* Each node consists of its tag, its coordinates and entity_dim parameters if it is parametric. */
+      block.type = block_info[2] ? block.entity_dim : 0;
+      entry_size = T8_MSH_FILE_BINARY_DATA_SIZE + (3 + block.type) * sizeof (double);
+    }
+    else {
+      /* Each element consists of its tag followed by the tags of its nodes. */
+      block.type = block_info[2];
+      if (block.type > T8_NUM_GMSH_ELEM_CLASSES || block.type < 0
+          || t8_msh_tree_type_to_eclass[block.type] == T8_ECLASS_COUNT) {
+        t8_global_errorf ("tree type %i is not supported by t8code.\n", block.type);
+        return -1;
+      }
+      entry_size = (1 + t8_eclass_num_vertices[t8_msh_tree_type_to_eclass[block.type]]) * T8_MSH_FILE_BINARY_DATA_SIZE;
+    }
+    blocks.push_back (block);
+    if (t8_msh_file_binary_seek (fp, block.data_offset + block.num_entries * entry_size, SEEK_SET)) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+/* Scan the sections of a binary .msh file of version 4.1 and store the position of
+ * the blocks in the $Nodes and $Elements sections.
+ * Sections that we do not need are skipped by searching for their end marker.
+ * \param [in]  fp              The file.
+ * \param [out] node_header     The header of the $Nodes section.
+ * \param [out] node_blocks     The blocks of the $Nodes section.
+ * \param [out] element_blocks  The blocks of the $Elements section.
+ * \return                      0 on success and -1 on failure.
+ */
+static int
+t8_msh_file_binary_scan (FILE *fp, uint64_t node_header[4], std::vector<t8_msh_file_binary_block_t> &node_blocks,
+                         std::vector<t8_msh_file_binary_block_t> &element_blocks)
+{
+  char *line = (char *) malloc (1024);
+  char first_word[2048] = "\0";
+  size_t linen = 1024;
+  uint64_t element_header[4];
+  int found_nodes = 0;
+  int found_elements = 0;
+  int version_number, sub_version_number, file_type, data_size, one;
+
+  T8_ASSERT (fp != NULL);
+  fseek (fp, 0, SEEK_SET);
+  while (!found_elements) {
+    if (t8_cmesh_msh_read_next_line (&line, &linen, fp) < 0 || sscanf (line, "%2047s", first_word) != 1) {
+      t8_global_errorf ("Premature end of file while searching for the elements.\n");
+      goto die_scan;
+    }
+    if (!strcmp (first_word, "$MeshFormat")) {
+      /* The format line is followed by the binary integer 1 to detect the endianness. */
+      if (t8_cmesh_msh_read_next_line (&line, &linen, fp) < 0
+          || sscanf (line, "%d.%d %d %d", &version_number, &sub_version_number, &file_type, &data_size) != 4
+          || fread (&one, sizeof (int), 1, fp) != 1) {
+        t8_global_errorf ("Reading of the MeshFormat failed.\n");
+        goto die_scan;
+      }
+      if (version_number != 4 || sub_version_number != 1 || file_type != 1
+          || data_size != T8_MSH_FILE_BINARY_DATA_SIZE) {
+        t8_global_errorf ("Only binary msh-files of version 4.1 with a data size of %i are supported.\n",
+                          T8_MSH_FILE_BINARY_DATA_SIZE);
+        goto die_scan;
+      }
+      if (one != 1) {
+        t8_global_errorf ("The endianness of the msh-file does not match the endianness of this machine.\n");
+        goto die_scan;
+      }
+    }
+    else if (!strcmp (first_word, "$Entities")) {
+      if (t8_msh_file_binary_skip_entities (fp)) {
+        t8_global_errorf ("Error while reading the entities.\n");
+        goto die_scan;
+      }
+    }
+    else if (!strcmp (first_word, "$Nodes")) {
+      if (t8_msh_file_binary_read_blocks (fp, 1, node_header, node_blocks)) {
+        t8_global_errorf ("Error while reading the node blocks.\n");
+        goto die_scan;
+      }
+      found_nodes = 1;
+    }
+    else if (!strcmp (first_word, "$Elements")) {
+      if (!found_nodes) {
+        t8_global_errorf ("Expected the nodes before the elements.\n");
+        goto die_scan;
+      }
+      if (t8_msh_file_binary_read_blocks (fp, 0, element_header, element_blocks)) {
+        t8_global_errorf ("Error while reading the element blocks.\n");
+        goto die_scan;
+      }
+      found_elements = 1;
+    }
+    else if (first_word[0] == '$' && strncmp (first_word, "$End", 4)) {
+      /* Skip all other sections. */
+      do {
+        if (t8_cmesh_msh_read_next_line (&line, &linen, fp) < 0) {
+          t8_global_errorf ("Premature end of file while skipping section %s.\n", first_word);
+          goto die_scan;
+        }
+      } while (strncmp (line, "$End", 4));
+    }
+  }
+  free (line);
+  return 0;
+
+die_scan:
+  free (line);
+  return -1;
+}
+
+/* Send data of a fixed size type to other processes.
+ * \param [in]  send          For each process the data to send to it.
+ * \param [out] recv          The data received from all processes, ordered by the sending process.
+ * \param [out] recv_offsets  The data received from process p is found at the positions
+ *                            recv_offsets[p] to recv_offsets[p + 1] - 1 in \a recv.
+ * \param [in]  comm          The communicator.
+ */
+template <typename T>
+static void
+t8_msh_file_binary_exchange (const std::vector<std::vector<T>> &send, std::vector<T> &recv,
+                             std::vector<int> &recv_offsets, sc_MPI_Comm comm)
+{
+  int mpirank, mpisize, mpiret;
+
+  mpiret = sc_MPI_Comm_size (comm, &mpisize);
+  SC_CHECK_MPI (mpiret);
+  mpiret = sc_MPI_Comm_rank (comm, &mpirank);
+  SC_CHECK_MPI (mpiret);
+  T8_ASSERT ((int) send.size () == mpisize);
+
+  std::vector<int> send_counts (mpisize), recv_counts (mpisize);
+  for (int iproc = 0; iproc < mpisize; ++iproc) {
+    send_counts[iproc] = send[iproc].size () * sizeof (T);
+  }
+  mpiret = sc_MPI_Alltoall (send_counts.data (), 1, sc_MPI_INT, recv_counts.data (), 1, sc_MPI_INT, comm);
+  SC_CHECK_MPI (mpiret);
+
+  recv_offsets.resize (mpisize + 1);
+  recv_offsets[0] = 0;
+  for (int iproc = 0; iproc < mpisize; ++iproc) {
+    recv_offsets[iproc + 1] = recv_offsets[iproc] + recv_counts[iproc] / sizeof (T);
+  }
+  recv.resize (recv_offsets[mpisize]);
+
+  std::vector<sc_MPI_Request> requests;
+  requests.reserve (2 * mpisize);
+  for (int iproc = 0; iproc < mpisize; ++iproc) {
+    if (iproc == mpirank) {
+      std::copy (send[iproc].begin (), send[iproc].end (), recv.begin () + recv_offsets[iproc]);
+    }
+    else if (recv_counts[iproc] > 0) {
+      requests.emplace_back ();
+      mpiret = sc_MPI_Irecv (recv.data () + recv_offsets[iproc], recv_counts[iproc], sc_MPI_BYTE, iproc,
+                             T8_MPI_CMESH_READ_MSH_FILE, comm, &requests.back ());
+      SC_CHECK_MPI (mpiret);
+    }
+  }
+  for (int iproc = 0; iproc < mpisize; ++iproc) {
+    if (iproc != mpirank && send_counts[iproc] > 0) {
+      requests.emplace_back ();
+      mpiret = sc_MPI_Isend ((void *) send[iproc].data (), send_counts[iproc], sc_MPI_BYTE, iproc,
+                             T8_MPI_CMESH_READ_MSH_FILE, comm, &requests.back ());
+      SC_CHECK_MPI (mpiret);
+    }
+  }
+  mpiret = sc_MPI_Waitall (requests.size (), requests.data (), sc_MPI_STATUSES_IGNORE);
+  SC_CHECK_MPI (mpiret);
+}
+
+/* The process that stores the coordinates of a node during the distributed lookup.
+ * We assign the range of node tags evenly to the processes. */
+static int
+t8_msh_file_binary_node_owner (const t8_gloidx_t tag, const uint64_t node_header[4], const int mpisize)
+{
+  const t8_gloidx_t min_tag = node_header[2];
+  const t8_gloidx_t num_tags = node_header[3] - node_header[2] + 1;
+  const t8_gloidx_t clamped_tag = SC_MAX (min_tag, SC_MIN (tag, min_tag + num_tags - 1));
+  return (int) ((clamped_tag - min_tag) * mpisize / num_tags);
+}
+
+/* The process that matches a face with its neighbor.
+ * We compute it from a hash of the sorted vertex tags. */
+static int
+t8_msh_file_binary_face_owner (const t8_msh_file_binary_face_t *face, const int mpisize)
+{
+  uint64_t hash = 0;
+  for (int ivertex = 0; ivertex < face->num_vertices; ++ivertex) {
+    hash = hash * 1000003 + (uint64_t) face->sorted_vertices[ivertex];
+  }
+  return (int) (hash % mpisize);
+}
+
+/* Order nodes by their tags. */
+static bool
+t8_msh_file_binary_node_less (const t8_msh_file_binary_node_t &node_a, const t8_msh_file_binary_node_t &node_b)
+{
+  return node_a.tag < node_b.tag;
+}
+
+/* Order faces by their number of vertices and their sorted vertices.
+ * Faces that share the same vertices are equal with respect to this order. */
+static bool
+t8_msh_file_binary_face_less (const t8_msh_file_binary_face_t &face_a, const t8_msh_file_binary_face_t &face_b)
+{
+  if (face_a.num_vertices != face_b.num_vertices) {
+    return face_a.num_vertices < face_b.num_vertices;
+  }
+  return std::lexicographical_compare (face_a.sorted_vertices, face_a.sorted_vertices + face_a.num_vertices,
+                                       face_b.sorted_vertices, face_b.sorted_vertices + face_b.num_vertices);
+}
+
+/* Order face connections by the trees and faces they connect. */
+static bool
+t8_msh_file_binary_join_less (const t8_msh_file_binary_join_t &join_a, const t8_msh_file_binary_join_t &join_b)
+{
+  if (join_a.gtree_id1 != join_b.gtree_id1) {
+    return join_a.gtree_id1 < join_b.gtree_id1;
+  }
+  if (join_a.face1 != join_b.face1) {
+    return join_a.face1 < join_b.face1;
+  }
+  if (join_a.gtree_id2 != join_b.gtree_id2) {
+    return join_a.gtree_id2 < join_b.gtree_id2;
+  }
+  return join_a.face2 < join_b.face2;
+}
+
+/* Read a binary .msh file of version 4.1 in parallel.
+ * Each process reads an equally sized range of the trees and of the nodes directly from the file.
+ * The coordinates of the nodes of the local trees are then looked up on the processes that
+ * read them. To find the face neighbors, each face is sent to a process that is determined by
+ * its vertices and that matches it with its neighbor.
+ * At last, each process sends its trees to the processes that have them as a ghost.
+ * Thus, no process needs to read or store more than its share of the file.
+ * \param [in,out] cmesh            The cmesh to which the trees are added. It must be initialized but not committed.
+ * \param [in]     filename         The name of the file.
+ * \param [in]     dim              The dimension of the trees to read.
+ * \param [in]     comm             The processes that read the file together.
+ * \param [in]     main_proc        The process that scans the file for the positions of the nodes and elements.
+ * \param [in]     partition        If true, the cmesh is partitioned among the processes in \a comm.
+ *                                  Otherwise, \a comm must only contain the calling process.
+ * \param [in]     linear_geometry  The geometry to use for the trees.
+ * \return                          0 on success and -1 on failure on any process.
+ */
+static int
+t8_cmesh_msh_file_binary_read (t8_cmesh_t cmesh, const char *filename, const int dim, sc_MPI_Comm comm,
+                               const int main_proc, const int partition, const t8_geometry_c *linear_geometry)
+{
+  int mpirank, mpisize, mpiret;
+  /* The header of the $Nodes section: the number of blocks, the number of nodes, the minimal and maximal tag. */
+  uint64_t node_header[4] = { 0, 0, 0, 0 };
+  std::vector<t8_msh_file_binary_block_t> node_blocks, element_blocks;
+  /* Whether the scan succeeded and the number of node and element blocks. */
+  t8_gloidx_t scan_info[3] = { -1, 0, 0 };
+  int read_error = 0, global_read_error;
+
+  mpiret = sc_MPI_Comm_size (comm, &mpisize);
+  SC_CHECK_MPI (mpiret);
+  mpiret = sc_MPI_Comm_rank (comm, &mpirank);
+  SC_CHECK_MPI (mpiret);
+  T8_ASSERT (partition || mpisize == 1);
+
+  FILE *fp = fopen (filename, "rb");
+  if (fp == NULL) {
+    t8_errorf ("Could not open file %s\n", filename);
+    read_error = 1;
+  }
+  else if (mpirank == main_proc) {
+    /* Find the entity blocks of the nodes and elements in the file */
+    scan_info[0] = t8_msh_file_binary_scan (fp, node_header, node_blocks, element_blocks);
+    scan_info[1] = node_blocks.size ();
+    scan_info[2] = element_blocks.size ();
+  }
+  mpiret = sc_MPI_Bcast (scan_info, 3, T8_MPI_GLOIDX, main_proc, comm);
+  SC_CHECK_MPI (mpiret);
+  mpiret = sc_MPI_Allreduce (&read_error, &global_read_error, 1, sc_MPI_INT, sc_MPI_MAX, comm);
+  SC_CHECK_MPI (mpiret);
+  if (scan_info[0] != 0 || global_read_error) {
+    if (fp != NULL) {
+      fclose (fp);
+    }
+    return -1;
+  }
+  /* Distribute the block positions to all processes. */
+  node_blocks.resize (scan_info[1]);
+  element_blocks.resize (scan_info[2]);
+  mpiret = sc_MPI_Bcast (node_header, 4 * sizeof (uint64_t), sc_MPI_BYTE, main_proc, comm);
+  SC_CHECK_MPI (mpiret);
+  if (scan_info[1] > 0) {
+    mpiret = sc_MPI_Bcast (node_blocks.data (), scan_info[1] * sizeof (t8_msh_file_binary_block_t), sc_MPI_BYTE,
+                           main_proc, comm);
+    SC_CHECK_MPI (mpiret);
+  }
+  if (scan_info[2] > 0) {
+    mpiret = sc_MPI_Bcast (element_blocks.data (), scan_info[2] * sizeof (t8_msh_file_binary_block_t), sc_MPI_BYTE,
+                           main_proc, comm);
+    SC_CHECK_MPI (mpiret);
+  }
+
+  /* Each process gets an equally sized range of the trees of dimension dim. */
+  t8_gloidx_t num_trees = 0;
+  for (const t8_msh_file_binary_block_t &block : element_blocks) {
+    if (t8_eclass_to_dimension[t8_msh_tree_type_to_eclass[block.type]] == dim) {
+      num_trees += block.num_entries;
+    }
+  }
+  std::vector<t8_gloidx_t> tree_offsets (mpisize + 1);
+  for (int iproc = 0; iproc <= mpisize; ++iproc) {
+    tree_offsets[iproc] = num_trees * iproc / mpisize;
+  }
+  const t8_gloidx_t first_tree = tree_offsets[mpirank];
+  const t8_locidx_t num_local_trees = tree_offsets[mpirank + 1] - first_tree;
+  /* Return the process that owns a tree */
+  auto tree_owner = [&tree_offsets] (t8_gloidx_t gtree_id) {
+    return (int) (std::upper_bound (tree_offsets.begin (), tree_offsets.end (), gtree_id) - tree_offsets.begin ()) - 1;
+  };
+
+  /* Read the local trees. For each tree we store its class and its node tags in msh order. */
+  std::vector<t8_eclass_t> tree_classes (num_local_trees);
+  std::vector<t8_gloidx_t> tree_node_tags ((size_t) num_local_trees * T8_ECLASS_MAX_CORNERS);
+  {
+    std::vector<uint64_t> records;
+    t8_gloidx_t block_first_tree = 0;
+    for (const t8_msh_file_binary_block_t &block : element_blocks) {
+      const t8_eclass_t eclass = t8_msh_tree_type_to_eclass[block.type];
+      if (t8_eclass_to_dimension[eclass] != dim) {
+        continue;
+      }
+      /* The part of this block that belongs to this process. */
+      const t8_gloidx_t begin = SC_MAX (first_tree, block_first_tree);
+      const t8_gloidx_t end = SC_MIN (first_tree + num_local_trees, block_first_tree + block.num_entries);
+      if (begin < end) {
+        const int num_vertices = t8_eclass_num_vertices[eclass];
+        const int record_size = 1 + num_vertices;
+        records.resize ((end - begin) * record_size);
+        if (t8_msh_file_binary_read_at (fp,
+                                        block.data_offset
+                                          + (begin - block_first_tree) * record_size * T8_MSH_FILE_BINARY_DATA_SIZE,
+                                        records.data (), T8_MSH_FILE_BINARY_DATA_SIZE, records.size ())) {
+          t8_errorf ("Error while reading trees from file %s\n", filename);
+          read_error = 1;
+          break;
+        }
+        for (t8_gloidx_t itree = begin; itree < end; ++itree) {
+          const t8_locidx_t ltree = itree - first_tree;
+          tree_classes[ltree] = eclass;
+          /* The first entry of a record is the element tag, we skip it. */
+          for (int ivertex = 0; ivertex < num_vertices; ++ivertex) {
+            tree_node_tags[ltree * T8_ECLASS_MAX_CORNERS + ivertex]
+              = records[(itree - begin) * record_size + 1 + ivertex];
+          }
+        }
+      }
+      block_first_tree += block.num_entries;
+    }
+  }
+
+  /* Read an equally sized range of the nodes and send each node to the process that
+   * stores it during the lookup. */
+  std::vector<std::vector<t8_msh_file_binary_node_t>> node_send (mpisize);
+  if (!read_error) {
+    const t8_gloidx_t num_nodes = node_header[1];
+    const t8_gloidx_t first_node = num_nodes * mpirank / mpisize;
+    const t8_gloidx_t end_node = num_nodes * (mpirank + 1) / mpisize;
+    std::vector<uint64_t> tags;
+    std::vector<double> coordinates;
+    t8_gloidx_t block_first_node = 0;
+    for (const t8_msh_file_binary_block_t &block : node_blocks) {
+      const t8_gloidx_t begin = SC_MAX (first_node, block_first_node);
+      const t8_gloidx_t end = SC_MIN (end_node, block_first_node + block.num_entries);
+      if (begin < end) {
+        /* A block stores the tags of all of its nodes followed by their coordinates and parameters. */
+        const t8_gloidx_t num_block_nodes = end - begin;
+        const t8_gloidx_t first_in_block = begin - block_first_node;
+        const int stride = 3 + block.type;
+        tags.resize (num_block_nodes);
+        coordinates.resize (num_block_nodes * stride);
+        if (t8_msh_file_binary_read_at (fp, block.data_offset + first_in_block * T8_MSH_FILE_BINARY_DATA_SIZE,
+                                        tags.data (), T8_MSH_FILE_BINARY_DATA_SIZE, num_block_nodes)
+            || t8_msh_file_binary_read_at (fp,
+                                           block.data_offset + block.num_entries * T8_MSH_FILE_BINARY_DATA_SIZE
+                                             + first_in_block * stride * sizeof (double),
+                                           coordinates.data (), sizeof (double), num_block_nodes * stride)) {
+          t8_errorf ("Error while reading nodes from file %s\n", filename);
+          read_error = 1;
+          break;
+        }
+        for (t8_gloidx_t inode = 0; inode < num_block_nodes; ++inode) {
+          t8_msh_file_binary_node_t node;
+          node.tag = tags[inode];
+          memcpy (node.coordinates, coordinates.data () + inode * stride, 3 * sizeof (double));
+          node_send[t8_msh_file_binary_node_owner (node.tag, node_header, mpisize)].push_back (node);
+        }
+      }
+      block_first_node += block.num_entries;
+    }
+  }
+  fclose (fp);
+  mpiret = sc_MPI_Allreduce (&read_error, &global_read_error, 1, sc_MPI_INT, sc_MPI_MAX, comm);
+  SC_CHECK_MPI (mpiret);
+  if (global_read_error) {
+    return -1;
+  }
+
+  /* Collect the nodes that this process is responsible for and sort them by their tags. */
+  std::vector<t8_msh_file_binary_node_t> node_directory;
+  std::vector<int> recv_offsets;
+  t8_msh_file_binary_exchange (node_send, node_directory, recv_offsets, comm);
+  node_send.clear ();
+  std::sort (node_directory.begin (), node_directory.end (), t8_msh_file_binary_node_less);
+
+  /* Request the coordinates of the nodes of the local trees. Since the owner of a node is
+   * monotonous in its tag, the answers arrive in the order of the sorted requested tags. */
+  std::vector<t8_gloidx_t> needed_tags;
+  needed_tags.reserve (tree_node_tags.size ());
+  for (t8_locidx_t ltree = 0; ltree < num_local_trees; ++ltree) {
+    for (int ivertex = 0; ivertex < t8_eclass_num_vertices[tree_classes[ltree]]; ++ivertex) {
+      needed_tags.push_back (tree_node_tags[ltree * T8_ECLASS_MAX_CORNERS + ivertex]);
+    }
+  }
+  std::sort (needed_tags.begin (), needed_tags.end ());
+  needed_tags.erase (std::unique (needed_tags.begin (), needed_tags.end ()), needed_tags.end ());
+  std::vector<std::vector<t8_gloidx_t>> request_send (mpisize);
+  for (const t8_gloidx_t tag : needed_tags) {
+    request_send[t8_msh_file_binary_node_owner (tag, node_header, mpisize)].push_back (tag);
+  }
+  std::vector<t8_gloidx_t> requested_tags;
+  t8_msh_file_binary_exchange (request_send, requested_tags, recv_offsets, comm);
+  request_send.clear ();
+
+  /* Answer the requests of all processes. */
+  std::vector<std::vector<t8_msh_file_binary_node_t>> answer_send (mpisize);
+  for (int iproc = 0; iproc < mpisize; ++iproc) {
+    for (int irequest = recv_offsets[iproc]; irequest < recv_offsets[iproc + 1]; ++irequest) {
+      t8_msh_file_binary_node_t node;
+      node.tag = requested_tags[irequest];
+      auto found
+        = std::lower_bound (node_directory.begin (), node_directory.end (), node, t8_msh_file_binary_node_less);
+      if (found == node_directory.end () || found->tag != node.tag) {
+        t8_errorf ("Node %lli is used by a tree but not contained in file %s\n", (long long) node.tag, filename);
+        read_error = 1;
+        node.coordinates[0] = node.coordinates[1] = node.coordinates[2] = 0;
+      }
+      else {
+        node = *found;
+      }
+      answer_send[iproc].push_back (node);
+    }
+  }
+  node_directory.clear ();
+  requested_tags.clear ();
+  std::vector<t8_msh_file_binary_node_t> needed_nodes;
+  t8_msh_file_binary_exchange (answer_send, needed_nodes, recv_offsets, comm);
+  answer_send.clear ();
+  mpiret = sc_MPI_Allreduce (&read_error, &global_read_error, 1, sc_MPI_INT, sc_MPI_MAX, comm);
+  SC_CHECK_MPI (mpiret);
+  if (global_read_error) {
+    return -1;
+  }
+  T8_ASSERT (needed_nodes.size () == needed_tags.size ());
+
+  /* Build the local trees. We store their node tags and vertices in t8code order. */
+  std::vector<t8_gloidx_t> tree_vertex_tags ((size_t) num_local_trees * T8_ECLASS_MAX_CORNERS);
+  std::vector<double> tree_vertices ((size_t) num_local_trees * T8_ECLASS_MAX_CORNERS * 3);
+  for (t8_locidx_t ltree = 0; ltree < num_local_trees; ++ltree) {
+    const t8_eclass_t eclass = tree_classes[ltree];
+    const int num_vertices = t8_eclass_num_vertices[eclass];
+    t8_gloidx_t *vertex_tags = tree_vertex_tags.data () + ltree * T8_ECLASS_MAX_CORNERS;
+    double *vertices = tree_vertices.data () + ltree * T8_ECLASS_MAX_CORNERS * 3;
+    for (int ivertex = 0; ivertex < num_vertices; ++ivertex) {
+      const t8_gloidx_t tag = tree_node_tags[ltree * T8_ECLASS_MAX_CORNERS + ivertex];
+      const size_t inode = std::lower_bound (needed_tags.begin (), needed_tags.end (), tag) - needed_tags.begin ();
+      T8_ASSERT (inode < needed_tags.size () && needed_tags[inode] == tag);
+      const int t8_vertex_num = t8_msh_tree_vertex_to_t8_vertex_num[eclass][ivertex];
+      vertex_tags[t8_vertex_num] = tag;
+      memcpy (vertices + 3 * t8_vertex_num, needed_nodes[inode].coordinates, 3 * sizeof (double));
+    }
+    /* Detect and correct negative volumes */
+    if (t8_cmesh_tree_vertices_negative_volume (eclass, vertices, num_vertices)) {
+      int switch_indices[4] = { 0 };
+      const int num_switches = t8_msh_file_negative_volume_switches (eclass, switch_indices);
+      for (int iswitch = 0; iswitch < num_switches; ++iswitch) {
+        std::swap_ranges (vertices + 3 * iswitch, vertices + 3 * iswitch + 3, vertices + 3 * switch_indices[iswitch]);
+        std::swap (vertex_tags[iswitch], vertex_tags[switch_indices[iswitch]]);
+      }
+      T8_ASSERT (!t8_cmesh_tree_vertices_negative_volume (eclass, vertices, num_vertices));
+    }
+    t8_cmesh_set_tree_class (cmesh, first_tree + ltree, eclass);
+    t8_cmesh_set_tree_vertices (cmesh, first_tree + ltree, vertices, num_vertices);
+    t8_cmesh_set_tree_geometry (cmesh, first_tree + ltree, linear_geometry);
+  }
+  tree_node_tags.clear ();
+  needed_tags.clear ();
+  needed_nodes.clear ();
+
+  /* Send each face to the process that matches it with its neighbor. */
+  std::vector<std::vector<t8_msh_file_binary_face_t>> face_send (mpisize);
+  for (t8_locidx_t ltree = 0; ltree < num_local_trees; ++ltree) {
+    const t8_eclass_t eclass = tree_classes[ltree];
+    for (int iface = 0; iface < t8_eclass_num_faces[eclass]; ++iface) {
+      t8_msh_file_binary_face_t face;
+      face.gtree_id = first_tree + ltree;
+      face.face_number = iface;
+      face.eclass = eclass;
+      face.num_vertices = t8_eclass_num_vertices[t8_eclass_face_types[eclass][iface]];
+      for (int ivertex = 0; ivertex < face.num_vertices; ++ivertex) {
+        face.vertices[ivertex]
+          = tree_vertex_tags[ltree * T8_ECLASS_MAX_CORNERS + t8_face_vertex_to_tree_vertex[eclass][iface][ivertex]];
+        face.sorted_vertices[ivertex] = face.vertices[ivertex];
+      }
+      std::sort (face.sorted_vertices, face.sorted_vertices + face.num_vertices);
+      face_send[t8_msh_file_binary_face_owner (&face, mpisize)].push_back (face);
+    }
+  }
+  std::vector<t8_msh_file_binary_face_t> faces;
+  t8_msh_file_binary_exchange (face_send, faces, recv_offsets, comm);
+  face_send.clear ();
+
+  /* Match the received faces. Equal faces are adjacent after sorting and we connect them
+   * pairwise. Each connection is sent to the owners of both trees. */
+  std::sort (faces.begin (), faces.end (), t8_msh_file_binary_face_less);
+  std::vector<std::vector<t8_msh_file_binary_join_t>> join_send (mpisize);
+  for (size_t iface = 0; iface + 1 < faces.size (); ++iface) {
+    t8_msh_file_binary_face_t *face_a = &faces[iface];
+    t8_msh_file_binary_face_t *face_b = &faces[iface + 1];
+    if (t8_msh_file_binary_face_less (*face_a, *face_b)) {
+      continue;
+    }
+    /* The orientation only depends on which vertices of the two faces coincide. Thus, we pass
+     * the position of each vertex in the sorted vertices, which both faces share, as its index. */
+    long vertices_a[T8_ECLASS_MAX_CORNERS_2D], vertices_b[T8_ECLASS_MAX_CORNERS_2D];
+    for (int ivertex = 0; ivertex < face_a->num_vertices; ++ivertex) {
+      vertices_a[ivertex] = std::lower_bound (face_a->sorted_vertices, face_a->sorted_vertices + face_a->num_vertices,
+                                              face_a->vertices[ivertex])
+                            - face_a->sorted_vertices;
+      vertices_b[ivertex] = std::lower_bound (face_a->sorted_vertices, face_a->sorted_vertices + face_a->num_vertices,
+                                              face_b->vertices[ivertex])
+                            - face_a->sorted_vertices;
+    }
+    t8_msh_file_face_t Face_a, Face_b;
+    Face_a.ltree_id = face_a->gtree_id;
+    Face_b.ltree_id = face_b->gtree_id;
+    Face_a.face_number = face_a->face_number;
+    Face_a.num_vertices = face_a->num_vertices;
+    Face_a.vertices = vertices_a;
+    Face_b.face_number = face_b->face_number;
+    Face_b.num_vertices = face_b->num_vertices;
+    Face_b.vertices = vertices_b;
+    t8_msh_file_binary_join_t join;
+    join.gtree_id1 = face_a->gtree_id;
+    join.gtree_id2 = face_b->gtree_id;
+    join.face1 = face_a->face_number;
+    join.face2 = face_b->face_number;
+    join.orientation
+      = t8_msh_file_face_orientation (&Face_a, &Face_b, (t8_eclass_t) face_a->eclass, (t8_eclass_t) face_b->eclass);
+    const int owner1 = tree_owner (join.gtree_id1);
+    const int owner2 = tree_owner (join.gtree_id2);
+    join_send[owner1].push_back (join);
+    if (owner2 != owner1) {
+      join_send[owner2].push_back (join);
+    }
+    /* The next face was used by this connection */
+    ++iface;
+  }
+  faces.clear ();
+  std::vector<t8_msh_file_binary_join_t> joins;
+  t8_msh_file_binary_exchange (join_send, joins, recv_offsets, comm);
+  join_send.clear ();
+
+  /* Set the face connections of the local trees and collect for each local tree the
+   * connections it is part of together with the processes that have it as a ghost. */
+  auto is_local = [first_tree, num_local_trees] (t8_gloidx_t gtree_id) {
+    return first_tree <= gtree_id && gtree_id < first_tree + num_local_trees;
+  };
+  std::vector<std::pair<t8_locidx_t, size_t>> tree_joins;
+  std::vector<std::pair<t8_locidx_t, int>> ghost_receivers;
+  for (size_t ijoin = 0; ijoin < joins.size (); ++ijoin) {
+    const t8_msh_file_binary_join_t &join = joins[ijoin];
+    t8_cmesh_set_join (cmesh, join.gtree_id1, join.gtree_id2, join.face1, join.face2, join.orientation);
+    const t8_gloidx_t gtree_ids[2] = { join.gtree_id1, join.gtree_id2 };
+    for (int iside = 0; iside < 2; ++iside) {
+      const t8_gloidx_t gtree_id = gtree_ids[iside];
+      const t8_gloidx_t neighbor_id = gtree_ids[1 - iside];
+      if (is_local (gtree_id) && (iside == 0 || gtree_id != neighbor_id)) {
+        tree_joins.emplace_back (gtree_id - first_tree, ijoin);
+        if (!is_local (neighbor_id)) {
+          ghost_receivers.emplace_back (gtree_id - first_tree, tree_owner (neighbor_id));
+        }
+      }
+    }
+  }
+  std::sort (tree_joins.begin (), tree_joins.end ());
+  std::sort (ghost_receivers.begin (), ghost_receivers.end ());
+  ghost_receivers.erase (std::unique (ghost_receivers.begin (), ghost_receivers.end ()), ghost_receivers.end ());
+
+  /* Send the local trees and their face connections to the processes that have them as a ghost. */
+  std::vector<std::vector<t8_msh_file_binary_ghost_t>> ghost_send (mpisize);
+  std::vector<std::vector<t8_msh_file_binary_join_t>> ghost_join_send (mpisize);
+  for (const std::pair<t8_locidx_t, int> &receiver : ghost_receivers) {
+    const t8_locidx_t ltree = receiver.first;
+    t8_msh_file_binary_ghost_t ghost;
+    ghost.gtree_id = first_tree + ltree;
+    ghost.eclass = tree_classes[ltree];
+    memcpy (ghost.vertices, tree_vertices.data () + ltree * T8_ECLASS_MAX_CORNERS * 3,
+            sizeof (double) * T8_ECLASS_MAX_CORNERS * 3);
+    ghost_send[receiver.second].push_back (ghost);
+    auto range = std::equal_range (tree_joins.begin (), tree_joins.end (), std::make_pair (ltree, (size_t) 0),
+                                   [] (const std::pair<t8_locidx_t, size_t> &pair_a,
+                                       const std::pair<t8_locidx_t, size_t> &pair_b) {
+                                     return pair_a.first < pair_b.first;
+                                   });
+    for (auto tree_join = range.first; tree_join != range.second; ++tree_join) {
+      ghost_join_send[receiver.second].push_back (joins[tree_join->second]);
+    }
+  }
+  std::vector<t8_msh_file_binary_ghost_t> ghosts;
+  t8_msh_file_binary_exchange (ghost_send, ghosts, recv_offsets, comm);
+  std::vector<t8_msh_file_binary_join_t> ghost_joins;
+  t8_msh_file_binary_exchange (ghost_join_send, ghost_joins, recv_offsets, comm);
+
+  for (const t8_msh_file_binary_ghost_t &ghost : ghosts) {
+    const t8_eclass_t eclass = (t8_eclass_t) ghost.eclass;
+    t8_cmesh_set_tree_class (cmesh, ghost.gtree_id, eclass);
+    t8_cmesh_set_tree_vertices (cmesh, ghost.gtree_id, ghost.vertices, t8_eclass_num_vertices[eclass]);
+    t8_cmesh_set_tree_geometry (cmesh, ghost.gtree_id, linear_geometry);
+  }
+  /* The face connections between a ghost and a local tree are already set.
+   * A face connection between two ghosts may be received from both of their owners,
+   * so we bring all connections into a unique form and set each only once. */
+  std::vector<t8_msh_file_binary_join_t> remote_joins;
+  for (t8_msh_file_binary_join_t join : ghost_joins) {
+    if (is_local (join.gtree_id1) || is_local (join.gtree_id2)) {
+      continue;
+    }
+    if (join.gtree_id2 < join.gtree_id1 || (join.gtree_id2 == join.gtree_id1 && join.face2 < join.face1)) {
+      std::swap (join.gtree_id1, join.gtree_id2);
+      std::swap (join.face1, join.face2);
+    }
+    remote_joins.push_back (join);
+  }
+  std::sort (remote_joins.begin (), remote_joins.end (), t8_msh_file_binary_join_less);
+  for (size_t ijoin = 0; ijoin < remote_joins.size (); ++ijoin) {
+    const t8_msh_file_binary_join_t &join = remote_joins[ijoin];
+    if (ijoin == 0 || t8_msh_file_binary_join_less (remote_joins[ijoin - 1], join)) {
+      t8_cmesh_set_join (cmesh, join.gtree_id1, join.gtree_id2, join.face1, join.face2, join.orientation);
+    }
+  }
+
+  if (partition) {
+    t8_cmesh_set_partition_range (cmesh, 3, first_tree, first_tree + num_local_trees - 1);
+  }
+  if (num_trees == 0) {
+    t8_global_errorf ("Warning: No %iD elements found in msh file.\n", dim);
+  }
+  t8_debugf ("Read %li trees and %li ghosts from binary msh file.\n", (long) num_local_trees, (long) ghosts.size ());
+  return 0;
+}
+
 /* This part should be callable from C */
 T8_EXTERN_C_BEGIN ();
 
@@ -1767,6 +2570,7 @@ t8_cmesh_from_msh_file (const char *fileprefix, int partition, sc_MPI_Comm comm,
   t8_gloidx_t num_trees, first_tree, last_tree = -1;
   int main_proc_read_successful = 0;
   int msh_version;
+  int is_binary = 0;
   const t8_geometry_c *cad_geometry = NULL;
   const t8_geometry_c *linear_geometry = NULL;
 
@@ -1775,9 +2579,6 @@ t8_cmesh_from_msh_file (const char *fileprefix, int partition, sc_MPI_Comm comm,
   mpiret = sc_MPI_Comm_rank (comm, &mpirank);
   SC_CHECK_MPI (mpiret);
 
-  /* TODO: implement partitioned input using gmesh's
-   * partitioned files.
-   * Or using a single file and computing the partition on the run. */
   T8_ASSERT (partition == 0 || (main_proc >= 0 && main_proc < mpisize));
 
   /* initialize cmesh structure */
@@ -1797,8 +2598,8 @@ t8_cmesh_from_msh_file (const char *fileprefix, int partition, sc_MPI_Comm comm,
     return NULL;
   }
 
+  snprintf (current_file, BUFSIZ, "%s.msh", fileprefix);
   if (!partition || mpirank == main_proc) {
-    snprintf (current_file, BUFSIZ, "%s.msh", fileprefix);
     /* Open the file */
     t8_debugf ("Opening file %s\n", current_file);
     file = fopen (current_file, "r");
@@ -1814,7 +2615,7 @@ t8_cmesh_from_msh_file (const char *fileprefix, int partition, sc_MPI_Comm comm,
       return NULL;
     }
     /* Check if msh-file version is compatible. */
-    msh_version = t8_cmesh_check_version_of_msh_file (file);
+    msh_version = t8_cmesh_check_version_of_msh_file (file, &is_binary);
     if (msh_version < 1) {
       /* If reading the MeshFormat-number failed or the version is incompatible, close the file */
       fclose (file);
@@ -1828,6 +2629,23 @@ t8_cmesh_from_msh_file (const char *fileprefix, int partition, sc_MPI_Comm comm,
       }
       return NULL;
     }
+    if (is_binary) {
+      /* Binary files are read by all processes together, see below. */
+      fclose (file);
+      if (use_cad_geometry) {
+        t8_errorf ("WARNING: The cad geometry is not supported for binary msh files\n");
+        t8_cmesh_destroy (&cmesh);
+        if (partition) {
+          /* Communicate to the other processes that reading failed. */
+          main_proc_read_successful = 0;
+          sc_MPI_Bcast (&main_proc_read_successful, 1, sc_MPI_INT, main_proc, comm);
+        }
+        return NULL;
+      }
+      main_proc_read_successful = 2;
+    }
+  }
+  if ((!partition || mpirank == main_proc) && !is_binary) {
     /* read nodes from the file */
     switch (msh_version) {
     case 2:
@@ -1874,13 +2692,27 @@ t8_cmesh_from_msh_file (const char *fileprefix, int partition, sc_MPI_Comm comm,
   if (partition) {
     /* Communicate whether main proc read the cmesh successful.
      * If the main process failed then it called this Bcast already and
-     * terminated. If it was successful, it calls the Bcast now. */
+     * terminated. If it was successful, it calls the Bcast now.
+     * A value of 2 means that the file is binary and has not been read yet. */
     sc_MPI_Bcast (&main_proc_read_successful, 1, sc_MPI_INT, main_proc, comm);
     if (!main_proc_read_successful) {
       t8_debugf ("Main process could not read cmesh successfully.\n");
       t8_cmesh_destroy (&cmesh);
       return NULL;
     }
+  }
+
+  if (main_proc_read_successful == 2) {
+    /* A binary file is read by all processes in parallel and directly distributed among them,
+     * if the cmesh is partitioned. Otherwise, each process reads the file on its own. */
+    if (t8_cmesh_msh_file_binary_read (cmesh, current_file, dim, partition ? comm : sc_MPI_COMM_SELF,
+                                       partition ? main_proc : 0, partition, linear_geometry)) {
+      t8_debugf ("Reading the binary msh file failed.\n");
+      t8_cmesh_destroy (&cmesh);
+      return NULL;
+    }
+  }
+  else if (partition) {
     /* The cmesh is not yet committed, since we set the partitioning before */
     if (mpirank == main_proc) {
       /* The main_proc process sends the number of trees to
@@ -0,0 +1,620 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/** \file t8_cmesh_reorder.cxx
+ *
+ * Reordering of the trees of a cmesh along a space-filling curve.
+ */
+
+#include <t8.h>
+#include <t8_eclass.h>
+#include <t8_cmesh.h>
+#include <t8_cmesh/t8_cmesh_reorder.h>
+#include <t8_cmesh/t8_cmesh_types.h>
+#include <t8_cmesh/t8_cmesh_trees.h>
+#include <t8_geometry/t8_geometry_handler.hxx>
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/* The number of bits per coordinate direction of the curve keys. 3 * 21 = 63 bits fit into a 64-bit key. */
+#define T8_CMESH_REORDER_BITS 21
+
+/* The curve key of a tree together with the global id of the tree in the input cmesh. */
+typedef struct
+{
+  uint64_t key;     /* The curve key of the tree's centroid. */
+  t8_gloidx_t tree; /* The global id of the tree in the input cmesh. */
+} t8_cmesh_reorder_entry_t;
+
+/* The new global id of a tree of the input cmesh. */
+typedef struct
+{
+  t8_gloidx_t old_id; /* The global id in the input cmesh. */
+  t8_gloidx_t new_id; /* The global id in the reordered cmesh. */
+} t8_cmesh_reorder_id_t;
+
+/* A tree as it is sent to its new owner or to a process that has it as a ghost.
+ * It is followed by \a num_attributes attributes, each consisting of a t8_cmesh_reorder_attribute_t
+ * and the attribute data. */
+typedef struct
+{
+  t8_gloidx_t tree;                           /* The global id in the reordered cmesh. */
+  t8_gloidx_t neighbors[T8_ECLASS_MAX_FACES]; /* The new ids of the face neighbors, -1 at the boundary. */
+  int8_t dual_faces[T8_ECLASS_MAX_FACES];     /* The face numbers of the neighbors. */
+  int8_t orientations[T8_ECLASS_MAX_FACES];   /* The orientations of the face connections. */
+  int eclass;                                 /* The eclass of the tree. */
+  int is_ghost;                               /* True if the receiver has this tree as a ghost. */
+  int num_attributes;                         /* The number of attributes that follow. */
+} t8_cmesh_reorder_tree_t;
+
+/* The header of a tree attribute in the send buffer. The attribute data follows directly. */
+typedef struct
+{
+  int package_id; /* The package id of the attribute. */
+  int key;        /* The key of the attribute. */
+  size_t size;    /* The size of the attribute data in bytes. */
+} t8_cmesh_reorder_attribute_t;
+
+static inline bool
+t8_cmesh_reorder_entry_less (const t8_cmesh_reorder_entry_t &entry_a, const t8_cmesh_reorder_entry_t &entry_b)
+{
+  return entry_a.key < entry_b.key || (entry_a.key == entry_b.key && entry_a.tree < entry_b.tree);
+}
+
+/* Compute the Morton key of quantized coordinates by interleaving their bits. */
+static uint64_t
+t8_cmesh_reorder_morton_key (const uint32_t coords[3])
+{
+  uint64_t key = 0;
+  for (int ibit = T8_CMESH_REORDER_BITS - 1; ibit >= 0; --ibit) {
+    for (int idim = 0; idim < 3; ++idim) {
+      key = (key << 1) | ((coords[idim] >> ibit) & 1);
+    }
+  }
+  return key;
+}
+
+/* Compute the Hilbert key of quantized coordinates.
+ * We transform the coordinates into the transposed Hilbert index as described in
+ * J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707 (2004) and interleave its bits. */
+static uint64_t
+t8_cmesh_reorder_hilbert_key (const uint32_t coords[3])
+{
+  uint32_t X[3] = { coords[0], coords[1], coords[2] };
+  const uint32_t M = 1u << (T8_CMESH_REORDER_BITS - 1);
+
+  /* Inverse undo excess work */
+  for (uint32_t Q = M; Q > 1; Q >>= 1) {
+    const uint32_t P = Q - 1;
+    for (int idim = 0; idim < 3; ++idim) {
+      if (X[idim] & Q) {
+        X[0] ^= P;
+      }
+      else {
+        const uint32_t t = (X[0] ^ X[idim]) & P;
+        X[0] ^= t;
+        X[idim] ^= t;
+      }
+    }
+  }
+  /* Gray encode */
+  for (int idim = 1; idim < 3; ++idim) {
+    X[idim] ^= X[idim - 1];
+  }
+  uint32_t t = 0;
+  for (uint32_t Q = M; Q > 1; Q >>= 1) {
+    if (X[2] & Q) {
+      t ^= Q - 1;
+    }
+  }
+  for (int idim = 0; idim < 3; ++idim) {
+    X[idim] ^= t;
+  }
+  return t8_cmesh_reorder_morton_key (X);
+}
+
+/* Given the offsets of a partition, return the process that owns a global id.
+ * Processes without entries have the same offset as their successor and are skipped. */
+static inline int
+t8_cmesh_reorder_owner (const std::vector<t8_gloidx_t> &offsets, const t8_gloidx_t id)
+{
+  T8_ASSERT (offsets.front () <= id && id < offsets.back ());
+  return std::upper_bound (offsets.begin (), offsets.end (), id) - offsets.begin () - 1;
+}
+
+/* Send the entries of send[p] to each process p and receive all entries sent to this process
+ * ordered by the sending process. */
+template <typename T>
+static void
+t8_cmesh_reorder_exchange (const std::vector<std::vector<T>> &send, std::vector<T> &recv, sc_MPI_Comm comm)
+{
+  int mpirank, mpisize, mpiret;
+
+  mpiret = sc_MPI_Comm_size (comm, &mpisize);
+  SC_CHECK_MPI (mpiret);
+  mpiret = sc_MPI_Comm_rank (comm, &mpirank);
+  SC_CHECK_MPI (mpiret);
+  T8_ASSERT ((int) send.size () == mpisize);
+
+  std::vector<int> send_counts (mpisize), recv_counts (mpisize);
+  for (int iproc = 0; iproc < mpisize; ++iproc) {
+    send_counts[iproc] = send[iproc].size () * sizeof (T);
+  }
+  mpiret = sc_MPI_Alltoall (send_counts.data (), 1, sc_MPI_INT, recv_counts.data (), 1, sc_MPI_INT, comm);
+  SC_CHECK_MPI (mpiret);
+
+  std::vector<size_t> recv_offsets (mpisize + 1, 0);
+  for (int iproc = 0; iproc < mpisize; ++iproc) {
+    recv_offsets[iproc + 1] = recv_offsets[iproc] + recv_counts[iproc] / sizeof (T);
+  }
+  recv.resize (recv_offsets[mpisize]);
+
+  std::vector<sc_MPI_Request> requests;
+  requests.reserve (2 * mpisize);
+  for (int iproc = 0; iproc < mpisize; ++iproc) {
+    if (iproc == mpirank) {
+      std::copy (send[iproc].begin (), send[iproc].end (), recv.begin () + recv_offsets[iproc]);
+    }
+    else if (recv_counts[iproc] > 0) {
+      requests.emplace_back ();
+      mpiret = sc_MPI_Irecv (recv.data () + recv_offsets[iproc], recv_counts[iproc], sc_MPI_BYTE, iproc,
+                             T8_MPI_CMESH_REORDER, comm, &requests.back ());
+      SC_CHECK_MPI (mpiret);
+    }
+  }
+  for (int iproc = 0; iproc < mpisize; ++iproc) {
+    if (iproc != mpirank && send_counts[iproc] > 0) {
+      requests.emplace_back ();
+      mpiret = sc_MPI_Isend ((void *) send[iproc].data (), send_counts[iproc], sc_MPI_BYTE, iproc,
+                             T8_MPI_CMESH_REORDER, comm, &requests.back ());
+      SC_CHECK_MPI (mpiret);
+    }
+  }
+  mpiret = sc_MPI_Waitall (requests.size (), requests.data (), sc_MPI_STATUSES_IGNORE);
+  SC_CHECK_MPI (mpiret);
+}
+
+/* Sort the entries of all processes with a sample sort.
+ * Each process sorts its entries and contributes up to mpisize regular samples, from which
+ * mpisize - 1 splitters are chosen. On output, \a entries holds a contiguous and sorted part
+ * of all entries. The parts are ordered by the process rank. */
+static void
+t8_cmesh_reorder_sample_sort (std::vector<t8_cmesh_reorder_entry_t> &entries, sc_MPI_Comm comm)
+{
+  int mpisize, mpiret;
+
+  mpiret = sc_MPI_Comm_size (comm, &mpisize);
+  SC_CHECK_MPI (mpiret);
+
+  std::sort (entries.begin (), entries.end (), t8_cmesh_reorder_entry_less);
+  if (mpisize == 1) {
+    return;
+  }
+
+  /* Gather the regular samples of all processes. */
+  const size_t num_entries = entries.size ();
+  const int num_samples = (int) SC_MIN ((size_t) mpisize, num_entries);
+  std::vector<t8_cmesh_reorder_entry_t> samples (num_samples);
+  for (int isample = 0; isample < num_samples; ++isample) {
+    samples[isample] = entries[isample * num_entries / num_samples];
+  }
+  std::vector<int> sample_bytes (mpisize), sample_displs (mpisize + 1, 0);
+  const int num_sample_bytes = num_samples * sizeof (t8_cmesh_reorder_entry_t);
+  mpiret = sc_MPI_Allgather ((void *) &num_sample_bytes, 1, sc_MPI_INT, sample_bytes.data (), 1, sc_MPI_INT, comm);
+  SC_CHECK_MPI (mpiret);
+  for (int iproc = 0; iproc < mpisize; ++iproc) {
+    sample_displs[iproc + 1] = sample_displs[iproc] + sample_bytes[iproc];
+  }
+  std::vector<t8_cmesh_reorder_entry_t> all_samples (sample_displs[mpisize] / sizeof (t8_cmesh_reorder_entry_t));
+  mpiret = sc_MPI_Allgatherv ((void *) samples.data (), num_sample_bytes, sc_MPI_BYTE, all_samples.data (),
+                              sample_bytes.data (), sample_displs.data (), sc_MPI_BYTE, comm);
+  SC_CHECK_MPI (mpiret);
+  std::sort (all_samples.begin (), all_samples.end (), t8_cmesh_reorder_entry_less);
+
+  /* Process p receives all entries between splitter p - 1 and splitter p. */
+  std::vector<t8_cmesh_reorder_entry_t> splitters;
+  for (int iproc = 1; iproc < mpisize && !all_samples.empty (); ++iproc) {
+    splitters.push_back (all_samples[iproc * all_samples.size () / mpisize]);
+  }
+  std::vector<std::vector<t8_cmesh_reorder_entry_t>> send (mpisize);
+  int dest = 0;
+  for (const t8_cmesh_reorder_entry_t &entry : entries) {
+    while (dest < (int) splitters.size () && !t8_cmesh_reorder_entry_less (entry, splitters[dest])) {
+      ++dest;
+    }
+    send[dest].push_back (entry);
+  }
+  t8_cmesh_reorder_exchange (send, entries, comm);
+  std::sort (entries.begin (), entries.end (), t8_cmesh_reorder_entry_less);
+}
+
+/* Append a tree with all its attributes to a send buffer. */
+static void
+t8_cmesh_reorder_pack_tree (std::vector<char> &buffer, const t8_cmesh_reorder_tree_t *header, const t8_ctree_t tree)
+{
+  const char *header_bytes = (const char *) header;
+  buffer.insert (buffer.end (), header_bytes, header_bytes + sizeof (t8_cmesh_reorder_tree_t));
+  for (int iattribute = 0; iattribute < tree->num_attributes; ++iattribute) {
+    const t8_attribute_info_struct_t *info = T8_TREE_ATTR_INFO (tree, iattribute);
+    t8_cmesh_reorder_attribute_t attribute;
+    attribute.package_id = info->package_id;
+    attribute.key = info->key;
+    attribute.size = info->attribute_size;
+    const char *attribute_bytes = (const char *) &attribute;
+    buffer.insert (buffer.end (), attribute_bytes, attribute_bytes + sizeof (t8_cmesh_reorder_attribute_t));
+    const char *data = T8_TREE_ATTR (tree, info);
+    buffer.insert (buffer.end (), data, data + info->attribute_size);
+  }
+}
+
+/* Call \a tree_fn for each tree in a received buffer.
+ * \a tree_fn is called with the tree header and the position of its first attribute in the buffer. */
+template <typename F>
+static void
+t8_cmesh_reorder_unpack_trees (const std::vector<char> &buffer, F tree_fn)
+{
+  size_t position = 0;
+  while (position < buffer.size ()) {
+    t8_cmesh_reorder_tree_t header;
+    memcpy (&header, buffer.data () + position, sizeof (t8_cmesh_reorder_tree_t));
+    position += sizeof (t8_cmesh_reorder_tree_t);
+    tree_fn (header, position);
+    for (int iattribute = 0; iattribute < header.num_attributes; ++iattribute) {
+      t8_cmesh_reorder_attribute_t attribute;
+      memcpy (&attribute, buffer.data () + position, sizeof (t8_cmesh_reorder_attribute_t));
+      position += sizeof (t8_cmesh_reorder_attribute_t) + attribute.size;
+    }
+  }
+  T8_ASSERT (position == buffer.size ());
+}
+
+t8_cmesh_t
+t8_cmesh_new_reorder_sfc (t8_cmesh_t cmesh, const t8_cmesh_sfc_type_t sfc_type, sc_MPI_Comm comm,
+                          t8_cmesh_reorder_stats_t *stats)
+{
+  int mpirank, mpisize, mpiret;
+
+  T8_ASSERT (t8_cmesh_is_committed (cmesh));
+  T8_ASSERT (t8_cmesh_comm_is_valid (cmesh, comm));
+  T8_ASSERT (sfc_type == T8_CMESH_SFC_MORTON || sfc_type == T8_CMESH_SFC_HILBERT);
+
+  /* A replicated cmesh is reordered by each process on its own. */
+  const int partitioned = t8_cmesh_is_partitioned (cmesh);
+  sc_MPI_Comm sort_comm = partitioned ? comm : sc_MPI_COMM_SELF;
+  mpiret = sc_MPI_Comm_size (sort_comm, &mpisize);
+  SC_CHECK_MPI (mpiret);
+  mpiret = sc_MPI_Comm_rank (sort_comm, &mpirank);
+  SC_CHECK_MPI (mpiret);
+
+  /* Each tree is handled by exactly one process. A first local tree that is shared with
+   * the previous process is handled by the previous process. */
+  const t8_locidx_t num_local_trees = t8_cmesh_get_num_local_trees (cmesh);
+  const t8_locidx_t first_ltree = partitioned && num_local_trees > 0 && cmesh->first_tree_shared ? 1 : 0;
+  const t8_locidx_t num_trees = num_local_trees - first_ltree;
+  const t8_gloidx_t first_tree = num_trees > 0 ? t8_cmesh_get_first_treeid (cmesh) + first_ltree : 0;
+  const t8_gloidx_t num_global_trees = t8_cmesh_get_num_trees (cmesh);
+
+  /* Compute the offsets of the trees handled by each process. */
+  std::vector<t8_gloidx_t> old_offsets (mpisize + 1, 0);
+  const t8_gloidx_t num_trees_g = num_trees;
+  mpiret = sc_MPI_Allgather ((void *) &num_trees_g, 1, T8_MPI_GLOIDX, old_offsets.data () + 1, 1, T8_MPI_GLOIDX,
+                             sort_comm);
+  SC_CHECK_MPI (mpiret);
+  for (int iproc = 0; iproc < mpisize; ++iproc) {
+    old_offsets[iproc + 1] += old_offsets[iproc];
+  }
+  T8_ASSERT (old_offsets[mpisize] == num_global_trees);
+  T8_ASSERT (num_trees == 0 || old_offsets[mpirank] == first_tree);
+
+  /* Compute the centroids of the trees and their bounding box.
+   * We store the negative minimum to compute minimum and maximum with one reduction. */
+  std::vector<double> centroids (3 * num_trees, 0);
+  double local_bounds[6] = { -DBL_MAX, -DBL_MAX, -DBL_MAX, -DBL_MAX, -DBL_MAX, -DBL_MAX };
+  for (t8_locidx_t itree = 0; itree < num_trees; ++itree) {
+    const t8_locidx_t ltree = first_ltree + itree;
+    const double *vertices = t8_cmesh_get_tree_vertices (cmesh, ltree);
+    SC_CHECK_ABORT (vertices != NULL, "Reordering a cmesh along a space-filling curve requires tree vertices.");
+    const int num_vertices = t8_eclass_num_vertices[t8_cmesh_get_tree_class (cmesh, ltree)];
+    for (int ivertex = 0; ivertex < num_vertices; ++ivertex) {
+      for (int idim = 0; idim < 3; ++idim) {
+        centroids[3 * itree + idim] += vertices[3 * ivertex + idim] / num_vertices;
+      }
+    }
+    for (int idim = 0; idim < 3; ++idim) {
+      local_bounds[idim] = SC_MAX (local_bounds[idim], -centroids[3 * itree + idim]);
+      local_bounds[3 + idim] = SC_MAX (local_bounds[3 + idim], centroids[3 * itree + idim]);
+    }
+  }
+  double bounds[6];
+  mpiret = sc_MPI_Allreduce (local_bounds, bounds, 6, sc_MPI_DOUBLE, sc_MPI_MAX, sort_comm);
+  SC_CHECK_MPI (mpiret);
+
+  /* Quantize the centroids on a cube around their bounding box and compute the curve keys. */
+  double extent = 0;
+  for (int idim = 0; idim < 3; ++idim) {
+    extent = SC_MAX (extent, bounds[3 + idim] + bounds[idim]);
+  }
+  const double max_coord = (double) ((1u << T8_CMESH_REORDER_BITS) - 1);
+  const double scale = extent > 0 ? max_coord / extent : 0;
+  std::vector<t8_cmesh_reorder_entry_t> entries (num_trees);
+  for (t8_locidx_t itree = 0; itree < num_trees; ++itree) {
+    uint32_t coords[3];
+    for (int idim = 0; idim < 3; ++idim) {
+      const double coord = (centroids[3 * itree + idim] + bounds[idim]) * scale;
+      coords[idim] = (uint32_t) SC_MAX (0., SC_MIN (max_coord, coord));
+    }
+    entries[itree].key = sfc_type == T8_CMESH_SFC_HILBERT ? t8_cmesh_reorder_hilbert_key (coords)
+                                                          : t8_cmesh_reorder_morton_key (coords);
+    entries[itree].tree = first_tree + itree;
+  }
+  centroids.clear ();
+
+  /* Sort the trees along the curve. The position of a tree in the sorted sequence is its new id. */
+  t8_cmesh_reorder_sample_sort (entries, sort_comm);
+  std::vector<t8_gloidx_t> sorted_offsets (mpisize + 1, 0);
+  const t8_gloidx_t num_sorted = entries.size ();
+  mpiret = sc_MPI_Allgather ((void *) &num_sorted, 1, T8_MPI_GLOIDX, sorted_offsets.data () + 1, 1, T8_MPI_GLOIDX,
+                             sort_comm);
+  SC_CHECK_MPI (mpiret);
+  for (int iproc = 0; iproc < mpisize; ++iproc) {
+    sorted_offsets[iproc + 1] += sorted_offsets[iproc];
+  }
+
+  /* Send the new ids back to the processes that handle the trees. */
+  std::vector<std::vector<t8_cmesh_reorder_id_t>> id_send (mpisize);
+  for (size_t ientry = 0; ientry < entries.size (); ++ientry) {
+    const t8_cmesh_reorder_id_t id = { entries[ientry].tree, sorted_offsets[mpirank] + (t8_gloidx_t) ientry };
+    id_send[t8_cmesh_reorder_owner (old_offsets, id.old_id)].push_back (id);
+  }
+  entries.clear ();
+  std::vector<t8_cmesh_reorder_id_t> ids;
+  t8_cmesh_reorder_exchange (id_send, ids, sort_comm);
+  std::vector<t8_gloidx_t> new_ids (num_trees, -1);
+  for (const t8_cmesh_reorder_id_t &id : ids) {
+    new_ids[id.old_id - first_tree] = id.new_id;
+  }
+
+  /* Collect the face neighbors of the trees. Face connections are symmetric, so we send the new id
+   * of each tree to the processes that handle its neighbors and thus learn the new ids of our neighbors. */
+  std::vector<t8_gloidx_t> neighbors (num_trees * T8_ECLASS_MAX_FACES, -1);
+  std::vector<int8_t> dual_faces (num_trees * T8_ECLASS_MAX_FACES, -1);
+  std::vector<int8_t> orientations (num_trees * T8_ECLASS_MAX_FACES, 0);
+  for (auto &send : id_send) {
+    send.clear ();
+  }
+  for (t8_locidx_t itree = 0; itree < num_trees; ++itree) {
+    const t8_locidx_t ltree = first_ltree + itree;
+    const int num_faces = t8_eclass_num_faces[t8_cmesh_get_tree_class (cmesh, ltree)];
+    for (int iface = 0; iface < num_faces; ++iface) {
+      int dual_face, orientation;
+      const t8_locidx_t neighbor = t8_cmesh_get_face_neighbor (cmesh, ltree, iface, &dual_face, &orientation);
+      if (neighbor < 0) {
+        continue;
+      }
+      const t8_gloidx_t gneighbor = t8_cmesh_get_global_id (cmesh, neighbor);
+      neighbors[itree * T8_ECLASS_MAX_FACES + iface] = gneighbor;
+      dual_faces[itree * T8_ECLASS_MAX_FACES + iface] = dual_face;
+      orientations[itree * T8_ECLASS_MAX_FACES + iface] = orientation;
+      const int owner = t8_cmesh_reorder_owner (old_offsets, gneighbor);
+      if (owner != mpirank) {
+        id_send[owner].push_back ({ first_tree + itree, new_ids[itree] });
+      }
+    }
+  }
+  for (auto &send : id_send) {
+    std::sort (send.begin (), send.end (), [] (const t8_cmesh_reorder_id_t &id_a, const t8_cmesh_reorder_id_t &id_b) {
+      return id_a.old_id < id_b.old_id;
+    });
+    send.erase (std::unique (send.begin (), send.end (),
+                             [] (const t8_cmesh_reorder_id_t &id_a, const t8_cmesh_reorder_id_t &id_b) {
+                               return id_a.old_id == id_b.old_id;
+                             }),
+                send.end ());
+  }
+  t8_cmesh_reorder_exchange (id_send, ids, sort_comm);
+  id_send.clear ();
+  std::unordered_map<t8_gloidx_t, t8_gloidx_t> remote_new_ids;
+  for (const t8_cmesh_reorder_id_t &id : ids) {
+    remote_new_ids[id.old_id] = id.new_id;
+  }
+  ids.clear ();
+  auto get_new_id = [&] (const t8_gloidx_t old_id) {
+    if (first_tree <= old_id && old_id < first_tree + num_trees) {
+      return new_ids[old_id - first_tree];
+    }
+    T8_ASSERT (remote_new_ids.count (old_id) == 1);
+    return remote_new_ids[old_id];
+  };
+
+  /* The new partition gives each process the same number of trees. */
+  std::vector<t8_gloidx_t> new_offsets (mpisize + 1);
+  for (int iproc = 0; iproc <= mpisize; ++iproc) {
+    new_offsets[iproc] = num_global_trees * iproc / mpisize;
+  }
+
+  /* Send each tree to its new owner and to the new owners of its neighbors, which have it as a ghost. */
+  std::vector<std::vector<char>> tree_send (mpisize);
+  std::vector<int> ghost_receivers;
+  for (t8_locidx_t itree = 0; itree < num_trees; ++itree) {
+    const t8_locidx_t ltree = first_ltree + itree;
+    const t8_ctree_t tree = t8_cmesh_trees_get_tree (cmesh->trees, ltree);
+    t8_cmesh_reorder_tree_t header;
+    memset (&header, 0, sizeof (t8_cmesh_reorder_tree_t));
+    header.tree = new_ids[itree];
+    header.eclass = tree->eclass;
+    header.num_attributes = tree->num_attributes;
+    const int owner = t8_cmesh_reorder_owner (new_offsets, header.tree);
+    ghost_receivers.clear ();
+    for (int iface = 0; iface < T8_ECLASS_MAX_FACES; ++iface) {
+      const t8_gloidx_t neighbor = neighbors[itree * T8_ECLASS_MAX_FACES + iface];
+      header.neighbors[iface] = neighbor >= 0 ? get_new_id (neighbor) : -1;
+      header.dual_faces[iface] = dual_faces[itree * T8_ECLASS_MAX_FACES + iface];
+      header.orientations[iface] = orientations[itree * T8_ECLASS_MAX_FACES + iface];
+      if (neighbor >= 0) {
+        const int neighbor_owner = t8_cmesh_reorder_owner (new_offsets, header.neighbors[iface]);
+        if (neighbor_owner != owner) {
+          ghost_receivers.push_back (neighbor_owner);
+        }
+      }
+    }
+    t8_cmesh_reorder_pack_tree (tree_send[owner], &header, tree);
+    std::sort (ghost_receivers.begin (), ghost_receivers.end ());
+    ghost_receivers.erase (std::unique (ghost_receivers.begin (), ghost_receivers.end ()), ghost_receivers.end ());
+    header.is_ghost = 1;
+    for (const int receiver : ghost_receivers) {
+      t8_cmesh_reorder_pack_tree (tree_send[receiver], &header, tree);
+    }
+  }
+  std::vector<char> trees;
+  t8_cmesh_reorder_exchange (tree_send, trees, sort_comm);
+  tree_send.clear ();
+
+  /* Build the new cmesh from the received trees. */
+  t8_cmesh_t cmesh_new;
+  t8_cmesh_init (&cmesh_new);
+  t8_cmesh_set_dimension (cmesh_new, cmesh->dimension);
+  const t8_gloidx_t new_first_tree = new_offsets[mpirank];
+  const t8_gloidx_t new_last_tree = new_offsets[mpirank + 1] - 1;
+  auto is_local = [new_first_tree, new_last_tree] (const t8_gloidx_t tree) {
+    return new_first_tree <= tree && tree <= new_last_tree;
+  };
+  std::unordered_set<t8_gloidx_t> ghosts;
+  t8_cmesh_reorder_unpack_trees (trees, [&] (const t8_cmesh_reorder_tree_t &header, size_t) {
+    T8_ASSERT (header.is_ghost == !is_local (header.tree));
+    if (header.is_ghost) {
+      ghosts.insert (header.tree);
+    }
+  });
+  t8_cmesh_reorder_unpack_trees (trees, [&] (const t8_cmesh_reorder_tree_t &header, size_t position) {
+    const t8_eclass_t eclass = (t8_eclass_t) header.eclass;
+    t8_cmesh_set_tree_class (cmesh_new, header.tree, eclass);
+    for (int iattribute = 0; iattribute < header.num_attributes; ++iattribute) {
+      t8_cmesh_reorder_attribute_t attribute;
+      memcpy (&attribute, trees.data () + position, sizeof (t8_cmesh_reorder_attribute_t));
+      position += sizeof (t8_cmesh_reorder_attribute_t);
+      t8_cmesh_set_attribute (cmesh_new, header.tree, attribute.package_id, attribute.key,
+                              (void *) (trees.data () + position), attribute.size, 0);
+      position += attribute.size;
+    }
+    /* Each face connection is set once. Connections between a local tree and a ghost are set
+     * by the local tree, connections between two ghosts or two local trees by the smaller face. */
+    for (int iface = 0; iface < t8_eclass_num_faces[eclass]; ++iface) {
+      const t8_gloidx_t neighbor = header.neighbors[iface];
+      if (neighbor < 0) {
+        continue;
+      }
+      const int dual_face = header.dual_faces[iface];
+      const int neighbor_is_local = is_local (neighbor);
+      const int same_kind = header.is_ghost ? !neighbor_is_local && ghosts.count (neighbor) > 0 : neighbor_is_local;
+      if (header.is_ghost && neighbor_is_local) {
+        continue;
+      }
+      if (same_kind && (neighbor < header.tree || (neighbor == header.tree && dual_face < iface))) {
+        continue;
+      }
+      t8_cmesh_set_join (cmesh_new, header.tree, neighbor, iface, dual_face, header.orientations[iface]);
+    }
+  });
+  trees.clear ();
+
+  if (partitioned) {
+    t8_cmesh_set_partition_range (cmesh_new, 3, new_first_tree, new_last_tree);
+  }
+  if (cmesh->geometry_handler != NULL) {
+    /* The new cmesh uses the same geometries. */
+    cmesh_new->geometry_handler = cmesh->geometry_handler;
+    cmesh_new->geometry_handler->ref ();
+  }
+  t8_cmesh_commit (cmesh_new, comm);
+
+  if (stats != NULL) {
+    stats->edge_cut_before = t8_cmesh_get_partition_edge_cut (cmesh, comm, &stats->num_face_connections);
+    stats->edge_cut_after = t8_cmesh_get_partition_edge_cut (cmesh_new, comm, NULL);
+  }
+  return cmesh_new;
+}
+
+t8_gloidx_t
+t8_cmesh_get_partition_edge_cut (t8_cmesh_t cmesh, sc_MPI_Comm comm, t8_gloidx_t *num_face_connections)
+{
+  int mpirank, mpisize, mpiret;
+
+  T8_ASSERT (t8_cmesh_is_committed (cmesh));
+  T8_ASSERT (t8_cmesh_comm_is_valid (cmesh, comm));
+
+  mpiret = sc_MPI_Comm_size (comm, &mpisize);
+  SC_CHECK_MPI (mpiret);
+  mpiret = sc_MPI_Comm_rank (comm, &mpirank);
+  SC_CHECK_MPI (mpiret);
+
+  /* Each connection is counted from both sides. */
+  t8_gloidx_t local_counts[2] = { 0, 0 };
+  const t8_locidx_t num_local_trees = t8_cmesh_get_num_local_trees (cmesh);
+  if (t8_cmesh_is_partitioned (cmesh)) {
+    /* A shared first tree is counted by the previous process. */
+    const t8_locidx_t first_ltree = num_local_trees > 0 && cmesh->first_tree_shared ? 1 : 0;
+    for (t8_locidx_t ltree = first_ltree; ltree < num_local_trees; ++ltree) {
+      const int num_faces = t8_eclass_num_faces[t8_cmesh_get_tree_class (cmesh, ltree)];
+      for (int iface = 0; iface < num_faces; ++iface) {
+        const t8_locidx_t neighbor = t8_cmesh_get_face_neighbor (cmesh, ltree, iface, NULL, NULL);
+        if (neighbor < 0 || neighbor == ltree) {
+          continue;
+        }
+        local_counts[0]++;
+        if (t8_cmesh_treeid_is_ghost (cmesh, neighbor) || neighbor < first_ltree) {
+          local_counts[1]++;
+        }
+      }
+    }
+  }
+  else {
+    /* Each process computes the edge cut of all trees. */
+    const t8_gloidx_t num_trees = t8_cmesh_get_num_trees (cmesh);
+    for (t8_locidx_t ltree = 0; ltree < num_local_trees; ++ltree) {
+      const int owner = (int) (((t8_gloidx_t) ltree * mpisize + mpisize - 1) / num_trees);
+      const int num_faces = t8_eclass_num_faces[t8_cmesh_get_tree_class (cmesh, ltree)];
+      for (int iface = 0; iface < num_faces; ++iface) {
+        const t8_locidx_t neighbor = t8_cmesh_get_face_neighbor (cmesh, ltree, iface, NULL, NULL);
+        if (neighbor < 0 || neighbor == ltree) {
+          continue;
+        }
+        local_counts[0]++;
+        if (owner != (int) (((t8_gloidx_t) neighbor * mpisize + mpisize - 1) / num_trees)) {
+          local_counts[1]++;
+        }
+      }
+    }
+  }
+  t8_gloidx_t counts[2] = { local_counts[0], local_counts[1] };
+  if (t8_cmesh_is_partitioned (cmesh)) {
+    mpiret = sc_MPI_Allreduce (local_counts, counts, 2, T8_MPI_GLOIDX, sc_MPI_SUM, comm);
+    SC_CHECK_MPI (mpiret);
+  }
+  if (num_face_connections != NULL) {
+    *num_face_connections = counts[0] / 2;
+  }
+  return counts[1] / 2;
+}
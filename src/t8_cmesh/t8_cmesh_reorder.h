@@ -0,0 +1,93 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/** \file t8_cmesh_reorder.h
+ *
+ * Reorder the trees of a coarse mesh along a space-filling curve.
+ * In contrast to \ref t8_cmesh_reorder this does not need METIS and works on
+ * replicated as well as on partitioned cmeshes.
+ */
+
+#ifndef T8_CMESH_REORDER_H
+#define T8_CMESH_REORDER_H
+
+#include <t8.h>
+#include <t8_cmesh.h>
+
+/** The space-filling curves that can be used to reorder the trees of a cmesh. */
+typedef enum t8_cmesh_sfc_type {
+  T8_CMESH_SFC_MORTON = 0, /**< Order the trees along the Morton curve. */
+  T8_CMESH_SFC_HILBERT     /**< Order the trees along the Hilbert curve. */
+} t8_cmesh_sfc_type_t;
+
+/** Statistics about a reordering with \ref t8_cmesh_new_reorder_sfc. */
+typedef struct t8_cmesh_reorder_stats
+{
+  t8_gloidx_t num_face_connections; /**< The global number of face connections between two trees. */
+  t8_gloidx_t edge_cut_before;      /**< The partition edge cut of the input cmesh. */
+  t8_gloidx_t edge_cut_after;       /**< The partition edge cut of the reordered cmesh. */
+} t8_cmesh_reorder_stats_t;
+
+T8_EXTERN_C_BEGIN ();
+
+/** Create a new cmesh whose trees are ordered along a space-filling curve.
+ * Each tree is represented by the centroid of its vertices. The centroids are
+ * mapped to 63-bit keys of a Morton or Hilbert curve on the bounding box of all
+ * centroids and the trees are sorted by these keys with a distributed sample sort.
+ * Trees with equal keys keep their relative order.
+ * The tree ids, the face connections and all attributes, including the vertices,
+ * are moved to the new cmesh. The new cmesh uses the geometries of \a cmesh.
+ * \param [in]  cmesh     A committed cmesh. Each tree must have vertices.
+ *                        If \a cmesh is replicated, every process computes the same
+ *                        reordering without communication and the new cmesh is replicated.
+ *                        If \a cmesh is partitioned, the new cmesh is partitioned such that
+ *                        each process has the same number of trees (up to one).
+ * \param [in]  sfc_type  The space-filling curve to use.
+ * \param [in]  comm      The MPI communicator of \a cmesh.
+ * \param [out] stats     If not NULL, filled with the edge cut before and after the reordering.
+ *                        See \ref t8_cmesh_get_partition_edge_cut.
+ * \return                The new committed cmesh. \a cmesh is not modified and must still be destroyed by the caller.
+ * \note The tree with global id i of the new cmesh is the i-th tree along the curve.
+ */
+t8_cmesh_t
+t8_cmesh_new_reorder_sfc (t8_cmesh_t cmesh, const t8_cmesh_sfc_type_t sfc_type, sc_MPI_Comm comm,
+                          t8_cmesh_reorder_stats_t *stats);
+
+/** Compute the number of face connections between trees of different processes.
+ * If \a cmesh is partitioned, its current partition is used. If \a cmesh is replicated,
+ * the edge cut is computed for the partition in which each process of \a comm gets the
+ * same number of consecutive trees (up to one).
+ * Connections of a tree to itself are never counted.
+ * This can be used to compare an ordering of the trees with the one computed by
+ * \ref t8_cmesh_reorder.
+ * \param [in]  cmesh     A committed cmesh.
+ * \param [in]  comm      The MPI communicator of \a cmesh.
+ * \param [out] num_face_connections If not NULL, the global number of face connections between two trees.
+ * \return                The global number of face connections across the partition boundaries.
+ *                        This is the same on each process.
+ */
+t8_gloidx_t
+t8_cmesh_get_partition_edge_cut (t8_cmesh_t cmesh, sc_MPI_Comm comm, t8_gloidx_t *num_face_connections);
+
+T8_EXTERN_C_END ();
+
+#endif /* !T8_CMESH_REORDER_H */
@@ -82,6 +82,7 @@ t8_cmesh_trees_init (t8_cmesh_trees_t *ptrees, int num_procs, t8_locidx_t num_tr
   /* Initialize the global_id hash table */
   trees->ghost_globalid_to_local_id
     = sc_hash_new (t8_cmesh_trees_glo_lo_hash_func, t8_cmesh_trees_glo_lo_hash_equal, NULL, NULL);
+  trees->shmem = NULL;
 }
 
 void
@@ -970,17 +971,150 @@ t8_cmesh_trees_bcast (t8_cmesh_t cmesh_in, int root, sc_MPI_Comm comm)
     if (mpirank != root) {
       part->first_tree_id = part_info.first_tree_id;
       part->num_trees = part_info.num_trees;
-      /* Allocate memory for part's trees */
-      part->first_tree = T8_ALLOC (char, part_info.num_bytes);
+      /* Allocate memory for part's trees, unless they are stored in shared memory */
+      part->first_tree = cmesh_in->set_shmem ? NULL : T8_ALLOC (char, part_info.num_bytes);
       part->num_ghosts = 0;
       part->first_ghost_id = 0;
     }
-    /* Bcast the part information */
-    mpiret = sc_MPI_Bcast (part->first_tree, part_info.num_bytes, sc_MPI_BYTE, root, comm);
-    SC_CHECK_MPI (mpiret);
+    if (!cmesh_in->set_shmem) {
+      /* Bcast the part information */
+      mpiret = sc_MPI_Bcast (part->first_tree, part_info.num_bytes, sc_MPI_BYTE, root, comm);
+      SC_CHECK_MPI (mpiret);
+    }
   } /* end for */
-  /* Bcast the tree_to_proc array */
-  sc_MPI_Bcast (trees->tree_to_proc, cmesh_in->num_trees, sc_MPI_INT, root, comm);
+  if (cmesh_in->set_shmem) {
+    /* Bcast the parts and the tree_to_proc array into shared memory */
+    t8_cmesh_trees_share (trees, cmesh_in->num_trees, root, comm);
+  }
+  else {
+    /* Bcast the tree_to_proc array */
+    sc_MPI_Bcast (trees->tree_to_proc, cmesh_in->num_trees, sc_MPI_INT, root, comm);
+  }
+}
+
+/* The maximum number of bytes that t8_cmesh_trees_share sends in one broadcast. */
+#define T8_CMESH_TREES_SHARE_CHUNK (1 << 30)
+
+/* Copy the tree_to_proc array and the parts of a trees structure
+ * to the layout in shared memory that is given by offsets. */
+static void
+t8_cmesh_trees_pack_shared (t8_cmesh_trees_t trees, t8_locidx_t num_trees, const size_t *offsets, char *buffer)
+{
+  size_t ipart;
+  const size_t num_parts = trees->from_proc->elem_count;
+  t8_part_tree_t part;
+
+  /* Zero the padding bytes, such that two trees can be compared with memcmp */
+  memset (buffer, 0, offsets[num_parts + 1]);
+  memcpy (buffer, trees->tree_to_proc, num_trees * sizeof (int));
+  for (ipart = 0; ipart < num_parts; ipart++) {
+    part = t8_cmesh_trees_get_part (trees, ipart);
+    memcpy (buffer + offsets[ipart + 1], part->first_tree, t8_cmesh_trees_get_part_alloc (trees, part));
+  }
+}
+
+void
+t8_cmesh_trees_share (t8_cmesh_trees_t trees, t8_locidx_t num_trees, int root, sc_MPI_Comm comm)
+{
+  int mpirank, mpiret;
+  size_t ipart, total_bytes;
+  const size_t num_parts = trees->from_proc->elem_count;
+  size_t *offsets;
+  t8_shmem_array_t shmem;
+  t8_part_tree_t part;
+  char *shared;
+
+  T8_ASSERT (trees != NULL);
+  T8_ASSERT (trees->ghost_to_proc == NULL);
+  mpiret = sc_MPI_Comm_rank (comm, &mpirank);
+  SC_CHECK_MPI (mpiret);
+
+  /* The shared memory stores the tree_to_proc array followed by the parts.
+   * offsets[0] is the offset of tree_to_proc and offsets[ipart + 1] the offset of a part,
+   * each padded such that the trees are aligned. */
+  offsets = T8_ALLOC_ZERO (size_t, num_parts + 2);
+  offsets[1] = num_trees * sizeof (int);
+  offsets[1] += T8_ADD_PADDING (offsets[1]);
+  if (root < 0 || mpirank == root) {
+    for (ipart = 0; ipart < num_parts; ipart++) {
+      part = t8_cmesh_trees_get_part (trees, ipart);
+      offsets[ipart + 2] = offsets[ipart + 1] + t8_cmesh_trees_get_part_alloc (trees, part);
+      offsets[ipart + 2] += T8_ADD_PADDING (offsets[ipart + 2]);
+    }
+  }
+  if (root >= 0) {
+    mpiret = sc_MPI_Bcast (offsets, (num_parts + 2) * sizeof (size_t), sc_MPI_BYTE, root, comm);
+    SC_CHECK_MPI (mpiret);
+  }
+  total_bytes = offsets[num_parts + 1];
+  if (total_bytes == 0) {
+    /* There are no trees to share */
+    T8_FREE (offsets);
+    return;
+  }
+
+  t8_shmem_init (comm);
+  t8_shmem_array_init (&shmem, sizeof (char), total_bytes, comm);
+  if (root < 0) {
+    /* Each process has the trees, the writing processes copy them */
+    if (t8_shmem_array_start_writing (shmem)) {
+      t8_cmesh_trees_pack_shared (trees, num_trees, offsets, (char *) t8_shmem_array_index_for_writing (shmem, 0));
+    }
+    t8_shmem_array_end_writing (shmem);
+  }
+  else {
+    /* Only root has the trees. Root and the writing process of each node
+     * form a communicator in which root broadcasts the trees directly into the
+     * shared memory of the nodes. We send in chunks, since the trees of large
+     * meshes may exceed the int range of MPI counts. */
+    const int is_writing = t8_shmem_array_start_writing (shmem);
+    const int in_bcast = is_writing || mpirank == root;
+    sc_MPI_Comm bcast_comm;
+    char *buffer;
+    size_t offset;
+
+    /* Root gets the rank 0 in the new communicator. The other processes form a second one that is not used. */
+    mpiret = sc_MPI_Comm_split (comm, in_bcast, mpirank == root ? 0 : mpirank + 1, &bcast_comm);
+    SC_CHECK_MPI (mpiret);
+    if (in_bcast) {
+      /* If root does not write to the shared memory of its node, it packs the trees into a temporary buffer */
+      buffer = is_writing ? (char *) t8_shmem_array_index_for_writing (shmem, 0) : T8_ALLOC (char, total_bytes);
+      if (mpirank == root) {
+        t8_cmesh_trees_pack_shared (trees, num_trees, offsets, buffer);
+      }
+      for (offset = 0; offset < total_bytes; offset += T8_CMESH_TREES_SHARE_CHUNK) {
+        const int chunk_bytes = (int) SC_MIN ((size_t) T8_CMESH_TREES_SHARE_CHUNK, total_bytes - offset);
+        mpiret = sc_MPI_Bcast (buffer + offset, chunk_bytes, sc_MPI_BYTE, 0, bcast_comm);
+        SC_CHECK_MPI (mpiret);
+      }
+      if (!is_writing) {
+        T8_FREE (buffer);
+      }
+    }
+    mpiret = sc_MPI_Comm_free (&bcast_comm);
+    SC_CHECK_MPI (mpiret);
+    t8_shmem_array_end_writing (shmem);
+  }
+
+  /* Free the process local memory and use the shared memory instead */
+  if (trees->shmem != NULL) {
+    t8_shmem_array_destroy (&trees->shmem);
+  }
+  else {
+    for (ipart = 0; ipart < num_parts; ipart++) {
+      part = t8_cmesh_trees_get_part (trees, ipart);
+      T8_FREE (part->first_tree);
+    }
+    T8_FREE (trees->tree_to_proc);
+  }
+  shared = (char *) t8_shmem_array_get_array (shmem);
+  trees->tree_to_proc = (int *) shared;
+  for (ipart = 0; ipart < num_parts; ipart++) {
+    part = t8_cmesh_trees_get_part (trees, ipart);
+    part->first_tree = shared + offsets[ipart + 1];
+  }
+  trees->shmem = shmem;
+  T8_FREE (offsets);
 }
 
 /* Check whether for each tree its neighbors are set consistently, that means that
@@ -1178,12 +1312,18 @@ t8_cmesh_trees_destroy (t8_cmesh_trees_t *ptrees)
   t8_cmesh_trees_t trees = *ptrees;
   t8_part_tree_t part;
 
-  for (proc = 0; proc < trees->from_proc->elem_count; proc++) {
-    part = t8_cmesh_trees_get_part (trees, proc);
-    T8_FREE (part->first_tree);
+  if (trees->shmem != NULL) {
+    /* The parts and the tree_to_proc array are stored in shared memory */
+    t8_shmem_array_destroy (&trees->shmem);
+  }
+  else {
+    for (proc = 0; proc < trees->from_proc->elem_count; proc++) {
+      part = t8_cmesh_trees_get_part (trees, proc);
+      T8_FREE (part->first_tree);
+    }
+    T8_FREE (trees->tree_to_proc);
   }
   T8_FREE (trees->ghost_to_proc);
-  T8_FREE (trees->tree_to_proc);
   sc_array_destroy (trees->from_proc);
   /* Free the hash table */
 
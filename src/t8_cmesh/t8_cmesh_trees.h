@@ -492,6 +492,24 @@ t8_cmesh_trees_print (t8_cmesh_t cmesh, t8_cmesh_trees_t trees);
 void
 t8_cmesh_trees_bcast (t8_cmesh_t cmesh_in, int root, sc_MPI_Comm comm);
 
+/** Store the parts and the tree_to_proc array of a replicated trees structure
+ * in shared memory, such that they are stored only once per node.
+ * Afterwards the trees must not be modified.
+ * \param [in,out]  trees       On \a root, or on all processes if \a root is negative,
+ *                              the trees of a replicated cmesh without ghosts.
+ *                              On the other processes a trees structure with the
+ *                              number of parts and their meta data set but no part memory.
+ * \param [in]      num_trees   The number of trees of \a trees.
+ * \param [in]      root        If negative, all processes store the same trees.
+ *                              Otherwise the rank that stores the trees.
+ * \param [in]      comm        MPI communicator to use. It must be valid until \a trees is destroyed.
+ * \note This function is MPI collective. Destroying the shared trees is MPI collective as well.
+ * \note If \a root is not negative, the other processes never allocate the trees in their
+ *       own memory. Root does so temporarily if it does not write the shared memory of its node.
+ */
+void
+t8_cmesh_trees_share (t8_cmesh_trees_t trees, t8_locidx_t num_trees, int root, sc_MPI_Comm comm);
+
 /** Check whether the face connection of a trees structure are consistent.
  * That is if tree1 lists tree2 as neighbor at face i with ttf entries (or,face j),
  * then tree2 must list tree1 as neighbor at face j with ttf entries (or, face i).
@@ -92,6 +92,8 @@ typedef struct t8_cmesh
 
   int set_partition;  /**< If nonzero the cmesh is partitioned.
                                             If zero each process has the whole cmesh. */
+  int set_shmem;      /**< If nonzero and the cmesh is replicated, its trees are stored once per node
+                                            in shared memory. \ref t8_cmesh_set_shared_memory */
   int face_knowledge; /**< If partitioned the level of face knowledge that is expected. \ref t8_mesh_set_partitioned;
                             see \ref t8_cmesh_set_partition.
 */
@@ -235,6 +237,8 @@ typedef struct t8_cmesh_trees
                                                            global_id -> local_id for the ghost trees.
                                                            The local_id is the local ghost id starting at num_local_trees  */
   sc_mempool_t *global_local_mempool;    /* Memory pool for the entries in the hash table */
+  t8_shmem_array_t shmem;                /* If not NULL, the tree_to_proc array and the parts are stored
+                                                           in this shared memory array and must not be modified. */
 } t8_cmesh_trees_struct_t;
 
 /* TODO: document */
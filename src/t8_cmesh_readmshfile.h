@@ -33,7 +33,8 @@
 #include <t8_cmesh.h>
 
 /* The supported .msh file versions.
- * Currently, we support gmsh's file version 2 and 4 in ASCII format.
+ * Currently, we support gmsh's file version 2 and 4 in ASCII format
+ * and version 4.1 in binary format.
  */
 #define T8_CMESH_N_SUPPORTED_MSH_FILE_VERSIONS 2
 
@@ -81,14 +82,20 @@ T8_EXTERN_C_BEGIN ();
  *                                  specified by the \a master argument and saved as
  *                                  a partitioned cmesh where each other process does not
  *                                  have any trees.
+ *                                  Binary files of version 4.1 are instead read by all
+ *                                  processes in parallel, each process reading only its
+ *                                  part of the nodes and trees, and the cmesh is
+ *                                  partitioned evenly among the processes.
  * \param [in]    comm              The MPI communicator with which the cmesh is to be committed.
  * \param [in]    dim               The dimension to read from the .msh files. The .msh format
  *                                  can store several dimensions of the mesh and therefore the
  *                                  dimension to read has to be set manually.
  * \param [in]    master            If partition is true, a valid MPI rank that will
  *                                  read the file and store all the trees alone.
+ *                                  For binary files, this rank only locates the nodes and
+ *                                  trees in the file.
  * \param [in]    use_cad_geometry  Read the parameters of a parametric msh file and use the
- *                                  cad geometry.
+ *                                  cad geometry. Not supported for binary files.
  * \return        A committed cmesh holding the mesh of dimension \a dim in the
  *                specified .msh file.
  */
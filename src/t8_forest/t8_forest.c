@@ -57,6 +57,8 @@ t8_forest_init (t8_forest_t *pforest)
   forest->global_num_elements = -1;
   forest->set_adapt_recursive = -1;
   forest->set_balance = -1;
+  forest->num_threads = 1;
+  forest->ghost_width = 1;
   forest->maxlevel_existing = -1;
   forest->stats_computed = 0;
   forest->incomplete_trees = -1;
@@ -160,6 +162,7 @@ t8_forest_set_copy (t8_forest_t forest, const t8_forest_t set_from)
   forest->set_adapt_fn = NULL;
   forest->set_adapt_recursive = -1;
   forest->set_balance = -1;
+  forest->set_balance_onepass = 0;
   forest->set_for_coarsening = -1;
 }
 
@@ -189,6 +192,14 @@ t8_forest_set_partition (t8_forest_t forest, const t8_forest_t set_from, int set
   }
 }
 
+void
+t8_forest_set_partition_weight_function (t8_forest_t forest, t8_forest_partition_weight_t weight_fn)
+{
+  T8_ASSERT (t8_forest_is_initialized (forest));
+
+  forest->set_partition_weight_fn = weight_fn;
+}
+
 void
 t8_forest_set_balance (t8_forest_t forest, const t8_forest_t set_from, int no_repartition)
 {
@@ -219,13 +230,21 @@ t8_forest_set_balance (t8_forest_t forest, const t8_forest_t set_from, int no_re
 }
 
 void
-t8_forest_set_ghost_ext (t8_forest_t forest, int do_ghost, t8_ghost_type_t ghost_type, int ghost_version)
+t8_forest_set_balance_onepass (t8_forest_t forest, int onepass)
 {
   T8_ASSERT (t8_forest_is_initialized (forest));
-  /* We currently only support face ghosts */
-  SC_CHECK_ABORT (do_ghost == 0 || ghost_type == T8_GHOST_FACES,
-                  "Ghost neighbors other than face-neighbors are not supported.\n");
+
+  forest->set_balance_onepass = onepass != 0;
+}
+
+void
+t8_forest_set_ghost_ext (t8_forest_t forest, int do_ghost, t8_ghost_type_t ghost_type, int ghost_version,
+                         int ghost_width)
+{
+  T8_ASSERT (t8_forest_is_initialized (forest));
+  T8_ASSERT (T8_GHOST_NONE <= ghost_type && ghost_type <= T8_GHOST_VERTICES);
   SC_CHECK_ABORT (1 <= ghost_version && ghost_version <= 3, "Invalid choice for ghost version. Choose 1, 2, or 3.\n");
+  SC_CHECK_ABORT (ghost_width >= 1, "Invalid choice for ghost width. Choose at least 1.\n");
 
   if (ghost_type == T8_GHOST_NONE) {
     /* none type disables ghost */
@@ -237,6 +256,7 @@ t8_forest_set_ghost_ext (t8_forest_t forest, int do_ghost, t8_ghost_type_t ghost
   if (forest->do_ghost) {
     forest->ghost_type = ghost_type;
     forest->ghost_algorithm = ghost_version;
+    forest->ghost_width = ghost_width;
   }
 }
 
@@ -244,7 +264,19 @@ void
 t8_forest_set_ghost (t8_forest_t forest, int do_ghost, t8_ghost_type_t ghost_type)
 {
   /* Use ghost version 3, top-down search and for unbalanced forests. */
-  t8_forest_set_ghost_ext (forest, do_ghost, ghost_type, 3);
+  t8_forest_set_ghost_ext (forest, do_ghost, ghost_type, 3, 1);
+}
+
+void
+t8_forest_set_load (t8_forest_t forest, const char *filename)
+{
+  T8_ASSERT (t8_forest_is_initialized (forest));
+  T8_ASSERT (forest->set_from == NULL);
+  T8_ASSERT (filename != NULL);
+
+  T8_FREE (forest->set_load_filename);
+  forest->set_load_filename = T8_ALLOC (char, strlen (filename) + 1);
+  strcpy (forest->set_load_filename, filename);
 }
 
 void
@@ -278,6 +310,15 @@ t8_forest_set_adapt (t8_forest_t forest, const t8_forest_t set_from, t8_forest_a
   }
 }
 
+void
+t8_forest_set_num_threads (t8_forest_t forest, int num_threads)
+{
+  T8_ASSERT (t8_forest_is_initialized (forest));
+  T8_ASSERT (num_threads >= 1);
+
+  forest->num_threads = num_threads;
+}
+
 void
 t8_forest_set_user_data (t8_forest_t forest, void *data)
 {
@@ -453,7 +494,13 @@ t8_forest_commit (t8_forest_t forest)
     t8_forest_compute_maxlevel (forest);
     T8_ASSERT (forest->set_level <= forest->maxlevel);
     /* populate a new forest with tree and quadrant objects */
-    if (t8_forest_refines_irregular (forest) && forest->set_level > 0) {
+    if (forest->set_load_filename != NULL) {
+      /* Load the elements from a checkpoint. We need to repartition the cmesh
+       * if its partition differs from the one of the loaded forest. */
+      t8_forest_load_checkpoint (forest);
+      partitioned = 1;
+    }
+    else if (t8_forest_refines_irregular (forest) && forest->set_level > 0) {
       /* On root level we will also use the normal algorithm */
       t8_forest_populate_irregular (forest);
     }
@@ -472,6 +519,7 @@ t8_forest_commit (t8_forest_t forest)
     T8_ASSERT (!forest->do_dup);
     T8_ASSERT (forest->from_method >= T8_FOREST_FROM_FIRST && forest->from_method < T8_FOREST_FROM_LAST);
     T8_ASSERT (forest->set_from->incomplete_trees > -1);
+    T8_ASSERT (forest->set_load_filename == NULL);
 
     /* TODO: optimize all this when forest->set_from has reference count one */
     /* TODO: Get rid of duping the communicator */
@@ -557,6 +605,7 @@ t8_forest_commit (t8_forest_t forest)
           t8_forest_ref (forest->set_from);
         }
         t8_forest_set_partition (forest_partition, forest->set_from, forest->set_for_coarsening);
+        t8_forest_set_partition_weight_function (forest_partition, forest->set_partition_weight_fn);
         /* activate profiling, if this forest has profiling */
         t8_forest_set_profiling (forest_partition, forest->profile != NULL);
         /* Commit the partitioned forest */
@@ -615,8 +664,11 @@ t8_forest_commit (t8_forest_t forest)
   t8_forest_compute_desc (forest);
 
   /* we do not need the set parameters anymore */
+  T8_FREE (forest->set_load_filename);
+  forest->set_load_filename = NULL;
   forest->set_level = 0;
   forest->set_for_coarsening = 0;
+  forest->set_partition_weight_fn = NULL;
   forest->set_from = NULL;
   forest->committed = 1;
   t8_debugf ("Committed forest with %li local elements and %lli "
@@ -1197,6 +1249,13 @@ t8_forest_compute_profile (t8_forest_t forest)
     sc_stats_set1 (&forest->stats[11], profile->ghost_waittime, "forest: Ghost waittime.");
     sc_stats_set1 (&forest->stats[12], profile->balance_runtime, "forest: Balance runtime.");
     sc_stats_set1 (&forest->stats[13], profile->balance_rounds, "forest: Balance rounds.");
+    sc_stats_set1 (&forest->stats[14], profile->balance_adapt_runtime, "forest: Balance adapt runtime.");
+    sc_stats_set1 (&forest->stats[15], profile->balance_ghost_runtime, "forest: Balance ghost runtime.");
+    sc_stats_set1 (&forest->stats[16], profile->balance_partition_runtime, "forest: Balance partition runtime.");
+    sc_stats_set1 (&forest->stats[17], profile->ghost_search_runtime, "forest: Ghost search runtime.");
+    sc_stats_set1 (&forest->stats[18], profile->ghost_pack_runtime, "forest: Ghost pack runtime.");
+    sc_stats_set1 (&forest->stats[19], profile->ghost_communicate_runtime, "forest: Ghost communicate runtime.");
+    sc_stats_set1 (&forest->stats[20], profile->ghost_unpack_runtime, "forest: Ghost unpack runtime.");
     /* compute stats */
     sc_stats_compute (sc_MPI_COMM_WORLD, T8_PROFILE_NUM_STATS, forest->stats);
     forest->stats_computed = 1;
@@ -1316,6 +1375,22 @@ t8_forest_profile_get_ghost_time (t8_forest_t forest, t8_locidx_t *ghosts_sent)
   return 0;
 }
 
+double
+t8_forest_profile_get_ghost_phase_times (t8_forest_t forest, double *search_time, double *pack_time,
+                                         double *communicate_time, double *unpack_time)
+{
+  T8_ASSERT (t8_forest_is_committed (forest));
+  if (forest->profile != NULL) {
+    *search_time = forest->profile->ghost_search_runtime;
+    *pack_time = forest->profile->ghost_pack_runtime;
+    *communicate_time = forest->profile->ghost_communicate_runtime;
+    *unpack_time = forest->profile->ghost_unpack_runtime;
+    return forest->profile->ghost_runtime;
+  }
+  *search_time = *pack_time = *communicate_time = *unpack_time = 0;
+  return 0;
+}
+
 double
 t8_forest_profile_get_ghostexchange_waittime (t8_forest_t forest)
 {
@@ -1364,7 +1439,8 @@ t8_forest_compute_elements_offset (t8_forest_t forest)
 int
 t8_forest_write_vtk_ext (t8_forest_t forest, const char *fileprefix, const int write_treeid, const int write_mpirank,
                          const int write_level, const int write_element_id, const int write_ghosts,
-                         const int write_curved, int do_not_use_API, const int num_data, t8_vtk_data_field_t *data)
+                         const int write_curved, int do_not_use_API, const int deduplicate_points, const int num_data,
+                         t8_vtk_data_field_t *data)
 {
   T8_ASSERT (forest != NULL);
   T8_ASSERT (forest->rc.refcount > 0);
@@ -1387,21 +1463,25 @@ t8_forest_write_vtk_ext (t8_forest_t forest, const char *fileprefix, const int w
   }
   do_not_use_API = 1;
 #endif
+  if (!do_not_use_API && deduplicate_points) {
+    t8_errorf ("WARNING: Writing shared corners as one point is not available with the VTK API. "
+               "Each corner is written as a separate point.\n");
+  }
   if (!do_not_use_API) {
     return t8_forest_vtk_write_file_via_API (forest, fileprefix, write_treeid, write_mpirank, write_level,
                                              write_element_id, write_ghosts, write_curved, num_data, data);
   }
   else {
     T8_ASSERT (!write_curved);
-    return t8_forest_vtk_write_file (forest, fileprefix, write_treeid, write_mpirank, write_level, write_element_id,
-                                     write_ghosts, num_data, data);
+    return t8_forest_vtk_write_file_binary (forest, fileprefix, write_treeid, write_mpirank, write_level,
+                                            write_element_id, write_ghosts, 0, deduplicate_points, num_data, data);
   }
 }
 
 int
 t8_forest_write_vtk (t8_forest_t forest, const char *fileprefix)
 {
-  return t8_forest_write_vtk_ext (forest, fileprefix, 1, 1, 1, 1, 0, 0, 0, 0, NULL);
+  return t8_forest_write_vtk_ext (forest, fileprefix, 1, 1, 1, 1, 0, 0, 0, 0, 0, NULL);
 }
 
 t8_forest_t
@@ -1496,6 +1576,7 @@ t8_forest_reset (t8_forest_t *pforest)
       /* in this case we have taken ownership and not released it yet */
       t8_forest_unref (&forest->set_from);
     }
+    T8_FREE (forest->set_load_filename);
   }
   else {
     T8_ASSERT (forest->set_from == NULL);
@@ -1514,6 +1595,10 @@ t8_forest_reset (t8_forest_t *pforest)
   if (forest->ghosts != NULL) {
     t8_forest_ghost_unref (&forest->ghosts);
   }
+  /* Destroy the face neighbor table if it exists */
+  t8_forest_face_connectivity_destroy (forest);
+  /* Destroy the bounding boxes for point location if they exist */
+  t8_forest_locate_boxes_destroy (forest);
   /* we have taken ownership on calling t8_forest_set_* */
   if (forest->scheme_cxx != NULL) {
     t8_scheme_cxx_unref (&forest->scheme_cxx);
@@ -26,6 +26,10 @@
 #include <t8_forest/t8_forest_general.h>
 #include <t8_data/t8_containers.h>
 #include <t8_element_cxx.hxx>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
 
 /* We want to export the whole implementation to be callable from "C" */
 T8_EXTERN_C_BEGIN ();
@@ -361,6 +365,281 @@ t8_forest_adapt_refine_recursive (t8_forest_t forest, t8_locidx_t ltreeid, t8_lo
   } /* End while loop */
 }
 
+/** A range of elements in a local tree of forest_from that is adapted by one thread. */
+struct t8_forest_adapt_range
+{
+  t8_locidx_t ltree_id;          /* The local tree of the elements. */
+  t8_locidx_t first;             /* The tree local index of the first element of the range. */
+  t8_locidx_t end;               /* The tree local index of the first element after the range. */
+  t8_locidx_t num_inserted;      /* The number of new elements that result from the range. */
+  t8_locidx_t offset;            /* The tree local index of the first new element in the new tree. */
+  int element_removed;           /* True if an element of the range was removed. */
+  std::vector<int8_t> decisions; /* The return values of the adapt callback in the order of the calls. */
+};
+
+/** Call a function for each index in [0, num_ranges) using \a num_threads threads.
+ * The calling thread is one of the threads. Each thread takes the next index that
+ * is not processed yet, until all indices are processed.
+ */
+static void
+t8_forest_adapt_run_threads (const int num_threads, const size_t num_ranges, const std::function<void (size_t)> &work)
+{
+  std::atomic<size_t> next_range (0);
+  const auto worker = [&] () {
+    for (size_t irange = next_range++; irange < num_ranges; irange = next_range++) {
+      work (irange);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t ithread = 1; ithread < (size_t) num_threads && ithread < num_ranges; ithread++) {
+    threads.emplace_back (worker);
+  }
+  worker ();
+  for (auto &thread : threads) {
+    thread.join ();
+  }
+}
+
+/** Call the adapt callback for all elements and families of a range and store its return values.
+ * This function is called concurrently for different ranges. Thus, it must not allocate
+ * elements and does not write to the new forest.
+ * \param [in] forest     The new forest currently in construction.
+ * \param [in,out] range  The range of elements. On output the decisions, the number
+ *                        of new elements and the removed flag are set.
+ */
+static void
+t8_forest_adapt_range_decide (t8_forest_t forest, t8_forest_adapt_range *range)
+{
+  const t8_forest_t forest_from = forest->set_from;
+  const t8_tree_t tree_from = t8_forest_get_tree (forest_from, range->ltree_id);
+  t8_element_array_t *telements_from = &tree_from->elements;
+  t8_eclass_scheme_c *tscheme = t8_forest_get_eclass_scheme (forest_from, tree_from->eclass);
+  std::vector<t8_element_t *> elements_from;
+
+  T8_ASSERT (!forest_from->incomplete_trees);
+  range->num_inserted = 0;
+  range->element_removed = 0;
+  t8_locidx_t el_considered = range->first;
+  while (el_considered < range->end) {
+    /* Load the current element and the following ones, as long as they can form a family. */
+    const int num_siblings
+      = tscheme->t8_element_num_siblings (t8_element_array_index_locidx (telements_from, el_considered));
+    if ((int) elements_from.size () < num_siblings) {
+      elements_from.resize (num_siblings);
+    }
+    int zz;
+    for (zz = 0; zz < num_siblings && el_considered + (t8_locidx_t) zz < range->end; zz++) {
+      elements_from[zz] = t8_element_array_index_locidx (telements_from, el_considered + (t8_locidx_t) zz);
+      if (tscheme->t8_element_child_id (elements_from[zz]) != zz) {
+        break;
+      }
+    }
+    int is_family = 0;
+    int num_elements_to_adapt_callback = 1;
+    if (zz == num_siblings && tscheme->t8_element_is_family (elements_from.data ())) {
+      /* We will pass a full family to the adapt callback */
+      is_family = 1;
+      num_elements_to_adapt_callback = num_siblings;
+    }
+    int refine = forest->set_adapt_fn (forest, forest_from, range->ltree_id, el_considered, tscheme, is_family,
+                                       num_elements_to_adapt_callback, elements_from.data ());
+    T8_ASSERT (is_family || refine != -1);
+    if (refine > 0 && tscheme->t8_element_level (elements_from[0]) >= forest->maxlevel) {
+      /* Only refine an element if it does not exceed the maximum level */
+      refine = 0;
+    }
+    range->decisions.push_back ((int8_t) refine);
+    if (refine == 1) {
+      range->num_inserted += tscheme->t8_element_num_children (elements_from[0]);
+      el_considered++;
+    }
+    else if (refine == -1) {
+      range->num_inserted++;
+      el_considered += (t8_locidx_t) num_siblings;
+    }
+    else if (refine == 0) {
+      range->num_inserted++;
+      el_considered++;
+    }
+    else {
+      T8_ASSERT (refine == -2);
+      range->element_removed = 1;
+      el_considered++;
+    }
+  }
+  T8_ASSERT (el_considered == range->end);
+}
+
+/** Write the new elements of a range to the element array of its tree in the new forest.
+ * The array must already have its final size. This function is called concurrently
+ * for different ranges, which write to disjoint parts of the element arrays.
+ * \param [in] forest     The new forest currently in construction.
+ * \param [in] range      A range for which \ref t8_forest_adapt_range_decide was called
+ *                        and whose offset is set.
+ */
+static void
+t8_forest_adapt_range_build (t8_forest_t forest, const t8_forest_adapt_range *range)
+{
+  const t8_forest_t forest_from = forest->set_from;
+  const t8_tree_t tree_from = t8_forest_get_tree (forest_from, range->ltree_id);
+  t8_element_array_t *telements_from = &tree_from->elements;
+  t8_element_array_t *telements = &t8_forest_get_tree (forest, range->ltree_id)->elements;
+  t8_eclass_scheme_c *tscheme = t8_forest_get_eclass_scheme (forest_from, tree_from->eclass);
+  std::vector<t8_element_t *> elements;
+
+  t8_locidx_t el_considered = range->first;
+  t8_locidx_t el_inserted = range->offset;
+  for (const int8_t refine : range->decisions) {
+    const t8_element_t *element_from = t8_element_array_index_locidx (telements_from, el_considered);
+    if (refine == 1) {
+      /* Insert the children of the element */
+      const int num_children = tscheme->t8_element_num_children (element_from);
+      if ((int) elements.size () < num_children) {
+        elements.resize (num_children);
+      }
+      for (int ichild = 0; ichild < num_children; ichild++) {
+        elements[ichild] = t8_element_array_index_locidx (telements, el_inserted + ichild);
+      }
+      tscheme->t8_element_children (element_from, num_children, elements.data ());
+      el_inserted += num_children;
+      el_considered++;
+    }
+    else if (refine == -1) {
+      /* Insert the parent of the family */
+      tscheme->t8_element_parent (element_from, t8_element_array_index_locidx (telements, el_inserted));
+      el_inserted++;
+      el_considered += tscheme->t8_element_num_siblings (element_from);
+    }
+    else if (refine == 0) {
+      /* Copy the element */
+      tscheme->t8_element_copy (element_from, t8_element_array_index_locidx (telements, el_inserted));
+      el_inserted++;
+      el_considered++;
+    }
+    else {
+      /* The element is removed */
+      T8_ASSERT (refine == -2);
+      el_considered++;
+    }
+  }
+  T8_ASSERT (el_considered == range->end);
+  T8_ASSERT (el_inserted == range->offset + range->num_inserted);
+}
+
+/** Adapt the local trees of a forest with forest->num_threads threads.
+ * The local elements are split into ranges that do not split a family. In a first parallel
+ * step the adapt callback is called for all ranges, then the new element arrays are allocated
+ * and in a second parallel step each range writes its new elements.
+ * Since the output sizes are known before writing, no thread needs to allocate memory
+ * in the element arrays.
+ * \param [in,out] forest        The new forest currently in construction.
+ * \param [out] element_removed  Set to 1 if any element was removed.
+ * \note Recursive adaptation and incomplete trees are not supported.
+ */
+static void
+t8_forest_adapt_threaded (t8_forest_t forest, int *element_removed)
+{
+  const t8_forest_t forest_from = forest->set_from;
+  const t8_locidx_t num_trees = t8_forest_get_num_local_trees (forest);
+  std::vector<t8_forest_adapt_range> ranges;
+
+  T8_ASSERT (forest->num_threads > 1);
+  T8_ASSERT (!forest->set_adapt_recursive);
+  T8_ASSERT (!forest_from->incomplete_trees);
+
+  /* We create a few ranges per thread, such that threads that finish early can take more work. */
+  const t8_locidx_t range_size = SC_MAX (1, t8_forest_get_local_num_elements (forest_from) / (4 * forest->num_threads));
+  for (t8_locidx_t ltree_id = 0; ltree_id < num_trees; ltree_id++) {
+    const t8_tree_t tree_from = t8_forest_get_tree (forest_from, ltree_id);
+    t8_element_array_t *telements_from = &tree_from->elements;
+    t8_eclass_scheme_c *tscheme = t8_forest_get_eclass_scheme (forest_from, tree_from->eclass);
+    const t8_locidx_t num_el_from = (t8_locidx_t) t8_element_array_get_count (telements_from);
+    t8_locidx_t first = 0;
+    while (first < num_el_from) {
+      t8_locidx_t end = SC_MIN (first + range_size, num_el_from);
+      /* A family starts with child id 0. We let the range end before such an element,
+       * such that no family is split between two ranges. */
+      while (end < num_el_from && tscheme->t8_element_child_id (t8_element_array_index_locidx (telements_from, end))) {
+        end++;
+      }
+      ranges.emplace_back ();
+      ranges.back ().ltree_id = ltree_id;
+      ranges.back ().first = first;
+      ranges.back ().end = end;
+      first = end;
+    }
+  }
+
+  /* Call the adapt callback for all ranges */
+  t8_forest_adapt_run_threads (forest->num_threads, ranges.size (),
+                               [&] (size_t irange) { t8_forest_adapt_range_decide (forest, &ranges[irange]); });
+
+  /* Compute the offsets of the ranges and allocate the new element arrays */
+  t8_locidx_t el_offset = 0;
+  size_t irange = 0;
+  for (t8_locidx_t ltree_id = 0; ltree_id < num_trees; ltree_id++) {
+    t8_tree_t tree = t8_forest_get_tree (forest, ltree_id);
+    t8_locidx_t el_inserted = 0;
+    for (; irange < ranges.size () && ranges[irange].ltree_id == ltree_id; irange++) {
+      ranges[irange].offset = el_inserted;
+      el_inserted += ranges[irange].num_inserted;
+      *element_removed |= ranges[irange].element_removed;
+    }
+    t8_element_array_resize (&tree->elements, el_inserted);
+    tree->elements_offset = el_offset;
+    el_offset += el_inserted;
+  }
+  forest->local_num_elements = el_offset;
+
+  /* Write the new elements */
+  t8_forest_adapt_run_threads (forest->num_threads, ranges.size (),
+                               [&] (size_t irange) { t8_forest_adapt_range_build (forest, &ranges[irange]); });
+}
+
+/** Complete the adaptation after the new element arrays of all local trees are built.
+ * Compute the global number of elements, communicate whether there are incomplete trees
+ * and stop the runtime measurement.
+ * \param [in,out] forest        The new forest currently in construction.
+ * \param [in]     element_removed True if this process removed an element.
+ */
+static void
+t8_forest_adapt_finish (t8_forest_t forest, int element_removed)
+{
+  const t8_forest_t forest_from = forest->set_from;
+
+  /* We now adapted all local trees */
+  /* Compute the new global number of elements */
+  t8_forest_comm_global_num_elements (forest);
+
+  /* Updating other processes about local (in)complete trees.
+   * If the old forest already contained incomplete trees, 
+   * this step is not necessary. */
+  if (!forest_from->incomplete_trees) {
+    T8_ASSERT (element_removed == 1 || element_removed == 0);
+    int incomplete_trees;
+    int mpiret = sc_MPI_Allreduce (&element_removed, &incomplete_trees, 1, sc_MPI_INT, sc_MPI_MAX, forest->mpicomm);
+    SC_CHECK_MPI (mpiret);
+    T8_ASSERT (incomplete_trees == 1 || incomplete_trees == 0);
+    forest->incomplete_trees = incomplete_trees;
+  }
+  else {
+    T8_ASSERT (forest_from->incomplete_trees == 1);
+    forest->incomplete_trees = 1;
+  }
+
+  t8_global_productionf ("Done t8_forest_adapt with %lld total elements\n", (long long) forest->global_num_elements);
+
+  /* if profiling is enabled, measure runtime */
+  if (forest->profile != NULL) {
+    forest->profile->adapt_runtime += sc_MPI_Wtime ();
+    /* DO NOT DELETE THE FOLLOWING line.
+     * even if you do not want this output. It fixes a bug that occurred on JUQUEEN, where the
+     * runtimes were computed to 0.
+     * Only delete the line, if you know what you are doing. */
+    t8_global_productionf ("End adadpt %f %f\n", sc_MPI_Wtime (), forest->profile->adapt_runtime);
+  }
+}
+
 /* TODO: optimize this when we own forest_from */
 void
 t8_forest_adapt (t8_forest_t forest)
@@ -416,6 +695,13 @@ t8_forest_adapt (t8_forest_t forest)
    * Will we do this here or in an extra function? */
   T8_ASSERT (forest->trees->elem_count == forest_from->trees->elem_count);
 
+  if (forest->num_threads > 1 && !forest->set_adapt_recursive && !forest_from->incomplete_trees) {
+    /* Adapt the trees with multiple threads */
+    t8_forest_adapt_threaded (forest, &element_removed);
+    t8_forest_adapt_finish (forest, element_removed);
+    return;
+  }
+
   if (forest->set_adapt_recursive) {
     refine_list = sc_list_new (NULL);
   }
@@ -637,37 +923,7 @@ t8_forest_adapt (t8_forest_t forest)
     sc_list_destroy (refine_list);
   }
 
-  /* We now adapted all local trees */
-  /* Compute the new global number of elements */
-  t8_forest_comm_global_num_elements (forest);
-
-  /* Updating other processes about local (in)complete trees.
-   * If the old forest already contained incomplete trees, 
-   * this step is not necessary. */
-  if (!forest_from->incomplete_trees) {
-    T8_ASSERT (element_removed == 1 || element_removed == 0);
-    int incomplete_trees;
-    int mpiret = sc_MPI_Allreduce (&element_removed, &incomplete_trees, 1, sc_MPI_INT, sc_MPI_MAX, forest->mpicomm);
-    SC_CHECK_MPI (mpiret);
-    T8_ASSERT (incomplete_trees == 1 || incomplete_trees == 0);
-    forest->incomplete_trees = incomplete_trees;
-  }
-  else {
-    T8_ASSERT (forest_from->incomplete_trees == 1);
-    forest->incomplete_trees = 1;
-  }
-
-  t8_global_productionf ("Done t8_forest_adapt with %lld total elements\n", (long long) forest->global_num_elements);
-
-  /* if profiling is enabled, measure runtime */
-  if (forest->profile != NULL) {
-    forest->profile->adapt_runtime += sc_MPI_Wtime ();
-    /* DO NOT DELETE THE FOLLOWING line.
-     * even if you do not want this output. It fixes a bug that occurred on JUQUEEN, where the
-     * runtimes were computed to 0.
-     * Only delete the line, if you know what you are doing. */
-    t8_global_productionf ("End adadpt %f %f\n", sc_MPI_Wtime (), forest->profile->adapt_runtime);
-  }
+  t8_forest_adapt_finish (forest, element_removed);
 }
 
 T8_EXTERN_C_END ();
@@ -35,6 +35,7 @@ T8_EXTERN_C_BEGIN ();
 /* This is the adapt function called during one round of balance.
  * We refine an element if it has any face neighbor with a level larger
  * than the element's level + 1.
+ * This function only reads forest_from and may thus be called by several threads.
  */
 /* TODO: We currently do not adapt recursively since some functions such
  * as half neighbor computation require the forest to be committed. Thus,
@@ -44,7 +45,7 @@ static int
 t8_forest_balance_adapt (t8_forest_t forest, t8_forest_t forest_from, t8_locidx_t ltree_id, t8_locidx_t lelement_id,
                          t8_eclass_scheme_c *ts, const int is_family, const int num_elements, t8_element_t *elements[])
 {
-  int *pdone, iface, num_faces, num_half_neighbors, ineigh;
+  int iface, num_faces, num_half_neighbors, ineigh;
   t8_gloidx_t neighbor_tree;
   t8_eclass_t neigh_class;
   t8_eclass_scheme_c *neigh_scheme;
@@ -60,8 +61,6 @@ t8_forest_balance_adapt (t8_forest_t forest, t8_forest_t forest_from, t8_locidx_
 
   if (forest_from->maxlevel_existing <= 0 || ts->t8_element_level (element) <= forest_from->maxlevel_existing - 2) {
 
-    pdone = (int *) forest->t8code_data;
-
     num_faces = ts->t8_element_num_faces (element);
     for (iface = 0; iface < num_faces; iface++) {
       /* Get the element class and scheme of the face neighbor */
@@ -81,7 +80,6 @@ t8_forest_balance_adapt (t8_forest_t forest, t8_forest_t forest_from, t8_locidx_
         for (ineigh = 0; ineigh < num_half_neighbors; ineigh++) {
           if (t8_forest_element_has_leaf_desc (forest_from, neighbor_tree, half_neighbors[ineigh], neigh_scheme)) {
             /* This element should be refined */
-            *pdone = 0;
             /* clean-up */
             neigh_scheme->t8_element_destroy (num_half_neighbors, half_neighbors);
             T8_FREE (half_neighbors);
@@ -98,6 +96,282 @@ t8_forest_balance_adapt (t8_forest_t forest, t8_forest_t forest_from, t8_locidx_
   return 0;
 }
 
+/* The data of a one-pass balance round.
+ * Since the answer whether an element needs to be refined only depends on forest_from,
+ * we store it for each element that was tested. */
+typedef struct
+{
+  t8_forest_t forest_from;     /* The forest that is balanced in this round. */
+  sc_hash_t *refine_hash;      /* Stores for tested elements whether they need to be refined. */
+  sc_mempool_t *hash_mempool;  /* The memory for the entries in refine_hash. */
+  int *neighbor_maxlevel;      /* For each local leaf of forest_from the maximum level of the
+                                  leaves in its face neighbors. -1 if not computed yet. */
+} t8_forest_balance_onepass_t;
+
+/* An entry in the refine_hash of a one-pass balance round. */
+typedef struct
+{
+  t8_gloidx_t gtreeid; /* The global id of the element's tree. */
+  t8_linearidx_t id;   /* The linear id of the element at its level. */
+  int level;           /* The level of the element. */
+  int refine;          /* True if the element needs to be refined. */
+} t8_forest_balance_refine_hash_t;
+
+static unsigned
+t8_forest_balance_refine_hash_function (const void *entry, const void *data)
+{
+  const t8_forest_balance_refine_hash_t *hash_entry = (const t8_forest_balance_refine_hash_t *) entry;
+
+  return (unsigned) (hash_entry->id ^ (hash_entry->id >> 32)) ^ ((unsigned) hash_entry->gtreeid * 31u)
+         ^ ((unsigned) hash_entry->level * 131u);
+}
+
+static int
+t8_forest_balance_refine_hash_equal (const void *entrya, const void *entryb, const void *data)
+{
+  const t8_forest_balance_refine_hash_t *hash_a = (const t8_forest_balance_refine_hash_t *) entrya;
+  const t8_forest_balance_refine_hash_t *hash_b = (const t8_forest_balance_refine_hash_t *) entryb;
+
+  return hash_a->gtreeid == hash_b->gtreeid && hash_a->level == hash_b->level && hash_a->id == hash_b->id;
+}
+
+/* Compute the maximum level of all leaves in an element array that are
+ * descendants of element (or element itself). Returns -1 if there are none. */
+static int
+t8_forest_balance_max_desc_level (t8_element_array_t *elements, const t8_element_t *element, t8_eclass_scheme_c *ts,
+                                  int maxlevel)
+{
+  t8_element_t *last_desc;
+  const t8_element_t *leaf;
+  t8_linearidx_t first_desc_id, last_desc_id;
+  t8_locidx_t index;
+  int max_level = -1;
+
+  if (t8_element_array_get_count (elements) == 0) {
+    return -1;
+  }
+  first_desc_id = ts->t8_element_get_linear_id (element, maxlevel);
+  ts->t8_element_new (1, &last_desc);
+  ts->t8_element_last_descendant (element, last_desc, maxlevel);
+  last_desc_id = ts->t8_element_get_linear_id (last_desc, maxlevel);
+  ts->t8_element_destroy (1, &last_desc);
+
+  /* Iterate backwards over all leaves with ids between the first and the last descendant */
+  for (index = t8_forest_bin_search_lower (elements, last_desc_id, maxlevel); index >= 0; index--) {
+    leaf = t8_element_array_index_locidx (elements, index);
+    if (ts->t8_element_get_linear_id (leaf, maxlevel) < first_desc_id) {
+      break;
+    }
+    max_level = SC_MAX (max_level, ts->t8_element_level (leaf));
+  }
+  return max_level;
+}
+
+/* Return the maximum level of the local and ghost leaves of forest_from that lie in
+ * the face neighbors of the local leaf that contains element.
+ * If element is not contained in a local leaf, it lies in the domain of another process
+ * and we return -1. */
+static int
+t8_forest_balance_onepass_neighbor_maxlevel (t8_forest_balance_onepass_t *onepass, t8_locidx_t ltreeid,
+                                             const t8_element_t *element, t8_eclass_scheme_c *ts)
+{
+  t8_forest_t forest_from = onepass->forest_from;
+  t8_element_array_t *elements;
+  const t8_element_t *leaf;
+  t8_element_t *neighbor;
+  t8_eclass_scheme_c *neigh_scheme;
+  t8_gloidx_t neighbor_tree;
+  t8_locidx_t index, lneigh_tree, ghost_treeid;
+  int level, leaf_level, iface, num_faces, dual_face, max_level;
+
+  /* Find the leaf that contains element */
+  elements = t8_forest_get_tree_element_array (forest_from, ltreeid);
+  if (t8_element_array_get_count (elements) == 0) {
+    return -1;
+  }
+  index = t8_forest_bin_search_lower (elements, ts->t8_element_get_linear_id (element, forest_from->maxlevel),
+                                      forest_from->maxlevel);
+  if (index < 0) {
+    return -1;
+  }
+  leaf = t8_element_array_index_locidx (elements, index);
+  level = ts->t8_element_level (element);
+  leaf_level = ts->t8_element_level (leaf);
+  if (leaf_level > level
+      || ts->t8_element_get_linear_id (leaf, leaf_level) != ts->t8_element_get_linear_id (element, leaf_level)) {
+    /* The leaf is not an ancestor of element */
+    return -1;
+  }
+
+  index += t8_forest_get_tree_element_offset (forest_from, ltreeid);
+  if (onepass->neighbor_maxlevel[index] >= 0) {
+    /* We already computed this value */
+    return onepass->neighbor_maxlevel[index];
+  }
+
+  max_level = leaf_level;
+  num_faces = ts->t8_element_num_faces (leaf);
+  for (iface = 0; iface < num_faces; iface++) {
+    /* Compute the same level face neighbor of the leaf */
+    neigh_scheme = t8_forest_get_eclass_scheme (forest_from,
+                                                t8_forest_element_neighbor_eclass (forest_from, ltreeid, leaf, iface));
+    neigh_scheme->t8_element_new (1, &neighbor);
+    neighbor_tree = t8_forest_element_face_neighbor (forest_from, ltreeid, leaf, neighbor, neigh_scheme, iface,
+                                                     &dual_face);
+    if (neighbor_tree >= 0) {
+      /* Check the local and the ghost leaves inside the neighbor */
+      lneigh_tree = t8_forest_get_local_id (forest_from, neighbor_tree);
+      if (lneigh_tree >= 0) {
+        max_level = SC_MAX (max_level, t8_forest_balance_max_desc_level (
+                                         t8_forest_get_tree_element_array (forest_from, lneigh_tree), neighbor,
+                                         neigh_scheme, forest_from->maxlevel));
+      }
+      if (forest_from->ghosts != NULL) {
+        ghost_treeid = t8_forest_ghost_get_ghost_treeid (forest_from, neighbor_tree);
+        if (ghost_treeid >= 0) {
+          max_level = SC_MAX (max_level, t8_forest_balance_max_desc_level (
+                                           t8_forest_ghost_get_tree_elements (forest_from, ghost_treeid), neighbor,
+                                           neigh_scheme, forest_from->maxlevel));
+        }
+      }
+    }
+    neigh_scheme->t8_element_destroy (1, &neighbor);
+  }
+  onepass->neighbor_maxlevel[index] = max_level;
+  return max_level;
+}
+
+/* Decide whether an element needs to be refined in the balanced forest of forest_from.
+ * This is the case if it is a strict ancestor of a leaf or if any of its half face neighbors
+ * needs to be refined. We recurse over the half face neighbors until the level is so
+ * fine that no leaf can enforce a refinement anymore.
+ * Elements in non-local trees are only checked for leaf descendants, since we cannot
+ * compute their face neighbors. Conflicts that we miss this way are resolved in
+ * another round of balance. */
+static int
+t8_forest_balance_onepass_need_refine (t8_forest_balance_onepass_t *onepass, t8_gloidx_t gtreeid,
+                                       const t8_element_t *element, t8_eclass_scheme_c *ts)
+{
+  t8_forest_t forest_from = onepass->forest_from;
+  t8_forest_balance_refine_hash_t query, *entry, **pfound;
+  t8_element_t **half_neighbors;
+  t8_eclass_scheme_c *neigh_scheme;
+  t8_gloidx_t neighbor_tree;
+  t8_locidx_t ltreeid;
+  int level, refine, iface, num_faces, num_half_neighbors, ineigh;
+#ifdef T8_ENABLE_DEBUG
+  int ret;
+#endif
+
+  if (t8_forest_element_has_leaf_desc (forest_from, gtreeid, element, ts)) {
+    /* The element is a strict ancestor of a leaf */
+    return 1;
+  }
+  level = ts->t8_element_level (element);
+  if (level + 2 > forest_from->maxlevel_existing) {
+    /* Only leaves of level + 2 and finer can enforce a refinement */
+    return 0;
+  }
+  ltreeid = t8_forest_get_local_id (forest_from, gtreeid);
+  if (ltreeid < 0) {
+    /* We cannot compute the neighbors in a non-local tree */
+    return 0;
+  }
+  if (t8_forest_balance_onepass_neighbor_maxlevel (onepass, ltreeid, element, ts) < level + 2) {
+    /* There are no leaves near the element that are fine enough to enforce a refinement,
+     * or the element is not in the local domain */
+    return 0;
+  }
+
+  /* Check whether we already know the answer */
+  query.gtreeid = gtreeid;
+  query.level = level;
+  query.id = ts->t8_element_get_linear_id (element, level);
+  if (sc_hash_lookup (onepass->refine_hash, &query, (void ***) &pfound)) {
+    return (*pfound)->refine;
+  }
+
+  refine = 0;
+  num_faces = ts->t8_element_num_faces (element);
+  for (iface = 0; iface < num_faces && !refine; iface++) {
+    /* Compute the half face neighbors of element at this face */
+    neigh_scheme = t8_forest_get_eclass_scheme (
+      forest_from, t8_forest_element_neighbor_eclass (forest_from, ltreeid, element, iface));
+    num_half_neighbors = ts->t8_element_num_face_children (element, iface);
+    half_neighbors = T8_ALLOC (t8_element_t *, num_half_neighbors);
+    neigh_scheme->t8_element_new (num_half_neighbors, half_neighbors);
+    neighbor_tree = t8_forest_element_half_face_neighbors (forest_from, ltreeid, element, half_neighbors, neigh_scheme,
+                                                           iface, num_half_neighbors, NULL);
+    if (neighbor_tree >= 0) {
+      /* If any of the half neighbors needs to be refined, it has descendants of level + 2
+       * at this face and the element must be refined as well. */
+      for (ineigh = 0; ineigh < num_half_neighbors && !refine; ineigh++) {
+        refine = t8_forest_balance_onepass_need_refine (onepass, neighbor_tree, half_neighbors[ineigh], neigh_scheme);
+      }
+    }
+    neigh_scheme->t8_element_destroy (num_half_neighbors, half_neighbors);
+    T8_FREE (half_neighbors);
+  }
+
+  /* Store the answer */
+  entry = (t8_forest_balance_refine_hash_t *) sc_mempool_alloc (onepass->hash_mempool);
+  *entry = query;
+  entry->refine = refine;
+#ifdef T8_ENABLE_DEBUG
+  ret =
+#else
+  (void)
+#endif
+    sc_hash_insert_unique (onepass->refine_hash, entry, NULL);
+  T8_ASSERT (ret);
+  return refine;
+}
+
+/* This is the recursive adapt function of a one-pass balance round.
+ * An element (or a child of a refined element) is refined if it needs to be
+ * refined in the balanced forest of forest_from. */
+static int
+t8_forest_balance_onepass_adapt (t8_forest_t forest, t8_forest_t forest_from, t8_locidx_t ltree_id,
+                                 t8_locidx_t lelement_id, t8_eclass_scheme_c *ts, const int is_family,
+                                 const int num_elements, t8_element_t *elements[])
+{
+  t8_forest_balance_onepass_t *onepass = (t8_forest_balance_onepass_t *) forest->t8code_data;
+
+  T8_ASSERT (onepass->forest_from == forest_from);
+  if (t8_forest_balance_onepass_need_refine (onepass, t8_forest_global_tree_id (forest_from, ltree_id), elements[0],
+                                             ts)) {
+    return 1;
+  }
+  return 0;
+}
+
+/* Initialize the data of a one-pass balance round of forest_from. */
+static void
+t8_forest_balance_onepass_init (t8_forest_balance_onepass_t *onepass, t8_forest_t forest_from)
+{
+  t8_locidx_t ielement, num_elements;
+
+  onepass->forest_from = forest_from;
+  onepass->hash_mempool = sc_mempool_new (sizeof (t8_forest_balance_refine_hash_t));
+  onepass->refine_hash
+    = sc_hash_new (t8_forest_balance_refine_hash_function, t8_forest_balance_refine_hash_equal, NULL, NULL);
+  num_elements = t8_forest_get_local_num_elements (forest_from);
+  onepass->neighbor_maxlevel = T8_ALLOC (int, num_elements);
+  for (ielement = 0; ielement < num_elements; ielement++) {
+    onepass->neighbor_maxlevel[ielement] = -1;
+  }
+}
+
+/* Free the data of a one-pass balance round. */
+static void
+t8_forest_balance_onepass_reset (t8_forest_balance_onepass_t *onepass)
+{
+  sc_hash_destroy (onepass->refine_hash);
+  sc_mempool_destroy (onepass->hash_mempool);
+  T8_FREE (onepass->neighbor_maxlevel);
+  onepass->forest_from = NULL;
+}
+
 /* Collective function to compute the maximum occurring refinement level in a forest */
 static void
 t8_forest_compute_max_element_level (t8_forest_t forest)
@@ -127,8 +401,10 @@ void
 t8_forest_balance (t8_forest_t forest, int repartition)
 {
   t8_forest_t forest_temp, forest_from, forest_partition;
+  t8_forest_balance_onepass_t onepass;
   int done = 0, done_global = 0;
   int count_rounds = 0;
+  t8_locidx_t num_elements_from;
   /* The following variables are only required if profiling is
    * enabled. */
   int num_stats_allocated, istats;
@@ -140,6 +416,9 @@ t8_forest_balance (t8_forest_t forest, int repartition)
 
   t8_global_productionf ("Into t8_forest_balance with %lli global elements.\n",
                          (long long) t8_forest_get_global_num_elements (forest->set_from));
+  if (forest->set_balance_onepass) {
+    t8_global_productionf ("Using one-pass balance.\n");
+  }
   t8_log_indent_push ();
 
   /* Set default value to prevent compiler warning */
@@ -175,26 +454,40 @@ t8_forest_balance (t8_forest_t forest, int repartition)
   }
 
   while (!done_global) {
-    done = 1;
-
     T8_ASSERT (forest_from->maxlevel_existing >= 0);
     /* Initialize the temp forest to be adapted from forest_from */
     t8_forest_init (&forest_temp);
     /* Update the maximum occurring level */
     forest_temp->maxlevel_existing = forest_from->maxlevel_existing;
     /* Adapt the forest */
-    t8_forest_set_adapt (forest_temp, forest_from, t8_forest_balance_adapt, 0);
+    if (forest->set_balance_onepass) {
+      /* Refine recursively all elements that need to be refined in the balanced forest */
+      t8_forest_balance_onepass_init (&onepass, forest_from);
+      t8_forest_set_adapt (forest_temp, forest_from, t8_forest_balance_onepass_adapt, 1);
+      forest_temp->t8code_data = &onepass;
+    }
+    else {
+      t8_forest_set_adapt (forest_temp, forest_from, t8_forest_balance_adapt, 0);
+    }
+    /* The balance adapt function only reads forest_from and may thus run on several threads.
+     * A recursive adapt always runs on one thread. */
+    t8_forest_set_num_threads (forest_temp, forest->num_threads);
     if (!repartition) {
       t8_forest_set_ghost (forest_temp, 1, T8_GHOST_FACES);
     }
-    forest_temp->t8code_data = &done;
     /* If profiling is enabled, measure ghost/adapt rumtimes */
     if (forest->profile != NULL) {
       t8_forest_set_profiling (forest_temp, 1);
     }
     t8_global_productionf ("Profiling: %i\n", forest->profile != NULL);
+    /* Balance only refines, thus the round changed nothing if the number of elements stays the same.
+     * We store the number now, since committing forest_temp may destroy forest_from. */
+    num_elements_from = t8_forest_get_local_num_elements (forest_from);
     /* Adapt the forest */
     t8_forest_commit (forest_temp);
+    if (forest->set_balance_onepass) {
+      t8_forest_balance_onepass_reset (&onepass);
+    }
     /* Store the runtimes of adapt and ghost */
     if (forest->profile != NULL) {
       if (count_rounds > num_stats_allocated - 2) {
@@ -218,16 +511,20 @@ t8_forest_balance (t8_forest_t forest, int repartition)
       }
     }
 
-    /* Compute the logical and of all process local done values, if this results
-     * in 1 then all processes are finished */
-    sc_MPI_Allreduce (&done, &done_global, 1, sc_MPI_INT, sc_MPI_LAND, forest->mpicomm);
+    if (!forest->set_balance_onepass) {
+      /* Compute the logical and of all process local done values, if this results
+       * in 1 then all processes are finished */
+      done = t8_forest_get_local_num_elements (forest_temp) == num_elements_from;
+      sc_MPI_Allreduce (&done, &done_global, 1, sc_MPI_INT, sc_MPI_LAND, forest->mpicomm);
+    }
 
-    if (repartition && !done_global) {
+    if (repartition && (forest->set_balance_onepass || !done_global)) {
       /* If repartitioning is used, we partition the forest */
       t8_forest_init (&forest_partition);
       /* Update the maximum occurring level */
       forest_partition->maxlevel_existing = forest_temp->maxlevel_existing;
       t8_forest_set_partition (forest_partition, forest_temp, 0);
+      t8_forest_set_partition_weight_function (forest_partition, forest->set_partition_weight_fn);
       t8_forest_set_ghost (forest_partition, 1, T8_GHOST_FACES);
       /* If profiling is enabled, measure partition rumtimes */
       if (forest->profile != NULL) {
@@ -248,6 +545,15 @@ t8_forest_balance (t8_forest_t forest, int repartition)
       forest_temp = forest_partition;
       forest_partition = NULL;
     }
+    if (forest->set_balance_onepass) {
+      /* The one-pass refinement resolves all conflicts that can be seen from the local
+       * elements and their face neighbors. We only need another round if there are
+       * conflicts left across process boundaries. Instead of reducing whether any element
+       * was refined, we directly reduce whether the new forest is balanced. This needs
+       * the ghosts of forest_temp, which is why we always repartition first. */
+      done = t8_forest_is_balanced (forest_temp);
+      sc_MPI_Allreduce (&done, &done_global, 1, sc_MPI_INT, sc_MPI_LAND, forest->mpicomm);
+    }
     /* Adapt forest_temp in the next round */
     forest_from = forest_temp;
     count_rounds++;
@@ -283,6 +589,9 @@ t8_forest_balance (t8_forest_t forest, int repartition)
         part_time += partition_stats[istats].sum_values;
       }
     }
+    forest->profile->balance_adapt_runtime = ada_time;
+    forest->profile->balance_ghost_runtime = ghost_time;
+    forest->profile->balance_partition_runtime = part_time;
     sc_stats_set1 (&adap_stats[count_adapt_stats], ada_time, "forest balance: Total adapt time");
     sc_stats_set1 (&ghost_stats[count_ghost_stats], ghost_time, "forest balance: Total ghost time");
     if (repartition) {
@@ -317,8 +626,6 @@ t8_forest_is_balanced (t8_forest_t forest)
   t8_locidx_t num_trees, num_elements;
   t8_locidx_t itree, ielem;
   t8_eclass_scheme_c *ts;
-  void *data_temp;
-  int dummy_int;
 
   T8_ASSERT (t8_forest_is_committed (forest));
 
@@ -327,10 +634,6 @@ t8_forest_is_balanced (t8_forest_t forest)
 
   forest->set_from = forest;
 
-  /* temporarily save forest t8code_data */
-  data_temp = forest->t8code_data;
-  forest->t8code_data = &dummy_int;
-
   num_trees = t8_forest_get_num_local_trees (forest);
   /* Iterate over all trees */
   for (itree = 0; itree < num_trees; itree++) {
@@ -343,13 +646,11 @@ t8_forest_is_balanced (t8_forest_t forest)
        * If so, the forest is not balanced locally. */
       if (t8_forest_balance_adapt (forest, forest, itree, ielem, ts, 0, 1, (t8_element_t **) (&element))) {
         forest->set_from = forest_from;
-        forest->t8code_data = data_temp;
         return 0;
       }
     }
   }
   forest->set_from = forest_from;
-  forest->t8code_data = data_temp;
   return 1;
 }
 
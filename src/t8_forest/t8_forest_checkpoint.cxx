@@ -0,0 +1,420 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+#include <t8_forest/t8_forest_io.h>
+#include <t8_forest/t8_forest_types.h>
+#include <t8_forest/t8_forest_private.h>
+#include <t8_forest/t8_forest_general.h>
+#include <t8_cmesh.h>
+#include <t8_element_cxx.hxx>
+#include <algorithm>
+#include <vector>
+
+/* A checkpoint file stores a forest independently of the number of processes
+ * that wrote it. All integers are stored in the byte order of the writing machine.
+ * The file consists of the following sections, each starting at a multiple of 8 bytes:
+ *
+ *   header         T8_FOREST_CHECKPOINT_HEADER_SIZE int64, indexed by t8_forest_checkpoint_header_entry_t
+ *   partition      mpisize + 1 int64, the element offsets of the processes that wrote the file
+ *   tree offsets   global_num_trees + 1 int64, the global index of the first element of each tree
+ *   tree classes   global_num_trees int8, the eclass of each tree
+ *   linear ids     global_num_elements uint64, the linear id of each element on its own level
+ *   levels         global_num_elements int8, the level of each element
+ *   element data   global_num_elements * data_size bytes of user data (optional)
+ */
+
+/** The string "t8forest" read as a big endian integer. */
+#define T8_FOREST_CHECKPOINT_MAGIC 0x7438666f72657374LL
+/** The version of the checkpoint format. Increase when the layout changes. */
+#define T8_FOREST_CHECKPOINT_VERSION 1
+
+typedef enum {
+  T8_FOREST_CHECKPOINT_MAGIC_ENTRY = 0,
+  T8_FOREST_CHECKPOINT_VERSION_ENTRY,
+  T8_FOREST_CHECKPOINT_DIMENSION,
+  T8_FOREST_CHECKPOINT_NUM_TREES,
+  T8_FOREST_CHECKPOINT_NUM_ELEMENTS,
+  T8_FOREST_CHECKPOINT_MPISIZE,
+  T8_FOREST_CHECKPOINT_DATA_SIZE,
+  T8_FOREST_CHECKPOINT_HEADER_SIZE = 8 /* The remaining entries are reserved */
+} t8_forest_checkpoint_header_entry_t;
+
+/* The byte offsets of the sections of a checkpoint file. */
+typedef struct
+{
+  t8_gloidx_t partition;
+  t8_gloidx_t tree_offsets;
+  t8_gloidx_t tree_classes;
+  t8_gloidx_t linear_ids;
+  t8_gloidx_t levels;
+  t8_gloidx_t element_data;
+} t8_forest_checkpoint_layout_t;
+
+/* An open checkpoint file, shared by all processes of a communicator. */
+typedef struct
+{
+#ifdef T8_ENABLE_MPIIO
+  MPI_File file;
+#else
+  FILE *file;
+#endif
+  sc_MPI_Comm comm;
+} t8_forest_checkpoint_file_t;
+
+/* Round a byte count up to the next multiple of 8. */
+static t8_gloidx_t
+t8_forest_checkpoint_pad (const t8_gloidx_t bytes)
+{
+  return (bytes + 7) / 8 * 8;
+}
+
+static void
+t8_forest_checkpoint_compute_layout (const int64_t *header, t8_forest_checkpoint_layout_t *layout)
+{
+  const t8_gloidx_t num_trees = header[T8_FOREST_CHECKPOINT_NUM_TREES];
+  const t8_gloidx_t num_elements = header[T8_FOREST_CHECKPOINT_NUM_ELEMENTS];
+
+  layout->partition = T8_FOREST_CHECKPOINT_HEADER_SIZE * sizeof (int64_t);
+  layout->tree_offsets = layout->partition + (header[T8_FOREST_CHECKPOINT_MPISIZE] + 1) * sizeof (int64_t);
+  layout->tree_classes = layout->tree_offsets + (num_trees + 1) * sizeof (int64_t);
+  layout->linear_ids = layout->tree_classes + t8_forest_checkpoint_pad (num_trees);
+  layout->levels = layout->linear_ids + num_elements * sizeof (uint64_t);
+  layout->element_data = layout->levels + t8_forest_checkpoint_pad (num_elements);
+}
+
+/* Open a checkpoint file on all processes of comm.
+ * If do_write is true, the file is created or truncated, otherwise it is opened for reading. */
+static void
+t8_forest_checkpoint_open (t8_forest_checkpoint_file_t *file, const char *filename, const int do_write,
+                           sc_MPI_Comm comm)
+{
+  file->comm = comm;
+#ifdef T8_ENABLE_MPIIO
+  const int amode = do_write ? MPI_MODE_WRONLY | MPI_MODE_CREATE : MPI_MODE_RDONLY;
+  int mpiret = MPI_File_open (comm, filename, amode, MPI_INFO_NULL, &file->file);
+  SC_CHECK_ABORTF (mpiret == MPI_SUCCESS, "Could not open checkpoint file %s.\n", filename);
+  if (do_write) {
+    /* Discard the content of an existing file */
+    mpiret = MPI_File_set_size (file->file, 0);
+    SC_CHECK_MPI (mpiret);
+  }
+#else
+  if (do_write) {
+    int mpirank;
+    int mpiret = sc_MPI_Comm_rank (comm, &mpirank);
+    SC_CHECK_MPI (mpiret);
+    /* Without MPI-IO the first process creates the file and afterwards
+     * all processes write into it with positioned stdio calls. */
+    if (mpirank == 0) {
+      file->file = fopen (filename, "wb");
+      SC_CHECK_ABORTF (file->file != NULL, "Could not create checkpoint file %s.\n", filename);
+      fclose (file->file);
+    }
+    mpiret = sc_MPI_Barrier (comm);
+    SC_CHECK_MPI (mpiret);
+  }
+  file->file = fopen (filename, do_write ? "r+b" : "rb");
+  SC_CHECK_ABORTF (file->file != NULL, "Could not open checkpoint file %s.\n", filename);
+#endif
+}
+
+static void
+t8_forest_checkpoint_close (t8_forest_checkpoint_file_t *file)
+{
+#ifdef T8_ENABLE_MPIIO
+  const int mpiret = MPI_File_close (&file->file);
+  SC_CHECK_MPI (mpiret);
+#else
+  fclose (file->file);
+  /* Make sure that all processes finished writing before anyone reads the file. */
+  const int mpiret = sc_MPI_Barrier (file->comm);
+  SC_CHECK_MPI (mpiret);
+#endif
+}
+
+/* Collectively write (do_write true) or read num_bytes bytes at the byte position offset.
+ * Each process may pass a different offset and number of bytes, including zero. */
+static void
+t8_forest_checkpoint_access_at_all (t8_forest_checkpoint_file_t *file, const int do_write, const t8_gloidx_t offset,
+                                    void *buffer, const size_t num_bytes)
+{
+#ifdef T8_ENABLE_MPIIO
+  /* MPI counts are int, hence we transfer large blocks in chunks.
+   * All processes need to take part in each collective call. */
+  const size_t max_chunk = (size_t) 1 << 30;
+  int num_chunks = (int) ((num_bytes + max_chunk - 1) / max_chunk);
+  int max_num_chunks;
+  int mpiret = sc_MPI_Allreduce (&num_chunks, &max_num_chunks, 1, sc_MPI_INT, sc_MPI_MAX, file->comm);
+  SC_CHECK_MPI (mpiret);
+  for (int ichunk = 0; ichunk < max_num_chunks; ichunk++) {
+    const size_t begin = SC_MIN ((size_t) ichunk * max_chunk, num_bytes);
+    const int count = (int) SC_MIN (max_chunk, num_bytes - begin);
+    const MPI_Offset chunk_offset = offset + begin;
+    char *chunk = (char *) buffer + begin;
+    if (do_write) {
+      mpiret = MPI_File_write_at_all (file->file, chunk_offset, chunk, count, MPI_BYTE, MPI_STATUS_IGNORE);
+    }
+    else {
+      mpiret = MPI_File_read_at_all (file->file, chunk_offset, chunk, count, MPI_BYTE, MPI_STATUS_IGNORE);
+    }
+    SC_CHECK_ABORT (mpiret == MPI_SUCCESS, "Error accessing the checkpoint file.\n");
+  }
+#else
+  if (num_bytes == 0) {
+    return;
+  }
+#ifdef _WIN32
+  int retval = _fseeki64 (file->file, offset, SEEK_SET);
+#else
+  int retval = fseeko (file->file, (off_t) offset, SEEK_SET);
+#endif
+  SC_CHECK_ABORT (retval == 0, "Error seeking in the checkpoint file.\n");
+  const size_t count
+    = do_write ? fwrite (buffer, 1, num_bytes, file->file) : fread (buffer, 1, num_bytes, file->file);
+  SC_CHECK_ABORT (count == num_bytes, "Error accessing the checkpoint file.\n");
+#endif
+}
+
+/* Read and check the header of a checkpoint file. */
+static void
+t8_forest_checkpoint_read_header (t8_forest_checkpoint_file_t *file, const char *filename, int64_t *header)
+{
+  t8_forest_checkpoint_access_at_all (file, 0, 0, header, T8_FOREST_CHECKPOINT_HEADER_SIZE * sizeof (int64_t));
+  SC_CHECK_ABORTF (header[T8_FOREST_CHECKPOINT_MAGIC_ENTRY] == T8_FOREST_CHECKPOINT_MAGIC,
+                   "%s is not a forest checkpoint or was written on a machine with a different byte order.\n",
+                   filename);
+  SC_CHECK_ABORTF (header[T8_FOREST_CHECKPOINT_VERSION_ENTRY] == T8_FOREST_CHECKPOINT_VERSION,
+                   "Unsupported version %lli of forest checkpoint %s.\n",
+                   (long long) header[T8_FOREST_CHECKPOINT_VERSION_ENTRY], filename);
+}
+
+T8_EXTERN_C_BEGIN ();
+
+void
+t8_forest_save_ext (t8_forest_t forest, const char *filename, const sc_array_t *element_data)
+{
+  T8_ASSERT (t8_forest_is_committed (forest));
+  T8_ASSERT (filename != NULL);
+  T8_ASSERT (element_data == NULL || element_data->elem_count == (size_t) forest->local_num_elements);
+  SC_CHECK_ABORT (!forest->incomplete_trees, "Saving forests with removed elements is not supported.\n");
+
+  const t8_locidx_t num_local_trees = t8_forest_get_num_local_trees (forest);
+  const t8_gloidx_t first_element = t8_forest_get_first_local_element_id (forest);
+  const t8_gloidx_t *element_offsets = t8_shmem_array_get_gloidx_array (forest->element_offsets);
+
+  int64_t header[T8_FOREST_CHECKPOINT_HEADER_SIZE] = { 0 };
+  header[T8_FOREST_CHECKPOINT_MAGIC_ENTRY] = T8_FOREST_CHECKPOINT_MAGIC;
+  header[T8_FOREST_CHECKPOINT_VERSION_ENTRY] = T8_FOREST_CHECKPOINT_VERSION;
+  header[T8_FOREST_CHECKPOINT_DIMENSION] = forest->dimension;
+  header[T8_FOREST_CHECKPOINT_NUM_TREES] = forest->global_num_trees;
+  header[T8_FOREST_CHECKPOINT_NUM_ELEMENTS] = forest->global_num_elements;
+  header[T8_FOREST_CHECKPOINT_MPISIZE] = forest->mpisize;
+  header[T8_FOREST_CHECKPOINT_DATA_SIZE] = element_data != NULL ? element_data->elem_size : 0;
+  t8_forest_checkpoint_layout_t layout;
+  t8_forest_checkpoint_compute_layout (header, &layout);
+
+  t8_forest_checkpoint_file_t file;
+  t8_forest_checkpoint_open (&file, filename, 1, forest->mpicomm);
+
+  /* The first process writes the header and the partition */
+  std::vector<int64_t> header_and_partition;
+  if (forest->mpirank == 0) {
+    header_and_partition.assign (header, header + T8_FOREST_CHECKPOINT_HEADER_SIZE);
+    header_and_partition.insert (header_and_partition.end (), element_offsets, element_offsets + forest->mpisize + 1);
+  }
+  t8_forest_checkpoint_access_at_all (&file, 1, 0, header_and_partition.data (),
+                                      header_and_partition.size () * sizeof (int64_t));
+
+  /* Each process writes the offsets and classes of the trees that start on it.
+   * The process holding the last element additionally writes the total number of elements. */
+  std::vector<int64_t> tree_offsets;
+  std::vector<int8_t> tree_classes;
+  const t8_locidx_t first_written_tree = num_local_trees > 0 && t8_forest_first_tree_shared (forest) ? 1 : 0;
+  for (t8_locidx_t itree = first_written_tree; itree < num_local_trees; itree++) {
+    tree_offsets.push_back (first_element + t8_forest_get_tree_element_offset (forest, itree));
+    tree_classes.push_back ((int8_t) t8_forest_get_tree_class (forest, itree));
+  }
+  if (forest->local_num_elements > 0 && first_element + forest->local_num_elements == forest->global_num_elements) {
+    tree_offsets.push_back (forest->global_num_elements);
+  }
+  const t8_gloidx_t first_written_gtree = forest->first_local_tree + first_written_tree;
+  t8_forest_checkpoint_access_at_all (&file, 1, layout.tree_offsets + first_written_gtree * sizeof (int64_t),
+                                      tree_offsets.data (), tree_offsets.size () * sizeof (int64_t));
+  t8_forest_checkpoint_access_at_all (&file, 1, layout.tree_classes + first_written_gtree, tree_classes.data (),
+                                      tree_classes.size ());
+
+  /* Each process writes the linear ids and levels of its elements */
+  std::vector<uint64_t> linear_ids (forest->local_num_elements);
+  std::vector<int8_t> levels (forest->local_num_elements);
+  for (t8_locidx_t itree = 0, ielement = 0; itree < num_local_trees; itree++) {
+    const t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, t8_forest_get_tree_class (forest, itree));
+    const t8_locidx_t num_tree_elements = t8_forest_get_tree_num_elements (forest, itree);
+    for (t8_locidx_t ielem_in_tree = 0; ielem_in_tree < num_tree_elements; ielem_in_tree++, ielement++) {
+      const t8_element_t *element = t8_forest_get_element_in_tree (forest, itree, ielem_in_tree);
+      const int level = ts->t8_element_level (element);
+      levels[ielement] = (int8_t) level;
+      linear_ids[ielement] = ts->t8_element_get_linear_id (element, level);
+    }
+  }
+  t8_forest_checkpoint_access_at_all (&file, 1, layout.linear_ids + first_element * sizeof (uint64_t),
+                                      linear_ids.data (), linear_ids.size () * sizeof (uint64_t));
+  t8_forest_checkpoint_access_at_all (&file, 1, layout.levels + first_element, levels.data (), levels.size ());
+
+  if (element_data != NULL) {
+    t8_forest_checkpoint_access_at_all (&file, 1, layout.element_data + first_element * element_data->elem_size,
+                                        element_data->array, element_data->elem_count * element_data->elem_size);
+  }
+  t8_forest_checkpoint_close (&file);
+  t8_global_productionf ("Saved forest with %lli elements to %s.\n", (long long) forest->global_num_elements,
+                         filename);
+}
+
+void
+t8_forest_save (t8_forest_t forest, const char *filename)
+{
+  t8_forest_save_ext (forest, filename, NULL);
+}
+
+void
+t8_forest_load_element_data (t8_forest_t forest, const char *filename, sc_array_t *element_data)
+{
+  T8_ASSERT (t8_forest_is_committed (forest));
+  T8_ASSERT (filename != NULL);
+  T8_ASSERT (element_data != NULL);
+
+  t8_forest_checkpoint_file_t file;
+  int64_t header[T8_FOREST_CHECKPOINT_HEADER_SIZE];
+  t8_forest_checkpoint_open (&file, filename, 0, forest->mpicomm);
+  t8_forest_checkpoint_read_header (&file, filename, header);
+  SC_CHECK_ABORTF (header[T8_FOREST_CHECKPOINT_DATA_SIZE] == (int64_t) element_data->elem_size,
+                   "Checkpoint %s stores %lli bytes of data per element, expected %lli.\n", filename,
+                   (long long) header[T8_FOREST_CHECKPOINT_DATA_SIZE], (long long) element_data->elem_size);
+  SC_CHECK_ABORTF (header[T8_FOREST_CHECKPOINT_NUM_ELEMENTS] == forest->global_num_elements,
+                   "Checkpoint %s does not match the forest.\n", filename);
+  t8_forest_checkpoint_layout_t layout;
+  t8_forest_checkpoint_compute_layout (header, &layout);
+
+  const t8_gloidx_t first_element = t8_forest_get_first_local_element_id (forest);
+  sc_array_resize (element_data, forest->local_num_elements);
+  t8_forest_checkpoint_access_at_all (&file, 0, layout.element_data + first_element * element_data->elem_size,
+                                      element_data->array, element_data->elem_count * element_data->elem_size);
+  t8_forest_checkpoint_close (&file);
+}
+
+void
+t8_forest_load_checkpoint (t8_forest_t forest)
+{
+  T8_ASSERT (forest->set_load_filename != NULL);
+  T8_ASSERT (forest->cmesh != NULL && forest->scheme_cxx != NULL);
+  T8_ASSERT (forest->mpisize > 0 && forest->maxlevel >= 0);
+  const char *filename = forest->set_load_filename;
+
+  t8_forest_checkpoint_file_t file;
+  int64_t header[T8_FOREST_CHECKPOINT_HEADER_SIZE];
+  t8_forest_checkpoint_open (&file, filename, 0, forest->mpicomm);
+  t8_forest_checkpoint_read_header (&file, filename, header);
+  const t8_gloidx_t num_trees = header[T8_FOREST_CHECKPOINT_NUM_TREES];
+  const t8_gloidx_t num_elements = header[T8_FOREST_CHECKPOINT_NUM_ELEMENTS];
+  SC_CHECK_ABORTF (num_trees == t8_cmesh_get_num_trees (forest->cmesh)
+                     && header[T8_FOREST_CHECKPOINT_DIMENSION] == forest->dimension,
+                   "The coarse mesh does not match the forest in checkpoint %s.\n", filename);
+  t8_forest_checkpoint_layout_t layout;
+  t8_forest_checkpoint_compute_layout (header, &layout);
+
+  /* Compute the range of elements of this process. If the number of processes did not change,
+   * we restore the partition of the saved forest, otherwise we partition the elements uniformly. */
+  t8_gloidx_t element_range[2];
+  if (header[T8_FOREST_CHECKPOINT_MPISIZE] == forest->mpisize) {
+    t8_forest_checkpoint_access_at_all (&file, 0, layout.partition + forest->mpirank * sizeof (int64_t), element_range,
+                                        sizeof (element_range));
+  }
+  else {
+    for (int irank = 0; irank < 2; irank++) {
+      const t8_gloidx_t rank = forest->mpirank + irank;
+      element_range[irank] = num_elements / forest->mpisize * rank + SC_MIN (rank, num_elements % forest->mpisize);
+    }
+  }
+  const t8_gloidx_t first_element = element_range[0];
+  const t8_locidx_t num_local_elements = element_range[1] - element_range[0];
+
+  /* Every process reads all tree offsets to find its local trees */
+  std::vector<int64_t> tree_offsets (num_trees + 1);
+  t8_forest_checkpoint_access_at_all (&file, 0, layout.tree_offsets, tree_offsets.data (),
+                                      tree_offsets.size () * sizeof (int64_t));
+  t8_gloidx_t first_tree = 0;
+  t8_locidx_t num_local_trees = 0;
+  if (num_local_elements > 0) {
+    /* The local trees are those containing the first and the last local element */
+    const auto tree_of_element = [&tree_offsets] (const t8_gloidx_t ielement) -> t8_gloidx_t {
+      return std::upper_bound (tree_offsets.begin (), tree_offsets.end (), ielement) - tree_offsets.begin () - 1;
+    };
+    first_tree = tree_of_element (first_element);
+    num_local_trees = tree_of_element (element_range[1] - 1) - first_tree + 1;
+  }
+  std::vector<int8_t> tree_classes (num_local_trees);
+  std::vector<uint64_t> linear_ids (num_local_elements);
+  std::vector<int8_t> levels (num_local_elements);
+  t8_forest_checkpoint_access_at_all (&file, 0, layout.tree_classes + first_tree, tree_classes.data (),
+                                      tree_classes.size ());
+  t8_forest_checkpoint_access_at_all (&file, 0, layout.linear_ids + first_element * sizeof (uint64_t),
+                                      linear_ids.data (), linear_ids.size () * sizeof (uint64_t));
+  t8_forest_checkpoint_access_at_all (&file, 0, layout.levels + first_element, levels.data (), levels.size ());
+  t8_forest_checkpoint_close (&file);
+
+  /* Build the local trees from the elements */
+  forest->trees = sc_array_new_count (sizeof (t8_tree_struct_t), num_local_trees);
+  for (t8_locidx_t itree = 0, ielement = 0; itree < num_local_trees; itree++) {
+    const t8_gloidx_t gtree = first_tree + itree;
+    t8_tree_t tree = (t8_tree_t) t8_sc_array_index_locidx (forest->trees, itree);
+    tree->eclass = (t8_eclass_t) tree_classes[itree];
+    tree->elements_offset = ielement;
+    t8_eclass_scheme_c *ts = forest->scheme_cxx->eclass_schemes[tree->eclass];
+    SC_CHECK_ABORTF (ts != NULL, "Checkpoint %s contains a tree of unsupported class.\n", filename);
+    const t8_gloidx_t tree_end = SC_MIN (tree_offsets[gtree + 1], element_range[1]);
+    const t8_locidx_t num_tree_elements = tree_end - SC_MAX (tree_offsets[gtree], first_element);
+    T8_ASSERT (num_tree_elements > 0);
+    t8_element_array_init_size (&tree->elements, ts, num_tree_elements);
+    for (t8_locidx_t ielem_in_tree = 0; ielem_in_tree < num_tree_elements; ielem_in_tree++, ielement++) {
+      const int level = levels[ielement];
+      SC_CHECK_ABORTF (0 <= level && level <= forest->maxlevel,
+                       "Checkpoint %s contains an element of level %i exceeding the maximum level %i.\n", filename,
+                       level, forest->maxlevel);
+      T8_ASSERT ((t8_gloidx_t) linear_ids[ielement] < ts->t8_element_count_leaves_from_root (level));
+      t8_element_t *element = t8_element_array_index_locidx (&tree->elements, ielem_in_tree);
+      ts->t8_element_set_linear_id (element, level, linear_ids[ielement]);
+    }
+  }
+  if (num_local_trees > 0) {
+    forest->first_local_tree = first_tree;
+    forest->last_local_tree = first_tree + num_local_trees - 1;
+  }
+  else {
+    /* This process is empty */
+    forest->first_local_tree = 0;
+    forest->last_local_tree = -1;
+  }
+  forest->local_num_elements = num_local_elements;
+  forest->global_num_elements = num_elements;
+  t8_global_productionf ("Loaded forest with %lli elements from %s.\n", (long long) num_elements, filename);
+}
+
+T8_EXTERN_C_END ();
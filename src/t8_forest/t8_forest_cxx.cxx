@@ -31,6 +31,7 @@
 #include <t8_forest/t8_forest_private.h>
 #include <t8_forest/t8_forest_ghost.h>
 #include <t8_forest/t8_forest_balance.h>
+#include <t8_forest/t8_forest_iterate.h>
 #include <t8_element_cxx.hxx>
 #include <t8_element_c_interface.h>
 #include <t8_cmesh/t8_cmesh_trees.h>
@@ -41,6 +42,11 @@
 #include <t8_geometry/t8_geometry_implementations/t8_geometry_linear_axis_aligned.h>
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
 /* We want to export the whole implementation to be callable from "C" */
 T8_EXTERN_C_BEGIN ();
 
@@ -361,6 +367,16 @@ t8_forest_is_equal (t8_forest_t forest_a, t8_forest_t forest_b)
   return 1;
 }
 
+/* Evaluate the geometry of a tree for the element geometry functions below.
+ * We use the re-entrant evaluation such that these functions can be called from multiple threads,
+ * also if the cmesh records geometry timings in its profile. */
+static void
+t8_forest_geometry_evaluate (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords, const size_t num_coords,
+                             double *out_coords)
+{
+  t8_geometry_evaluate_threadsafe (cmesh, gtreeid, ref_coords, num_coords, out_coords, NULL);
+}
+
 /* given an element in a coarse tree, the corner coordinates of the coarse tree
  * and a corner number of the element compute the coordinates of that corner
  * within the coarse tree.
@@ -388,7 +404,7 @@ t8_forest_element_coordinate (t8_forest_t forest, t8_locidx_t ltree_id, const t8
   /* Get the cmesh */
   cmesh = t8_forest_get_cmesh (forest);
   /* Evaluate the geometry */
-  t8_geometry_evaluate (cmesh, gtreeid, vertex_coords, 1, coordinates);
+  t8_forest_geometry_evaluate (cmesh, gtreeid, vertex_coords, 1, coordinates);
 }
 
 void
@@ -402,7 +418,11 @@ t8_forest_element_from_ref_coords_ext (t8_forest_t forest, t8_locidx_t ltreeid,
   const t8_cmesh_t cmesh = t8_forest_get_cmesh (forest);
   const t8_gloidx_t gtreeid = t8_forest_global_tree_id (forest, ltreeid);
 
-  double *tree_ref_coords = T8_ALLOC (double, (tree_dim == 0 ? 1 : tree_dim) * num_coords);
+  /* Use a stack buffer for the common case of few coordinates, since T8_ALLOC is not thread-safe. */
+  double tree_ref_coords_buffer[T8_ECLASS_MAX_CORNERS * T8_ECLASS_MAX_DIM];
+  double *tree_ref_coords = num_coords <= T8_ECLASS_MAX_CORNERS
+                              ? tree_ref_coords_buffer
+                              : T8_ALLOC (double, (tree_dim == 0 ? 1 : tree_dim) * num_coords);
 
   if (stretch_factors != NULL) {
 #if T8_ENABLE_DEBUG
@@ -423,9 +443,11 @@ t8_forest_element_from_ref_coords_ext (t8_forest_t forest, t8_locidx_t ltreeid,
     scheme->t8_element_reference_coords (element, ref_coords, num_coords, tree_ref_coords);
   }
 
-  t8_geometry_evaluate (cmesh, gtreeid, tree_ref_coords, num_coords, coords_out);
+  t8_forest_geometry_evaluate (cmesh, gtreeid, tree_ref_coords, num_coords, coords_out);
 
-  T8_FREE (tree_ref_coords);
+  if (tree_ref_coords != tree_ref_coords_buffer) {
+    T8_FREE (tree_ref_coords);
+  }
 }
 
 void
@@ -492,6 +514,42 @@ t8_forest_element_centroid (t8_forest_t forest, t8_locidx_t ltreeid, const t8_el
                                      coordinates);
 }
 
+/* The corner and centroid coordinates of an element for the geometrical queries below.
+ * If corners (centroid) is NULL, the coordinates are evaluated on demand, otherwise
+ * they are read from the buffers precomputed by the batched tree queries. */
+typedef struct
+{
+  t8_forest_t forest;          /* The forest. */
+  t8_locidx_t ltreeid;         /* The local tree of the element. */
+  const t8_element_t *element; /* The element. */
+  const double *corners;       /* The coordinates of all corners of element, 3 per corner, or NULL. */
+  const double *centroid;      /* The coordinates of the centroid of element or NULL. */
+} t8_forest_element_coords_t;
+
+/* Get the coordinates of a corner of an element. */
+static void
+t8_forest_element_coords_corner (const t8_forest_element_coords_t *coords, const int corner, double coordinates[3])
+{
+  if (coords->corners != NULL) {
+    t8_vec_copy (coords->corners + 3 * corner, coordinates);
+  }
+  else {
+    t8_forest_element_coordinate (coords->forest, coords->ltreeid, coords->element, corner, coordinates);
+  }
+}
+
+/* Get the coordinates of the centroid of an element. */
+static void
+t8_forest_element_coords_centroid (const t8_forest_element_coords_t *coords, double coordinates[3])
+{
+  if (coords->centroid != NULL) {
+    t8_vec_copy (coords->centroid, coordinates);
+  }
+  else {
+    t8_forest_element_centroid (coords->forest, coords->ltreeid, coords->element, coordinates);
+  }
+}
+
 /* Compute the length of the line from one corner to a second corner in an element */
 static double
 t8_forest_element_line_length (t8_forest_t forest, t8_locidx_t ltreeid, const t8_element_t *element, int corner_a,
@@ -555,10 +613,13 @@ t8_forest_element_tet_volume (const double coordinates[4][3])
   return fabs (t8_vec_dot (coordinates_tmp[0], cross)) / 6;
 }
 
-/* Compute an element's volume */
-double
-t8_forest_element_volume (t8_forest_t forest, t8_locidx_t ltreeid, const t8_element_t *element)
+/* Compute an element's volume from its corner coordinates */
+static double
+t8_forest_element_volume_coords (const t8_forest_element_coords_t *coords)
 {
+  t8_forest_t forest = coords->forest;
+  const t8_locidx_t ltreeid = coords->ltreeid;
+  const t8_element_t *element = coords->element;
   t8_eclass_t tree_class;
   t8_element_shape_t element_shape;
   t8_eclass_scheme_c *ts;
@@ -575,9 +636,13 @@ t8_forest_element_volume (t8_forest_t forest, t8_locidx_t ltreeid, const t8_elem
   case T8_ECLASS_VERTEX:
     /* vertices do not have any volume */
     return 0;
-  case T8_ECLASS_LINE:
-    /* for line, the volume equals the diameter */
-    return t8_forest_element_diam (forest, ltreeid, element);
+  case T8_ECLASS_LINE: {
+    /* for line, the volume equals the diameter, which is the distance of the two corners */
+    double coordinates[2][3];
+    t8_forest_element_coords_corner (coords, 0, coordinates[0]);
+    t8_forest_element_coords_corner (coords, 1, coordinates[1]);
+    return t8_vec_dist (coordinates[0], coordinates[1]);
+  }
   case T8_ECLASS_QUAD: {
     int face_a, face_b, corner_a, corner_b;
     double coordinates[3][3];
@@ -604,9 +669,9 @@ t8_forest_element_volume (t8_forest_t forest, t8_locidx_t ltreeid, const t8_elem
     T8_ASSERT (corner_a != 0 && corner_b != 0);
     T8_ASSERT (corner_a != corner_b);
     /* Compute the coordinates of vertex 0, a and b */
-    t8_forest_element_coordinate (forest, ltreeid, element, 0, coordinates[0]);
-    t8_forest_element_coordinate (forest, ltreeid, element, corner_a, coordinates[1]);
-    t8_forest_element_coordinate (forest, ltreeid, element, corner_b, coordinates[2]);
+    t8_forest_element_coords_corner (coords, 0, coordinates[0]);
+    t8_forest_element_coords_corner (coords, corner_a, coordinates[1]);
+    t8_forest_element_coords_corner (coords, corner_b, coordinates[2]);
     return 2 * t8_forest_element_triangle_area (coordinates);
   } break;
   case T8_ECLASS_TRIANGLE: {
@@ -625,7 +690,7 @@ t8_forest_element_volume (t8_forest_t forest, t8_locidx_t ltreeid, const t8_elem
      * triangle always spans a parallelogram.
      */
     for (i = 0; i < 3; i++) {
-      t8_forest_element_coordinate (forest, ltreeid, element, i, coordinates[i]);
+      t8_forest_element_coords_corner (coords, i, coordinates[i]);
     }
     return t8_forest_element_triangle_area (coordinates);
   } break;
@@ -642,7 +707,7 @@ t8_forest_element_volume (t8_forest_t forest, t8_locidx_t ltreeid, const t8_elem
 
     /* Compute the 4 corner coordinates */
     for (i = 0; i < 4; i++) {
-      t8_forest_element_coordinate (forest, ltreeid, element, i, coordinates[i]);
+      t8_forest_element_coords_corner (coords, i, coordinates[i]);
     }
 
     return t8_forest_element_tet_volume (coordinates);
@@ -655,10 +720,10 @@ t8_forest_element_volume (t8_forest_t forest, t8_locidx_t ltreeid, const t8_elem
     int i;
 
     /* Get the coordinates of the four corners */
-    t8_forest_element_coordinate (forest, ltreeid, element, 0, coordinates[0]);
-    t8_forest_element_coordinate (forest, ltreeid, element, 1, coordinates[1]);
-    t8_forest_element_coordinate (forest, ltreeid, element, 2, coordinates[2]);
-    t8_forest_element_coordinate (forest, ltreeid, element, 4, coordinates[3]);
+    t8_forest_element_coords_corner (coords, 0, coordinates[0]);
+    t8_forest_element_coords_corner (coords, 1, coordinates[1]);
+    t8_forest_element_coords_corner (coords, 2, coordinates[2]);
+    t8_forest_element_coords_corner (coords, 4, coordinates[3]);
 
     /* Compute the difference of each corner with corner 0 */
     for (i = 1; i < 4; i++) {
@@ -678,24 +743,24 @@ t8_forest_element_volume (t8_forest_t forest, t8_locidx_t ltreeid, const t8_elem
     double coordinates[4][3], volume;
 
     /* The first tetrahedron has prism vertices 0, 1, 2, and 4 */
-    t8_forest_element_coordinate (forest, ltreeid, element, 0, coordinates[0]);
-    t8_forest_element_coordinate (forest, ltreeid, element, 1, coordinates[1]);
-    t8_forest_element_coordinate (forest, ltreeid, element, 2, coordinates[2]);
-    t8_forest_element_coordinate (forest, ltreeid, element, 4, coordinates[3]);
+    t8_forest_element_coords_corner (coords, 0, coordinates[0]);
+    t8_forest_element_coords_corner (coords, 1, coordinates[1]);
+    t8_forest_element_coords_corner (coords, 2, coordinates[2]);
+    t8_forest_element_coords_corner (coords, 4, coordinates[3]);
     volume = t8_forest_element_tet_volume (coordinates);
 
     /* The second tetrahedron has prism vertices 0, 2, 3, and 4 */
-    t8_forest_element_coordinate (forest, ltreeid, element, 0, coordinates[0]);
-    t8_forest_element_coordinate (forest, ltreeid, element, 2, coordinates[1]);
-    t8_forest_element_coordinate (forest, ltreeid, element, 3, coordinates[2]);
-    t8_forest_element_coordinate (forest, ltreeid, element, 4, coordinates[3]);
+    t8_forest_element_coords_corner (coords, 0, coordinates[0]);
+    t8_forest_element_coords_corner (coords, 2, coordinates[1]);
+    t8_forest_element_coords_corner (coords, 3, coordinates[2]);
+    t8_forest_element_coords_corner (coords, 4, coordinates[3]);
     volume += t8_forest_element_tet_volume (coordinates);
 
     /* The third tetrahedron has prism vertices 2, 3, 4, and 5 */
-    t8_forest_element_coordinate (forest, ltreeid, element, 2, coordinates[0]);
-    t8_forest_element_coordinate (forest, ltreeid, element, 3, coordinates[1]);
-    t8_forest_element_coordinate (forest, ltreeid, element, 4, coordinates[2]);
-    t8_forest_element_coordinate (forest, ltreeid, element, 5, coordinates[3]);
+    t8_forest_element_coords_corner (coords, 2, coordinates[0]);
+    t8_forest_element_coords_corner (coords, 3, coordinates[1]);
+    t8_forest_element_coords_corner (coords, 4, coordinates[2]);
+    t8_forest_element_coords_corner (coords, 5, coordinates[3]);
     volume += t8_forest_element_tet_volume (coordinates);
 
     return volume;
@@ -703,15 +768,15 @@ t8_forest_element_volume (t8_forest_t forest, t8_locidx_t ltreeid, const t8_elem
   case T8_ECLASS_PYRAMID: {
     double volume, coordinates[4][3];
     /* The first tetrahedron has pyra vertices 0, 1, 3 and 4 */
-    t8_forest_element_coordinate (forest, ltreeid, element, 0, coordinates[0]);
-    t8_forest_element_coordinate (forest, ltreeid, element, 1, coordinates[1]);
-    t8_forest_element_coordinate (forest, ltreeid, element, 3, coordinates[2]);
-    t8_forest_element_coordinate (forest, ltreeid, element, 4, coordinates[3]);
+    t8_forest_element_coords_corner (coords, 0, coordinates[0]);
+    t8_forest_element_coords_corner (coords, 1, coordinates[1]);
+    t8_forest_element_coords_corner (coords, 3, coordinates[2]);
+    t8_forest_element_coords_corner (coords, 4, coordinates[3]);
     volume = t8_forest_element_tet_volume (coordinates);
 
     /* The second tetrahedron has pyra vertices 0, 3, 2 and 4 */
 
-    t8_forest_element_coordinate (forest, ltreeid, element, 2, coordinates[1]);
+    t8_forest_element_coords_corner (coords, 2, coordinates[1]);
 
     volume += t8_forest_element_tet_volume (coordinates);
     return volume;
@@ -722,6 +787,14 @@ t8_forest_element_volume (t8_forest_t forest, t8_locidx_t ltreeid, const t8_elem
   return -1; /* default return prevents compiler warning */
 }
 
+/* Compute an element's volume */
+double
+t8_forest_element_volume (t8_forest_t forest, t8_locidx_t ltreeid, const t8_element_t *element)
+{
+  const t8_forest_element_coords_t coords = { forest, ltreeid, element, NULL, NULL };
+  return t8_forest_element_volume_coords (&coords);
+}
+
 /* Compute the area of an element's face */
 double
 t8_forest_element_face_area (t8_forest_t forest, t8_locidx_t ltreeid, const t8_element_t *element, int face)
@@ -922,10 +995,13 @@ t8_four_points_coplanar (const double p_0[3], const double p_1[3], const double
 }
 #endif
 
-void
-t8_forest_element_face_normal (t8_forest_t forest, t8_locidx_t ltreeid, const t8_element_t *element, int face,
-                               double normal[3])
+/* Compute the normal vector of an element's face from its corner and centroid coordinates */
+static void
+t8_forest_element_face_normal_coords (const t8_forest_element_coords_t *coords, int face, double normal[3])
 {
+  t8_forest_t forest = coords->forest;
+  const t8_locidx_t ltreeid = coords->ltreeid;
+  const t8_element_t *element = coords->element;
   T8_ASSERT (t8_forest_is_committed (forest));
   /* get the eclass of the forest */
   const t8_eclass_t tree_class = t8_forest_get_tree_class (forest, ltreeid);
@@ -948,8 +1024,8 @@ t8_forest_element_face_normal (t8_forest_t forest, t8_locidx_t ltreeid, const t8
     int sign;
 
     /* Get the coordinates of v_0 and v_1 */
-    t8_forest_element_coordinate (forest, ltreeid, element, 0, v_0);
-    t8_forest_element_coordinate (forest, ltreeid, element, 1, normal);
+    t8_forest_element_coords_corner (coords, 0, v_0);
+    t8_forest_element_coords_corner (coords, 1, normal);
 
     /* Compute normal = v_1 - v_0 */
     t8_vec_axpy (v_0, normal, -1);
@@ -988,10 +1064,10 @@ t8_forest_element_face_normal (t8_forest_t forest, t8_locidx_t ltreeid, const t8
     corner_a = ts->t8_element_get_face_corner (element, face, 0);
     corner_b = ts->t8_element_get_face_corner (element, face, 1);
     /* Compute the coordinates of the endnotes */
-    t8_forest_element_coordinate (forest, ltreeid, element, corner_a, vertex_a);
-    t8_forest_element_coordinate (forest, ltreeid, element, corner_b, vertex_b);
+    t8_forest_element_coords_corner (coords, corner_a, vertex_a);
+    t8_forest_element_coords_corner (coords, corner_b, vertex_b);
     /* Compute the center */
-    t8_forest_element_centroid (forest, ltreeid, element, center);
+    t8_forest_element_coords_centroid (coords, center);
 
     /* Compute the difference with V_a.
        * Compute the dot products */
@@ -1040,10 +1116,10 @@ t8_forest_element_face_normal (t8_forest_t forest, t8_locidx_t ltreeid, const t8
     {
       double p_0[3], p_1[3], p_2[3], p_3[3];
       /* Compute the vertex coordinates of the quad */
-      t8_forest_element_coordinate (forest, ltreeid, element, 0, p_0);
-      t8_forest_element_coordinate (forest, ltreeid, element, 1, p_1);
-      t8_forest_element_coordinate (forest, ltreeid, element, 2, p_2);
-      t8_forest_element_coordinate (forest, ltreeid, element, 3, p_3);
+      t8_forest_element_coords_corner (coords, 0, p_0);
+      t8_forest_element_coords_corner (coords, 1, p_1);
+      t8_forest_element_coords_corner (coords, 2, p_2);
+      t8_forest_element_coords_corner (coords, 3, p_3);
       if (!t8_four_points_coplanar (p_0, p_1, p_2, p_3, 1e-16)) {
         t8_debugf ("WARNING: Computing normal to a quad that is not coplanar. This computation will be inaccurate.\n");
       }
@@ -1060,7 +1136,7 @@ t8_forest_element_face_normal (t8_forest_t forest, t8_locidx_t ltreeid, const t8
       /* Compute the i-th corner */
       corner = ts->t8_element_get_face_corner (element, face, i);
       /* Compute the coordinates of this corner */
-      t8_forest_element_coordinate (forest, ltreeid, element, corner, corner_vertices[i]);
+      t8_forest_element_coords_corner (coords, corner, corner_vertices[i]);
     }
     /* Subtract vertex 0 from the other two */
     t8_vec_axpy (corner_vertices[0], corner_vertices[1], -1);
@@ -1072,7 +1148,7 @@ t8_forest_element_face_normal (t8_forest_t forest, t8_locidx_t ltreeid, const t8
     norm = t8_vec_norm (normal);
     T8_ASSERT (norm > 1e-14);
     /* Compute the coordinates of the center of the element */
-    t8_forest_element_centroid (forest, ltreeid, element, center);
+    t8_forest_element_coords_centroid (coords, center);
     /* Compute center = center - vertex_0 */
     t8_vec_axpy (corner_vertices[0], center, -1);
     /* Compute the dot-product of normal and center */
@@ -1089,6 +1165,152 @@ t8_forest_element_face_normal (t8_forest_t forest, t8_locidx_t ltreeid, const t8
   }
 }
 
+void
+t8_forest_element_face_normal (t8_forest_t forest, t8_locidx_t ltreeid, const t8_element_t *element, int face,
+                               double normal[3])
+{
+  const t8_forest_element_coords_t coords = { forest, ltreeid, element, NULL, NULL };
+  t8_forest_element_face_normal_coords (&coords, face, normal);
+}
+
+/* Evaluate the corner coordinates of the elements first_element, ..., first_element + num_elements - 1
+ * of a local tree with a single geometry evaluation.
+ * On output the corners of the i-th element start at corners[3 * corner_offsets[i]]. */
+static void
+t8_forest_tree_elements_corners (t8_forest_t forest, t8_locidx_t ltreeid, t8_locidx_t first_element,
+                                 t8_locidx_t num_elements, std::vector<size_t> &corner_offsets,
+                                 std::vector<double> &corners)
+{
+  const t8_eclass_t tree_class = t8_forest_get_tree_class (forest, ltreeid);
+  const t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, tree_class);
+  const int tree_dim = t8_eclass_to_dimension[tree_class];
+
+  /* Count the corners of all elements. Pyramid trees contain elements with different numbers of corners. */
+  corner_offsets.resize (num_elements + 1);
+  corner_offsets[0] = 0;
+  for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+    const t8_element_t *element = t8_forest_get_element_in_tree (forest, ltreeid, first_element + ielement);
+    corner_offsets[ielement + 1] = corner_offsets[ielement] + ts->t8_element_num_corners (element);
+  }
+  const size_t num_points = corner_offsets[num_elements];
+
+  /* Collect the reference coordinates of all corners in the tree. */
+  std::vector<double> tree_ref_coords (SC_MAX (tree_dim, 1) * num_points);
+  for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+    const t8_element_t *element = t8_forest_get_element_in_tree (forest, ltreeid, first_element + ielement);
+    const int num_corners = corner_offsets[ielement + 1] - corner_offsets[ielement];
+    for (int icorner = 0; icorner < num_corners; icorner++) {
+      double vertex_coords[3] = { 0.0 };
+      ts->t8_element_vertex_reference_coords (element, icorner, vertex_coords);
+      for (int idim = 0; idim < tree_dim; idim++) {
+        tree_ref_coords[(corner_offsets[ielement] + icorner) * tree_dim + idim] = vertex_coords[idim];
+      }
+    }
+  }
+
+  /* Map all corners to the physical domain at once. */
+  corners.resize (3 * num_points);
+  if (num_points > 0) {
+    const t8_cmesh_t cmesh = t8_forest_get_cmesh (forest);
+    const t8_gloidx_t gtreeid = t8_forest_global_tree_id (forest, ltreeid);
+    t8_forest_geometry_evaluate (cmesh, gtreeid, tree_ref_coords.data (), num_points, corners.data ());
+  }
+}
+
+/* Evaluate the centroid coordinates of a range of elements of a local tree with a single geometry evaluation.
+ * On output the centroid of the i-th element is centroids[3 * i], ..., centroids[3 * i + 2]. */
+static void
+t8_forest_tree_elements_centroids (t8_forest_t forest, t8_locidx_t ltreeid, t8_locidx_t first_element,
+                                   t8_locidx_t num_elements, std::vector<double> &centroids)
+{
+  const t8_eclass_t tree_class = t8_forest_get_tree_class (forest, ltreeid);
+  const t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, tree_class);
+  const int tree_dim = SC_MAX (t8_eclass_to_dimension[tree_class], 1);
+
+  std::vector<double> tree_ref_coords (tree_dim * num_elements);
+  for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+    const t8_element_t *element = t8_forest_get_element_in_tree (forest, ltreeid, first_element + ielement);
+    const t8_element_shape_t element_shape = ts->t8_element_shape (element);
+    ts->t8_element_reference_coords (element, t8_element_centroid_ref_coords[element_shape], 1,
+                                     tree_ref_coords.data () + tree_dim * ielement);
+  }
+
+  centroids.resize (3 * num_elements);
+  if (num_elements > 0) {
+    const t8_cmesh_t cmesh = t8_forest_get_cmesh (forest);
+    const t8_gloidx_t gtreeid = t8_forest_global_tree_id (forest, ltreeid);
+    t8_forest_geometry_evaluate (cmesh, gtreeid, tree_ref_coords.data (), num_elements, centroids.data ());
+  }
+}
+
+void
+t8_forest_tree_elements_centroid (t8_forest_t forest, t8_locidx_t ltreeid, t8_locidx_t first_element,
+                                  t8_locidx_t num_elements, double *centroids)
+{
+  T8_ASSERT (t8_forest_is_committed (forest));
+  T8_ASSERT (0 <= first_element && 0 <= num_elements);
+  T8_ASSERT (first_element + num_elements <= t8_forest_get_tree_num_elements (forest, ltreeid));
+
+  std::vector<double> centroids_aos;
+  t8_forest_tree_elements_centroids (forest, ltreeid, first_element, num_elements, centroids_aos);
+  /* Transpose to structure of arrays. */
+  for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+    for (int idim = 0; idim < 3; idim++) {
+      centroids[idim * num_elements + ielement] = centroids_aos[3 * ielement + idim];
+    }
+  }
+}
+
+void
+t8_forest_tree_elements_volume (t8_forest_t forest, t8_locidx_t ltreeid, t8_locidx_t first_element,
+                                t8_locidx_t num_elements, double *volumes)
+{
+  T8_ASSERT (t8_forest_is_committed (forest));
+  T8_ASSERT (0 <= first_element && 0 <= num_elements);
+  T8_ASSERT (first_element + num_elements <= t8_forest_get_tree_num_elements (forest, ltreeid));
+
+  std::vector<size_t> corner_offsets;
+  std::vector<double> corners;
+  t8_forest_tree_elements_corners (forest, ltreeid, first_element, num_elements, corner_offsets, corners);
+
+  for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+    const t8_element_t *element = t8_forest_get_element_in_tree (forest, ltreeid, first_element + ielement);
+    const t8_forest_element_coords_t coords
+      = { forest, ltreeid, element, corners.data () + 3 * corner_offsets[ielement], NULL };
+    volumes[ielement] = t8_forest_element_volume_coords (&coords);
+  }
+}
+
+void
+t8_forest_tree_elements_face_normal (t8_forest_t forest, t8_locidx_t ltreeid, t8_locidx_t first_element,
+                                     t8_locidx_t num_elements, int face, double *normals)
+{
+  T8_ASSERT (t8_forest_is_committed (forest));
+  T8_ASSERT (0 <= first_element && 0 <= num_elements);
+  T8_ASSERT (first_element + num_elements <= t8_forest_get_tree_num_elements (forest, ltreeid));
+
+  std::vector<size_t> corner_offsets;
+  std::vector<double> corners;
+  std::vector<double> centroids;
+  t8_forest_tree_elements_corners (forest, ltreeid, first_element, num_elements, corner_offsets, corners);
+  if (t8_eclass_to_dimension[t8_forest_get_tree_class (forest, ltreeid)] > 1) {
+    /* Only the normals of edges and faces need the element centroids for their orientation. */
+    t8_forest_tree_elements_centroids (forest, ltreeid, first_element, num_elements, centroids);
+  }
+
+  for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+    const t8_element_t *element = t8_forest_get_element_in_tree (forest, ltreeid, first_element + ielement);
+    const double *element_centroid = centroids.empty () ? NULL : centroids.data () + 3 * ielement;
+    const t8_forest_element_coords_t coords
+      = { forest, ltreeid, element, corners.data () + 3 * corner_offsets[ielement], element_centroid };
+    double normal[3];
+    t8_forest_element_face_normal_coords (&coords, face, normal);
+    for (int idim = 0; idim < 3; idim++) {
+      normals[idim * num_elements + ielement] = normal[idim];
+    }
+  }
+}
+
 void
 t8_forest_element_points_inside (t8_forest_t forest, t8_locidx_t ltreeid, const t8_element_t *element,
                                  const double *points, int num_points, int *is_inside, const double tolerance)
@@ -1141,7 +1363,39 @@ t8_forest_compute_desc (t8_forest_t forest)
   }
 }
 
-/* Create the elements on this process given a uniform partition of the coarse mesh. */
+/** A contiguous range of elements of one tree that is filled by one thread. */
+struct t8_forest_populate_range
+{
+  t8_element_array_t *telements;     /* The elements of the tree. */
+  t8_eclass_scheme_c *eclass_scheme; /* The scheme of the tree. */
+  t8_locidx_t first;                 /* The index in \a telements of the first element of the range. */
+  t8_locidx_t end;                   /* The index in \a telements of the first element after the range. */
+  t8_gloidx_t first_id;              /* The linear id of the first element of the range. */
+};
+
+/** Fill the elements of a range. The first element is computed from its linear id,
+ * all further elements are the successors of their predecessor.
+ * This function is called concurrently for different ranges.
+ * \param [in,out] range The range of elements.
+ * \param [in]     level The refinement level of the elements.
+ */
+static void
+t8_forest_populate_fill_range (const t8_forest_populate_range &range, const int level)
+{
+  t8_eclass_scheme_c *eclass_scheme = range.eclass_scheme;
+  t8_element_t *element = t8_element_array_index_locidx (range.telements, range.first);
+
+  eclass_scheme->t8_element_set_linear_id (element, level, range.first_id);
+  for (t8_locidx_t ielement = range.first + 1; ielement < range.end; ielement++) {
+    t8_element_t *element_succ = t8_element_array_index_locidx (range.telements, ielement);
+    T8_ASSERT (eclass_scheme->t8_element_level (element) == level);
+    eclass_scheme->t8_element_successor (element, element_succ);
+    element = element_succ;
+  }
+}
+
+/* Create the elements on this process given a uniform partition of the coarse mesh.
+ * The element arrays are filled by forest->num_threads threads. */
 void
 t8_forest_populate (t8_forest_t forest)
 {
@@ -1151,9 +1405,8 @@ t8_forest_populate (t8_forest_t forest)
   t8_locidx_t num_tree_elements;
   t8_locidx_t num_local_trees;
   t8_gloidx_t jt, first_ctree;
-  t8_gloidx_t start, end, et;
+  t8_gloidx_t start, end;
   t8_tree_t tree;
-  t8_element_t *element, *element_succ;
   t8_element_array_t *telements;
   t8_eclass_t tree_class;
   t8_eclass_scheme_c *eclass_scheme;
@@ -1193,6 +1446,8 @@ t8_forest_populate (t8_forest_t forest)
     num_local_trees = forest->last_local_tree - forest->first_local_tree + 1;
     forest->trees = sc_array_new_count (sizeof (t8_tree_struct_t), num_local_trees);
     first_ctree = t8_cmesh_get_first_treeid (forest->cmesh);
+    std::vector<t8_forest_populate_range> tree_ranges;
+    tree_ranges.reserve (num_local_trees);
     for (jt = forest->first_local_tree, count_elements = 0; jt <= forest->last_local_tree; jt++) {
       tree = (t8_tree_t) t8_sc_array_index_locidx (forest->trees, jt - forest->first_local_tree);
       tree_class = tree->eclass = t8_cmesh_get_tree_class (forest->cmesh, jt - first_ctree);
@@ -1208,17 +1463,43 @@ t8_forest_populate (t8_forest_t forest)
       T8_ASSERT (num_tree_elements > 0);
       /* Allocate elements for this processor. */
       t8_element_array_init_size (telements, eclass_scheme, num_tree_elements);
-      element = t8_element_array_index_locidx (telements, 0);
-      eclass_scheme->t8_element_set_linear_id (element, forest->set_level, start);
-      count_elements++;
-      for (et = start + 1; et < end; et++, count_elements++) {
-        element_succ = t8_element_array_index_locidx (telements, et - start);
-        T8_ASSERT (eclass_scheme->t8_element_level (element) == forest->set_level);
-        eclass_scheme->t8_element_successor (element, element_succ);
-        /* TODO: process elements here */
-        element = element_succ;
+      tree_ranges.push_back ({ telements, eclass_scheme, 0, num_tree_elements, start });
+      count_elements += num_tree_elements;
+    }
+
+    /* Split the trees into ranges, such that each thread fills several ranges.
+     * Each range starts with the element of its linear id. */
+    const int num_threads = forest->num_threads;
+    std::vector<t8_forest_populate_range> ranges;
+    if (num_threads == 1) {
+      ranges.swap (tree_ranges);
+    }
+    else {
+      const t8_locidx_t range_size = SC_MAX (1, count_elements / (4 * num_threads));
+      for (const t8_forest_populate_range &tree_range : tree_ranges) {
+        for (t8_locidx_t first = tree_range.first; first < tree_range.end; first += range_size) {
+          ranges.push_back ({ tree_range.telements, tree_range.eclass_scheme, first,
+                              SC_MIN (first + range_size, tree_range.end), tree_range.first_id + first });
+        }
       }
     }
+
+    /* Each thread takes the next range that is not filled yet. The calling thread is one of the threads. */
+    std::atomic<size_t> next_range (0);
+    const int level = forest->set_level;
+    const auto worker = [&] () {
+      for (size_t irange = next_range++; irange < ranges.size (); irange = next_range++) {
+        t8_forest_populate_fill_range (ranges[irange], level);
+      }
+    };
+    std::vector<std::thread> threads;
+    for (size_t ithread = 1; ithread < (size_t) num_threads && ithread < ranges.size (); ithread++) {
+      threads.emplace_back (worker);
+    }
+    worker ();
+    for (auto &thread : threads) {
+      thread.join ();
+    }
   }
   forest->local_num_elements = count_elements;
   /* TODO: if no tree has pyramid type we can optimize this to global_num_elements = global_num_trees * 2^(dim*level) */
@@ -1429,7 +1710,7 @@ t8_forest_copy_trees (t8_forest_t forest, t8_forest_t from, int copy_elements)
  * If no such i exists, return -1.
  */
 /* TODO: should return t8_locidx_t */
-static t8_locidx_t
+t8_locidx_t
 t8_forest_bin_search_lower (t8_element_array_t *elements, t8_linearidx_t element_id, int maxlevel)
 {
   t8_element_t *query;
@@ -1517,18 +1798,26 @@ t8_forest_element_neighbor_eclass (t8_forest_t forest, t8_locidx_t ltreeid, cons
 t8_gloidx_t
 t8_forest_element_face_neighbor (t8_forest_t forest, t8_locidx_t ltreeid, const t8_element_t *elem, t8_element_t *neigh,
                                  t8_eclass_scheme_c *neigh_scheme, int face, int *neigh_face)
+{
+  return t8_forest_element_face_neighbor_cmesh_tree (forest, t8_forest_ltreeid_to_cmesh_ltreeid (forest, ltreeid), elem,
+                                                     neigh, neigh_scheme, face, neigh_face);
+}
+
+t8_gloidx_t
+t8_forest_element_face_neighbor_cmesh_tree (t8_forest_t forest, t8_locidx_t lctree_id, const t8_element_t *elem,
+                                            t8_element_t *neigh, t8_eclass_scheme_c *neigh_scheme, int face,
+                                            int *neigh_face)
 {
   t8_eclass_scheme_c *ts;
-  t8_tree_t tree;
   t8_eclass_t eclass;
 
-  /* Get a pointer to the tree to read its element class */
-  tree = t8_forest_get_tree (forest, ltreeid);
-  eclass = tree->eclass;
+  T8_ASSERT (0 <= lctree_id && lctree_id < t8_cmesh_get_num_local_trees (forest->cmesh));
+  /* Read the element class of the coarse tree */
+  eclass = t8_cmesh_get_tree_class (forest->cmesh, lctree_id);
   ts = t8_forest_get_eclass_scheme (forest, eclass);
   if (neigh_scheme == ts && ts->t8_element_face_neighbor_inside (elem, neigh, face, neigh_face)) {
     /* The neighbor was constructed and is inside the current tree. */
-    return ltreeid + t8_forest_get_first_local_tree_id (forest);
+    return lctree_id + t8_cmesh_get_first_treeid (forest->cmesh);
   }
   else {
     /* The neighbor does not lie inside the current tree. The content of neigh is undefined right now. */
@@ -1536,7 +1825,7 @@ t8_forest_element_face_neighbor (t8_forest_t forest, t8_locidx_t ltreeid, const
     t8_eclass_t neigh_eclass, boundary_class;
     t8_element_t *face_element;
     t8_cmesh_t cmesh;
-    t8_locidx_t lctree_id, lcneigh_id;
+    t8_locidx_t lcneigh_id;
     t8_locidx_t *face_neighbor;
     t8_gloidx_t global_neigh_id;
     t8_cghost_t ghost;
@@ -1549,8 +1838,6 @@ t8_forest_element_face_neighbor (t8_forest_t forest, t8_locidx_t ltreeid, const
     /* Get the scheme associated to the element class of the boundary element. */
     /* Compute the face of elem_tree at which the face connection is. */
     tree_face = ts->t8_element_tree_face (elem, face);
-    /* compute coarse tree id */
-    lctree_id = t8_forest_ltreeid_to_cmesh_ltreeid (forest, ltreeid);
     if (t8_cmesh_tree_face_is_boundary (cmesh, lctree_id, tree_face)) {
       /* This face is a domain boundary. We do not need to continue */
       return -1;
@@ -1709,6 +1996,199 @@ t8_forest_leaf_face_orientation (t8_forest_t forest, const t8_locidx_t ltreeid,
   return orientation;
 }
 
+/* Find all leaves in the sorted array \a leaves that are descendants of \a element
+ * and touch its face \a face. The leaves must all be descendants of \a element.
+ * We descend into the face children of \a element similar to t8_forest_iterate_faces,
+ * but do not require \a leaves to be the leaves of a local tree.
+ * \a first_index is the index of the first leaf in \a leaves in the complete leaf array. */
+static void
+t8_forest_leaf_face_neighbors_descend (t8_eclass_scheme_c *ts, const t8_element_t *element, const int face,
+                                       t8_element_array_t *leaves, const t8_locidx_t first_index, sc_array_t *neighbors)
+{
+  const size_t num_leaves = t8_element_array_get_count (leaves);
+
+  if (num_leaves == 0) {
+    return;
+  }
+  if (num_leaves == 1) {
+    const t8_element_t *leaf = t8_element_array_index_locidx (leaves, 0);
+    if (ts->t8_element_equal (element, leaf)) {
+      /* The element is a leaf and a face neighbor */
+      t8_forest_leaf_face_neighbor_t *neighbor = (t8_forest_leaf_face_neighbor_t *) sc_array_push (neighbors);
+      neighbor->leaf = leaf;
+      neighbor->index = first_index;
+      neighbor->dual_face = face;
+      return;
+    }
+  }
+  T8_ASSERT (ts->t8_element_level (element) < ts->t8_element_level (t8_element_array_index_locidx (leaves, 0)));
+
+  /* Split the leaves into the ranges of the children of element and descend into the face children. */
+  const int num_face_children = ts->t8_element_num_face_children (element, face);
+  t8_element_t **face_children = T8_ALLOC (t8_element_t *, num_face_children);
+  int *child_indices = T8_ALLOC (int, num_face_children);
+  size_t *split_offsets = T8_ALLOC (size_t, ts->t8_element_num_children (element) + 1);
+  ts->t8_element_new (num_face_children, face_children);
+  ts->t8_element_children_at_face (element, face, face_children, num_face_children, child_indices);
+  t8_forest_split_array (element, leaves, split_offsets);
+  for (int iface = 0; iface < num_face_children; iface++) {
+    const size_t indexa = split_offsets[child_indices[iface]];
+    const size_t indexb = split_offsets[child_indices[iface] + 1];
+    if (indexa < indexb) {
+      t8_element_array_t face_child_leaves;
+      t8_element_array_init_view (&face_child_leaves, leaves, indexa, indexb - indexa);
+      const int child_face = ts->t8_element_face_child_face (element, face, iface);
+      t8_forest_leaf_face_neighbors_descend (ts, face_children[iface], child_face, &face_child_leaves,
+                                             first_index + indexa, neighbors);
+    }
+  }
+  ts->t8_element_destroy (num_face_children, face_children);
+  T8_FREE (face_children);
+  T8_FREE (child_indices);
+  T8_FREE (split_offsets);
+}
+
+void
+t8_forest_leaf_face_neighbors_in_array (t8_forest_t forest, t8_eclass_scheme_c *ts, const t8_element_t *neighbor,
+                                        const int dual_face, t8_element_array_t *leaves, t8_locidx_t lower,
+                                        const t8_locidx_t index_offset, sc_array_t *neighbors)
+{
+  const t8_locidx_t num_leaves = t8_element_array_get_count (leaves);
+  const int maxlevel = forest->maxlevel;
+
+  T8_ASSERT (neighbors->elem_size == sizeof (t8_forest_leaf_face_neighbor_t));
+  if (num_leaves == 0) {
+    return;
+  }
+  const t8_linearidx_t first_id = ts->t8_element_get_linear_id (neighbor, maxlevel);
+  if (lower < -1) {
+    /* The last leaf that starts before or at neighbor */
+    lower = t8_forest_bin_search_lower (leaves, first_id, maxlevel);
+  }
+  T8_ASSERT (lower == t8_forest_bin_search_lower (leaves, first_id, maxlevel));
+  t8_locidx_t first_desc = lower + 1;
+  if (lower >= 0) {
+    const t8_element_t *candidate = t8_element_array_index_locidx (leaves, lower);
+    const int candidate_level = ts->t8_element_level (candidate);
+    t8_element_t *ancestor;
+    ts->t8_element_new (1, &ancestor);
+    ts->t8_element_nca (candidate, neighbor, ancestor);
+    const int is_ancestor
+      = candidate_level <= ts->t8_element_level (neighbor) && ts->t8_element_equal (ancestor, candidate);
+    if (is_ancestor) {
+      /* The candidate contains neighbor and is the only face neighbor leaf.
+       * We compute its face by going up from neighbor to the candidate. */
+      int face = dual_face;
+      ts->t8_element_copy (neighbor, ancestor);
+      while (ts->t8_element_level (ancestor) > candidate_level) {
+        face = ts->t8_element_face_parent_face (ancestor, face);
+        T8_ASSERT (face >= 0);
+        ts->t8_element_parent (ancestor, ancestor);
+      }
+      ts->t8_element_destroy (1, &ancestor);
+      t8_forest_leaf_face_neighbor_t *found = (t8_forest_leaf_face_neighbor_t *) sc_array_push (neighbors);
+      found->leaf = candidate;
+      found->index = lower + index_offset;
+      found->dual_face = face;
+      return;
+    }
+    ts->t8_element_destroy (1, &ancestor);
+    if (ts->t8_element_get_linear_id (candidate, maxlevel) == first_id) {
+      /* The candidate is the first descendant of neighbor */
+      first_desc = lower;
+    }
+  }
+  if (first_desc >= num_leaves) {
+    return;
+  }
+  /* The descendants of neighbor are the leaves up to its last descendant */
+  t8_element_t *last_desc;
+  ts->t8_element_new (1, &last_desc);
+  ts->t8_element_last_descendant (neighbor, last_desc, maxlevel);
+  const t8_locidx_t end_desc
+    = t8_forest_bin_search_lower (leaves, ts->t8_element_get_linear_id (last_desc, maxlevel), maxlevel) + 1;
+  ts->t8_element_destroy (1, &last_desc);
+  if (first_desc < end_desc) {
+    t8_element_array_t desc_leaves;
+    t8_element_array_init_view (&desc_leaves, leaves, first_desc, end_desc - first_desc);
+    t8_forest_leaf_face_neighbors_descend (ts, neighbor, dual_face, &desc_leaves, first_desc + index_offset,
+                                           neighbors);
+  }
+}
+
+/* Compute the leaf face neighbors of a leaf in a forest that is not necessarily balanced.
+ * The arguments are the same as in t8_forest_leaf_face_neighbors_ext.
+ * We compute the same level face neighbor of leaf and search for the leaves that overlap it
+ * in the local and the ghost leaves of the neighbor tree. */
+static void
+t8_forest_leaf_face_neighbors_unbalanced (t8_forest_t forest, t8_locidx_t ltreeid, const t8_element_t *leaf,
+                                          t8_element_t **pneighbor_leaves[], int face, int *dual_faces[],
+                                          int *num_neighbors, t8_locidx_t **pelement_indices,
+                                          t8_eclass_scheme_c **pneigh_scheme, t8_gloidx_t *gneigh_tree)
+{
+  const t8_eclass_t neigh_class = t8_forest_element_neighbor_eclass (forest, ltreeid, leaf, face);
+  t8_eclass_scheme_c *neigh_scheme = *pneigh_scheme = t8_forest_get_eclass_scheme (forest, neigh_class);
+  sc_array_t neighbors;
+  t8_element_t *same_level_neighbor;
+  int dual_face;
+
+  sc_array_init (&neighbors, sizeof (t8_forest_leaf_face_neighbor_t));
+  /* Compute the same level face neighbor */
+  neigh_scheme->t8_element_new (1, &same_level_neighbor);
+  const t8_gloidx_t gneigh_treeid
+    = t8_forest_element_face_neighbor (forest, ltreeid, leaf, same_level_neighbor, neigh_scheme, face, &dual_face);
+  if (gneigh_tree) {
+    *gneigh_tree = gneigh_treeid;
+  }
+  if (gneigh_treeid >= 0) {
+    /* Search the local leaves of the neighbor tree */
+    const t8_locidx_t lneigh_treeid = t8_forest_get_local_id (forest, gneigh_treeid);
+    if (lneigh_treeid >= 0) {
+      t8_forest_leaf_face_neighbors_in_array (forest, neigh_scheme, same_level_neighbor, dual_face,
+                                              t8_forest_get_tree_element_array (forest, lneigh_treeid), -2,
+                                              t8_forest_get_tree_element_offset (forest, lneigh_treeid), &neighbors);
+    }
+    /* Search the ghost leaves of the neighbor tree */
+    if (forest->ghosts != NULL) {
+      const t8_locidx_t lghost_treeid = t8_forest_ghost_get_ghost_treeid (forest, gneigh_treeid);
+      if (lghost_treeid >= 0) {
+        t8_forest_leaf_face_neighbors_in_array (forest, neigh_scheme, same_level_neighbor, dual_face,
+                                                t8_forest_ghost_get_tree_elements (forest, lghost_treeid), -2,
+                                                t8_forest_get_local_num_elements (forest)
+                                                  + t8_forest_ghost_get_tree_element_offset (forest, lghost_treeid),
+                                                &neighbors);
+      }
+    }
+  }
+  neigh_scheme->t8_element_destroy (1, &same_level_neighbor);
+
+  *num_neighbors = neighbors.elem_count;
+  if (*num_neighbors == 0) {
+    /* There exists no face neighbor across this face */
+    *pneighbor_leaves = NULL;
+    *dual_faces = NULL;
+    *pelement_indices = NULL;
+    sc_array_reset (&neighbors);
+    return;
+  }
+  /* Local leaves and ghosts were searched separately, we sort the neighbors along the SFC */
+  t8_forest_leaf_face_neighbor_t *found = (t8_forest_leaf_face_neighbor_t *) neighbors.array;
+  std::sort (found, found + *num_neighbors,
+             [neigh_scheme] (const t8_forest_leaf_face_neighbor_t &a, const t8_forest_leaf_face_neighbor_t &b) {
+               return neigh_scheme->t8_element_compare (a.leaf, b.leaf) < 0;
+             });
+  *pneighbor_leaves = T8_ALLOC (t8_element_t *, *num_neighbors);
+  *dual_faces = T8_ALLOC (int, *num_neighbors);
+  *pelement_indices = T8_ALLOC (t8_locidx_t, *num_neighbors);
+  neigh_scheme->t8_element_new (*num_neighbors, *pneighbor_leaves);
+  for (int ineigh = 0; ineigh < *num_neighbors; ineigh++) {
+    neigh_scheme->t8_element_copy (found[ineigh].leaf, (*pneighbor_leaves)[ineigh]);
+    (*dual_faces)[ineigh] = found[ineigh].dual_face;
+    (*pelement_indices)[ineigh] = found[ineigh].index;
+  }
+  sc_array_reset (&neighbors);
+}
+
 void
 t8_forest_leaf_face_neighbors_ext (t8_forest_t forest, t8_locidx_t ltreeid, const t8_element_t *leaf,
                                    t8_element_t **pneighbor_leaves[], int face, int *dual_faces[], int *num_neighbors,
@@ -1729,11 +2209,12 @@ t8_forest_leaf_face_neighbors_ext (t8_forest_t forest, t8_locidx_t ltreeid, cons
   /* TODO: implement is_leaf check to apply to leaf */
   T8_ASSERT (t8_forest_is_committed (forest));
   T8_ASSERT (!forest_is_balanced || t8_forest_is_balanced (forest));
-  SC_CHECK_ABORT (forest_is_balanced, "leaf face neighbors is not implemented "
-                                      "for unbalanced forests.\n"); /* TODO: write version for unbalanced forests */
   SC_CHECK_ABORT (forest->mpisize == 1 || forest->ghosts != NULL,
                   "Ghost structure is needed for t8_forest_leaf_face_neighbors "
                   "but was not found in forest.\n");
+  SC_CHECK_ABORT (forest_is_balanced || forest->mpisize == 1 || forest->ghost_algorithm != 1,
+                  "Leaf face neighbors of unbalanced forests need a ghost layer "
+                  "that was not created with the balanced only algorithm.\n");
 
   if (forest_is_balanced) {
     /* In a balanced forest, the leaf neighbor of a leaf is either the neighbor element itself,
@@ -1944,8 +2425,14 @@ t8_forest_leaf_face_neighbors_ext (t8_forest_t forest, t8_locidx_t ltreeid, cons
     T8_FREE (owners);
   }
   else {
-    /* TODO: implement unbalanced version */
-    SC_ABORT_NOT_REACHED ();
+    /* The forest may have arbitrary level differences between neighbors. */
+    if (orientation) {
+      eclass = t8_forest_get_tree_class (forest, ltreeid);
+      ts = t8_forest_get_eclass_scheme (forest, eclass);
+      *orientation = t8_forest_leaf_face_orientation (forest, ltreeid, ts, leaf, face);
+    }
+    t8_forest_leaf_face_neighbors_unbalanced (forest, ltreeid, leaf, pneighbor_leaves, face, dual_faces, num_neighbors,
+                                              pelement_indices, pneigh_scheme, gneigh_tree);
   }
 }
 
@@ -0,0 +1,249 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+#include <t8_forest/t8_forest_face_connectivity.h>
+#include <t8_forest/t8_forest_types.h>
+#include <t8_forest/t8_forest_private.h>
+#include <t8_forest/t8_forest_ghost.h>
+#include <t8_element_cxx.hxx>
+#include <algorithm>
+#include <vector>
+
+T8_EXTERN_C_BEGIN ();
+
+/* A face of a local leaf whose neighbors are searched in the leaves of the neighbor tree. */
+typedef struct
+{
+  t8_gloidx_t gneigh_tree;  /* The global id of the neighbor tree. */
+  t8_linearidx_t neigh_id;  /* The linear id of the same level face neighbor at the maximum level. */
+  t8_locidx_t ltreeid;      /* The local tree of the leaf. */
+  t8_locidx_t ielem_tree;   /* The index of the leaf in its tree. */
+  t8_locidx_t face_index;   /* The index of the face in the table. */
+  int face;                 /* The face of the leaf. */
+} t8_forest_face_query_t;
+
+/* Find the leaves that overlap the same level face neighbors of the queries in a sorted leaf array.
+ * The queries must belong to the same neighbor tree and be sorted by their linear ids, such that
+ * the last leaf before each neighbor is found by advancing a single position in the array.
+ * For each query, the found leaves are appended to neighbors. */
+static void
+t8_forest_face_connectivity_merge (t8_forest_t forest, const t8_forest_face_query_t *queries,
+                                   const size_t num_queries, t8_element_array_t *leaves, const t8_locidx_t index_offset,
+                                   std::vector<sc_array_t> &neighbors)
+{
+  const t8_locidx_t num_leaves = t8_element_array_get_count (leaves);
+  t8_eclass_scheme_c *neigh_scheme = t8_element_array_get_scheme (leaves);
+  t8_element_t *same_level_neighbor;
+  t8_locidx_t lower = -1;
+
+  neigh_scheme->t8_element_new (1, &same_level_neighbor);
+  for (size_t iquery = 0; iquery < num_queries; iquery++) {
+    const t8_forest_face_query_t *query = queries + iquery;
+    /* Advance to the last leaf that starts before or at the neighbor */
+    while (lower + 1 < num_leaves
+           && neigh_scheme->t8_element_get_linear_id (t8_element_array_index_locidx (leaves, lower + 1),
+                                                      forest->maxlevel)
+                <= query->neigh_id) {
+      lower++;
+    }
+    /* Recompute the neighbor, which is cheaper than storing it for all faces */
+    const t8_element_t *leaf = t8_forest_get_element_in_tree (forest, query->ltreeid, query->ielem_tree);
+    int dual_face;
+    t8_forest_element_face_neighbor (forest, query->ltreeid, leaf, same_level_neighbor, neigh_scheme, query->face,
+                                     &dual_face);
+    t8_forest_leaf_face_neighbors_in_array (forest, neigh_scheme, same_level_neighbor, dual_face, leaves, lower,
+                                            index_offset, &neighbors[query->face_index]);
+  }
+  neigh_scheme->t8_element_destroy (1, &same_level_neighbor);
+}
+
+/* Compute the face neighbor table of a forest.
+ * We compute the same level face neighbor of each face of each local leaf and sort these
+ * by neighbor tree and linear id. The neighbor leaves are then found in one pass over the
+ * local and the ghost leaves of each neighbor tree, instead of a search per face.
+ * The result is the same as the one of t8_forest_leaf_face_neighbors_ext for unbalanced forests,
+ * in particular the neighbors of a face are sorted along the SFC. */
+static t8_forest_face_connectivity_t *
+t8_forest_face_connectivity_new (t8_forest_t forest)
+{
+  const t8_locidx_t num_elements = t8_forest_get_local_num_elements (forest);
+  const t8_locidx_t num_local_trees = t8_forest_get_num_local_trees (forest);
+  t8_forest_face_connectivity_t *conn = T8_ALLOC (t8_forest_face_connectivity_t, 1);
+  std::vector<t8_forest_face_query_t> queries;
+  t8_element_t *same_level_neighbor[T8_ECLASS_COUNT] = { NULL };
+
+  conn->num_elements = num_elements;
+  conn->num_ghosts = t8_forest_get_num_ghosts (forest);
+  conn->face_offsets = T8_ALLOC (t8_locidx_t, num_elements + 1);
+  conn->face_offsets[0] = 0;
+  for (t8_locidx_t itree = 0, ielement = 0; itree < num_local_trees; itree++) {
+    const t8_locidx_t num_tree_elements = t8_forest_get_tree_num_elements (forest, itree);
+    const t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, t8_forest_get_tree_class (forest, itree));
+    for (t8_locidx_t ielem_tree = 0; ielem_tree < num_tree_elements; ielem_tree++, ielement++) {
+      const t8_element_t *leaf = t8_forest_get_element_in_tree (forest, itree, ielem_tree);
+      conn->face_offsets[ielement + 1] = conn->face_offsets[ielement] + ts->t8_element_num_faces (leaf);
+    }
+  }
+  const t8_locidx_t num_faces = conn->face_offsets[num_elements];
+  conn->orientations = T8_ALLOC (int, num_faces);
+
+  /* Compute the same level face neighbor and the orientation of each face */
+  for (t8_locidx_t itree = 0, ielement = 0; itree < num_local_trees; itree++) {
+    const t8_locidx_t num_tree_elements = t8_forest_get_tree_num_elements (forest, itree);
+    const t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, t8_forest_get_tree_class (forest, itree));
+    for (t8_locidx_t ielem_tree = 0; ielem_tree < num_tree_elements; ielem_tree++, ielement++) {
+      const t8_element_t *leaf = t8_forest_get_element_in_tree (forest, itree, ielem_tree);
+      for (t8_locidx_t face_index = conn->face_offsets[ielement]; face_index < conn->face_offsets[ielement + 1];
+           face_index++) {
+        const int face = face_index - conn->face_offsets[ielement];
+        const t8_eclass_t neigh_class = t8_forest_element_neighbor_eclass (forest, itree, leaf, face);
+        t8_eclass_scheme_c *neigh_scheme = t8_forest_get_eclass_scheme (forest, neigh_class);
+        int dual_face;
+
+        conn->orientations[face_index] = t8_forest_leaf_face_orientation (forest, itree, ts, leaf, face);
+        if (same_level_neighbor[neigh_class] == NULL) {
+          neigh_scheme->t8_element_new (1, &same_level_neighbor[neigh_class]);
+        }
+        const t8_gloidx_t gneigh_tree = t8_forest_element_face_neighbor (
+          forest, itree, leaf, same_level_neighbor[neigh_class], neigh_scheme, face, &dual_face);
+        if (gneigh_tree >= 0) {
+          queries.push_back (
+            { gneigh_tree,
+              neigh_scheme->t8_element_get_linear_id (same_level_neighbor[neigh_class], forest->maxlevel), itree,
+              ielem_tree, face_index, face });
+        }
+      }
+    }
+  }
+  for (int eclass = T8_ECLASS_ZERO; eclass < T8_ECLASS_COUNT; eclass++) {
+    if (same_level_neighbor[eclass] != NULL) {
+      t8_forest_get_eclass_scheme (forest, (t8_eclass_t) eclass)->t8_element_destroy (1, &same_level_neighbor[eclass]);
+    }
+  }
+
+  /* Sort the faces by neighbor tree and position of their neighbor along the SFC.
+   * Faces with the same neighbor keep their order, such that the result is deterministic. */
+  std::stable_sort (queries.begin (), queries.end (),
+                    [] (const t8_forest_face_query_t &query1, const t8_forest_face_query_t &query2) {
+                      return query1.gneigh_tree < query2.gneigh_tree
+                             || (query1.gneigh_tree == query2.gneigh_tree && query1.neigh_id < query2.neigh_id);
+                    });
+
+  /* Merge the faces of each neighbor tree with the local and the ghost leaves of this tree */
+  std::vector<sc_array_t> neighbors (num_faces);
+  for (sc_array_t &face_neighbors : neighbors) {
+    sc_array_init (&face_neighbors, sizeof (t8_forest_leaf_face_neighbor_t));
+  }
+  for (size_t first_query = 0, end_query; first_query < queries.size (); first_query = end_query) {
+    const t8_gloidx_t gneigh_tree = queries[first_query].gneigh_tree;
+    for (end_query = first_query; end_query < queries.size () && queries[end_query].gneigh_tree == gneigh_tree;
+         end_query++) {
+    }
+    const t8_locidx_t lneigh_tree = t8_forest_get_local_id (forest, gneigh_tree);
+    if (lneigh_tree >= 0) {
+      t8_forest_face_connectivity_merge (forest, &queries[first_query], end_query - first_query,
+                                         t8_forest_get_tree_element_array (forest, lneigh_tree),
+                                         t8_forest_get_tree_element_offset (forest, lneigh_tree), neighbors);
+    }
+    if (forest->ghosts != NULL) {
+      const t8_locidx_t lghost_tree = t8_forest_ghost_get_ghost_treeid (forest, gneigh_tree);
+      if (lghost_tree >= 0) {
+        t8_forest_face_connectivity_merge (forest, &queries[first_query], end_query - first_query,
+                                           t8_forest_ghost_get_tree_elements (forest, lghost_tree),
+                                           num_elements + t8_forest_ghost_get_tree_element_offset (forest, lghost_tree),
+                                           neighbors);
+      }
+    }
+  }
+  queries.clear ();
+  queries.shrink_to_fit ();
+
+  /* Store the neighbors of each face in compressed sparse row format */
+  conn->neighbor_offsets = T8_ALLOC (t8_locidx_t, num_faces + 1);
+  conn->neighbor_offsets[0] = 0;
+  for (t8_locidx_t face_index = 0; face_index < num_faces; face_index++) {
+    conn->neighbor_offsets[face_index + 1] = conn->neighbor_offsets[face_index] + neighbors[face_index].elem_count;
+  }
+  conn->neighbors = T8_ALLOC (t8_locidx_t, conn->neighbor_offsets[num_faces]);
+  conn->dual_faces = T8_ALLOC (int, conn->neighbor_offsets[num_faces]);
+  for (t8_locidx_t itree = 0, ielement = 0; itree < num_local_trees; itree++) {
+    const t8_locidx_t num_tree_elements = t8_forest_get_tree_num_elements (forest, itree);
+    for (t8_locidx_t ielem_tree = 0; ielem_tree < num_tree_elements; ielem_tree++, ielement++) {
+      const t8_element_t *leaf = t8_forest_get_element_in_tree (forest, itree, ielem_tree);
+      for (t8_locidx_t face_index = conn->face_offsets[ielement]; face_index < conn->face_offsets[ielement + 1];
+           face_index++) {
+        t8_forest_leaf_face_neighbor_t *found = (t8_forest_leaf_face_neighbor_t *) neighbors[face_index].array;
+        const size_t num_found = neighbors[face_index].elem_count;
+        if (num_found > 1) {
+          /* Local leaves and ghosts were searched separately, we sort the neighbors along the SFC */
+          t8_eclass_scheme_c *neigh_scheme = t8_forest_get_eclass_scheme (
+            forest, t8_forest_element_neighbor_eclass (forest, itree, leaf, face_index - conn->face_offsets[ielement]));
+          std::sort (found, found + num_found,
+                     [neigh_scheme] (const t8_forest_leaf_face_neighbor_t &a, const t8_forest_leaf_face_neighbor_t &b) {
+                       return neigh_scheme->t8_element_compare (a.leaf, b.leaf) < 0;
+                     });
+        }
+        for (size_t ineigh = 0; ineigh < num_found; ineigh++) {
+          conn->neighbors[conn->neighbor_offsets[face_index] + ineigh] = found[ineigh].index;
+          conn->dual_faces[conn->neighbor_offsets[face_index] + ineigh] = found[ineigh].dual_face;
+        }
+        sc_array_reset (&neighbors[face_index]);
+      }
+    }
+  }
+  return conn;
+}
+
+const t8_forest_face_connectivity_t *
+t8_forest_get_face_connectivity (t8_forest_t forest, int forest_is_balanced)
+{
+  T8_ASSERT (t8_forest_is_committed (forest));
+  SC_CHECK_ABORT (forest->mpisize == 1 || forest->ghosts != NULL,
+                  "Ghost structure is needed for t8_forest_get_face_connectivity but was not found in forest.\n");
+  SC_CHECK_ABORT (forest_is_balanced || forest->mpisize == 1 || forest->ghost_algorithm != 1,
+                  "The face connectivity of unbalanced forests needs a ghost layer "
+                  "that was not created with the balanced only algorithm.\n");
+
+  if (forest->face_connectivity == NULL) {
+    forest->face_connectivity = t8_forest_face_connectivity_new (forest);
+  }
+  return forest->face_connectivity;
+}
+
+void
+t8_forest_face_connectivity_destroy (t8_forest_t forest)
+{
+  t8_forest_face_connectivity_t *conn = forest->face_connectivity;
+
+  if (conn == NULL) {
+    return;
+  }
+  T8_FREE (conn->face_offsets);
+  T8_FREE (conn->neighbor_offsets);
+  T8_FREE (conn->neighbors);
+  T8_FREE (conn->dual_faces);
+  T8_FREE (conn->orientations);
+  T8_FREE (conn);
+  forest->face_connectivity = NULL;
+}
+
+T8_EXTERN_C_END ();
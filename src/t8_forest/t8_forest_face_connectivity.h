@@ -0,0 +1,96 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/** \file t8_forest_face_connectivity.h
+ * We define a table of the face neighbors of all local leaves of a forest.
+ * The table is computed once per forest and stored in compressed sparse row
+ * format, such that iterating over the face neighbors of all leaves does not
+ * require any neighbor search or memory allocation.
+ */
+
+#ifndef T8_FOREST_FACE_CONNECTIVITY_H
+#define T8_FOREST_FACE_CONNECTIVITY_H
+
+#include <t8.h>
+#include <t8_forest/t8_forest_general.h>
+
+/** The face neighbors of all local leaves of a forest.
+ * The faces of all local leaves are enumerated consecutively in SFC order,
+ * face \a iface of the local leaf \a ielement has the index
+ * face_offsets[ielement] + iface.
+ * The face neighbors of the face with index \a i are the entries
+ * neighbor_offsets[i], ..., neighbor_offsets[i + 1] - 1 of \a neighbors
+ * and \a dual_faces, sorted along the SFC.
+ * Example: Loop over all face neighbors of all local leaves
+ * \code
+ * for (t8_locidx_t ielement = 0; ielement < conn->num_elements; ielement++) {
+ *   for (t8_locidx_t iface = conn->face_offsets[ielement]; iface < conn->face_offsets[ielement + 1]; iface++) {
+ *     for (t8_locidx_t ineigh = conn->neighbor_offsets[iface]; ineigh < conn->neighbor_offsets[iface + 1]; ineigh++) {
+ *       const t8_locidx_t neighbor = conn->neighbors[ineigh];
+ *       ...
+ *     }
+ *   }
+ * }
+ * \endcode
+ */
+typedef struct t8_forest_face_connectivity
+{
+  t8_locidx_t num_elements;      /**< The number of local leaves. */
+  t8_locidx_t num_ghosts;        /**< The number of ghost leaves. */
+  t8_locidx_t *face_offsets;     /**< For each local leaf the index of its first face, followed by
+                                      the total number of faces. Length num_elements + 1. */
+  t8_locidx_t *neighbor_offsets; /**< For each face the index of its first neighbor in \a neighbors,
+                                      followed by the total number of neighbors.
+                                      Length face_offsets[num_elements] + 1. */
+  t8_locidx_t *neighbors;        /**< The element indices of the neighbor leaves.
+                                      0, ..., num_elements - 1 for local leaves and
+                                      num_elements, ..., num_elements + num_ghosts - 1 for ghosts. */
+  int *dual_faces;               /**< For each neighbor the index of the face of the neighbor leaf. */
+  int *orientations;             /**< For each face the face orientation, \see t8_forest_leaf_face_orientation. */
+} t8_forest_face_connectivity_t;
+
+T8_EXTERN_C_BEGIN ();
+
+/** Return the face neighbor table of a forest.
+ * On the first call the table is computed and stored in the forest. Following calls
+ * return the stored table. Since a committed forest cannot be modified, the
+ * table stays valid for the lifetime of the forest. Forests derived from
+ * \a forest via adapt, partition or balance compute their own table.
+ * \param [in]    forest  The forest. Must be committed and, if it lives on more than
+ *                        one process, must have a valid ghost layer.
+ * \param [in]    forest_is_balanced True if we know that \a forest is balanced, false
+ *                        otherwise. If false, the ghost layer must not have been created
+ *                        with the balanced only algorithm. The table itself does not depend
+ *                        on this flag, later calls with a different value return the same table.
+ * \return                The face neighbor table. It is owned by \a forest and must not
+ *                        be modified or freed.
+ * \note This function is not collective. The first call on a forest is not thread-safe.
+ * \note The neighbors are the same as the ones of \ref t8_forest_leaf_face_neighbors_ext for an
+ *       unbalanced forest, but they are found in one pass over the leaves of each neighbor tree.
+ * \see t8_forest_leaf_face_neighbors
+ */
+const t8_forest_face_connectivity_t *
+t8_forest_get_face_connectivity (t8_forest_t forest, int forest_is_balanced);
+
+T8_EXTERN_C_END ();
+
+#endif /* !T8_FOREST_FACE_CONNECTIVITY_H */
@@ -36,6 +36,8 @@
 /** Opaque pointer to a forest implementation. */
 typedef struct t8_forest *t8_forest_t;
 typedef struct t8_tree *t8_tree_t;
+/** Opaque handle to a running ghost data exchange. \see t8_forest_ghost_exchange_begin */
+typedef struct t8_forest_ghost_exchange *t8_forest_ghost_exchange_t;
 
 /** This type controls, which neighbors count as ghost elements.
  * Currently, we support face-neighbors. Vertex and edge neighbors will eventually be added. */
@@ -108,6 +110,15 @@ typedef void (*t8_forest_replace_t) (t8_forest_t forest_old, t8_forest_t forest_
  *        -1 if the family \a elements shall be coarsened,
  *        -2 if the first entry in \a elements should be removed,
  *         0 else.
+ * \note If the forest is adapted with more than one thread (\ref t8_forest_set_num_threads),
+ * the callback is called concurrently for different elements and must be thread-safe:
+ *  - It may read \a forest_from, the elements and the user data, but must not modify
+ *    shared data without synchronization. Writing to per element entries (indexed by
+ *    \a which_tree and \a lelement_id) of a user array is safe.
+ *  - It must not allocate or free elements with \a ts (t8_element_new, t8_element_destroy),
+ *    since the element memory pools of the schemes are not thread-safe.
+ *  - It must not call t8code functions that communicate.
+ *  - The order in which the elements are passed to the callback is undefined.
  */
 /* TODO: Do we really need the forest argument? Since the forest is not committed yet it
  *       seems dangerous to expose to the user. */
@@ -115,6 +126,18 @@ typedef int (*t8_forest_adapt_t) (t8_forest_t forest, t8_forest_t forest_from, t
                                   t8_locidx_t lelement_id, t8_eclass_scheme_c *ts, const int is_family,
                                   const int num_elements, t8_element_t *elements[]);
 
+/** Callback function prototype to compute the load of an element for a weighted partition.
+ * \param [in] forest_from  the forest that is partitioned.
+ * \param [in] which_tree   the local tree containing \a element
+ * \param [in] element      the element
+ * \param [in] ielement     the local index of \a element in \a forest_from, counted over all local trees.
+ *                          This can be used to look up the weight in a per element array.
+ * \return The weight of the element. Must be non-negative.
+ * \see t8_forest_set_partition_weight_function
+ */
+typedef double (*t8_forest_partition_weight_t) (t8_forest_t forest_from, t8_locidx_t which_tree,
+                                                const t8_element_t *element, t8_locidx_t ielement);
+
 /** Create a new forest with reference count one.
  * This forest needs to be specialized with the t8_forest_set_* calls.
  * Currently it is manatory to either call the functions \ref
@@ -255,6 +278,19 @@ t8_forest_set_copy (t8_forest_t forest, const t8_forest_t from);
 void
 t8_forest_set_adapt (t8_forest_t forest, const t8_forest_t set_from, t8_forest_adapt_t adapt_fn, int recursive);
 
+/** Set the number of threads that are used to adapt the forest on committing.
+ * The local elements are split into ranges that are adapted concurrently.
+ * Recursive adaptation and forests with incomplete trees are always adapted with one thread.
+ * If the forest is a uniform forest that is constructed from a cmesh, its elements are
+ * created concurrently by \a num_threads threads.
+ * \param [in,out] forest      The forest
+ * \param [in]     num_threads The number of threads, must be at least 1. Default is 1.
+ * \note If \a num_threads is greater than 1, the adapt callback must be thread-safe,
+ * see \ref t8_forest_adapt_t.
+ */
+void
+t8_forest_set_num_threads (t8_forest_t forest, int num_threads);
+
 /** Set the user data of a forest. This can i.e. be used to pass user defined
  * arguments to the adapt routine.
  * \param [in,out] forest   The forest
@@ -298,7 +334,8 @@ t8_forest_get_user_function (const t8_forest_t forest);
 
 /** Set a source forest to be partitioned during commit.
  * The partitioning is done according to the SFC and each rank is assigned
- * the same (maybe +1) number of elements.
+ * the same (maybe +1) number of elements, unless element weights are set
+ * with \ref t8_forest_set_partition_weight_function.
  * \param [in, out] forest  The forest.
  * \param [in]      set_from A second forest that should be partitioned.
  *                          We take ownership. This can be prevented by
@@ -319,6 +356,27 @@ t8_forest_get_user_function (const t8_forest_t forest);
 void
 t8_forest_set_partition (t8_forest_t forest, const t8_forest_t set_from, int set_for_coarsening);
 
+/** Use element weights to partition the forest during commit.
+ * Instead of assigning the same number of elements to each rank, the
+ * partition is chosen such that the sum of the weights of the elements
+ * is (up to the weight of one element) the same on each rank.
+ * The weights are computed with \a weight_fn for each element of the source
+ * forest and a parallel prefix sum along the SFC yields the new offsets.
+ * Data can be moved to the new partition with \ref t8_forest_partition_data
+ * as usual.
+ * \param [in, out] forest    The forest.
+ * \param [in]      weight_fn The weight callback. It is called with the forest
+ *                            that is partitioned, which in combination with
+ *                            \ref t8_forest_set_adapt or \ref t8_forest_set_balance
+ *                            is an intermediate forest.
+ *                            If NULL, each element has the same weight.
+ * \note If all weights are zero, the elements are partitioned evenly.
+ * \note This setting only has an effect in combination with \ref t8_forest_set_partition
+ * or \ref t8_forest_set_balance with repartitioning.
+ */
+void
+t8_forest_set_partition_weight_function (t8_forest_t forest, t8_forest_partition_weight_t weight_fn);
+
 /** Set a source forest to be balanced during commit.
  * A forest is said to be balanced if each element has face neighbors of level
  * at most +1 or -1 of the element's level.
@@ -345,30 +403,62 @@ t8_forest_set_partition (t8_forest_t forest, const t8_forest_t set_from, int set
 void
 t8_forest_set_balance (t8_forest_t forest, const t8_forest_t set_from, int no_repartition);
 
+/** Select the algorithm used to balance the forest during commit.
+ * On default each balance round refines each element at most once.
+ * With the one-pass algorithm each round refines recursively all elements that need to be
+ * refined with respect to the leaves of the previous round and their face neighbors.
+ * Usually one round suffices, another round is only needed for conflicts across process
+ * boundaries. Each round ends with one reduction of whether the new forest is balanced.
+ * The number of rounds is stored in the forest's profile, see \ref t8_forest_profile_get_balance_time.
+ * \param [in, out] forest  The forest.
+ * \param [in]      onepass If true, the one-pass algorithm is used.
+ * \note This setting only has an effect in combination with \ref t8_forest_set_balance.
+ */
+void
+t8_forest_set_balance_onepass (t8_forest_t forest, int onepass);
+
 /** Enable or disable the creation of a layer of ghost elements.
- * On default no ghosts are created.
+ * On default no ghosts are created. The layer is one element wide,
+ * see \ref t8_forest_set_ghost_ext for wider layers.
  * \param [in]      forest    The forest.
  * \param [in]      do_ghost  If non-zero a ghost layer will be created.
- * \param [in]      ghost_type Controls which neighbors count as ghost elements,
- *                             currently only T8_GHOST_FACES is supported. This value
- *                             is ignored if \a do_ghost = 0.
+ * \param [in]      ghost_type Controls which neighbors count as ghost elements.
+ *                             This value is ignored if \a do_ghost = 0.
+ * \note T8_GHOST_EDGES and T8_GHOST_VERTICES are supported for forests of lines,
+ *       quadrilaterals and hexahedra on a replicated coarse mesh. In 2D edge and vertex
+ *       ghosts coincide. For these types the top-down search is used for each \a ghost_version.
  */
 void
 t8_forest_set_ghost (t8_forest_t forest, int do_ghost, t8_ghost_type_t ghost_type);
 
 /** Like \ref t8_forest_set_ghost but with the additional options to change the
- * ghost algorithm. This is used for debugging and timing the algorithm.
- * An application should almost always use \ref t8_forest_set_ghost.
+ * ghost algorithm and the width of the ghost layer.
+ * Changing the algorithm is used for debugging and timing.
  * \param [in]      ghost_version If 1, the iterative ghost algorithm for balanced forests is used.
  *                                If 2, the iterative algorithm for unbalanced forests.
  *                                If 3, the top-down search algorithm for unbalanced forests.
+ * \param [in]      ghost_width   The number of layers of ghost elements, at least 1.
+ *                                A leaf is a ghost if it can be reached from a local leaf by a chain
+ *                                of at most \a ghost_width neighboring leaves, where neighbors are
+ *                                defined by \a ghost_type. \ref t8_forest_ghost_exchange_data
+ *                                exchanges the data of all layers.
+ * \note With \a ghost_width > 1 and \a ghost_version = 1 the forest must be balanced.
  * \see t8_forest_set_ghost
  */
 void
-t8_forest_set_ghost_ext (t8_forest_t forest, int do_ghost, t8_ghost_type_t ghost_type, int ghost_version);
-
-/* TODO: use assertions and document that the forest_set (..., from) and
- *       set_load are mutually exclusive. */
+t8_forest_set_ghost_ext (t8_forest_t forest, int do_ghost, t8_ghost_type_t ghost_type, int ghost_version,
+                         int ghost_width);
+
+/** Set a forest to be loaded from a checkpoint file written by \ref t8_forest_save.
+ * The coarse mesh and scheme of the forest must be set with \ref t8_forest_set_cmesh
+ * and \ref t8_forest_set_scheme and must match those of the saved forest.
+ * The number of processes may differ from the number of processes that saved the forest.
+ * If it is the same, the saved partition is restored, otherwise the elements are
+ * partitioned uniformly and each process only reads its own elements.
+ * Loading is mutually exclusive with deriving the forest from another forest.
+ * \param [in, out] forest     The forest.
+ * \param [in]      filename   The checkpoint file. It is read in \ref t8_forest_commit.
+ */
 void
 t8_forest_set_load (t8_forest_t forest, const char *filename);
 
@@ -524,11 +614,13 @@ t8_forest_leaf_face_orientation (t8_forest_t forest, const t8_locidx_t ltreeid,
  *                        num_local_el , ... , num_local_el + num_ghosts - 1 for ghosts.
  * \param [out]   pneigh_scheme On output the eclass scheme of the neighbor elements.
  * \param [in]    forest_is_balanced True if we know that \a forest is balanced, false
- *                        otherwise.
+ *                        otherwise. If false, neighbors of arbitrary level are found by
+ *                        descending into the neighbor's leaves. In this case, the ghost layer
+ *                        must not be created with the balanced only algorithm
+ *                        (\ref t8_forest_set_ghost_ext with version 1).
  * \param [out]   orientation If a pointer to an integer variable is given the face orientation is computed and stored there.
  * \note If there are no face neighbors, then *neighbor_leaves = NULL, num_neighbors = 0,
  * and *pelement_indices = NULL on output.
- * \note Currently \a forest must be balanced.
  * \note \a forest must be committed before calling this function.
  */
 void
@@ -553,12 +645,39 @@ t8_forest_leaf_face_neighbors_ext (t8_forest_t forest, t8_locidx_t ltreeid, cons
  * \note This function is collective and hence must be called by all processes in the forest's
  *       MPI Communicator.
  */
-/* TODO: In \ref t8_forest_ghost_cxx we already implemented a begin and end function
- *       that allow for overlapping communication and computation. We will make them
- *       available in this interface in the future. */
 void
 t8_forest_ghost_exchange_data (t8_forest_t forest, sc_array_t *element_data);
 
+/** Start a non-blocking exchange of ghost information of user defined element data.
+ * The communication pattern (which local elements are sent to which process and where
+ * the received ghost values are stored) is computed once per ghost layer and reused by
+ * all following exchanges. The MPI requests and the send buffer are bound to the data
+ * array of \a element_data and its element size and are reused as long as the same array
+ * is passed again. Thus, repeatedly exchanging the same array does not allocate memory.
+ * Between this call and \ref t8_forest_ghost_exchange_end the local entries of
+ * \a element_data may be read, but no entry of \a element_data may be modified and
+ * the array must not be resized.
+ * \param[in] forest       The forest. Must be committed.
+ * \param[in] element_data An array of length num_local_elements + num_ghosts
+ *                         storing one value for each local element and ghost in \a forest.
+ * \return                 A handle to the running exchange that must be passed to
+ *                         \ref t8_forest_ghost_exchange_end. NULL if \a forest has no ghost layer.
+ * \note This function is collective and hence must be called by all processes in the forest's
+ *       MPI Communicator. If multiple exchanges are running at the same time, they must be begun
+ *       in the same order on all processes.
+ * \see t8_forest_ghost_exchange_data
+ */
+t8_forest_ghost_exchange_t
+t8_forest_ghost_exchange_begin (t8_forest_t forest, sc_array_t *element_data);
+
+/** Wait for a ghost data exchange started with \ref t8_forest_ghost_exchange_begin to finish.
+ * Afterwards, the ghost entries of the exchanged element data array are up to date.
+ * \param[in] exchange     The handle returned by \ref t8_forest_ghost_exchange_begin.
+ *                         May be NULL, in which case nothing is done.
+ */
+void
+t8_forest_ghost_exchange_end (t8_forest_ghost_exchange_t exchange);
+
 /** Print the ghost structure of a forest. Only used for debugging. */
 void
 t8_forest_ghost_print (t8_forest_t forest);
@@ -811,6 +930,8 @@ t8_forest_element_points_inside (t8_forest_t forest, t8_locidx_t ltreeid, const
  *                            \a scheme and refinement level \a level.
  * \note This is equivalent to calling \ref t8_forest_init, \ref t8_forest_set_cmesh,
  * \ref t8_forest_set_scheme, \ref t8_forest_set_level, and \ref t8_forest_commit.
+ * To create the elements with multiple threads, call \ref t8_forest_set_num_threads
+ * before \ref t8_forest_commit instead.
  */
 t8_forest_t
 t8_forest_new_uniform (t8_cmesh_t cmesh, t8_scheme_cxx_t *scheme, const int level, const int do_face_ghost,
@@ -161,6 +161,57 @@ void
 t8_forest_element_face_normal (t8_forest_t forest, t8_locidx_t ltreeid, const t8_element_t *element, int face,
                                double normal[3]);
 
+/** Compute the centroids of a range of elements of a local tree if a geometry for this tree is
+ * registered in the forest's cmesh.
+ * In contrast to calling \ref t8_forest_element_centroid for each element, the geometry is
+ * evaluated only once for all elements of the range.
+ * \param [in]      forest        The forest.
+ * \param [in]      ltreeid       The forest local id of the tree in which the elements are.
+ * \param [in]      first_element The tree local index of the first element of the range.
+ * \param [in]      num_elements  The number of elements in the range.
+ * \param [out]     centroids     On input an allocated array to store 3 * \a num_elements doubles, on output
+ *                                the centroids as structure of arrays: First the x coordinates of all elements,
+ *                                then all y coordinates, then all z coordinates.
+ * \a forest must be committed when calling this function.
+ */
+void
+t8_forest_tree_elements_centroid (t8_forest_t forest, t8_locidx_t ltreeid, t8_locidx_t first_element,
+                                  t8_locidx_t num_elements, double *centroids);
+
+/** Compute the volumes of a range of elements of a local tree if a geometry for this tree is
+ * registered in the forest's cmesh.
+ * The result equals that of \ref t8_forest_element_volume for each element, but the geometry is
+ * evaluated only once for all corners of the range.
+ * \param [in]      forest        The forest.
+ * \param [in]      ltreeid       The forest local id of the tree in which the elements are.
+ * \param [in]      first_element The tree local index of the first element of the range.
+ * \param [in]      num_elements  The number of elements in the range.
+ * \param [out]     volumes       On input an allocated array to store \a num_elements doubles, on output
+ *                                the volumes of the elements.
+ * \a forest must be committed when calling this function.
+ */
+void
+t8_forest_tree_elements_volume (t8_forest_t forest, t8_locidx_t ltreeid, t8_locidx_t first_element,
+                                t8_locidx_t num_elements, double *volumes);
+
+/** Compute the normal vectors of a face of a range of elements of a local tree if a geometry for this
+ * tree is registered in the forest's cmesh.
+ * The result equals that of \ref t8_forest_element_face_normal for each element, but the geometry is
+ * evaluated only once for all corners (and centroids) of the range.
+ * \param [in]      forest        The forest.
+ * \param [in]      ltreeid       The forest local id of the tree in which the elements are.
+ * \param [in]      first_element The tree local index of the first element of the range.
+ * \param [in]      num_elements  The number of elements in the range.
+ * \param [in]      face          A face that all elements of the range have.
+ * \param [out]     normals       On input an allocated array to store 3 * \a num_elements doubles, on output
+ *                                the normals as structure of arrays: First the x coordinates of all elements,
+ *                                then all y coordinates, then all z coordinates.
+ * \a forest must be committed when calling this function.
+ */
+void
+t8_forest_tree_elements_face_normal (t8_forest_t forest, t8_locidx_t ltreeid, t8_locidx_t first_element,
+                                     t8_locidx_t num_elements, int face, double *normals);
+
 T8_EXTERN_C_END ();
 
 #endif /* !T8_FOREST_GEOMETRICAL_H */
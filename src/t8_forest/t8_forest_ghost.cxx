@@ -30,6 +30,10 @@
 #include <t8_element_cxx.hxx>
 #include <t8_data/t8_containers.h>
 #include <sc_statistics.h>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
 
 /* We want to export the whole implementation to be callable from "C" */
 T8_EXTERN_C_BEGIN ();
@@ -41,7 +45,8 @@ typedef struct
   int recv_rank;           /* The rank to which we send. */
   size_t num_bytes;        /* The number of bytes that we send. */
   sc_MPI_Request *request; /* Communication request, not owned by this struct. */
-  char *buffer;            /* The send buffer. */
+  char *buffer;            /* The part of the send buffer for this rank. The buffers of all ranks are one
+                              allocation which starts at the buffer of the first rank. */
 } t8_ghost_mpi_send_info_t;
 
 /* The information stored for the ghost trees */
@@ -151,29 +156,51 @@ t8_ghost_remote_equal_function (const void *remote_dataa, const void *remote_dat
   return remotea->remote_rank == remoteb->remote_rank;
 }
 
+/** The maximum number of different element data arrays for which we keep
+ * persistent communication requests at the same time. */
+#define T8_GHOST_EXCHANGE_MAX_CHANNELS 8
+
 /** This struct is used during a ghost data exchange.
  * Since we use asynchronuous communication, we store the
- * send buffers and mpi requests until we end the communication.
+ * send buffer and mpi requests until we end the communication.
+ * The requests are persistent and bound to the data array of the exchanged
+ * element data, such that we can reuse them for all exchanges of the same array.
  */
-typedef struct
+struct t8_forest_ghost_exchange
 {
-  int num_remotes;
-  /** The number of processes, we send to */
-  char **send_buffers;
-  /** For each remote the send buffer */
-  sc_MPI_Request *send_requests;
-  /** For each process we send to, the MPI request used */
-  sc_MPI_Request *recv_requests;
-  /** For each process we receive from, the MPI request used */
-} t8_ghost_data_exchange_t;
+  t8_ghost_exchange_plan_t plan;  /* The plan this exchange belongs to. */
+  void *data;                     /* The data array of the element data that the requests are bound to. */
+  size_t data_size;               /* The number of bytes per element. */
+  char *send_buffer;              /* One send buffer for all remote processes, ordered as the plan's send indices. */
+  sc_MPI_Request *send_requests;  /* For each process we send to, the MPI request used. */
+  sc_MPI_Request *recv_requests;  /* For each process we receive from, the MPI request used. */
+  const sc_array_t *element_data; /* The element data of the running exchange, NULL if no exchange is running. */
+  long last_used;                 /* The plan's use counter when this exchange was started the last time. */
+};
+
+/** The communication pattern of a ghost data exchange.
+ * It only depends on the ghost layer and is computed on the first exchange.
+ */
+struct t8_ghost_exchange_plan
+{
+  sc_MPI_Comm mpicomm;        /* The communicator of the forest. */
+  int num_remotes;            /* The number of processes we send to and receive from. */
+  int *remote_ranks;          /* The ranks of these processes in ascending order. */
+  t8_locidx_t *send_offsets;  /* For each remote the position of its first entry in send_indices.
+                                 num_remotes + 1 entries. */
+  t8_locidx_t *send_indices;  /* The local element indices of all remote elements, grouped by remote process. */
+  t8_locidx_t *recv_offsets;  /* For each remote the index of its first ghost. num_remotes + 1 entries. */
+  long use_count;             /* Counts the started exchanges, used to recycle the least recently used one. */
+  t8_forest_ghost_exchange_t exchanges[T8_GHOST_EXCHANGE_MAX_CHANNELS]; /* The exchanges of the most recently
+                                                                            used element data arrays. */
+};
 
 void
 t8_forest_ghost_init (t8_forest_ghost_t *pghost, t8_ghost_type_t ghost_type)
 {
   t8_forest_ghost_t ghost;
 
-  /* We currently only support face-neighbor ghosts */
-  T8_ASSERT (ghost_type == T8_GHOST_FACES);
+  T8_ASSERT (ghost_type != T8_GHOST_NONE);
 
   /* Allocate memory for ghost */
   ghost = *pghost = T8_ALLOC_ZERO (t8_forest_ghost_struct_t, 1);
@@ -675,6 +702,465 @@ t8_forest_ghost_fill_remote_v3 (t8_forest_t forest)
 #endif
 }
 
+/* An element that has the same level as the element whose edge or vertex neighbors we compute
+ * and that shares at least one corner with it. */
+typedef struct
+{
+  t8_gloidx_t gtreeid;   /* The global id of the tree of the element. */
+  t8_linearidx_t id;     /* The linear id of the element at its level. */
+  t8_element_t *element; /* The element. */
+  int corners;           /* Bitmask of the corners of element that are also corners of the searched element. */
+} t8_ghost_touching_t;
+
+typedef struct
+{
+  t8_eclass_scheme_c *ts;                    /* The scheme of all trees. */
+  t8_eclass_t eclass;                        /* The eclass of all trees. */
+  int min_corners;                           /* The number of corners that a neighbor must share with an element,
+                                                2^(dim - codim) for codimension codim neighbors. */
+  std::vector<t8_ghost_touching_t> touching; /* All same level elements touching the current element. */
+  std::vector<size_t> queue;                 /* Indices into touching whose neighbors must be (re)visited. */
+  t8_element_t *neigh;                       /* Temporary storage for a face neighbor */
+  t8_element_t *child;                       /* Temporary storage for a child */
+  t8_element_t *neigh_child;                 /* Temporary storage for the face neighbor of a child */
+  t8_element_t *desc[2];                     /* Temporary storage to compute descendants */
+  sc_array_t owners;                         /* Temporary storage for the owners of a touching element */
+#ifdef T8_ENABLE_DEBUG
+  t8_locidx_t left_out; /* Count the elements for which we skip the search */
+#endif
+} t8_forest_ghost_corner_data_t;
+
+/* Return the number of bits set in a corner mask. */
+static int
+t8_ghost_num_corners (int corners)
+{
+  int count = 0;
+  for (; corners != 0; corners &= corners - 1) {
+    count++;
+  }
+  return count;
+}
+
+/* Return the bitmask of the corners of an element that lie on one of its faces. */
+static int
+t8_ghost_face_corners (t8_eclass_scheme_c *ts, t8_eclass_t eclass, const t8_element_t *element, int face)
+{
+  const int num_face_corners = t8_eclass_num_vertices[t8_eclass_face_types[eclass][face]];
+  int corners = 0;
+
+  for (int icorner = 0; icorner < num_face_corners; icorner++) {
+    corners |= 1 << ts->t8_element_get_face_corner (element, face, icorner);
+  }
+  return corners;
+}
+
+/* Construct the face neighbor of an element in any tree of the forest's coarse mesh.
+ * Returns the global id of the neighbor's tree or -1 if face is on the domain boundary. */
+static t8_gloidx_t
+t8_ghost_neighbor (t8_forest_t forest, t8_eclass_scheme_c *ts, t8_gloidx_t gtreeid, const t8_element_t *element,
+                   int face, t8_element_t *neigh)
+{
+  int neigh_face;
+  const t8_locidx_t lctree_id = gtreeid - t8_cmesh_get_first_treeid (forest->cmesh);
+
+  return t8_forest_element_face_neighbor_cmesh_tree (forest, lctree_id, element, neigh, ts, face, &neigh_face);
+}
+
+/* Remove all touching elements from the data. */
+static void
+t8_forest_ghost_touching_reset (t8_forest_ghost_corner_data_t *data)
+{
+  for (t8_ghost_touching_t &touching : data->touching) {
+    data->ts->t8_element_destroy (1, &touching.element);
+  }
+  data->touching.clear ();
+  data->queue.clear ();
+}
+
+/* Collect all elements of the same level as element that share at least min_corners corners with element.
+ * The first collected element is element itself.
+ * Starting from element, we repeatedly cross those faces of the collected elements that contain
+ * at least min_corners of their shared corners. Crossing a face, we identify the shared corners in the
+ * neighbor by constructing the neighbor of the child at each shared corner, which is the child
+ * of the neighbor at the same corner. Since tree boundaries may identify corners with each other,
+ * an element may be reached several times with different corners and we merge the corners. */
+static void
+t8_forest_ghost_touching_elements (t8_forest_t forest, t8_forest_ghost_corner_data_t *data, t8_gloidx_t gtreeid,
+                                   const t8_element_t *element, const int min_corners)
+{
+  t8_eclass_scheme_c *ts = data->ts;
+  const int level = ts->t8_element_level (element);
+  t8_ghost_touching_t start;
+
+  SC_CHECK_ABORT (level < ts->t8_element_maxlevel (),
+                  "Edge and vertex ghosts are not supported for elements of maximum refinement level.\n");
+  t8_forest_ghost_touching_reset (data);
+  start.gtreeid = gtreeid;
+  start.id = ts->t8_element_get_linear_id (element, level);
+  ts->t8_element_new (1, &start.element);
+  ts->t8_element_copy (element, start.element);
+  start.corners = (1 << ts->t8_element_num_corners (element)) - 1;
+  data->touching.push_back (start);
+  data->queue.push_back (0);
+
+  while (!data->queue.empty ()) {
+    const size_t icurrent = data->queue.back ();
+    data->queue.pop_back ();
+    /* We copy the entries, since pushing to touching may invalidate references */
+    const t8_gloidx_t current_tree = data->touching[icurrent].gtreeid;
+    const t8_element_t *current = data->touching[icurrent].element;
+    const int current_corners = data->touching[icurrent].corners;
+    const int num_faces = ts->t8_element_num_faces (current);
+
+    for (int iface = 0; iface < num_faces; iface++) {
+      const int shared = current_corners & t8_ghost_face_corners (ts, data->eclass, current, iface);
+      if (t8_ghost_num_corners (shared) < min_corners) {
+        /* The neighbor at this face does not share enough corners with element */
+        continue;
+      }
+      const t8_gloidx_t neigh_tree = t8_ghost_neighbor (forest, ts, current_tree, current, iface, data->neigh);
+      if (neigh_tree < 0) {
+        /* This face is on the domain boundary */
+        continue;
+      }
+      /* Compute the corners of the neighbor that are shared with element */
+      int neigh_corners = 0;
+      for (int icorner = 0; shared >> icorner != 0; icorner++) {
+        if (shared & (1 << icorner)) {
+          ts->t8_element_child (current, icorner, data->child);
+          t8_ghost_neighbor (forest, ts, current_tree, data->child, iface, data->neigh_child);
+          neigh_corners |= 1 << ts->t8_element_child_id (data->neigh_child);
+        }
+      }
+      /* Check whether we already know the neighbor */
+      const t8_linearidx_t neigh_id = ts->t8_element_get_linear_id (data->neigh, level);
+      size_t ineigh;
+      for (ineigh = 0; ineigh < data->touching.size (); ineigh++) {
+        if (data->touching[ineigh].gtreeid == neigh_tree && data->touching[ineigh].id == neigh_id) {
+          break;
+        }
+      }
+      if (ineigh == data->touching.size ()) {
+        t8_ghost_touching_t neigh;
+        neigh.gtreeid = neigh_tree;
+        neigh.id = neigh_id;
+        ts->t8_element_new (1, &neigh.element);
+        ts->t8_element_copy (data->neigh, neigh.element);
+        neigh.corners = neigh_corners;
+        data->touching.push_back (neigh);
+        data->queue.push_back (ineigh);
+      }
+      else if ((data->touching[ineigh].corners | neigh_corners) != data->touching[ineigh].corners) {
+        /* We found new shared corners of a known element and need to visit it again */
+        data->touching[ineigh].corners |= neigh_corners;
+        data->queue.push_back (ineigh);
+      }
+    }
+  }
+}
+
+/* Compute the descendant of element at the forest's maximum level that contains the corner icorner of element. */
+static const t8_element_t *
+t8_forest_ghost_corner_descendant (t8_forest_t forest, t8_forest_ghost_corner_data_t *data,
+                                   const t8_element_t *element, const int icorner, const int idesc)
+{
+  t8_element_t *desc = data->desc[idesc];
+
+  data->ts->t8_element_copy (element, desc);
+  while (data->ts->t8_element_level (desc) < forest->maxlevel) {
+    data->ts->t8_element_child (desc, icorner, data->child);
+    data->ts->t8_element_copy (data->child, desc);
+  }
+  return desc;
+}
+
+/* Compute the owners of all leaves in element that touch the subentity of element spanned by the corners
+ * in the bitmask corners. The children of element touching the subentity are those at its corners and
+ * the subentity of such a child is spanned by the same corners. Thus, we proceed as in
+ * t8_forest_element_owners_at_face_recursion. The owners are appended to data->owners in ascending order. */
+static void
+t8_forest_ghost_owners_at_corners (t8_forest_t forest, t8_forest_ghost_corner_data_t *data, t8_gloidx_t gtreeid,
+                                   const t8_element_t *element, const int corners, int lower, int upper)
+{
+  int first_corner = 0, last_corner = 0;
+
+  T8_ASSERT (corners != 0);
+  for (int icorner = 0; corners >> icorner != 0; icorner++) {
+    if (corners & (1 << icorner)) {
+      last_corner = icorner;
+    }
+  }
+  while (!(corners & (1 << first_corner))) {
+    first_corner++;
+  }
+  /* The owners of the first and last descendant touching the subentity */
+  const t8_element_t *first_desc = t8_forest_ghost_corner_descendant (forest, data, element, first_corner, 0);
+  const int first_owner = t8_forest_element_find_owner_ext (forest, gtreeid, (t8_element_t *) first_desc,
+                                                            data->eclass, lower, upper, lower, 1);
+  const t8_element_t *last_desc = t8_forest_ghost_corner_descendant (forest, data, element, last_corner, 1);
+  const int last_owner = t8_forest_element_find_owner_ext (forest, gtreeid, (t8_element_t *) last_desc,
+                                                           data->eclass, lower, upper, upper, 1);
+  T8_ASSERT (first_owner <= last_owner);
+
+  if (first_owner == last_owner) {
+    /* All leaves at the subentity have the same owner */
+    if (data->owners.elem_count == 0
+        || *(int *) sc_array_index (&data->owners, data->owners.elem_count - 1) != first_owner) {
+      *(int *) sc_array_push (&data->owners) = first_owner;
+    }
+    return;
+  }
+  /* Recurse into the children at the corners in SFC order */
+  t8_element_t *child;
+  data->ts->t8_element_new (1, &child);
+  for (int icorner = first_corner; icorner <= last_corner; icorner++) {
+    if (corners & (1 << icorner)) {
+      data->ts->t8_element_child (element, icorner, child);
+      t8_forest_ghost_owners_at_corners (forest, data, gtreeid, child, corners, first_owner, last_owner);
+    }
+  }
+  data->ts->t8_element_destroy (1, &child);
+}
+
+/* Search callback for edge and vertex ghosts.
+ * For a leaf we add it as a remote element to all owners of leaves that share
+ * a face, edge or vertex, depending on the ghost type, with it.
+ * We do not continue the search for an element if it and all elements touching it are
+ * owned by this rank, since then all leaf neighbors of its descendants are local. */
+static int
+t8_forest_ghost_search_corners (t8_forest_t forest, t8_locidx_t ltreeid, const t8_element_t *element,
+                                const int is_leaf, const t8_element_array_t *leaves, const t8_locidx_t tree_leaf_index,
+                                void *query, sc_array_t *query_indices, int *query_matches,
+                                const size_t num_active_queries)
+{
+  t8_forest_ghost_corner_data_t *data = (t8_forest_ghost_corner_data_t *) t8_forest_get_user_data (forest);
+  const t8_gloidx_t gtreeid = t8_forest_global_tree_id (forest, ltreeid);
+
+  if (!is_leaf) {
+    /* Each leaf touching a descendant of element is a descendant or an ancestor
+     * of an element touching element in at least one corner. */
+    t8_forest_ghost_touching_elements (forest, data, gtreeid, element, 1);
+    for (const t8_ghost_touching_t &touching : data->touching) {
+      int lower = 0, upper = forest->mpisize - 1;
+      t8_forest_element_owners_bounds (forest, touching.gtreeid, touching.element, data->eclass, &lower, &upper);
+      if (lower != upper || lower != forest->mpirank) {
+        /* Continue the search, since there may be remote neighbors */
+        return 1;
+      }
+    }
+#ifdef T8_ENABLE_DEBUG
+    data->left_out += t8_element_array_get_count (leaves);
+#endif
+    return 0;
+  }
+
+  t8_forest_ghost_touching_elements (forest, data, gtreeid, element, data->min_corners);
+  /* The first touching element is the leaf itself */
+  for (size_t itouching = 1; itouching < data->touching.size (); itouching++) {
+    const t8_ghost_touching_t &touching = data->touching[itouching];
+    int lower = 0, upper = forest->mpisize - 1;
+
+    t8_forest_element_owners_bounds (forest, touching.gtreeid, touching.element, data->eclass, &lower, &upper);
+    sc_array_truncate (&data->owners);
+    if (lower == upper) {
+      *(int *) sc_array_push (&data->owners) = lower;
+    }
+    else if (lower < upper) {
+      t8_forest_ghost_owners_at_corners (forest, data, touching.gtreeid, touching.element, touching.corners, lower,
+                                         upper);
+    }
+    for (size_t iowner = 0; iowner < data->owners.elem_count; iowner++) {
+      const int remote_rank = *(int *) sc_array_index (&data->owners, iowner);
+      if (remote_rank != forest->mpirank) {
+        t8_ghost_add_remote (forest, forest->ghosts, remote_rank, ltreeid, element, tree_leaf_index);
+      }
+    }
+  }
+  return 0;
+}
+
+/* Initialize the data to compute edge or vertex neighbors of the elements of a forest.
+ * We support lines, quadrilaterals and hexahedra and the trees must be local in the coarse mesh,
+ * for example since the coarse mesh is replicated. */
+static void
+t8_forest_ghost_corner_data_init (t8_forest_t forest, t8_forest_ghost_corner_data_t *data)
+{
+  const int dim = forest->dimension;
+  const t8_eclass_t eclass = dim == 1 ? T8_ECLASS_LINE : dim == 2 ? T8_ECLASS_QUAD : T8_ECLASS_HEX;
+  const int codim = SC_MIN (dim, forest->ghost_type == T8_GHOST_EDGES ? 2 : 3);
+
+  SC_CHECK_ABORT (t8_cmesh_get_num_local_trees (forest->cmesh) == t8_cmesh_get_num_trees (forest->cmesh),
+                  "Edge and vertex ghosts require a replicated coarse mesh.\n");
+  for (t8_locidx_t itree = 0; itree < t8_cmesh_get_num_local_trees (forest->cmesh); itree++) {
+    SC_CHECK_ABORT (dim > 0 && t8_cmesh_get_tree_class (forest->cmesh, itree) == eclass,
+                    "Edge and vertex ghosts are only supported for lines, quadrilaterals and hexahedra.\n");
+  }
+
+  data->eclass = eclass;
+  data->ts = t8_forest_get_eclass_scheme (forest, eclass);
+  data->min_corners = 1 << (dim - codim);
+  data->ts->t8_element_new (1, &data->neigh);
+  data->ts->t8_element_new (1, &data->child);
+  data->ts->t8_element_new (1, &data->neigh_child);
+  data->ts->t8_element_new (2, data->desc);
+  sc_array_init (&data->owners, sizeof (int));
+#ifdef T8_ENABLE_DEBUG
+  data->left_out = 0;
+#endif
+}
+
+/* Free the memory of the data to compute edge or vertex neighbors. */
+static void
+t8_forest_ghost_corner_data_reset (t8_forest_ghost_corner_data_t *data)
+{
+  t8_forest_ghost_touching_reset (data);
+  data->ts->t8_element_destroy (1, &data->neigh);
+  data->ts->t8_element_destroy (1, &data->child);
+  data->ts->t8_element_destroy (1, &data->neigh_child);
+  data->ts->t8_element_destroy (2, data->desc);
+  sc_array_reset (&data->owners);
+}
+
+/* Fill the remote ghosts of a ghost structure for edge or vertex ghosts.
+ * As in t8_forest_ghost_fill_remote_v3, we use a top-down search through the local elements.
+ * For each leaf we collect all elements of the same level that share a face, edge or vertex with it
+ * and add the leaf as a remote to all owners of leaves at the shared subentity. */
+static void
+t8_forest_ghost_fill_remote_corners (t8_forest_t forest)
+{
+  t8_forest_ghost_corner_data_t data;
+  void *store_user_data = NULL;
+
+  t8_forest_ghost_corner_data_init (forest, &data);
+  /* Store any user data that may reside on the forest */
+  store_user_data = t8_forest_get_user_data (forest);
+  /* Set the user data for the search routine */
+  t8_forest_set_user_data (forest, &data);
+  /* Loop over the trees of the forest */
+  t8_forest_search (forest, t8_forest_ghost_search_corners, NULL, NULL);
+
+  /* Reset the user data from before search */
+  t8_forest_set_user_data (forest, store_user_data);
+
+#ifdef T8_ENABLE_DEBUG
+  t8_debugf ("Skipped the search for %li leaves.\n", (long) data.left_out);
+#endif
+  t8_forest_ghost_corner_data_reset (&data);
+}
+
+/* Find the leaves in the sorted array leaves that touch the subentity of element spanned by the
+ * corners in the bitmask corners. These are either a single leaf that is element or one of its ancestors,
+ * or descendants of element at these corners. The indices of the found leaves, offset by index_offset,
+ * are appended to indices. */
+static void
+t8_forest_ghost_leaves_at_corners (t8_forest_t forest, t8_eclass_scheme_c *ts, const t8_element_t *element,
+                                   const int corners, t8_element_array_t *leaves, const t8_locidx_t index_offset,
+                                   std::vector<t8_locidx_t> &indices)
+{
+  const int maxlevel = forest->maxlevel;
+  const int level = ts->t8_element_level (element);
+
+  if (t8_element_array_get_count (leaves) == 0) {
+    return;
+  }
+  const t8_linearidx_t first_id = ts->t8_element_get_linear_id (element, maxlevel);
+  /* The last leaf that starts before or at element */
+  const t8_locidx_t lower = t8_forest_bin_search_lower (leaves, first_id, maxlevel);
+  t8_locidx_t first_desc = lower + 1;
+  if (lower >= 0) {
+    const t8_element_t *candidate = t8_element_array_index_locidx (leaves, lower);
+    t8_element_t *ancestor;
+    ts->t8_element_new (1, &ancestor);
+    ts->t8_element_nca (candidate, element, ancestor);
+    const int is_ancestor = ts->t8_element_level (candidate) <= level && ts->t8_element_equal (ancestor, candidate);
+    ts->t8_element_destroy (1, &ancestor);
+    if (is_ancestor) {
+      /* The candidate contains element */
+      indices.push_back (lower + index_offset);
+      return;
+    }
+    if (ts->t8_element_get_linear_id (candidate, maxlevel) == first_id) {
+      /* The candidate is the first descendant of element */
+      first_desc = lower;
+    }
+  }
+  /* Check whether there are leaves inside element */
+  t8_element_t *desc;
+  ts->t8_element_new (1, &desc);
+  ts->t8_element_last_descendant (element, desc, maxlevel);
+  const t8_locidx_t end_desc
+    = t8_forest_bin_search_lower (leaves, ts->t8_element_get_linear_id (desc, maxlevel), maxlevel) + 1;
+  if (first_desc < end_desc && level < maxlevel) {
+    /* Descend into the children at the corners */
+    const int num_corners = ts->t8_element_num_corners (element);
+    for (int icorner = 0; icorner < num_corners; icorner++) {
+      if (corners & (1 << icorner)) {
+        ts->t8_element_child (element, icorner, desc);
+        t8_forest_ghost_leaves_at_corners (forest, ts, desc, corners, leaves, index_offset, indices);
+      }
+    }
+  }
+  ts->t8_element_destroy (1, &desc);
+}
+
+/* Compute the indices of all local and ghost leaves that are neighbors of a local leaf with respect
+ * to the ghost type of the forest. The indices are 0, ..., num_local_elements - 1 for local leaves
+ * and num_local_elements + i for the i-th ghost. They are sorted and do not contain leaf_index.
+ * For edge and vertex neighbors data must be initialized with t8_forest_ghost_corner_data_init. */
+static void
+t8_forest_ghost_leaf_neighbors (t8_forest_t forest, t8_forest_ghost_corner_data_t *data, const t8_locidx_t ltreeid,
+                                const t8_element_t *leaf, const t8_locidx_t leaf_index,
+                                std::vector<t8_locidx_t> &neighbors)
+{
+  neighbors.clear ();
+  if (forest->ghost_type == T8_GHOST_FACES) {
+    t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, t8_forest_get_tree_class (forest, ltreeid));
+    const int num_faces = ts->t8_element_num_faces (leaf);
+    for (int iface = 0; iface < num_faces; iface++) {
+      t8_element_t **neighbor_leaves;
+      t8_locidx_t *element_indices;
+      t8_eclass_scheme_c *neigh_scheme;
+      int *dual_faces;
+      int num_neighbors;
+
+      t8_forest_leaf_face_neighbors (forest, ltreeid, leaf, &neighbor_leaves, iface, &dual_faces, &num_neighbors,
+                                     &element_indices, &neigh_scheme, forest->ghost_algorithm == 1);
+      if (num_neighbors > 0) {
+        neighbors.insert (neighbors.end (), element_indices, element_indices + num_neighbors);
+        neigh_scheme->t8_element_destroy (num_neighbors, neighbor_leaves);
+        T8_FREE (neighbor_leaves);
+        T8_FREE (dual_faces);
+        T8_FREE (element_indices);
+      }
+    }
+  }
+  else {
+    const t8_locidx_t num_local_elements = t8_forest_get_local_num_elements (forest);
+    t8_forest_ghost_touching_elements (forest, data, t8_forest_global_tree_id (forest, ltreeid), leaf,
+                                       data->min_corners);
+    /* The first touching element is the leaf itself */
+    for (size_t itouching = 1; itouching < data->touching.size (); itouching++) {
+      const t8_ghost_touching_t &touching = data->touching[itouching];
+      const t8_locidx_t lneigh_treeid = t8_forest_get_local_id (forest, touching.gtreeid);
+      if (lneigh_treeid >= 0) {
+        t8_forest_ghost_leaves_at_corners (forest, data->ts, touching.element, touching.corners,
+                                           t8_forest_get_tree_element_array (forest, lneigh_treeid),
+                                           t8_forest_get_tree_element_offset (forest, lneigh_treeid), neighbors);
+      }
+      const t8_locidx_t lghost_treeid = t8_forest_ghost_get_ghost_treeid (forest, touching.gtreeid);
+      if (lghost_treeid >= 0) {
+        t8_element_array_t *ghost_leaves = t8_forest_ghost_get_tree_elements (forest, lghost_treeid);
+        t8_forest_ghost_leaves_at_corners (
+          forest, data->ts, touching.element, touching.corners, ghost_leaves,
+          num_local_elements + t8_forest_ghost_get_tree_element_offset (forest, lghost_treeid), neighbors);
+      }
+    }
+  }
+  std::sort (neighbors.begin (), neighbors.end ());
+  neighbors.erase (std::unique (neighbors.begin (), neighbors.end ()), neighbors.end ());
+  neighbors.erase (std::remove (neighbors.begin (), neighbors.end (), leaf_index), neighbors.end ());
+}
+
 /* Fill the remote ghosts of a ghost structure.
  * We iterate through all elements and check if their neighbors
  * lie on remote processes. If so, we add the element to the
@@ -821,12 +1307,50 @@ t8_forest_ghost_fill_remote (t8_forest_t forest, t8_forest_ghost_t ghost, int gh
   }
 }
 
+/* Compute the number of bytes of the message that we send to a remote process.
+ * See t8_forest_ghost_parse_received_message for the layout of the message.
+ * Since the message ends with padding, its size is a multiple of T8_PADDING_SIZE. */
+static size_t
+t8_forest_ghost_message_num_bytes (sc_array_t *remote_trees)
+{
+  size_t num_bytes = 0;
+
+  /* At first we store the number of remote trees in the buffer */
+  num_bytes += sizeof (size_t);
+  /* add padding before the first tree */
+  num_bytes += T8_ADD_PADDING (num_bytes);
+  for (size_t remote_index = 0; remote_index < remote_trees->elem_count; remote_index++) {
+    /* Get the next remote tree. */
+    t8_ghost_remote_tree_t *remote_tree = (t8_ghost_remote_tree_t *) sc_array_index (remote_trees, remote_index);
+    /* We will store the global tree id, the element class and the list
+     * of elements in the send_buffer. */
+    num_bytes += sizeof (t8_gloidx_t);
+    /* add padding before the eclass */
+    num_bytes += T8_ADD_PADDING (num_bytes);
+    num_bytes += sizeof (t8_eclass_t);
+    /* add padding before the number of elements */
+    num_bytes += T8_ADD_PADDING (num_bytes);
+    /* We will store the number of elements */
+    num_bytes += sizeof (size_t);
+    /* add padding before the elements */
+    num_bytes += T8_ADD_PADDING (num_bytes);
+    /* The byte count of the elements */
+    num_bytes += t8_element_array_get_size (&remote_tree->elements)
+                 * t8_element_array_get_count (&remote_tree->elements);
+    /* add padding after the elements */
+    num_bytes += T8_ADD_PADDING (num_bytes);
+  }
+  return num_bytes;
+}
+
 /* Begin sending the ghost elements from the remote ranks
  * using non-blocking communication.
+ * The messages to all remote ranks are packed into one send buffer.
  * Afterwards,
  *  t8_forest_ghost_send_end
  * must be called to end the communication.
  * Returns an array of mpi_send_info_t, one for each remote rank.
+ * On output, requests stores num_remotes requests, one for each message.
  */
 static t8_ghost_mpi_send_info_t *
 t8_forest_ghost_send_start (t8_forest_t forest, t8_forest_ghost_t ghost, sc_MPI_Request **requests)
@@ -838,77 +1362,54 @@ t8_forest_ghost_send_start (t8_forest_t forest, t8_forest_ghost_t ghost, sc_MPI_
   sc_array_t *remote_trees;
   t8_ghost_remote_tree_t *remote_tree = NULL;
   t8_ghost_mpi_send_info_t *send_info, *current_send_info;
-  char *current_buffer;
-  size_t bytes_written, element_bytes, element_count, element_size;
-#ifdef T8_ENABLE_DEBUG
-  size_t acc_el_count = 0;
-#endif
+  char *send_buffer, *current_buffer;
+  size_t bytes_written, element_bytes, element_count, element_size, total_bytes;
   int mpiret;
 
-  /* Allocate a send_buffer for each remote rank */
+  if (forest->profile != NULL) {
+    forest->profile->ghost_pack_runtime -= sc_MPI_Wtime ();
+  }
+
+  /* Allocate a send_info and a request for each remote rank */
   num_remotes = ghost->remote_processes->elem_count;
   send_info = T8_ALLOC (t8_ghost_mpi_send_info_t, num_remotes);
   *requests = T8_ALLOC (sc_MPI_Request, num_remotes);
 
-  /* Loop over all remote processes */
-  for (proc_index = 0; proc_index < (int) ghost->remote_processes->elem_count; proc_index++) {
+  /* Compute the number of bytes that we send to each remote rank */
+  total_bytes = 0;
+  for (proc_index = 0; proc_index < num_remotes; proc_index++) {
     current_send_info = send_info + proc_index;
     /* Get the rank of the current remote process. */
     remote_rank = *(int *) sc_array_index_int (ghost->remote_processes, proc_index);
-    t8_debugf ("Filling send buffer for process %i\n", remote_rank);
+    remote_entry = t8_forest_ghost_get_remote (forest, remote_rank);
+    T8_ASSERT (remote_entry->remote_rank == remote_rank);
     /* initialize the send_info for the current rank */
     current_send_info->recv_rank = remote_rank;
-    current_send_info->num_bytes = 0;
+    current_send_info->num_bytes = t8_forest_ghost_message_num_bytes (&remote_entry->remote_trees);
     current_send_info->request = *requests + proc_index;
-    /* Lookup the ghost elements for the first tree of this remote */
+    total_bytes += current_send_info->num_bytes;
+  }
+
+  /* We now know the number of bytes of all messages and allocate one buffer for them.
+   * Since the size of each message is padded, each message starts at a padded offset. */
+  send_buffer = num_remotes > 0 ? T8_ALLOC_ZERO (char, total_bytes) : NULL;
+
+  /* Loop over all remote processes */
+  current_buffer = send_buffer;
+  for (proc_index = 0; proc_index < num_remotes; proc_index++) {
+    current_send_info = send_info + proc_index;
+    remote_rank = current_send_info->recv_rank;
+    current_send_info->buffer = current_buffer;
+    t8_debugf ("Filling send buffer for process %i\n", remote_rank);
     remote_entry = t8_forest_ghost_get_remote (forest, remote_rank);
-    T8_ASSERT (remote_entry->remote_rank == remote_rank);
-    /* Loop over all trees of the remote rank and count the bytes */
-    /* At first we store the number of remote trees in the buffer */
-    current_send_info->num_bytes += sizeof (size_t);
-    /* add padding before the eclass */
-    current_send_info->num_bytes += T8_ADD_PADDING (current_send_info->num_bytes);
-    /* TODO: put this in a function */
-    /* TODO: Use remote_entry to count the number of bytes while inserting
-     *        the remote ghosts. */
     remote_trees = &remote_entry->remote_trees;
-    for (remote_index = 0; remote_index < remote_trees->elem_count; remote_index++) {
-      /* Get the next remote tree. */
-      remote_tree = (t8_ghost_remote_tree_t *) sc_array_index (remote_trees, remote_index);
-      /* We will store the global tree id, the element class and the list
-       * of elements in the send_buffer. */
-      current_send_info->num_bytes += sizeof (t8_gloidx_t);
-      /* add padding before the eclass */
-      current_send_info->num_bytes += T8_ADD_PADDING (current_send_info->num_bytes);
-      current_send_info->num_bytes += sizeof (t8_eclass_t);
-      /* add padding before the elements */
-      current_send_info->num_bytes += T8_ADD_PADDING (current_send_info->num_bytes);
-      /* The byte count of the elements */
-      element_size = t8_element_array_get_size (&remote_tree->elements);
-      element_count = t8_element_array_get_count (&remote_tree->elements);
-      element_bytes = element_size * element_count;
-      /* We will store the number of elements */
-      current_send_info->num_bytes += sizeof (size_t);
-      /* add padding before the elements */
-      current_send_info->num_bytes += T8_ADD_PADDING (current_send_info->num_bytes);
-      current_send_info->num_bytes += element_bytes;
-      /* add padding after the elements */
-      current_send_info->num_bytes += T8_ADD_PADDING (current_send_info->num_bytes);
-    }
-
-    /* We now now the number of bytes for our send_buffer and thus allocate it. */
-    current_send_info->buffer = T8_ALLOC_ZERO (char, current_send_info->num_bytes);
 
-    /* We iterate through the tree again and store the tree info and the elements into the send_buffer. */
-    current_buffer = current_send_info->buffer;
+    /* We iterate through the trees and store the tree info and the elements into the send_buffer. */
     bytes_written = 0;
     /* Start with the number of remote trees in the buffer */
     memcpy (current_buffer + bytes_written, &remote_trees->elem_count, sizeof (size_t));
     bytes_written += sizeof (size_t);
     bytes_written += T8_ADD_PADDING (bytes_written);
-#ifdef T8_ENABLE_DEBUG
-    acc_el_count = 0;
-#endif
     for (remote_index = 0; remote_index < remote_trees->elem_count; remote_index++) {
       /* Get a pointer to the tree */
       remote_tree = (t8_ghost_remote_tree_t *) sc_array_index (remote_trees, remote_index);
@@ -938,17 +1439,20 @@ t8_forest_ghost_send_start (t8_forest_t forest, t8_forest_ghost_t ghost, sc_MPI_
 
       /* Add to the counter of remote elements. */
       ghost->num_remote_elements += element_count;
-#ifdef T8_ENABLE_DEBUG
-      acc_el_count += element_count;
-#endif
     } /* End tree loop */
 
     T8_ASSERT (bytes_written == current_send_info->num_bytes);
     /* We can now post the MPI_Isend for the remote process */
     mpiret = sc_MPI_Isend (current_buffer, bytes_written, sc_MPI_BYTE, remote_rank, T8_MPI_GHOST_FOREST,
-                           forest->mpicomm, *requests + proc_index);
+                           forest->mpicomm, current_send_info->request);
     SC_CHECK_MPI (mpiret);
+    current_buffer += bytes_written;
   } /* end process loop */
+  T8_ASSERT (current_buffer == send_buffer + total_bytes);
+
+  if (forest->profile != NULL) {
+    forest->profile->ghost_pack_runtime += sc_MPI_Wtime ();
+  }
   return send_info;
 }
 
@@ -957,11 +1461,15 @@ t8_forest_ghost_send_end (t8_forest_t forest, t8_forest_ghost_t ghost, t8_ghost_
                           sc_MPI_Request *requests)
 {
   int num_remotes;
-  int proc_pos, mpiret;
+  int mpiret;
 
   T8_ASSERT (t8_forest_is_committed (forest));
   T8_ASSERT (ghost != NULL);
 
+  if (forest->profile != NULL) {
+    forest->profile->ghost_communicate_runtime -= sc_MPI_Wtime ();
+  }
+
   /* Get the number of remote processes */
   num_remotes = ghost->remote_processes->elem_count;
 
@@ -969,36 +1477,16 @@ t8_forest_ghost_send_end (t8_forest_t forest, t8_forest_ghost_t ghost, t8_ghost_
   mpiret = sc_MPI_Waitall (num_remotes, requests, sc_MPI_STATUSES_IGNORE);
   SC_CHECK_MPI (mpiret);
 
-  /* Clean-up */
-  for (proc_pos = 0; proc_pos < num_remotes; proc_pos++) {
-    T8_FREE (send_info[proc_pos].buffer);
+  /* Clean-up, the first send_info points to the start of the send buffer */
+  if (num_remotes > 0) {
+    T8_FREE (send_info[0].buffer);
   }
   T8_FREE (send_info);
   T8_FREE (requests);
-}
-
-/* Receive a single message from a remote process, after the message was successfully probed.
- * Returns the allocated receive buffer and the number of bytes received */
-static char *
-t8_forest_ghost_receive_message (int recv_rank, sc_MPI_Comm comm, sc_MPI_Status status, int *recv_bytes)
-{
-  char *recv_buffer;
-  int mpiret;
 
-  T8_ASSERT (recv_rank == status.MPI_SOURCE);
-  T8_ASSERT (status.MPI_TAG == T8_MPI_GHOST_FOREST);
-
-  /* Get the number of bytes in the message */
-  mpiret = sc_MPI_Get_count (&status, sc_MPI_BYTE, recv_bytes);
-
-  /* Allocate receive buffer */
-  recv_buffer = T8_ALLOC_ZERO (char, *recv_bytes);
-  /* receive the message */
-  mpiret
-    = sc_MPI_Recv (recv_buffer, *recv_bytes, sc_MPI_BYTE, recv_rank, T8_MPI_GHOST_FOREST, comm, sc_MPI_STATUS_IGNORE);
-  SC_CHECK_MPI (mpiret);
-
-  return recv_buffer;
+  if (forest->profile != NULL) {
+    forest->profile->ghost_communicate_runtime += sc_MPI_Wtime ();
+  }
 }
 
 /* Parse a message from a remote process and correctly include the received
@@ -1016,8 +1504,8 @@ t8_forest_ghost_receive_message (int recv_rank, sc_MPI_Comm comm, sc_MPI_Status
 /* Currently we expect that the messages arrive in order of the sender's rank. */
 static void
 t8_forest_ghost_parse_received_message (t8_forest_t forest, t8_forest_ghost_t ghost,
-                                        t8_locidx_t *current_element_offset, int recv_rank, char *recv_buffer,
-                                        int recv_bytes)
+                                        t8_locidx_t *current_element_offset, int recv_rank, const char *recv_buffer,
+                                        size_t recv_bytes)
 {
   size_t bytes_read, first_tree_index = 0, first_element_index = 0;
   t8_locidx_t num_trees, itree;
@@ -1035,11 +1523,11 @@ t8_forest_ghost_parse_received_message (t8_forest_t forest, t8_forest_ghost_t gh
 
   bytes_read = 0;
   /* read the number of trees */
-  num_trees = *(size_t *) recv_buffer;
+  num_trees = *(const size_t *) recv_buffer;
   bytes_read += sizeof (size_t);
   bytes_read += T8_ADD_PADDING (bytes_read);
 
-  t8_debugf ("Received %li trees from %i (%i bytes)\n", (long) num_trees, recv_rank, recv_bytes);
+  t8_debugf ("Received %li trees from %i (%zu bytes)\n", (long) num_trees, recv_rank, recv_bytes);
 
   /* Count the total number of ghosts that we receive from this rank */
   ghosts_offset = ghost->num_ghosts_elements;
@@ -1050,15 +1538,15 @@ t8_forest_ghost_parse_received_message (t8_forest_t forest, t8_forest_ghost_t gh
     /* if yes: add the elements to the end of the tree's element array. */
 
     /* read the global id of this tree. */
-    global_id = *(t8_gloidx_t *) (recv_buffer + bytes_read);
+    global_id = *(const t8_gloidx_t *) (recv_buffer + bytes_read);
     bytes_read += sizeof (t8_gloidx_t);
     bytes_read += T8_ADD_PADDING (bytes_read);
     /* read the element class of the tree */
-    eclass = *(t8_eclass_t *) (recv_buffer + bytes_read);
+    eclass = *(const t8_eclass_t *) (recv_buffer + bytes_read);
     bytes_read += sizeof (t8_eclass_t);
     bytes_read += T8_ADD_PADDING (bytes_read);
     /* read the number of elements sent */
-    num_elements = *(size_t *) (recv_buffer + bytes_read);
+    num_elements = *(const size_t *) (recv_buffer + bytes_read);
 
     /* Add to the counter of ghost elements. */
     ghost->num_ghosts_elements += num_elements;
@@ -1123,8 +1611,7 @@ t8_forest_ghost_parse_received_message (t8_forest_t forest, t8_forest_ghost_t gh
     bytes_read += T8_ADD_PADDING (bytes_read);
     *current_element_offset += num_elements;
   }
-  T8_ASSERT (bytes_read == (size_t) recv_bytes);
-  T8_FREE (recv_buffer);
+  T8_ASSERT (bytes_read == recv_bytes);
 
   /* At last we add the receiving rank to the ghosts process_offset hash table */
   process_hash = (t8_ghost_process_hash_t *) sc_mempool_alloc (ghost->proc_offset_mempool);
@@ -1142,46 +1629,26 @@ t8_forest_ghost_parse_received_message (t8_forest_t forest, t8_forest_ghost_t gh
   T8_ASSERT (added_process);
 }
 
-/* In forest_ghost_receive we need a lookup table to give us the position
- * of a process in the ghost->remote_processes array, given the rank of a process.
- * We implement this via a hash table with the following struct as entry. */
-typedef struct t8_recv_list_entry_struct
-{
-  int rank;                    /* The rank of this process */
-  int pos_in_remote_processes; /* The position of this process in the remote_processes array */
-} t8_recv_list_entry_t;
-
-/* We hash these entries by their rank */
-unsigned
-t8_recv_list_entry_hash (const void *v1, const void *u)
-{
-  const t8_recv_list_entry_t *e1 = (const t8_recv_list_entry_t *) v1;
-
-  return e1->rank;
-}
-
-/* two entries are considered equal if they have the same rank. */
-int
-t8_recv_list_entry_equal (const void *v1, const void *v2, const void *u)
-{
-  const t8_recv_list_entry_t *e1 = (const t8_recv_list_entry_t *) v1;
-  const t8_recv_list_entry_t *e2 = (const t8_recv_list_entry_t *) v2;
-
-  return e1->rank == e2->rank;
-}
-
-/* Probe for all incoming messages from the remote ranks and receive them.
- * We receive the message in the order in which they arrive. To achieve this,
- * we have to use polling. */
+/* Receive the ghost elements from the remote ranks.
+ * Since the ghost relation is symmetric, we receive from exactly the remote processes.
+ * We probe for the message of each remote process in order of the ranks. The probe
+ * tells us the size of the message, such that we do not need to exchange the sizes
+ * beforehand. We receive the message and include the received data into the ghost
+ * structure, while the messages of the larger ranks may still be in transit.
+ * We do not probe for any source, since a remote process may already have sent the
+ * message of the next ghost layer creation. */
 static void
 t8_forest_ghost_receive (t8_forest_t forest, t8_forest_ghost_t ghost)
 {
   int num_remotes;
   int proc_pos;
   int recv_rank;
+  int recv_bytes;
   int mpiret;
   sc_MPI_Comm comm;
   sc_MPI_Status status;
+  std::vector<char> recv_buffer;
+  t8_locidx_t current_element_offset = 0;
 
   T8_ASSERT (t8_forest_is_committed (forest));
   T8_ASSERT (ghost != NULL);
@@ -1195,183 +1662,212 @@ t8_forest_ghost_receive (t8_forest_t forest, t8_forest_ghost_t ghost)
     return;
   }
 
-  {
-    /* This code receives the message in order of their arrival.
-     * This is effective in terms of runtime, but makes it more difficult
-     * to store the received data, since the data has to be stored in order of
-     * ascending ranks.
-     * We include the received data into the ghost structure in order of the
-     * ranks of the receivers and we do this as soon as the message from
-     * the next rank that we can include was received.
-     */
-    char **buffer;
-    int *recv_bytes;
-    int received_messages = 0;
-    int *received_flag;
-    int last_rank_parsed = -1, parse_it;
-#undef T8_POLLING /* activates polling for Mpi messages, currently used for testing */
-#ifdef T8_POLLING
-    sc_link_t *proc_it, *prev;
-    int iprobe_flag;
-    sc_list_t *receivers;
-#else
-    t8_recv_list_entry_t **pfound, *found;
-#ifdef T8_ENABLE_DEBUG
-    int ret;
-#endif
-    sc_hash_t *recv_list_entries_hash;
-#endif
-    t8_recv_list_entry_t recv_list_entry, *recv_list_entries;
-    t8_locidx_t current_element_offset = 0;
-
-    buffer = T8_ALLOC (char *, num_remotes);
-    recv_bytes = T8_ALLOC (int, num_remotes);
-    received_flag = T8_ALLOC_ZERO (int, num_remotes);
-    recv_list_entries = T8_ALLOC (t8_recv_list_entry_t, num_remotes);
-
-    /* Sort the array of remote processes, such that the ranks are in
-     * ascending order. */
-    sc_array_sort (ghost->remote_processes, sc_int_compare);
-
-    /* We build a hash table of all ranks from which we receive and their position
-     * in the remote_processes array. */
-#ifdef T8_POLLING /* polling */
-    receivers = sc_list_new (NULL);
-#else
-    recv_list_entries_hash = sc_hash_new (t8_recv_list_entry_hash, t8_recv_list_entry_equal, NULL, NULL);
-#endif
-    for (proc_pos = 0; proc_pos < num_remotes; proc_pos++) {
-      recv_list_entries[proc_pos].rank = *(int *) sc_array_index_int (ghost->remote_processes, proc_pos);
-      recv_list_entries[proc_pos].pos_in_remote_processes = proc_pos;
-#ifndef T8_POLLING
-#ifdef T8_ENABLE_DEBUG
-      ret =
-#else
-      (void)
-#endif
-        sc_hash_insert_unique (recv_list_entries_hash, recv_list_entries + proc_pos, NULL);
-      T8_ASSERT (ret == 1);
-#else /* polling */
-      sc_list_append (receivers, recv_list_entries + proc_pos);
-#endif
+  /* Sort the array of remote processes, such that the ranks are in
+   * ascending order. */
+  sc_array_sort (ghost->remote_processes, sc_int_compare);
+
+  for (proc_pos = 0; proc_pos < num_remotes; proc_pos++) {
+    if (forest->profile != NULL) {
+      forest->profile->ghost_communicate_runtime -= sc_MPI_Wtime ();
+    }
+    recv_rank = *(int *) sc_array_index_int (ghost->remote_processes, proc_pos);
+    /* Wait for the message of this rank and get its size */
+    mpiret = sc_MPI_Probe (recv_rank, T8_MPI_GHOST_FOREST, comm, &status);
+    SC_CHECK_MPI (mpiret);
+    mpiret = sc_MPI_Get_count (&status, sc_MPI_BYTE, &recv_bytes);
+    SC_CHECK_MPI (mpiret);
+    /* The buffer is reused for all messages and only grows */
+    if ((size_t) recv_bytes > recv_buffer.size ()) {
+      recv_buffer.resize (recv_bytes);
     }
+    mpiret = sc_MPI_Recv (recv_buffer.data (), recv_bytes, sc_MPI_BYTE, recv_rank, T8_MPI_GHOST_FOREST, comm,
+                          sc_MPI_STATUS_IGNORE);
+    SC_CHECK_MPI (mpiret);
+    if (forest->profile != NULL) {
+      const double now = sc_MPI_Wtime ();
+      forest->profile->ghost_communicate_runtime += now;
+      forest->profile->ghost_unpack_runtime -= now;
+    }
+    t8_forest_ghost_parse_received_message (forest, ghost, &current_element_offset, recv_rank, recv_buffer.data (),
+                                            recv_bytes);
+    if (forest->profile != NULL) {
+      forest->profile->ghost_unpack_runtime += sc_MPI_Wtime ();
+    }
+  }
+}
 
-    /****     Actual communication    ****/
-
-    /* Until there is only one sender left we iprobe for a message for each
-     * sender and if there is one we receive it and remove the sender from the list.
-     * The last message can be received via probe */
-#ifdef T8_POLLING
-    while (received_messages < num_remotes - 1) {
-      /* TODO: This part of the code using polling and IProbe to receive the
-       *       messages. We replaced with a non-polling version that uses the
-       *       blocking Probe. */
-      iprobe_flag = 0;
-      prev = NULL; /* ensure that if the first receive entry is matched first,
-                                it is removed properly. */
-      for (proc_it = receivers->first; proc_it != NULL && iprobe_flag == 0;) {
-        /* pointer to the rank of a receiver */
-        recv_rank = ((t8_recv_list_entry_t *) proc_it->data)->rank;
-        proc_pos = ((t8_recv_list_entry_t *) proc_it->data)->pos_in_remote_processes;
-
-        mpiret = sc_MPI_Iprobe (recv_rank, T8_MPI_GHOST_FOREST, comm, &iprobe_flag, &status);
-        SC_CHECK_MPI (mpiret);
-#else
-    while (received_messages < num_remotes) {
-      /* blocking probe for a message. */
-      mpiret = sc_MPI_Probe (sc_MPI_ANY_SOURCE, T8_MPI_GHOST_FOREST, comm, &status);
-      SC_CHECK_MPI (mpiret);
-#endif
-#ifdef T8_POLLING
-        if (iprobe_flag == 0) {
-          /* There is no message to receive, we continue */
-          prev = proc_it;
-          proc_it = proc_it->next;
+/* Grow the ghost layer of a forest to forest->ghost_width layers of leaves.
+ * A leaf is in the halo of width k of a process q if it is not owned by q and there is a chain of
+ * at most k neighboring leaves from a leaf of q to it. We compute the halos on the owner side, starting
+ * with the remote leaves of the ghost layer of width 1. In each round we visit, for each process q,
+ * the local leaves that were added to the halo of q in the previous round. Their local neighbors are
+ * added to the halo of q directly, their ghost neighbors are sent to the owners of the ghosts which add
+ * them to the halo of q. All neighbors are computed with the ghost layer of width 1.
+ * Since the halo relation is symmetric, we receive ghosts from exactly the processes that we send to.
+ * At last, we rebuild the ghost structure with the leaves in the halos as remote leaves. */
+static void
+t8_forest_ghost_grow (t8_forest_t forest)
+{
+  t8_forest_ghost_t ghost = forest->ghosts;
+  t8_forest_ghost_corner_data_t data;
+  const t8_locidx_t num_local_elements = t8_forest_get_local_num_elements (forest);
+  const int num_remotes = ghost->remote_processes->elem_count;
+  /* For each remote process the local indices of our remote leaves in the order in which they were sent.
+   * The remote processes refer to our leaves by their position in this list. */
+  std::vector<std::vector<t8_locidx_t>> remote_leaves (num_remotes);
+  /* For each ghost the position of its owner in the remote processes and its position in the owner's list */
+  std::vector<int> ghost_owner (ghost->num_ghosts_elements);
+  std::vector<t8_locidx_t> ghost_position (ghost->num_ghosts_elements);
+  /* For each process the local leaves in its halo and the ones that were added in the last round */
+  std::map<int, std::set<t8_locidx_t>> halo;
+  std::map<int, std::vector<t8_locidx_t>> frontier;
+  /* The neighbors of each local leaf, computed when they are needed */
+  std::vector<std::vector<t8_locidx_t>> leaf_neighbors (num_local_elements);
+  std::vector<char> neighbors_computed (num_local_elements, 0);
+  int mpiret;
+
+  T8_ASSERT (forest->ghost_width > 1);
+  if (forest->ghost_type != T8_GHOST_FACES) {
+    t8_forest_ghost_corner_data_init (forest, &data);
+  }
+  /* The remote processes are sorted after receiving the ghosts */
+  for (int iremote = 0; iremote < num_remotes; iremote++) {
+    const int remote_rank = *(int *) sc_array_index_int (ghost->remote_processes, iremote);
+    t8_ghost_remote_t *remote_entry = t8_forest_ghost_get_remote (forest, remote_rank);
+    for (size_t itree = 0; itree < remote_entry->remote_trees.elem_count; itree++) {
+      t8_ghost_remote_tree_t *remote_tree
+        = (t8_ghost_remote_tree_t *) sc_array_index (&remote_entry->remote_trees, itree);
+      const t8_locidx_t ltreeid = t8_forest_get_local_id (forest, remote_tree->global_id);
+      const t8_locidx_t elements_offset = t8_forest_get_tree_element_offset (forest, ltreeid);
+      for (size_t ielement = 0; ielement < remote_tree->element_indices.elem_count; ielement++) {
+        remote_leaves[iremote].push_back (elements_offset
+                                          + *(t8_locidx_t *) sc_array_index (&remote_tree->element_indices, ielement));
+      }
+    }
+    halo[remote_rank].insert (remote_leaves[iremote].begin (), remote_leaves[iremote].end ());
+    frontier[remote_rank] = remote_leaves[iremote];
+    /* The ghosts of this process are stored consecutively and in the order of its remote leaves */
+    const t8_locidx_t ghost_offset = t8_forest_ghost_remote_first_elem (forest, remote_rank);
+    t8_locidx_t ghost_end = ghost->num_ghosts_elements;
+    if (iremote + 1 < num_remotes) {
+      const int next_rank = *(int *) sc_array_index_int (ghost->remote_processes, iremote + 1);
+      ghost_end = t8_forest_ghost_remote_first_elem (forest, next_rank);
+    }
+    for (t8_locidx_t ighost = ghost_offset; ighost < ghost_end; ighost++) {
+      ghost_owner[ighost] = iremote;
+      ghost_position[ighost] = ighost - ghost_offset;
+    }
+  }
+
+  for (int iround = 1; iround < forest->ghost_width; iround++) {
+    /* For each remote process the pairs (rank q, position) of its leaves that are in the halo of q */
+    std::vector<std::set<std::pair<t8_locidx_t, t8_locidx_t>>> send_pairs (num_remotes);
+    std::map<int, std::vector<t8_locidx_t>> new_frontier;
+
+    for (const auto &frontier_entry : frontier) {
+      const int halo_rank = frontier_entry.first;
+      std::set<t8_locidx_t> &halo_leaves = halo[halo_rank];
+      for (const t8_locidx_t ileaf : frontier_entry.second) {
+        if (!neighbors_computed[ileaf]) {
+          t8_locidx_t ltreeid;
+          const t8_element_t *leaf = t8_forest_get_element (forest, ileaf, &ltreeid);
+          t8_forest_ghost_leaf_neighbors (forest, &data, ltreeid, leaf, ileaf, leaf_neighbors[ileaf]);
+          neighbors_computed[ileaf] = 1;
         }
-        else {
-#else
-      /* There is a message to receive, we receive it. */
-      recv_rank = status.MPI_SOURCE;
-      /* Get the position of this rank in the remote processes array */
-      recv_list_entry.rank = recv_rank;
-#ifdef T8_ENABLE_DEBUG
-      ret =
-#else
-      (void)
-#endif
-        sc_hash_lookup (recv_list_entries_hash, &recv_list_entry, (void ***) &pfound);
-      T8_ASSERT (ret != 0);
-      found = *pfound;
-      proc_pos = found->pos_in_remote_processes;
-#endif
-          T8_ASSERT (status.MPI_TAG == T8_MPI_GHOST_FOREST);
-          buffer[proc_pos] = t8_forest_ghost_receive_message (recv_rank, comm, status, recv_bytes + proc_pos);
-          /* mark this entry as received. */
-          T8_ASSERT (received_flag[proc_pos] == 0);
-          received_flag[proc_pos] = 1;
-          received_messages++;
-          /* Parse all messages that we can parse now.
-           * We have to parse the messages in order of their rank. */
-          T8_ASSERT (last_rank_parsed < proc_pos);
-          /* For all ranks that we haven't parsed yet, but can be parsed in order */
-          for (parse_it = last_rank_parsed + 1; parse_it < num_remotes && received_flag[parse_it] == 1; parse_it++) {
-            recv_rank = *(int *) sc_array_index_int (ghost->remote_processes, parse_it);
-            t8_forest_ghost_parse_received_message (forest, ghost, &current_element_offset, recv_rank, buffer[parse_it],
-                                                    recv_bytes[parse_it]);
-            last_rank_parsed++;
+        for (const t8_locidx_t ineigh : leaf_neighbors[ileaf]) {
+          if (ineigh < num_local_elements) {
+            /* A local neighbor, we add it to the halo */
+            if (halo_leaves.insert (ineigh).second) {
+              new_frontier[halo_rank].push_back (ineigh);
+            }
+          }
+          else {
+            /* A ghost neighbor, its owner adds it to the halo unless it is owned by the halo's process */
+            const t8_locidx_t ighost = ineigh - num_local_elements;
+            const int iowner = ghost_owner[ighost];
+            if (*(int *) sc_array_index_int (ghost->remote_processes, iowner) != halo_rank) {
+              send_pairs[iowner].insert (std::make_pair (halo_rank, ghost_position[ighost]));
+            }
           }
-
-#ifdef T8_POLLING /* polling */
-          /* Remove the process from the list of receivers. */
-          proc_it = proc_it->next;
-          sc_list_remove (receivers, prev);
         }
-      } /* end for */
-#endif
-    } /* end while */
-
-#ifdef T8_POLLING
-    /* polling */
-    T8_ASSERT (receivers->elem_count == 1);
-    /* Get the last rank from which we didnt receive yet */
-    recv_list_entry = *(t8_recv_list_entry_t *) sc_list_pop (receivers);
-    recv_rank = recv_list_entry.rank;
-    proc_pos = recv_list_entry.pos_in_remote_processes;
-    /* destroy the list */
-    sc_list_destroy (receivers);
-    /* Blocking probe for the last message */
-    mpiret = sc_MPI_Probe (recv_rank, T8_MPI_GHOST_FOREST, comm, &status);
-    SC_CHECK_MPI (mpiret);
-    /* Receive the message */
-    T8_ASSERT (received_flag[proc_pos] == 0);
-    buffer[proc_pos] = t8_forest_ghost_receive_message (recv_rank, comm, status, recv_bytes + proc_pos);
-    received_flag[proc_pos] = 1;
-    received_messages++;
-    T8_ASSERT (received_messages == num_remotes);
-    /* parse all messages that are left */
-    /* For all ranks that we haven't parsed yet, but can be parsed in order */
-    for (parse_it = last_rank_parsed + 1; parse_it < num_remotes && received_flag[parse_it] == 1; parse_it++) {
-      recv_rank = *(int *) sc_array_index_int (ghost->remote_processes, parse_it);
-      t8_forest_ghost_parse_received_message (forest, ghost, &current_element_offset, recv_rank, buffer[parse_it],
-                                              recv_bytes[parse_it]);
-      last_rank_parsed++;
+      }
     }
-#endif
-#ifdef T8_ENABLE_DEBUG
-    for (parse_it = 0; parse_it < num_remotes; parse_it++) {
-      T8_ASSERT (received_flag[parse_it] == 1);
+
+    /* Send the pairs to the owners of the ghosts */
+    std::vector<std::vector<t8_locidx_t>> send_buffers (num_remotes);
+    std::vector<sc_MPI_Request> requests (num_remotes);
+    for (int iremote = 0; iremote < num_remotes; iremote++) {
+      const int remote_rank = *(int *) sc_array_index_int (ghost->remote_processes, iremote);
+      for (const auto &pair : send_pairs[iremote]) {
+        send_buffers[iremote].push_back (pair.first);
+        send_buffers[iremote].push_back (pair.second);
+      }
+      mpiret = sc_MPI_Isend (send_buffers[iremote].data (), (int) send_buffers[iremote].size (), T8_MPI_LOCIDX,
+                             remote_rank, T8_MPI_GHOST_HALO, forest->mpicomm, &requests[iremote]);
+      SC_CHECK_MPI (mpiret);
     }
-#endif
-    T8_ASSERT (last_rank_parsed == num_remotes - 1);
+    /* Receive the pairs for our leaves and add the leaves to the halos.
+     * We handle the messages in order of their arrival. Since each process sends exactly one message
+     * per round, we only probe the processes that we did not receive from in this round. A fast process
+     * may already have sent its message of the next round, thus we do not probe for any source. */
+    std::vector<int> pending (num_remotes);
+    for (int iremote = 0; iremote < num_remotes; iremote++) {
+      pending[iremote] = iremote;
+    }
+    while (!pending.empty ()) {
+      sc_MPI_Status status;
+      int count, iprobe_flag = 0;
+      size_t ipending;
+
+      for (ipending = 0; ipending < pending.size (); ipending++) {
+        mpiret = sc_MPI_Iprobe (*(int *) sc_array_index_int (ghost->remote_processes, pending[ipending]),
+                                T8_MPI_GHOST_HALO, forest->mpicomm, &iprobe_flag, &status);
+        SC_CHECK_MPI (mpiret);
+        if (iprobe_flag) {
+          break;
+        }
+      }
+      if (!iprobe_flag) {
+        /* No message arrived yet, we probe again */
+        continue;
+      }
+      const int iremote = pending[ipending];
+      const int remote_rank = *(int *) sc_array_index_int (ghost->remote_processes, iremote);
+      pending.erase (pending.begin () + ipending);
+      mpiret = sc_MPI_Get_count (&status, T8_MPI_LOCIDX, &count);
+      SC_CHECK_MPI (mpiret);
+      std::vector<t8_locidx_t> recv_buffer (count);
+      mpiret = sc_MPI_Recv (recv_buffer.data (), count, T8_MPI_LOCIDX, remote_rank, T8_MPI_GHOST_HALO, forest->mpicomm,
+                            sc_MPI_STATUS_IGNORE);
+      SC_CHECK_MPI (mpiret);
+      T8_ASSERT (count % 2 == 0);
+      for (int ipair = 0; ipair < count; ipair += 2) {
+        const int halo_rank = recv_buffer[ipair];
+        T8_ASSERT (0 <= recv_buffer[ipair + 1] && (size_t) recv_buffer[ipair + 1] < remote_leaves[iremote].size ());
+        const t8_locidx_t ileaf = remote_leaves[iremote][recv_buffer[ipair + 1]];
+        if (halo_rank != forest->mpirank && halo[halo_rank].insert (ileaf).second) {
+          new_frontier[halo_rank].push_back (ileaf);
+        }
+      }
+    }
+    mpiret = sc_MPI_Waitall (num_remotes, requests.data (), sc_MPI_STATUSES_IGNORE);
+    SC_CHECK_MPI (mpiret);
+    frontier = std::move (new_frontier);
+  }
+  if (forest->ghost_type != T8_GHOST_FACES) {
+    t8_forest_ghost_corner_data_reset (&data);
+  }
 
-    /* clean-up */
-#ifndef T8_POLLING
-    sc_hash_destroy (recv_list_entries_hash);
-#endif
-    T8_FREE (buffer);
-    T8_FREE (received_flag);
-    T8_FREE (recv_list_entries);
-    T8_FREE (recv_bytes);
+  /* Rebuild the ghost structure with the halos as remote leaves. We add the leaves in SFC order. */
+  t8_forest_ghost_unref (&forest->ghosts);
+  t8_forest_ghost_init (&forest->ghosts, forest->ghost_type);
+  for (const auto &halo_entry : halo) {
+    for (const t8_locidx_t ileaf : halo_entry.second) {
+      t8_locidx_t ltreeid;
+      const t8_element_t *leaf = t8_forest_get_element (forest, ileaf, &ltreeid);
+      t8_ghost_add_remote (forest, forest->ghosts, halo_entry.first, ltreeid, leaf,
+                           ileaf - t8_forest_get_tree_element_offset (forest, ltreeid));
+    }
   }
 }
 
@@ -1386,6 +1882,8 @@ t8_forest_ghost_receive (t8_forest_t forest, t8_forest_ghost_t ghost)
  *
  * version 3 with top-down search
  * for unbalanced_version = -1
+ * If the ghost width of the forest is larger than 1, the layer is grown afterwards,
+ * see t8_forest_ghost_grow.
  */
 void
 t8_forest_ghost_create_ext (t8_forest_t forest, int unbalanced_version)
@@ -1411,6 +1909,11 @@ t8_forest_ghost_create_ext (t8_forest_t forest, int unbalanced_version)
   if (forest->profile != NULL) {
     /* If profiling is enabled, we measure the runtime of ghost_create */
     forest->profile->ghost_runtime = -sc_MPI_Wtime ();
+    /* We also measure the phases of ghost_create, which are accumulated over all rounds */
+    forest->profile->ghost_search_runtime = 0;
+    forest->profile->ghost_pack_runtime = 0;
+    forest->profile->ghost_communicate_runtime = 0;
+    forest->profile->ghost_unpack_runtime = 0;
     /* DO NOT DELETE THE FOLLOWING line.
      * even if you do not want this output. It fixes a bug that occurred on JUQUEEN, where the
      * runtimes were computed to 0.
@@ -1440,20 +1943,28 @@ t8_forest_ghost_create_ext (t8_forest_t forest, int unbalanced_version)
                  "Ghost layer is not constructed.\n");
       return;
     }
-    /* Currently we only support face ghosts */
-    T8_ASSERT (forest->ghost_type == T8_GHOST_FACES);
 
     /* Initialize the ghost structure */
     t8_forest_ghost_init (&forest->ghosts, forest->ghost_type);
     ghost = forest->ghosts;
 
-    if (unbalanced_version == -1) {
+    if (forest->profile != NULL) {
+      forest->profile->ghost_search_runtime -= sc_MPI_Wtime ();
+    }
+    if (forest->ghost_type != T8_GHOST_FACES) {
+      /* Edge and vertex ghosts are always computed with a top-down search */
+      t8_forest_ghost_fill_remote_corners (forest);
+    }
+    else if (unbalanced_version == -1) {
       t8_forest_ghost_fill_remote_v3 (forest);
     }
     else {
       /* Construct the remote elements and processes. */
       t8_forest_ghost_fill_remote (forest, ghost, unbalanced_version != 0);
     }
+    if (forest->profile != NULL) {
+      forest->profile->ghost_search_runtime += sc_MPI_Wtime ();
+    }
 
     /* Start sending the remote elements */
     send_info = t8_forest_ghost_send_start (forest, ghost, &requests);
@@ -1463,6 +1974,21 @@ t8_forest_ghost_create_ext (t8_forest_t forest, int unbalanced_version)
 
     /* End sending the remote elements */
     t8_forest_ghost_send_end (forest, ghost, send_info, requests);
+
+    if (forest->ghost_width > 1) {
+      /* Grow the ghost layer and send the remote elements of the wider layer */
+      if (forest->profile != NULL) {
+        forest->profile->ghost_search_runtime -= sc_MPI_Wtime ();
+      }
+      t8_forest_ghost_grow (forest);
+      if (forest->profile != NULL) {
+        forest->profile->ghost_search_runtime += sc_MPI_Wtime ();
+      }
+      ghost = forest->ghosts;
+      send_info = t8_forest_ghost_send_start (forest, ghost, &requests);
+      t8_forest_ghost_receive (forest, ghost);
+      t8_forest_ghost_send_end (forest, ghost, send_info, requests);
+    }
   }
 
   if (create_element_array) {
@@ -1588,188 +2114,273 @@ t8_forest_ghost_remote_first_elem (t8_forest_t forest, int remote)
   return proc_entry->ghost_offset;
 }
 
-/* Fill the send buffer for a ghost data exchange for on remote rank.
- * returns the number of bytes in the buffer. */
-static size_t
-t8_forest_ghost_exchange_fill_send_buffer (t8_forest_t forest, int remote, char **pbuffer, sc_array_t *element_data)
+/* Build the communication pattern for ghost data exchanges of a forest.
+ * For each remote process we store the local element indices of the elements that
+ * are ghosts of this process and the position of its ghosts in the element data.
+ * The plan is stored at the forest's ghost structure. */
+static void
+t8_forest_ghost_exchange_plan_create (t8_forest_t forest)
 {
-  char *buffer;
-  t8_ghost_remote_t lookup_rank, *remote_entry;
-  t8_ghost_remote_tree_t *remote_tree;
   t8_forest_ghost_t ghost;
-  size_t index, element_index, data_size;
-  size_t elements_inserted, byte_count;
-  t8_tree_t local_tree;
-#ifdef T8_ENABLE_DEBUG
-  int ret;
-#endif
-  t8_locidx_t itree, ielement, element_pos;
-  t8_locidx_t ltreeid;
-  size_t elem_count;
+  t8_ghost_exchange_plan_t plan;
+  t8_ghost_remote_t *remote_entry;
+  t8_ghost_remote_tree_t *remote_tree;
+  t8_locidx_t ghost_start, elements_offset, ltreeid, isend;
+  size_t itree, ielement, elem_count;
+  int iremote, remote_rank;
 
+  T8_ASSERT (t8_forest_is_committed (forest));
   ghost = forest->ghosts;
-  data_size = element_data->elem_size;
-  elements_inserted = 0;
-  lookup_rank.remote_rank = remote;
+  T8_ASSERT (ghost != NULL);
+  T8_ASSERT (ghost->exchange_plan == NULL);
 
-  /* Lookup the remote entry of this remote process */
-#ifdef T8_ENABLE_DEBUG
-  ret =
+  plan = ghost->exchange_plan = T8_ALLOC_ZERO (struct t8_ghost_exchange_plan, 1);
+  plan->mpicomm = forest->mpicomm;
+  plan->num_remotes = ghost->remote_processes->elem_count;
+  plan->remote_ranks = T8_ALLOC (int, plan->num_remotes);
+  plan->send_offsets = T8_ALLOC (t8_locidx_t, plan->num_remotes + 1);
+  plan->recv_offsets = T8_ALLOC (t8_locidx_t, plan->num_remotes + 1);
+  plan->send_indices = T8_ALLOC (t8_locidx_t, ghost->num_remote_elements);
+
+  /* The index in the element data at which the ghost elements start */
+  ghost_start = t8_forest_get_local_num_elements (forest);
+  isend = 0;
+  for (iremote = 0; iremote < plan->num_remotes; iremote++) {
+    remote_rank = *(int *) sc_array_index_int (ghost->remote_processes, iremote);
+    plan->remote_ranks[iremote] = remote_rank;
+    plan->send_offsets[iremote] = isend;
+    /* We iterate over the remote trees and their elements to find the
+     * local element indices of the remote elements */
+    remote_entry = t8_forest_ghost_get_remote (forest, remote_rank);
+    for (itree = 0; itree < remote_entry->remote_trees.elem_count; itree++) {
+      remote_tree = (t8_ghost_remote_tree_t *) sc_array_index (&remote_entry->remote_trees, itree);
+      ltreeid = t8_forest_get_local_id (forest, remote_tree->global_id);
+      elements_offset = t8_forest_get_tree_element_offset (forest, ltreeid);
+      elem_count = t8_element_array_get_count (&remote_tree->elements);
+      for (ielement = 0; ielement < elem_count; ielement++) {
+        T8_ASSERT (isend < ghost->num_remote_elements);
+        plan->send_indices[isend++]
+          = elements_offset + *(t8_locidx_t *) sc_array_index (&remote_tree->element_indices, ielement);
+      }
+    }
+    /* The ghosts of the remote are stored at position ghost_start + offset in the element data */
+    plan->recv_offsets[iremote] = ghost_start + t8_forest_ghost_remote_first_elem (forest, remote_rank);
+    T8_ASSERT (iremote == 0 || plan->recv_offsets[iremote - 1] <= plan->recv_offsets[iremote]);
+  }
+  T8_ASSERT (isend == ghost->num_remote_elements);
+  plan->send_offsets[plan->num_remotes] = isend;
+  plan->recv_offsets[plan->num_remotes] = ghost_start + ghost->num_ghosts_elements;
+}
+
+/* Allocate a new exchange for an element data array and initialize the
+ * persistent send and receive requests for it. */
+static t8_forest_ghost_exchange_t
+t8_forest_ghost_exchange_new (t8_ghost_exchange_plan_t plan, const sc_array_t *element_data)
+{
+  t8_forest_ghost_exchange_t exchange;
+#if T8_ENABLE_MPI
+  int iremote, mpiret;
+  int bytes_send, bytes_recv;
+#endif
+
+  exchange = T8_ALLOC_ZERO (struct t8_forest_ghost_exchange, 1);
+  exchange->plan = plan;
+  exchange->data = element_data->array;
+  exchange->data_size = element_data->elem_size;
+  exchange->send_buffer = T8_ALLOC (char, exchange->data_size * plan->send_offsets[plan->num_remotes]);
+  exchange->send_requests = T8_ALLOC (sc_MPI_Request, plan->num_remotes);
+  exchange->recv_requests = T8_ALLOC (sc_MPI_Request, plan->num_remotes);
+
+#if T8_ENABLE_MPI
+  for (iremote = 0; iremote < plan->num_remotes; iremote++) {
+    /* The remote's part of the send buffer */
+    bytes_send = (plan->send_offsets[iremote + 1] - plan->send_offsets[iremote]) * exchange->data_size;
+    mpiret = MPI_Send_init (exchange->send_buffer + plan->send_offsets[iremote] * exchange->data_size, bytes_send,
+                            sc_MPI_BYTE, plan->remote_ranks[iremote], T8_MPI_GHOST_EXC_FOREST, plan->mpicomm,
+                            exchange->send_requests + iremote);
+    SC_CHECK_MPI (mpiret);
+    /* We receive directly into the ghost entries of the element data */
+    bytes_recv = (plan->recv_offsets[iremote + 1] - plan->recv_offsets[iremote]) * exchange->data_size;
+    mpiret = MPI_Recv_init ((char *) exchange->data + plan->recv_offsets[iremote] * exchange->data_size, bytes_recv,
+                            sc_MPI_BYTE, plan->remote_ranks[iremote], T8_MPI_GHOST_EXC_FOREST, plan->mpicomm,
+                            exchange->recv_requests + iremote);
+    SC_CHECK_MPI (mpiret);
+  }
 #else
-  (void)
+  /* Without MPI there is only one process and thus no remote. */
+  T8_ASSERT (plan->num_remotes == 0);
+#endif
+  return exchange;
+}
+
+/* Free the persistent requests and the send buffer of an exchange. */
+static void
+t8_forest_ghost_exchange_destroy (t8_forest_ghost_exchange_t *pexchange)
+{
+  t8_forest_ghost_exchange_t exchange;
+#if T8_ENABLE_MPI
+  int iremote, mpiret;
+#endif
+
+  T8_ASSERT (pexchange != NULL);
+  exchange = *pexchange;
+  T8_ASSERT (exchange != NULL);
+  SC_CHECK_ABORT (exchange->element_data == NULL, "Trying to destroy a running ghost data exchange.\n");
+
+#if T8_ENABLE_MPI
+  for (iremote = 0; iremote < exchange->plan->num_remotes; iremote++) {
+    mpiret = MPI_Request_free (exchange->send_requests + iremote);
+    SC_CHECK_MPI (mpiret);
+    mpiret = MPI_Request_free (exchange->recv_requests + iremote);
+    SC_CHECK_MPI (mpiret);
+  }
 #endif
-    sc_hash_array_lookup (ghost->remote_ghosts, &lookup_rank, &index);
-  T8_ASSERT (ret != 0);
-  remote_entry = (t8_ghost_remote_t *) sc_array_index (&ghost->remote_ghosts->a, index);
-  T8_ASSERT (remote_entry->remote_rank == remote);
-
-  /* allocate memory for the send buffer */
-  byte_count = data_size * remote_entry->num_elements;
-  buffer = *pbuffer = T8_ALLOC (char, byte_count);
-
-  /* We now iterate over the remote trees and their elements to find the
-   * local element indices of the remote elements */
-  for (itree = 0; itree < (t8_locidx_t) remote_entry->remote_trees.elem_count; itree++) {
-    /* tree loop */
-    remote_tree = (t8_ghost_remote_tree_t *) t8_sc_array_index_locidx (&remote_entry->remote_trees, itree);
-    /* Get the local id of this tree */
-    /* TODO: Why does remote_tree store the global id? could be local instead */
-    ltreeid = t8_forest_get_local_id (forest, remote_tree->global_id);
-    /* Get a pointer to the forest tree */
-    local_tree = t8_forest_get_tree (forest, ltreeid);
-    elem_count = t8_element_array_get_count (&remote_tree->elements);
-    for (ielement = 0; ielement < (t8_locidx_t) elem_count; ielement++) {
-      /* element loop */
-      /* Get the index of this remote element in its local tree */
-      element_pos = *(t8_locidx_t *) t8_sc_array_index_locidx (&remote_tree->element_indices, ielement);
-      T8_ASSERT (0 <= element_pos);
-      /* Compute the index of this element in the element_data array */
-      element_index = local_tree->elements_offset + element_pos;
-      /* Copy the data of this element from the element_data array to the send buffer */
-      memcpy (buffer + elements_inserted * data_size, sc_array_index (element_data, element_index), data_size);
-      elements_inserted++;
+  T8_FREE (exchange->send_buffer);
+  T8_FREE (exchange->send_requests);
+  T8_FREE (exchange->recv_requests);
+  T8_FREE (exchange);
+  *pexchange = NULL;
+}
+
+/* Destroy an exchange plan together with all of its exchanges. */
+static void
+t8_forest_ghost_exchange_plan_destroy (t8_ghost_exchange_plan_t *pplan)
+{
+  t8_ghost_exchange_plan_t plan;
+  int iexchange;
+
+  T8_ASSERT (pplan != NULL);
+  plan = *pplan;
+  T8_ASSERT (plan != NULL);
+
+  for (iexchange = 0; iexchange < T8_GHOST_EXCHANGE_MAX_CHANNELS; iexchange++) {
+    if (plan->exchanges[iexchange] != NULL) {
+      t8_forest_ghost_exchange_destroy (plan->exchanges + iexchange);
     }
   }
-  return byte_count;
+  T8_FREE (plan->remote_ranks);
+  T8_FREE (plan->send_offsets);
+  T8_FREE (plan->recv_offsets);
+  T8_FREE (plan->send_indices);
+  T8_FREE (plan);
+  *pplan = NULL;
 }
 
-static t8_ghost_data_exchange_t *
+/* Return the exchange that is bound to an element data array.
+ * If there is none, a new one is created. If all slots are occupied, we recycle
+ * the least recently used exchange that is currently not running. */
+static t8_forest_ghost_exchange_t
+t8_forest_ghost_exchange_get (t8_ghost_exchange_plan_t plan, const sc_array_t *element_data)
+{
+  t8_forest_ghost_exchange_t exchange;
+  int iexchange, free_slot = -1, recycle_slot = -1;
+
+  for (iexchange = 0; iexchange < T8_GHOST_EXCHANGE_MAX_CHANNELS; iexchange++) {
+    exchange = plan->exchanges[iexchange];
+    if (exchange == NULL) {
+      if (free_slot < 0) {
+        free_slot = iexchange;
+      }
+      continue;
+    }
+    if (exchange->data == element_data->array && exchange->data_size == element_data->elem_size) {
+      /* We found the exchange for this data array */
+      SC_CHECK_ABORT (exchange->element_data == NULL, "A ghost data exchange of this element data is already running.\n");
+      return exchange;
+    }
+    if (exchange->element_data == NULL
+        && (recycle_slot < 0 || exchange->last_used < plan->exchanges[recycle_slot]->last_used)) {
+      recycle_slot = iexchange;
+    }
+  }
+  if (free_slot < 0) {
+    SC_CHECK_ABORT (recycle_slot >= 0, "Too many ghost data exchanges running at the same time.\n");
+    t8_forest_ghost_exchange_destroy (plan->exchanges + recycle_slot);
+    free_slot = recycle_slot;
+  }
+  plan->exchanges[free_slot] = t8_forest_ghost_exchange_new (plan, element_data);
+  return plan->exchanges[free_slot];
+}
+
+t8_forest_ghost_exchange_t
 t8_forest_ghost_exchange_begin (t8_forest_t forest, sc_array_t *element_data)
 {
-  t8_ghost_data_exchange_t *data_exchange;
-  t8_forest_ghost_t ghost;
-  size_t bytes_to_send, ghost_start;
-  int iremote, remote_rank;
-  int mpiret, recv_rank, bytes_recv;
-#ifdef T8_ENABLE_DEBUG
-  int ret;
+  t8_ghost_exchange_plan_t plan;
+  t8_forest_ghost_exchange_t exchange;
+  t8_locidx_t isend;
+  size_t data_size;
+  char *send_pos;
+  int iremote;
+#if T8_ENABLE_MPI
+  int mpiret;
 #endif
-  char **send_buffers;
-  t8_ghost_process_hash_t lookup_proc, *process_entry, **pfound;
-  t8_locidx_t remote_offset, next_offset;
 
   T8_ASSERT (t8_forest_is_committed (forest));
   T8_ASSERT (element_data != NULL);
-  T8_ASSERT (forest->ghosts != NULL);
-
-  ghost = forest->ghosts;
 
-  /* Allocate the new exchange context */
-  data_exchange = T8_ALLOC (t8_ghost_data_exchange_t, 1);
-  /* The number of processes we need to send to */
-  data_exchange->num_remotes = ghost->remote_processes->elem_count;
-  /* Allocate MPI requests */
-  data_exchange->send_requests = T8_ALLOC (sc_MPI_Request, data_exchange->num_remotes);
-  data_exchange->recv_requests = T8_ALLOC (sc_MPI_Request, data_exchange->num_remotes);
-  /* Allocate pointers to send buffers */
-  send_buffers = data_exchange->send_buffers = T8_ALLOC (char *, data_exchange->num_remotes);
-
-  for (iremote = 0; iremote < data_exchange->num_remotes; iremote++) {
-    /* Iterate over all remote processes and fill their send buffers */
-    remote_rank = *(int *) sc_array_index_int (ghost->remote_processes, iremote);
-    /* Fill the send buffers and compute the number of bytes to send */
-    bytes_to_send
-      = t8_forest_ghost_exchange_fill_send_buffer (forest, remote_rank, send_buffers + iremote, element_data);
+  if (forest->ghosts == NULL) {
+    /* This process has no ghosts */
+    return NULL;
+  }
+  T8_ASSERT ((t8_locidx_t) element_data->elem_count
+             == t8_forest_get_local_num_elements (forest) + t8_forest_get_num_ghosts (forest));
 
-    /* Post the asynchronuos send */
-    mpiret = sc_MPI_Isend (send_buffers[iremote], bytes_to_send, sc_MPI_BYTE, remote_rank, T8_MPI_GHOST_EXC_FOREST,
-                           forest->mpicomm, data_exchange->send_requests + iremote);
+  if (forest->ghosts->exchange_plan == NULL) {
+    /* This is the first exchange on this ghost layer */
+    t8_forest_ghost_exchange_plan_create (forest);
+  }
+  plan = forest->ghosts->exchange_plan;
+  exchange = t8_forest_ghost_exchange_get (plan, element_data);
+  exchange->element_data = element_data;
+  exchange->last_used = ++plan->use_count;
+  data_size = exchange->data_size;
+
+#if T8_ENABLE_MPI
+  /* Post all receives before we start sending */
+  if (plan->num_remotes > 0) {
+    mpiret = MPI_Startall (plan->num_remotes, exchange->recv_requests);
     SC_CHECK_MPI (mpiret);
   }
-
-  /* The index in element_data at which the ghost elements start */
-  ghost_start = t8_forest_get_local_num_elements (forest);
-  /* Receive the incoming messages */
-  for (iremote = 0; iremote < data_exchange->num_remotes; iremote++) {
-    /* We need to compute the offset in element_data to which we can receive the message */
-    /* Search for this processes' entry in the ghost struct */
-    recv_rank = *(int *) sc_array_index_int (ghost->remote_processes, iremote);
-    lookup_proc.mpirank = recv_rank;
-#ifdef T8_ENABLE_DEBUG
-    ret =
-#else
-    (void)
-#endif
-      sc_hash_lookup (ghost->process_offsets, &lookup_proc, (void ***) &pfound);
-    T8_ASSERT (ret);
-    process_entry = *pfound;
-    /* In process_entry we stored the offset of this ranks ghosts under all
-     * ghosts. Thus in element_data we look at the position
-     *  ghost_start + offset
-     */
-    remote_offset = process_entry->ghost_offset;
-    /* Compute the offset of the next remote rank */
-    if (iremote + 1 < data_exchange->num_remotes) {
-      lookup_proc.mpirank = *(int *) sc_array_index_int (ghost->remote_processes, iremote + 1);
-#ifdef T8_ENABLE_DEBUG
-      ret =
-#else
-      (void)
 #endif
-        sc_hash_lookup (ghost->process_offsets, &lookup_proc, (void ***) &pfound);
-      T8_ASSERT (ret);
-      process_entry = *pfound;
-      next_offset = process_entry->ghost_offset;
-    }
-    else {
-      /* We are the last rank, the next offset is the total number of ghosts */
-      next_offset = ghost->num_ghosts_elements;
+  for (iremote = 0; iremote < plan->num_remotes; iremote++) {
+    /* Copy the data of this remote's elements to its part of the send buffer */
+    send_pos = exchange->send_buffer + plan->send_offsets[iremote] * data_size;
+    for (isend = plan->send_offsets[iremote]; isend < plan->send_offsets[iremote + 1]; isend++) {
+      memcpy (send_pos, sc_array_index (element_data, plan->send_indices[isend]), data_size);
+      send_pos += data_size;
     }
-    /* Calculate the number of bytes to receive */
-    bytes_recv = (next_offset - remote_offset) * element_data->elem_size;
-    /* receive the message */
-    mpiret = sc_MPI_Irecv (sc_array_index (element_data, ghost_start + remote_offset), bytes_recv, sc_MPI_BYTE,
-                           recv_rank, T8_MPI_GHOST_EXC_FOREST, forest->mpicomm, data_exchange->recv_requests + iremote);
+#if T8_ENABLE_MPI
+    /* Start sending to this remote while we fill the buffers of the others */
+    mpiret = MPI_Start (exchange->send_requests + iremote);
     SC_CHECK_MPI (mpiret);
+#endif
   }
-  return data_exchange;
+  return exchange;
 }
 
-static void
-t8_forest_ghost_exchange_end (t8_ghost_data_exchange_t *data_exchange)
+void
+t8_forest_ghost_exchange_end (t8_forest_ghost_exchange_t exchange)
 {
-  int iproc;
+  int mpiret;
 
-  T8_ASSERT (data_exchange != NULL);
+  if (exchange == NULL) {
+    /* This process has no ghosts */
+    return;
+  }
+  T8_ASSERT (exchange->element_data != NULL);
   /* Wait for all communications to end */
-  sc_MPI_Waitall (data_exchange->num_remotes, data_exchange->recv_requests, sc_MPI_STATUSES_IGNORE);
-  sc_MPI_Waitall (data_exchange->num_remotes, data_exchange->send_requests, sc_MPI_STATUSES_IGNORE);
-
-  /* Free the send buffers */
-  for (iproc = 0; iproc < data_exchange->num_remotes; iproc++) {
-    T8_FREE (data_exchange->send_buffers[iproc]);
-  }
-  T8_FREE (data_exchange->send_buffers);
-  /* free requests */
-  T8_FREE (data_exchange->send_requests);
-  T8_FREE (data_exchange->recv_requests);
-  T8_FREE (data_exchange);
+  mpiret = sc_MPI_Waitall (exchange->plan->num_remotes, exchange->recv_requests, sc_MPI_STATUSES_IGNORE);
+  SC_CHECK_MPI (mpiret);
+  mpiret = sc_MPI_Waitall (exchange->plan->num_remotes, exchange->send_requests, sc_MPI_STATUSES_IGNORE);
+  SC_CHECK_MPI (mpiret);
+  /* The persistent requests are now inactive and can be started again */
+  exchange->element_data = NULL;
 }
 
 void
 t8_forest_ghost_exchange_data (t8_forest_t forest, sc_array_t *element_data)
 {
-  t8_ghost_data_exchange_t *data_exchange;
+  t8_forest_ghost_exchange_t data_exchange;
 
   t8_debugf ("Entering ghost_exchange_data\n");
   T8_ASSERT (t8_forest_is_committed (forest));
@@ -1900,6 +2511,11 @@ t8_forest_ghost_reset (t8_forest_ghost_t *pghost)
   sc_mempool_destroy (ghost->glo_tree_mempool);
   sc_mempool_destroy (ghost->proc_offset_mempool);
 
+  /* Free the persistent communication of ghost data exchanges */
+  if (ghost->exchange_plan != NULL) {
+    t8_forest_ghost_exchange_plan_destroy (&ghost->exchange_plan);
+  }
+
   /* Free the ghost */
   T8_FREE (ghost);
   pghost = NULL;
@@ -32,19 +32,56 @@
 #include <t8_vtk.h>
 T8_EXTERN_C_BEGIN ();
 
-/* TODO: implement */
+/** Save a forest to a checkpoint file from which it can be restored with
+ * \ref t8_forest_set_load. The file stores the linear id and level of each element,
+ * the tree offsets and classes, and the partition of the forest. It does not
+ * depend on the number of processes, so the forest can be loaded on any number of processes.
+ * All processes write their elements in parallel, using collective MPI-IO if available.
+ * Forests with removed elements are not supported.
+ * This function is collective and must be called on each process.
+ * \param [in]      forest      The committed forest to save.
+ * \param [in]      filename    The name of the checkpoint file. An existing file is overwritten.
+ * \note Previously this function was declared as t8_forest_save (forest) without a file name
+ *       and without an implementation. Callers of that declaration must pass a file name now.
+ */
+void
+t8_forest_save (t8_forest_t forest, const char *filename);
+
+/** Save a forest together with per-element user data to a checkpoint file.
+ * See \ref t8_forest_save for the standard version of this function.
+ * The data can be restored with \ref t8_forest_load_element_data.
+ * \param [in]      forest       The committed forest to save.
+ * \param [in]      filename     The name of the checkpoint file. An existing file is overwritten.
+ * \param [in]      element_data If not NULL, an array with one entry per local element of \a forest.
+ *                               Its element size is stored in the file. Must be NULL on all
+ *                               processes or on none.
+ */
+void
+t8_forest_save_ext (t8_forest_t forest, const char *filename, const sc_array_t *element_data);
+
+/** Read the per-element user data of a checkpoint file for the local elements of a forest.
+ * The forest must have been loaded from the same file with \ref t8_forest_set_load and
+ * not been modified since. Each process reads only the data of its own elements.
+ * This function is collective and must be called on each process.
+ * \param [in]      forest       The committed forest.
+ * \param [in]      filename     The checkpoint file written with \ref t8_forest_save_ext.
+ * \param [in,out]  element_data An array whose element size must match the size stored in the file.
+ *                               On output it is resized to the local number of elements and
+ *                               filled with their data.
+ */
 void
-t8_forest_save (t8_forest_t forest);
+t8_forest_load_element_data (t8_forest_t forest, const char *filename, sc_array_t *element_data);
 
 /** Write the forest in a parallel vtu format. Extended version.
  * See \ref t8_forest_write_vtk for the standard version of this function.
  * Writes one master .pvtu file and each process writes in its own .vtu file.
  * If linked and not otherwise specified, the VTK API is used.
- * If the VTK library is not linked, an ASCII file is written.
+ * If the VTK library is not linked, a file with raw binary data arrays is written.
+ * Each corner of each element is written as a separate point, unless \a deduplicate_points is set.
  * This may change in accordance with \a write_ghosts, \a write_curved and 
  * \a do_not_use_API, because the export of ghosts is not yet available with 
  * the VTK API and the export of curved elements is not available with the
- * inbuilt function to write ASCII files. The function will for example
+ * inbuilt function to write files. The function will for example
  * still use the VTK API to satisfy \a write_curved, even if \a do_not_use_API 
  * is set to true.
  * Forest must be committed when calling this function.
@@ -62,6 +99,10 @@ t8_forest_save (t8_forest_t forest);
  *                                      For ghost element the treeid is -1.
  * \param [in]      write_curved        If true, write the elements as curved element types from vtk.
  * \param [in]      do_not_use_API      Do not use the VTK API, even if linked and available.
+ * \param [in]      deduplicate_points  If true, the corners that are shared by several local elements
+ *                                      are written as one point. The point data at such a point is the
+ *                                      average over its elements. Only available without the VTK API,
+ *                                      see \ref t8_forest_vtk_write_file_binary.
  * \param [in]      num_data            Number of user defined double valued data fields to write.
  * \param [in]      data                Array of t8_vtk_data_field_t of length \a num_data
  *                                      providing the user defined per element data.
@@ -73,12 +114,13 @@ t8_forest_save (t8_forest_t forest);
 int
 t8_forest_write_vtk_ext (t8_forest_t forest, const char *fileprefix, const int write_treeid, const int write_mpirank,
                          const int write_level, const int write_element_id, const int write_ghosts,
-                         const int write_curved, int do_not_use_API, const int num_data, t8_vtk_data_field_t *data);
+                         const int write_curved, int do_not_use_API, const int deduplicate_points, const int num_data,
+                         t8_vtk_data_field_t *data);
 
 /** Write the forest in a parallel vtu format. Writes one master
  * .pvtu file and each process writes in its own .vtu file.
  * If linked, the VTK API is used.
- * If the VTK library is not linked, an ASCII file is written.
+ * If the VTK library is not linked, a file with raw binary data arrays is written.
  * This function writes the forest elements, the tree id, element level, mpirank and element id as data.
  * Forest must be committed when calling this function.
  * This function is collective and must be called on each process.
@@ -24,6 +24,9 @@
 #include <t8_forest/t8_forest_types.h>
 #include <t8_forest/t8_forest_general.h>
 #include <t8_element_cxx.hxx>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 /* We want to export the whole implementation to be callable from "C" */
 T8_EXTERN_C_BEGIN ();
@@ -156,6 +159,62 @@ t8_forest_iterate_faces (t8_forest_t forest, t8_locidx_t ltreeid, const t8_eleme
   }
 }
 
+/* The memory that the search uses for the children of an element at one refinement level.
+ * The memory is kept for the next element of the same level, so that after the first
+ * elements of each level no memory is allocated anymore. */
+struct t8_forest_search_level
+{
+  const t8_eclass_scheme_c *ts;         /* The scheme for which the children are initialized. */
+  std::vector<char> children_memory;    /* The memory of the children. */
+  std::vector<t8_element_t *> children; /* Pointers to the children in children_memory. */
+  std::vector<size_t> split_offsets;    /* The offsets of the leaves of the children. */
+  std::vector<int> query_matches;       /* The results of the query callback for the active queries. */
+  std::vector<size_t> active_queries;   /* The queries that are active for the children. */
+};
+
+/* The memory of one thread during a search. There is one level for each
+ * refinement level of the forest and one level for the root element of a tree. */
+struct t8_forest_search_arena
+{
+  std::vector<t8_forest_search_level> levels;
+  t8_forest_search_level root;
+
+  ~t8_forest_search_arena ()
+  {
+    for (auto &level : levels) {
+      if (level.ts != NULL && !level.children.empty ()) {
+        level.ts->t8_element_deinit (level.children.size (), (t8_element_t *) level.children_memory.data ());
+      }
+    }
+    if (root.ts != NULL && !root.children.empty ()) {
+      root.ts->t8_element_deinit (root.children.size (), (t8_element_t *) root.children_memory.data ());
+    }
+  }
+};
+
+/* Return at least num_elements initialized elements of the scheme ts from a level of the arena.
+ * The elements stay valid until this function is called again for the same level. */
+static t8_element_t **
+t8_forest_search_level_elements (t8_forest_search_level *level, const t8_eclass_scheme_c *ts,
+                                 const int num_elements)
+{
+  if (level->ts != ts || (int) level->children.size () < num_elements) {
+    if (level->ts != NULL && !level->children.empty ()) {
+      level->ts->t8_element_deinit (level->children.size (), (t8_element_t *) level->children_memory.data ());
+    }
+    const size_t element_size = ts->t8_element_size ();
+    const int num_allocate = SC_MAX (num_elements, (int) level->children.size ());
+    level->children_memory.resize (num_allocate * element_size);
+    level->children.resize (num_allocate);
+    for (int ielem = 0; ielem < num_allocate; ielem++) {
+      level->children[ielem] = (t8_element_t *) (level->children_memory.data () + ielem * element_size);
+    }
+    ts->t8_element_init (num_allocate, (t8_element_t *) level->children_memory.data ());
+    level->ts = ts;
+  }
+  return level->children.data ();
+}
+
 /* The recursion that is called from t8_forest_search_tree
  * Input is an element and an array of all leaf elements of this element.
  * The callback function is called on element and if it returns true,
@@ -168,12 +227,15 @@ t8_forest_iterate_faces (t8_forest_t forest, t8_locidx_t ltreeid, const t8_eleme
  * for the parent element.
  * If the callback function (search_fn) returns false for an element,
  * the query function is not called for this element.
+ * All temporary memory is taken from the arena, the active queries of the element
+ * are stored in active_queries, which is part of the arena level of the parent.
  */
 static void
 t8_forest_search_recursion (t8_forest_t forest, const t8_locidx_t ltreeid, t8_element_t *element,
                             const t8_eclass_scheme_c *ts, t8_element_array_t *leaf_elements,
                             const t8_locidx_t tree_lindex_of_first_leaf, t8_forest_search_query_fn search_fn,
-                            t8_forest_search_query_fn query_fn, sc_array_t *queries, sc_array_t *active_queries)
+                            t8_forest_search_query_fn query_fn, sc_array_t *queries,
+                            const std::vector<size_t> &active_queries, t8_forest_search_arena *arena)
 {
   /* Assertions to check for necessary requirements */
   /* The forest must be committed */
@@ -188,7 +250,7 @@ t8_forest_search_recursion (t8_forest_t forest, const t8_locidx_t ltreeid, t8_el
     /* There are no leaves left, so we have nothing to do */
     return;
   }
-  const size_t num_active = queries == NULL ? 0 : active_queries->elem_count;
+  const size_t num_active = queries == NULL ? 0 : active_queries.size ();
   if (queries != NULL && num_active == 0) {
     /* There are no queries left. We stop the recursion */
     return;
@@ -216,27 +278,30 @@ t8_forest_search_recursion (t8_forest_t forest, const t8_locidx_t ltreeid, t8_el
     return;
   }
 
+  const int element_level = ts->t8_element_level (element);
+  T8_ASSERT (element_level < (int) arena->levels.size ());
+  t8_forest_search_level *level = &arena->levels[element_level];
+
   /* Check the queries.
    * If the current element is not a leaf, we store the queries that
    * return true in order to pass them on to the children of the element. */
-  sc_array_t *new_active_queries = NULL;
   if (num_active > 0) {
-    if (!is_leaf) {
-      /* Initialize the new active query array */
-      new_active_queries = sc_array_new (sizeof (size_t));
-    }
-    int *active_queries_matches = T8_ALLOC (int, num_active);
+    level->active_queries.clear ();
+    level->query_matches.resize (num_active);
+    /* A view on the active queries, as it is passed to the query callback. */
+    sc_array_t active_query_view;
+    sc_array_init_data (&active_query_view, (void *) active_queries.data (), sizeof (size_t), num_active);
     T8_ASSERT (query_fn != NULL);
-    query_fn (forest, ltreeid, element, is_leaf, leaf_elements, tree_lindex_of_first_leaf, queries, active_queries,
-              active_queries_matches, num_active);
+    query_fn (forest, ltreeid, element, is_leaf, leaf_elements, tree_lindex_of_first_leaf, queries, &active_query_view,
+              level->query_matches.data (), num_active);
 
-    for (size_t iactive = 0; iactive < num_active; iactive++) {
-      if (!is_leaf && active_queries_matches[iactive]) {
-        size_t query_index = *(size_t *) sc_array_index (active_queries, iactive);
-        *(size_t *) sc_array_push (new_active_queries) = query_index;
+    if (!is_leaf) {
+      for (size_t iactive = 0; iactive < num_active; iactive++) {
+        if (level->query_matches[iactive]) {
+          level->active_queries.push_back (active_queries[iactive]);
+        }
       }
     }
-    T8_FREE (active_queries_matches);
   }
 
   if (is_leaf) {
@@ -244,28 +309,24 @@ t8_forest_search_recursion (t8_forest_t forest, const t8_locidx_t ltreeid, t8_el
     return;
   }
 
-  if (num_active > 0 && new_active_queries->elem_count == 0) {
+  if (num_active > 0 && level->active_queries.empty ()) {
     /* No queries returned true for this element. We abort the recursion */
-    sc_array_destroy (new_active_queries);
     return;
   }
 
   /* Enter the recursion (the element is definitely not a leaf at this point) */
   /* We compute all children of E, compute their leaf arrays and call search_recursion */
-  /* allocate the memory to store the children */
   const int num_children = ts->t8_element_num_children (element);
-  t8_element_t **children = T8_ALLOC (t8_element_t *, num_children);
-  ts->t8_element_new (num_children, children);
-  /* Memory for the indices that split the leaf_elements array */
-  size_t *split_offsets = T8_ALLOC (size_t, num_children + 1);
+  t8_element_t **children = t8_forest_search_level_elements (level, ts, num_children);
+  level->split_offsets.resize (num_children + 1);
   /* Compute the children */
   ts->t8_element_children (element, num_children, children);
   /* Split the leaves array in portions belonging to the children of element */
-  t8_forest_split_array (element, leaf_elements, split_offsets);
+  t8_forest_split_array (element, leaf_elements, level->split_offsets.data ());
   for (int ichild = 0; ichild < num_children; ichild++) {
     /* Check if there are any leaf elements for this child */
-    const size_t indexa = split_offsets[ichild];     /* first leaf of this child */
-    const size_t indexb = split_offsets[ichild + 1]; /* first leaf of next child */
+    const size_t indexa = level->split_offsets[ichild];     /* first leaf of this child */
+    const size_t indexb = level->split_offsets[ichild + 1]; /* first leaf of next child */
     if (indexa < indexb) {
       t8_element_array_t child_leaves;
       /* There exist leaves of this child in leaf_elements,
@@ -273,22 +334,17 @@ t8_forest_search_recursion (t8_forest_t forest, const t8_locidx_t ltreeid, t8_el
       t8_element_array_init_view (&child_leaves, leaf_elements, indexa, indexb - indexa);
       /* Enter the recursion */
       t8_forest_search_recursion (forest, ltreeid, children[ichild], ts, &child_leaves,
-                                  indexa + tree_lindex_of_first_leaf, search_fn, query_fn, queries, new_active_queries);
+                                  indexa + tree_lindex_of_first_leaf, search_fn, query_fn, queries,
+                                  level->active_queries, arena);
     }
   }
-  /* clean-up */
-  ts->t8_element_destroy (num_children, children);
-  T8_FREE (children);
-  T8_FREE (split_offsets);
-  if (num_active > 0) {
-    sc_array_destroy (new_active_queries);
-  }
 }
 
 /* Perform a top-down search in one tree of the forest */
 static void
 t8_forest_search_tree (t8_forest_t forest, t8_locidx_t ltreeid, t8_forest_search_query_fn search_fn,
-                       t8_forest_search_query_fn query_fn, sc_array_t *queries, sc_array_t *active_queries)
+                       t8_forest_search_query_fn query_fn, sc_array_t *queries,
+                       const std::vector<size_t> &active_queries, t8_forest_search_arena *arena)
 {
 
   /* Get the element class, scheme and leaf elements of this tree */
@@ -296,46 +352,71 @@ t8_forest_search_tree (t8_forest_t forest, t8_locidx_t ltreeid, t8_forest_search
   const t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, eclass);
   t8_element_array_t *leaf_elements = t8_forest_tree_get_leaves (forest, ltreeid);
 
-  /* assert for empty tree */
-  T8_ASSERT (t8_element_array_get_count (leaf_elements) >= 0);
+  if (t8_element_array_get_count (leaf_elements) == 0) {
+    /* The tree is empty */
+    return;
+  }
   /* Get the first and last leaf of this tree */
   const t8_element_t *first_el = t8_element_array_index_locidx (leaf_elements, 0);
   const t8_element_t *last_el
     = t8_element_array_index_locidx (leaf_elements, t8_element_array_get_count (leaf_elements) - 1);
   /* Compute their nearest common ancestor */
-  t8_element_t *nca;
-  ts->t8_element_new (1, &nca);
+  t8_element_t *nca = t8_forest_search_level_elements (&arena->root, ts, 1)[0];
   ts->t8_element_nca (first_el, last_el, nca);
 
   /* Start the top-down search */
-  t8_forest_search_recursion (forest, ltreeid, nca, ts, leaf_elements, 0, search_fn, query_fn, queries, active_queries);
-
-  ts->t8_element_destroy (1, &nca);
+  t8_forest_search_recursion (forest, ltreeid, nca, ts, leaf_elements, 0, search_fn, query_fn, queries, active_queries,
+                              arena);
 }
 
 void
 t8_forest_search (t8_forest_t forest, t8_forest_search_query_fn search_fn, t8_forest_search_query_fn query_fn,
                   sc_array_t *queries)
 {
-  /* If we have queries build a list of all active queries,
-   * thus all queries in the array */
-  sc_array_t *active_queries = NULL;
-  if (queries != NULL) {
-    const size_t num_queries = queries->elem_count;
-    /* build an array and write 0, 1, 2, 3,... into it */
-    active_queries = sc_array_new_count (sizeof (size_t), num_queries);
-    for (size_t iquery = 0; iquery < num_queries; ++iquery) {
-      *(size_t *) sc_array_index (active_queries, iquery) = iquery;
-    }
-  }
+  t8_forest_search_ext (forest, search_fn, query_fn, queries, 1);
+}
+
+void
+t8_forest_search_ext (t8_forest_t forest, t8_forest_search_query_fn search_fn, t8_forest_search_query_fn query_fn,
+                      sc_array_t *queries, const int num_threads)
+{
+  T8_ASSERT (t8_forest_is_committed (forest));
+  T8_ASSERT (num_threads >= 1);
 
   const t8_locidx_t num_local_trees = t8_forest_get_num_local_trees (forest);
-  for (t8_locidx_t itree = 0; itree < num_local_trees; itree++) {
-    t8_forest_search_tree (forest, itree, search_fn, query_fn, queries, active_queries);
+  const size_t num_queries = queries == NULL ? 0 : queries->elem_count;
+  /* If there are fewer trees than threads, we additionally split the queries into batches. */
+  size_t num_batches = 1;
+  if (queries != NULL && num_local_trees > 0 && num_local_trees < num_threads) {
+    num_batches = SC_MAX (1, SC_MIN (num_queries, (size_t) (num_threads + num_local_trees - 1) / num_local_trees));
   }
-
-  if (active_queries != NULL) {
-    sc_array_destroy (active_queries);
+  const size_t num_work_items = (size_t) num_local_trees * num_batches;
+
+  /* Each thread takes the next pair of tree and query batch that is not searched yet. */
+  std::atomic<size_t> next_item (0);
+  const auto worker = [&] () {
+    t8_forest_search_arena arena;
+    arena.levels.resize (t8_forest_get_maxlevel (forest) + 1);
+    std::vector<size_t> active_queries;
+    for (size_t iitem = next_item++; iitem < num_work_items; iitem = next_item++) {
+      const t8_locidx_t itree = iitem / num_batches;
+      const size_t ibatch = iitem % num_batches;
+      /* The queries of this batch are all active at the start of the search */
+      active_queries.clear ();
+      for (size_t iquery = ibatch * num_queries / num_batches; iquery < (ibatch + 1) * num_queries / num_batches;
+           iquery++) {
+        active_queries.push_back (iquery);
+      }
+      t8_forest_search_tree (forest, itree, search_fn, query_fn, queries, active_queries, &arena);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t ithread = 1; ithread < (size_t) num_threads && ithread < num_work_items; ithread++) {
+    threads.emplace_back (worker);
+  }
+  worker ();
+  for (auto &thread : threads) {
+    thread.join ();
   }
 }
 
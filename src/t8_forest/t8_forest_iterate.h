@@ -88,6 +88,28 @@ void
 t8_forest_search (t8_forest_t forest, t8_forest_search_query_fn search_fn, t8_forest_search_query_fn query_fn,
                   sc_array_t *queries);
 
+/** Perform a top-down search of the forest with multiple threads.
+ * The search is the same as in \ref t8_forest_search. The local trees are searched
+ * in parallel. If there are fewer local trees than threads and \a queries is not NULL,
+ * the queries are additionally split into batches of consecutive queries, which are
+ * searched in parallel. In this case \a search_fn and \a query_fn may be called
+ * multiple times for the same element, once for each batch.
+ * No memory is allocated during the recursion, except for the first elements
+ * of each refinement level on each thread.
+ * \param [in]      forest      The forest. Must be committed.
+ * \param [in]      search_fn   The search callback.
+ * \param [in]      query_fn    The query callback, may be NULL if \a queries is NULL.
+ * \param [in,out]  queries     The queries or NULL.
+ * \param [in]      num_threads The number of threads, must be at least 1.
+ * \note If \a num_threads is greater than 1, \a search_fn and \a query_fn are called
+ *       concurrently for different trees or query batches and must be thread-safe.
+ *       They may write to the queries whose indices are passed to \a query_fn,
+ *       but must not modify the forest, for example its user data.
+ */
+void
+t8_forest_search_ext (t8_forest_t forest, t8_forest_search_query_fn search_fn, t8_forest_search_query_fn query_fn,
+                      sc_array_t *queries, const int num_threads);
+
 /** Given two forest where the elements in one forest are either direct children or
  * parents of the elements in the other forest
  * compare the two forests and for each refined element or coarsened
@@ -58,6 +58,7 @@ These functions write a file in the NetCDF-format which represents the given 2D-
 #include <t8_element_cxx.hxx>
 #include <t8_forest/t8_forest_general.h>
 #include <t8_forest/t8_forest_geometrical.h>
+#include <t8_forest/t8_forest_vertex_numbering.h>
 #include <t8_forest_netcdf.h>
 #include <t8_element_shape.h>
 
@@ -73,6 +74,10 @@ typedef struct
   t8_gloidx_t nMesh_node;
   t8_gloidx_t nMesh_local_node;
   int nMaxMesh_elem_nodes;
+  /* The global numbering of the element corners, each node is written once */
+  t8_forest_vertex_numbering_t *vertex_numbering;
+  /* If true, each process writes its own file with all its local nodes and local node ids */
+  int use_local_node_ids;
   /* Declaring NetCDF-dimension ids */
   int nMesh_elem_dimid;
   int nMaxMesh_elem_nodes_dimid;
@@ -381,8 +386,6 @@ t8_forest_write_netcdf_data (t8_forest_t forest, t8_forest_netcdf_context_t *con
   t8_element_shape_t element_shape;
   t8_locidx_t local_tree_offset;
   t8_gloidx_t first_local_elem_id;
-  t8_gloidx_t num_local_nodes;
-  t8_gloidx_t num_nodes;
   int *Mesh_elem_types;
   t8_nc_int64_t *Mesh_elem_tree_id;
   size_t start_ptr;
@@ -405,8 +408,6 @@ t8_forest_write_netcdf_data (t8_forest_t forest, t8_forest_netcdf_context_t *con
   /* Check if pointers are not NULL. */
   T8_ASSERT (Mesh_elem_types != NULL && Mesh_elem_tree_id != NULL);
 
-  /* Counts the number of nodes */
-  num_local_nodes = 0;
   /* Iterate over all local trees and their respective elements */
   for (ltree_id = 0; ltree_id < num_local_trees; ltree_id++) {
     num_local_tree_elem = t8_forest_get_tree_num_elements (forest, ltree_id);
@@ -425,8 +426,6 @@ t8_forest_write_netcdf_data (t8_forest_t forest, t8_forest_netcdf_context_t *con
       Mesh_elem_types[(local_tree_offset + local_elem_id)] = t8_element_shape_vtk_type (element_shape);
       /* Store the elements tree_id in its global index position */
       Mesh_elem_tree_id[(local_tree_offset + local_elem_id)] = t8_forest_global_tree_id (forest, ltree_id);
-      /* Adding the number of corners of this elements shape to the counter */
-      num_local_nodes += t8_element_shape_num_vertices (element_shape);
     }
   }
   /* Write the data in the corresponding NetCDF-variable. */
@@ -446,14 +445,19 @@ t8_forest_write_netcdf_data (t8_forest_t forest, t8_forest_netcdf_context_t *con
   T8_FREE (Mesh_elem_types);
   T8_FREE (Mesh_elem_tree_id);
 
-  /* Store the number of local nodes */
-  context->nMesh_local_node = num_local_nodes;
-  /* Gather the number of all global nodes */
-  retval = sc_MPI_Allreduce (&num_local_nodes, &num_nodes, 1, T8_MPI_GLOIDX, sc_MPI_SUM, comm);
-  SC_CHECK_MPI (retval);
-
-  /* After counting the number of nodes, the  NetCDF-dimension 'nMesh_node' can be created => Store the 'nMesh_node' dimension */
-  context->nMesh_node = num_nodes;
+  /* Number the element corners, such that corners shared by several elements are written only once.
+   * Each process writes the nodes it owns. */
+  context->vertex_numbering = t8_forest_vertex_numbering_new (forest, 0);
+  if (context->use_local_node_ids) {
+    /* Each process writes its own file, which needs to contain all nodes of the local elements */
+    context->nMesh_local_node = context->vertex_numbering->num_local_vertices;
+    context->nMesh_node = context->vertex_numbering->num_local_vertices;
+  }
+  else {
+    context->nMesh_local_node = context->vertex_numbering->num_owned_vertices;
+    /* After counting the number of nodes, the NetCDF-dimension 'nMesh_node' can be created */
+    context->nMesh_node = context->vertex_numbering->global_num_vertices;
+  }
 
 #endif
 }
@@ -666,7 +670,7 @@ static void
 t8_forest_write_netcdf_coordinate_data (t8_forest_t forest, t8_forest_netcdf_context_t *context, sc_MPI_Comm comm)
 {
 #if T8_WITH_NETCDF
-  double *vertex_coords = T8_ALLOC (double, 3);
+  const t8_forest_vertex_numbering_t *numbering = context->vertex_numbering;
   t8_eclass_t tree_class;
   t8_locidx_t num_local_trees;
   t8_locidx_t ltree_id = 0;
@@ -683,11 +687,8 @@ t8_forest_write_netcdf_coordinate_data (t8_forest_t forest, t8_forest_netcdf_con
   double *Mesh_node_x;
   double *Mesh_node_y;
   double *Mesh_node_z;
-  t8_gloidx_t *node_offset;
-  t8_gloidx_t num_it = 0;
   int retval;
-  int mpisize, mpirank;
-  size_t start_ptr = 0;
+  size_t start_ptr;
   size_t count_ptr;
   int i;
   int number_nodes;
@@ -695,29 +696,12 @@ t8_forest_write_netcdf_coordinate_data (t8_forest_t forest, t8_forest_netcdf_con
   /* Get the first local element id in a forest (function is collective) */
   first_local_elem_id = t8_forest_get_first_local_element_id (forest);
 
-  /* Get the size of the MPI_Comm and the process local rank */
-  retval = sc_MPI_Comm_size (comm, &mpisize);
-  SC_CHECK_MPI (retval);
-  retval = sc_MPI_Comm_rank (comm, &mpirank);
-  SC_CHECK_MPI (retval);
-
   /* Get number of local trees. */
   num_local_trees = t8_forest_get_num_local_trees (forest);
 
   /* Ger number of local elements */
   num_local_elements = t8_forest_get_local_num_elements (forest);
 
-  /* Allocate memory for node offsets */
-  node_offset = T8_ALLOC (t8_gloidx_t, mpisize);
-
-  /* Get the number of all nodes local to each rank */
-  retval = sc_MPI_Allgather (&context->nMesh_local_node, 1, T8_MPI_GLOIDX, node_offset, 1, T8_MPI_GLOIDX, comm);
-  SC_CHECK_MPI (retval);
-  /*Calculate the global number of element nodes in the previous trees */
-  for (int j = 0; j < mpirank; j++) {
-    start_ptr += (size_t) node_offset[j];
-  }
-
   /* Allocate the Variable-data that will be put out in the NetCDF variables */
   num_elements = (size_t) num_local_elements;
   num_max_nodes_per_elem = (size_t) (context->nMaxMesh_elem_nodes);
@@ -731,6 +715,15 @@ t8_forest_write_netcdf_coordinate_data (t8_forest_t forest, t8_forest_netcdf_con
   /* Check if pointers are not NULL. */
   T8_ASSERT (Mesh_node_x != NULL && Mesh_node_y != NULL && Mesh_node_z != NULL && Mesh_elem_nodes != NULL);
 
+  /* The nodes owned by this process are the first local vertices of the numbering.
+   * If local node ids are used, we write all local vertices. */
+  for (size_t inode = 0; inode < num_nodes; inode++) {
+    /* Stores the x-, y- and z- coordinate of the nodes */
+    Mesh_node_x[inode] = numbering->coordinates[3 * inode];
+    Mesh_node_y[inode] = numbering->coordinates[3 * inode + 1];
+    Mesh_node_z[inode] = numbering->coordinates[3 * inode + 2];
+  }
+
   /* Iterate over all local trees. */
   /* Corners should be stored in the same order as in a vtk-file (read that somewehere on a netcdf page). */
   for (ltree_id = 0; ltree_id < num_local_trees; ltree_id++) {
@@ -740,6 +733,7 @@ t8_forest_write_netcdf_coordinate_data (t8_forest_t forest, t8_forest_netcdf_con
     local_tree_offset = t8_forest_get_tree_element_offset (forest, ltree_id);
 
     for (local_elem_id = 0; local_elem_id < num_local_tree_elem; local_elem_id++) {
+      const t8_locidx_t ielement = local_tree_offset + local_elem_id;
       /* Get the eclass scheme */
       t8_eclass_scheme_c *scheme = t8_forest_get_eclass_scheme (forest, tree_class);
       /* Get the local element in the local tree */
@@ -750,26 +744,19 @@ t8_forest_write_netcdf_coordinate_data (t8_forest_t forest, t8_forest_netcdf_con
       number_nodes = t8_element_shape_num_vertices (element_shape);
       i = 0;
       for (; i < number_nodes; i++) {
-        t8_forest_element_coordinate (forest, ltree_id, element,
-                                      t8_element_shape_vtk_corner_number ((int) element_shape, i), vertex_coords);
-        /* Stores the x-, y- and z- coordinate of the nodes */
-        Mesh_node_x[num_it] = vertex_coords[0];
-        Mesh_node_y[num_it] = vertex_coords[1];
-        Mesh_node_z[num_it] = vertex_coords[2];
-        /* Stores the the nodes which correspond to this element. */
-        Mesh_elem_nodes[(local_tree_offset + local_elem_id) * (context->nMaxMesh_elem_nodes) + i]
-          = ((t8_gloidx_t) start_ptr) + num_it;
-        num_it++;
+        /* Stores the ids of the nodes which correspond to this element. */
+        const t8_locidx_t ivertex
+          = numbering->element_vertices[numbering->element_offsets[ielement]
+                                        + t8_element_shape_vtk_corner_number ((int) element_shape, i)];
+        Mesh_elem_nodes[ielement * (context->nMaxMesh_elem_nodes) + i]
+          = context->use_local_node_ids ? (t8_gloidx_t) ivertex : numbering->global_ids[ivertex];
       }
       for (; i < context->nMaxMesh_elem_nodes; i++) {
         /* Fill the elements corresponding nodes, which remain empty, if it is an element having less than nMaxMesh_elem_nodes. */
-        Mesh_elem_nodes[(local_tree_offset + local_elem_id) * (context->nMaxMesh_elem_nodes) + i]
-          = context->fillvalue64;
+        Mesh_elem_nodes[ielement * (context->nMaxMesh_elem_nodes) + i] = context->fillvalue64;
       }
     }
   }
-  /* Free allocated memory */
-  T8_FREE (vertex_coords);
 
   /* *Write the data into the NetCDF coordinate variables.* */
 
@@ -783,6 +770,7 @@ t8_forest_write_netcdf_coordinate_data (t8_forest_t forest, t8_forest_netcdf_con
   }
 
   /* Fill the space coordinate variables */
+  start_ptr = context->use_local_node_ids ? 0 : (size_t) numbering->first_owned_vertex;
   count_ptr = (size_t) context->nMesh_local_node;
   /* Fill the 'Mesh_node_x'-variable. */
   if ((retval = nc_put_vara_double (context->ncid, context->var_node_x_id, &start_ptr, &count_ptr, &Mesh_node_x[0]))) {
@@ -798,11 +786,11 @@ t8_forest_write_netcdf_coordinate_data (t8_forest_t forest, t8_forest_netcdf_con
   }
 
   /* Free the allocated memory */
-  T8_FREE (node_offset);
   T8_FREE (Mesh_node_x);
   T8_FREE (Mesh_node_y);
   T8_FREE (Mesh_node_z);
   T8_FREE (Mesh_elem_nodes);
+  t8_forest_vertex_numbering_destroy (&context->vertex_numbering);
 
 #endif
 }
@@ -1008,8 +996,13 @@ t8_forest_write_netcdf_ext (t8_forest_t forest, const char *file_prefix, const c
    *
    * \note Therefore, it is advisable to either run the whole program with only one MPI rank or
    * make use of a parallel netCDF/HDF-5 configuration
+   *
+   * \note The nodes of a process' file are the distinct corners of its local elements,
+   * referred to by their local ids.
    */
+  context.use_local_node_ids = 0;
   if (mpisize > 1) {
+    context.use_local_node_ids = 1;
     /* Create the NetCDF-Filename for each process */
     snprintf (file_name, BUFSIZ, "%s_rank_%d.nc", file_prefix, mpirank);
     t8_global_productionf (
@@ -1024,6 +1017,10 @@ t8_forest_write_netcdf_ext (t8_forest_t forest, const char *file_prefix, const c
   context.filetitle = file_title;
   context.dim = dim;
   context.nMaxMesh_elem_nodes = t8_element_shape_max_num_corner[dim];
+  context.vertex_numbering = NULL;
+#if T8_WITH_NETCDF_PAR
+  context.use_local_node_ids = 0;
+#endif
   context.fillvalue32 = -1;
   context.fillvalue64 = -1;
   context.start_index = 0;
@@ -26,6 +26,7 @@
 #include <t8_forest/t8_forest_general.h>
 #include <t8_cmesh/t8_cmesh_offset.h>
 #include <t8_element_cxx.hxx>
+#include <algorithm>
 
 /* We want to export the whole implementation to be callable from "C" */
 T8_EXTERN_C_BEGIN ();
@@ -437,6 +438,113 @@ t8_forest_partition_compute_new_offset (t8_forest_t forest)
   t8_shmem_array_end_writing (forest->element_offsets);
 }
 
+/* Calculate the new element_offset for forest from the elements in forest->set_from
+ * such that the sum of the element weights is balanced among the processes.
+ * The weight of each element is computed with forest->set_partition_weight_fn.
+ * With the inclusive prefix sum W_e of the weights along the SFC up to element e and
+ * the total weight W, the first element of process p is the first element e
+ * with W_e > p * W / mpisize. The product is computed before the division, as in
+ * t8_forest_partition_compute_new_offset, such that equal weights give its partition. */
+static void
+t8_forest_partition_compute_new_offset_weighted (t8_forest_t forest)
+{
+  t8_forest_t forest_from = forest->set_from;
+  sc_MPI_Comm comm = forest->mpicomm;
+  const int mpisize = forest->mpisize;
+  const t8_locidx_t num_local_elements = forest_from->local_num_elements;
+  const t8_gloidx_t global_num_elements = forest_from->global_num_elements;
+  const t8_gloidx_t first_element = t8_shmem_array_get_gloidx (forest_from->element_offsets, forest->mpirank);
+  int mpiret;
+
+  T8_ASSERT (t8_forest_is_initialized (forest));
+  T8_ASSERT (forest->set_partition_weight_fn != NULL);
+  T8_ASSERT (forest->element_offsets == NULL);
+
+  /* Compute the inclusive prefix sum of the local element weights */
+  double *prefix_weight = T8_ALLOC (double, num_local_elements);
+  double local_weight = 0;
+  t8_locidx_t ielement = 0;
+  const t8_locidx_t num_local_trees = t8_forest_get_num_local_trees (forest_from);
+  for (t8_locidx_t itree = 0; itree < num_local_trees; itree++) {
+    const t8_locidx_t num_tree_elements = t8_forest_get_tree_num_elements (forest_from, itree);
+    for (t8_locidx_t ielem_tree = 0; ielem_tree < num_tree_elements; ielem_tree++, ielement++) {
+      const t8_element_t *element = t8_forest_get_element_in_tree (forest_from, itree, ielem_tree);
+      const double weight = forest->set_partition_weight_fn (forest_from, itree, element, ielement);
+      SC_CHECK_ABORT (weight >= 0, "Element weights for partition must be non-negative.");
+      local_weight += weight;
+      prefix_weight[ielement] = local_weight;
+    }
+  }
+  T8_ASSERT (ielement == num_local_elements);
+
+  /* The weight of all elements on smaller ranks and the total weight */
+  double weight_offset;
+  double global_weight;
+  mpiret = sc_MPI_Scan (&local_weight, &weight_offset, 1, sc_MPI_DOUBLE, sc_MPI_SUM, comm);
+  SC_CHECK_MPI (mpiret);
+  /* MPI_Scan is inclusive, thus we subtract our own weight */
+  weight_offset -= local_weight;
+  mpiret = sc_MPI_Allreduce (&local_weight, &global_weight, 1, sc_MPI_DOUBLE, sc_MPI_SUM, comm);
+  SC_CHECK_MPI (mpiret);
+
+  if (global_weight <= 0) {
+    /* All elements have zero weight, we fall back to the partition with equal weights. */
+    T8_FREE (prefix_weight);
+    t8_forest_partition_compute_new_offset (forest);
+    return;
+  }
+
+  /* Each process determines the first elements of those processes whose weight
+   * boundary lies within its own range of weights. The other entries are set to
+   * the global number of elements and the minimum over all processes is taken.
+   * Due to rounding, a boundary may not be found by any process. These entries
+   * remain at the global number of elements and are corrected afterwards. */
+  t8_gloidx_t *new_offsets = T8_ALLOC (t8_gloidx_t, mpisize + 1);
+  t8_gloidx_t *local_offsets = T8_ALLOC (t8_gloidx_t, mpisize + 1);
+  for (int iproc = 0; iproc <= mpisize; iproc++) {
+    local_offsets[iproc] = global_num_elements;
+  }
+  local_offsets[0] = 0;
+  if (num_local_elements > 0) {
+    const double last_weight = weight_offset + prefix_weight[num_local_elements - 1];
+    /* The first process whose boundary may lie within our range, we start one
+     * process earlier to be safe against rounding. */
+    int iproc = SC_MAX (1, (int) (weight_offset * mpisize / global_weight) - 1);
+    for (; iproc < mpisize; iproc++) {
+      const double boundary = (double) iproc * global_weight / mpisize;
+      if (boundary >= last_weight) {
+        break;
+      }
+      if (boundary >= weight_offset) {
+        /* Find the first local element whose prefix weight exceeds the boundary */
+        const double *first_larger
+          = std::upper_bound (prefix_weight, prefix_weight + num_local_elements, boundary - weight_offset);
+        local_offsets[iproc] = first_element + (first_larger - prefix_weight);
+      }
+    }
+  }
+  mpiret = sc_MPI_Allreduce (local_offsets, new_offsets, mpisize + 1, T8_MPI_GLOIDX, sc_MPI_MIN, comm);
+  SC_CHECK_MPI (mpiret);
+  /* Ensure that the offsets are non-decreasing */
+  for (int iproc = mpisize - 1; iproc > 0; iproc--) {
+    new_offsets[iproc] = SC_MIN (new_offsets[iproc], new_offsets[iproc + 1]);
+  }
+  T8_FREE (local_offsets);
+  T8_FREE (prefix_weight);
+
+  /* Set the shmem array type to comm */
+  t8_shmem_init (comm);
+  t8_shmem_set_type (comm, T8_SHMEM_BEST_TYPE);
+  /* Initialize the shmem array */
+  t8_shmem_array_init (&forest->element_offsets, sizeof (t8_gloidx_t), mpisize + 1, comm);
+  if (t8_shmem_array_start_writing (forest->element_offsets)) {
+    t8_gloidx_t *element_offsets = t8_shmem_array_get_gloidx_array_for_writing (forest->element_offsets);
+    memcpy (element_offsets, new_offsets, (mpisize + 1) * sizeof (t8_gloidx_t));
+  }
+  t8_shmem_array_end_writing (forest->element_offsets);
+  T8_FREE (new_offsets);
+}
+
 /* Find the owner of a given element.
  */
 static int
@@ -1149,7 +1257,9 @@ t8_forest_partition_given (t8_forest_t forest, const int send_data, const sc_arr
 }
 
 /* Populate a forest with the partitioned elements of forest->set_from.
- * Currently the elements are distributed evenly (each element has the same weight).
+ * If forest->set_partition_weight_fn is set, the elements are distributed such that
+ * each process has the same load. Otherwise the elements are distributed evenly
+ * (each element has the same weight).
  */
 void
 t8_forest_partition (t8_forest_t forest)
@@ -1182,7 +1292,12 @@ t8_forest_partition (t8_forest_t forest)
   /* TODO: if offsets already exist on forest_from, check it for consistency */
 
   /* We now calculate the new element offsets */
-  t8_forest_partition_compute_new_offset (forest);
+  if (forest->set_partition_weight_fn != NULL) {
+    t8_forest_partition_compute_new_offset_weighted (forest);
+  }
+  else {
+    t8_forest_partition_compute_new_offset (forest);
+  }
   t8_forest_partition_given (forest, 0, NULL, NULL);
 
   T8_ASSERT ((size_t) t8_forest_get_num_local_trees (forest_from) == forest_from->trees->elem_count);
@@ -0,0 +1,694 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+#include <sc_notify.h>
+#include <t8_forest/t8_forest_point_location.h>
+#include <t8_forest/t8_forest_iterate.h>
+#include <t8_forest/t8_forest_geometrical.h>
+#include <t8_forest/t8_forest_private.h>
+#include <t8_forest/t8_forest_types.h>
+#include <t8_geometry/t8_geometry.h>
+#include <t8_element_cxx.hxx>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+T8_EXTERN_C_BEGIN ();
+
+/* A point that is searched for in the local leaves of this process. */
+typedef struct
+{
+  double point[3];           /* The coordinates of the point. */
+  double tolerance;          /* The tolerance for the point inside check. */
+  t8_locidx_t element_index; /* The local index of the leaf containing the point, -1 if not found yet. */
+  double ref_coords[3];      /* The reference coordinates of the point in this leaf. */
+} t8_forest_locate_query_t;
+
+/* The answer to a point that was sent to this process by another process. */
+typedef struct
+{
+  t8_locidx_t element_index;
+  double ref_coords[3];
+} t8_forest_locate_result_t;
+
+/* The bounding boxes of the local trees of all processes, sorted into a uniform grid of bins.
+ * They only depend on the forest and are computed on the first call of t8_forest_locate_points.
+ * The boxes overlapping bin i are box_ids[offsets[i]] ... box_ids[offsets[i+1] - 1]. */
+typedef struct t8_forest_locate_boxes
+{
+  size_t num_boxes; /* The number of boxes of all processes. */
+  double *boxes;    /* The lower and the upper corner of each box. */
+  int *box_ranks;   /* For each box the process that owns the tree. */
+  double lower[3];
+  double width[3];
+  int num_bins[3];
+  size_t *offsets;
+  size_t *box_ids;
+} t8_forest_locate_boxes_t;
+
+/* Compute the ref coordinates of a point inside a leaf by a Gauss-Newton iteration on
+ * t8_forest_element_from_ref_coords. If the geometry of the tree provides a Jacobian,
+ * we use it, otherwise we use a finite difference Jacobian.
+ * For linear geometries of simplices the iteration converges in one step. */
+static void
+t8_forest_locate_ref_coords (t8_forest_t forest, const t8_locidx_t ltreeid, const t8_element_t *element,
+                             const double *point, double *ref_coords)
+{
+  const t8_eclass_t tree_class = t8_forest_get_eclass (forest, ltreeid);
+  const int dim = t8_eclass_to_dimension[tree_class];
+  const t8_cmesh_t cmesh = t8_forest_get_cmesh (forest);
+  const t8_gloidx_t gtreeid = t8_forest_global_tree_id (forest, ltreeid);
+  const t8_geometry_type_t geom_type = t8_geometry_get_type (cmesh, gtreeid);
+  /* The linear geometries do not implement the Jacobian and the one of an analytic geometry is optional */
+  const int use_jacobian = geom_type == T8_GEOMETRY_TYPE_LAGRANGE || geom_type == T8_GEOMETRY_TYPE_CAD;
+  const t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, tree_class);
+  t8_geometry_tree_cache_t cache;
+  /* The derivative of the affine map from the reference space of the element to the one of the tree */
+  double ref_to_tree[3][3];
+  const double h = 1e-7;
+  const int max_iterations = 20;
+
+  for (int idim = 0; idim < 3; idim++) {
+    ref_coords[idim] = idim < dim ? 0.5 : 0;
+  }
+  if (use_jacobian && dim > 0) {
+    double unit_coords[4 * 3] = { 0 }, tree_unit_coords[4 * 3];
+    /* Map the origin and the unit vectors of the element to the tree */
+    for (int jdim = 0; jdim < dim; jdim++) {
+      unit_coords[(jdim + 1) * dim + jdim] = 1;
+    }
+    ts->t8_element_reference_coords (element, unit_coords, dim + 1, tree_unit_coords);
+    for (int kdim = 0; kdim < dim; kdim++) {
+      for (int jdim = 0; jdim < dim; jdim++) {
+        ref_to_tree[kdim][jdim] = tree_unit_coords[(jdim + 1) * dim + kdim] - tree_unit_coords[kdim];
+      }
+    }
+  }
+  t8_geometry_tree_cache_init (&cache);
+  for (int iter = 0; iter < max_iterations && dim > 0; iter++) {
+    double coords[3], shifted_ref[3], shifted[3];
+    double residual[3], jacobian[3][3];
+    t8_forest_element_from_ref_coords (forest, ltreeid, element, ref_coords, 1, coords);
+    for (int i = 0; i < 3; i++) {
+      residual[i] = point[i] - coords[i];
+    }
+    if (use_jacobian) {
+      double tree_ref_coords[3], tree_jacobian[3 * 3];
+      /* Entry 3 * k + i of tree_jacobian is the derivative of the i-th coordinate by the k-th tree ref coordinate */
+      ts->t8_element_reference_coords (element, ref_coords, 1, tree_ref_coords);
+      t8_geometry_jacobian_threadsafe (cmesh, gtreeid, tree_ref_coords, 1, tree_jacobian, &cache);
+      for (int i = 0; i < 3; i++) {
+        for (int jdim = 0; jdim < dim; jdim++) {
+          jacobian[i][jdim] = 0;
+          for (int kdim = 0; kdim < dim; kdim++) {
+            jacobian[i][jdim] += tree_jacobian[3 * kdim + i] * ref_to_tree[kdim][jdim];
+          }
+        }
+      }
+    }
+    else {
+      for (int jdim = 0; jdim < dim; jdim++) {
+        for (int idim = 0; idim < dim; idim++) {
+          shifted_ref[idim] = ref_coords[idim] + (idim == jdim ? h : 0);
+        }
+        t8_forest_element_from_ref_coords (forest, ltreeid, element, shifted_ref, 1, shifted);
+        for (int i = 0; i < 3; i++) {
+          jacobian[i][jdim] = (shifted[i] - coords[i]) / h;
+        }
+      }
+    }
+    /* Set up the normal equations J^T J delta = J^T r. They also cover elements
+     * whose dimension is smaller than 3. */
+    double matrix[3][4];
+    for (int idim = 0; idim < dim; idim++) {
+      for (int jdim = 0; jdim < dim; jdim++) {
+        matrix[idim][jdim] = 0;
+        for (int i = 0; i < 3; i++) {
+          matrix[idim][jdim] += jacobian[i][idim] * jacobian[i][jdim];
+        }
+      }
+      matrix[idim][dim] = 0;
+      for (int i = 0; i < 3; i++) {
+        matrix[idim][dim] += jacobian[i][idim] * residual[i];
+      }
+    }
+    /* Gaussian elimination with partial pivoting */
+    for (int idim = 0; idim < dim; idim++) {
+      int pivot = idim;
+      for (int jdim = idim + 1; jdim < dim; jdim++) {
+        if (fabs (matrix[jdim][idim]) > fabs (matrix[pivot][idim])) {
+          pivot = jdim;
+        }
+      }
+      if (matrix[pivot][idim] == 0) {
+        /* The element is degenerated, we keep the current approximation. */
+        return;
+      }
+      for (int k = 0; k <= dim; k++) {
+        std::swap (matrix[idim][k], matrix[pivot][k]);
+      }
+      for (int jdim = idim + 1; jdim < dim; jdim++) {
+        const double factor = matrix[jdim][idim] / matrix[idim][idim];
+        for (int k = idim; k <= dim; k++) {
+          matrix[jdim][k] -= factor * matrix[idim][k];
+        }
+      }
+    }
+    double max_update = 0;
+    for (int idim = dim - 1; idim >= 0; idim--) {
+      double update = matrix[idim][dim];
+      for (int jdim = idim + 1; jdim < dim; jdim++) {
+        update -= matrix[idim][jdim] * matrix[jdim][dim];
+      }
+      update /= matrix[idim][idim];
+      /* Store the solution in the last column for the back substitution of the remaining rows */
+      matrix[idim][dim] = update;
+      ref_coords[idim] += update;
+      max_update = SC_MAX (max_update, fabs (update));
+    }
+    if (max_update < 1e-14) {
+      return;
+    }
+  }
+}
+
+static int
+t8_forest_locate_points_search_fn (t8_forest_t forest, const t8_locidx_t ltreeid, const t8_element_t *element,
+                                   const int is_leaf, const t8_element_array_t *leaf_elements,
+                                   const t8_locidx_t tree_leaf_index, void *queries, sc_array_t *query_indices,
+                                   int *query_matches, const size_t num_active_queries)
+{
+  /* We continue the search everywhere, the queries decide whether to descend. */
+  return 1;
+}
+
+/* Check all active points that were not found yet at once.
+ * If the element is a leaf, the matching points are assigned to it. Since the
+ * search traverses the leaves in the order of the space-filling curve, a point on the
+ * boundary of several leaves is assigned to the first of them. */
+static int
+t8_forest_locate_points_query_fn (t8_forest_t forest, const t8_locidx_t ltreeid, const t8_element_t *element,
+                                  const int is_leaf, const t8_element_array_t *leaf_elements,
+                                  const t8_locidx_t tree_leaf_index, void *queries, sc_array_t *query_indices,
+                                  int *query_matches, const size_t num_active_queries)
+{
+  T8_ASSERT (queries != NULL);
+  sc_array_t *query_array = (sc_array_t *) queries;
+  std::vector<double> points;
+  std::vector<size_t> active_positions;
+  double tolerance = 0;
+
+  points.reserve (3 * num_active_queries);
+  active_positions.reserve (num_active_queries);
+  for (size_t iactive = 0; iactive < num_active_queries; iactive++) {
+    const size_t iquery = *(size_t *) sc_array_index (query_indices, iactive);
+    const t8_forest_locate_query_t *query = (const t8_forest_locate_query_t *) sc_array_index (query_array, iquery);
+    query_matches[iactive] = 0;
+    if (query->element_index < 0) {
+      points.insert (points.end (), query->point, query->point + 3);
+      active_positions.push_back (iactive);
+      tolerance = query->tolerance;
+    }
+  }
+  const int num_points = active_positions.size ();
+  if (num_points == 0) {
+    return 0;
+  }
+  std::vector<int> is_inside (num_points);
+  t8_forest_element_points_inside (forest, ltreeid, element, points.data (), num_points, is_inside.data (), tolerance);
+
+  for (int ipoint = 0; ipoint < num_points; ipoint++) {
+    const size_t iactive = active_positions[ipoint];
+    query_matches[iactive] = is_inside[ipoint];
+    if (is_leaf && is_inside[ipoint]) {
+      const size_t iquery = *(size_t *) sc_array_index (query_indices, iactive);
+      t8_forest_locate_query_t *query = (t8_forest_locate_query_t *) sc_array_index (query_array, iquery);
+      query->element_index = t8_forest_get_tree_element_offset (forest, ltreeid) + tree_leaf_index;
+      t8_forest_locate_ref_coords (forest, ltreeid, element, query->point, query->ref_coords);
+    }
+  }
+  return 1;
+}
+
+/* Enlarge a box by the coordinates of a point. */
+static void
+t8_forest_locate_box_add (double *lower, double *upper, const double *coords)
+{
+  for (int i = 0; i < 3; i++) {
+    lower[i] = SC_MIN (lower[i], coords[i]);
+    upper[i] = SC_MAX (upper[i], coords[i]);
+  }
+}
+
+/* Enlarge a box by the bounding box of a leaf in a tree with a curved geometry.
+ * We evaluate the geometry at the corners, the midpoints of all pairs of corners and the
+ * center of the leaf. The deviation of the midpoints from the midpoints of the straight lines
+ * measures the curvature of the leaf. We pad the box of the leaf by this deviation, since
+ * the leaf may bulge out further between the evaluated points. */
+static void
+t8_forest_locate_box_add_curved (t8_forest_t forest, const t8_locidx_t ltreeid, const t8_element_t *element,
+                                 const t8_eclass_scheme_c *ts, double *lower, double *upper)
+{
+  const t8_eclass_t shape = (t8_eclass_t) ts->t8_element_shape (element);
+  const int dim = t8_eclass_to_dimension[shape];
+  const int num_corners = t8_eclass_num_vertices[shape];
+  const int num_pairs = num_corners * (num_corners - 1) / 2;
+  const int num_samples = num_corners + num_pairs + 1;
+  std::vector<double> ref_coords (num_samples * dim, 0);
+  std::vector<double> coords (3 * num_samples);
+  double element_lower[3] = { HUGE_VAL, HUGE_VAL, HUGE_VAL };
+  double element_upper[3] = { -HUGE_VAL, -HUGE_VAL, -HUGE_VAL };
+  double deviation = 0;
+  int isample = num_corners;
+
+  /* The corners, the midpoints of all pairs of corners and the center */
+  for (int icorner = 0; icorner < num_corners; icorner++) {
+    for (int idim = 0; idim < dim; idim++) {
+      ref_coords[icorner * dim + idim] = t8_element_corner_ref_coords[shape][icorner][idim];
+      ref_coords[(num_samples - 1) * dim + idim] += t8_element_corner_ref_coords[shape][icorner][idim] / num_corners;
+    }
+  }
+  for (int icorner = 0; icorner < num_corners; icorner++) {
+    for (int jcorner = icorner + 1; jcorner < num_corners; jcorner++, isample++) {
+      for (int idim = 0; idim < dim; idim++) {
+        ref_coords[isample * dim + idim] = 0.5 * (ref_coords[icorner * dim + idim] + ref_coords[jcorner * dim + idim]);
+      }
+    }
+  }
+  t8_forest_element_from_ref_coords (forest, ltreeid, element, ref_coords.data (), num_samples, coords.data ());
+
+  for (isample = 0; isample < num_samples; isample++) {
+    t8_forest_locate_box_add (element_lower, element_upper, &coords[3 * isample]);
+  }
+  /* Compare the evaluated midpoints to the midpoints of the straight lines */
+  isample = num_corners;
+  for (int icorner = 0; icorner < num_corners; icorner++) {
+    for (int jcorner = icorner + 1; jcorner < num_corners; jcorner++, isample++) {
+      for (int i = 0; i < 3; i++) {
+        const double straight = 0.5 * (coords[3 * icorner + i] + coords[3 * jcorner + i]);
+        deviation = SC_MAX (deviation, fabs (coords[3 * isample + i] - straight));
+      }
+    }
+  }
+  for (int i = 0; i < 3; i++) {
+    double center = 0;
+    for (int icorner = 0; icorner < num_corners; icorner++) {
+      center += coords[3 * icorner + i] / num_corners;
+    }
+    deviation = SC_MAX (deviation, fabs (coords[3 * (num_samples - 1) + i] - center));
+  }
+  for (int i = 0; i < 3; i++) {
+    lower[i] = SC_MIN (lower[i], element_lower[i] - deviation);
+    upper[i] = SC_MAX (upper[i], element_upper[i] + deviation);
+  }
+}
+
+/* Compute the bounding box of the local leaves of each local tree.
+ * For each non-empty tree, 6 doubles (lower and upper corner) are appended to boxes.
+ * The boxes of trees with a linear geometry are computed from the corners of the leaves. */
+static void
+t8_forest_locate_bounding_boxes (t8_forest_t forest, std::vector<double> &boxes)
+{
+  const t8_cmesh_t cmesh = t8_forest_get_cmesh (forest);
+  const t8_locidx_t num_local_trees = t8_forest_get_num_local_trees (forest);
+  for (t8_locidx_t itree = 0; itree < num_local_trees; itree++) {
+    const t8_locidx_t num_elements = t8_forest_get_tree_num_elements (forest, itree);
+    if (num_elements == 0) {
+      continue;
+    }
+    const t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, t8_forest_get_tree_class (forest, itree));
+    const t8_geometry_type_t geom_type = t8_geometry_get_type (cmesh, t8_forest_global_tree_id (forest, itree));
+    const int is_linear = geom_type == T8_GEOMETRY_TYPE_LINEAR || geom_type == T8_GEOMETRY_TYPE_LINEAR_AXIS_ALIGNED;
+    double lower[3] = { HUGE_VAL, HUGE_VAL, HUGE_VAL };
+    double upper[3] = { -HUGE_VAL, -HUGE_VAL, -HUGE_VAL };
+    for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+      const t8_element_t *element = t8_forest_get_element_in_tree (forest, itree, ielement);
+      if (!is_linear) {
+        t8_forest_locate_box_add_curved (forest, itree, element, ts, lower, upper);
+        continue;
+      }
+      const int num_corners = ts->t8_element_num_corners (element);
+      for (int icorner = 0; icorner < num_corners; icorner++) {
+        double coords[3];
+        t8_forest_element_coordinate (forest, itree, element, icorner, coords);
+        t8_forest_locate_box_add (lower, upper, coords);
+      }
+    }
+    boxes.insert (boxes.end (), lower, lower + 3);
+    boxes.insert (boxes.end (), upper, upper + 3);
+  }
+}
+
+/* Compute the range of bins in one direction that overlap the interval [lower, upper]. */
+static void
+t8_forest_locate_grid_range (const t8_forest_locate_boxes_t *grid, const int idim, const double lower,
+                             const double upper, int *first, int *last)
+{
+  const int num_bins = grid->num_bins[idim];
+  if (grid->width[idim] <= 0) {
+    *first = *last = 0;
+    return;
+  }
+  *first = (int) floor ((lower - grid->lower[idim]) / grid->width[idim] * num_bins);
+  *last = (int) floor ((upper - grid->lower[idim]) / grid->width[idim] * num_bins);
+  *first = SC_MAX (0, SC_MIN (*first, num_bins - 1));
+  *last = SC_MAX (0, SC_MIN (*last, num_bins - 1));
+}
+
+/* Sort the bounding boxes of all processes into a uniform grid with about as many bins as boxes. */
+static void
+t8_forest_locate_grid_build (t8_forest_locate_boxes_t *grid)
+{
+  const size_t num_boxes = grid->num_boxes;
+  const double *boxes = grid->boxes;
+  T8_ASSERT (num_boxes > 0);
+  double upper[3];
+  int num_directions = 0;
+  for (int i = 0; i < 3; i++) {
+    grid->lower[i] = HUGE_VAL;
+    upper[i] = -HUGE_VAL;
+    for (size_t ibox = 0; ibox < num_boxes; ibox++) {
+      grid->lower[i] = SC_MIN (grid->lower[i], boxes[6 * ibox + i]);
+      upper[i] = SC_MAX (upper[i], boxes[6 * ibox + 3 + i]);
+    }
+    grid->width[i] = upper[i] - grid->lower[i];
+    num_directions += grid->width[i] > 0;
+  }
+  /* Distribute the bins over all directions in which the domain is not flat. */
+  const int bins_per_direction
+    = num_directions == 0 ? 1 : SC_MAX (1, (int) ceil (pow ((double) num_boxes, 1. / num_directions)));
+  for (int i = 0; i < 3; i++) {
+    grid->num_bins[i] = grid->width[i] > 0 ? bins_per_direction : 1;
+  }
+  const size_t total_bins = (size_t) grid->num_bins[0] * grid->num_bins[1] * grid->num_bins[2];
+
+  /* Count the boxes per bin and then fill the bins. */
+  grid->offsets = T8_ALLOC_ZERO (size_t, total_bins + 1);
+  grid->box_ids = NULL;
+  std::vector<size_t> fill;
+  for (int pass = 0; pass < 2; pass++) {
+    if (pass == 1) {
+      for (size_t ibin = 0; ibin < total_bins; ibin++) {
+        grid->offsets[ibin + 1] += grid->offsets[ibin];
+      }
+      grid->box_ids = T8_ALLOC (size_t, grid->offsets[total_bins]);
+      fill.assign (grid->offsets, grid->offsets + total_bins);
+    }
+    for (size_t ibox = 0; ibox < num_boxes; ibox++) {
+      int first[3], last[3];
+      for (int i = 0; i < 3; i++) {
+        t8_forest_locate_grid_range (grid, i, boxes[6 * ibox + i], boxes[6 * ibox + 3 + i], first + i, last + i);
+      }
+      for (int iz = first[2]; iz <= last[2]; iz++) {
+        for (int iy = first[1]; iy <= last[1]; iy++) {
+          for (int ix = first[0]; ix <= last[0]; ix++) {
+            const size_t ibin = ((size_t) iz * grid->num_bins[1] + iy) * grid->num_bins[0] + ix;
+            if (pass == 0) {
+              grid->offsets[ibin + 1]++;
+            }
+            else {
+              grid->box_ids[fill[ibin]++] = ibox;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+/* Return the bounding boxes of the local trees of all processes.
+ * They are gathered on the first call and stored in the forest.
+ * This function is collective on the first call. */
+static const t8_forest_locate_boxes_t *
+t8_forest_locate_get_boxes (t8_forest_t forest)
+{
+  if (forest->locate_boxes != NULL) {
+    return forest->locate_boxes;
+  }
+  const sc_MPI_Comm comm = t8_forest_get_mpicomm (forest);
+  int mpisize, mpiret;
+  mpiret = sc_MPI_Comm_size (comm, &mpisize);
+  SC_CHECK_MPI (mpiret);
+
+  /* Gather the bounding boxes of the local trees of all processes. */
+  std::vector<double> local_boxes;
+  t8_forest_locate_bounding_boxes (forest, local_boxes);
+  std::vector<int> box_counts (mpisize), box_displs (mpisize + 1, 0);
+  int local_box_count = local_boxes.size ();
+  mpiret = sc_MPI_Allgather (&local_box_count, 1, sc_MPI_INT, box_counts.data (), 1, sc_MPI_INT, comm);
+  SC_CHECK_MPI (mpiret);
+  for (int irank = 0; irank < mpisize; irank++) {
+    box_displs[irank + 1] = box_displs[irank] + box_counts[irank];
+  }
+
+  t8_forest_locate_boxes_t *grid = T8_ALLOC_ZERO (t8_forest_locate_boxes_t, 1);
+  grid->num_boxes = box_displs[mpisize] / 6;
+  grid->boxes = T8_ALLOC (double, box_displs[mpisize]);
+  mpiret = sc_MPI_Allgatherv (local_boxes.data (), local_box_count, sc_MPI_DOUBLE, grid->boxes, box_counts.data (),
+                              box_displs.data (), sc_MPI_DOUBLE, comm);
+  SC_CHECK_MPI (mpiret);
+  grid->box_ranks = T8_ALLOC (int, grid->num_boxes);
+  for (int irank = 0; irank < mpisize; irank++) {
+    std::fill (grid->box_ranks + box_displs[irank] / 6, grid->box_ranks + box_displs[irank + 1] / 6, irank);
+  }
+  if (grid->num_boxes > 0) {
+    t8_forest_locate_grid_build (grid);
+  }
+  forest->locate_boxes = grid;
+  return grid;
+}
+
+void
+t8_forest_locate_boxes_destroy (t8_forest_t forest)
+{
+  t8_forest_locate_boxes_t *grid = forest->locate_boxes;
+
+  if (grid == NULL) {
+    return;
+  }
+  T8_FREE (grid->boxes);
+  T8_FREE (grid->box_ranks);
+  T8_FREE (grid->offsets);
+  T8_FREE (grid->box_ids);
+  T8_FREE (grid);
+  forest->locate_boxes = NULL;
+}
+
+void
+t8_forest_locate_points (t8_forest_t forest, const double *points, const size_t num_points, const double tolerance,
+                         t8_forest_point_location_t *locations)
+{
+  T8_ASSERT (t8_forest_is_committed (forest));
+  T8_ASSERT (num_points == 0 || points != NULL);
+  T8_ASSERT (num_points == 0 || locations != NULL);
+  T8_ASSERT (tolerance >= 0);
+
+  const sc_MPI_Comm comm = t8_forest_get_mpicomm (forest);
+  int mpisize, mpirank, mpiret;
+  mpiret = sc_MPI_Comm_size (comm, &mpisize);
+  SC_CHECK_MPI (mpiret);
+  mpiret = sc_MPI_Comm_rank (comm, &mpirank);
+  SC_CHECK_MPI (mpiret);
+
+  for (size_t ipoint = 0; ipoint < num_points; ipoint++) {
+    locations[ipoint].rank = -1;
+    locations[ipoint].element_index = -1;
+    locations[ipoint].ref_coords[0] = locations[ipoint].ref_coords[1] = locations[ipoint].ref_coords[2] = 0;
+  }
+
+  /* Get the bounding boxes of the local trees of all processes. */
+  const t8_forest_locate_boxes_t *grid = t8_forest_locate_get_boxes (forest);
+  if (grid->num_boxes == 0) {
+    /* The forest is empty. */
+    return;
+  }
+  const double *boxes = grid->boxes;
+
+  /* For each point determine the processes whose boxes, enlarged by the tolerance, contain it. */
+  std::vector<std::vector<size_t>> send_points (mpisize);
+  std::vector<int> candidates;
+  for (size_t ipoint = 0; ipoint < num_points; ipoint++) {
+    const double *point = points + 3 * ipoint;
+    int first[3], last[3];
+    int outside = 0;
+    for (int i = 0; i < 3; i++) {
+      outside = outside || point[i] < grid->lower[i] - tolerance
+                || point[i] > grid->lower[i] + grid->width[i] + tolerance;
+      t8_forest_locate_grid_range (grid, i, point[i] - tolerance, point[i] + tolerance, first + i, last + i);
+    }
+    if (outside) {
+      continue;
+    }
+    candidates.clear ();
+    for (int iz = first[2]; iz <= last[2]; iz++) {
+      for (int iy = first[1]; iy <= last[1]; iy++) {
+        for (int ix = first[0]; ix <= last[0]; ix++) {
+          const size_t ibin = ((size_t) iz * grid->num_bins[1] + iy) * grid->num_bins[0] + ix;
+          for (size_t ientry = grid->offsets[ibin]; ientry < grid->offsets[ibin + 1]; ientry++) {
+            const size_t ibox = grid->box_ids[ientry];
+            int inside = 1;
+            for (int i = 0; i < 3 && inside; i++) {
+              inside = boxes[6 * ibox + i] - tolerance <= point[i] && point[i] <= boxes[6 * ibox + 3 + i] + tolerance;
+            }
+            if (inside) {
+              candidates.push_back (grid->box_ranks[ibox]);
+            }
+          }
+        }
+      }
+    }
+    std::sort (candidates.begin (), candidates.end ());
+    candidates.erase (std::unique (candidates.begin (), candidates.end ()), candidates.end ());
+    for (const int irank : candidates) {
+      send_points[irank].push_back (ipoint);
+    }
+  }
+
+  /* Find the processes that send points to us. Since a process only sends to the few processes
+   * whose boxes contain its points, we do not exchange counts with all processes. */
+  std::vector<int> send_counts (mpisize), recv_counts (mpisize, 0), recv_offsets (mpisize + 1, 0);
+  std::vector<int> receivers, senders (mpisize);
+  int num_senders;
+  for (int irank = 0; irank < mpisize; irank++) {
+    send_counts[irank] = send_points[irank].size ();
+    if (irank != mpirank && send_counts[irank] > 0) {
+      receivers.push_back (irank);
+    }
+  }
+  sc_notify (receivers.data (), (int) receivers.size (), senders.data (), &num_senders, comm);
+  senders.resize (num_senders);
+  if (send_counts[mpirank] > 0) {
+    senders.insert (std::upper_bound (senders.begin (), senders.end (), mpirank), mpirank);
+  }
+
+  /* Send the points */
+  std::vector<std::vector<double>> send_coords (mpisize);
+  std::vector<sc_MPI_Request> requests;
+  requests.reserve (2 * mpisize);
+  for (int irank = 0; irank < mpisize; irank++) {
+    send_coords[irank].reserve (3 * send_counts[irank]);
+    for (const size_t ipoint : send_points[irank]) {
+      send_coords[irank].insert (send_coords[irank].end (), points + 3 * ipoint, points + 3 * ipoint + 3);
+    }
+    if (irank != mpirank && send_counts[irank] > 0) {
+      requests.emplace_back ();
+      mpiret = sc_MPI_Isend (send_coords[irank].data (), 3 * send_counts[irank], sc_MPI_DOUBLE, irank,
+                             T8_MPI_LOCATE_POINTS, comm, &requests.back ());
+      SC_CHECK_MPI (mpiret);
+    }
+  }
+  /* Receive the points in order of the senders' ranks. The probe tells us the number of points. */
+  std::vector<double> recv_coords;
+  for (const int irank : senders) {
+    if (irank == mpirank) {
+      recv_counts[irank] = send_counts[irank];
+      recv_coords.insert (recv_coords.end (), send_coords[irank].begin (), send_coords[irank].end ());
+    }
+    else {
+      sc_MPI_Status status;
+      int num_doubles;
+      mpiret = sc_MPI_Probe (irank, T8_MPI_LOCATE_POINTS, comm, &status);
+      SC_CHECK_MPI (mpiret);
+      mpiret = sc_MPI_Get_count (&status, sc_MPI_DOUBLE, &num_doubles);
+      SC_CHECK_MPI (mpiret);
+      T8_ASSERT (num_doubles % 3 == 0);
+      recv_counts[irank] = num_doubles / 3;
+      recv_coords.resize (recv_coords.size () + num_doubles);
+      mpiret = sc_MPI_Recv (recv_coords.data () + recv_coords.size () - num_doubles, num_doubles, sc_MPI_DOUBLE,
+                            irank, T8_MPI_LOCATE_POINTS, comm, sc_MPI_STATUS_IGNORE);
+      SC_CHECK_MPI (mpiret);
+    }
+  }
+  for (int irank = 0; irank < mpisize; irank++) {
+    recv_offsets[irank + 1] = recv_offsets[irank] + recv_counts[irank];
+  }
+  const size_t num_recv_points = recv_offsets[mpisize];
+  T8_ASSERT (recv_coords.size () == 3 * num_recv_points);
+  mpiret = sc_MPI_Waitall (requests.size (), requests.data (), sc_MPI_STATUSES_IGNORE);
+  SC_CHECK_MPI (mpiret);
+  requests.clear ();
+
+  /* Search all received points at once in the local leaves. */
+  sc_array_t queries;
+  sc_array_init_size (&queries, sizeof (t8_forest_locate_query_t), num_recv_points);
+  for (size_t iquery = 0; iquery < num_recv_points; iquery++) {
+    t8_forest_locate_query_t *query = (t8_forest_locate_query_t *) sc_array_index (&queries, iquery);
+    std::copy (recv_coords.begin () + 3 * iquery, recv_coords.begin () + 3 * iquery + 3, query->point);
+    query->tolerance = tolerance;
+    query->element_index = -1;
+  }
+  if (num_recv_points > 0) {
+    t8_forest_search (forest, t8_forest_locate_points_search_fn, t8_forest_locate_points_query_fn, &queries);
+  }
+  std::vector<t8_forest_locate_result_t> results (num_recv_points);
+  for (size_t iquery = 0; iquery < num_recv_points; iquery++) {
+    const t8_forest_locate_query_t *query = (const t8_forest_locate_query_t *) sc_array_index (&queries, iquery);
+    results[iquery].element_index = query->element_index;
+    std::copy (query->ref_coords, query->ref_coords + 3, results[iquery].ref_coords);
+  }
+  sc_array_reset (&queries);
+
+  /* Send the results back in the order in which the points were received. */
+  std::vector<size_t> answer_offsets (mpisize + 1, 0);
+  for (int irank = 0; irank < mpisize; irank++) {
+    answer_offsets[irank + 1] = answer_offsets[irank] + send_counts[irank];
+  }
+  std::vector<t8_forest_locate_result_t> answers (answer_offsets[mpisize]);
+  for (int irank = 0; irank < mpisize; irank++) {
+    if (irank == mpirank) {
+      std::copy (results.begin () + recv_offsets[irank], results.begin () + recv_offsets[irank + 1],
+                 answers.begin () + answer_offsets[irank]);
+      continue;
+    }
+    if (send_counts[irank] > 0) {
+      requests.emplace_back ();
+      mpiret = sc_MPI_Irecv (answers.data () + answer_offsets[irank],
+                             send_counts[irank] * sizeof (t8_forest_locate_result_t), sc_MPI_BYTE, irank,
+                             T8_MPI_LOCATE_POINTS_RESULT, comm, &requests.back ());
+      SC_CHECK_MPI (mpiret);
+    }
+    if (recv_counts[irank] > 0) {
+      requests.emplace_back ();
+      mpiret = sc_MPI_Isend (results.data () + recv_offsets[irank],
+                             recv_counts[irank] * sizeof (t8_forest_locate_result_t), sc_MPI_BYTE, irank,
+                             T8_MPI_LOCATE_POINTS_RESULT, comm, &requests.back ());
+      SC_CHECK_MPI (mpiret);
+    }
+  }
+  mpiret = sc_MPI_Waitall (requests.size (), requests.data (), sc_MPI_STATUSES_IGNORE);
+  SC_CHECK_MPI (mpiret);
+
+  /* Assign each point to the smallest rank that found it. */
+  for (int irank = 0; irank < mpisize; irank++) {
+    for (size_t isent = 0; isent < send_points[irank].size (); isent++) {
+      const t8_forest_locate_result_t *answer = &answers[answer_offsets[irank] + isent];
+      t8_forest_point_location_t *location = locations + send_points[irank][isent];
+      if (location->rank < 0 && answer->element_index >= 0) {
+        location->rank = irank;
+        location->element_index = answer->element_index;
+        std::copy (answer->ref_coords, answer->ref_coords + 3, location->ref_coords);
+      }
+    }
+  }
+}
+
+T8_EXTERN_C_END ();
@@ -0,0 +1,78 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/** \file t8_forest_point_location.h
+ * We define a collective routine to locate points in a distributed forest.
+ * Each process passes an arbitrary batch of points, which may lie in elements
+ * of other processes.
+ */
+
+#ifndef T8_FOREST_POINT_LOCATION_H
+#define T8_FOREST_POINT_LOCATION_H
+
+#include <t8.h>
+#include <t8_forest/t8_forest_general.h>
+
+/** The location of a point in a forest. \see t8_forest_locate_points */
+typedef struct
+{
+  int rank;                  /**< The process owning the leaf that contains the point. -1 if there is no such leaf. */
+  t8_locidx_t element_index; /**< The local index of the leaf on process \a rank. -1 if there is no such leaf. */
+  double ref_coords[3];      /**< The reference coordinates of the point in the leaf. Only the first
+                                  dim entries are used, where dim is the dimension of the leaf. */
+} t8_forest_point_location_t;
+
+T8_EXTERN_C_BEGIN ();
+
+/** Locate a batch of points in a forest.
+ * Each process passes its own points, which may lie in leaves of any process.
+ * Each process first computes a bounding box of the leaves of each of its local trees.
+ * These boxes are gathered on all processes and each point is sent to those processes
+ * whose boxes, enlarged by \a tolerance, contain the point. The boxes are computed on the first
+ * call and stored in the forest, such that later calls with the same forest only communicate
+ * with the processes that receive or send points. There, the point is searched with \ref t8_forest_search
+ * in the local leaves and its reference coordinates are computed. The results are
+ * sent back to the process that passed the point.
+ * If a point lies on the boundary of multiple leaves, the leaf on the smallest rank
+ * and within a rank the first leaf along the space-filling curve is returned.
+ * \param [in]      forest      The forest. Must be committed. The geometry of all trees
+ *                              must support \ref t8_forest_element_points_inside.
+ * \param [in]      points      The 3-dimensional coordinates of the points, x y z for each point.
+ * \param [in]      num_points  The number of points on this process.
+ * \param [in]      tolerance   The tolerance passed to \ref t8_forest_element_points_inside.
+ *                              The bounding boxes are enlarged by this value.
+ * \param [out]     locations   An array of length \a num_points. On output the location of each point.
+ * \note This function is collective and must be called on each process of the forest's communicator.
+ * \note The bounding boxes of trees with a linear geometry are computed from the vertices of the leaves.
+ *       For other geometries, the geometry is evaluated at the corners, at the midpoints between the
+ *       corners and at the center of each leaf, and the box is padded by the deviation of the midpoints
+ *       from the straight lines between the corners.
+ * \note The reference coordinates are computed by a Gauss-Newton iteration. It uses the Jacobian of
+ *       Lagrange and CAD geometries and a finite difference approximation for the other geometries.
+ */
+void
+t8_forest_locate_points (t8_forest_t forest, const double *points, const size_t num_points, const double tolerance,
+                         t8_forest_point_location_t *locations);
+
+T8_EXTERN_C_END ();
+
+#endif /* !T8_FOREST_POINT_LOCATION_H */
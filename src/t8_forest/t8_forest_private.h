@@ -68,6 +68,25 @@ t8_forest_compute_desc (t8_forest_t forest);
 void
 t8_forest_populate (t8_forest_t forest);
 
+/** Construct the face neighbor of an element in a tree of the coarse mesh, possibly across tree boundaries.
+ * In contrast to \ref t8_forest_element_face_neighbor the tree does not need to be a local tree
+ * of the forest. It must be a local tree of the forest's coarse mesh.
+ * \param [in] forest       The forest.
+ * \param [in] lctree_id    The local id of the tree of \a elem in the coarse mesh of \a forest.
+ * \param [in] elem         The element to be considered.
+ * \param [in,out] neigh    On input an allocated element of the scheme of the face neighbor's eclass.
+ *                          On output, the face neighbor of \a elem across \a face.
+ * \param [in] neigh_scheme The eclass scheme of \a neigh.
+ * \param [in] face         The number of the face along which the neighbor should be constructed.
+ * \param [out] neigh_face  The number of the face viewed from perspective of \a neigh.
+ * \return The global tree-id of the tree in which \a neigh is in.
+ *        -1 if there exists no neighbor across that face.
+ */
+t8_gloidx_t
+t8_forest_element_face_neighbor_cmesh_tree (t8_forest_t forest, t8_locidx_t lctree_id, const t8_element_t *elem,
+                                            t8_element_t *neigh, t8_eclass_scheme_c *neigh_scheme, int face,
+                                            int *neigh_face);
+
 /** Return the eclass scheme of a given element class associated to a forest.
  * This function does not check whether the given forest is committed, use with
  * caution and only if you are sure that the eclass_scheme was set.
@@ -124,6 +143,57 @@ t8_forest_first_tree_shared (t8_forest_t forest);
 int
 t8_forest_last_tree_shared (t8_forest_t forest);
 
+/** Create the trees and elements of a forest from the checkpoint file set with
+ * \ref t8_forest_set_load. Each process reads its own range of elements.
+ * \param [in,out] forest    The forest. Its cmesh, scheme, communicator and
+ *                           maximum level must be set.
+ */
+void
+t8_forest_load_checkpoint (t8_forest_t forest);
+
+/** A face neighbor leaf found by \ref t8_forest_leaf_face_neighbors_in_array. */
+typedef struct
+{
+  const t8_element_t *leaf; /**< The neighbor leaf */
+  t8_locidx_t index;        /**< Its index in the leaf array it was found in, plus the index offset */
+  int dual_face;            /**< Its face that touches the original leaf */
+} t8_forest_leaf_face_neighbor_t;
+
+/** Find the leaves in a sorted leaf array that are face neighbors across the face
+ * \a dual_face of \a neighbor, the same level face neighbor of a leaf.
+ * These are either a single leaf that is \a neighbor or one of its ancestors, or
+ * the descendants of \a neighbor that touch \a dual_face.
+ * \param [in]      forest        The forest.
+ * \param [in]      ts            The scheme of the leaves.
+ * \param [in]      neighbor      The same level face neighbor.
+ * \param [in]      dual_face     The face of \a neighbor that touches the leaf.
+ * \param [in]      leaves        The leaves of a local or a ghost tree, sorted along the SFC.
+ * \param [in]      lower         The index of the last leaf in \a leaves whose linear id is smaller or equal to
+ *                                the one of \a neighbor, or -1 if there is none, as returned by
+ *                                \ref t8_forest_bin_search_lower. If smaller than -1, it is computed here.
+ * \param [in]      index_offset  Added to the indices of the found leaves.
+ * \param [in,out]  neighbors     An array of \ref t8_forest_leaf_face_neighbor_t to which the found leaves
+ *                                are appended.
+ */
+void
+t8_forest_leaf_face_neighbors_in_array (t8_forest_t forest, t8_eclass_scheme_c *ts, const t8_element_t *neighbor,
+                                        const int dual_face, t8_element_array_t *leaves, t8_locidx_t lower,
+                                        const t8_locidx_t index_offset, sc_array_t *neighbors);
+
+/** Free the face neighbor table of a forest, if it was computed.
+ * \param [in,out] forest  The forest.
+ * \see t8_forest_get_face_connectivity
+ */
+void
+t8_forest_face_connectivity_destroy (t8_forest_t forest);
+
+/** Free the bounding boxes used to locate points in a forest, if they were computed.
+ * \param [in,out] forest  The forest.
+ * \see t8_forest_locate_points
+ */
+void
+t8_forest_locate_boxes_destroy (t8_forest_t forest);
+
 /* Allocate memory for trees and set their values as in from.
  * For each tree allocate enough element memory to fit the elements of from.
  * If copy_elements is true, copy the elements of from into the element memory.
@@ -406,6 +476,17 @@ int
 t8_forest_element_has_leaf_desc (t8_forest_t forest, t8_gloidx_t gtreeid, const t8_element_t *element,
                                  t8_eclass_scheme_c *ts);
 
+/** Search for a linear element id (at level \a maxlevel) in a sorted array of elements.
+ * \param [in]  elements   A sorted, nonempty array of elements.
+ * \param [in]  element_id The linear id to search for.
+ * \param [in]  maxlevel   The level at which \a element_id was computed.
+ * \return                 The index of the element with id \a element_id. If it does not exist,
+ *                         the largest index i such that the element at position i has a smaller id.
+ *                         -1 if no such i exists.
+ */
+t8_locidx_t
+t8_forest_bin_search_lower (t8_element_array_t *elements, t8_linearidx_t element_id, int maxlevel);
+
 T8_EXTERN_C_END ();
 
 #endif /* !T8_FOREST_PRIVATE_H */
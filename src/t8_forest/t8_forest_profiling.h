@@ -121,6 +121,22 @@ t8_forest_profile_get_balance_time (t8_forest_t forest, int *balance_rounds);
 double
 t8_forest_profile_get_ghost_time (t8_forest_t forest, t8_locidx_t *ghosts_sent);
 
+/** Get the runtime of the last call to \ref t8_forest_create_ghosts broken down into its phases.
+ * \param [in]   forest           The forest.
+ * \param [out]  search_time      On output the time spent finding the remote elements.
+ * \param [out]  pack_time        On output the time spent packing the remote elements.
+ * \param [out]  communicate_time On output the time spent in communication.
+ * \param [out]  unpack_time      On output the time spent unpacking the received ghost elements.
+ * \return                        The runtime of ghost if profiling was activated.
+ *                                0 otherwise, in which case all phase times are 0 as well.
+ * \a forest must be committed before calling this function.
+ * \see t8_forest_set_profiling
+ * \see t8_forest_set_ghost
+ */
+double
+t8_forest_profile_get_ghost_phase_times (t8_forest_t forest, double *search_time, double *pack_time,
+                                         double *communicate_time, double *unpack_time);
+
 /** Get the waittime of the last call to \ref t8_forest_ghost_exchange_data.
  * \param [in]   forest         The forest.
  * \return                      The time of ghost_exchange_data that was spent waiting
@@ -38,6 +38,7 @@
 
 typedef struct t8_profile t8_profile_t;            /* Defined below */
 typedef struct t8_forest_ghost *t8_forest_ghost_t; /* Defined below */
+typedef struct t8_ghost_exchange_plan *t8_ghost_exchange_plan_t; /* Defined in t8_forest_ghost.cxx */
 
 /** If a forest is to be derived from another forest, there are different
  * possibilities how the original forest is modified.
@@ -62,7 +63,7 @@ typedef int8_t t8_forest_from_t;
 #define T8_FOREST_BALANCE_NO_REPART 2 /**< Value of forest->set_balance if balancing without repartitioning */
 
 /** The number of statistics collected by a profile struct. */
-#define T8_PROFILE_NUM_STATS 14
+#define T8_PROFILE_NUM_STATS 21
 
 /** This structure is private to the implementation. */
 typedef struct t8_forest
@@ -73,6 +74,9 @@ typedef struct t8_forest
   int set_for_coarsening; /**< Change partition to allow
                                                      for one round of coarsening */
 
+  t8_forest_partition_weight_t set_partition_weight_fn; /**< If not NULL, the element weights used for partition.
+                                                          \see t8_forest_set_partition_weight_function */
+
   sc_MPI_Comm mpicomm; /**< MPI communicator to use. */
   t8_cmesh_t cmesh;    /**< Coarse mesh to use. */
   //t8_scheme_t        *scheme;        /**< Scheme for element types. */
@@ -88,6 +92,8 @@ typedef struct t8_forest
                                              false on all ranks. */
 
   t8_forest_t set_from;           /**< Temporarily store source forest. */
+  char *set_load_filename;        /**< If not NULL, the checkpoint file to load the forest from.
+                                             \see t8_forest_set_load */
   t8_forest_from_t from_method;   /**< Method to derive from \b set_from. */
   t8_forest_adapt_t set_adapt_fn; /**< refinement and coarsen function. Called when \b from_method
                                              is set to T8_FOREST_FROM_ADAPT. */
@@ -97,10 +103,15 @@ typedef struct t8_forest
                                              See \ref t8_forest_set_balance.
                                              If 0, no balance. If 1 balance with repartitioning, if 2 balance without
                                              repartitioning, \see t8_forest_balance */
+  int set_balance_onepass;        /**< If true, balance uses the one-pass algorithm.
+                                             \see t8_forest_set_balance_onepass */
+  int num_threads;                /**< The number of threads used to adapt or populate the forest.
+                                             \see t8_forest_set_num_threads */
   int do_ghost;                   /**< If True, a ghost layer will be created when the forest is committed. */
   t8_ghost_type_t ghost_type;     /**< If a ghost layer will be created, the type of neighbors that count as ghost. */
   int ghost_algorithm;            /**< Controls the algorithm used for ghost. 1 = balanced only. 2 = also unbalanced
                                              3 = top-down search and unbalanced. */
+  int ghost_width;                /**< The number of layers of ghost elements. \see t8_forest_set_ghost_ext */
   void *user_data;                /**< Pointer for arbitrary user data. \see t8_forest_set_user_data. */
   void (*user_function) ();       /**< Pointer for arbitrary user function. \see t8_forest_set_user_function. */
   void *t8code_data;              /**< Pointer for arbitrary data that is used internally. */
@@ -136,6 +147,10 @@ typedef struct t8_forest
   t8_profile_t *profile;           /**< If not NULL, runtimes and statistics about forest_commit are stored here. */
   sc_statinfo_t stats[T8_PROFILE_NUM_STATS];
   int stats_computed;
+  struct t8_forest_face_connectivity *face_connectivity; /**< If not NULL, the face neighbors of the local leaves.
+                                                              \see t8_forest_get_face_connectivity */
+  struct t8_forest_locate_boxes *locate_boxes; /**< If not NULL, the bounding boxes of the local trees of all
+                                                    processes. \see t8_forest_locate_points */
 } t8_forest_struct_t;
 
 /** The t8 tree datatype */
@@ -158,7 +173,7 @@ typedef struct t8_tree
  */
 
 /** The number of statistics collected by a profile struct. */
-#define T8_PROFILE_NUM_STATS 14
+#define T8_PROFILE_NUM_STATS 21
 typedef struct t8_profile
 {
   t8_locidx_t partition_elements_shipped; /**< The number of elements this process has
@@ -181,7 +196,21 @@ typedef struct t8_profile
                                                   partition in t8_forest_balance). */
   double ghost_runtime;     /**< The runtime of the last call to \a t8_forest_ghost_create. */
   double ghost_waittime;    /**< Amount of synchronisation time in ghost. */
+  double ghost_search_runtime;      /**< The time of the last call to \a t8_forest_ghost_create spent finding
+                                                  the remote elements, including growing the layer to its width. */
+  double ghost_pack_runtime;        /**< The time of the last call to \a t8_forest_ghost_create spent packing
+                                                  the remote elements into the send buffer. */
+  double ghost_communicate_runtime; /**< The time of the last call to \a t8_forest_ghost_create spent in
+                                                  communication. */
+  double ghost_unpack_runtime;      /**< The time of the last call to \a t8_forest_ghost_create spent unpacking
+                                                  the received ghost elements. */
   double balance_runtime;   /**< The runtime of the last call to \a t8_forest_balance. */
+  double balance_adapt_runtime;     /**< The accumulated adapt runtime of all rounds in the last call to
+                                                  \a t8_forest_balance. */
+  double balance_ghost_runtime;     /**< The accumulated ghost runtime of all rounds in the last call to
+                                                  \a t8_forest_balance. */
+  double balance_partition_runtime; /**< The accumulated partition runtime of all rounds in the last call to
+                                                  \a t8_forest_balance. */
   double commit_runtime;    /**< The runtime of the last call to \a t8_cmesh_commit. */
 
 } t8_profile_struct_t;
@@ -214,6 +243,10 @@ typedef struct t8_forest_ghost
 
   sc_mempool_t *glo_tree_mempool;
   sc_mempool_t *proc_offset_mempool;
+
+  t8_ghost_exchange_plan_t exchange_plan; /**< The precomputed send/receive lists and persistent communication
+                                                for ghost data exchange. Built on the first call to
+                                                \ref t8_forest_ghost_exchange_begin, NULL before. */
 } t8_forest_ghost_struct_t;
 
 #endif /* ! T8_FOREST_TYPES_H */
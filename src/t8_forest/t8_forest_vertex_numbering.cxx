@@ -0,0 +1,462 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+#include <t8_forest/t8_forest_vertex_numbering.h>
+#include <t8_forest/t8_forest_types.h>
+#include <t8_forest/t8_forest_geometrical.h>
+#include <t8_eclass.h>
+#include <t8_element.h>
+#include <t8_element_cxx.hxx>
+#include <algorithm>
+#include <vector>
+
+/* The number of bins per coordinate direction used to quantize the vertices.
+ * Vertices closer than (max_coord - min_coord) / T8_FOREST_VERTEX_NUMBERING_NUM_BINS might be identified. */
+#define T8_FOREST_VERTEX_NUMBERING_NUM_BINS 1073741824.0 /* 2^30 */
+
+/* The points of a leaf are its corners and, if we look for hanging vertices, its midpoints.
+ * These are the midpoints of the edges and the centers of the quadrilateral faces,
+ * at which the children of the leaf have corners. */
+#define T8_FOREST_VERTEX_CORNER 1
+#define T8_FOREST_VERTEX_MIDPOINT 2
+
+/* The entry of the hash tables that marks an empty slot. */
+#define T8_FOREST_VERTEX_EMPTY_SLOT ((size_t) -1)
+
+/* A point together with its quantized coordinates. */
+typedef struct
+{
+  uint32_t coords[3]; /* The quantized coordinates. */
+  uint32_t flags;     /* Whether the point is a corner or a midpoint of a leaf, or both. */
+} t8_forest_vertex_key_t;
+
+/* The answer of the process that collects a point to a process that has the point. */
+typedef struct
+{
+  int owner;      /* The lowest process with a leaf that has the point as a corner, -1 if there is none. */
+  int is_hanging; /* True if the point is a corner of a leaf and a midpoint of another leaf. */
+} t8_forest_vertex_owner_t;
+
+/* Send the entries send_offsets[irank], ..., send_offsets[irank + 1] - 1 of send to each process irank
+ * and receive the entries recv_offsets[irank], ..., recv_offsets[irank + 1] - 1 of recv from each process irank.
+ * All rounds of the numbering use the same tag. Since each round is completed before the next one is
+ * started and messages between two processes do not overtake each other, they cannot be confused. */
+template <typename T>
+static void
+t8_forest_vertex_exchange (const std::vector<T> &send, const std::vector<int> &send_offsets, std::vector<T> &recv,
+                           const std::vector<int> &recv_offsets, sc_MPI_Comm comm)
+{
+  const int mpisize = send_offsets.size () - 1;
+  std::vector<sc_MPI_Request> requests;
+  int mpiret;
+
+  recv.resize (recv_offsets[mpisize]);
+  for (int irank = 0; irank < mpisize; irank++) {
+    const int count = recv_offsets[irank + 1] - recv_offsets[irank];
+    if (count > 0) {
+      requests.emplace_back ();
+      mpiret = sc_MPI_Irecv (recv.data () + recv_offsets[irank], sizeof (T) * count, sc_MPI_BYTE, irank,
+                             T8_MPI_VERTEX_NUMBERING, comm, &requests.back ());
+      SC_CHECK_MPI (mpiret);
+    }
+  }
+  for (int irank = 0; irank < mpisize; irank++) {
+    const int count = send_offsets[irank + 1] - send_offsets[irank];
+    if (count > 0) {
+      requests.emplace_back ();
+      mpiret = sc_MPI_Isend ((void *) (send.data () + send_offsets[irank]), sizeof (T) * count, sc_MPI_BYTE, irank,
+                             T8_MPI_VERTEX_NUMBERING, comm, &requests.back ());
+      SC_CHECK_MPI (mpiret);
+    }
+  }
+  mpiret = sc_MPI_Waitall (requests.size (), requests.data (), sc_MPI_STATUSES_IGNORE);
+  SC_CHECK_MPI (mpiret);
+}
+
+T8_EXTERN_C_BEGIN ();
+
+/* Mix the bits of a 64-bit integer (the finalizer of splitmix64). */
+static inline uint64_t
+t8_forest_vertex_mix (uint64_t x)
+{
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+/* Compute the hash of the quantized coordinates of a point. */
+static inline uint64_t
+t8_forest_vertex_hash (const t8_forest_vertex_key_t *key)
+{
+  uint64_t hash = 3;
+  for (int icoord = 0; icoord < 3; icoord++) {
+    hash = t8_forest_vertex_mix (hash ^ key->coords[icoord]);
+  }
+  return hash;
+}
+
+/* Return the size of a hash table for up to num_keys keys, the smallest power of two that is at least 2 * num_keys. */
+static size_t
+t8_forest_vertex_table_size (const size_t num_keys)
+{
+  size_t size = 2;
+  while (size < 2 * num_keys) {
+    size *= 2;
+  }
+  return size;
+}
+
+/* Find a point in an open-addressing hash table with linear probing that stores indices into keys.
+ * If there is no point with the same coordinates, append the point to keys. Otherwise, merge the flags
+ * of the point into the found point. Return the index of the point in keys.
+ * The table must have more slots than the final number of keys. */
+static size_t
+t8_forest_vertex_table_insert (std::vector<size_t> &table, std::vector<t8_forest_vertex_key_t> &keys,
+                               const t8_forest_vertex_key_t &key)
+{
+  const size_t mask = table.size () - 1;
+  size_t slot = t8_forest_vertex_hash (&key) & mask;
+
+  while (table[slot] != T8_FOREST_VERTEX_EMPTY_SLOT) {
+    t8_forest_vertex_key_t *other = &keys[table[slot]];
+    if (std::equal (key.coords, key.coords + 3, other->coords)) {
+      other->flags |= key.flags;
+      return table[slot];
+    }
+    slot = (slot + 1) & mask;
+  }
+  table[slot] = keys.size ();
+  keys.push_back (key);
+  return table[slot];
+}
+
+/* Compute the element reference coordinates of the points of an element shape. These are
+ * the corners in the t8code corner order, followed by the midpoints if midpoints is true. */
+static void
+t8_forest_vertex_ref_coords (const int shape, const int midpoints, std::vector<double> &ref_coords)
+{
+  const int num_corners = t8_eclass_num_vertices[shape];
+  const int dim = t8_eclass_to_dimension[shape];
+  auto add_center = [&ref_coords, shape] (const int *corners, const int num_center_corners) {
+    for (int icoord = 0; icoord < 3; icoord++) {
+      double sum = 0;
+      for (int icorner = 0; icorner < num_center_corners; icorner++) {
+        sum += t8_element_corner_ref_coords[shape][corners[icorner]][icoord];
+      }
+      ref_coords.push_back (sum / num_center_corners);
+    }
+  };
+
+  ref_coords.assign (t8_element_corner_ref_coords[shape][0], t8_element_corner_ref_coords[shape][0] + 3 * num_corners);
+  if (!midpoints) {
+    return;
+  }
+  if (dim == 1) {
+    const int line_corners[2] = { 0, 1 };
+    add_center (line_corners, 2);
+  }
+  else if (dim > 1) {
+    for (int iedge = 0; iedge < t8_eclass_num_edges[shape]; iedge++) {
+      add_center (t8_edge_vertex_to_tree_vertex[shape][iedge], 2);
+    }
+  }
+  if (dim == 3) {
+    for (int iface = 0; iface < t8_eclass_num_faces[shape]; iface++) {
+      if (t8_eclass_face_types[shape][iface] == T8_ECLASS_QUAD) {
+        add_center (t8_face_vertex_to_tree_vertex[shape][iface], 4);
+      }
+    }
+  }
+}
+
+t8_forest_vertex_numbering_t *
+t8_forest_vertex_numbering_new (t8_forest_t forest, int mark_hanging)
+{
+  T8_ASSERT (t8_forest_is_committed (forest));
+  const sc_MPI_Comm comm = forest->mpicomm;
+  const int mpisize = forest->mpisize;
+  const int mpirank = forest->mpirank;
+  const t8_locidx_t num_elements = t8_forest_get_local_num_elements (forest);
+  const t8_locidx_t num_local_trees = t8_forest_get_num_local_trees (forest);
+  t8_forest_vertex_numbering_t *numbering = T8_ALLOC (t8_forest_vertex_numbering_t, 1);
+  int mpiret;
+
+  std::vector<double> ref_coords[T8_ECLASS_COUNT];
+  for (int ishape = 0; ishape < T8_ECLASS_COUNT; ishape++) {
+    t8_forest_vertex_ref_coords (ishape, mark_hanging, ref_coords[ishape]);
+  }
+
+  /* Compute the coordinates of the points of all local leaves. */
+  numbering->num_elements = num_elements;
+  numbering->element_offsets = T8_ALLOC (t8_locidx_t, num_elements + 1);
+  numbering->element_offsets[0] = 0;
+  std::vector<size_t> point_offsets (num_elements + 1, 0);
+  std::vector<double> coords;
+  for (t8_locidx_t itree = 0, ielement = 0; itree < num_local_trees; itree++) {
+    const t8_locidx_t num_tree_elements = t8_forest_get_tree_num_elements (forest, itree);
+    t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, t8_forest_get_tree_class (forest, itree));
+    for (t8_locidx_t ielem_tree = 0; ielem_tree < num_tree_elements; ielem_tree++, ielement++) {
+      const t8_element_t *leaf = t8_forest_get_element_in_tree (forest, itree, ielem_tree);
+      const t8_element_shape_t shape = ts->t8_element_shape (leaf);
+      const size_t num_points = ref_coords[shape].size () / 3;
+      point_offsets[ielement + 1] = point_offsets[ielement] + num_points;
+      coords.resize (3 * point_offsets[ielement + 1]);
+      t8_forest_element_from_ref_coords (forest, itree, leaf, ref_coords[shape].data (), num_points,
+                                         coords.data () + 3 * point_offsets[ielement]);
+      numbering->element_offsets[ielement + 1] = numbering->element_offsets[ielement] + t8_eclass_num_vertices[shape];
+    }
+  }
+
+  /* The bounds of all coordinates of all processes. We negate the minimum to compute both with one reduction. */
+  double local_bounds[2] = { -1e300, -1e300 }, bounds[2];
+  for (const double coord : coords) {
+    local_bounds[0] = SC_MAX (local_bounds[0], -coord);
+    local_bounds[1] = SC_MAX (local_bounds[1], coord);
+  }
+  mpiret = sc_MPI_Allreduce (local_bounds, bounds, 2, sc_MPI_DOUBLE, sc_MPI_MAX, comm);
+  SC_CHECK_MPI (mpiret);
+  const double min_coord = -bounds[0];
+  const double inverse_bin_size
+    = bounds[1] > min_coord ? T8_FOREST_VERTEX_NUMBERING_NUM_BINS / (bounds[1] - min_coord) : 0;
+
+  /* Merge the points of the local leaves with the same quantized coordinates. */
+  std::vector<t8_forest_vertex_key_t> points;
+  std::vector<double> point_coords;
+  std::vector<size_t> element_points (numbering->element_offsets[num_elements]);
+  {
+    std::vector<size_t> table (t8_forest_vertex_table_size (point_offsets[num_elements]), T8_FOREST_VERTEX_EMPTY_SLOT);
+    for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+      const size_t num_corners = numbering->element_offsets[ielement + 1] - numbering->element_offsets[ielement];
+      for (size_t ipoint = point_offsets[ielement]; ipoint < point_offsets[ielement + 1]; ipoint++) {
+        const size_t ielem_point = ipoint - point_offsets[ielement];
+        t8_forest_vertex_key_t key;
+        for (int icoord = 0; icoord < 3; icoord++) {
+          key.coords[icoord] = (uint32_t) ((coords[3 * ipoint + icoord] - min_coord) * inverse_bin_size + 0.5);
+        }
+        key.flags = ielem_point < num_corners ? T8_FOREST_VERTEX_CORNER : T8_FOREST_VERTEX_MIDPOINT;
+        const size_t index = t8_forest_vertex_table_insert (table, points, key);
+        if (3 * index == point_coords.size ()) {
+          /* This is a new point */
+          point_coords.insert (point_coords.end (), &coords[3 * ipoint], &coords[3 * ipoint] + 3);
+        }
+        if (ielem_point < num_corners) {
+          element_points[numbering->element_offsets[ielement] + ielem_point] = index;
+        }
+      }
+    }
+  }
+  coords.clear ();
+  coords.shrink_to_fit ();
+
+  /* Send each point to the process that collects it. We use the upper bits of the hash
+   * to find this process, since the hash tables use the lower bits. */
+  std::vector<int> send_offsets (mpisize + 1, 0), recv_counts (mpisize), recv_offsets (mpisize + 1, 0);
+  std::vector<size_t> send_points (points.size ());
+  std::vector<t8_forest_vertex_key_t> send_keys (points.size ());
+  {
+    std::vector<int> point_ranks (points.size ());
+    for (size_t ipoint = 0; ipoint < points.size (); ipoint++) {
+      point_ranks[ipoint] = (int) ((t8_forest_vertex_hash (&points[ipoint]) >> 32) % mpisize);
+      send_offsets[point_ranks[ipoint] + 1]++;
+    }
+    for (int irank = 0; irank < mpisize; irank++) {
+      send_offsets[irank + 1] += send_offsets[irank];
+    }
+    std::vector<int> position (send_offsets.begin (), send_offsets.end () - 1);
+    for (size_t ipoint = 0; ipoint < points.size (); ipoint++) {
+      const int ipos = position[point_ranks[ipoint]]++;
+      send_points[ipos] = ipoint;
+      send_keys[ipos] = points[ipoint];
+    }
+  }
+  {
+    std::vector<int> send_counts (mpisize);
+    for (int irank = 0; irank < mpisize; irank++) {
+      send_counts[irank] = send_offsets[irank + 1] - send_offsets[irank];
+    }
+    mpiret = sc_MPI_Alltoall (send_counts.data (), 1, sc_MPI_INT, recv_counts.data (), 1, sc_MPI_INT, comm);
+    SC_CHECK_MPI (mpiret);
+    for (int irank = 0; irank < mpisize; irank++) {
+      recv_offsets[irank + 1] = recv_offsets[irank] + recv_counts[irank];
+    }
+  }
+  std::vector<t8_forest_vertex_key_t> recv_keys;
+  t8_forest_vertex_exchange (send_keys, send_offsets, recv_keys, recv_offsets, comm);
+  send_keys.clear ();
+  send_keys.shrink_to_fit ();
+
+  /* Merge the received points. Since we go through the processes in ascending order,
+   * the first process that sent a point as a corner owns it. Each process sends each point once. */
+  std::vector<t8_forest_vertex_key_t> home_points;
+  std::vector<int> home_owners;
+  std::vector<size_t> recv_points (recv_keys.size ());
+  {
+    std::vector<size_t> table (t8_forest_vertex_table_size (recv_keys.size ()), T8_FOREST_VERTEX_EMPTY_SLOT);
+    for (int irank = 0; irank < mpisize; irank++) {
+      for (int ikey = recv_offsets[irank]; ikey < recv_offsets[irank + 1]; ikey++) {
+        const size_t index = t8_forest_vertex_table_insert (table, home_points, recv_keys[ikey]);
+        if (index == home_owners.size ()) {
+          home_owners.push_back (-1);
+        }
+        if (home_owners[index] < 0 && (recv_keys[ikey].flags & T8_FOREST_VERTEX_CORNER)) {
+          home_owners[index] = irank;
+        }
+        recv_points[ikey] = index;
+      }
+    }
+  }
+  recv_keys.clear ();
+  recv_keys.shrink_to_fit ();
+
+  /* Tell the processes the owners of their points. */
+  std::vector<t8_forest_vertex_owner_t> send_owners (recv_points.size ()), point_owners;
+  for (size_t ikey = 0; ikey < recv_points.size (); ikey++) {
+    const uint32_t flags = home_points[recv_points[ikey]].flags;
+    send_owners[ikey].owner = home_owners[recv_points[ikey]];
+    send_owners[ikey].is_hanging = (flags & T8_FOREST_VERTEX_CORNER) && (flags & T8_FOREST_VERTEX_MIDPOINT);
+  }
+  t8_forest_vertex_exchange (send_owners, recv_offsets, point_owners, send_offsets, comm);
+  send_owners.clear ();
+  send_owners.shrink_to_fit ();
+
+  /* The local vertices are the corners of the local leaves. The owned vertices come first,
+   * both groups in the order of the first occurrence of the vertices. */
+  std::vector<int> point_owner_ranks (points.size ());
+  for (size_t ipos = 0; ipos < send_points.size (); ipos++) {
+    point_owner_ranks[send_points[ipos]] = point_owners[ipos].owner;
+  }
+  std::vector<t8_locidx_t> point_vertices (points.size (), -1);
+  t8_locidx_t num_vertices = 0;
+  for (size_t ipoint = 0; ipoint < points.size (); ipoint++) {
+    if ((points[ipoint].flags & T8_FOREST_VERTEX_CORNER) && point_owner_ranks[ipoint] == mpirank) {
+      point_vertices[ipoint] = num_vertices++;
+    }
+  }
+  const t8_locidx_t num_owned = num_vertices;
+  for (size_t ipoint = 0; ipoint < points.size (); ipoint++) {
+    if ((points[ipoint].flags & T8_FOREST_VERTEX_CORNER) && point_owner_ranks[ipoint] != mpirank) {
+      point_vertices[ipoint] = num_vertices++;
+    }
+  }
+
+  /* The owned vertices of the processes are numbered consecutively. */
+  {
+    const t8_gloidx_t local_num_owned = num_owned;
+    std::vector<t8_gloidx_t> owned_counts (mpisize);
+    mpiret = sc_MPI_Allgather ((void *) &local_num_owned, 1, T8_MPI_GLOIDX, owned_counts.data (), 1, T8_MPI_GLOIDX,
+                               comm);
+    SC_CHECK_MPI (mpiret);
+    numbering->first_owned_vertex = 0;
+    numbering->global_num_vertices = 0;
+    for (int irank = 0; irank < mpisize; irank++) {
+      if (irank == mpirank) {
+        numbering->first_owned_vertex = numbering->global_num_vertices;
+      }
+      numbering->global_num_vertices += owned_counts[irank];
+    }
+  }
+
+  /* Send the global ids of the owned vertices to the processes that collect them and
+   * let these processes send the global ids to all processes that have the vertices. */
+  std::vector<int> send_id_offsets (mpisize + 1, 0), recv_id_offsets (mpisize + 1, 0);
+  std::vector<t8_gloidx_t> send_ids, recv_ids;
+  for (int irank = 0; irank < mpisize; irank++) {
+    for (int ipos = send_offsets[irank]; ipos < send_offsets[irank + 1]; ipos++) {
+      const t8_locidx_t ivertex = point_vertices[send_points[ipos]];
+      if (0 <= ivertex && ivertex < num_owned) {
+        send_ids.push_back (numbering->first_owned_vertex + ivertex);
+      }
+    }
+    send_id_offsets[irank + 1] = send_ids.size ();
+    recv_id_offsets[irank + 1] = recv_id_offsets[irank];
+    for (int ikey = recv_offsets[irank]; ikey < recv_offsets[irank + 1]; ikey++) {
+      recv_id_offsets[irank + 1] += home_owners[recv_points[ikey]] == irank;
+    }
+  }
+  t8_forest_vertex_exchange (send_ids, send_id_offsets, recv_ids, recv_id_offsets, comm);
+  std::vector<t8_gloidx_t> home_ids (home_points.size (), -1);
+  for (int irank = 0; irank < mpisize; irank++) {
+    int iid = recv_id_offsets[irank];
+    for (int ikey = recv_offsets[irank]; ikey < recv_offsets[irank + 1]; ikey++) {
+      if (home_owners[recv_points[ikey]] == irank) {
+        home_ids[recv_points[ikey]] = recv_ids[iid++];
+      }
+    }
+    T8_ASSERT (iid == recv_id_offsets[irank + 1]);
+  }
+  send_ids.resize (recv_points.size ());
+  for (size_t ikey = 0; ikey < recv_points.size (); ikey++) {
+    send_ids[ikey] = home_ids[recv_points[ikey]];
+  }
+  t8_forest_vertex_exchange (send_ids, recv_offsets, recv_ids, send_offsets, comm);
+
+  /* Store the numbering */
+  numbering->num_local_vertices = num_vertices;
+  numbering->num_owned_vertices = num_owned;
+  numbering->element_vertices = T8_ALLOC (t8_locidx_t, element_points.size ());
+  for (size_t icorner = 0; icorner < element_points.size (); icorner++) {
+    numbering->element_vertices[icorner] = point_vertices[element_points[icorner]];
+  }
+  numbering->global_ids = T8_ALLOC (t8_gloidx_t, num_vertices);
+  numbering->owners = T8_ALLOC (int, num_vertices);
+  numbering->coordinates = T8_ALLOC (double, 3 * num_vertices);
+  numbering->is_hanging = mark_hanging ? T8_ALLOC (int8_t, num_vertices) : NULL;
+  for (size_t ipos = 0; ipos < send_points.size (); ipos++) {
+    const size_t ipoint = send_points[ipos];
+    const t8_locidx_t ivertex = point_vertices[ipoint];
+    if (ivertex < 0) {
+      /* Only a midpoint */
+      continue;
+    }
+    T8_ASSERT (ivertex >= num_owned || recv_ids[ipos] == numbering->first_owned_vertex + ivertex);
+    numbering->global_ids[ivertex] = recv_ids[ipos];
+    numbering->owners[ivertex] = point_owners[ipos].owner;
+    std::copy (&point_coords[3 * ipoint], &point_coords[3 * ipoint] + 3, numbering->coordinates + 3 * ivertex);
+    if (mark_hanging) {
+      numbering->is_hanging[ivertex] = point_owners[ipos].is_hanging;
+    }
+  }
+  return numbering;
+}
+
+void
+t8_forest_vertex_numbering_destroy (t8_forest_vertex_numbering_t **pnumbering)
+{
+  T8_ASSERT (pnumbering != NULL && *pnumbering != NULL);
+  t8_forest_vertex_numbering_t *numbering = *pnumbering;
+
+  T8_FREE (numbering->element_offsets);
+  T8_FREE (numbering->element_vertices);
+  T8_FREE (numbering->global_ids);
+  T8_FREE (numbering->owners);
+  T8_FREE (numbering->coordinates);
+  if (numbering->is_hanging != NULL) {
+    T8_FREE (numbering->is_hanging);
+  }
+  T8_FREE (numbering);
+  *pnumbering = NULL;
+}
+
+T8_EXTERN_C_END ();
@@ -0,0 +1,104 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/** \file t8_forest_vertex_numbering.h
+ * We define a global numbering of the corners of the leaves of a forest.
+ * Corners of different leaves that lie at the same position, possibly in
+ * different trees or on different processes, get the same global id.
+ * Each vertex is owned by the lowest process that has a leaf with this corner.
+ * The owned vertices of all processes are numbered consecutively in the order
+ * of the processes, such that process p owns the global ids
+ * first_owned_vertex, ..., first_owned_vertex + num_owned_vertices - 1.
+ *
+ * The vertices are identified by their coordinates, which are quantized to
+ * 2^30 bins per direction over the extent of the forest. Thus, corners that
+ * are closer than this resolution are considered equal, and corners of
+ * periodic boundaries are not identified with each other.
+ */
+
+#ifndef T8_FOREST_VERTEX_NUMBERING_H
+#define T8_FOREST_VERTEX_NUMBERING_H
+
+#include <t8.h>
+#include <t8_forest/t8_forest_general.h>
+
+/** The global vertex numbering of the local leaves of a forest.
+ * The distinct corners of the local leaves are the local vertices. The owned
+ * vertices come first, ordered by their first occurrence in SFC order, followed
+ * by the vertices owned by other processes.
+ * The corners of the local leaf \a ielement are the entries
+ * element_offsets[ielement], ..., element_offsets[ielement + 1] - 1 of \a element_vertices,
+ * in the corner numbering of the element.
+ * Example: Loop over the global ids of the corners of all local leaves
+ * \code
+ * for (t8_locidx_t ielement = 0; ielement < numbering->num_elements; ielement++) {
+ *   for (t8_locidx_t icorner = numbering->element_offsets[ielement];
+ *        icorner < numbering->element_offsets[ielement + 1]; icorner++) {
+ *     const t8_gloidx_t global_id = numbering->global_ids[numbering->element_vertices[icorner]];
+ *     ...
+ *   }
+ * }
+ * \endcode
+ */
+typedef struct t8_forest_vertex_numbering
+{
+  t8_locidx_t num_elements;        /**< The number of local leaves. */
+  t8_locidx_t num_local_vertices;  /**< The number of distinct corners of the local leaves. */
+  t8_locidx_t num_owned_vertices;  /**< The number of local vertices owned by this process.
+                                        These are the local vertices 0, ..., num_owned_vertices - 1. */
+  t8_gloidx_t first_owned_vertex;  /**< The global id of the first owned vertex. */
+  t8_gloidx_t global_num_vertices; /**< The number of vertices on all processes. */
+  t8_locidx_t *element_offsets;    /**< For each local leaf the index of its first corner in \a element_vertices,
+                                        followed by the total number of corners. Length num_elements + 1. */
+  t8_locidx_t *element_vertices;   /**< For each corner of each local leaf its local vertex. */
+  t8_gloidx_t *global_ids;         /**< For each local vertex its global id. */
+  int *owners;                     /**< For each local vertex the process that owns it. */
+  double *coordinates;             /**< For each local vertex its x, y and z coordinates.
+                                        Length 3 * num_local_vertices. */
+  int8_t *is_hanging;              /**< If not NULL, for each local vertex true if it is a hanging vertex,
+                                        that is a corner of a leaf that lies on an edge or face of another
+                                        leaf, and false otherwise. */
+} t8_forest_vertex_numbering_t;
+
+T8_EXTERN_C_BEGIN ();
+
+/** Compute the global vertex numbering of a forest.
+ * \param [in]    forest  The committed forest. No ghost layer is needed.
+ * \param [in]    mark_hanging If true, compute \a is_hanging of the numbering.
+ *                        A vertex is recognized as hanging if it is the midpoint of an edge or
+ *                        the center of a quadrilateral face of a leaf, which covers all hanging
+ *                        vertices of 2:1 balanced forests.
+ * \return                The vertex numbering. Must be freed with \ref t8_forest_vertex_numbering_destroy.
+ * \note This function is collective and must be called on each process of the forest.
+ */
+t8_forest_vertex_numbering_t *
+t8_forest_vertex_numbering_new (t8_forest_t forest, int mark_hanging);
+
+/** Free a vertex numbering.
+ * \param [in,out] pnumbering  The numbering. Set to NULL on output.
+ */
+void
+t8_forest_vertex_numbering_destroy (t8_forest_vertex_numbering_t **pnumbering);
+
+T8_EXTERN_C_END ();
+
+#endif /* !T8_FOREST_VERTEX_NUMBERING_H */
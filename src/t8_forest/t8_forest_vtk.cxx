@@ -59,6 +59,13 @@
 #include <t8_forest/t8_forest_general.h>
 #include <t8_forest/t8_forest_io.h>
 #include <t8_forest/t8_forest_geometrical.h>
+#include <t8_forest/t8_forest_vertex_numbering.h>
+#include <t8_element_shape.h>
+#include <algorithm>
+#include <vector>
+#ifdef SC_HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 /* We want to export the whole implementation to be callable from "C" */
 T8_EXTERN_C_BEGIN ();
@@ -1374,4 +1381,445 @@ t8_forest_vtk_failure:
   return 0;
 }
 
+/* The binary writer stores all data arrays in the appended section of the .vtu file.
+ * Each array is assembled in one contiguous buffer during a single pass over the
+ * elements and then written with one call to fwrite.
+ * Each array in the appended section starts with a header of UInt64 values.
+ * For uncompressed arrays this is the number of bytes of the array.
+ * For compressed arrays it consists of the number of blocks, the uncompressed
+ * block size, the uncompressed size of the last block and the compressed size of
+ * each block, followed by the zlib compressed blocks. */
+
+/** The number of uncompressed bytes per block of a compressed data array. */
+#define T8_VTK_BINARY_BLOCK_SIZE (1 << 20)
+
+/** The sections of a .vtu file in the order in which they are written. */
+typedef enum {
+  T8_VTK_BINARY_POINTS,
+  T8_VTK_BINARY_POINT_DATA,
+  T8_VTK_BINARY_CELLS,
+  T8_VTK_BINARY_CELL_DATA,
+  T8_VTK_BINARY_NUM_SECTIONS
+} t8_forest_vtk_binary_section_t;
+
+/** A data array of a binary .vtu file. */
+typedef struct
+{
+  t8_forest_vtk_binary_section_t section; /**< The section of the file that contains the array. */
+  char name[BUFSIZ];                      /**< The name of the array. */
+  const char *type;                       /**< The vtk name of the type of the entries. */
+  int num_components;                     /**< The number of components of each entry. */
+  size_t data_size;                       /**< The number of bytes of the raw array. */
+  char *buffer;                           /**< A size header followed by the raw array. */
+  char *encoded;                          /**< The array as written to the file, points to \\a buffer if
+                                               the array is not compressed. */
+  size_t encoded_size;                    /**< The number of bytes of \\a encoded. */
+} t8_forest_vtk_binary_array_t;
+
+/* Add an array to the list of arrays and return a pointer to its raw data. */
+static void *
+t8_forest_vtk_binary_add_array (sc_array_t *arrays, const t8_forest_vtk_binary_section_t section, const char *name,
+                                const char *type, const int num_components, const size_t entry_size,
+                                const size_t num_entries)
+{
+  t8_forest_vtk_binary_array_t *array = (t8_forest_vtk_binary_array_t *) sc_array_push (arrays);
+
+  T8_ASSERT (arrays->elem_count == 1
+             || ((t8_forest_vtk_binary_array_t *) sc_array_index (arrays, arrays->elem_count - 2))->section <= section);
+  array->section = section;
+  snprintf (array->name, BUFSIZ, "%s", name);
+  array->type = type;
+  array->num_components = num_components;
+  array->data_size = entry_size * num_components * num_entries;
+  array->buffer = T8_ALLOC (char, sizeof (uint64_t) + array->data_size);
+  array->encoded = NULL;
+  array->encoded_size = 0;
+  return array->buffer + sizeof (uint64_t);
+}
+
+/* Compute the representation of an array in the appended section of the file.
+ * Return true on success. */
+static int
+t8_forest_vtk_binary_encode (t8_forest_vtk_binary_array_t *array, const int compress)
+{
+  if (!compress) {
+    /* The size header was reserved in front of the data, so we do not need to copy. */
+    const uint64_t size = array->data_size;
+    memcpy (array->buffer, &size, sizeof (uint64_t));
+    array->encoded = array->buffer;
+    array->encoded_size = sizeof (uint64_t) + array->data_size;
+    return 1;
+  }
+#ifdef SC_HAVE_ZLIB
+  const char *data = array->buffer + sizeof (uint64_t);
+  const size_t num_blocks = (array->data_size + T8_VTK_BINARY_BLOCK_SIZE - 1) / T8_VTK_BINARY_BLOCK_SIZE;
+  const size_t header_size = (3 + num_blocks) * sizeof (uint64_t);
+  uint64_t *header = T8_ALLOC (uint64_t, 3 + num_blocks);
+  char *compressed = T8_ALLOC (char, header_size + num_blocks * compressBound (T8_VTK_BINARY_BLOCK_SIZE));
+  size_t position = header_size;
+
+  header[0] = num_blocks;
+  header[1] = T8_VTK_BINARY_BLOCK_SIZE;
+  header[2] = num_blocks > 0 ? array->data_size - (num_blocks - 1) * T8_VTK_BINARY_BLOCK_SIZE : 0;
+  for (size_t iblock = 0; iblock < num_blocks; iblock++) {
+    const size_t block_size = iblock + 1 < num_blocks ? T8_VTK_BINARY_BLOCK_SIZE : header[2];
+    uLongf compressed_size = compressBound (T8_VTK_BINARY_BLOCK_SIZE);
+    /* Favor speed over size, the output should not dominate the runtime. */
+    if (compress2 ((Bytef *) compressed + position, &compressed_size,
+                   (const Bytef *) data + iblock * T8_VTK_BINARY_BLOCK_SIZE, block_size, Z_BEST_SPEED)
+        != Z_OK) {
+      T8_FREE (header);
+      T8_FREE (compressed);
+      return 0;
+    }
+    header[3 + iblock] = compressed_size;
+    position += compressed_size;
+  }
+  memcpy (compressed, header, header_size);
+  T8_FREE (header);
+  array->encoded = compressed;
+  array->encoded_size = position;
+  return 1;
+#else
+  SC_ABORT_NOT_REACHED ();
+  return 0;
+#endif
+}
+
+/* Fill the data arrays of a binary .vtu file in one pass over the local and,
+ * if requested, the ghost elements.
+ * If numbering is not NULL, the corners of the local elements are the vertices of
+ * the numbering and the value of a point is the average of its elements. Otherwise,
+ * and for ghost elements, each corner is a separate point.
+ * The point data arrays must be initialized with zero. */
+static void
+t8_forest_vtk_binary_fill (t8_forest_t forest, const int write_ghosts, const t8_forest_vertex_numbering_t *numbering,
+                           const int num_data, t8_vtk_data_field_t *data, T8_VTK_FLOAT_TYPE *positions,
+                           T8_VTK_FLOAT_TYPE **point_data, int32_t *connectivity, int32_t *offsets, uint8_t *types,
+                           int32_t *treeids, int32_t *mpiranks, int32_t *levels, int32_t *element_ids,
+                           T8_VTK_FLOAT_TYPE **cell_data)
+{
+  const t8_locidx_t num_local_trees = t8_forest_get_num_local_trees (forest);
+  const t8_locidx_t num_trees = num_local_trees + (write_ghosts ? t8_forest_ghost_num_trees (forest) : 0);
+  const t8_gloidx_t first_element_id = t8_forest_get_first_local_element_id (forest);
+  double vertex_coords[3 * T8_ECLASS_MAX_CORNERS];
+  t8_locidx_t ielement = 0;
+  t8_locidx_t icorner = 0;
+  t8_locidx_t ipoint = 0;
+  std::vector<int> point_num_elements;
+
+  if (numbering != NULL) {
+    /* The vertices of the numbering are the first points */
+    for (ipoint = 0; ipoint < numbering->num_local_vertices; ipoint++) {
+      for (int idim = 0; idim < 3; idim++) {
+        positions[3 * ipoint + idim] = (T8_VTK_FLOAT_TYPE) numbering->coordinates[3 * ipoint + idim];
+      }
+    }
+    point_num_elements.resize (numbering->num_local_vertices, 0);
+  }
+
+  for (t8_locidx_t itree = 0; itree < num_trees; itree++) {
+    const int is_ghost = itree >= num_local_trees;
+    const t8_locidx_t ighost = itree - num_local_trees;
+    const t8_eclass_t tree_class
+      = is_ghost ? t8_forest_ghost_get_tree_class (forest, ighost) : t8_forest_get_tree_class (forest, itree);
+    t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, tree_class);
+    const t8_locidx_t num_tree_elements = is_ghost ? t8_forest_ghost_tree_num_elements (forest, ighost)
+                                                   : t8_forest_get_tree_num_elements (forest, itree);
+    for (t8_locidx_t element_index = 0; element_index < num_tree_elements; element_index++, ielement++) {
+      const t8_element_t *element = is_ghost ? t8_forest_ghost_get_element (forest, ighost, element_index)
+                                             : t8_forest_get_element_in_tree (forest, itree, element_index);
+      const t8_element_shape_t element_shape = ts->t8_element_shape (element);
+      const int num_vertices = t8_eclass_num_vertices[element_shape];
+      const t8_locidx_t first_corner = icorner;
+
+      if (numbering != NULL && !is_ghost) {
+        /* Look up the points of the corners, in vtk corner order */
+        const t8_locidx_t *element_vertices = numbering->element_vertices + numbering->element_offsets[ielement];
+        for (int ivertex = 0; ivertex < num_vertices; ivertex++, icorner++) {
+          connectivity[icorner] = element_vertices[t8_element_shape_vtk_corner_number (element_shape, ivertex)];
+          point_num_elements[connectivity[icorner]]++;
+        }
+      }
+      else {
+        /* Compute all vertex coordinates of the element at once */
+        const double *ref_coords = t8_forest_vtk_point_to_element_ref_coords[element_shape][0];
+        t8_forest_element_from_ref_coords (forest, itree, element, ref_coords, num_vertices, vertex_coords);
+        for (int ivertex = 0; ivertex < num_vertices; ivertex++, icorner++, ipoint++) {
+          for (int idim = 0; idim < 3; idim++) {
+            positions[3 * ipoint + idim] = (T8_VTK_FLOAT_TYPE) vertex_coords[3 * ivertex + idim];
+          }
+          connectivity[icorner] = ipoint;
+        }
+      }
+      offsets[ielement] = icorner;
+      types[ielement] = (uint8_t) t8_eclass_vtk_type[element_shape];
+      if (treeids != NULL) {
+        /* For ghost elements we write -1 as the tree id */
+        treeids[ielement] = is_ghost ? -1 : (int32_t) (forest->first_local_tree + itree);
+      }
+      if (mpiranks != NULL) {
+        mpiranks[ielement] = forest->mpirank;
+      }
+      if (levels != NULL) {
+        levels[ielement] = ts->t8_element_level (element);
+      }
+      if (element_ids != NULL) {
+        element_ids[ielement] = is_ghost ? -1 : (int32_t) (first_element_id + ielement);
+      }
+      /* Write the user defined data. Ghost elements get zero values. */
+      for (int idata = 0; idata < num_data; idata++) {
+        const int num_components = data[idata].type == T8_VTK_SCALAR ? 1 : 3;
+        for (int icomp = 0; icomp < num_components; icomp++) {
+          const T8_VTK_FLOAT_TYPE value
+            = is_ghost ? 0 : (T8_VTK_FLOAT_TYPE) data[idata].data[num_components * ielement + icomp];
+          cell_data[idata][num_components * ielement + icomp] = value;
+          for (t8_locidx_t ielem_corner = first_corner; ielem_corner < icorner; ielem_corner++) {
+            point_data[idata][num_components * connectivity[ielem_corner] + icomp] += value;
+          }
+        }
+      }
+    }
+  }
+  /* Average the values of the shared points */
+  for (t8_locidx_t ivertex = 0; ivertex < (t8_locidx_t) point_num_elements.size (); ivertex++) {
+    for (int idata = 0; idata < num_data && point_num_elements[ivertex] > 1; idata++) {
+      const int num_components = data[idata].type == T8_VTK_SCALAR ? 1 : 3;
+      for (int icomp = 0; icomp < num_components; icomp++) {
+        point_data[idata][num_components * ivertex + icomp] /= point_num_elements[ivertex];
+      }
+    }
+  }
+}
+
+int
+t8_forest_vtk_write_file_binary (t8_forest_t forest, const char *fileprefix, const int write_treeid,
+                                 const int write_mpirank, const int write_level, const int write_element_id,
+                                 int write_ghosts, int compress, const int deduplicate_points, const int num_data,
+                                 t8_vtk_data_field_t *data)
+{
+  static const char *const section_names[T8_VTK_BINARY_NUM_SECTIONS] = { "Points", "PointData", "Cells", "CellData" };
+  FILE *vtufile = NULL;
+  char vtufilename[BUFSIZ];
+  char name[BUFSIZ];
+  sc_array_t arrays;
+  int freturn;
+  int success = 0;
+
+  T8_ASSERT (forest != NULL);
+  T8_ASSERT (t8_forest_is_committed (forest));
+  T8_ASSERT (fileprefix != NULL);
+  if (forest->ghosts == NULL || forest->ghosts->num_ghosts_elements == 0) {
+    /* Never write ghost elements if there aren't any */
+    write_ghosts = 0;
+  }
+#ifndef SC_HAVE_ZLIB
+  if (compress) {
+    t8_errorf ("WARNING: Compressed vtk output requires zlib. Writing uncompressed data instead.\n");
+    compress = 0;
+  }
+#endif
+
+  /* The numbering is collective, so we compute it before any process can return. */
+  t8_forest_vertex_numbering_t *numbering = deduplicate_points ? t8_forest_vertex_numbering_new (forest, 0) : NULL;
+
+  /* process 0 creates the .pvtu file */
+  if (forest->mpirank == 0) {
+    if (t8_write_pvtu_ext (fileprefix, forest->mpisize, write_treeid, write_mpirank, write_level, write_element_id,
+                           num_data, data, "appended")) {
+      t8_errorf ("Error when writing file %s.pvtu\n", fileprefix);
+      t8_errorf ("Error when writing vtk file.\n");
+      if (numbering != NULL) {
+        t8_forest_vertex_numbering_destroy (&numbering);
+      }
+      return 0;
+    }
+  }
+
+  /* The local number of elements and of their corners */
+  const size_t num_elements
+    = t8_forest_get_local_num_elements (forest) + (write_ghosts ? t8_forest_get_num_ghosts (forest) : 0);
+  const size_t num_corners = t8_forest_num_points (forest, write_ghosts);
+  /* Without deduplication, each corner is a separate point. Otherwise, the corners of the
+   * local elements share their points and only the corners of the ghosts are separate points. */
+  size_t num_points = num_corners;
+  if (numbering != NULL) {
+    num_points = num_corners - numbering->element_offsets[numbering->num_elements] + numbering->num_local_vertices;
+  }
+
+  /* Allocate all arrays in the order in which they appear in the file */
+  sc_array_init (&arrays, sizeof (t8_forest_vtk_binary_array_t));
+  T8_VTK_FLOAT_TYPE *positions = (T8_VTK_FLOAT_TYPE *) t8_forest_vtk_binary_add_array (
+    &arrays, T8_VTK_BINARY_POINTS, "Position", T8_VTK_FLOAT_NAME, 3, sizeof (T8_VTK_FLOAT_TYPE), num_points);
+  T8_VTK_FLOAT_TYPE **point_data = T8_ALLOC_ZERO (T8_VTK_FLOAT_TYPE *, num_data + 1);
+  T8_VTK_FLOAT_TYPE **cell_data = T8_ALLOC_ZERO (T8_VTK_FLOAT_TYPE *, num_data + 1);
+  for (int idata = 0; idata < num_data; idata++) {
+    const int sreturn = snprintf (name, BUFSIZ, "%s_%s", data[idata].description, "points");
+    if (sreturn >= BUFSIZ) {
+      /* The name was truncated */
+      /* Note: gcc >= 7.1 prints a warning if we
+       * do not check the return value of snprintf. */
+      t8_debugf ("Warning: Truncated vtk point data name to '%s'\n", name);
+    }
+    const int num_components = data[idata].type == T8_VTK_SCALAR ? 1 : 3;
+    point_data[idata] = (T8_VTK_FLOAT_TYPE *) t8_forest_vtk_binary_add_array (
+      &arrays, T8_VTK_BINARY_POINT_DATA, name, T8_VTK_FLOAT_NAME, num_components, sizeof (T8_VTK_FLOAT_TYPE),
+      num_points);
+    /* The values of the points are accumulated */
+    std::fill (point_data[idata], point_data[idata] + num_components * num_points, (T8_VTK_FLOAT_TYPE) 0);
+  }
+  int32_t *connectivity = (int32_t *) t8_forest_vtk_binary_add_array (&arrays, T8_VTK_BINARY_CELLS, "connectivity",
+                                                                      T8_VTK_LOCIDX, 1, sizeof (int32_t), num_corners);
+  int32_t *offsets = (int32_t *) t8_forest_vtk_binary_add_array (&arrays, T8_VTK_BINARY_CELLS, "offsets",
+                                                                 T8_VTK_LOCIDX, 1, sizeof (int32_t), num_elements);
+  uint8_t *types = (uint8_t *) t8_forest_vtk_binary_add_array (&arrays, T8_VTK_BINARY_CELLS, "types", "UInt8", 1,
+                                                               sizeof (uint8_t), num_elements);
+  int32_t *treeids = !write_treeid ? NULL
+                                   : (int32_t *) t8_forest_vtk_binary_add_array (&arrays, T8_VTK_BINARY_CELL_DATA,
+                                                                                 "treeid", T8_VTK_GLOIDX, 1,
+                                                                                 sizeof (int32_t), num_elements);
+  int32_t *mpiranks = !write_mpirank ? NULL
+                                     : (int32_t *) t8_forest_vtk_binary_add_array (&arrays, T8_VTK_BINARY_CELL_DATA,
+                                                                                   "mpirank", "Int32", 1,
+                                                                                   sizeof (int32_t), num_elements);
+  int32_t *levels = !write_level ? NULL
+                                 : (int32_t *) t8_forest_vtk_binary_add_array (&arrays, T8_VTK_BINARY_CELL_DATA,
+                                                                               "level", "Int32", 1, sizeof (int32_t),
+                                                                               num_elements);
+  int32_t *element_ids = !write_element_id ? NULL
+                                           : (int32_t *) t8_forest_vtk_binary_add_array (
+                                             &arrays, T8_VTK_BINARY_CELL_DATA, "element_id", T8_VTK_LOCIDX, 1,
+                                             sizeof (int32_t), num_elements);
+  for (int idata = 0; idata < num_data; idata++) {
+    cell_data[idata] = (T8_VTK_FLOAT_TYPE *) t8_forest_vtk_binary_add_array (
+      &arrays, T8_VTK_BINARY_CELL_DATA, data[idata].description, T8_VTK_FLOAT_NAME,
+      data[idata].type == T8_VTK_SCALAR ? 1 : 3, sizeof (T8_VTK_FLOAT_TYPE), num_elements);
+  }
+
+  /* Compute the data of all arrays */
+  t8_forest_vtk_binary_fill (forest, write_ghosts, numbering, num_data, data, positions, point_data, connectivity,
+                             offsets, types, treeids, mpiranks, levels, element_ids, cell_data);
+  if (numbering != NULL) {
+    t8_forest_vertex_numbering_destroy (&numbering);
+  }
+  T8_FREE (point_data);
+  T8_FREE (cell_data);
+  for (size_t iarray = 0; iarray < arrays.elem_count; iarray++) {
+    t8_forest_vtk_binary_array_t *array = (t8_forest_vtk_binary_array_t *) sc_array_index (&arrays, iarray);
+    if (!t8_forest_vtk_binary_encode (array, compress)) {
+      t8_errorf ("Error when compressing vtk data array %s.\n", array->name);
+      goto t8_forest_vtk_binary_failure;
+    }
+  }
+
+  /* The filename for this processes file */
+  freturn = snprintf (vtufilename, BUFSIZ, "%s_%04d.vtu", fileprefix, forest->mpirank);
+  if (freturn >= BUFSIZ) {
+    t8_errorf ("Error when writing vtu file. Filename too long.\n");
+    goto t8_forest_vtk_binary_failure;
+  }
+  vtufile = fopen (vtufilename, "wb");
+  if (vtufile == NULL) {
+    t8_errorf ("Error when opening file %s\n", vtufilename);
+    goto t8_forest_vtk_binary_failure;
+  }
+
+  /* Write the xml header with the offset of each array in the appended section */
+  freturn = fprintf (vtufile,
+                     "<?xml version=\"1.0\"?>\n"
+                     "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"%s\" header_type=\"UInt64\"%s>\n"
+                     "  <UnstructuredGrid>\n"
+                     "    <Piece NumberOfPoints=\"%lld\" NumberOfCells=\"%lld\">\n",
+#ifdef SC_IS_BIGENDIAN
+                     "BigEndian",
+#else
+                     "LittleEndian",
+#endif
+                     compress ? " compressor=\"vtkZLibDataCompressor\"" : "", (long long) num_points,
+                     (long long) num_elements);
+  if (freturn <= 0) {
+    goto t8_forest_vtk_binary_failure;
+  }
+  {
+    size_t iarray = 0;
+    unsigned long long offset = 0;
+    for (int isection = 0; isection < T8_VTK_BINARY_NUM_SECTIONS; isection++) {
+      const size_t section_begin = iarray;
+      for (; iarray < arrays.elem_count; iarray++) {
+        const t8_forest_vtk_binary_array_t *array
+          = (const t8_forest_vtk_binary_array_t *) sc_array_index (&arrays, iarray);
+        if (array->section != isection) {
+          break;
+        }
+        if (iarray == section_begin && fprintf (vtufile, "      <%s>\n", section_names[isection]) <= 0) {
+          goto t8_forest_vtk_binary_failure;
+        }
+        freturn = fprintf (vtufile, "        <DataArray type=\"%s\" Name=\"%s\"", array->type, array->name);
+        if (freturn > 0 && array->num_components > 1) {
+          freturn = fprintf (vtufile, " NumberOfComponents=\"%i\"", array->num_components);
+        }
+        if (freturn > 0) {
+          freturn = fprintf (vtufile, " format=\"appended\" offset=\"%llu\"/>\n", offset);
+        }
+        if (freturn <= 0) {
+          goto t8_forest_vtk_binary_failure;
+        }
+        offset += array->encoded_size;
+      }
+      if (iarray > section_begin && fprintf (vtufile, "      </%s>\n", section_names[isection]) <= 0) {
+        goto t8_forest_vtk_binary_failure;
+      }
+    }
+  }
+  freturn = fprintf (vtufile, "    </Piece>\n"
+                              "  </UnstructuredGrid>\n"
+                              "  <AppendedData encoding=\"raw\">\n"
+                              "   _");
+  if (freturn <= 0) {
+    goto t8_forest_vtk_binary_failure;
+  }
+  /* Write each array with a single call */
+  for (size_t iarray = 0; iarray < arrays.elem_count; iarray++) {
+    const t8_forest_vtk_binary_array_t *array = (const t8_forest_vtk_binary_array_t *) sc_array_index (&arrays, iarray);
+    if (fwrite (array->encoded, 1, array->encoded_size, vtufile) != array->encoded_size) {
+      goto t8_forest_vtk_binary_failure;
+    }
+  }
+  freturn = fprintf (vtufile, "\n"
+                              "  </AppendedData>\n"
+                              "</VTKFile>\n");
+  if (freturn <= 0) {
+    goto t8_forest_vtk_binary_failure;
+  }
+
+  freturn = fclose (vtufile);
+  /* We set it NULL, even if fclose was not successful, since then any
+   * following call to fclose would result in undefined behaviour. */
+  vtufile = NULL;
+  if (freturn != 0) {
+    /* Closing failed, this usually means that the final write operation could
+     * not be completed. */
+    t8_global_errorf ("Error when closing file %s\n", vtufilename);
+    goto t8_forest_vtk_binary_failure;
+  }
+  /* Writing was successful */
+  success = 1;
+t8_forest_vtk_binary_failure:
+  if (vtufile != NULL) {
+    fclose (vtufile);
+  }
+  for (size_t iarray = 0; iarray < arrays.elem_count; iarray++) {
+    t8_forest_vtk_binary_array_t *array = (t8_forest_vtk_binary_array_t *) sc_array_index (&arrays, iarray);
+    if (array->encoded != array->buffer) {
+      T8_FREE (array->encoded);
+    }
+    T8_FREE (array->buffer);
+  }
+  sc_array_reset (&arrays);
+  if (!success) {
+    t8_errorf ("Error when writing vtk file.\n");
+  }
+  return success;
+}
+
 T8_EXTERN_C_END ();
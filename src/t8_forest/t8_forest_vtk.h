@@ -87,6 +87,42 @@ t8_forest_vtk_write_file (t8_forest_t forest, const char *fileprefix, const int
                           const int write_level, const int write_element_id, int write_ghosts, const int num_data,
                           t8_vtk_data_field_t *data);
 
+/** Write the forest in .pvtu file format with binary data arrays.
+ * Writes one .vtu file per process and a meta .pvtu file.
+ * In contrast to \ref t8_forest_vtk_write_file, all data arrays are stored
+ * as raw binary data in the appended section of the .vtu file. Each array
+ * is assembled in one contiguous buffer and written with a single call
+ * to fwrite, which makes the output considerably smaller and faster than
+ * the ASCII format. No VTK library is needed.
+ * \param [in]  forest    The forest.
+ * \param [in]  fileprefix  The prefix of the output files.
+ * \param [in]  write_treeid If true, the global tree id is written for each element.
+ * \param [in]  write_mpirank If true, the mpirank is written for each element.
+ * \param [in]  write_level If true, the refinement level is written for each element.
+ * \param [in]  write_element_id If true, the global element id is written for each element.
+ * \param [in]  write_ghosts If true, each process additionally writes its ghost elements.
+ *                           For ghost element the treeid is -1.
+ * \param [in]  compress  If true, the data arrays are compressed with zlib.
+ *                        Only available if sc was built with zlib, otherwise
+ *                        the data is written uncompressed.
+ * \param [in]  deduplicate_points If true, the corners of the local elements that lie at the
+ *                        same position are written as one point, see \ref t8_forest_vertex_numbering_new.
+ *                        The value of the point data at such a point is the average of the values
+ *                        of its elements. The corners of ghost elements are always separate points.
+ * \param [in]  num_data  Number of user defined double valued data fields to write.
+ * \param [in]  data      Array of t8_vtk_data_field_t of length \a num_data
+ *                        providing the user defined per element data.
+ *                        If scalar and vector fields are used, all scalar fields
+ *                        must come first in the array.
+ * \return  True if successful, false if not (process local).
+ * \note If \a deduplicate_points is true, this function is collective.
+ */
+int
+t8_forest_vtk_write_file_binary (t8_forest_t forest, const char *fileprefix, const int write_treeid,
+                                 const int write_mpirank, const int write_level, const int write_element_id,
+                                 int write_ghosts, int compress, const int deduplicate_points, const int num_data,
+                                 t8_vtk_data_field_t *data);
+
 T8_EXTERN_C_END ();
 
 #endif /* !T8_FOREST_VTK_H */
@@ -57,6 +57,53 @@ t8_geometry_jacobian (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_c
   cmesh->geometry_handler->evaluate_tree_geometry_jacobian (cmesh, gtreeid, ref_coords, num_coords, jacobian);
 }
 
+void
+t8_geometry_tree_cache_init (t8_geometry_tree_cache_t *cache)
+{
+  T8_ASSERT (cache != NULL);
+  cache->geometry = NULL;
+  cache->gtreeid = -1;
+  cache->tree_vertices = NULL;
+  cache->tree_data = NULL;
+}
+
+void
+t8_geometry_evaluate_threadsafe (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords,
+                                 const size_t num_coords, double *out_coords, t8_geometry_tree_cache_t *cache)
+{
+  /* The geometries do not expect the in- and output vector to be the same */
+  T8_ASSERT (ref_coords != out_coords);
+
+  double start_wtime = 0; /* Used for profiling. */
+  t8_geometry_tree_cache_t local_cache;
+  if (cache == NULL) {
+    t8_geometry_tree_cache_init (&local_cache);
+    cache = &local_cache;
+  }
+  if (cmesh->profile != NULL) {
+    start_wtime = sc_MPI_Wtime ();
+  }
+  cmesh->geometry_handler->evaluate_tree_geometry_threadsafe (cmesh, gtreeid, ref_coords, num_coords, out_coords,
+                                                              cache);
+  if (cmesh->profile != NULL) {
+    /* Other threads may record their evaluations at the same time. */
+    cmesh->geometry_handler->record_evaluation (cmesh, sc_MPI_Wtime () - start_wtime);
+  }
+}
+
+void
+t8_geometry_jacobian_threadsafe (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords,
+                                 const size_t num_coords, double *jacobian, t8_geometry_tree_cache_t *cache)
+{
+  t8_geometry_tree_cache_t local_cache;
+  if (cache == NULL) {
+    t8_geometry_tree_cache_init (&local_cache);
+    cache = &local_cache;
+  }
+  cmesh->geometry_handler->evaluate_tree_geometry_jacobian_threadsafe (cmesh, gtreeid, ref_coords, num_coords,
+                                                                       jacobian, cache);
+}
+
 t8_geometry_type_t
 t8_geometry_get_type (t8_cmesh_t cmesh, t8_gloidx_t gtreeid)
 {
@@ -30,6 +30,7 @@
 
 #include <t8.h>
 #include <t8_refcount.h>
+#include <t8_eclass.h>
 
 /** This enumeration contains all possible geometries. */
 typedef enum t8_geometry_type {
@@ -70,6 +71,21 @@ typedef struct t8_geometry_handler t8_geometry_handler_c;
 
 T8_EXTERN_C_BEGIN ();
 
+/** Per-thread cache of the data of one tree that is needed to evaluate its geometry.
+ * It is filled by \ref t8_geometry_evaluate_threadsafe and allows repeated evaluations
+ * in the same tree without looking up the tree's geometry and vertices again.
+ * Each thread must use its own cache. A cache is only valid for a single cmesh and
+ * has to be reset with \ref t8_geometry_tree_cache_init before it is used with another cmesh.
+ */
+typedef struct t8_geometry_tree_cache
+{
+  const t8_geometry_c *geometry; /**< The geometry of the cached tree. */
+  t8_gloidx_t gtreeid;           /**< The global id of the cached tree, -1 if the cache is empty. */
+  t8_eclass_t tree_class;        /**< The eclass of the cached tree. */
+  const double *tree_vertices;   /**< The vertex coordinates of the cached tree, may be NULL. */
+  const void *tree_data;         /**< Further geometry specific data of the cached tree, may be NULL. */
+} t8_geometry_tree_cache_t;
+
 /**
  * Evaluates the geometry of a tree at a given reference point.
  * \param [in]  cmesh      The cmesh
@@ -93,6 +109,46 @@ void
 t8_geometry_jacobian (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords, const size_t num_coords,
                       double *jacobian);
 
+/** Reset a tree cache such that it does not hold data of any tree.
+ * \param [out] cache      The cache to reset.
+ */
+void
+t8_geometry_tree_cache_init (t8_geometry_tree_cache_t *cache);
+
+/**
+ * Evaluates the geometry of a tree at a given reference point without modifying
+ * any state of the cmesh or its geometries.
+ * In contrast to \ref t8_geometry_evaluate this function may be called concurrently
+ * from multiple threads on the same cmesh, as long as each thread uses its own \a cache.
+ * Geometries that do not support re-entrant evaluation are evaluated one thread at a time.
+ * If the cmesh records a profile, the runtime is added to the profile under a lock.
+ * \param [in]  cmesh      The cmesh
+ * \param [in]  gtreeid    The global id of the tree
+ * \param [in]  ref_coords The reference coordinates at which to evaluate the geometry
+ * \param [in]  num_coords The number of reference coordinates
+ * \param [out] out_coords The evaluated coordinates
+ * \param [in,out] cache   A per-thread cache of the tree data. If NULL, the tree data is looked up on each call.
+ */
+void
+t8_geometry_evaluate_threadsafe (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords,
+                                 const size_t num_coords, double *out_coords, t8_geometry_tree_cache_t *cache);
+
+/** Evaluates the jacobian of a tree at a given reference point without modifying
+ * any state of the cmesh or its geometries.
+ * As \ref t8_geometry_evaluate_threadsafe, this function may be called concurrently
+ * from multiple threads on the same cmesh, as long as each thread uses its own \a cache.
+ * Geometries that do not support re-entrant evaluation are evaluated one thread at a time.
+ * \param[in]  cmesh      The cmesh
+ * \param[in]  gtreeid    The global id of the tree
+ * \param[in]  ref_coords The reference coordinates at which to evaluate the jacobian
+ * \param[in]  num_coords The number of reference coordinates
+ * \param[out] jacobian   The jacobian at the reference coordinates
+ * \param [in,out] cache  A per-thread cache of the tree data. If NULL, the tree data is looked up on each call.
+ */
+void
+t8_geometry_jacobian_threadsafe (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords,
+                                 const size_t num_coords, double *jacobian, t8_geometry_tree_cache_t *cache);
+
 /** This function returns the geometry type of a tree.
  * \param[in] cmesh       The cmesh
  * \param[in] gtreeid     The global id of the tree
@@ -107,6 +107,62 @@ struct t8_geometry
   t8_geom_load_tree_data (t8_cmesh_t cmesh, t8_gloidx_t gtreeid)
     = 0;
 
+  /** Fill a tree cache with the data of a tree without modifying the geometry.
+   * Geometries that override \ref t8_geom_evaluate_with_tree_cache must load all
+   * per tree data they need into the cache here.
+   * \param [in]  cmesh      The cmesh.
+   * \param [in]  gtreeid    The global tree.
+   * \param [out] cache      The cache to fill.
+   */
+  virtual void
+  t8_geom_fill_tree_cache (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, t8_geometry_tree_cache_t *cache) const
+  {
+    cache->geometry = this;
+    cache->gtreeid = gtreeid;
+    cache->tree_vertices = NULL;
+    cache->tree_data = NULL;
+  }
+
+  /** Whether this geometry implements \ref t8_geom_evaluate_with_tree_cache and
+   * \ref t8_geom_evaluate_jacobian_with_tree_cache and can thus be evaluated concurrently by multiple threads.
+   * \return True if the evaluation with a tree cache is implemented.
+   */
+  virtual bool
+  t8_geom_is_reentrant () const
+  {
+    return false;
+  }
+
+  /**
+   * Maps points in the reference space \f$ [0,1]^\mathrm{dim} \to \mathbb{R}^3 \f$, using only the
+   * tree data in \a cache and no internal state of the geometry.
+   * \param [in]  cache       The tree data, filled by \ref t8_geom_fill_tree_cache.
+   * \param [in]  ref_coords  Array of \a dimension x \a num_coords many entries, specifying points in \f$ [0,1]^\mathrm{dim} \f$.
+   * \param [in]  num_coords  Amount of points of /f$ \mathrm{dim} /f$ to map.
+   * \param [out] out_coords  The mapped coordinates in physical space of \a ref_coords. The length is \a num_coords * 3.
+   */
+  virtual void
+  t8_geom_evaluate_with_tree_cache (const t8_geometry_tree_cache_t *cache, const double *ref_coords,
+                                    const size_t num_coords, double *out_coords) const
+  {
+    SC_ABORTF ("Re-entrant evaluation is not implemented for geometry %s", name.c_str ());
+  }
+
+  /**
+   * Compute the jacobian of the \a t8_geom_evaluate map, using only the tree data in \a cache
+   * and no internal state of the geometry.
+   * \param [in]  cache       The tree data, filled by \ref t8_geom_fill_tree_cache.
+   * \param [in]  ref_coords  Array of \a dimension x \a num_coords many entries, specifying points in \f$ [0,1]^\mathrm{dim} \f$.
+   * \param [in]  num_coords  Amount of points of /f$ \mathrm{dim} /f$ to map.
+   * \param [out] jacobian    The jacobian at \a ref_coords, as in \ref t8_geom_evaluate_jacobian.
+   */
+  virtual void
+  t8_geom_evaluate_jacobian_with_tree_cache (const t8_geometry_tree_cache_t *cache, const double *ref_coords,
+                                             const size_t num_coords, double *jacobian) const
+  {
+    SC_ABORTF ("Re-entrant jacobian evaluation is not implemented for geometry %s", name.c_str ());
+  }
+
   /** Query whether a batch of points lies inside an element. 
  * \param [in]      forest      The forest.
  * \param [in]      ltree_id    The forest local id of the tree in which the element is.
@@ -68,3 +68,78 @@ t8_geometry_handler::update_tree (t8_cmesh_t cmesh, t8_gloidx_t gtreeid)
     active_geometry->t8_geom_load_tree_data (cmesh, gtreeid);
   }
 }
+
+const t8_geometry *
+t8_geometry_handler::get_tree_geometry_const (t8_cmesh_t cmesh, t8_gloidx_t gtreeid) const
+{
+  T8_ASSERT (0 <= gtreeid && gtreeid < t8_cmesh_get_num_trees (cmesh));
+  const size_t num_geoms = get_num_geometries ();
+  SC_CHECK_ABORTF (num_geoms > 0,
+                   "The geometry of the tree could not be found, because no geometries were registered.");
+  if (num_geoms == 1) {
+    return registered_geometries.begin ()->second.get ();
+  }
+  const size_t geom_hash = t8_cmesh_get_tree_geom_hash (cmesh, gtreeid);
+  const auto found = registered_geometries.find (geom_hash);
+  SC_CHECK_ABORTF (found != registered_geometries.end (),
+                   "Could not find geometry with hash %zu or tree %ld has no registered geometry.", geom_hash, gtreeid);
+  return found->second.get ();
+}
+
+void
+t8_geometry_handler::update_tree_cache (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, t8_geometry_tree_cache_t *cache) const
+{
+  T8_ASSERT (cache != NULL);
+  if (cache->gtreeid != gtreeid) {
+    /* Look up the geometry and the data of the new tree without touching the active tree. */
+    const t8_geometry *geometry = get_tree_geometry_const (cmesh, gtreeid);
+    if (geometry->t8_geom_is_reentrant ()) {
+      geometry->t8_geom_fill_tree_cache (cmesh, gtreeid, cache);
+    }
+    else {
+      t8_geometry_tree_cache_init (cache);
+      cache->geometry = geometry;
+    }
+  }
+}
+
+void
+t8_geometry_handler::evaluate_tree_geometry_threadsafe (t8_cmesh_t cmesh, t8_gloidx_t gtreeid,
+                                                        const double *ref_coords, const size_t num_coords,
+                                                        double *out_coords, t8_geometry_tree_cache_t *cache)
+{
+  update_tree_cache (cmesh, gtreeid, cache);
+  if (cache->gtreeid == gtreeid) {
+    cache->geometry->t8_geom_evaluate_with_tree_cache (cache, ref_coords, num_coords, out_coords);
+  }
+  else {
+    /* This geometry keeps per tree data in its own state. We evaluate it one thread at a time. */
+    std::lock_guard<std::mutex> lock (stateful_mutex);
+    evaluate_tree_geometry (cmesh, gtreeid, ref_coords, num_coords, out_coords);
+  }
+}
+
+void
+t8_geometry_handler::evaluate_tree_geometry_jacobian_threadsafe (t8_cmesh_t cmesh, t8_gloidx_t gtreeid,
+                                                                 const double *ref_coords, const size_t num_coords,
+                                                                 double *out_coords, t8_geometry_tree_cache_t *cache)
+{
+  update_tree_cache (cmesh, gtreeid, cache);
+  if (cache->gtreeid == gtreeid) {
+    cache->geometry->t8_geom_evaluate_jacobian_with_tree_cache (cache, ref_coords, num_coords, out_coords);
+  }
+  else {
+    /* This geometry keeps per tree data in its own state. We evaluate it one thread at a time. */
+    std::lock_guard<std::mutex> lock (stateful_mutex);
+    evaluate_tree_geometry_jacobian (cmesh, gtreeid, ref_coords, num_coords, out_coords);
+  }
+}
+
+void
+t8_geometry_handler::record_evaluation (t8_cmesh_t cmesh, const double runtime)
+{
+  T8_ASSERT (cmesh->profile != NULL);
+  std::lock_guard<std::mutex> lock (profile_mutex);
+  cmesh->profile->geometry_evaluate_runtime += runtime;
+  cmesh->profile->geometry_evaluate_num_calls++;
+}
@@ -30,6 +30,7 @@
 #include <t8_geometry/t8_geometry.h>
 #include <t8_geometry/t8_geometry_base.hxx>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -153,6 +154,59 @@ struct t8_geometry_handler
     return active_geometry;
   }
 
+  /**
+   * Get the geometry of the provided tree without changing the active tree.
+   * In contrast to \ref get_tree_geometry this function does not load the tree data into the geometry
+   * and may be called concurrently from multiple threads.
+   * \param [in] cmesh   The cmesh.
+   * \param [in] gtreeid The global tree id of the tree for which the geometry should be returned.
+   * \return             The geometry of the tree.
+   */
+  const t8_geometry *
+  get_tree_geometry_const (t8_cmesh_t cmesh, t8_gloidx_t gtreeid) const;
+
+  /**
+   * Evaluate the geometry of the provided tree at the given reference coordinates
+   * without changing the active tree. May be called concurrently from multiple threads,
+   * as long as each thread passes its own \a cache.
+   * Geometries that are not re-entrant are evaluated one thread at a time.
+   * \param [in]  cmesh      The cmesh.
+   * \param [in]  gtreeid    The global tree id of the tree for which the geometry should be evaluated.
+   * \param [in]  ref_coords The reference coordinates at which to evaluate the geometry.
+   * \param [in]  num_coords The number of reference coordinates.
+   * \param [out] out_coords The evaluated coordinates.
+   * \param [in,out] cache   The per-thread tree cache.
+   */
+  void
+  evaluate_tree_geometry_threadsafe (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords,
+                                     const size_t num_coords, double *out_coords, t8_geometry_tree_cache_t *cache);
+
+  /**
+   * Evaluate the Jacobian of the geometry of the provided tree at the given reference coordinates
+   * without changing the active tree. May be called concurrently from multiple threads,
+   * as long as each thread passes its own \a cache.
+   * Geometries that are not re-entrant are evaluated one thread at a time.
+   * \param [in]  cmesh      The cmesh.
+   * \param [in]  gtreeid    The global tree id of the tree for which the geometry should be evaluated.
+   * \param [in]  ref_coords The reference coordinates at which to evaluate the geometry.
+   * \param [in]  num_coords The number of reference coordinates.
+   * \param [out] out_coords The evaluated Jacobian coordinates.
+   * \param [in,out] cache   The per-thread tree cache.
+   */
+  void
+  evaluate_tree_geometry_jacobian_threadsafe (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords,
+                                              const size_t num_coords, double *out_coords,
+                                              t8_geometry_tree_cache_t *cache);
+
+  /**
+   * Add the runtime of a thread-safe evaluation to the profile of the cmesh.
+   * May be called concurrently from multiple threads.
+   * \param [in,out] cmesh   The cmesh. Its profile must not be NULL.
+   * \param [in]     runtime The runtime of the evaluation.
+   */
+  void
+  record_evaluation (t8_cmesh_t cmesh, const double runtime);
+
   /**
    * Evaluate the geometry of the provided tree at the given reference coordinates.
    * \param [in]  cmesh      The cmesh.
@@ -192,10 +246,10 @@ struct t8_geometry_handler
    * \return             The geometry type of the tree.
    */
   inline t8_geometry_type_t
-  get_tree_geometry_type (t8_cmesh_t cmesh, t8_gloidx_t gtreeid)
+  get_tree_geometry_type (t8_cmesh_t cmesh, t8_gloidx_t gtreeid) const
   {
-    update_tree (cmesh, gtreeid);
-    return active_geometry->t8_geom_get_type ();
+    /* The type does not depend on the tree data, so we do not need to activate the tree. */
+    return get_tree_geometry_const (cmesh, gtreeid)->t8_geom_get_type ();
   }
 
   /**
@@ -263,6 +317,16 @@ struct t8_geometry_handler
   void
   update_tree (t8_cmesh_t cmesh, t8_gloidx_t gtreeid);
 
+  /**
+   * Load the data of a tree into a tree cache, if it holds another tree.
+   * For geometries that are not re-entrant only the geometry is stored and the cache stays empty.
+   * \param [in]     cmesh    The cmesh.
+   * \param [in]     gtreeid  The global tree id.
+   * \param [in,out] cache    The per-thread tree cache.
+   */
+  void
+  update_tree_cache (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, t8_geometry_tree_cache_t *cache) const;
+
   /** Stores all geometries that are handled by this geometry_handler. */
   std::unordered_map<size_t, std::unique_ptr<t8_geometry>> registered_geometries;
   /** Points to the currently loaded geometry (the geometry that was used last and is likely to be used next). */
@@ -271,4 +335,8 @@ struct t8_geometry_handler
   t8_gloidx_t active_tree;
   /** The reference count of the geometry handler. TODO: Replace by shared_ptr when cmesh becomes a class. */
   t8_refcount_t rc;
+  /** Serializes the thread-safe evaluation of geometries that are not re-entrant. */
+  std::mutex stateful_mutex;
+  /** Serializes the profiling of thread-safe evaluations. */
+  std::mutex profile_mutex;
 };
@@ -71,6 +71,7 @@ t8_geometry_cad::t8_geometry_cad (int dim, std::string fileprefix, std::string n
   TopExp::MapShapes (cad_shape, TopAbs_FACE, cad_shape_face_map);
   TopExp::MapShapesAndUniqueAncestors (cad_shape, TopAbs_VERTEX, TopAbs_EDGE, cad_shape_vertex2edge_map);
   TopExp::MapShapesAndUniqueAncestors (cad_shape, TopAbs_EDGE, TopAbs_FACE, cad_shape_edge2face_map);
+  t8_geom_resolve_cad_handles ();
 }
 
 t8_geometry_cad::t8_geometry_cad (int dim, const TopoDS_Shape cad_shape, std::string name_in)
@@ -84,6 +85,7 @@ t8_geometry_cad::t8_geometry_cad (int dim, const TopoDS_Shape cad_shape, std::st
   TopExp::MapShapes (cad_shape, TopAbs_FACE, cad_shape_face_map);
   TopExp::MapShapesAndUniqueAncestors (cad_shape, TopAbs_VERTEX, TopAbs_EDGE, cad_shape_vertex2edge_map);
   TopExp::MapShapesAndUniqueAncestors (cad_shape, TopAbs_EDGE, TopAbs_FACE, cad_shape_edge2face_map);
+  t8_geom_resolve_cad_handles ();
 }
 
 t8_geometry_cad::t8_geometry_cad (int dim): t8_geometry_with_vertices (dim, "t8_geom_cad_" + std::to_string (dim))
@@ -91,6 +93,34 @@ t8_geometry_cad::t8_geometry_cad (int dim): t8_geometry_with_vertices (dim, "t8_
   cad_shape.Nullify ();
 }
 
+void
+t8_geometry_cad::t8_geom_resolve_cad_handles ()
+{
+  Standard_Real first, last;
+  /* The shape maps are indexed from 1, we keep index 0 unused. */
+  cad_curves.assign (cad_shape_edge_map.Size () + 1, Handle_Geom_Curve ());
+  cad_surfaces.assign (cad_shape_face_map.Size () + 1, Handle_Geom_Surface ());
+  cad_pcurves.clear ();
+  for (int i_face = 1; i_face <= cad_shape_face_map.Size (); ++i_face) {
+    cad_surfaces[i_face] = BRep_Tool::Surface (TopoDS::Face (cad_shape_face_map.FindKey (i_face)));
+  }
+  for (int i_edge = 1; i_edge <= cad_shape_edge_map.Size (); ++i_edge) {
+    const TopoDS_Edge edge = TopoDS::Edge (cad_shape_edge_map.FindKey (i_edge));
+    cad_curves[i_edge] = BRep_Tool::Curve (edge, first, last);
+    /* Edges that are not part of a face have no parametric curves. */
+    const int edge2face_index = cad_shape_edge2face_map.FindIndex (edge);
+    if (edge2face_index == 0) {
+      continue;
+    }
+    const TopTools_ListOfShape &edge_faces = cad_shape_edge2face_map.FindFromIndex (edge2face_index);
+    for (auto face = edge_faces.begin (); face != edge_faces.end (); ++face) {
+      const int i_face = cad_shape_face_map.FindIndex (*face);
+      cad_pcurves[std::make_pair (i_edge, i_face)]
+        = BRep_Tool::CurveOnSurface (edge, TopoDS::Face (*face), first, last);
+    }
+  }
+}
+
 void
 t8_geometry_cad::t8_geom_evaluate (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords,
                                    const size_t num_coords, double *out_coords) const
@@ -164,7 +194,6 @@ t8_geometry_cad::t8_geom_evaluate_cad_tri (t8_cmesh_t cmesh, t8_gloidx_t gtreeid
   const int num_edges = t8_eclass_num_edges[active_tree_class];
   Handle_Geom_Curve curve;
   Handle_Geom_Surface surface;
-  Standard_Real first, last;
   gp_Pnt pnt;
   double displacement;
   double scaling_factor;
@@ -278,7 +307,7 @@ t8_geometry_cad::t8_geom_evaluate_cad_tri (t8_cmesh_t cmesh, t8_gloidx_t gtreeid
           }
           /* Retrieve surface */
           T8_ASSERT (*faces <= cad_shape_face_map.Size ());
-          surface = BRep_Tool::Surface (TopoDS::Face (cad_shape_face_map.FindKey (*faces)));
+          surface = cad_surfaces[*faces];
           /* Check if surface is valid */
           T8_ASSERT (!surface.IsNull ());
 
@@ -292,7 +321,7 @@ t8_geometry_cad::t8_geom_evaluate_cad_tri (t8_cmesh_t cmesh, t8_gloidx_t gtreeid
       }
       /* Retrieve surface */
       T8_ASSERT (*faces <= cad_shape_face_map.Size ());
-      surface = BRep_Tool::Surface (TopoDS::Face (cad_shape_face_map.FindKey (*faces)));
+      surface = cad_surfaces[*faces];
       /* Check if surface is valid */
       T8_ASSERT (!surface.IsNull ());
 
@@ -334,7 +363,7 @@ t8_geometry_cad::t8_geom_evaluate_cad_tri (t8_cmesh_t cmesh, t8_gloidx_t gtreeid
                                           &interpolated_curve_parameter);
             /* Retrieve curve */
             T8_ASSERT (edges[i_edge] <= cad_shape_edge_map.Size ());
-            curve = BRep_Tool::Curve (TopoDS::Edge (cad_shape_edge_map.FindKey (edges[i_edge])), first, last);
+            curve = cad_curves[edges[i_edge]];
             /* Check if curve is valid */
             T8_ASSERT (!curve.IsNull ());
 
@@ -346,7 +375,7 @@ t8_geometry_cad::t8_geom_evaluate_cad_tri (t8_cmesh_t cmesh, t8_gloidx_t gtreeid
             t8_geom_linear_interpolation (&ref_intersection[(i_edge == 0) + offset_2d], parameters, 2, 1,
                                           interpolated_surface_parameters + offset_2d);
             T8_ASSERT (edges[i_edge + num_edges] <= cad_shape_face_map.Size ());
-            surface = BRep_Tool::Surface (TopoDS::Face (cad_shape_face_map.FindKey (edges[i_edge + num_edges])));
+            surface = cad_surfaces[edges[i_edge + num_edges]];
             /* Check if surface is valid */
             T8_ASSERT (!surface.IsNull ());
 
@@ -388,7 +417,6 @@ t8_geometry_cad::t8_geom_evaluate_cad_quad (t8_cmesh_t cmesh, t8_gloidx_t gtreei
   gp_Pnt pnt;
   Handle_Geom_Curve curve;
   Handle_Geom_Surface surface;
-  Standard_Real first, last;
 
   /* Check if face has a linked geometry */
   if (*faces > 0) {
@@ -439,7 +467,7 @@ t8_geometry_cad::t8_geom_evaluate_cad_quad (t8_cmesh_t cmesh, t8_gloidx_t gtreei
         T8_ASSERT (edge_parameters != NULL);
         T8_ASSERT (edges[i_edge] <= cad_shape_edge_map.Size ());
 
-        curve = BRep_Tool::Curve (TopoDS::Edge (cad_shape_edge_map.FindKey (edges[i_edge])), first, last);
+        curve = cad_curves[edges[i_edge]];
 
         /* Check if curve is valid */
         T8_ASSERT (!curve.IsNull ());
@@ -477,7 +505,7 @@ t8_geometry_cad::t8_geom_evaluate_cad_quad (t8_cmesh_t cmesh, t8_gloidx_t gtreei
 
     /* Retrieve surface */
     T8_ASSERT (*faces <= cad_shape_face_map.Size ());
-    surface = BRep_Tool::Surface (TopoDS::Face (cad_shape_face_map.FindKey (*faces)));
+    surface = cad_surfaces[*faces];
 
     /* Check if surface is valid */
     T8_ASSERT (!surface.IsNull ());
@@ -537,7 +565,7 @@ t8_geometry_cad::t8_geom_evaluate_cad_quad (t8_cmesh_t cmesh, t8_gloidx_t gtreei
           T8_ASSERT (edges[i_edge] <= cad_shape_edge_map.Size ());
           /* Infinite indent loop */
           /* *INDENT-OFF* */
-          curve = BRep_Tool::Curve (TopoDS::Edge (cad_shape_edge_map.FindKey (edges[i_edge])), first, last);
+          curve = cad_curves[edges[i_edge]];
 
           /* Check if curve are valid */
           T8_ASSERT (!curve.IsNull ());
@@ -569,7 +597,7 @@ t8_geometry_cad::t8_geom_evaluate_cad_quad (t8_cmesh_t cmesh, t8_gloidx_t gtreei
         else {
           /* Get surface */
           T8_ASSERT (edges[i_edge + num_edges] <= cad_shape_face_map.Size ());
-          surface = BRep_Tool::Surface (TopoDS::Face (cad_shape_face_map.FindKey (edges[i_edge + num_edges])));
+          surface = cad_surfaces[edges[i_edge + num_edges]];
 
           /* Check if surface is valid */
           T8_ASSERT (!surface.IsNull ());
@@ -622,7 +650,6 @@ t8_geometry_cad::t8_geom_evaluate_cad_tet (t8_cmesh_t cmesh, t8_gloidx_t gtreeid
   double interpolated_surface_parameters[2], interpolated_coords[3];
   Handle_Geom_Curve curve;
   Handle_Geom_Surface surface;
-  Standard_Real first, last;
 
   for (size_t coord = 0; coord < num_coords; ++coord) {
     const int offset_3d = coord * 3;
@@ -675,7 +702,7 @@ t8_geometry_cad::t8_geom_evaluate_cad_tet (t8_cmesh_t cmesh, t8_gloidx_t gtreeid
           T8_ASSERT (edges[i_edge] <= cad_shape_edge_map.Size ());
 
           /* Retrieve the curve and check if curve is valid */
-          curve = BRep_Tool::Curve (TopoDS::Edge (cad_shape_edge_map.FindKey (edges[i_edge])), first, last);
+          curve = cad_curves[edges[i_edge]];
           T8_ASSERT (!curve.IsNull ());
 
           /* Calculate point on curve with the interpolated parameter */
@@ -688,7 +715,7 @@ t8_geometry_cad::t8_geom_evaluate_cad_tet (t8_cmesh_t cmesh, t8_gloidx_t gtreeid
           T8_ASSERT (edges[i_edge + num_edges] <= cad_shape_face_map.Size ());
 
           /* Retrieve the surface and check if surface is valid */
-          surface = BRep_Tool::Surface (TopoDS::Face (cad_shape_face_map.FindKey (edges[i_edge + num_edges])));
+          surface = cad_surfaces[edges[i_edge + num_edges]];
           T8_ASSERT (!surface.IsNull ());
 
           /* Compute point on surface with interpolated parameters */
@@ -783,7 +810,7 @@ t8_geometry_cad::t8_geom_evaluate_cad_tet (t8_cmesh_t cmesh, t8_gloidx_t gtreeid
 
             /* Retrieve the curve of the edge and check if it is valid */
             T8_ASSERT (edges[i_tree_edge] <= cad_shape_edge_map.Size ());
-            curve = BRep_Tool::Curve (TopoDS::Edge (cad_shape_edge_map.FindKey (edges[i_tree_edge])), first, last);
+            curve = cad_curves[edges[i_tree_edge]];
             T8_ASSERT (!curve.IsNull ());
 
             /* Calculate point on curve with interpolated parameter */
@@ -815,7 +842,7 @@ t8_geometry_cad::t8_geom_evaluate_cad_tet (t8_cmesh_t cmesh, t8_gloidx_t gtreeid
 
         /* Retrieve the surface and check if it is valid */
         T8_ASSERT (faces[i_faces] <= cad_shape_face_map.Size ());
-        surface = BRep_Tool::Surface (TopoDS::Face (cad_shape_face_map.FindKey (faces[i_faces])));
+        surface = cad_surfaces[faces[i_faces]];
         T8_ASSERT (!surface.IsNull ());
 
         /* Compute point on surface with interpolated surface parameters */
@@ -868,7 +895,6 @@ t8_geometry_cad::t8_geom_evaluate_cad_hex (t8_cmesh_t cmesh, t8_gloidx_t gtreeid
   double interpolation_coeffs[2], temp_face_vertices[T8_ECLASS_MAX_CORNERS_2D * 3], temp_edge_vertices[2 * 3];
   Handle_Geom_Curve curve;
   Handle_Geom_Surface surface;
-  Standard_Real first, last;
 
   for (size_t coord = 0; coord < num_coords; ++coord) {
     const int offset_3d = coord * 3;
@@ -919,7 +945,7 @@ t8_geometry_cad::t8_geom_evaluate_cad_hex (t8_cmesh_t cmesh, t8_gloidx_t gtreeid
                                         &interpolated_curve_param);
 
           T8_ASSERT (edges[i_edge] <= cad_shape_edge_map.Size ());
-          curve = BRep_Tool::Curve (TopoDS::Edge (cad_shape_edge_map.FindKey (edges[i_edge])), first, last);
+          curve = cad_curves[edges[i_edge]];
 
           /* Check if curve are valid */
           T8_ASSERT (!curve.IsNull ());
@@ -933,7 +959,7 @@ t8_geometry_cad::t8_geom_evaluate_cad_hex (t8_cmesh_t cmesh, t8_gloidx_t gtreeid
                                         interpolated_surface_params);
 
           T8_ASSERT (edges[i_edge + num_edges] <= cad_shape_face_map.Size ());
-          surface = BRep_Tool::Surface (TopoDS::Face (cad_shape_face_map.FindKey (edges[i_edge + num_edges])));
+          surface = cad_surfaces[edges[i_edge + num_edges]];
 
           /* Check if surface is valid */
           T8_ASSERT (!surface.IsNull ());
@@ -1051,9 +1077,7 @@ t8_geometry_cad::t8_geom_evaluate_cad_hex (t8_cmesh_t cmesh, t8_gloidx_t gtreeid
             /* Retrieve the curve of the edge */
             T8_ASSERT (edges[t8_face_edge_to_tree_edge[T8_ECLASS_HEX][i_faces][i_face_edge]]
                        <= cad_shape_edge_map.Size ());
-            curve = BRep_Tool::Curve (TopoDS::Edge (cad_shape_edge_map.FindKey (
-                                        edges[t8_face_edge_to_tree_edge[T8_ECLASS_HEX][i_faces][i_face_edge]])),
-                                      first, last);
+            curve = cad_curves[edges[t8_face_edge_to_tree_edge[T8_ECLASS_HEX][i_faces][i_face_edge]]];
             /* Check if curve is valid */
             T8_ASSERT (!curve.IsNull ());
             /* Calculate point on curve with interpolated parameters */
@@ -1139,7 +1163,7 @@ t8_geometry_cad::t8_geom_evaluate_cad_hex (t8_cmesh_t cmesh, t8_gloidx_t gtreeid
 
         /* Retrieve the surface of the edge */
         T8_ASSERT (faces[i_faces] <= cad_shape_face_map.Size ());
-        surface = BRep_Tool::Surface (TopoDS::Face (cad_shape_face_map.FindKey (faces[i_faces])));
+        surface = cad_surfaces[faces[i_faces]];
 
         /* Check if surface is valid */
         T8_ASSERT (!surface.IsNull ());
@@ -1197,16 +1221,15 @@ t8_geometry_cad::t8_geom_get_cad_point (const int index) const
 const Handle_Geom_Curve
 t8_geometry_cad::t8_geom_get_cad_curve (const int index) const
 {
-  T8_ASSERT (index <= cad_shape_edge_map.Size ());
-  Standard_Real first, last;
-  return BRep_Tool::Curve (TopoDS::Edge (cad_shape_edge_map.FindKey (index)), first, last);
+  T8_ASSERT (0 < index && (size_t) index < cad_curves.size ());
+  return cad_curves[index];
 }
 
 const Handle_Geom_Surface
 t8_geometry_cad::t8_geom_get_cad_surface (const int index) const
 {
-  T8_ASSERT (index <= cad_shape_face_map.Size ());
-  return BRep_Tool::Surface (TopoDS::Face (cad_shape_face_map.FindKey (index)));
+  T8_ASSERT (0 < index && (size_t) index < cad_surfaces.size ());
+  return cad_surfaces[index];
 }
 
 const TopTools_IndexedMapOfShape
@@ -1315,12 +1338,9 @@ t8_geometry_cad::t8_geom_edge_parameter_to_face_parameters (const int edge_index
                                                             const double *surface_params, double *face_params) const
 {
   T8_ASSERT (t8_geometry_cad::t8_geom_is_edge_on_face (edge_index, face_index));
-  Standard_Real first, last;
   gp_Pnt2d uv;
-  TopoDS_Edge edge = TopoDS::Edge (cad_shape_edge_map.FindKey (edge_index));
-  TopoDS_Face face = TopoDS::Face (cad_shape_face_map.FindKey (face_index));
-  Handle_Geom2d_Curve curve_on_surface = BRep_Tool::CurveOnSurface (edge, face, first, last);
-  Handle_Geom_Surface surface = BRep_Tool::Surface (face);
+  const Handle_Geom2d_Curve &curve_on_surface = cad_pcurves.at (std::make_pair (edge_index, face_index));
+  const Handle_Geom_Surface &surface = cad_surfaces[face_index];
   curve_on_surface->D0 (edge_param, uv);
   face_params[0] = uv.X ();
   face_params[1] = uv.Y ();
@@ -41,6 +41,11 @@
 #include <gp_Pnt.hxx>
 #include <Geom_Curve.hxx>
 #include <Geom_Surface.hxx>
+#include <Geom2d_Curve.hxx>
+
+#include <map>
+#include <utility>
+#include <vector>
 
 /**
  * This geometry uses OpenCASCADE CAD geometries to curve
@@ -344,6 +349,14 @@ struct t8_geometry_cad: public t8_geometry_with_vertices
   t8_geom_evaluate_cad_hex (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords, const size_t num_coords,
                             double *out_coords) const;
 
+  /**
+   * Resolve the curves and surfaces of all cad edges and faces and the curves of the edges
+   * on their faces once, such that the evaluation does not look them up in the shape maps
+   * for every call.
+   */
+  void
+  t8_geom_resolve_cad_handles ();
+
   const int *edges;                                /**< The linked edges of the currently active tree. */
   const int *faces;                                /**< The linked faces of the currently active tree. */
   TopoDS_Shape cad_shape;                          /**< cad geometry */
@@ -354,6 +367,10 @@ struct t8_geometry_cad: public t8_geometry_with_vertices
     cad_shape_vertex2edge_map; /**< Maps all TopoDS_Vertex of shape to all its connected TopoDS_Edge */
   TopTools_IndexedDataMapOfShapeListOfShape
     cad_shape_edge2face_map; /**< Maps all TopoDS_Edge of shape to all its connected TopoDS_Face */
+  std::vector<Handle_Geom_Curve> cad_curves;     /**< The curve of each cad edge, indexed as \a cad_shape_edge_map. */
+  std::vector<Handle_Geom_Surface> cad_surfaces; /**< The surface of each cad face, indexed as \a cad_shape_face_map. */
+  std::map<std::pair<int, int>, Handle_Geom2d_Curve>
+    cad_pcurves; /**< The parametric curve of each cad edge on each of its faces, indexed by (edge, face). */
 };
 
 #endif /* T8_WITH_OCC */
@@ -41,30 +41,199 @@ t8_geometry_lagrange::~t8_geometry_lagrange ()
 {
 }
 
+/** The 1D nodes of the tensor product basis functions of the quadrilateral and hexahedral elements.
+ * Entry [i][k] is the index of the 1D basis function in direction k, which belongs to node i,
+ * see \ref t8_geom_lagrange_1d_basis. */
+static const int t8_geom_q4_nodes[4][2] = { { 0, 0 }, { 1, 0 }, { 0, 1 }, { 1, 1 } };
+static const int t8_geom_q9_nodes[9][2]
+  = { { 0, 0 }, { 1, 0 }, { 0, 1 }, { 1, 1 }, { 0, 2 }, { 1, 2 }, { 2, 0 }, { 2, 1 }, { 2, 2 } };
+static const int t8_geom_h8_nodes[8][3]
+  = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 1, 1, 0 }, { 0, 0, 1 }, { 1, 0, 1 }, { 0, 1, 1 }, { 1, 1, 1 } };
+/* clang-format off */
+static const int t8_geom_h27_nodes[27][3] = {
+  { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 1, 1, 0 }, { 0, 0, 1 }, { 1, 0, 1 }, { 0, 1, 1 }, { 1, 1, 1 },
+  { 0, 1, 2 }, { 0, 0, 2 }, { 0, 2, 0 }, { 0, 2, 1 }, { 0, 2, 2 },
+  { 1, 0, 2 }, { 1, 1, 2 }, { 1, 2, 0 }, { 1, 2, 1 }, { 1, 2, 2 },
+  { 2, 0, 0 }, { 2, 0, 1 }, { 2, 0, 2 }, { 2, 1, 0 }, { 2, 1, 1 }, { 2, 1, 2 },
+  { 2, 2, 0 }, { 2, 2, 1 }, { 2, 2, 2 } };
+/* clang-format on */
+
+/** Evaluate the 1D Lagrange basis functions with nodes 0, 1 (and 0.5) and their derivatives.
+ * \param [in]  degree       The polynomial degree, 1 or 2.
+ * \param [in]  x            The point in [0,1].
+ * \param [out] basis        The degree + 1 basis functions at \a x.
+ * \param [out] derivatives  If not NULL, the degree + 1 derivatives at \a x.
+ */
+static inline void
+t8_geom_lagrange_1d_basis (const int degree, const double x, double *basis, double *derivatives)
+{
+  T8_ASSERT (degree == 1 || degree == 2);
+  if (degree == 1) {
+    basis[0] = 1 - x;
+    basis[1] = x;
+    if (derivatives != NULL) {
+      derivatives[0] = -1;
+      derivatives[1] = 1;
+    }
+  }
+  else {
+    basis[0] = (1 - x) * (1 - 2 * x);
+    basis[1] = x * (2 * x - 1);
+    basis[2] = 4 * x * (1 - x);
+    if (derivatives != NULL) {
+      derivatives[0] = 4 * x - 3;
+      derivatives[1] = 4 * x - 1;
+      derivatives[2] = 4 - 8 * x;
+    }
+  }
+}
+
+/** Evaluate tensor product basis functions and their derivatives.
+ * \tparam      dim          The dimension of the element.
+ * \tparam      num_nodes    The number of basis functions.
+ * \param [in]  ref_point    The point in the reference space.
+ * \param [in]  degree       The polynomial degree in each direction.
+ * \param [in]  nodes        The 1D nodes of each basis function, e.g. \ref t8_geom_q9_nodes.
+ * \param [out] basis        The basis functions at \a ref_point.
+ * \param [out] derivatives  If not NULL, the derivatives of the basis functions at \a ref_point.
+ */
+template <int dim, int num_nodes>
+static inline void
+t8_geom_tensor_basis (const double *ref_point, const int degree, const int (*nodes)[dim], double *basis,
+                      double *derivatives)
+{
+  double basis_1d[dim][T8_GEOMETRY_MAX_POLYNOMIAL_DEGREE + 1];
+  double derivatives_1d[dim][T8_GEOMETRY_MAX_POLYNOMIAL_DEGREE + 1];
+  for (int i_dim = 0; i_dim < dim; i_dim++) {
+    t8_geom_lagrange_1d_basis (degree, ref_point[i_dim], basis_1d[i_dim], derivatives_1d[i_dim]);
+  }
+  for (int i_node = 0; i_node < num_nodes; i_node++) {
+    double value = 1;
+    for (int i_dim = 0; i_dim < dim; i_dim++) {
+      value *= basis_1d[i_dim][nodes[i_node][i_dim]];
+    }
+    basis[i_node] = value;
+    if (derivatives != NULL) {
+      for (int j_dim = 0; j_dim < dim; j_dim++) {
+        double derivative = 1;
+        for (int i_dim = 0; i_dim < dim; i_dim++) {
+          derivative *= i_dim == j_dim ? derivatives_1d[i_dim][nodes[i_node][i_dim]]
+                                       : basis_1d[i_dim][nodes[i_node][i_dim]];
+        }
+        derivatives[i_node * dim + j_dim] = derivative;
+      }
+    }
+  }
+}
+
 void
 t8_geometry_lagrange::t8_geom_evaluate (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords,
                                         const size_t num_points, double *out_coords) const
 {
-  if (num_points != 1)
-    SC_ABORT ("Error: Batch computation of geometry not yet supported.");
-  const auto basis_functions = t8_geometry_lagrange::t8_geom_compute_basis (ref_coords);
-  const size_t n_vertex = basis_functions.size ();
-  for (size_t i_component = 0; i_component < T8_ECLASS_MAX_DIM; i_component++) {
-    double inner_product = 0;
-    for (size_t j_vertex = 0; j_vertex < n_vertex; j_vertex++) {
-      const double coordinate = active_tree_vertices[j_vertex * T8_ECLASS_MAX_DIM + i_component];
-      const double basis_function = basis_functions[j_vertex];
-      inner_product += basis_function * coordinate;
-    }
-    out_coords[i_component] = inner_product;
+  t8_geom_evaluate_tree (active_tree_class, *degree, active_tree_vertices, ref_coords, num_points, out_coords);
+}
+
+void
+t8_geometry_lagrange::t8_geom_evaluate_with_tree_cache (const t8_geometry_tree_cache_t *cache,
+                                                        const double *ref_coords, const size_t num_points,
+                                                        double *out_coords) const
+{
+  T8_ASSERT (cache->geometry == this);
+  t8_geom_evaluate_tree (cache->tree_class, *(const int *) cache->tree_data, cache->tree_vertices, ref_coords,
+                         num_points, out_coords);
+}
+
+void
+t8_geometry_lagrange::t8_geom_evaluate_tree (const t8_eclass_t tree_class, const int degree,
+                                             const double *tree_vertices, const double *ref_coords,
+                                             const size_t num_points, double *out_coords)
+{
+  /* Select the basis functions once for all points. */
+  switch (tree_class) {
+  case T8_ECLASS_LINE:
+    if (degree == 1)
+      return t8_geom_evaluate_batch<2, 1, t8_geom_s2_basis> (tree_vertices, ref_coords, num_points, out_coords);
+    if (degree == 2)
+      return t8_geom_evaluate_batch<3, 1, t8_geom_s3_basis> (tree_vertices, ref_coords, num_points, out_coords);
+    break;
+  case T8_ECLASS_TRIANGLE:
+    if (degree == 1)
+      return t8_geom_evaluate_batch<3, 2, t8_geom_t3_basis> (tree_vertices, ref_coords, num_points, out_coords);
+    if (degree == 2)
+      return t8_geom_evaluate_batch<6, 2, t8_geom_t6_basis> (tree_vertices, ref_coords, num_points, out_coords);
+    break;
+  case T8_ECLASS_QUAD:
+    if (degree == 1)
+      return t8_geom_evaluate_batch<4, 2, t8_geom_q4_basis> (tree_vertices, ref_coords, num_points, out_coords);
+    if (degree == 2)
+      return t8_geom_evaluate_batch<9, 2, t8_geom_q9_basis> (tree_vertices, ref_coords, num_points, out_coords);
+    break;
+  case T8_ECLASS_HEX:
+    if (degree == 1)
+      return t8_geom_evaluate_batch<8, 3, t8_geom_h8_basis> (tree_vertices, ref_coords, num_points, out_coords);
+    if (degree == 2)
+      return t8_geom_evaluate_batch<27, 3, t8_geom_h27_basis> (tree_vertices, ref_coords, num_points, out_coords);
+    break;
+  default:
+    break;
   }
+  SC_ABORTF ("Error: Lagrange geometry for degree %i %s not yet implemented. \n", degree,
+             t8_eclass_to_string[tree_class]);
 }
 
 void
 t8_geometry_lagrange::t8_geom_evaluate_jacobian (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords,
                                                  const size_t num_points, double *jacobian) const
 {
-  SC_ABORT_NOT_REACHED ();
+  t8_geom_evaluate_jacobian_tree (active_tree_class, *degree, active_tree_vertices, ref_coords, num_points, jacobian);
+}
+
+void
+t8_geometry_lagrange::t8_geom_evaluate_jacobian_with_tree_cache (const t8_geometry_tree_cache_t *cache,
+                                                                 const double *ref_coords, const size_t num_points,
+                                                                 double *jacobian) const
+{
+  T8_ASSERT (cache->geometry == this);
+  t8_geom_evaluate_jacobian_tree (cache->tree_class, *(const int *) cache->tree_data, cache->tree_vertices,
+                                  ref_coords, num_points, jacobian);
+}
+
+void
+t8_geometry_lagrange::t8_geom_evaluate_jacobian_tree (const t8_eclass_t tree_class, const int degree,
+                                                      const double *tree_vertices, const double *ref_coords,
+                                                      const size_t num_points, double *jacobian)
+{
+  switch (tree_class) {
+  case T8_ECLASS_LINE:
+    if (degree == 1)
+      return t8_geom_evaluate_jacobian_batch<2, 1, t8_geom_s2_basis> (tree_vertices, ref_coords, num_points, jacobian);
+    if (degree == 2)
+      return t8_geom_evaluate_jacobian_batch<3, 1, t8_geom_s3_basis> (tree_vertices, ref_coords, num_points, jacobian);
+    break;
+  case T8_ECLASS_TRIANGLE:
+    if (degree == 1)
+      return t8_geom_evaluate_jacobian_batch<3, 2, t8_geom_t3_basis> (tree_vertices, ref_coords, num_points, jacobian);
+    if (degree == 2)
+      return t8_geom_evaluate_jacobian_batch<6, 2, t8_geom_t6_basis> (tree_vertices, ref_coords, num_points, jacobian);
+    break;
+  case T8_ECLASS_QUAD:
+    if (degree == 1)
+      return t8_geom_evaluate_jacobian_batch<4, 2, t8_geom_q4_basis> (tree_vertices, ref_coords, num_points, jacobian);
+    if (degree == 2)
+      return t8_geom_evaluate_jacobian_batch<9, 2, t8_geom_q9_basis> (tree_vertices, ref_coords, num_points, jacobian);
+    break;
+  case T8_ECLASS_HEX:
+    if (degree == 1)
+      return t8_geom_evaluate_jacobian_batch<8, 3, t8_geom_h8_basis> (tree_vertices, ref_coords, num_points, jacobian);
+    if (degree == 2)
+      return t8_geom_evaluate_jacobian_batch<27, 3, t8_geom_h27_basis> (tree_vertices, ref_coords, num_points,
+                                                                        jacobian);
+    break;
+  default:
+    break;
+  }
+  SC_ABORTF ("Error: Lagrange geometry for degree %i %s not yet implemented. \n", degree,
+             t8_eclass_to_string[tree_class]);
 }
 
 inline void
@@ -76,183 +245,133 @@ t8_geometry_lagrange::t8_geom_load_tree_data (t8_cmesh_t cmesh, t8_gloidx_t gtre
   T8_ASSERT (degree != NULL);
 }
 
-inline std::vector<double>
-t8_geometry_lagrange::t8_geom_compute_basis (const double *ref_coords) const
+void
+t8_geometry_lagrange::t8_geom_fill_tree_cache (t8_cmesh_t cmesh, t8_gloidx_t gtreeid,
+                                               t8_geometry_tree_cache_t *cache) const
 {
-  switch (active_tree_class) {
-  case T8_ECLASS_LINE:
-    switch (*degree) {
-    case 1:
-      return t8_geometry_lagrange::t8_geom_s2_basis (ref_coords);
-    case 2:
-      return t8_geometry_lagrange::t8_geom_s3_basis (ref_coords);
-    }
-  case T8_ECLASS_TRIANGLE:
-    switch (*degree) {
-    case 1:
-      return t8_geometry_lagrange::t8_geom_t3_basis (ref_coords);
-    case 2:
-      return t8_geometry_lagrange::t8_geom_t6_basis (ref_coords);
-    }
-  case T8_ECLASS_QUAD:
-    switch (*degree) {
-    case 1:
-      return t8_geometry_lagrange::t8_geom_q4_basis (ref_coords);
-    case 2:
-      return t8_geometry_lagrange::t8_geom_q9_basis (ref_coords);
+  t8_geometry_with_vertices::t8_geom_fill_tree_cache (cmesh, gtreeid, cache);
+  const t8_locidx_t ltreeid = t8_cmesh_get_local_id (cmesh, gtreeid);
+  cache->tree_data = t8_cmesh_get_attribute (cmesh, t8_get_package_id (), T8_CMESH_LAGRANGE_POLY_DEGREE, ltreeid);
+  T8_ASSERT (cache->tree_data != NULL);
+}
+
+template <int num_nodes, int dim, void (*basis_fn) (const double *, double *, double *)>
+inline void
+t8_geometry_lagrange::t8_geom_evaluate_batch (const double *tree_vertices, const double *ref_coords,
+                                              const size_t num_points, double *out_coords)
+{
+  double basis[num_nodes];
+  for (size_t i_point = 0; i_point < num_points; i_point++) {
+    basis_fn (ref_coords + i_point * dim, basis, NULL);
+    double *out = out_coords + i_point * T8_ECLASS_MAX_DIM;
+    for (int i_component = 0; i_component < T8_ECLASS_MAX_DIM; i_component++) {
+      double inner_product = 0;
+      for (int j_vertex = 0; j_vertex < num_nodes; j_vertex++) {
+        inner_product += basis[j_vertex] * tree_vertices[j_vertex * T8_ECLASS_MAX_DIM + i_component];
+      }
+      out[i_component] = inner_product;
     }
-  case T8_ECLASS_HEX:
-    switch (*degree) {
-    case 1:
-      return t8_geometry_lagrange::t8_geom_h8_basis (ref_coords);
-    case 2:
-      return t8_geometry_lagrange::t8_geom_h27_basis (ref_coords);
+  }
+}
+
+template <int num_nodes, int dim, void (*basis_fn) (const double *, double *, double *)>
+inline void
+t8_geometry_lagrange::t8_geom_evaluate_jacobian_batch (const double *tree_vertices, const double *ref_coords,
+                                                       const size_t num_points, double *jacobian)
+{
+  double basis[num_nodes];
+  double derivatives[num_nodes * dim];
+  for (size_t i_point = 0; i_point < num_points; i_point++) {
+    basis_fn (ref_coords + i_point * dim, basis, derivatives);
+    double *jac = jacobian + i_point * dim * T8_ECLASS_MAX_DIM;
+    /* Column i_dim of the Jacobian is the derivative of the mapping in reference direction i_dim. */
+    for (int i_dim = 0; i_dim < dim; i_dim++) {
+      for (int i_component = 0; i_component < T8_ECLASS_MAX_DIM; i_component++) {
+        double inner_product = 0;
+        for (int j_vertex = 0; j_vertex < num_nodes; j_vertex++) {
+          inner_product
+            += derivatives[j_vertex * dim + i_dim] * tree_vertices[j_vertex * T8_ECLASS_MAX_DIM + i_component];
+        }
+        jac[i_dim * T8_ECLASS_MAX_DIM + i_component] = inner_product;
+      }
     }
-  default:
-    SC_ABORTF ("Error: Lagrange geometry for degree %i %s not yet implemented. \n", *degree,
-               t8_eclass_to_string[active_tree_class]);
   }
 }
 
-inline std::vector<double>
-t8_geometry_lagrange::t8_geom_s2_basis (const double *ref_point) const
+inline void
+t8_geometry_lagrange::t8_geom_s2_basis (const double *ref_point, double *basis, double *derivatives)
 {
-  const double xi = ref_point[0];
-  const std::vector<double> basis_functions = { 1 - xi, xi };
-  return basis_functions;
+  t8_geom_lagrange_1d_basis (1, ref_point[0], basis, derivatives);
 }
 
-inline std::vector<double>
-t8_geometry_lagrange::t8_geom_s3_basis (const double *ref_point) const
+inline void
+t8_geometry_lagrange::t8_geom_s3_basis (const double *ref_point, double *basis, double *derivatives)
 {
-  const double xi = ref_point[0];
-  /* clang-format off */
-  const std::vector<double> basis_functions = {
-    (1 - xi) * (1 - 2 * xi),
-    xi * (2 * xi - 1),
-    4 * xi * (1 - xi) };
-  /* clang-format on */
-  return basis_functions;
+  t8_geom_lagrange_1d_basis (2, ref_point[0], basis, derivatives);
 }
 
-inline std::vector<double>
-t8_geometry_lagrange::t8_geom_t3_basis (const double *ref_point) const
+inline void
+t8_geometry_lagrange::t8_geom_t3_basis (const double *ref_point, double *basis, double *derivatives)
 {
   const double xi = ref_point[0];
   const double eta = ref_point[1];
-  const std::vector<double> basis_functions = { 1 - xi, xi - eta, eta };
-  return basis_functions;
+  basis[0] = 1 - xi;
+  basis[1] = xi - eta;
+  basis[2] = eta;
+  if (derivatives != NULL) {
+    /* clang-format off */
+    derivatives[0] = -1; derivatives[1] = 0;
+    derivatives[2] = 1;  derivatives[3] = -1;
+    derivatives[4] = 0;  derivatives[5] = 1;
+    /* clang-format on */
+  }
 }
 
-inline std::vector<double>
-t8_geometry_lagrange::t8_geom_t6_basis (const double *ref_point) const
+inline void
+t8_geometry_lagrange::t8_geom_t6_basis (const double *ref_point, double *basis, double *derivatives)
 {
   const double xi = ref_point[0];
   const double eta = ref_point[1];
-  /* clang-format off */
-  const std::vector<double> basis_functions = {
-    1 - 3 * xi + 2 * xi * xi,
-    -xi + eta + 2 * xi * xi + 2 * eta * eta - 4 * xi * eta,
-    -eta + 2 * eta * eta,
-    -4 * eta * eta + 4 * xi * eta,
-    4 * eta - 4 * xi * eta,
-    4 * xi - 4 * eta - 4 * xi * xi + 4 * xi * eta };
-  /* clang-format on */
-  return basis_functions;
+  basis[0] = 1 - 3 * xi + 2 * xi * xi;
+  basis[1] = -xi + eta + 2 * xi * xi + 2 * eta * eta - 4 * xi * eta;
+  basis[2] = -eta + 2 * eta * eta;
+  basis[3] = -4 * eta * eta + 4 * xi * eta;
+  basis[4] = 4 * eta - 4 * xi * eta;
+  basis[5] = 4 * xi - 4 * eta - 4 * xi * xi + 4 * xi * eta;
+  if (derivatives != NULL) {
+    /* clang-format off */
+    derivatives[0] = 4 * xi - 3;                derivatives[1] = 0;
+    derivatives[2] = 4 * xi - 4 * eta - 1;      derivatives[3] = 4 * eta - 4 * xi + 1;
+    derivatives[4] = 0;                         derivatives[5] = 4 * eta - 1;
+    derivatives[6] = 4 * eta;                   derivatives[7] = 4 * xi - 8 * eta;
+    derivatives[8] = -4 * eta;                  derivatives[9] = 4 - 4 * xi;
+    derivatives[10] = 4 - 8 * xi + 4 * eta;     derivatives[11] = 4 * xi - 4;
+    /* clang-format on */
+  }
 }
 
-inline std::vector<double>
-t8_geometry_lagrange::t8_geom_q4_basis (const double *ref_point) const
+inline void
+t8_geometry_lagrange::t8_geom_q4_basis (const double *ref_point, double *basis, double *derivatives)
 {
-  const double xi = ref_point[0];
-  const double eta = ref_point[1];
-  /* clang-format off */
-  const std::vector<double> basis_functions = {
-    (1 - xi) * (1 - eta),
-    xi * (1 - eta),
-    eta * (1 - xi),
-    xi * eta };
-  /* clang-format on */
-  return basis_functions;
+  t8_geom_tensor_basis<2, 4> (ref_point, 1, t8_geom_q4_nodes, basis, derivatives);
 }
 
-inline std::vector<double>
-t8_geometry_lagrange::t8_geom_q9_basis (const double *ref_point) const
+inline void
+t8_geometry_lagrange::t8_geom_q9_basis (const double *ref_point, double *basis, double *derivatives)
 {
-  const double xi = ref_point[0];
-  const double eta = ref_point[1];
-  /* clang-format off */
-  const std::vector<double> basis_functions = {
-    4 * (eta - 1) * (eta - 0.5) * (xi - 1) * (xi - 0.5),
-    4 * xi * (eta - 1) * (eta - 0.5) * (xi - 0.5),
-    4 * eta * (eta - 0.5) * (xi - 1) * (xi - 0.5),
-    4 * eta * xi * (eta - 0.5) * (xi - 0.5),
-    -8 * eta * (eta - 1) * (xi - 1) * (xi - 0.5),
-    -8 * eta * xi * (eta - 1) * (xi - 0.5),
-    -8 * xi * (eta - 1) * (eta - 0.5) * (xi - 1),
-    -8 * eta * xi * (eta - 0.5) * (xi - 1),
-    16 * eta * xi * (eta - 1) * (xi - 1) };
-  /* clang-format on */
-  return basis_functions;
-}
-
-inline std::vector<double>
-t8_geometry_lagrange::t8_geom_h8_basis (const double *ref_point) const
+  t8_geom_tensor_basis<2, 9> (ref_point, 2, t8_geom_q9_nodes, basis, derivatives);
+}
+
+inline void
+t8_geometry_lagrange::t8_geom_h8_basis (const double *ref_point, double *basis, double *derivatives)
 {
-  const double xi = ref_point[0];
-  const double eta = ref_point[1];
-  const double zeta = ref_point[2];
-  /* clang-format off */
-  const std::vector<double> basis_functions = {
-    (1 - xi) * (1 - eta) * (1 - zeta),
-    xi * (1 - eta) * (1 - zeta),
-    (1 - xi) * eta * (1 - zeta),
-    xi * eta * (1 - zeta),
-    (1 - xi) * (1 - eta) * zeta,
-    xi * (1 - eta) * zeta,
-    (1 - xi) * eta * zeta,
-    xi * eta * zeta };
-  /* clang-format on */
-  return basis_functions;
-}
-
-inline std::vector<double>
-t8_geometry_lagrange::t8_geom_h27_basis (const double *ref_point) const
+  t8_geom_tensor_basis<3, 8> (ref_point, 1, t8_geom_h8_nodes, basis, derivatives);
+}
+
+inline void
+t8_geometry_lagrange::t8_geom_h27_basis (const double *ref_point, double *basis, double *derivatives)
 {
-  const double xi = ref_point[0];
-  const double eta = ref_point[1];
-  const double zeta = ref_point[2];
-  /* clang-format off */
-  const std::vector<double> basis_functions = {
-    8 * (eta - 1) * (eta - 0.5) * (xi - 1) * (xi - 0.5) * (zeta - 1) * (zeta - 0.5),
-    8 * xi * (eta - 1) * (eta - 0.5) * (xi - 0.5) * (zeta - 1) * (zeta - 0.5),
-    8 * eta * (eta - 0.5) * (xi - 1) * (xi - 0.5) * (zeta - 1) * (zeta - 0.5),
-    8 * eta * xi * (eta - 0.5) * (xi - 0.5) * (zeta - 1) * (zeta - 0.5),
-    8 * zeta * (eta - 1) * (eta - 0.5) * (xi - 1) * (xi - 0.5) * (zeta - 0.5),
-    8 * xi * zeta * (eta - 1) * (eta - 0.5) * (xi - 0.5) * (zeta - 0.5),
-    8 * eta * zeta * (eta - 0.5) * (xi - 1) * (xi - 0.5) * (zeta - 0.5),
-    8 * eta * xi * zeta * (eta - 0.5) * (xi - 0.5) * (zeta - 0.5),
-    -16 * eta * zeta * (eta - 0.5) * (xi - 1) * (xi - 0.5) * (zeta - 1),
-    -16 * zeta * (eta - 1) * (eta - 0.5) * (xi - 1) * (xi - 0.5) * (zeta - 1),
-    -16 * eta * (eta - 1) * (xi - 1) * (xi - 0.5) * (zeta - 1) * (zeta - 0.5),
-    -16 * eta * zeta * (eta - 1) * (xi - 1) * (xi - 0.5) * (zeta - 0.5),
-    32 * eta * zeta * (eta - 1) * (xi - 1) * (xi - 0.5) * (zeta - 1),
-    -16 * xi * zeta * (eta - 1) * (eta - 0.5) * (xi - 0.5) * (zeta - 1),
-    -16 * eta * xi * zeta * (eta - 0.5) * (xi - 0.5) * (zeta - 1),
-    -16 * eta * xi * (eta - 1) * (xi - 0.5) * (zeta - 1) * (zeta - 0.5),
-    -16 * eta * xi * zeta * (eta - 1) * (xi - 0.5) * (zeta - 0.5),
-    32 * eta * xi * zeta * (eta - 1) * (xi - 0.5) * (zeta - 1),
-    -16 * xi * (eta - 1) * (eta - 0.5) * (xi - 1) * (zeta - 1) * (zeta - 0.5),
-    -16 * xi * zeta * (eta - 1) * (eta - 0.5) * (xi - 1) * (zeta - 0.5),
-    32 * xi * zeta * (eta - 1) * (eta - 0.5) * (xi - 1) * (zeta - 1),
-    -16 * eta * xi * (eta - 0.5) * (xi - 1) * (zeta - 1) * (zeta - 0.5),
-    -16 * eta * xi * zeta * (eta - 0.5) * (xi - 1) * (zeta - 0.5),
-    32 * eta * xi * zeta * (eta - 0.5) * (xi - 1) * (zeta - 1),
-    32 * eta * xi * (eta - 1) * (xi - 1) * (zeta - 1) * (zeta - 0.5),
-    32 * eta * xi * zeta * (eta - 1) * (xi - 1) * (zeta - 0.5),
-    -64 * eta * xi * zeta * (eta - 1) * (xi - 1) * (zeta - 1) };
-  /* clang-format on */
-  return basis_functions;
+  t8_geom_tensor_basis<3, 27> (ref_point, 2, t8_geom_h27_nodes, basis, derivatives);
 }
 
 t8_forest_t
@@ -123,7 +123,7 @@ struct t8_geometry_lagrange: public t8_geometry_with_vertices
    * \param [in]  cmesh       The cmesh in which the point lies.
    * \param [in]  gtreeid     The global tree (of the cmesh) in which the reference point is.
    * \param [in]  ref_coords  Array of \a dimension x \a num_points entries, specifying points in the reference space.
-   * \param [in]  num_points  Number of points to map. Currently, only one point is supported.
+   * \param [in]  num_points  Number of points to map.
    * \param [out] out_coords  Coordinates of the mapped points in physical space of \a ref_coords. The length is \a num_points * 3.
    */
   void
@@ -131,7 +131,8 @@ struct t8_geometry_lagrange: public t8_geometry_with_vertices
                     double *out_coords) const;
 
   /**
-   * Compute the Jacobian of the \a t8_geom_evaluate map at a point in the reference space.
+   * Compute the Jacobian of the \a t8_geom_evaluate map at points in the reference space.
+   * The Jacobian is the sum of the vertices weighted with the derivatives of the basis functions.
    * \param [in]  cmesh      The cmesh in which the point lies.
    * \param [in]  gtreeid    The global tree (of the cmesh) in which the reference point is.
    * \param [in]  ref_coords  Array of \a dimension x \a num_points entries, specifying points in the reference space.
@@ -153,13 +154,104 @@ struct t8_geometry_lagrange: public t8_geometry_with_vertices
   virtual void
   t8_geom_load_tree_data (t8_cmesh_t cmesh, t8_gloidx_t gtreeid);
 
+  /** Fill a tree cache with the class, the vertices and the polynomial degree of a tree.
+   * The degree is stored in the \a tree_data of the cache.
+   * \param [in]  cmesh      The cmesh.
+   * \param [in]  gtreeid    The global tree.
+   * \param [out] cache      The cache to fill.
+   */
+  virtual void
+  t8_geom_fill_tree_cache (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, t8_geometry_tree_cache_t *cache) const;
+
+  /**
+   * The Lagrange geometry only needs the tree vertices and the degree and can be evaluated concurrently.
+   * \return True.
+   */
+  virtual bool
+  t8_geom_is_reentrant () const
+  {
+    return true;
+  }
+
+  /**
+   * Maps points from the reference space to the physical space, using the tree data in \a cache.
+   * \param [in]  cache       The tree data, filled by \ref t8_geom_fill_tree_cache.
+   * \param [in]  ref_coords  Array of \a dimension x \a num_points entries, specifying points in the reference space.
+   * \param [in]  num_points  Number of points to map.
+   * \param [out] out_coords  Coordinates of the mapped points in physical space. The length is \a num_points * 3.
+   */
+  virtual void
+  t8_geom_evaluate_with_tree_cache (const t8_geometry_tree_cache_t *cache, const double *ref_coords,
+                                    const size_t num_points, double *out_coords) const;
+
+  /**
+   * Compute the Jacobian at points in the reference space, using the tree data in \a cache.
+   * \param [in]  cache       The tree data, filled by \ref t8_geom_fill_tree_cache.
+   * \param [in]  ref_coords  Array of \a dimension x \a num_points entries, specifying points in the reference space.
+   * \param [in]  num_points  Number of points.
+   * \param [out] jacobian    The Jacobian at \a ref_coords, as in \ref t8_geom_evaluate_jacobian.
+   */
+  virtual void
+  t8_geom_evaluate_jacobian_with_tree_cache (const t8_geometry_tree_cache_t *cache, const double *ref_coords,
+                                             const size_t num_points, double *jacobian) const;
+
  private:
   /**
-   * Evaluates the basis functions of the current tree type at a point.
-   * \param [in]  ref_point  Array of \a dimension entries, specifying the point in the reference space.
+   * Map a batch of points with the basis functions of a tree.
+   * \param [in]  tree_class     The eclass of the tree.
+   * \param [in]  degree         The polynomial degree of the tree.
+   * \param [in]  tree_vertices  The vertices of the tree.
+   * \param [in]  ref_coords     Array of dimension x \a num_points entries, specifying points in the reference space.
+   * \param [in]  num_points     Number of points to map.
+   * \param [out] out_coords     The mapped points. The length is \a num_points * 3.
+   */
+  static void
+  t8_geom_evaluate_tree (const t8_eclass_t tree_class, const int degree, const double *tree_vertices,
+                         const double *ref_coords, const size_t num_points, double *out_coords);
+
+  /**
+   * Compute the Jacobian of a batch of points with the basis functions of a tree.
+   * The parameters are as in \ref t8_geom_evaluate_tree.
+   * \param [out] jacobian       The Jacobians. Array of size \a num_points x dimension x 3.
+   */
+  static void
+  t8_geom_evaluate_jacobian_tree (const t8_eclass_t tree_class, const int degree, const double *tree_vertices,
+                                  const double *ref_coords, const size_t num_points, double *jacobian);
+
+  /**
+   * Map a batch of points with the basis functions of a tree.
+   * The basis functions are evaluated into a buffer on the stack, such that no memory is allocated.
+   * \tparam     num_nodes   The number of basis functions.
+   * \tparam     dim         The dimension of the reference space.
+   * \tparam     basis_fn    The basis functions, e.g. \ref t8_geom_t6_basis.
+   * \param [in]  tree_vertices  The vertices of the tree.
+   * \param [in]  ref_coords  Array of \a dim x \a num_points entries, specifying points in the reference space.
+   * \param [in]  num_points  Number of points to map.
+   * \param [out] out_coords  The mapped points. The length is \a num_points * 3.
+   */
+  template <int num_nodes, int dim, void (*basis_fn) (const double *, double *, double *)>
+  static inline void
+  t8_geom_evaluate_batch (const double *tree_vertices, const double *ref_coords, const size_t num_points,
+                          double *out_coords);
+
+  /**
+   * Compute the Jacobian of a batch of points with the basis functions of a tree.
+   * \tparam     num_nodes   The number of basis functions.
+   * \tparam     dim         The dimension of the reference space.
+   * \tparam     basis_fn    The basis functions, e.g. \ref t8_geom_t6_basis. All basis functions are called as
+   *                         basis_fn (ref_point, basis, derivatives). If \a derivatives is not NULL, it is filled
+   *                         with the derivatives of the basis functions with respect to the reference coordinates.
+   *                         Entry \f$ dim \cdot i + j \f$ is the derivative of the \f$ i \f$-th basis function
+   *                         in direction \f$ j \f$.
+   * \param [in]  tree_vertices  The vertices of the tree.
+   * \param [in]  ref_coords  Array of \a dim x \a num_points entries, specifying points in the reference space.
+   * \param [in]  num_points  Number of points.
+   * \param [out] jacobian    The Jacobians. Array of size \a num_points x \a dim x 3, as in \ref t8_geom_evaluate_jacobian.
    */
-  inline std::vector<double>
-  t8_geom_compute_basis (const double *ref_point) const;
+  template <int num_nodes, int dim, void (*basis_fn) (const double *, double *, double *)>
+  static inline void
+  t8_geom_evaluate_jacobian_batch (const double *tree_vertices, const double *ref_coords, const size_t num_points,
+                                   double *jacobian);
 
   /**
    * Basis functions of a 2-node segment.
@@ -167,11 +259,11 @@ struct t8_geometry_lagrange: public t8_geometry_with_vertices
       x --------- x
      0             1
      \endverbatim
-   * \param ref_point  Point in the reference space.
-   * \return  Basis functions evaluated at the reference point.
+   * \param [in]  ref_point    Point in the reference space.
+   * \param [out] basis        The basis functions evaluated at the reference point.
    */
-  inline std::vector<double>
-  t8_geom_s2_basis (const double *ref_point) const;
+  static inline void
+  t8_geom_s2_basis (const double *ref_point, double *basis, double *derivatives);
 
   /**
    * Basis functions of a 3-node segment.
@@ -179,11 +271,11 @@ struct t8_geometry_lagrange: public t8_geometry_with_vertices
       x ----x---- x
      0      2      1
      \endverbatim
-   * \param ref_point  Point in the reference space.
-   * \return  Basis functions evaluated at the reference point.
+   * \param [in]  ref_point    Point in the reference space.
+   * \param [out] basis        The basis functions evaluated at the reference point.
    */
-  inline std::vector<double>
-  t8_geom_s3_basis (const double *ref_point) const;
+  static inline void
+  t8_geom_s3_basis (const double *ref_point, double *basis, double *derivatives);
 
   /**
    * Basis functions of a 3-node triangle element.
@@ -198,11 +290,11 @@ struct t8_geometry_lagrange: public t8_geometry_with_vertices
       x --------- x
      0             1
      \endverbatim
-   * \param ref_point  Point in the reference space.
-   * \return  Basis functions evaluated at the reference point.
+   * \param [in]  ref_point    Point in the reference space.
+   * \param [out] basis        The basis functions evaluated at the reference point.
    */
-  inline std::vector<double>
-  t8_geom_t3_basis (const double *ref_point) const;
+  static inline void
+  t8_geom_t3_basis (const double *ref_point, double *basis, double *derivatives);
 
   /**
    * Basis functions of a 6-node triangle element.
@@ -217,11 +309,11 @@ struct t8_geometry_lagrange: public t8_geometry_with_vertices
       x --- x --- x
      0      5      1
      \endverbatim
-   * \param ref_point  Point in the reference space.
-   * \return  Basis functions evaluated at the reference point.
+   * \param [in]  ref_point    Point in the reference space.
+   * \param [out] basis        The basis functions evaluated at the reference point.
    */
-  inline std::vector<double>
-  t8_geom_t6_basis (const double *ref_point) const;
+  static inline void
+  t8_geom_t6_basis (const double *ref_point, double *basis, double *derivatives);
 
   /**
    * Basis functions of a 4-node quadrilateral element.
@@ -236,11 +328,11 @@ struct t8_geometry_lagrange: public t8_geometry_with_vertices
       x --------- x
      0             1
      \endverbatim
-   * \param ref_point  Point in the reference space.
-   * \return  Basis functions evaluated at the reference point.
+   * \param [in]  ref_point    Point in the reference space.
+   * \param [out] basis        The basis functions evaluated at the reference point.
    */
-  inline std::vector<double>
-  t8_geom_q4_basis (const double *ref_point) const;
+  static inline void
+  t8_geom_q4_basis (const double *ref_point, double *basis, double *derivatives);
 
   /**
    * Basis functions of a 9-node quadrilateral element.
@@ -255,11 +347,11 @@ struct t8_geometry_lagrange: public t8_geometry_with_vertices
       x ----x---- x
      0      6      1
      \endverbatim
-   * \param ref_point  Point in the reference space.
-   * \return  Basis functions evaluated at the reference point.
+   * \param [in]  ref_point    Point in the reference space.
+   * \param [out] basis        The basis functions evaluated at the reference point.
    */
-  inline std::vector<double>
-  t8_geom_q9_basis (const double *ref_point) const;
+  static inline void
+  t8_geom_q9_basis (const double *ref_point, double *basis, double *derivatives);
 
   /**
    * Basis functions of an 8-node hexahedron element.
@@ -278,11 +370,11 @@ struct t8_geometry_lagrange: public t8_geometry_with_vertices
       x --------- x    -->
      0             1
      \endverbatim
-   * \param ref_point  Point in the reference space.
-   * \return  Basis functions evaluated at the reference point.
+   * \param [in]  ref_point    Point in the reference space.
+   * \param [out] basis        The basis functions evaluated at the reference point.
    */
-  inline std::vector<double>
-  t8_geom_h8_basis (const double *ref_point) const;
+  static inline void
+  t8_geom_h8_basis (const double *ref_point, double *basis, double *derivatives);
 
   /**
    * Basis functions of a 27-node hexahedron element.
@@ -301,11 +393,11 @@ struct t8_geometry_lagrange: public t8_geometry_with_vertices
       x ----x---- x  -->        x ----x---- x  -->        x ----x---- x  -->
      0     18     1            9     20      13          4     19      5
      \endverbatim
-   * \param ref_point  Point in the reference space.
-   * \return  Basis functions evaluated at the reference point.
+   * \param [in]  ref_point    Point in the reference space.
+   * \param [out] basis        The basis functions evaluated at the reference point.
    */
-  inline std::vector<double>
-  t8_geom_h27_basis (const double *ref_point) const;
+  static inline void
+  t8_geom_h27_basis (const double *ref_point, double *basis, double *derivatives);
 
   /** Polynomial degree of the interpolation. */
   const int *degree;
@@ -42,6 +42,14 @@ t8_geometry_linear::t8_geom_evaluate (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, con
   t8_geom_compute_linear_geometry (active_tree_class, active_tree_vertices, ref_coords, num_coords, out_coords);
 }
 
+void
+t8_geometry_linear::t8_geom_evaluate_with_tree_cache (const t8_geometry_tree_cache_t *cache, const double *ref_coords,
+                                                      const size_t num_coords, double *out_coords) const
+{
+  T8_ASSERT (cache->geometry == this);
+  t8_geom_compute_linear_geometry (cache->tree_class, cache->tree_vertices, ref_coords, num_coords, out_coords);
+}
+
 void
 t8_geometry_linear::t8_geom_evaluate_jacobian (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords,
                                                const size_t num_coords, double *jacobian) const
@@ -77,6 +77,27 @@ struct t8_geometry_linear: public t8_geometry_with_vertices
   t8_geom_evaluate (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords, const size_t num_coords,
                     double *out_coords) const;
 
+  /**
+   * The linear geometry only needs the tree vertices and can be evaluated concurrently.
+   * \return True.
+   */
+  virtual bool
+  t8_geom_is_reentrant () const
+  {
+    return true;
+  }
+
+  /**
+   * Maps points in the reference space \f$ [0,1]^\mathrm{dim} \to \mathbb{R}^3 \f$, using the tree data in \a cache.
+   * \param [in]  cache       The tree data, filled by \ref t8_geom_fill_tree_cache.
+   * \param [in]  ref_coords  Array of \a dimension x \a num_coords many entries, specifying points in \f$ [0,1]^\mathrm{dim} \f$.
+   * \param [in]  num_coords  Amount of points of /f$ \mathrm{dim} /f$ to map.
+   * \param [out] out_coords  The mapped coordinates in physical space of \a ref_coords. The length is \a num_coords * 3.
+   */
+  virtual void
+  t8_geom_evaluate_with_tree_cache (const t8_geometry_tree_cache_t *cache, const double *ref_coords,
+                                    const size_t num_coords, double *out_coords) const;
+
   /**
    * Compute the jacobian of the \a t8_geom_evaluate map at a point in the reference space \f$ [0,1]^\mathrm{dim} \f$.
    * \param [in]  cmesh      The cmesh in which the point lies.
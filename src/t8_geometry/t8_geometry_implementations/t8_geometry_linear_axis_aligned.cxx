@@ -60,6 +60,17 @@ t8_geometry_linear_axis_aligned::t8_geom_evaluate (t8_cmesh_t cmesh, t8_gloidx_t
                                                 out_coords);
 }
 
+void
+t8_geometry_linear_axis_aligned::t8_geom_evaluate_with_tree_cache (const t8_geometry_tree_cache_t *cache,
+                                                                   const double *ref_coords, const size_t num_coords,
+                                                                   double *out_coords) const
+{
+  T8_ASSERT (cache->geometry == this);
+  T8_ASSERT (correct_point_order (cache->tree_vertices));
+  t8_geom_compute_linear_axis_aligned_geometry (cache->tree_class, cache->tree_vertices, ref_coords, num_coords,
+                                                out_coords);
+}
+
 void
 t8_geometry_linear_axis_aligned::t8_geom_evaluate_jacobian (t8_cmesh_t cmesh, t8_gloidx_t gtreeid,
                                                             const double *ref_coords, const size_t num_coords,
@@ -0,0 +1,323 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include <t8_eclass.h>
+#include <t8_vec.h>
+#include <t8_geometry/t8_geometry_implementations/t8_geometry_surrogate.hxx>
+
+/** Evaluate the 1D Lagrange polynomials of a set of nodes and their derivatives.
+ * The products over the nodes left and right of each node are accumulated
+ * together with their derivatives, such that no division by x - nodes[k] is needed.
+ * \param [in]  degree       The polynomial degree.
+ * \param [in]  nodes        The \a degree + 1 nodes.
+ * \param [in]  weights      The inverse of the denominator of each Lagrange polynomial.
+ * \param [in]  x            The point at which to evaluate.
+ * \param [out] basis        The \a degree + 1 Lagrange polynomials at \a x.
+ * \param [out] derivatives  If not NULL, the \a degree + 1 derivatives at \a x.
+ */
+static void
+t8_geom_surrogate_basis_1d (const int degree, const double *nodes, const double *weights, const double x,
+                            double *basis, double *derivatives)
+{
+  const int num_nodes = degree + 1;
+  double left[T8_GEOMETRY_SURROGATE_MAX_DEGREE + 2], left_derivative[T8_GEOMETRY_SURROGATE_MAX_DEGREE + 2];
+  double right[T8_GEOMETRY_SURROGATE_MAX_DEGREE + 2], right_derivative[T8_GEOMETRY_SURROGATE_MAX_DEGREE + 2];
+
+  /* left[k] is the product of x - nodes[m] for m < k, right[k] for m >= k. */
+  left[0] = 1;
+  left_derivative[0] = 0;
+  for (int k = 0; k < num_nodes; ++k) {
+    left[k + 1] = left[k] * (x - nodes[k]);
+    left_derivative[k + 1] = left_derivative[k] * (x - nodes[k]) + left[k];
+  }
+  right[num_nodes] = 1;
+  right_derivative[num_nodes] = 0;
+  for (int k = num_nodes - 1; k >= 0; --k) {
+    right[k] = right[k + 1] * (x - nodes[k]);
+    right_derivative[k] = right_derivative[k + 1] * (x - nodes[k]) + right[k + 1];
+  }
+  for (int k = 0; k < num_nodes; ++k) {
+    basis[k] = weights[k] * left[k] * right[k + 1];
+    if (derivatives != NULL) {
+      derivatives[k] = weights[k] * (left_derivative[k] * right[k + 1] + left[k] * right_derivative[k + 1]);
+    }
+  }
+}
+
+t8_geometry_surrogate::t8_geometry_surrogate (std::unique_ptr<t8_geometry> exact, const double tolerance,
+                                              const int max_degree)
+  : t8_geometry_with_vertices (exact->t8_geom_get_dimension (), "t8_geom_surrogate_" + exact->t8_geom_get_name ()),
+    exact_geometry (std::move (exact)), tolerance (tolerance), max_degree (max_degree), active_surrogate (NULL)
+{
+  T8_ASSERT (tolerance > 0);
+  T8_ASSERT (1 <= max_degree && max_degree <= T8_GEOMETRY_SURROGATE_MAX_DEGREE);
+}
+
+void
+t8_geometry_surrogate::t8_geom_evaluate (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords,
+                                         const size_t num_coords, double *out_coords) const
+{
+  T8_ASSERT (active_surrogate != NULL);
+  if (active_surrogate->degree == 0) {
+    exact_geometry->t8_geom_evaluate (cmesh, gtreeid, ref_coords, num_coords, out_coords);
+    return;
+  }
+  const int tree_dim = t8_eclass_to_dimension[active_tree_class];
+  for (size_t i_coord = 0; i_coord < num_coords; ++i_coord) {
+    t8_geom_evaluate_surrogate (active_surrogate, ref_coords + i_coord * tree_dim, out_coords + i_coord * 3, NULL);
+  }
+}
+
+void
+t8_geometry_surrogate::t8_geom_evaluate_jacobian (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords,
+                                                  const size_t num_coords, double *jacobian) const
+{
+  T8_ASSERT (active_surrogate != NULL);
+  if (active_surrogate->degree == 0) {
+    exact_geometry->t8_geom_evaluate_jacobian (cmesh, gtreeid, ref_coords, num_coords, jacobian);
+    return;
+  }
+  const int tree_dim = t8_eclass_to_dimension[active_tree_class];
+  double mapped[3];
+  for (size_t i_coord = 0; i_coord < num_coords; ++i_coord) {
+    t8_geom_evaluate_surrogate (active_surrogate, ref_coords + i_coord * tree_dim, mapped,
+                                jacobian + i_coord * tree_dim * 3);
+  }
+}
+
+void
+t8_geometry_surrogate::t8_geom_load_tree_data (t8_cmesh_t cmesh, t8_gloidx_t gtreeid)
+{
+  t8_geometry_with_vertices::t8_geom_load_tree_data (cmesh, gtreeid);
+  exact_geometry->t8_geom_load_tree_data (cmesh, gtreeid);
+
+  const auto found = surrogates.find (gtreeid);
+  if (found != surrogates.end () && t8_geom_surrogate_is_valid (cmesh, found->second)) {
+    active_surrogate = &found->second;
+    return;
+  }
+
+  /* Compute a new surrogate for this tree. */
+  t8_geometry_surrogate_tree &tree = surrogates[gtreeid];
+  tree.cmesh = cmesh;
+  tree.tree_class = active_tree_class;
+  if (active_tree_vertices != NULL) {
+    tree.tree_vertices.assign (active_tree_vertices,
+                               active_tree_vertices + 3 * t8_eclass_num_vertices[active_tree_class]);
+  }
+  else {
+    tree.tree_vertices.clear ();
+  }
+  tree.degree = 0;
+  if (active_tree_class == T8_ECLASS_LINE || active_tree_class == T8_ECLASS_QUAD
+      || active_tree_class == T8_ECLASS_HEX) {
+    /* Double the degree until the surrogate is accurate enough. The error is only
+     * estimated at a few points, thus we require it to be below half the tolerance. */
+    int degree = 1;
+    for (;;) {
+      if (t8_geom_fit_surrogate (cmesh, gtreeid, degree, &tree) <= 0.5 * tolerance) {
+        tree.degree = degree;
+        break;
+      }
+      if (degree == max_degree) {
+        break;
+      }
+      degree = SC_MIN (2 * degree, max_degree);
+    }
+  }
+  if (tree.degree == 0) {
+    /* The exact geometry is used for this tree. */
+    tree.nodes.clear ();
+    tree.weights.clear ();
+    tree.node_values.clear ();
+  }
+  active_surrogate = &tree;
+}
+
+bool
+t8_geometry_surrogate::t8_geom_tree_negative_volume () const
+{
+  return exact_geometry->t8_geom_tree_negative_volume ();
+}
+
+int
+t8_geometry_surrogate::t8_geom_get_active_surrogate_degree () const
+{
+  T8_ASSERT (active_surrogate != NULL);
+  return active_surrogate->degree;
+}
+
+void
+t8_geometry_surrogate::t8_geom_clear_surrogates ()
+{
+  const t8_cmesh_t active_cmesh = active_surrogate != NULL ? active_surrogate->cmesh : NULL;
+  surrogates.clear ();
+  active_surrogate = NULL;
+  if (active_cmesh != NULL) {
+    /* The handler does not load the active tree again, thus we recompute its surrogate now. */
+    t8_geom_load_tree_data (active_cmesh, active_tree);
+  }
+}
+
+bool
+t8_geometry_surrogate::t8_geom_surrogate_is_valid (t8_cmesh_t cmesh, const t8_geometry_surrogate_tree &tree) const
+{
+  if (tree.cmesh != cmesh || tree.tree_class != active_tree_class) {
+    return false;
+  }
+  if (active_tree_vertices == NULL) {
+    return tree.tree_vertices.empty ();
+  }
+  return tree.tree_vertices.size () == (size_t) 3 * t8_eclass_num_vertices[active_tree_class]
+         && std::equal (tree.tree_vertices.begin (), tree.tree_vertices.end (), active_tree_vertices);
+}
+
+double
+t8_geometry_surrogate::t8_geom_fit_surrogate (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const int degree,
+                                              t8_geometry_surrogate_tree *tree)
+{
+  const int tree_dim = t8_eclass_to_dimension[active_tree_class];
+  const int num_nodes = degree + 1;
+  int num_nodes_dim[3] = { 1, 1, 1 };
+  for (int i_dim = 0; i_dim < tree_dim; ++i_dim) {
+    num_nodes_dim[i_dim] = num_nodes;
+  }
+
+  /* The Chebyshev-Lobatto nodes in [0,1] and the denominators of the Lagrange polynomials. */
+  tree->degree = degree;
+  tree->nodes.resize (num_nodes);
+  tree->weights.resize (num_nodes);
+  for (int k = 0; k < num_nodes; ++k) {
+    tree->nodes[k] = 0.5 - 0.5 * cos (M_PI * k / degree);
+  }
+  for (int k = 0; k < num_nodes; ++k) {
+    double denominator = 1;
+    for (int m = 0; m < num_nodes; ++m) {
+      if (m != k) {
+        denominator *= tree->nodes[k] - tree->nodes[m];
+      }
+    }
+    tree->weights[k] = 1. / denominator;
+  }
+
+  /* Map the tensor product nodes with the exact geometry. The points are mapped one
+   * by one, such that geometries which expect 3 reference coordinates per point work as well. */
+  tree->node_values.resize (3 * num_nodes_dim[0] * num_nodes_dim[1] * num_nodes_dim[2]);
+  double ref_point[3] = { 0, 0, 0 };
+  for (int k2 = 0; k2 < num_nodes_dim[2]; ++k2) {
+    for (int k1 = 0; k1 < num_nodes_dim[1]; ++k1) {
+      for (int k0 = 0; k0 < num_nodes_dim[0]; ++k0) {
+        const int index[3] = { k0, k1, k2 };
+        for (int i_dim = 0; i_dim < tree_dim; ++i_dim) {
+          ref_point[i_dim] = tree->nodes[index[i_dim]];
+        }
+        const int i_node = (k2 * num_nodes_dim[1] + k1) * num_nodes_dim[0] + k0;
+        exact_geometry->t8_geom_evaluate (cmesh, gtreeid, ref_point, 1, tree->node_values.data () + 3 * i_node);
+      }
+    }
+  }
+
+  /* Estimate the error on a grid with degree + 2 points per direction,
+   * which lie between the interpolation nodes. */
+  const int num_test_points = degree + 2;
+  int num_test_points_dim[3] = { 1, 1, 1 };
+  for (int i_dim = 0; i_dim < tree_dim; ++i_dim) {
+    num_test_points_dim[i_dim] = num_test_points;
+  }
+  double max_error = 0;
+  for (int k2 = 0; k2 < num_test_points_dim[2]; ++k2) {
+    for (int k1 = 0; k1 < num_test_points_dim[1]; ++k1) {
+      for (int k0 = 0; k0 < num_test_points_dim[0]; ++k0) {
+        const int index[3] = { k0, k1, k2 };
+        for (int i_dim = 0; i_dim < tree_dim; ++i_dim) {
+          ref_point[i_dim] = (index[i_dim] + 0.5) / num_test_points;
+        }
+        double exact_coords[3], surrogate_coords[3];
+        exact_geometry->t8_geom_evaluate (cmesh, gtreeid, ref_point, 1, exact_coords);
+        t8_geom_evaluate_surrogate (tree, ref_point, surrogate_coords, NULL);
+        max_error = SC_MAX (max_error, t8_vec_dist (exact_coords, surrogate_coords));
+      }
+    }
+  }
+  return max_error;
+}
+
+void
+t8_geometry_surrogate::t8_geom_evaluate_surrogate (const t8_geometry_surrogate_tree *tree, const double *ref_coords,
+                                                   double *out_coords, double *jacobian) const
+{
+  T8_ASSERT (tree->degree > 0);
+  const int tree_dim = t8_eclass_to_dimension[tree->tree_class];
+  const int num_nodes = tree->degree + 1;
+  int num_nodes_dim[3] = { 1, 1, 1 };
+  /* The 1D Lagrange polynomials and their derivatives in each direction.
+   * Unused directions have the single polynomial 1. */
+  double basis[3][T8_GEOMETRY_SURROGATE_MAX_DEGREE + 1];
+  double derivatives[3][T8_GEOMETRY_SURROGATE_MAX_DEGREE + 1];
+  for (int i_dim = 0; i_dim < 3; ++i_dim) {
+    if (i_dim < tree_dim) {
+      num_nodes_dim[i_dim] = num_nodes;
+      t8_geom_surrogate_basis_1d (tree->degree, tree->nodes.data (), tree->weights.data (), ref_coords[i_dim],
+                                  basis[i_dim], jacobian != NULL ? derivatives[i_dim] : NULL);
+    }
+    else {
+      basis[i_dim][0] = 1;
+      derivatives[i_dim][0] = 0;
+    }
+  }
+
+  for (int i_component = 0; i_component < 3; ++i_component) {
+    out_coords[i_component] = 0;
+  }
+  if (jacobian != NULL) {
+    for (int i_entry = 0; i_entry < 3 * tree_dim; ++i_entry) {
+      jacobian[i_entry] = 0;
+    }
+  }
+  const double *values = tree->node_values.data ();
+  for (int k2 = 0; k2 < num_nodes_dim[2]; ++k2) {
+    for (int k1 = 0; k1 < num_nodes_dim[1]; ++k1) {
+      const double weight_21 = basis[2][k2] * basis[1][k1];
+      for (int k0 = 0; k0 < num_nodes_dim[0]; ++k0) {
+        const double *value = values + 3 * ((k2 * num_nodes_dim[1] + k1) * num_nodes_dim[0] + k0);
+        const double weight = weight_21 * basis[0][k0];
+        for (int i_component = 0; i_component < 3; ++i_component) {
+          out_coords[i_component] += weight * value[i_component];
+        }
+        if (jacobian != NULL) {
+          /* The derivative in direction i_dim replaces the polynomial of direction i_dim. */
+          const double weight_derivative[3] = { basis[2][k2] * basis[1][k1] * derivatives[0][k0],
+                                                basis[2][k2] * derivatives[1][k1] * basis[0][k0],
+                                                derivatives[2][k2] * basis[1][k1] * basis[0][k0] };
+          for (int i_dim = 0; i_dim < tree_dim; ++i_dim) {
+            for (int i_component = 0; i_component < 3; ++i_component) {
+              jacobian[3 * i_dim + i_component] += weight_derivative[i_dim] * value[i_component];
+            }
+          }
+        }
+      }
+    }
+  }
+}
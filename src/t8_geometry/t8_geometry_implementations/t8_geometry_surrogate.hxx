@@ -0,0 +1,199 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/** \file t8_geometry_surrogate.hxx
+ * This geometry wraps an expensive geometry, for example a cad geometry, and replaces
+ * its mapping on each tree by a polynomial surrogate as long as the surrogate is accurate
+ * up to a user given tolerance.
+ */
+
+#ifndef T8_GEOMETRY_SURROGATE_HXX
+#define T8_GEOMETRY_SURROGATE_HXX
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <t8.h>
+#include <t8_geometry/t8_geometry_with_vertices.hxx>
+
+/** The maximum polynomial degree of a surrogate in each reference direction. */
+#define T8_GEOMETRY_SURROGATE_MAX_DEGREE 16
+
+/**
+ * Polynomial surrogate of another geometry.
+ *
+ * When a tree is loaded for the first time, the mapping of the exact geometry is
+ * interpolated with tensor product polynomials on Chebyshev-Lobatto nodes of
+ * increasing degree. The interpolation error is estimated at points between the
+ * nodes and the first degree whose error is below the tolerance is kept.
+ * All further evaluations in this tree are pure arithmetic and do not call the
+ * exact geometry.
+ * If no degree up to the maximum degree is accurate enough, or the tree is not a
+ * line, quad or hex, the exact geometry is evaluated instead.
+ *
+ * The surrogates are stored per tree and cmesh. They are recomputed if the vertices
+ * of a tree changed, for example since the geometry is used by a new cmesh.
+ */
+struct t8_geometry_surrogate: public t8_geometry_with_vertices
+{
+ public:
+  /**
+   * Constructor of the surrogate geometry.
+   * The dimension is the one of \a exact and the name is "t8_geom_surrogate_"
+   * followed by the name of \a exact.
+   * \param [in] exact           The geometry to approximate. The surrogate takes ownership.
+   * \param [in] tolerance       The maximum distance between the surrogate and the exact mapping.
+   * \param [in] max_degree      The maximum polynomial degree in each reference direction,
+   *                             1 <= \a max_degree <= \ref T8_GEOMETRY_SURROGATE_MAX_DEGREE.
+   */
+  t8_geometry_surrogate (std::unique_ptr<t8_geometry> exact, const double tolerance,
+                         const int max_degree = T8_GEOMETRY_SURROGATE_MAX_DEGREE);
+
+  /** The destructor. */
+  virtual ~t8_geometry_surrogate ()
+  {
+  }
+
+  /**
+   * Get the type of this geometry.
+   * \return The type.
+   */
+  inline t8_geometry_type_t
+  t8_geom_get_type () const
+  {
+    return T8_GEOMETRY_TYPE_UNDEFINED;
+  };
+
+  /**
+   * Maps points from the reference space to the physical space \f$ \mathbb{R}^3 \f$ with the
+   * surrogate of the current tree, or with the exact geometry if the tree has no surrogate.
+   * \param [in]  cmesh       The cmesh in which the point lies.
+   * \param [in]  gtreeid     The global tree (of the cmesh) in which the reference point is.
+   * \param [in]  ref_coords  Array of \a dimension x \a num_coords many entries, specifying points in \f$ [0,1]^\mathrm{dim} \f$.
+   * \param [in]  num_coords  Amount of points of /f$ \mathrm{dim} /f$ to map.
+   * \param [out] out_coords  The mapped coordinates in physical space of \a ref_coords. The length is \a num_coords * 3.
+   */
+  void
+  t8_geom_evaluate (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords, const size_t num_coords,
+                    double *out_coords) const;
+
+  /**
+   * Compute the jacobian of the \a t8_geom_evaluate map at points in the reference space.
+   * If the current tree has a surrogate, this is the exact jacobian of the surrogate.
+   * \param [in]  cmesh      The cmesh in which the point lies.
+   * \param [in]  gtreeid    The global tree (of the cmesh) in which the reference point is.
+   * \param [in]  ref_coords  Array of \a dimension x \a num_coords many entries, specifying points in \f$ [0,1]^\mathrm{dim} \f$.
+   * \param [in]  num_coords  Amount of points of /f$ \mathrm{dim} /f$ to map.
+   * \param [out] jacobian    The jacobian at \a ref_coords. Array of size \a num_coords x dimension x 3. Indices \f$ 3 \cdot i\f$ , \f$ 3 \cdot i+1 \f$ , \f$ 3 \cdot i+2 \f$
+   *                          correspond to the \f$ i \f$-th column of the jacobian  (Entry \f$ 3 \cdot i + j \f$ is \f$ \frac{\partial f_j}{\partial x_i} \f$).
+   */
+  void
+  t8_geom_evaluate_jacobian (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords, const size_t num_coords,
+                             double *jacobian) const;
+
+  /** Load the tree data of the exact geometry and the surrogate of the tree.
+   * If the tree has no valid surrogate yet, it is computed here.
+   * \param [in]  cmesh      The cmesh.
+   * \param [in]  gtreeid    The global tree.
+   */
+  void
+  t8_geom_load_tree_data (t8_cmesh_t cmesh, t8_gloidx_t gtreeid);
+
+  /**
+   * Check if the currently active tree has a negative volume in the exact geometry.
+   * \return                True (non-zero) if the currently loaded tree has a negative volume. 0 otherwise.
+   */
+  bool
+  t8_geom_tree_negative_volume () const;
+
+  /** Get the polynomial degree of the surrogate of the currently active tree.
+   * \return                The degree, or 0 if the tree is evaluated with the exact geometry.
+   */
+  int
+  t8_geom_get_active_surrogate_degree () const;
+
+  /** Get the geometry that is approximated.
+   * \return                The exact geometry.
+   */
+  const t8_geometry *
+  t8_geom_get_exact_geometry () const
+  {
+    return exact_geometry.get ();
+  }
+
+  /** Discard all surrogates, for example after the exact geometry was modified.
+   * The surrogates are recomputed when their trees are loaded again.
+   */
+  void
+  t8_geom_clear_surrogates ();
+
+ private:
+  /** The surrogate of a single tree. */
+  struct t8_geometry_surrogate_tree
+  {
+    t8_cmesh_t cmesh;                  /**< The cmesh for which the surrogate was computed. */
+    t8_eclass_t tree_class;            /**< The class of the tree. */
+    std::vector<double> tree_vertices; /**< The vertices of the tree when the surrogate was computed. */
+    int degree;                        /**< The polynomial degree, 0 if the exact geometry is used. */
+    std::vector<double> nodes;         /**< The 1D interpolation nodes in [0,1]. */
+    std::vector<double> weights;       /**< The inverse of the denominators of the 1D Lagrange polynomials. */
+    std::vector<double> node_values;   /**< The mapped tensor product nodes, 3 coordinates each. */
+  };
+
+  /** Check whether a stored surrogate was computed for the currently active tree.
+   * \param [in]  cmesh      The cmesh.
+   * \param [in]  tree       The stored surrogate.
+   * \return                 True if \a tree belongs to the active tree of \a cmesh.
+   */
+  bool
+  t8_geom_surrogate_is_valid (t8_cmesh_t cmesh, const t8_geometry_surrogate_tree &tree) const;
+
+  /** Interpolate the exact geometry of the active tree and estimate the interpolation error.
+   * \param [in]  cmesh      The cmesh.
+   * \param [in]  gtreeid    The global tree.
+   * \param [in]  degree     The polynomial degree.
+   * \param [out] tree       On output, the node values are set.
+   * \return                 The maximum distance between the surrogate and the exact geometry at the test points.
+   */
+  double
+  t8_geom_fit_surrogate (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const int degree, t8_geometry_surrogate_tree *tree);
+
+  /** Evaluate the surrogate of the active tree at a single point.
+   * \param [in]  tree       The surrogate.
+   * \param [in]  ref_coords The point in the reference space of the tree.
+   * \param [out] out_coords The mapped point.
+   * \param [out] jacobian   If not NULL, the jacobian at \a ref_coords.
+   */
+  void
+  t8_geom_evaluate_surrogate (const t8_geometry_surrogate_tree *tree, const double *ref_coords, double *out_coords,
+                              double *jacobian) const;
+
+  std::unique_ptr<t8_geometry> exact_geometry; /**< The geometry that is approximated. */
+  double tolerance;                            /**< The maximum allowed error of a surrogate. */
+  int max_degree;                              /**< The maximum polynomial degree of a surrogate. */
+  std::unordered_map<t8_gloidx_t, t8_geometry_surrogate_tree>
+    surrogates;                                       /**< The surrogate of each tree that was loaded. */
+  const t8_geometry_surrogate_tree *active_surrogate; /**< The surrogate of the active tree. */
+};
+
+#endif /* !T8_GEOMETRY_SURROGATE_HXX */
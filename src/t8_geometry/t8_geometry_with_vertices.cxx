@@ -28,28 +28,45 @@
 #include <t8_geometry/t8_geometry_with_vertices.h>
 #include <t8_vec.h>
 
-/* Load the coordinates of the newly active tree to the active_tree_vertices variable. */
-void
-t8_geometry_with_vertices::t8_geom_load_tree_data (t8_cmesh_t cmesh, t8_gloidx_t gtreeid)
+/* Look up the eclass and the vertex coordinates of a tree. */
+static void
+t8_geometry_with_vertices_lookup_tree (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, t8_eclass_t *tree_class,
+                                       const double **tree_vertices)
 {
-  /* Set active id and eclass */
-  t8_locidx_t ltreeid = t8_cmesh_get_local_id (cmesh, gtreeid);
-  active_tree = gtreeid;
+  const t8_locidx_t ltreeid = t8_cmesh_get_local_id (cmesh, gtreeid);
   const t8_locidx_t num_local_trees = t8_cmesh_get_num_local_trees (cmesh);
   if (0 <= ltreeid && ltreeid < num_local_trees) {
-    active_tree_class = t8_cmesh_get_tree_class (cmesh, ltreeid);
+    *tree_class = t8_cmesh_get_tree_class (cmesh, ltreeid);
   }
   else {
-    active_tree_class = t8_cmesh_get_ghost_class (cmesh, ltreeid - num_local_trees);
+    *tree_class = t8_cmesh_get_ghost_class (cmesh, ltreeid - num_local_trees);
   }
   /* Load this trees vertices. */
-  active_tree_vertices = t8_cmesh_get_tree_vertices (cmesh, ltreeid);
+  *tree_vertices = t8_cmesh_get_tree_vertices (cmesh, ltreeid);
 
   /* Check whether we support this class */
-  T8_ASSERT (active_tree_class == T8_ECLASS_VERTEX || active_tree_class == T8_ECLASS_TRIANGLE
-             || active_tree_class == T8_ECLASS_TET || active_tree_class == T8_ECLASS_QUAD
-             || active_tree_class == T8_ECLASS_HEX || active_tree_class == T8_ECLASS_LINE
-             || active_tree_class == T8_ECLASS_PRISM || active_tree_class == T8_ECLASS_PYRAMID);
+  T8_ASSERT (*tree_class == T8_ECLASS_VERTEX || *tree_class == T8_ECLASS_TRIANGLE || *tree_class == T8_ECLASS_TET
+             || *tree_class == T8_ECLASS_QUAD || *tree_class == T8_ECLASS_HEX || *tree_class == T8_ECLASS_LINE
+             || *tree_class == T8_ECLASS_PRISM || *tree_class == T8_ECLASS_PYRAMID);
+}
+
+/* Load the coordinates of the newly active tree to the active_tree_vertices variable. */
+void
+t8_geometry_with_vertices::t8_geom_load_tree_data (t8_cmesh_t cmesh, t8_gloidx_t gtreeid)
+{
+  /* Set active id, eclass and vertices */
+  active_tree = gtreeid;
+  t8_geometry_with_vertices_lookup_tree (cmesh, gtreeid, &active_tree_class, &active_tree_vertices);
+}
+
+void
+t8_geometry_with_vertices::t8_geom_fill_tree_cache (t8_cmesh_t cmesh, t8_gloidx_t gtreeid,
+                                                    t8_geometry_tree_cache_t *cache) const
+{
+  cache->geometry = this;
+  cache->gtreeid = gtreeid;
+  cache->tree_data = NULL;
+  t8_geometry_with_vertices_lookup_tree (cmesh, gtreeid, &cache->tree_class, &cache->tree_vertices);
 }
 
 bool
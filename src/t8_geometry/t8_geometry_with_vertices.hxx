@@ -75,6 +75,15 @@ struct t8_geometry_with_vertices: public t8_geometry
   virtual void
   t8_geom_load_tree_data (t8_cmesh_t cmesh, t8_gloidx_t gtreeid);
 
+  /** Fill a tree cache with the class and the vertex coordinates of a tree.
+   * In contrast to \ref t8_geom_load_tree_data this does not modify the geometry.
+   * \param [in]  cmesh      The cmesh.
+   * \param [in]  gtreeid    The global tree.
+   * \param [out] cache      The cache to fill.
+   */
+  virtual void
+  t8_geom_fill_tree_cache (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, t8_geometry_tree_cache_t *cache) const;
+
   /**
    * Check if the currently active tree has a negative volume
    * \return                True (non-zero) if the currently loaded tree has a negative volume. 0 otherwise.  
@@ -32,6 +32,8 @@
 #include <t8_schemes/t8_default/t8_default_tet/t8_default_tet_cxx.hxx>
 #include <t8_schemes/t8_default/t8_default_prism/t8_default_prism_cxx.hxx>
 #include <t8_schemes/t8_default/t8_default_pyramid/t8_default_pyramid_cxx.hxx>
+#include <t8_schemes/t8_default/t8_default_quad/t8_default_quad_compact_cxx.hxx>
+#include <t8_schemes/t8_default/t8_default_hex/t8_default_hex_compact_cxx.hxx>
 
 /* We want to export the whole implementation to be callable from "C" */
 T8_EXTERN_C_BEGIN ();
@@ -75,6 +77,33 @@ t8_scheme_new_default_cxx (void)
   return s;
 }
 
+t8_scheme_cxx_t *
+t8_scheme_new_compact_cxx (void)
+{
+  t8_scheme_cxx_t *s;
+
+  s = T8_ALLOC_ZERO (t8_scheme_cxx_t, 1);
+  t8_refcount_init (&s->rc);
+
+  s->eclass_schemes[T8_ECLASS_VERTEX] = new t8_default_scheme_vertex_c ();
+  s->eclass_schemes[T8_ECLASS_LINE] = new t8_default_scheme_line_c ();
+  s->eclass_schemes[T8_ECLASS_QUAD] = new t8_default_scheme_quad_compact_c ();
+  s->eclass_schemes[T8_ECLASS_HEX] = new t8_default_scheme_hex_compact_c ();
+  s->eclass_schemes[T8_ECLASS_TRIANGLE] = new t8_default_scheme_tri_c ();
+  s->eclass_schemes[T8_ECLASS_TET] = new t8_default_scheme_tet_c ();
+  /* Prisms and pyramids cast their quad faces to p4est quadrants and cannot
+   * be combined with compact quads. */
+  s->eclass_schemes[T8_ECLASS_PRISM] = NULL;
+  s->eclass_schemes[T8_ECLASS_PYRAMID] = NULL;
+
+  T8_ASSERT (s->eclass_schemes[T8_ECLASS_LINE]->t8_element_maxlevel ()
+             >= s->eclass_schemes[T8_ECLASS_QUAD]->t8_element_maxlevel ());
+  T8_ASSERT (s->eclass_schemes[T8_ECLASS_QUAD]->t8_element_maxlevel ()
+             >= s->eclass_schemes[T8_ECLASS_HEX]->t8_element_maxlevel ());
+
+  return s;
+}
+
 int
 t8_eclass_scheme_is_default (t8_eclass_scheme_c *ts)
 {
@@ -37,6 +37,16 @@ T8_EXTERN_C_BEGIN ();
 t8_scheme_cxx_t *
 t8_scheme_new_default_cxx (void);
 
+/** Return the compact element implementation of t8code.
+ * Quadrilaterals and hexahedra are stored as a single 64-bit key consisting of
+ * the Morton index of the anchor node and the level, see
+ * t8_default_quad_compact_cxx.hxx. All other element classes use the default
+ * implementation, except for prisms and pyramids, which are not supported,
+ * since their quad faces are stored as p4est quadrants.
+ */
+t8_scheme_cxx_t *
+t8_scheme_new_compact_cxx (void);
+
 /** Check whether a given eclass_scheme is on of the default schemes.
  * \param [in] ts   A (pointer to a) scheme
  * \return          True (non-zero) if \a ts is one of the default schemes,
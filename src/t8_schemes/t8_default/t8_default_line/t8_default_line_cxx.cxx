@@ -349,6 +349,16 @@ t8_default_scheme_line_c::t8_element_num_face_children (const t8_element_t *elem
   return T8_DLINE_FACE_CHILDREN;
 }
 
+int
+t8_default_scheme_line_c::t8_element_get_face_corner (const t8_element_t *element, int face, int corner) const
+{
+  T8_ASSERT (t8_element_is_valid (element));
+  T8_ASSERT (0 <= face && face < T8_DLINE_FACES);
+  T8_ASSERT (corner == 0);
+  /* Face i of a line is its vertex i. */
+  return face;
+}
+
 int
 t8_default_scheme_line_c::t8_element_child_id (const t8_element_t *elem) const
 {
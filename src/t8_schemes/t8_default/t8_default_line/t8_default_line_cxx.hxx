@@ -198,11 +198,7 @@ struct t8_default_scheme_line_c: public t8_default_scheme_common_c
    * \return              The corner number of the \a corner-th vertex of \a face.
    */
   virtual int
-  t8_element_get_face_corner (const t8_element_t *element, int face, int corner) const
-  {
-    SC_ABORT ("Not implemented.\n");
-    return 0; /* prevents compiler warning */
-  }
+  t8_element_get_face_corner (const t8_element_t *element, int face, int corner) const;
 
   /** Return the face numbers of the faces sharing an element's corner.
    * \param [in] element  The element.
@@ -0,0 +1,581 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+#include <p4est_bits.h>
+#include <t8_schemes/t8_default/t8_default_quad/t8_default_quad_compact_cxx.hxx>
+
+/* We want to export the whole implementation to be callable from "C" */
+T8_EXTERN_C_BEGIN ();
+
+/* The number of bits of the Morton index below the anchor node of an element of a given level. */
+#define T8_QUAD_COMPACT_SHIFT(level) (P4EST_DIM * (P4EST_QMAXLEVEL - (level)))
+
+int
+t8_default_scheme_quad_compact_c::t8_element_maxlevel (void) const
+{
+  return P4EST_QMAXLEVEL;
+}
+
+int
+t8_default_scheme_quad_compact_c::t8_element_level (const t8_element_t *elem) const
+{
+  T8_ASSERT (t8_element_is_valid (elem));
+  return T8_COMPACT_KEY_LEVEL (t8_compact_get_key (elem));
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_copy (const t8_element_t *source, t8_element_t *dest) const
+{
+  T8_ASSERT (t8_element_is_valid (source));
+  t8_compact_set_key (dest, t8_compact_get_key (source));
+}
+
+int
+t8_default_scheme_quad_compact_c::t8_element_compare (const t8_element_t *elem1, const t8_element_t *elem2) const
+{
+  const t8_default_compact_key_t key1 = t8_compact_get_key (elem1);
+  const t8_default_compact_key_t key2 = t8_compact_get_key (elem2);
+
+  T8_ASSERT (t8_element_is_valid (elem1));
+  T8_ASSERT (t8_element_is_valid (elem2));
+  /* The Morton index is stored in front of the level, thus an ancestor comes before its descendants. */
+  return key1 < key2 ? -1 : key1 != key2;
+}
+
+int
+t8_default_scheme_quad_compact_c::t8_element_equal (const t8_element_t *elem1, const t8_element_t *elem2) const
+{
+  return t8_compact_get_key (elem1) == t8_compact_get_key (elem2);
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_parent (const t8_element_t *elem, t8_element_t *parent) const
+{
+  const t8_default_compact_key_t key = t8_compact_get_key (elem);
+  const int level = T8_COMPACT_KEY_LEVEL (key);
+
+  T8_ASSERT (t8_element_is_valid (elem));
+  T8_ASSERT (level > 0);
+  const uint64_t morton = T8_COMPACT_KEY_MORTON (key) & ~((1ULL << T8_QUAD_COMPACT_SHIFT (level - 1)) - 1);
+  t8_compact_set_key (parent, T8_COMPACT_KEY (morton, level - 1));
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_sibling (const t8_element_t *elem, int sibid, t8_element_t *sibling) const
+{
+  const t8_default_compact_key_t key = t8_compact_get_key (elem);
+  const int level = T8_COMPACT_KEY_LEVEL (key);
+  const int shift = T8_QUAD_COMPACT_SHIFT (level);
+
+  T8_ASSERT (t8_element_is_valid (elem));
+  T8_ASSERT (level > 0);
+  T8_ASSERT (0 <= sibid && sibid < P4EST_CHILDREN);
+  const uint64_t morton
+    = (T8_COMPACT_KEY_MORTON (key) & ~((uint64_t) (P4EST_CHILDREN - 1) << shift)) | ((uint64_t) sibid << shift);
+  t8_compact_set_key (sibling, T8_COMPACT_KEY (morton, level));
+}
+
+int
+t8_default_scheme_quad_compact_c::t8_element_num_faces (const t8_element_t *elem) const
+{
+  T8_ASSERT (t8_element_is_valid (elem));
+  return P4EST_FACES;
+}
+
+int
+t8_default_scheme_quad_compact_c::t8_element_max_num_faces (const t8_element_t *elem) const
+{
+  return P4EST_FACES;
+}
+
+int
+t8_default_scheme_quad_compact_c::t8_element_num_children (const t8_element_t *elem) const
+{
+  T8_ASSERT (t8_element_is_valid (elem));
+  return P4EST_CHILDREN;
+}
+
+int
+t8_default_scheme_quad_compact_c::t8_element_num_face_children (const t8_element_t *elem, int face) const
+{
+  T8_ASSERT (t8_element_is_valid (elem));
+  return 2;
+}
+
+int
+t8_default_scheme_quad_compact_c::t8_element_get_face_corner (const t8_element_t *element, int face, int corner) const
+{
+  T8_ASSERT (0 <= face && face < P4EST_FACES);
+  T8_ASSERT (0 <= corner && corner < 2);
+  return p4est_face_corners[face][corner];
+}
+
+int
+t8_default_scheme_quad_compact_c::t8_element_get_corner_face (const t8_element_t *element, int corner, int face) const
+{
+  T8_ASSERT (t8_element_is_valid (element));
+  T8_ASSERT (0 <= corner && corner < P4EST_CHILDREN);
+  T8_ASSERT (0 <= face && face < 2);
+  return p4est_corner_faces[corner][face];
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_child (const t8_element_t *elem, int childid, t8_element_t *child) const
+{
+  const t8_default_compact_key_t key = t8_compact_get_key (elem);
+  const int level = T8_COMPACT_KEY_LEVEL (key);
+
+  T8_ASSERT (t8_element_is_valid (elem));
+  T8_ASSERT (level < P4EST_QMAXLEVEL);
+  T8_ASSERT (0 <= childid && childid < P4EST_CHILDREN);
+  const uint64_t morton = T8_COMPACT_KEY_MORTON (key) | ((uint64_t) childid << T8_QUAD_COMPACT_SHIFT (level + 1));
+  t8_compact_set_key (child, T8_COMPACT_KEY (morton, level + 1));
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_children (const t8_element_t *elem, int length, t8_element_t *c[]) const
+{
+  const t8_default_compact_key_t key = t8_compact_get_key (elem);
+  const int level = T8_COMPACT_KEY_LEVEL (key);
+
+  T8_ASSERT (t8_element_is_valid (elem));
+  T8_ASSERT (length == P4EST_CHILDREN);
+  T8_ASSERT (level < P4EST_QMAXLEVEL);
+  /* elem may be one of the children, thus we only use the stored key */
+  for (int ichild = 0; ichild < P4EST_CHILDREN; ichild++) {
+    const uint64_t morton = T8_COMPACT_KEY_MORTON (key) | ((uint64_t) ichild << T8_QUAD_COMPACT_SHIFT (level + 1));
+    t8_compact_set_key (c[ichild], T8_COMPACT_KEY (morton, level + 1));
+  }
+}
+
+int
+t8_default_scheme_quad_compact_c::t8_element_child_id (const t8_element_t *elem) const
+{
+  const t8_default_compact_key_t key = t8_compact_get_key (elem);
+  const int level = T8_COMPACT_KEY_LEVEL (key);
+
+  T8_ASSERT (t8_element_is_valid (elem));
+  return level == 0 ? 0 : (int) ((T8_COMPACT_KEY_MORTON (key) >> T8_QUAD_COMPACT_SHIFT (level)) & (P4EST_CHILDREN - 1));
+}
+
+int
+t8_default_scheme_quad_compact_c::t8_element_ancestor_id (const t8_element_t *elem, int level) const
+{
+  T8_ASSERT (t8_element_is_valid (elem));
+  T8_ASSERT (0 <= level && level <= t8_element_level (elem));
+  return level == 0 ? 0
+                    : (int) ((T8_COMPACT_KEY_MORTON (t8_compact_get_key (elem)) >> T8_QUAD_COMPACT_SHIFT (level))
+                             & (P4EST_CHILDREN - 1));
+}
+
+int
+t8_default_scheme_quad_compact_c::t8_element_is_family (t8_element_t *const *fam) const
+{
+  const t8_default_compact_key_t key = t8_compact_get_key (fam[0]);
+  const int level = T8_COMPACT_KEY_LEVEL (key);
+
+  if (level == 0 || t8_element_child_id (fam[0]) != 0) {
+    return 0;
+  }
+  for (int ichild = 1; ichild < P4EST_CHILDREN; ichild++) {
+    const uint64_t morton = T8_COMPACT_KEY_MORTON (key) | ((uint64_t) ichild << T8_QUAD_COMPACT_SHIFT (level));
+    if (t8_compact_get_key (fam[ichild]) != T8_COMPACT_KEY (morton, level)) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_nca (const t8_element_t *elem1, const t8_element_t *elem2,
+                                                  t8_element_t *nca) const
+{
+  const t8_default_compact_key_t key1 = t8_compact_get_key (elem1);
+  const t8_default_compact_key_t key2 = t8_compact_get_key (elem2);
+
+  T8_ASSERT (t8_element_is_valid (elem1));
+  T8_ASSERT (t8_element_is_valid (elem2));
+  int level = SC_MIN (T8_COMPACT_KEY_LEVEL (key1), T8_COMPACT_KEY_LEVEL (key2));
+  const uint64_t difference = T8_COMPACT_KEY_MORTON (key1) ^ T8_COMPACT_KEY_MORTON (key2);
+  if (difference != 0) {
+    /* The highest differing bit belongs to the child id on this level. */
+    const int differing_level = P4EST_QMAXLEVEL - SC_LOG2_64 (difference) / P4EST_DIM;
+    level = SC_MIN (level, differing_level - 1);
+  }
+  const uint64_t morton = T8_COMPACT_KEY_MORTON (key1) & ~((1ULL << T8_QUAD_COMPACT_SHIFT (level)) - 1);
+  t8_compact_set_key (nca, T8_COMPACT_KEY (morton, level));
+}
+
+t8_element_shape_t
+t8_default_scheme_quad_compact_c::t8_element_face_shape (const t8_element_t *elem, int face) const
+{
+  T8_ASSERT (t8_element_is_valid (elem));
+  return T8_ECLASS_LINE;
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_children_at_face (const t8_element_t *elem, int face,
+                                                               t8_element_t *children[], int num_children,
+                                                               int *child_indices) const
+{
+  T8_ASSERT (t8_element_is_valid (elem));
+  T8_ASSERT (0 <= face && face < P4EST_FACES);
+  T8_ASSERT (num_children == t8_element_num_face_children (elem, face));
+
+  /* The children at a face are the children at the face's corners.
+   * We compute the second child first, since the usage allows for elem == children[0]. */
+  const int first_child = p4est_face_corners[face][0];
+  const int second_child = p4est_face_corners[face][1];
+  this->t8_element_child (elem, second_child, children[1]);
+  this->t8_element_child (elem, first_child, children[0]);
+  if (child_indices != NULL) {
+    child_indices[0] = first_child;
+    child_indices[1] = second_child;
+  }
+}
+
+int
+t8_default_scheme_quad_compact_c::t8_element_face_child_face (const t8_element_t *elem, int face,
+                                                              int face_child) const
+{
+  T8_ASSERT (t8_element_is_valid (elem));
+  /* For quadrants the face enumeration of children is the same as for the parent. */
+  return face;
+}
+
+int
+t8_default_scheme_quad_compact_c::t8_element_face_parent_face (const t8_element_t *elem, int face) const
+{
+  T8_ASSERT (t8_element_is_valid (elem));
+  if (t8_element_level (elem) == 0) {
+    return face;
+  }
+  /* The face is a subface of the parent if the child id matches one of the face's corners */
+  const int child_id = t8_element_child_id (elem);
+  if (child_id == p4est_face_corners[face][0] || child_id == p4est_face_corners[face][1]) {
+    return face;
+  }
+  return -1;
+}
+
+int
+t8_default_scheme_quad_compact_c::t8_element_tree_face (const t8_element_t *elem, int face) const
+{
+  T8_ASSERT (t8_element_is_valid (elem));
+  T8_ASSERT (0 <= face && face < P4EST_FACES);
+  /* For quadrants the face and the tree face number are the same. */
+  return face;
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_transform_face (const t8_element_t *elem1, t8_element_t *elem2,
+                                                             int orientation, int sign, int is_smaller_face) const
+{
+  p4est_quadrant_t q, p;
+
+  T8_ASSERT (t8_element_is_valid (elem1));
+  t8_compact_quad_to_quadrant (t8_compact_get_key (elem1), &q);
+  t8_compact_quad_to_quadrant (0, &p);
+  quad_scheme.t8_element_transform_face ((const t8_element_t *) &q, (t8_element_t *) &p, orientation, sign,
+                                         is_smaller_face);
+  t8_compact_set_key (elem2, t8_compact_quad_from_quadrant (&p));
+}
+
+int
+t8_default_scheme_quad_compact_c::t8_element_extrude_face (const t8_element_t *face,
+                                                           const t8_eclass_scheme_c *face_scheme, t8_element_t *elem,
+                                                           int root_face) const
+{
+  p4est_quadrant_t q;
+
+  t8_compact_quad_to_quadrant (0, &q);
+  const int quad_face = quad_scheme.t8_element_extrude_face (face, face_scheme, (t8_element_t *) &q, root_face);
+  t8_compact_set_key (elem, t8_compact_quad_from_quadrant (&q));
+  return quad_face;
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_first_descendant_face (const t8_element_t *elem, int face,
+                                                                    t8_element_t *first_desc, int level) const
+{
+  p4est_quadrant_t q, desc;
+
+  T8_ASSERT (t8_element_is_valid (elem));
+  T8_ASSERT (0 <= level && level <= P4EST_QMAXLEVEL);
+  t8_compact_quad_to_quadrant (t8_compact_get_key (elem), &q);
+  p4est_quadrant_corner_descendant (&q, &desc, p4est_face_corners[face][0], level);
+  t8_compact_set_key (first_desc, t8_compact_quad_from_quadrant (&desc));
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_last_descendant_face (const t8_element_t *elem, int face,
+                                                                   t8_element_t *last_desc, int level) const
+{
+  p4est_quadrant_t q, desc;
+
+  T8_ASSERT (t8_element_is_valid (elem));
+  T8_ASSERT (0 <= level && level <= P4EST_QMAXLEVEL);
+  t8_compact_quad_to_quadrant (t8_compact_get_key (elem), &q);
+  p4est_quadrant_corner_descendant (&q, &desc, p4est_face_corners[face][1], level);
+  t8_compact_set_key (last_desc, t8_compact_quad_from_quadrant (&desc));
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_boundary_face (const t8_element_t *elem, int face,
+                                                            t8_element_t *boundary,
+                                                            const t8_eclass_scheme_c *boundary_scheme) const
+{
+  p4est_quadrant_t q;
+
+  T8_ASSERT (t8_element_is_valid (elem));
+  t8_compact_quad_to_quadrant (t8_compact_get_key (elem), &q);
+  quad_scheme.t8_element_boundary_face ((const t8_element_t *) &q, face, boundary, boundary_scheme);
+}
+
+int
+t8_default_scheme_quad_compact_c::t8_element_is_root_boundary (const t8_element_t *elem, int face) const
+{
+  p4est_quadrant_t q;
+
+  T8_ASSERT (t8_element_is_valid (elem));
+  t8_compact_quad_to_quadrant (t8_compact_get_key (elem), &q);
+  return quad_scheme.t8_element_is_root_boundary ((const t8_element_t *) &q, face);
+}
+
+int
+t8_default_scheme_quad_compact_c::t8_element_face_neighbor_inside (const t8_element_t *elem, t8_element_t *neigh,
+                                                                   int face, int *neigh_face) const
+{
+  p4est_quadrant_t q, n;
+
+  T8_ASSERT (t8_element_is_valid (elem));
+  T8_ASSERT (0 <= face && face < P4EST_FACES);
+  t8_compact_quad_to_quadrant (t8_compact_get_key (elem), &q);
+  p4est_quadrant_face_neighbor (&q, face, &n);
+  T8_ASSERT (neigh_face != NULL);
+  *neigh_face = p4est_face_dual[face];
+  /* A neighbor outside of the root cannot be stored as a key. Its key is only
+   * valid if the neighbor is inside the root. */
+  t8_compact_set_key (neigh, t8_compact_quad_from_quadrant (&n));
+  return p4est_quadrant_is_inside_root (&n);
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_set_linear_id (t8_element_t *elem, int level, t8_linearidx_t id) const
+{
+  T8_ASSERT (0 <= level && level <= P4EST_QMAXLEVEL);
+  T8_ASSERT (0 <= id && id < ((t8_linearidx_t) 1) << P4EST_DIM * level);
+  t8_compact_set_key (elem, T8_COMPACT_KEY ((uint64_t) id << T8_QUAD_COMPACT_SHIFT (level), level));
+}
+
+t8_linearidx_t
+t8_default_scheme_quad_compact_c::t8_element_get_linear_id (const t8_element_t *elem, int level) const
+{
+  T8_ASSERT (t8_element_is_valid (elem));
+  T8_ASSERT (0 <= level && level <= P4EST_QMAXLEVEL);
+  return T8_COMPACT_KEY_MORTON (t8_compact_get_key (elem)) >> T8_QUAD_COMPACT_SHIFT (level);
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_first_descendant (const t8_element_t *elem, t8_element_t *desc,
+                                                               int level) const
+{
+  T8_ASSERT (t8_element_is_valid (elem));
+  T8_ASSERT (t8_element_level (elem) <= level && level <= P4EST_QMAXLEVEL);
+  t8_compact_set_key (desc, T8_COMPACT_KEY (T8_COMPACT_KEY_MORTON (t8_compact_get_key (elem)), level));
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_last_descendant (const t8_element_t *elem, t8_element_t *desc,
+                                                              int level) const
+{
+  const t8_default_compact_key_t key = t8_compact_get_key (elem);
+
+  T8_ASSERT (t8_element_is_valid (elem));
+  T8_ASSERT (T8_COMPACT_KEY_LEVEL (key) <= level && level <= P4EST_QMAXLEVEL);
+  const uint64_t morton = T8_COMPACT_KEY_MORTON (key) + (1ULL << T8_QUAD_COMPACT_SHIFT (T8_COMPACT_KEY_LEVEL (key)))
+                          - (1ULL << T8_QUAD_COMPACT_SHIFT (level));
+  t8_compact_set_key (desc, T8_COMPACT_KEY (morton, level));
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_successor (const t8_element_t *elem1, t8_element_t *elem2) const
+{
+  const t8_default_compact_key_t key = t8_compact_get_key (elem1);
+  const int level = T8_COMPACT_KEY_LEVEL (key);
+
+  T8_ASSERT (t8_element_is_valid (elem1));
+  T8_ASSERT (T8_COMPACT_KEY_MORTON (key) >> T8_QUAD_COMPACT_SHIFT (level) < (1ULL << (P4EST_DIM * level)) - 1);
+  t8_compact_set_key (elem2, T8_COMPACT_KEY (T8_COMPACT_KEY_MORTON (key) + (1ULL << T8_QUAD_COMPACT_SHIFT (level)),
+                                             level));
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_anchor (const t8_element_t *elem, int coord[3]) const
+{
+  p4est_quadrant_t q;
+
+  T8_ASSERT (t8_element_is_valid (elem));
+  t8_compact_quad_to_quadrant (t8_compact_get_key (elem), &q);
+  coord[0] = q.x;
+  coord[1] = q.y;
+  coord[2] = 0;
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_vertex_integer_coords (const t8_element_t *elem, int vertex,
+                                                                    int coords[]) const
+{
+  p4est_quadrant_t q;
+
+  T8_ASSERT (t8_element_is_valid (elem));
+  t8_compact_quad_to_quadrant (t8_compact_get_key (elem), &q);
+  quad_scheme.t8_element_vertex_integer_coords ((const t8_element_t *) &q, vertex, coords);
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_vertex_reference_coords (const t8_element_t *elem, const int vertex,
+                                                                      double coords[]) const
+{
+  p4est_quadrant_t q;
+
+  T8_ASSERT (t8_element_is_valid (elem));
+  t8_compact_quad_to_quadrant (t8_compact_get_key (elem), &q);
+  quad_scheme.t8_element_vertex_reference_coords ((const t8_element_t *) &q, vertex, coords);
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_reference_coords (const t8_element_t *elem, const double *ref_coords,
+                                                               const size_t num_coords, double *out_coords) const
+{
+  p4est_quadrant_t q;
+
+  T8_ASSERT (t8_element_is_valid (elem));
+  t8_compact_quad_to_quadrant (t8_compact_get_key (elem), &q);
+  quad_scheme.t8_element_reference_coords ((const t8_element_t *) &q, ref_coords, num_coords, out_coords);
+}
+
+int
+t8_default_scheme_quad_compact_c::t8_element_refines_irregular () const
+{
+  /* Quads refine regularly */
+  return 0;
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_new (int length, t8_element_t **elem) const
+{
+  t8_default_scheme_common_c::t8_element_new (length, elem);
+  for (int ielem = 0; ielem < length; ielem++) {
+    t8_element_root (elem[ielem]);
+  }
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_init (int length, t8_element_t *elem) const
+{
+#ifdef T8_ENABLE_DEBUG
+  for (int ielem = 0; ielem < length; ielem++) {
+    ((t8_default_compact_key_t *) elem)[ielem] = 0;
+  }
+#endif
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_root (t8_element_t *elem) const
+{
+  t8_compact_set_key (elem, 0);
+}
+
+#ifdef T8_ENABLE_DEBUG
+int
+t8_default_scheme_quad_compact_c::t8_element_is_valid (const t8_element_t *elem) const
+{
+  const t8_default_compact_key_t key = t8_compact_get_key (elem);
+  const int level = T8_COMPACT_KEY_LEVEL (key);
+  const uint64_t morton = T8_COMPACT_KEY_MORTON (key);
+
+  /* The level must be allowed and the Morton index must not have bits below the level. */
+  return level <= P4EST_QMAXLEVEL && (morton & ((1ULL << T8_QUAD_COMPACT_SHIFT (level)) - 1)) == 0
+         && morton < (1ULL << (P4EST_DIM * P4EST_QMAXLEVEL));
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_to_string (const t8_element_t *elem, char *debug_string,
+                                                        const int string_size) const
+{
+  p4est_quadrant_t q;
+
+  T8_ASSERT (t8_element_is_valid (elem));
+  T8_ASSERT (debug_string != NULL);
+  t8_compact_quad_to_quadrant (t8_compact_get_key (elem), &q);
+  snprintf (debug_string, string_size, "x: %i, y: %i, level: %i", q.x, q.y, q.level);
+}
+#endif
+
+/* Constructor */
+t8_default_scheme_quad_compact_c::t8_default_scheme_quad_compact_c (void)
+{
+  eclass = T8_ECLASS_QUAD;
+  element_size = sizeof (t8_default_compact_key_t);
+  ts_context = sc_mempool_new (element_size);
+}
+
+t8_default_scheme_quad_compact_c::~t8_default_scheme_quad_compact_c ()
+{
+  /* The mempool is destroyed by the destructor of the default_common scheme. */
+}
+
+/* each key is packed as one 64-bit integer */
+void
+t8_default_scheme_quad_compact_c::t8_element_MPI_Pack (t8_element_t **const elements, const unsigned int count,
+                                                       void *send_buffer, const int buffer_size, int *position,
+                                                       sc_MPI_Comm comm) const
+{
+  for (unsigned int ielem = 0; ielem < count; ielem++) {
+    const int mpiret = sc_MPI_Pack (elements[ielem], 1, T8_MPI_LINEARIDX, send_buffer, buffer_size, position, comm);
+    SC_CHECK_MPI (mpiret);
+  }
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_MPI_Pack_size (const unsigned int count, sc_MPI_Comm comm,
+                                                            int *pack_size) const
+{
+  int datasize = 0;
+  const int mpiret = sc_MPI_Pack_size (1, T8_MPI_LINEARIDX, comm, &datasize);
+  SC_CHECK_MPI (mpiret);
+  *pack_size = count * datasize;
+}
+
+void
+t8_default_scheme_quad_compact_c::t8_element_MPI_Unpack (void *recvbuf, const int buffer_size, int *position,
+                                                         t8_element_t **elements, const unsigned int count,
+                                                         sc_MPI_Comm comm) const
+{
+  for (unsigned int ielem = 0; ielem < count; ielem++) {
+    const int mpiret = sc_MPI_Unpack (recvbuf, buffer_size, position, elements[ielem], 1, T8_MPI_LINEARIDX, comm);
+    SC_CHECK_MPI (mpiret);
+  }
+}
+
+T8_EXTERN_C_END ();
@@ -0,0 +1,289 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/** \file t8_default_quad_compact_cxx.hxx
+ * A quadrilateral scheme that stores each element as a single 64-bit key instead
+ * of a p4est_quadrant_t. The key holds the Morton index of the anchor node on
+ * level P4EST_QMAXLEVEL in its upper bits and the level in its lowest
+ * T8_COMPACT_LEVEL_BITS bits. Thus, comparing two keys as integers is the same
+ * as comparing the elements along the space-filling curve.
+ * The tree operations work directly on the keys. The face operations convert
+ * the key to a p4est_quadrant_t and use the default quad scheme.
+ */
+
+#ifndef T8_DEFAULT_QUAD_COMPACT_CXX_HXX
+#define T8_DEFAULT_QUAD_COMPACT_CXX_HXX
+
+#include <t8_schemes/t8_default/t8_default_quad/t8_default_quad_cxx.hxx>
+
+/** The storage of a compact element. */
+typedef t8_linearidx_t t8_default_compact_key_t;
+
+/** The number of bits of a compact key that store the level. */
+#define T8_COMPACT_LEVEL_BITS 5
+
+/** Return the level of a compact key. */
+#define T8_COMPACT_KEY_LEVEL(key) ((int) ((key) & ((1 << T8_COMPACT_LEVEL_BITS) - 1)))
+
+/** Return the Morton index of the anchor node of a compact key. */
+#define T8_COMPACT_KEY_MORTON(key) ((key) >> T8_COMPACT_LEVEL_BITS)
+
+/** Build a compact key from a Morton index and a level. */
+#define T8_COMPACT_KEY(morton, level) (((morton) << T8_COMPACT_LEVEL_BITS) | (t8_default_compact_key_t) (level))
+
+/** Return the key stored in an element. */
+static inline t8_default_compact_key_t
+t8_compact_get_key (const t8_element_t *elem)
+{
+  return *(const t8_default_compact_key_t *) elem;
+}
+
+/** Store a key in an element. */
+static inline void
+t8_compact_set_key (t8_element_t *elem, const t8_default_compact_key_t key)
+{
+  *(t8_default_compact_key_t *) elem = key;
+}
+
+/** Spread the lower 32 bits of a coordinate to the even bits of a 64-bit integer. */
+static inline uint64_t
+t8_compact_spread_2d (uint64_t x)
+{
+  x &= 0xffffffffULL;
+  x = (x | (x << 16)) & 0x0000ffff0000ffffULL;
+  x = (x | (x << 8)) & 0x00ff00ff00ff00ffULL;
+  x = (x | (x << 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  x = (x | (x << 2)) & 0x3333333333333333ULL;
+  x = (x | (x << 1)) & 0x5555555555555555ULL;
+  return x;
+}
+
+/** Inverse of \ref t8_compact_spread_2d. */
+static inline uint64_t
+t8_compact_compress_2d (uint64_t x)
+{
+  x &= 0x5555555555555555ULL;
+  x = (x | (x >> 1)) & 0x3333333333333333ULL;
+  x = (x | (x >> 2)) & 0x0f0f0f0f0f0f0f0fULL;
+  x = (x | (x >> 4)) & 0x00ff00ff00ff00ffULL;
+  x = (x | (x >> 8)) & 0x0000ffff0000ffffULL;
+  x = (x | (x >> 16)) & 0x00000000ffffffffULL;
+  return x;
+}
+
+/** Compute the compact key of a quadrant. */
+static inline t8_default_compact_key_t
+t8_compact_quad_from_quadrant (const p4est_quadrant_t *q)
+{
+  const int shift = P4EST_MAXLEVEL - P4EST_QMAXLEVEL;
+  const uint64_t morton = t8_compact_spread_2d ((uint32_t) q->x >> shift)
+                          | (t8_compact_spread_2d ((uint32_t) q->y >> shift) << 1);
+  /* Quadrants outside of the root may occur as face neighbors, we cut off their coordinates. */
+  return T8_COMPACT_KEY (morton & ((1ULL << (P4EST_DIM * P4EST_QMAXLEVEL)) - 1), q->level);
+}
+
+/** Compute the quadrant of a compact key. */
+static inline void
+t8_compact_quad_to_quadrant (t8_default_compact_key_t key, p4est_quadrant_t *q)
+{
+  const int shift = P4EST_MAXLEVEL - P4EST_QMAXLEVEL;
+  const uint64_t morton = T8_COMPACT_KEY_MORTON (key);
+  P4EST_QUADRANT_INIT (q);
+  q->x = (p4est_qcoord_t) (t8_compact_compress_2d (morton) << shift);
+  q->y = (p4est_qcoord_t) (t8_compact_compress_2d (morton >> 1) << shift);
+  q->level = T8_COMPACT_KEY_LEVEL (key);
+  T8_QUAD_SET_TDIM (q, 2);
+}
+
+/** The compact quadrilateral scheme. See \ref t8_eclass_scheme_c for the documentation
+ * of the member functions. */
+struct t8_default_scheme_quad_compact_c: public t8_default_scheme_common_c
+{
+ public:
+  /** Constructor. */
+  t8_default_scheme_quad_compact_c ();
+
+  ~t8_default_scheme_quad_compact_c ();
+
+  virtual void
+  t8_element_new (int length, t8_element_t **elem) const;
+
+  virtual void
+  t8_element_init (int length, t8_element_t *elem) const;
+
+  virtual int
+  t8_element_maxlevel (void) const;
+
+  virtual int
+  t8_element_level (const t8_element_t *elem) const;
+
+  virtual void
+  t8_element_copy (const t8_element_t *source, t8_element_t *dest) const;
+
+  virtual int
+  t8_element_compare (const t8_element_t *elem1, const t8_element_t *elem2) const;
+
+  virtual int
+  t8_element_equal (const t8_element_t *elem1, const t8_element_t *elem2) const;
+
+  virtual void
+  t8_element_parent (const t8_element_t *elem, t8_element_t *parent) const;
+
+  virtual void
+  t8_element_sibling (const t8_element_t *elem, int sibid, t8_element_t *sibling) const;
+
+  virtual int
+  t8_element_num_faces (const t8_element_t *elem) const;
+
+  virtual int
+  t8_element_max_num_faces (const t8_element_t *elem) const;
+
+  virtual int
+  t8_element_num_children (const t8_element_t *elem) const;
+
+  virtual int
+  t8_element_num_face_children (const t8_element_t *elem, int face) const;
+
+  virtual int
+  t8_element_get_face_corner (const t8_element_t *element, int face, int corner) const;
+
+  virtual int
+  t8_element_get_corner_face (const t8_element_t *element, int corner, int face) const;
+
+  virtual void
+  t8_element_child (const t8_element_t *elem, int childid, t8_element_t *child) const;
+
+  virtual void
+  t8_element_children (const t8_element_t *elem, int length, t8_element_t *c[]) const;
+
+  virtual int
+  t8_element_child_id (const t8_element_t *elem) const;
+
+  virtual int
+  t8_element_ancestor_id (const t8_element_t *elem, int level) const;
+
+  virtual int
+  t8_element_is_family (t8_element_t *const *fam) const;
+
+  virtual void
+  t8_element_nca (const t8_element_t *elem1, const t8_element_t *elem2, t8_element_t *nca) const;
+
+  virtual t8_element_shape_t
+  t8_element_face_shape (const t8_element_t *elem, int face) const;
+
+  virtual void
+  t8_element_children_at_face (const t8_element_t *elem, int face, t8_element_t *children[], int num_children,
+                               int *child_indices) const;
+
+  virtual int
+  t8_element_face_child_face (const t8_element_t *elem, int face, int face_child) const;
+
+  virtual int
+  t8_element_face_parent_face (const t8_element_t *elem, int face) const;
+
+  virtual int
+  t8_element_tree_face (const t8_element_t *elem, int face) const;
+
+  virtual void
+  t8_element_transform_face (const t8_element_t *elem1, t8_element_t *elem2, int orientation, int sign,
+                             int is_smaller_face) const;
+
+  virtual int
+  t8_element_extrude_face (const t8_element_t *face, const t8_eclass_scheme_c *face_scheme, t8_element_t *elem,
+                           int root_face) const;
+
+  virtual void
+  t8_element_first_descendant_face (const t8_element_t *elem, int face, t8_element_t *first_desc, int level) const;
+
+  virtual void
+  t8_element_last_descendant_face (const t8_element_t *elem, int face, t8_element_t *last_desc, int level) const;
+
+  virtual void
+  t8_element_boundary_face (const t8_element_t *elem, int face, t8_element_t *boundary,
+                            const t8_eclass_scheme_c *boundary_scheme) const;
+
+  virtual int
+  t8_element_is_root_boundary (const t8_element_t *elem, int face) const;
+
+  virtual int
+  t8_element_face_neighbor_inside (const t8_element_t *elem, t8_element_t *neigh, int face, int *neigh_face) const;
+
+  virtual void
+  t8_element_set_linear_id (t8_element_t *elem, int level, t8_linearidx_t id) const;
+
+  virtual t8_linearidx_t
+  t8_element_get_linear_id (const t8_element_t *elem, int level) const;
+
+  virtual void
+  t8_element_first_descendant (const t8_element_t *elem, t8_element_t *desc, int level) const;
+
+  virtual void
+  t8_element_last_descendant (const t8_element_t *elem, t8_element_t *desc, int level) const;
+
+  virtual void
+  t8_element_successor (const t8_element_t *elem1, t8_element_t *elem2) const;
+
+  virtual void
+  t8_element_anchor (const t8_element_t *elem, int anchor[3]) const;
+
+  virtual void
+  t8_element_vertex_integer_coords (const t8_element_t *elem, int vertex, int coords[]) const;
+
+  virtual void
+  t8_element_vertex_reference_coords (const t8_element_t *elem, const int vertex, double coords[]) const;
+
+  virtual void
+  t8_element_reference_coords (const t8_element_t *elem, const double *ref_coords, const size_t num_coords,
+                               double *out_coords) const;
+
+  virtual int
+  t8_element_refines_irregular (void) const;
+
+#ifdef T8_ENABLE_DEBUG
+  virtual int
+  t8_element_is_valid (const t8_element_t *elem) const;
+
+  virtual void
+  t8_element_to_string (const t8_element_t *elem, char *debug_string, const int string_size) const;
+#endif
+
+  virtual void
+  t8_element_root (t8_element_t *elem) const;
+
+  /** Each key is packed as one 64-bit integer. */
+  virtual void
+  t8_element_MPI_Pack (t8_element_t **const elements, const unsigned int count, void *send_buffer, int buffer_size,
+                       int *position, sc_MPI_Comm comm) const;
+
+  virtual void
+  t8_element_MPI_Pack_size (const unsigned int count, sc_MPI_Comm comm, int *pack_size) const;
+
+  virtual void
+  t8_element_MPI_Unpack (void *recvbuf, const int buffer_size, int *position, t8_element_t **elements,
+                         const unsigned int count, sc_MPI_Comm comm) const;
+
+ private:
+  /** The default quad scheme, used for the face operations on decoded keys. */
+  t8_default_scheme_quad_c quad_scheme;
+};
+
+#endif /* !T8_DEFAULT_QUAD_COMPACT_CXX_HXX */
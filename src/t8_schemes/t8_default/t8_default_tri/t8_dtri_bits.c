@@ -36,21 +36,21 @@ static t8_dtri_cube_id_t
 compute_cubeid (const t8_dtri_t *t, int level)
 {
   t8_dtri_cube_id_t id = 0;
-  t8_dtri_coord_t h;
 
   /* TODO: assert that 0 < level? This may simplify code elsewhere */
 
   T8_ASSERT (0 <= level && level <= T8_DTRI_MAXLEVEL);
-  h = T8_DTRI_LEN (level);
 
   if (level == 0) {
     return 0;
   }
 
-  id |= ((t->x & h) ? 0x01 : 0);
-  id |= ((t->y & h) ? 0x02 : 0);
+  /* The bit of T8_DTRI_LEN (level) in each coordinate, shifted to its position in the cube-id. */
+  const int shift = T8_DTRI_MAXLEVEL - level;
+  id |= (t->x >> shift) & 0x01;
+  id |= ((t->y >> shift) & 0x01) << 1;
 #ifdef T8_DTRI_TO_DTET
-  id |= ((t->z & h) ? 0x04 : 0);
+  id |= ((t->z >> shift) & 0x01) << 2;
 #endif
 
   return id;
@@ -95,6 +95,60 @@ compute_type (const t8_dtri_t *t, int level)
   return compute_type_ext (t, level, t->type, t->level);
 }
 
+/* Compute the type of t's ancestor of level "level" in constant time from the
+ * coordinates of t. In contrast to compute_type, the runtime does not depend on t->level - level. */
+static t8_dtri_type_t
+compute_type_from_coords (const t8_dtri_t *t, int level)
+{
+  t8_dtri_coord_t delta_x, delta_y, diff_xy;
+#ifdef T8_DTRI_TO_DTET
+  t8_dtri_coord_t delta_z, diff_xz, diff_yz;
+#endif /* T8_DTRI_TO_DTET */
+
+  T8_ASSERT (0 <= level && level <= T8_DTRI_MAXLEVEL);
+
+  /* delta_{x,y} = t->{x,y} - ancestor->{x,y}
+   * the difference of the coordinates.
+   * Needed to compute the type of the ancestor. */
+  delta_x = t->x & (T8_DTRI_LEN (level) - 1);
+  delta_y = t->y & (T8_DTRI_LEN (level) - 1);
+#ifdef T8_DTRI_TO_DTET
+  delta_z = t->z & (T8_DTRI_LEN (level) - 1);
+#endif
+
+#ifndef T8_DTRI_TO_DTET
+  /* The type of the ancestor depends on delta_x - delta_y */
+  diff_xy = delta_x - delta_y;
+  if (diff_xy > 0) {
+    return 0;
+  }
+  else if (diff_xy < 0) {
+    return 1;
+  }
+  T8_ASSERT (diff_xy == 0);
+  return t->type;
+#else
+  /* The signs of the three diffs determine the type of the ancestor.
+   * delta_x > delta_y holds for types 0, 1 and 5,
+   * delta_x > delta_z holds for types 0, 1 and 2,
+   * delta_y > delta_z holds for types 1, 2 and 3.
+   * If a diff is zero, the relation that holds for t's type is used.
+   * These three bits determine the type uniquely, two of the eight combinations cannot occur. */
+  const int8_t type_by_relations[8] = { 4, 3, -1, 2, 5, -1, 0, 1 };
+  int relations;
+
+  diff_xy = delta_x - delta_y;
+  diff_xz = delta_x - delta_z;
+  diff_yz = delta_y - delta_z;
+
+  relations = (diff_xy > 0 || (diff_xy == 0 && ((0x23 >> t->type) & 1))) << 2;
+  relations |= (diff_xz > 0 || (diff_xz == 0 && ((0x07 >> t->type) & 1))) << 1;
+  relations |= (diff_yz > 0 || (diff_yz == 0 && ((0x0e >> t->type) & 1)));
+  T8_ASSERT (type_by_relations[relations] >= 0);
+  return type_by_relations[relations];
+#endif /* T8_DTRI_TO_DTET */
+}
+
 void
 t8_dtri_copy (const t8_dtri_t *t, t8_dtri_t *dest)
 {
@@ -118,21 +172,89 @@ t8_dtri_equal (const t8_dtri_t *elem1, const t8_dtri_t *elem2)
 int
 t8_dtri_compare (const t8_dtri_t *t1, const t8_dtri_t *t2)
 {
-  int maxlvl;
-  t8_linearidx_t id1, id2;
-
-  /* Compute the bigger level of the two */
-  maxlvl = SC_MAX (t1->level, t2->level);
-  /* Compute the linear ids of the elements */
-  id1 = t8_dtri_linear_id (t1, maxlvl);
-  id2 = t8_dtri_linear_id (t2, maxlvl);
-  if (id1 == id2) {
-    /* The linear ids are the same, the triangle with the smaller level is considered smaller */
-    T8_ASSERT (t1->level != t2->level || t8_dtri_is_equal (t1, t2));
-    return t1->level - t2->level;
-  }
-  /* return negative if id1 < id2, zero if id1 = id2, positive if id1 > id2 */
-  return id1 < id2 ? -1 : id1 != id2;
+  /* We do not compute the linear ids of t1 and t2, but find the first level at which
+   * their ancestors differ. The local ids of these two ancestors decide the order. */
+  const int min_level = SC_MIN (t1->level, t2->level);
+  uint32_t exclor;
+  int c_level, level;
+
+  /* Find the deepest level c_level at which the ancestors of t1 and t2 lie in the same cube. */
+  exclor = (t1->x ^ t2->x) | (t1->y ^ t2->y);
+#ifdef T8_DTRI_TO_DTET
+  exclor |= t1->z ^ t2->z;
+#endif
+  c_level = min_level;
+  if (exclor != 0) {
+    c_level = SC_MIN (T8_DTRI_MAXLEVEL - (SC_LOG2_32 (exclor) + 1), min_level);
+  }
+
+  /* Two ancestors in the same cube are equal if and only if they have the same type. */
+  if (c_level == 0 || compute_type_from_coords (t1, c_level) == compute_type_from_coords (t2, c_level)) {
+    if (c_level == min_level) {
+      /* One of t1 and t2 is an ancestor of the other (or they are equal).
+       * The linear ids at the bigger level agree if and only if the finer element is the
+       * first descendant of the coarser one, which is the case if and only if they have the same anchor. */
+      if (t1->x == t2->x && t1->y == t2->y
+#ifdef T8_DTRI_TO_DTET
+          && t1->z == t2->z
+#endif
+      ) {
+        T8_ASSERT (t1->type == t2->type);
+        return t1->level - t2->level;
+      }
+      T8_ASSERT (t1->level != t2->level);
+      /* The coarser element is the smaller one */
+      return t1->level < t2->level ? -1 : 1;
+    }
+    /* The ancestors at c_level are equal, their children at c_level + 1 lie in different cubes. */
+    level = c_level + 1;
+  }
+  else {
+    /* The ancestors at c_level lie in the same cube but differ in type.
+     * Equal ancestors at a level imply equal ancestors at all smaller levels,
+     * so we can search for the first level at which the ancestors differ.
+     * The invariant is that the ancestors at low_level are equal and those at level differ.
+     * Since the ancestors usually differ only close to c_level, we first search upwards
+     * with increasing step size and then bisect. */
+    int low_level = 0;
+    int step = 1;
+    level = c_level;
+    while (level - step > 0) {
+      const int probe_level = level - step;
+      if (compute_type_from_coords (t1, probe_level) == compute_type_from_coords (t2, probe_level)) {
+        low_level = probe_level;
+        break;
+      }
+      level = probe_level;
+      step *= 2;
+    }
+    while (level - low_level > 1) {
+      const int mid_level = (low_level + level) / 2;
+      if (compute_type_from_coords (t1, mid_level) == compute_type_from_coords (t2, mid_level)) {
+        low_level = mid_level;
+      }
+      else {
+        level = mid_level;
+      }
+    }
+  }
+
+  /* The ancestors of t1 and t2 at level - 1 are equal and those at level differ.
+   * Since they are children of the same parent, their local ids decide the order. */
+  const int iloc1 = t8_dtri_type_cid_to_Iloc[compute_type_from_coords (t1, level)][compute_cubeid (t1, level)];
+  const int iloc2 = t8_dtri_type_cid_to_Iloc[compute_type_from_coords (t2, level)][compute_cubeid (t2, level)];
+  T8_ASSERT (iloc1 != iloc2);
+#ifdef T8_ENABLE_DEBUG
+  {
+    /* Check the result against the comparison of the linear ids */
+    const int maxlvl = SC_MAX (t1->level, t2->level);
+    const t8_linearidx_t id1 = t8_dtri_linear_id (t1, maxlvl);
+    const t8_linearidx_t id2 = t8_dtri_linear_id (t2, maxlvl);
+    T8_ASSERT ((id1 < id2) == (iloc1 < iloc2));
+  }
+#endif
+  /* return negative if t1 < t2, positive if t1 > t2 */
+  return iloc1 < iloc2 ? -1 : 1;
 }
 
 void
@@ -163,124 +285,16 @@ t8_dtri_ancestor (const t8_dtri_t *t, int level, t8_dtri_t *ancestor)
    * the arithmetic computation of ancestor type
    * opposed to iteratively computing the parent type.
    */
-  t8_dtri_coord_t delta_x, delta_y, diff_xy;
-#ifdef T8_DTRI_TO_DTET
-  t8_dtri_coord_t delta_z, diff_xz, diff_yz;
-  t8_dtet_type_t possible_types[6] = { 1, 1, 1, 1, 1, 1 };
-  int i;
-#ifdef T8_ENABLE_DEBUG
-  int set_type = 0;
-#endif
-#endif /* T8_DTRI_TO_DTET */
-
-  /* delta_{x,y} = t->{x,y} - ancestor->{x,y}
-   * the difference of the coordinates.
-   * Needed to compute the type of the ancestor. */
-  delta_x = t->x & (T8_DTRI_LEN (level) - 1);
-  delta_y = t->y & (T8_DTRI_LEN (level) - 1);
-#ifdef T8_DTRI_TO_DTET
-  delta_z = t->z & (T8_DTRI_LEN (level) - 1);
-#endif
+  /* The type of the ancestor. It is necessary to compute it first,
+   * since ancestor and t could point to the same triangle. */
+  ancestor->type = compute_type_from_coords (t, level);
 
-  /* The coordinates of the ancestor. It is necessary
-   * to compute the delta first, since ancestor and t
-   * could point to the same triangle. */
+  /* The coordinates of the ancestor. */
   ancestor->x = t->x & ~(T8_DTRI_LEN (level) - 1);
   ancestor->y = t->y & ~(T8_DTRI_LEN (level) - 1);
 #ifdef T8_DTRI_TO_DTET
   ancestor->z = t->z & ~(T8_DTRI_LEN (level) - 1);
 #endif
-
-#ifndef T8_DTRI_TO_DTET
-  /* The type of the ancestor depends on delta_x - delta_y */
-  diff_xy = delta_x - delta_y;
-  if (diff_xy > 0) {
-    ancestor->type = 0;
-  }
-  else if (diff_xy < 0) {
-    ancestor->type = 1;
-  }
-  else {
-    T8_ASSERT (diff_xy == 0);
-    ancestor->type = t->type;
-  }
-
-#else
-  /* The sign of each diff reduces the number of possible types
- * for the ancestor. At the end only one possible type is left,
- * this type's entry in the possible_types array will be positive.
- */
-
-  diff_xy = delta_x - delta_y;
-  diff_xz = delta_x - delta_z;
-  diff_yz = delta_y - delta_z;
-
-  /* delta_x - delta_y */
-  if (diff_xy > 0) {
-    possible_types[2] = possible_types[3] = possible_types[4] = 0;
-  }
-  else if (diff_xy < 0) {
-    possible_types[0] = possible_types[1] = possible_types[5] = 0;
-  }
-  else {
-    T8_ASSERT (diff_xy == 0);
-    if (t->type == 0 || t->type == 1 || t->type == 5) {
-      possible_types[2] = possible_types[3] = possible_types[4] = 0;
-    }
-    else {
-      possible_types[0] = possible_types[1] = possible_types[5] = 0;
-    }
-  }
-
-  /* delta_x - delta_z */
-  if (diff_xz > 0) {
-    possible_types[3] = possible_types[4] = possible_types[5] = 0;
-  }
-  else if (diff_xz < 0) {
-    possible_types[0] = possible_types[1] = possible_types[2] = 0;
-  }
-  else {
-    T8_ASSERT (diff_xz == 0);
-    if (t->type == 0 || t->type == 1 || t->type == 2) {
-      possible_types[3] = possible_types[4] = possible_types[5] = 0;
-    }
-    else {
-      possible_types[0] = possible_types[1] = possible_types[2] = 0;
-    }
-  }
-
-  /* delta_y - delta_z */
-  if (diff_yz > 0) {
-    possible_types[0] = possible_types[4] = possible_types[5] = 0;
-  }
-  else if (diff_yz < 0) {
-    possible_types[1] = possible_types[2] = possible_types[3] = 0;
-  }
-  else {
-    T8_ASSERT (diff_yz == 0);
-    if (t->type == 1 || t->type == 2 || t->type == 3) {
-      possible_types[0] = possible_types[4] = possible_types[5] = 0;
-    }
-    else {
-      possible_types[1] = possible_types[2] = possible_types[3] = 0;
-    }
-  }
-
-  /* Got through possible_types array and find the only entry
-   * that is nonzero
-   */
-  for (i = 0; i < 6; i++) {
-    T8_ASSERT (possible_types[i] == 0 || possible_types[i] == 1);
-    if (possible_types[i] == 1) {
-      ancestor->type = i;
-#ifdef T8_ENABLE_DEBUG
-      T8_ASSERT (set_type != 1);
-      set_type = 1;
-#endif
-    }
-  }
-  T8_ASSERT (set_type == 1);
-#endif /* T8_DTRI_TO_DTET */
   ancestor->level = level;
 }
 
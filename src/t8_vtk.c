@@ -28,6 +28,14 @@
 int
 t8_write_pvtu (const char *filename, int num_procs, int write_tree, int write_rank, int write_level, int write_id,
                int num_data, t8_vtk_data_field_t *data)
+{
+  return t8_write_pvtu_ext (filename, num_procs, write_tree, write_rank, write_level, write_id, num_data, data,
+                            T8_VTK_FORMAT_STRING);
+}
+
+int
+t8_write_pvtu_ext (const char *filename, int num_procs, int write_tree, int write_rank, int write_level, int write_id,
+                   int num_data, t8_vtk_data_field_t *data, const char *format)
 {
   char pvtufilename[BUFSIZ], filename_cpy[BUFSIZ];
   FILE *pvtufile;
@@ -66,7 +74,7 @@ t8_write_pvtu (const char *filename, int num_procs, int write_tree, int write_ra
   fprintf (pvtufile,
            "      <PDataArray type=\"%s\" Name=\"Position\""
            " NumberOfComponents=\"3\" format=\"%s\"/>\n",
-           T8_VTK_FLOAT_NAME, T8_VTK_FORMAT_STRING);
+           T8_VTK_FLOAT_NAME, format);
   fprintf (pvtufile, "    </PPoints>\n");
 
   if (num_data > 0) {
@@ -130,7 +138,7 @@ t8_write_pvtu (const char *filename, int num_procs, int write_tree, int write_ra
         fprintf (pvtufile,
                  "      "
                  "<PDataArray type=\"%s\" Name=\"%s\" format=\"%s\"/>\n",
-                 T8_VTK_FLOAT_NAME, description, T8_VTK_FORMAT_STRING);
+                 T8_VTK_FLOAT_NAME, description, format);
       }
 
       /* Write vector data fields */
@@ -149,7 +157,7 @@ t8_write_pvtu (const char *filename, int num_procs, int write_tree, int write_ra
                  "      "
                  "<PDataArray type=\"%s\" Name=\"%s\" NumberOfComponents=\"3\" "
                  "format=\"%s\"/>\n",
-                 T8_VTK_FLOAT_NAME, description, T8_VTK_FORMAT_STRING);
+                 T8_VTK_FLOAT_NAME, description, format);
       }
       fprintf (pvtufile, "    </PPointData>\n");
     }
@@ -203,32 +211,32 @@ t8_write_pvtu (const char *filename, int num_procs, int write_tree, int write_ra
     fprintf (pvtufile,
              "      "
              "<PDataArray type=\"%s\" Name=\"treeid\" format=\"%s\"/>\n",
-             T8_VTK_GLOIDX, T8_VTK_FORMAT_STRING);
+             T8_VTK_GLOIDX, format);
   }
   if (write_rank) {
     fprintf (pvtufile,
              "      "
              "<PDataArray type=\"%s\" Name=\"mpirank\" format=\"%s\"/>\n",
-             "Int32", T8_VTK_FORMAT_STRING);
+             "Int32", format);
   }
   if (write_level) {
     fprintf (pvtufile,
              "      "
              "<PDataArray type=\"%s\" Name=\"level\" format=\"%s\"/>\n",
-             "Int32", T8_VTK_FORMAT_STRING);
+             "Int32", format);
   }
   if (write_id) {
     fprintf (pvtufile,
              "      "
              "<PDataArray type=\"%s\" Name=\"element_id\" format=\"%s\"/>\n",
-             T8_VTK_LOCIDX, T8_VTK_FORMAT_STRING);
+             T8_VTK_LOCIDX, format);
   }
   /* Write data fields */
   for (idata = 0; idata < num_scalars; idata++) {
     fprintf (pvtufile,
              "      "
              "<PDataArray type=\"%s\" Name=\"%s\" format=\"%s\"/>\n",
-             T8_VTK_FLOAT_NAME, data[idata].description, T8_VTK_FORMAT_STRING);
+             T8_VTK_FLOAT_NAME, data[idata].description, format);
   }
 
   /* Write vector data fields */
@@ -238,7 +246,7 @@ t8_write_pvtu (const char *filename, int num_procs, int write_tree, int write_ra
              "      "
              "<PDataArray type=\"%s\" Name=\"%s\" NumberOfComponents=\"3\" "
              "format=\"%s\"/>\n",
-             T8_VTK_FLOAT_NAME, data[idata].description, T8_VTK_FORMAT_STRING);
+             T8_VTK_FLOAT_NAME, data[idata].description, format);
   }
   if (wrote_cell_data) {
     fprintf (pvtufile, "    </PCellData>\n");
@@ -81,6 +81,13 @@ int
 t8_write_pvtu (const char *filename, int num_procs, int write_tree, int write_rank, int write_level, int write_id,
                int num_data, t8_vtk_data_field_t *data);
 
+/* Like \ref t8_write_pvtu, but with the format of the data arrays in the
+ * processor local files, for example "ascii", "binary" or "appended".
+ * Return 0 on success. */
+int
+t8_write_pvtu_ext (const char *filename, int num_procs, int write_tree, int write_rank, int write_level, int write_id,
+                   int num_data, t8_vtk_data_field_t *data, const char *format);
+
 T8_EXTERN_C_END ();
 
 #endif /* !T8_VTK_H */
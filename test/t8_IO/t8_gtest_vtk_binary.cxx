@@ -0,0 +1,241 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we write a hybrid forest with t8_forest_vtk_write_file_binary, with and
+ * without compression, and read the files back. We check that the pvtu file declares
+ * the appended format and that the arrays of each vtu file match the elements of the forest.
+ * If t8code is linked against VTK, we additionally read the vtu files with the VTK reader. */
+
+#include <gtest/gtest.h>
+#include <t8.h>
+#ifdef SC_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#include <t8_cmesh.h>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_cmesh_vtk_reader.hxx>
+#include <t8_element_shape.h>
+#include <t8_forest/t8_forest_general.h>
+#include <t8_forest/t8_forest_geometrical.h>
+#include <t8_forest/t8_forest_vtk.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <t8_vtk.h>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#define T8_TEST_VTK_BINARY_PREFIX "test_vtk_binary"
+
+/* Read the file with the given name into a string. */
+static std::string
+t8_test_vtk_binary_read_file (const char *filename)
+{
+  std::ifstream input (filename, std::ios::binary);
+  EXPECT_TRUE (input.good ()) << "Could not open file " << filename;
+  return std::string ((std::istreambuf_iterator<char> (input)), std::istreambuf_iterator<char> ());
+}
+
+/* Read an array of a vtu file written by t8_forest_vtk_write_file_binary.
+ * Each array is stored in the appended section behind a header of 64 bit integers.
+ * For uncompressed files this is the number of bytes of the array. For compressed files
+ * these are the number of blocks, the block size, the size of the last block and the
+ * compressed size of each block, followed by the compressed blocks. */
+template <typename T>
+static std::vector<T>
+t8_test_vtk_binary_array (const std::string &file, const char *name, const int compress)
+{
+  const size_t name_pos = file.find (std::string ("Name=\"") + name + "\"");
+  const size_t data_pos = file.find ("<AppendedData encoding=\"raw\">");
+  if (name_pos == std::string::npos || data_pos == std::string::npos) {
+    ADD_FAILURE () << "Array " << name << " not found in vtu file.";
+    return std::vector<T> ();
+  }
+  const size_t offset_pos = file.find ("offset=\"", name_pos) + strlen ("offset=\"");
+  const char *array_begin = file.data () + file.find ('_', data_pos) + 1 + std::stoull (file.substr (offset_pos, 20));
+  std::vector<char> bytes;
+  if (!compress) {
+    uint64_t num_bytes;
+    memcpy (&num_bytes, array_begin, sizeof (uint64_t));
+    bytes.assign (array_begin + sizeof (uint64_t), array_begin + sizeof (uint64_t) + num_bytes);
+  }
+  else {
+#ifdef SC_HAVE_ZLIB
+    uint64_t header[3];
+    memcpy (header, array_begin, sizeof (header));
+    const uint64_t num_blocks = header[0];
+    std::vector<uint64_t> compressed_sizes (num_blocks);
+    memcpy (compressed_sizes.data (), array_begin + sizeof (header), num_blocks * sizeof (uint64_t));
+    const char *block = array_begin + sizeof (header) + num_blocks * sizeof (uint64_t);
+    for (uint64_t iblock = 0; iblock < num_blocks; iblock++) {
+      uLongf block_size = iblock + 1 < num_blocks ? header[1] : header[2];
+      const size_t position = bytes.size ();
+      bytes.resize (position + block_size);
+      EXPECT_EQ (Z_OK, uncompress ((Bytef *) bytes.data () + position, &block_size, (const Bytef *) block,
+                                   compressed_sizes[iblock]));
+      block += compressed_sizes[iblock];
+    }
+#else
+    ADD_FAILURE () << "Cannot read compressed arrays without zlib.";
+#endif
+  }
+  std::vector<T> values (bytes.size () / sizeof (T));
+  memcpy (values.data (), bytes.data (), values.size () * sizeof (T));
+  return values;
+}
+
+class forest_vtk_binary: public testing::TestWithParam<int> {
+ protected:
+  void
+  SetUp () override
+  {
+    compress = GetParam ();
+#ifndef SC_HAVE_ZLIB
+    if (compress) {
+      GTEST_SKIP ();
+    }
+#endif
+    int mpiret = sc_MPI_Comm_rank (sc_MPI_COMM_WORLD, &mpirank);
+    SC_CHECK_MPI (mpiret);
+    mpiret = sc_MPI_Comm_size (sc_MPI_COMM_WORLD, &mpisize);
+    SC_CHECK_MPI (mpiret);
+    t8_cmesh_t cmesh = t8_cmesh_new_hypercube_hybrid (sc_MPI_COMM_WORLD, 0, 0);
+    forest = t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), 1, 0, sc_MPI_COMM_WORLD);
+  }
+
+  void
+  TearDown () override
+  {
+    if (forest != NULL) {
+      t8_forest_unref (&forest);
+    }
+  }
+
+  t8_forest_t forest = NULL;
+  int compress;
+  int mpirank;
+  int mpisize;
+};
+
+TEST_P (forest_vtk_binary, write_and_read)
+{
+  const t8_locidx_t num_elements = t8_forest_get_local_num_elements (forest);
+  const t8_gloidx_t first_element = t8_forest_get_first_local_element_id (forest);
+  char filename[BUFSIZ];
+
+  /* One scalar data field with the local element index */
+  std::vector<double> element_index (num_elements);
+  for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+    element_index[ielement] = ielement;
+  }
+  t8_vtk_data_field_t data;
+  data.type = T8_VTK_SCALAR;
+  snprintf (data.description, BUFSIZ, "element_index");
+  data.data = element_index.data ();
+  ASSERT_TRUE (
+    t8_forest_vtk_write_file_binary (forest, T8_TEST_VTK_BINARY_PREFIX, 1, 1, 1, 1, 0, compress, 0, 1, &data));
+
+  if (mpirank == 0) {
+    /* The pvtu file declares the format of the vtu files and lists one piece per process. */
+    const std::string pvtu = t8_test_vtk_binary_read_file (T8_TEST_VTK_BINARY_PREFIX ".pvtu");
+    EXPECT_NE (pvtu.find ("format=\"appended\""), std::string::npos);
+    EXPECT_EQ (pvtu.find ("format=\"ascii\""), std::string::npos);
+    for (int irank = 0; irank < mpisize; irank++) {
+      snprintf (filename, BUFSIZ, "<Piece Source=\"%s_%04d.vtu\"/>", T8_TEST_VTK_BINARY_PREFIX, irank);
+      EXPECT_NE (pvtu.find (filename), std::string::npos);
+    }
+  }
+
+  snprintf (filename, BUFSIZ, "%s_%04d.vtu", T8_TEST_VTK_BINARY_PREFIX, mpirank);
+  const std::string file = t8_test_vtk_binary_read_file (filename);
+  EXPECT_EQ (compress != 0, file.find ("compressor=\"vtkZLibDataCompressor\"") != std::string::npos);
+  const size_t num_cells_pos = file.find ("NumberOfCells=\"");
+  ASSERT_NE (num_cells_pos, std::string::npos);
+  EXPECT_EQ ((size_t) num_elements, std::stoull (file.substr (num_cells_pos + strlen ("NumberOfCells=\""), 20)));
+
+  const std::vector<T8_VTK_FLOAT_TYPE> positions
+    = t8_test_vtk_binary_array<T8_VTK_FLOAT_TYPE> (file, "Position", compress);
+  const std::vector<int32_t> connectivity = t8_test_vtk_binary_array<int32_t> (file, "connectivity", compress);
+  const std::vector<int32_t> offsets = t8_test_vtk_binary_array<int32_t> (file, "offsets", compress);
+  const std::vector<uint8_t> types = t8_test_vtk_binary_array<uint8_t> (file, "types", compress);
+  const std::vector<int32_t> treeids = t8_test_vtk_binary_array<int32_t> (file, "treeid", compress);
+  const std::vector<int32_t> mpiranks = t8_test_vtk_binary_array<int32_t> (file, "mpirank", compress);
+  const std::vector<int32_t> levels = t8_test_vtk_binary_array<int32_t> (file, "level", compress);
+  const std::vector<int32_t> element_ids = t8_test_vtk_binary_array<int32_t> (file, "element_id", compress);
+  const std::vector<T8_VTK_FLOAT_TYPE> cell_data
+    = t8_test_vtk_binary_array<T8_VTK_FLOAT_TYPE> (file, "element_index", compress);
+  ASSERT_EQ ((size_t) num_elements, offsets.size ());
+  ASSERT_EQ ((size_t) num_elements, types.size ());
+  ASSERT_EQ ((size_t) num_elements, treeids.size ());
+  ASSERT_EQ ((size_t) num_elements, mpiranks.size ());
+  ASSERT_EQ ((size_t) num_elements, levels.size ());
+  ASSERT_EQ ((size_t) num_elements, element_ids.size ());
+  ASSERT_EQ ((size_t) num_elements, cell_data.size ());
+
+  /* Compare the cells with the elements of the forest */
+  t8_locidx_t ielement = 0;
+  for (t8_locidx_t itree = 0; itree < t8_forest_get_num_local_trees (forest); itree++) {
+    const t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, t8_forest_get_tree_class (forest, itree));
+    for (t8_locidx_t ielem_in_tree = 0; ielem_in_tree < t8_forest_get_tree_num_elements (forest, itree);
+         ielem_in_tree++, ielement++) {
+      const t8_element_t *element = t8_forest_get_element_in_tree (forest, itree, ielem_in_tree);
+      const t8_element_shape_t shape = ts->t8_element_shape (element);
+      const int32_t first_corner = ielement > 0 ? offsets[ielement - 1] : 0;
+      ASSERT_EQ (first_corner + t8_eclass_num_vertices[shape], offsets[ielement]);
+      EXPECT_EQ (t8_eclass_vtk_type[shape], types[ielement]);
+      EXPECT_EQ (t8_forest_global_tree_id (forest, itree), treeids[ielement]);
+      EXPECT_EQ (mpirank, mpiranks[ielement]);
+      EXPECT_EQ (ts->t8_element_level (element), levels[ielement]);
+      EXPECT_EQ (first_element + ielement, element_ids[ielement]);
+      EXPECT_EQ (ielement, cell_data[ielement]);
+      for (int ivertex = 0; ivertex < t8_eclass_num_vertices[shape]; ivertex++) {
+        const int32_t ipoint = connectivity[first_corner + ivertex];
+        ASSERT_TRUE (0 <= ipoint && (size_t) 3 * ipoint + 2 < positions.size ());
+        double coords[3];
+        t8_forest_element_coordinate (forest, itree, element, t8_element_shape_vtk_corner_number (shape, ivertex),
+                                      coords);
+        for (int idim = 0; idim < 3; idim++) {
+          EXPECT_NEAR (coords[idim], positions[3 * ipoint + idim], 1e-6);
+        }
+      }
+    }
+  }
+
+#if T8_WITH_VTK
+  /* The VTK reader creates one tree per cell of the file. */
+  t8_cmesh_t cmesh = t8_cmesh_vtk_reader (filename, 0, 0, sc_MPI_COMM_SELF, VTK_UNSTRUCTURED_FILE);
+  ASSERT_TRUE (cmesh != NULL);
+  EXPECT_EQ (num_elements, t8_cmesh_get_num_local_trees (cmesh));
+  t8_cmesh_destroy (&cmesh);
+#endif
+
+  /* Remove the files once all processes are done reading them. */
+  remove (filename);
+  int mpiret = sc_MPI_Barrier (sc_MPI_COMM_WORLD);
+  SC_CHECK_MPI (mpiret);
+  if (mpirank == 0) {
+    remove (T8_TEST_VTK_BINARY_PREFIX ".pvtu");
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_vtk_binary, forest_vtk_binary, testing::Values (0, 1));
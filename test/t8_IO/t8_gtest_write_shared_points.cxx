@@ -0,0 +1,304 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we write an adapted forest of quadrilaterals, in which corners are shared
+ * by several elements, to binary vtu files and to a netCDF file and read the files back.
+ * We check that each shared corner is written as one point and that the connectivity
+ * of each element refers to the points at its corners. */
+
+#include <gtest/gtest.h>
+#include <t8.h>
+#if T8_WITH_NETCDF
+#include <netcdf.h>
+#endif
+#include <t8_cmesh.h>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_element_shape.h>
+#include <t8_forest/t8_forest_general.h>
+#include <t8_forest/t8_forest_geometrical.h>
+#include <t8_forest/t8_forest_io.h>
+#include <t8_forest/t8_forest_vtk.h>
+#include <t8_forest_netcdf.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <t8_vtk.h>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
+
+/* The number of distinct corners of the unit square, refined uniformly to level 1
+ * and then once more in the corner at the origin. */
+#define T8_TEST_SHARED_POINTS_NUM_VERTICES 14
+
+/* A point with coordinates rounded to a grid, such that points can be compared exactly. */
+typedef std::array<long long, 3> t8_test_point_t;
+
+static t8_test_point_t
+t8_test_shared_points_round (const double x, const double y, const double z)
+{
+  return { std::llround (x * 1e5), std::llround (y * 1e5), std::llround (z * 1e5) };
+}
+
+/* Refine the first leaf of a uniform level 1 forest. */
+static int
+t8_test_shared_points_adapt (t8_forest_t forest, t8_forest_t forest_from, t8_locidx_t which_tree,
+                             t8_locidx_t lelement_id, t8_eclass_scheme_c *ts, const int is_family,
+                             const int num_elements, t8_element_t *elements[])
+{
+  return ts->t8_element_level (elements[0]) == 1 && ts->t8_element_child_id (elements[0]) == 0;
+}
+
+/* Read an array of an uncompressed vtu file written by t8_forest_vtk_write_file_binary.
+ * Each array is stored in the appended section behind a 64 bit header with its size in bytes. */
+template <typename T>
+static std::vector<T>
+t8_test_shared_points_vtu_array (const std::string &file, const char *name)
+{
+  const size_t name_pos = file.find (std::string ("Name=\"") + name + "\"");
+  const size_t data_pos = file.find ("<AppendedData encoding=\"raw\">");
+  if (name_pos == std::string::npos || data_pos == std::string::npos) {
+    ADD_FAILURE () << "Array " << name << " not found in vtu file.";
+    return std::vector<T> ();
+  }
+  const size_t offset_pos = file.find ("offset=\"", name_pos) + strlen ("offset=\"");
+  const size_t array_begin = file.find ('_', data_pos) + 1 + std::stoull (file.substr (offset_pos, 20));
+  uint64_t num_bytes;
+  memcpy (&num_bytes, file.data () + array_begin, sizeof (uint64_t));
+  std::vector<T> values (num_bytes / sizeof (T));
+  memcpy (values.data (), file.data () + array_begin + sizeof (uint64_t), num_bytes);
+  return values;
+}
+
+class forest_write_shared_points: public testing::Test {
+ protected:
+  void
+  SetUp () override
+  {
+    int mpiret = sc_MPI_Comm_rank (sc_MPI_COMM_WORLD, &mpirank);
+    SC_CHECK_MPI (mpiret);
+    mpiret = sc_MPI_Comm_size (sc_MPI_COMM_WORLD, &mpisize);
+    SC_CHECK_MPI (mpiret);
+    t8_cmesh_t cmesh = t8_cmesh_new_hypercube (T8_ECLASS_QUAD, sc_MPI_COMM_WORLD, 0, 0, 0);
+    forest = t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), 1, 0, sc_MPI_COMM_WORLD);
+    forest = t8_forest_new_adapt (forest, t8_test_shared_points_adapt, 0, 0, NULL);
+  }
+
+  void
+  TearDown () override
+  {
+    t8_forest_unref (&forest);
+  }
+
+  /* The rounded corners of the local element with local index ielement. */
+  std::multiset<t8_test_point_t>
+  element_corners (t8_locidx_t ielement)
+  {
+    t8_locidx_t itree = t8_forest_get_num_local_trees (forest) - 1;
+    while (t8_forest_get_tree_element_offset (forest, itree) > ielement) {
+      itree--;
+    }
+    const t8_element_t *element
+      = t8_forest_get_element_in_tree (forest, itree, ielement - t8_forest_get_tree_element_offset (forest, itree));
+    const t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, t8_forest_get_tree_class (forest, itree));
+    std::multiset<t8_test_point_t> corners;
+    for (int icorner = 0; icorner < ts->t8_element_num_corners (element); icorner++) {
+      double coords[3];
+      t8_forest_element_coordinate (forest, itree, element, icorner, coords);
+      corners.insert (t8_test_shared_points_round (coords[0], coords[1], coords[2]));
+    }
+    return corners;
+  }
+
+  t8_forest_t forest;
+  int mpirank;
+  int mpisize;
+};
+
+/* Write the forest with and without deduplicated points and read back the vtu file of this process.
+ * We use the inbuilt writer, since the VTK API writes each corner as a separate point. */
+TEST_F (forest_write_shared_points, vtu)
+{
+  const t8_locidx_t num_elements = t8_forest_get_local_num_elements (forest);
+  char filename[BUFSIZ];
+
+  for (int deduplicate_points = 0; deduplicate_points <= 1; deduplicate_points++) {
+    ASSERT_TRUE (
+      t8_forest_write_vtk_ext (forest, "test_shared_points", 0, 0, 0, 0, 0, 0, 1, deduplicate_points, 0, NULL));
+    snprintf (filename, BUFSIZ, "test_shared_points_%04d.vtu", mpirank);
+    std::ifstream input (filename, std::ios::binary);
+    ASSERT_TRUE (input.good ()) << "Could not open file " << filename;
+    const std::string file ((std::istreambuf_iterator<char> (input)), std::istreambuf_iterator<char> ());
+    const size_t num_points_pos = file.find ("NumberOfPoints=\"");
+    ASSERT_NE (num_points_pos, std::string::npos);
+    const size_t num_points = std::stoull (file.substr (num_points_pos + strlen ("NumberOfPoints=\""), 20));
+    const std::vector<T8_VTK_FLOAT_TYPE> positions
+      = t8_test_shared_points_vtu_array<T8_VTK_FLOAT_TYPE> (file, "Position");
+    const std::vector<int32_t> connectivity = t8_test_shared_points_vtu_array<int32_t> (file, "connectivity");
+    const std::vector<int32_t> offsets = t8_test_shared_points_vtu_array<int32_t> (file, "offsets");
+    ASSERT_EQ (3 * num_points, positions.size ());
+    ASSERT_EQ ((size_t) 4 * num_elements, connectivity.size ());
+    ASSERT_EQ ((size_t) num_elements, offsets.size ());
+
+    std::set<t8_test_point_t> points;
+    for (size_t ipoint = 0; ipoint < num_points; ipoint++) {
+      points.insert (
+        t8_test_shared_points_round (positions[3 * ipoint], positions[3 * ipoint + 1], positions[3 * ipoint + 2]));
+    }
+    if (deduplicate_points) {
+      /* Each point lies at a different position */
+      EXPECT_EQ (num_points, points.size ());
+    }
+    else {
+      /* Each corner of each element is a separate point */
+      EXPECT_EQ ((size_t) 4 * num_elements, num_points);
+    }
+
+    /* The cells refer to the points at the corners of their elements */
+    for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+      std::multiset<t8_test_point_t> cell_points;
+      for (int32_t icorner = ielement > 0 ? offsets[ielement - 1] : 0; icorner < offsets[ielement]; icorner++) {
+        const int32_t ipoint = connectivity[icorner];
+        ASSERT_TRUE (0 <= ipoint && (size_t) ipoint < num_points);
+        cell_points.insert (
+          t8_test_shared_points_round (positions[3 * ipoint], positions[3 * ipoint + 1], positions[3 * ipoint + 2]));
+      }
+      EXPECT_EQ (element_corners (ielement), cell_points);
+    }
+
+    if (deduplicate_points) {
+      /* The points of all processes are the vertices of the forest */
+      const int num_local_coords = 3 * points.size ();
+      std::vector<long long> local_coords, global_coords;
+      for (const t8_test_point_t &point : points) {
+        local_coords.insert (local_coords.end (), point.begin (), point.end ());
+      }
+      std::vector<int> num_coords (mpisize), coords_offsets (mpisize + 1, 0);
+      int mpiret = sc_MPI_Allgather ((void *) &num_local_coords, 1, sc_MPI_INT, num_coords.data (), 1, sc_MPI_INT,
+                                     sc_MPI_COMM_WORLD);
+      SC_CHECK_MPI (mpiret);
+      for (int irank = 0; irank < mpisize; irank++) {
+        coords_offsets[irank + 1] = coords_offsets[irank] + num_coords[irank];
+      }
+      global_coords.resize (coords_offsets[mpisize]);
+      mpiret = sc_MPI_Allgatherv (local_coords.data (), num_local_coords, sc_MPI_LONG_LONG_INT, global_coords.data (),
+                                  num_coords.data (), coords_offsets.data (), sc_MPI_LONG_LONG_INT, sc_MPI_COMM_WORLD);
+      SC_CHECK_MPI (mpiret);
+      std::set<t8_test_point_t> global_points;
+      for (size_t icoord = 0; icoord < global_coords.size (); icoord += 3) {
+        const t8_test_point_t point = { global_coords[icoord], global_coords[icoord + 1], global_coords[icoord + 2] };
+        global_points.insert (point);
+      }
+      EXPECT_EQ ((size_t) T8_TEST_SHARED_POINTS_NUM_VERTICES, global_points.size ());
+    }
+  }
+}
+
+/* Write the forest to a netCDF file and read back the nodes and the nodes of the elements.
+ * Without parallel netCDF each process writes its own file with its local nodes. */
+TEST_F (forest_write_shared_points, netcdf)
+{
+#if T8_WITH_NETCDF
+#if T8_WITH_NETCDF_PAR
+  const bool local_file = false;
+#else
+  const bool local_file = mpisize > 1;
+#endif
+  const t8_locidx_t num_elements = t8_forest_get_local_num_elements (forest);
+  const t8_gloidx_t global_num_elements = t8_forest_get_global_num_elements (forest);
+  const t8_gloidx_t first_element = t8_forest_get_first_local_element_id (forest);
+  const size_t max_nodes = t8_element_shape_max_num_corner[2];
+  int ncid, dimid, varid;
+  size_t num_nodes;
+  char filename[BUFSIZ];
+
+  t8_forest_write_netcdf (forest, "test_shared_points", "Shared points", 2, 0, NULL, sc_MPI_COMM_WORLD);
+  const int mpiret = sc_MPI_Barrier (sc_MPI_COMM_WORLD);
+  SC_CHECK_MPI (mpiret);
+
+  if (local_file) {
+    snprintf (filename, BUFSIZ, "test_shared_points_rank_%d.nc", mpirank);
+  }
+  else {
+    snprintf (filename, BUFSIZ, "test_shared_points.nc");
+  }
+  ASSERT_EQ (NC_NOERR, nc_open (filename, NC_NOWRITE, &ncid));
+  ASSERT_EQ (NC_NOERR, nc_inq_dimid (ncid, "nMesh2_node", &dimid));
+  ASSERT_EQ (NC_NOERR, nc_inq_dimlen (ncid, dimid, &num_nodes));
+  if (local_file) {
+    /* The file contains the distinct corners of the local elements */
+    std::set<t8_test_point_t> local_corners;
+    for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+      const std::multiset<t8_test_point_t> corners = element_corners (ielement);
+      local_corners.insert (corners.begin (), corners.end ());
+    }
+    EXPECT_EQ (local_corners.size (), num_nodes);
+  }
+  else {
+    EXPECT_EQ ((size_t) T8_TEST_SHARED_POINTS_NUM_VERTICES, num_nodes);
+  }
+  std::vector<double> node_x (num_nodes), node_y (num_nodes), node_z (num_nodes);
+  ASSERT_EQ (NC_NOERR, nc_inq_varid (ncid, "Mesh2_node_x", &varid));
+  ASSERT_EQ (NC_NOERR, nc_get_var_double (ncid, varid, node_x.data ()));
+  ASSERT_EQ (NC_NOERR, nc_inq_varid (ncid, "Mesh2_node_y", &varid));
+  ASSERT_EQ (NC_NOERR, nc_get_var_double (ncid, varid, node_y.data ()));
+  ASSERT_EQ (NC_NOERR, nc_inq_varid (ncid, "Mesh2_node_z", &varid));
+  ASSERT_EQ (NC_NOERR, nc_get_var_double (ncid, varid, node_z.data ()));
+  std::vector<long long> elem_nodes (global_num_elements * max_nodes);
+  ASSERT_EQ (NC_NOERR, nc_inq_varid (ncid, "Mesh2_face_nodes", &varid));
+  ASSERT_EQ (NC_NOERR, nc_get_var_longlong (ncid, varid, elem_nodes.data ()));
+  ASSERT_EQ (NC_NOERR, nc_close (ncid));
+
+  /* Each node lies at a different position */
+  std::set<t8_test_point_t> nodes;
+  for (size_t inode = 0; inode < num_nodes; inode++) {
+    nodes.insert (t8_test_shared_points_round (node_x[inode], node_y[inode], node_z[inode]));
+  }
+  EXPECT_EQ (num_nodes, nodes.size ());
+
+  /* Each node is a corner of an element. A local file only contains the local elements. */
+  std::set<long long> used_nodes;
+  const size_t first_written = local_file ? first_element * max_nodes : 0;
+  const size_t end_written = local_file ? (first_element + num_elements) * max_nodes : elem_nodes.size ();
+  for (size_t icorner = first_written; icorner < end_written; icorner++) {
+    const long long inode = elem_nodes[icorner];
+    ASSERT_TRUE (0 <= inode && (size_t) inode < num_nodes);
+    used_nodes.insert (inode);
+  }
+  EXPECT_EQ (num_nodes, used_nodes.size ());
+
+  /* The local elements refer to the nodes at their corners */
+  for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+    std::multiset<t8_test_point_t> element_nodes;
+    for (size_t icorner = 0; icorner < max_nodes; icorner++) {
+      const long long inode = elem_nodes[(first_element + ielement) * max_nodes + icorner];
+      element_nodes.insert (t8_test_shared_points_round (node_x[inode], node_y[inode], node_z[inode]));
+    }
+    EXPECT_EQ (element_corners (ielement), element_nodes);
+  }
+#else
+  t8_debugf ("This version of t8code is not compiled with netcdf support.\n");
+#endif
+}
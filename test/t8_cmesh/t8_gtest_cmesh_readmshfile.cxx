@@ -29,10 +29,10 @@
 #include "t8_cmesh/t8_cmesh_trees.h"
 
 /* In this file we test the msh file (gmsh) reader of the cmesh.
- * Currently, we support version 2 and 4 ascii.
+ * Currently, we support version 2 and 4 ascii and version 4.1 binary.
  * We read a mesh file and check whether the constructed cmesh is correct.
- * We also try to read version 2 binary and version 4 binary
- * formats. All are not supported and we expect the reader to catch this.
+ * We also try to read the version 2 binary format, which is not supported
+ * and we expect the reader to catch this.
  */
 
 static void
@@ -65,9 +65,10 @@ t8_supported_msh_file (t8_cmesh_t cmesh)
 
   /* Number of local trees. */
   lnum_trees = t8_cmesh_get_num_local_trees (cmesh);
+  const t8_gloidx_t first_tree = t8_cmesh_get_first_treeid (cmesh);
   /* Iterate through the local elements and check if they were read properly. */
-  /* All trees should be local to the master rank. */
   for (t8_locidx_t ltree_it = 0; ltree_it < lnum_trees; ltree_it++) {
+    const t8_gloidx_t gtree_id = first_tree + ltree_it;
     tree_class = t8_cmesh_get_tree_class (cmesh, ltree_it);
     ASSERT_FALSE (t8_eclass_compare (tree_class, elem_type)) << "Element type in msh-file was read incorrectly.";
 
@@ -76,12 +77,14 @@ t8_supported_msh_file (t8_cmesh_t cmesh)
     /* Checking the msh-files elements and nodes. */
     for (int i = 0; i < 3; i++) {
       /* Checks if x and y coordinate of the nodes are not read correctly. */
-      ASSERT_EQ (vertex[elements[ltree_it][i]][0], (int) vertices[3 * i]) << "x coordinate was read incorrectly";
-      ASSERT_EQ (vertex[elements[ltree_it][i]][1], (int) vertices[(3 * i) + 1]) << "y coordinate was read incorrectly";
+      ASSERT_EQ (vertex[elements[gtree_id][i]][0], (int) vertices[3 * i]) << "x coordinate was read incorrectly";
+      ASSERT_EQ (vertex[elements[gtree_id][i]][1], (int) vertices[(3 * i) + 1]) << "y coordinate was read incorrectly";
 
-      /* Checks whether the face neighbor elements are not read correctly. */
+      /* Checks whether the face neighbor elements are not read correctly.
+       * The neighbor may be a ghost if the cmesh is partitioned, thus we compare global ids. */
       ltree_id = t8_cmesh_get_face_neighbor (cmesh, ltree_it, i, NULL, NULL);
-      ASSERT_EQ (ltree_id, face_neigh_elem[ltree_it][i])
+      const t8_gloidx_t neighbor_id = ltree_id < 0 ? -1 : t8_cmesh_get_global_id (cmesh, ltree_id);
+      ASSERT_EQ (neighbor_id, face_neigh_elem[gtree_id][i])
         << "The face neighbor element in the example test file was not read correctly.";
     }
   }
@@ -154,8 +157,15 @@ TEST (t8_cmesh_readmshfile, test_msh_file_vers4_bin)
   t8_debugf ("Checking msh file version 4 binary...\n");
 
   ASSERT_FALSE (access (filename, R_OK)) << "Could not open file " << filename;
-  t8_cmesh_t cmesh = t8_cmesh_from_msh_file (fileprefix, 1, sc_MPI_COMM_WORLD, 2, 0, 0);
-  ASSERT_TRUE (cmesh == NULL) << "Expected fail of reading binary msh file v.4, but did not fail.";
+  /* Binary files are read by all processes in parallel if the cmesh is partitioned
+   * and by each process on its own otherwise. We check both. */
+  for (int partition = 0; partition < 2; ++partition) {
+    t8_cmesh_t cmesh = t8_cmesh_from_msh_file (fileprefix, partition, sc_MPI_COMM_WORLD, 2, 0, 0);
+    ASSERT_TRUE (cmesh != NULL) << "Could not read cmesh from binary version 4, but should be able to.";
 
-  t8_debugf ("Error handling successful.\n");
+    t8_supported_msh_file (cmesh);
+
+    /* The cmesh was read successfully and we need to destroy it. */
+    t8_cmesh_destroy (&cmesh);
+  }
 }
@@ -0,0 +1,249 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+#include <gtest/gtest.h>
+#include <t8_cmesh.hxx>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_cmesh/t8_cmesh_types.h>
+#include <t8_cmesh/t8_cmesh_reorder.h>
+#include <t8_geometry/t8_geometry_implementations/t8_geometry_linear.hxx>
+
+/* Reorder a row of cubes along a space-filling curve and check that
+ * the vertices, attributes and face connections move with the trees. */
+
+class cmesh_reorder_sfc: public testing::TestWithParam<std::tuple<int, int, t8_cmesh_sfc_type_t>> {
+ protected:
+  void
+  SetUp () override
+  {
+    num_trees = std::get<0> (GetParam ());
+    partitioned = std::get<1> (GetParam ());
+    sfc_type = std::get<2> (GetParam ());
+    /* Each tree stores its global id as an attribute. */
+    cmesh = t8_cmesh_new_row_of_cubes (num_trees, 1, partitioned, sc_MPI_COMM_WORLD);
+    cmesh_reordered = t8_cmesh_new_reorder_sfc (cmesh, sfc_type, sc_MPI_COMM_WORLD, &stats);
+  }
+  void
+  TearDown () override
+  {
+    t8_cmesh_destroy (&cmesh);
+    t8_cmesh_destroy (&cmesh_reordered);
+  }
+
+  /* Return the global id that a tree or ghost had before the reordering. */
+  t8_locidx_t
+  original_id (const t8_locidx_t ltree_id)
+  {
+    return *(t8_locidx_t *) t8_cmesh_get_attribute (cmesh_reordered, t8_get_package_id (), T8_CMESH_NEXT_POSSIBLE_KEY,
+                                                    ltree_id);
+  }
+
+  t8_cmesh_t cmesh;
+  t8_cmesh_t cmesh_reordered;
+  t8_cmesh_reorder_stats_t stats;
+  t8_locidx_t num_trees;
+  int partitioned;
+  t8_cmesh_sfc_type_t sfc_type;
+};
+
+TEST_P (cmesh_reorder_sfc, trees_and_connections)
+{
+  /* Vertices of first cube in row as reference. */
+  const double vertices_ref[24] = {
+    0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 0, 0, 0, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1,
+  };
+
+  ASSERT_TRUE (t8_cmesh_is_committed (cmesh_reordered));
+  EXPECT_EQ (t8_cmesh_get_num_trees (cmesh_reordered), num_trees);
+  EXPECT_EQ (t8_cmesh_is_partitioned (cmesh_reordered), partitioned);
+  EXPECT_EQ (stats.num_face_connections, num_trees - 1);
+  EXPECT_EQ (stats.edge_cut_after, t8_cmesh_get_partition_edge_cut (cmesh_reordered, sc_MPI_COMM_WORLD, NULL));
+  EXPECT_LE (stats.edge_cut_after, stats.num_face_connections);
+
+  const t8_locidx_t num_local_trees = t8_cmesh_get_num_local_trees (cmesh_reordered);
+  const t8_locidx_t num_ghosts = t8_cmesh_get_num_ghosts (cmesh_reordered);
+  for (t8_locidx_t ltree_id = 0; ltree_id < num_local_trees + num_ghosts; ltree_id++) {
+    const t8_locidx_t old_id = original_id (ltree_id);
+    const double *vertices = (double *) t8_cmesh_get_attribute (cmesh_reordered, t8_get_package_id (),
+                                                                T8_CMESH_VERTICES_ATTRIBUTE_KEY, ltree_id);
+    for (int v_id = 0; v_id < 8; v_id++) {
+      EXPECT_EQ (vertices[v_id * 3], vertices_ref[v_id * 3] + old_id);
+      EXPECT_EQ (vertices[v_id * 3 + 1], vertices_ref[v_id * 3 + 1]);
+      EXPECT_EQ (vertices[v_id * 3 + 2], vertices_ref[v_id * 3 + 2]);
+    }
+    if (ltree_id >= num_local_trees) {
+      continue;
+    }
+    EXPECT_EQ (T8_ECLASS_HEX, t8_cmesh_get_tree_class (cmesh_reordered, ltree_id));
+    if (sfc_type == T8_CMESH_SFC_MORTON) {
+      /* The Morton curve is monotone along the x-axis. */
+      EXPECT_EQ (t8_cmesh_get_global_id (cmesh_reordered, ltree_id), old_id);
+    }
+    /* Face 0 is connected to the previous cube, face 1 to the next one. */
+    for (int face = 0; face < 2; face++) {
+      int dual_face, orientation;
+      const t8_locidx_t neighbor
+        = t8_cmesh_get_face_neighbor (cmesh_reordered, ltree_id, face, &dual_face, &orientation);
+      const t8_locidx_t expected_id = face == 0 ? old_id - 1 : old_id + 1;
+      if (expected_id < 0 || expected_id >= num_trees) {
+        EXPECT_LT (neighbor, 0);
+        continue;
+      }
+      ASSERT_GE (neighbor, 0);
+      EXPECT_EQ (original_id (neighbor), expected_id);
+      EXPECT_EQ (dual_face, 1 - face);
+      EXPECT_EQ (orientation, 0);
+    }
+    for (int face = 2; face < t8_eclass_num_faces[T8_ECLASS_HEX]; face++) {
+      EXPECT_TRUE (t8_cmesh_tree_face_is_boundary (cmesh_reordered, ltree_id, face));
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_cmesh_reorder_sfc, cmesh_reorder_sfc,
+                          testing::Combine (testing::Values (1, 4, 23), testing::Values (0, 1),
+                                            testing::Values (T8_CMESH_SFC_MORTON, T8_CMESH_SFC_HILBERT)));
+
+/* Build a brick of 4^dim unit quads or hexes whose tree ids are scrambled.
+ * The tree at position (i, j, k) of the brick gets the tree id (7 * position) % num_trees,
+ * where position = i + 4 * j + 16 * k. The position is stored as an attribute. */
+static t8_cmesh_t
+t8_test_new_scrambled_brick (const int dim, const int scramble, const int partitioned, sc_MPI_Comm comm)
+{
+  const int num_per_dim = 4;
+  const t8_locidx_t num_trees = dim == 2 ? num_per_dim * num_per_dim : num_per_dim * num_per_dim * num_per_dim;
+  const t8_eclass_t eclass = dim == 2 ? T8_ECLASS_QUAD : T8_ECLASS_HEX;
+  const int num_vertices = t8_eclass_num_vertices[eclass];
+  auto tree_id = [&] (const t8_locidx_t position) { return scramble ? (7 * position) % num_trees : position; };
+
+  t8_cmesh_t cmesh;
+  t8_cmesh_init (&cmesh);
+  t8_cmesh_register_geometry<t8_geometry_linear> (cmesh, dim);
+  for (t8_locidx_t position = 0; position < num_trees; position++) {
+    const int coords[3] = { position % num_per_dim, (position / num_per_dim) % num_per_dim,
+                            position / (num_per_dim * num_per_dim) };
+    double vertices[24];
+    for (int ivertex = 0; ivertex < num_vertices; ivertex++) {
+      for (int idim = 0; idim < 3; idim++) {
+        vertices[3 * ivertex + idim] = idim < dim ? coords[idim] + ((ivertex >> idim) & 1) : 0;
+      }
+    }
+    const t8_locidx_t itree = tree_id (position);
+    t8_cmesh_set_tree_class (cmesh, itree, eclass);
+    t8_cmesh_set_tree_vertices (cmesh, itree, vertices, num_vertices);
+    t8_cmesh_set_attribute (cmesh, itree, t8_get_package_id (), T8_CMESH_NEXT_POSSIBLE_KEY, &position,
+                            sizeof (t8_locidx_t), 0);
+    /* Join the tree with its neighbors in positive x, y and z direction. */
+    for (int idim = 0, stride = 1; idim < dim; idim++, stride *= num_per_dim) {
+      if (coords[idim] + 1 < num_per_dim) {
+        t8_cmesh_set_join (cmesh, itree, tree_id (position + stride), 2 * idim + 1, 2 * idim, 0);
+      }
+    }
+  }
+  if (partitioned) {
+    int mpirank, mpisize, mpiret;
+    mpiret = sc_MPI_Comm_rank (comm, &mpirank);
+    SC_CHECK_MPI (mpiret);
+    mpiret = sc_MPI_Comm_size (comm, &mpisize);
+    SC_CHECK_MPI (mpiret);
+    t8_cmesh_set_partition_range (cmesh, 3, (t8_gloidx_t) mpirank * num_trees / mpisize,
+                                  (t8_gloidx_t) (mpirank + 1) * num_trees / mpisize - 1);
+  }
+  t8_cmesh_commit (cmesh, comm);
+  return cmesh;
+}
+
+/* Reorder a brick with scrambled tree ids and the same brick with ordered tree ids.
+ * Both must result in the same order and the reordering must not increase the edge cut. */
+class cmesh_reorder_sfc_scrambled: public testing::TestWithParam<std::tuple<int, int, t8_cmesh_sfc_type_t>> {
+ protected:
+  void
+  SetUp () override
+  {
+    dim = std::get<0> (GetParam ());
+    partitioned = std::get<1> (GetParam ());
+    sfc_type = std::get<2> (GetParam ());
+    cmesh = t8_test_new_scrambled_brick (dim, 1, partitioned, sc_MPI_COMM_WORLD);
+    cmesh_ordered = t8_test_new_scrambled_brick (dim, 0, partitioned, sc_MPI_COMM_WORLD);
+    cmesh_reordered = t8_cmesh_new_reorder_sfc (cmesh, sfc_type, sc_MPI_COMM_WORLD, &stats);
+    cmesh_ordered_reordered = t8_cmesh_new_reorder_sfc (cmesh_ordered, sfc_type, sc_MPI_COMM_WORLD, NULL);
+  }
+  void
+  TearDown () override
+  {
+    t8_cmesh_destroy (&cmesh);
+    t8_cmesh_destroy (&cmesh_ordered);
+    t8_cmesh_destroy (&cmesh_reordered);
+    t8_cmesh_destroy (&cmesh_ordered_reordered);
+  }
+
+  t8_cmesh_t cmesh;
+  t8_cmesh_t cmesh_ordered;
+  t8_cmesh_t cmesh_reordered;
+  t8_cmesh_t cmesh_ordered_reordered;
+  t8_cmesh_reorder_stats_t stats;
+  int dim;
+  int partitioned;
+  t8_cmesh_sfc_type_t sfc_type;
+};
+
+TEST_P (cmesh_reorder_sfc_scrambled, order_and_edge_cut)
+{
+  const int num_per_dim = 4;
+
+  ASSERT_TRUE (t8_cmesh_is_committed (cmesh_reordered));
+  EXPECT_EQ (t8_cmesh_get_num_trees (cmesh_reordered), t8_cmesh_get_num_trees (cmesh));
+  EXPECT_EQ (stats.edge_cut_before, t8_cmesh_get_partition_edge_cut (cmesh, sc_MPI_COMM_WORLD, NULL));
+  EXPECT_EQ (stats.edge_cut_after, t8_cmesh_get_partition_edge_cut (cmesh_reordered, sc_MPI_COMM_WORLD, NULL));
+  EXPECT_LE (stats.edge_cut_after, stats.edge_cut_before);
+
+  const t8_locidx_t num_local_trees = t8_cmesh_get_num_local_trees (cmesh_reordered);
+  ASSERT_EQ (num_local_trees, t8_cmesh_get_num_local_trees (cmesh_ordered_reordered));
+  for (t8_locidx_t ltree_id = 0; ltree_id < num_local_trees; ltree_id++) {
+    const t8_locidx_t position = *(t8_locidx_t *) t8_cmesh_get_attribute (
+      cmesh_reordered, t8_get_package_id (), T8_CMESH_NEXT_POSSIBLE_KEY, ltree_id);
+    const t8_locidx_t position_ordered = *(t8_locidx_t *) t8_cmesh_get_attribute (
+      cmesh_ordered_reordered, t8_get_package_id (), T8_CMESH_NEXT_POSSIBLE_KEY, ltree_id);
+    /* The order along the curve does not depend on the input order. */
+    EXPECT_EQ (position, position_ordered);
+    /* The face connections move with the trees. */
+    for (int idim = 0, stride = 1; idim < dim; idim++, stride *= num_per_dim) {
+      for (int sign = 0; sign < 2; sign++) {
+        const int face = 2 * idim + sign;
+        const int coord = (position / stride) % num_per_dim;
+        const t8_locidx_t neighbor = t8_cmesh_get_face_neighbor (cmesh_reordered, ltree_id, face, NULL, NULL);
+        if ((sign == 0 && coord == 0) || (sign == 1 && coord == num_per_dim - 1)) {
+          EXPECT_LT (neighbor, 0);
+          continue;
+        }
+        ASSERT_GE (neighbor, 0);
+        const t8_locidx_t neighbor_position = *(t8_locidx_t *) t8_cmesh_get_attribute (
+          cmesh_reordered, t8_get_package_id (), T8_CMESH_NEXT_POSSIBLE_KEY, neighbor);
+        EXPECT_EQ (neighbor_position, sign == 0 ? position - stride : position + stride);
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_cmesh_reorder_sfc, cmesh_reorder_sfc_scrambled,
+                          testing::Combine (testing::Values (2, 3), testing::Values (0, 1),
+                                            testing::Values (T8_CMESH_SFC_MORTON, T8_CMESH_SFC_HILBERT)));
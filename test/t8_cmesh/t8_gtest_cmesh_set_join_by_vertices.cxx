@@ -39,19 +39,19 @@
  * compare the results again with the information given by `t8_cmesh_get_face_neighbor`.
  */
 
+/* Retrieve all tree vertices and element classes of the local trees and store them into arrays. */
 static void
-test_with_cmesh (t8_cmesh_t cmesh)
+get_cmesh_vertices (t8_cmesh_t cmesh, double **all_verts, t8_eclass_t **all_eclasses)
 {
   const t8_locidx_t ntrees = t8_cmesh_get_num_local_trees (cmesh);
 
   /* Arrays for the face connectivity computations via vertices. */
-  double *all_verts = T8_ALLOC (double, ntrees *T8_ECLASS_MAX_CORNERS *T8_ECLASS_MAX_DIM);
-  t8_eclass_t *all_eclasses = T8_ALLOC (t8_eclass_t, ntrees);
+  *all_verts = T8_ALLOC_ZERO (double, ntrees *T8_ECLASS_MAX_CORNERS *T8_ECLASS_MAX_DIM);
+  *all_eclasses = T8_ALLOC (t8_eclass_t, ntrees);
 
-  /* Retrieve all tree vertices and element classes and store them into arrays. */
   for (t8_locidx_t itree = 0; itree < ntrees; itree++) {
     const t8_eclass_t eclass = t8_cmesh_get_tree_class (cmesh, itree);
-    all_eclasses[itree] = eclass;
+    (*all_eclasses)[itree] = eclass;
 
     const double *vertices = t8_cmesh_get_tree_vertices (cmesh, itree);
 
@@ -59,11 +59,21 @@ test_with_cmesh (t8_cmesh_t cmesh)
 
     for (int ivert = 0; ivert < nverts; ivert++) {
       for (int icoord = 0; icoord < T8_ECLASS_MAX_DIM; icoord++) {
-        all_verts[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_CORNERS, T8_ECLASS_MAX_DIM, itree, ivert, icoord)]
+        (*all_verts)[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_CORNERS, T8_ECLASS_MAX_DIM, itree, ivert, icoord)]
           = vertices[T8_2D_TO_1D (nverts, T8_ECLASS_MAX_DIM, ivert, icoord)];
       }
     }
   }
+}
+
+static void
+test_with_cmesh (t8_cmesh_t cmesh)
+{
+  const t8_locidx_t ntrees = t8_cmesh_get_num_local_trees (cmesh);
+  double *all_verts;
+  t8_eclass_t *all_eclasses;
+
+  get_cmesh_vertices (cmesh, &all_verts, &all_eclasses);
 
   /* Compute face connectivity. */
   int *conn = NULL;
@@ -365,6 +375,132 @@ TEST (t8_cmesh_set_join_by_vertices, test_cmesh_set_join_by_vertices)
   }
 }
 
+/* Distribute the trees of a replicated cmesh evenly to the processes and check that
+ * `t8_cmesh_set_join_by_vertices_parallel` finds the same connections as the serial version. */
+static void
+test_parallel_with_cmesh (t8_cmesh_t cmesh, sc_MPI_Comm comm)
+{
+  int mpirank, mpisize, mpiret;
+  mpiret = sc_MPI_Comm_rank (comm, &mpirank);
+  SC_CHECK_MPI (mpiret);
+  mpiret = sc_MPI_Comm_size (comm, &mpisize);
+  SC_CHECK_MPI (mpiret);
+
+  ASSERT_FALSE (t8_cmesh_is_partitioned (cmesh));
+  const t8_locidx_t ntrees = t8_cmesh_get_num_local_trees (cmesh);
+  double *all_verts;
+  t8_eclass_t *all_eclasses;
+  get_cmesh_vertices (cmesh, &all_verts, &all_eclasses);
+
+  int *conn = NULL;
+  t8_cmesh_set_join_by_vertices (NULL, ntrees, all_eclasses, all_verts, &conn, 1);
+
+  const t8_gloidx_t first_tree = (t8_gloidx_t) ntrees * mpirank / mpisize;
+  const t8_locidx_t num_local_trees = (t8_gloidx_t) ntrees * (mpirank + 1) / mpisize - first_tree;
+  for (const int num_threads : { 1, 3 }) {
+    t8_gloidx_t *parallel_conn = NULL;
+    t8_cmesh_set_join_by_vertices_parallel (
+      NULL, first_tree, num_local_trees, all_eclasses + first_tree,
+      all_verts + T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_CORNERS, T8_ECLASS_MAX_DIM, first_tree, 0, 0), &parallel_conn,
+      num_threads, comm);
+    for (t8_locidx_t itree = 0; itree < num_local_trees; itree++) {
+      for (int iface = 0; iface < t8_eclass_num_faces[all_eclasses[first_tree + itree]]; iface++) {
+        for (int ientry = 0; ientry < 3; ientry++) {
+          EXPECT_EQ (parallel_conn[T8_3D_TO_1D (num_local_trees, T8_ECLASS_MAX_FACES, 3, itree, iface, ientry)],
+                     conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, first_tree + itree, iface, ientry)])
+            << "Connections differ at tree " << first_tree + itree << " face " << iface;
+        }
+      }
+    }
+    T8_FREE (parallel_conn);
+  }
+
+  T8_FREE (conn);
+  T8_FREE (all_verts);
+  T8_FREE (all_eclasses);
+}
+
+TEST (t8_cmesh_set_join_by_vertices, test_cmesh_set_join_by_vertices_parallel)
+{
+  sc_MPI_Comm comm = sc_MPI_COMM_WORLD;
+
+  {
+    t8_cmesh_t cmesh = t8_cmesh_new_hybrid_gate_deformed (comm);
+    test_parallel_with_cmesh (cmesh, comm);
+    t8_cmesh_destroy (&cmesh);
+  }
+
+  {
+    const int num_of_prisms = 28;
+    t8_cmesh_t cmesh = t8_cmesh_new_prism_cake (comm, num_of_prisms);
+    test_parallel_with_cmesh (cmesh, comm);
+    t8_cmesh_destroy (&cmesh);
+  }
+
+  {
+    t8_cmesh_t cmesh = t8_cmesh_new_full_hybrid (comm);
+    test_parallel_with_cmesh (cmesh, comm);
+    t8_cmesh_destroy (&cmesh);
+  }
+
+  {
+    p8est_connectivity_t *p8_conn = p8est_connectivity_new_brick (8, 8, 8, 0, 0, 0);
+    t8_cmesh_t cmesh = t8_cmesh_new_from_p8est (p8_conn, comm, 0);
+    test_parallel_with_cmesh (cmesh, comm);
+    p8est_connectivity_destroy (p8_conn);
+    t8_cmesh_destroy (&cmesh);
+  }
+}
+
+/* Two lines that meet up to rounding errors at 0.5. The domain [0, 2^30] is quantized into bins of size 1,
+ * whose boundary at 0.5 lies between the two end points. The lines are joined nevertheless. */
+TEST (t8_cmesh_set_join_by_vertices, test_cmesh_set_join_by_vertices_bin_boundary)
+{
+  sc_MPI_Comm comm = sc_MPI_COMM_WORLD;
+  int mpirank, mpisize, mpiret;
+  mpiret = sc_MPI_Comm_rank (comm, &mpirank);
+  SC_CHECK_MPI (mpiret);
+  mpiret = sc_MPI_Comm_size (comm, &mpisize);
+  SC_CHECK_MPI (mpiret);
+
+  const t8_gloidx_t ntrees = 2;
+  const t8_eclass_t eclasses[2] = { T8_ECLASS_LINE, T8_ECLASS_LINE };
+  double vertices[2 * T8_ECLASS_MAX_CORNERS * T8_ECLASS_MAX_DIM] = { 0 };
+  vertices[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_CORNERS, T8_ECLASS_MAX_DIM, 0, 1, 0)] = 0.5 - ldexp (1, -52);
+  vertices[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_CORNERS, T8_ECLASS_MAX_DIM, 1, 0, 0)] = 0.5 + ldexp (1, -52);
+  vertices[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_CORNERS, T8_ECLASS_MAX_DIM, 1, 1, 0)] = ldexp (1, 30);
+
+  int *conn = NULL;
+  t8_cmesh_set_join_by_vertices (NULL, ntrees, eclasses, vertices, &conn, 1);
+  EXPECT_EQ (conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, 1, 0, 0)], 0);
+  EXPECT_EQ (conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, 1, 0, 1)], 1);
+  EXPECT_EQ (conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, 0, 1, 0)], 1);
+  EXPECT_EQ (conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, 0, 1, 1)], 0);
+  EXPECT_EQ (conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, 0, 0, 0)], -1);
+  EXPECT_EQ (conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, 1, 1, 0)], -1);
+
+  /* The parallel version finds the same connection, also if the faces are matched on different processes. */
+  const t8_gloidx_t first_tree = ntrees * mpirank / mpisize;
+  const t8_locidx_t num_local_trees = ntrees * (mpirank + 1) / mpisize - first_tree;
+  for (const int num_threads : { 1, 3 }) {
+    t8_gloidx_t *parallel_conn = NULL;
+    t8_cmesh_set_join_by_vertices_parallel (
+      NULL, first_tree, num_local_trees, eclasses + first_tree,
+      vertices + T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_CORNERS, T8_ECLASS_MAX_DIM, first_tree, 0, 0), &parallel_conn,
+      num_threads, comm);
+    for (t8_locidx_t itree = 0; itree < num_local_trees; itree++) {
+      for (int iface = 0; iface < t8_eclass_num_faces[T8_ECLASS_LINE]; iface++) {
+        for (int ientry = 0; ientry < 3; ientry++) {
+          EXPECT_EQ (parallel_conn[T8_3D_TO_1D (num_local_trees, T8_ECLASS_MAX_FACES, 3, itree, iface, ientry)],
+                     conn[T8_3D_TO_1D (ntrees, T8_ECLASS_MAX_FACES, 3, first_tree + itree, iface, ientry)]);
+        }
+      }
+    }
+    T8_FREE (parallel_conn);
+  }
+  T8_FREE (conn);
+}
+
 class t8_cmesh_set_join_by_vertices_class: public testing::TestWithParam<cmesh_example_base *> {
  protected:
   void
@@ -0,0 +1,127 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we store replicated cmeshes in shared memory, once by committing
+ * them on all processes and once by broadcasting a committed cmesh from process 0.
+ * We check that they are equal to the same cmeshes stored on each process. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_cmesh.h>
+#include <test/t8_gtest_macros.hxx>
+
+#define T8_SHMEM_TEST_NUM_TREES 4
+
+/* Create a row of trees with vertices that are connected at their faces 1 and 0 */
+static t8_cmesh_t
+t8_test_cmesh_shared_new (t8_eclass_t eclass, int set_shmem, sc_MPI_Comm comm)
+{
+  t8_cmesh_t cmesh;
+  const int num_vertices = t8_eclass_num_vertices[eclass];
+
+  t8_cmesh_init (&cmesh);
+  for (t8_gloidx_t itree = 0; itree < T8_SHMEM_TEST_NUM_TREES; itree++) {
+    double vertices[3 * T8_ECLASS_MAX_CORNERS];
+    t8_cmesh_set_tree_class (cmesh, itree, eclass);
+    for (int ivertex = 0; ivertex < num_vertices; ivertex++) {
+      vertices[3 * ivertex] = itree + ivertex;
+      vertices[3 * ivertex + 1] = 0.5 * ivertex;
+      vertices[3 * ivertex + 2] = itree;
+    }
+    t8_cmesh_set_tree_vertices (cmesh, itree, vertices, num_vertices);
+    if (eclass != T8_ECLASS_VERTEX && itree > 0) {
+      t8_cmesh_set_join (cmesh, itree - 1, itree, 1, 0, 0);
+    }
+  }
+  t8_cmesh_set_shared_memory (cmesh, set_shmem);
+  t8_cmesh_commit (cmesh, comm);
+  return cmesh;
+}
+
+/* Check that two cmeshes have the same trees, vertices and face neighbors */
+static void
+t8_test_cmesh_shared_compare (t8_cmesh_t cmesh, t8_cmesh_t cmesh_check)
+{
+  EXPECT_TRUE (t8_cmesh_is_equal (cmesh, cmesh_check));
+  ASSERT_EQ (t8_cmesh_get_num_local_trees (cmesh), t8_cmesh_get_num_local_trees (cmesh_check));
+  for (t8_locidx_t itree = 0; itree < t8_cmesh_get_num_local_trees (cmesh); itree++) {
+    const t8_eclass_t eclass = t8_cmesh_get_tree_class (cmesh, itree);
+    ASSERT_EQ (eclass, t8_cmesh_get_tree_class (cmesh_check, itree));
+    const double *vertices = t8_cmesh_get_tree_vertices (cmesh, itree);
+    const double *vertices_check = t8_cmesh_get_tree_vertices (cmesh_check, itree);
+    for (int icoord = 0; icoord < 3 * t8_eclass_num_vertices[eclass]; icoord++) {
+      EXPECT_EQ (vertices[icoord], vertices_check[icoord]);
+    }
+    for (int iface = 0; iface < t8_eclass_num_faces[eclass]; iface++) {
+      int dual_face, dual_face_check, orientation, orientation_check;
+      EXPECT_EQ (t8_cmesh_get_face_neighbor (cmesh, itree, iface, &dual_face, &orientation),
+                 t8_cmesh_get_face_neighbor (cmesh_check, itree, iface, &dual_face_check, &orientation_check));
+    }
+  }
+}
+
+class cmesh_shared_memory: public testing::TestWithParam<t8_eclass_t> {
+ protected:
+  void
+  SetUp () override
+  {
+    eclass = GetParam ();
+    cmesh_check = t8_test_cmesh_shared_new (eclass, 0, sc_MPI_COMM_WORLD);
+  }
+  void
+  TearDown () override
+  {
+    t8_cmesh_destroy (&cmesh_check);
+  }
+  t8_cmesh_t cmesh_check;
+  t8_eclass_t eclass;
+};
+
+TEST_P (cmesh_shared_memory, commit)
+{
+  t8_cmesh_t cmesh = t8_test_cmesh_shared_new (eclass, 1, sc_MPI_COMM_WORLD);
+
+  EXPECT_TRUE (t8_cmesh_uses_shared_memory (cmesh));
+  EXPECT_FALSE (t8_cmesh_uses_shared_memory (cmesh_check));
+  t8_test_cmesh_shared_compare (cmesh, cmesh_check);
+  t8_cmesh_destroy (&cmesh);
+}
+
+TEST_P (cmesh_shared_memory, bcast)
+{
+  int mpirank;
+  int mpiret = sc_MPI_Comm_rank (sc_MPI_COMM_WORLD, &mpirank);
+  SC_CHECK_MPI (mpiret);
+
+  /* Process 0 commits the cmesh on its own and broadcasts it into shared memory */
+  t8_cmesh_t cmesh = NULL;
+  if (mpirank == 0) {
+    cmesh = t8_test_cmesh_shared_new (eclass, 1, sc_MPI_COMM_SELF);
+  }
+  cmesh = t8_cmesh_bcast (cmesh, 0, sc_MPI_COMM_WORLD);
+
+  EXPECT_TRUE (t8_cmesh_uses_shared_memory (cmesh));
+  t8_test_cmesh_shared_compare (cmesh, cmesh_check);
+  t8_cmesh_destroy (&cmesh);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_cmesh_shared_memory, cmesh_shared_memory, AllEclasses, print_eclass);
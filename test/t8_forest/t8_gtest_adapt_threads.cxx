@@ -0,0 +1,117 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we adapt a forest once with one thread and once with
+ * multiple threads and check that the resulting forests are equal. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_cmesh.h>
+#include <t8_forest/t8_forest_general.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include "test/t8_cmesh_generator/t8_cmesh_example_sets.hxx"
+#include <test/t8_gtest_macros.hxx>
+
+class forest_adapt_threads: public testing::TestWithParam<cmesh_example_base *> {
+ protected:
+  void
+  SetUp () override
+  {
+    /* Construct a cmesh */
+    cmesh = GetParam ()->cmesh_create ();
+    if (t8_cmesh_is_empty (cmesh)) {
+      /* Empty cmeshes are not supported */
+      GTEST_SKIP ();
+    }
+  }
+  void
+  TearDown () override
+  {
+    t8_cmesh_destroy (&cmesh);
+  }
+  t8_cmesh_t cmesh;
+};
+
+/* Coarsen every family whose first element has an even index, remove some elements
+ * and refine every element with child id 1 up to a maximum level.
+ * The callback only reads its arguments and is thus thread-safe. */
+static int
+t8_test_adapt_threads_callback (t8_forest_t forest, t8_forest_t forest_from, t8_locidx_t which_tree,
+                                t8_locidx_t lelement_id, t8_eclass_scheme_c *ts, const int is_family,
+                                const int num_elements, t8_element_t *elements[])
+{
+  const int maxlevel = *(const int *) t8_forest_get_user_data (forest);
+  const int child_id = ts->t8_element_child_id (elements[0]);
+
+  if (is_family && lelement_id % 2 == 0) {
+    return -1;
+  }
+  if (child_id == 2 && lelement_id % 3 == 0) {
+    return -2;
+  }
+  if (child_id == 1 && ts->t8_element_level (elements[0]) < maxlevel) {
+    return 1;
+  }
+  return 0;
+}
+
+TEST_P (forest_adapt_threads, test_adapt_threads)
+{
+  t8_scheme_cxx_t *scheme = t8_scheme_new_default_cxx ();
+
+  /* Compute the first level, such that no process is empty */
+  int min_level = t8_forest_min_nonempty_level (cmesh, scheme);
+  /* Use one level with empty processes */
+  min_level = SC_MAX (min_level - 1, 0);
+  for (int level = min_level; level < min_level + 3; level++) {
+    int maxlevel = level + 1;
+    /* ref the cmesh and the scheme since we reuse them */
+    t8_cmesh_ref (cmesh);
+    t8_scheme_cxx_ref (scheme);
+    t8_forest_t forest = t8_forest_new_uniform (cmesh, scheme, level, 0, sc_MPI_COMM_WORLD);
+    /* We need to use forest twice, so we ref it */
+    t8_forest_ref (forest);
+
+    /* Adapt with one thread */
+    t8_forest_t forest_serial = t8_forest_new_adapt (forest, t8_test_adapt_threads_callback, 0, 0, &maxlevel);
+
+    /* Adapt with multiple threads */
+    for (int num_threads = 2; num_threads <= 4; num_threads += 2) {
+      t8_forest_t forest_threads;
+      t8_forest_ref (forest);
+      t8_forest_init (&forest_threads);
+      t8_forest_set_user_data (forest_threads, &maxlevel);
+      t8_forest_set_adapt (forest_threads, forest, t8_test_adapt_threads_callback, 0);
+      t8_forest_set_num_threads (forest_threads, num_threads);
+      t8_forest_commit (forest_threads);
+
+      EXPECT_EQ (t8_forest_get_global_num_elements (forest_serial), t8_forest_get_global_num_elements (forest_threads));
+      EXPECT_TRUE (t8_forest_is_equal (forest_serial, forest_threads)) << "The forests are not equal";
+      t8_forest_unref (&forest_threads);
+    }
+    t8_forest_unref (&forest_serial);
+    t8_forest_unref (&forest);
+  }
+  t8_scheme_cxx_unref (&scheme);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_adapt_threads, forest_adapt_threads, AllCmeshsParam, pretty_print_base_example);
@@ -35,6 +35,7 @@ along with t8code; if not, write to the Free Software Foundation, Inc.,
 #include <t8_geometry/t8_geometry_implementations/t8_geometry_linear.hxx>
 #include <t8_schemes/t8_default/t8_default_cxx.hxx>
 #include <t8_forest/t8_forest_balance.h>
+#include <t8_forest/t8_forest_profiling.h>
 
 #include <array>
 #include <vector>
@@ -244,5 +245,44 @@ TEST (gtest_balance, balance_consistency_test)
   t8_forest_unref (&already_balanced_forest);
 }
 
+/**
+ * \brief Tests whether the one-pass balance algorithm results in the same forest as the iterative one
+ * and needs fewer rounds to do so.
+ */
+TEST (gtest_balance, balance_onepass_equals_iterative)
+{
+  const int additional_refinement = 3;
+  std::vector<t8_gloidx_t> trees_to_refine { 0 };
+
+  t8_forest_t forest = t8_gtest_obtain_forest_for_balance_tests (trees_to_refine, additional_refinement);
+  t8_forest_ref (forest);
+
+  const int flag_no_repartition = 1;
+  t8_forest_t balanced_forest;
+  t8_forest_init (&balanced_forest);
+  t8_forest_set_balance (balanced_forest, forest, flag_no_repartition);
+  t8_forest_set_profiling (balanced_forest, 1);
+  t8_forest_commit (balanced_forest);
+
+  t8_forest_t onepass_forest;
+  t8_forest_init (&onepass_forest);
+  t8_forest_set_balance (onepass_forest, forest, flag_no_repartition);
+  t8_forest_set_balance_onepass (onepass_forest, 1);
+  t8_forest_set_profiling (onepass_forest, 1);
+  t8_forest_commit (onepass_forest);
+
+  EXPECT_EQ (t8_forest_is_balanced (onepass_forest), 1);
+  EXPECT_EQ (t8_forest_is_equal (balanced_forest, onepass_forest), 1);
+
+  /* The one-pass balance must need fewer rounds than the iterative one */
+  int iterative_rounds, onepass_rounds;
+  t8_forest_profile_get_balance_time (balanced_forest, &iterative_rounds);
+  t8_forest_profile_get_balance_time (onepass_forest, &onepass_rounds);
+  EXPECT_LT (onepass_rounds, iterative_rounds);
+
+  t8_forest_unref (&balanced_forest);
+  t8_forest_unref (&onepass_forest);
+}
+
 INSTANTIATE_TEST_SUITE_P (t8_gtest_balance, gtest_balance,
                           testing::Combine (AllEclasses, testing::Range (0, 5), testing::Range (0, 2)));
@@ -30,6 +30,8 @@ along with t8code; if not, write to the Free Software Foundation, Inc.,
 #include <t8_forest/t8_forest_geometrical.h>
 #include <test/t8_gtest_macros.hxx>
 
+#include <vector>
+
 /**
  * This file tests the volume-computation of elements.
  */
@@ -116,5 +118,28 @@ TEST_P (t8_forest_volume, volume_check)
   }
 }
 
+TEST_P (t8_forest_volume, volume_and_centroid_batched)
+{
+  /* Compute the volumes and centroids of all elements of a tree at once and compare them
+   * to the single element computation. */
+  const t8_locidx_t local_num_trees = t8_forest_get_num_local_trees (forest);
+  for (t8_locidx_t itree = 0; itree < local_num_trees; itree++) {
+    const t8_locidx_t tree_elements = t8_forest_get_tree_num_elements (forest, itree);
+    std::vector<double> volumes (tree_elements);
+    std::vector<double> centroids (3 * tree_elements);
+    t8_forest_tree_elements_volume (forest, itree, 0, tree_elements, volumes.data ());
+    t8_forest_tree_elements_centroid (forest, itree, 0, tree_elements, centroids.data ());
+    for (t8_locidx_t ielement = 0; ielement < tree_elements; ielement++) {
+      const t8_element_t *element = t8_forest_get_element_in_tree (forest, itree, ielement);
+      EXPECT_NEAR (volumes[ielement], t8_forest_element_volume (forest, itree, element), epsilon);
+      double centroid[3];
+      t8_forest_element_centroid (forest, itree, element, centroid);
+      for (int idim = 0; idim < 3; idim++) {
+        EXPECT_NEAR (centroid[idim], centroids[idim * tree_elements + ielement], epsilon);
+      }
+    }
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P (t8_gtest_element_volume, t8_forest_volume,
                           testing::Combine (AllEclasses, testing::Range (0, 4)));
@@ -0,0 +1,124 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we compute the face neighbor table of a uniform, of an adapted
+ * and balanced, and of an adapted and unbalanced forest and compare its entries with
+ * the results of t8_forest_leaf_face_neighbors_ext for each face of each local leaf. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_cmesh.h>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_forest/t8_forest_general.h>
+#include <t8_forest/t8_forest_face_connectivity.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <test/t8_gtest_macros.hxx>
+
+/* Refine every element with child id 0 up to level 3. */
+static int
+t8_test_face_connectivity_adapt (t8_forest_t forest, t8_forest_t forest_from, t8_locidx_t which_tree,
+                                 t8_locidx_t lelement_id, t8_eclass_scheme_c *ts, const int is_family,
+                                 const int num_elements, t8_element_t *elements[])
+{
+  return ts->t8_element_child_id (elements[0]) == 0 && ts->t8_element_level (elements[0]) < 3;
+}
+
+class forest_face_connectivity: public testing::TestWithParam<std::tuple<t8_eclass_t, int>> {
+ protected:
+  void
+  SetUp () override
+  {
+    const t8_eclass_t eclass = std::get<0> (GetParam ());
+    const int adapt = std::get<1> (GetParam ());
+    t8_cmesh_t cmesh = t8_cmesh_new_hypercube (eclass, sc_MPI_COMM_WORLD, 0, 0, 0);
+    forest = t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), 1, 1, sc_MPI_COMM_WORLD);
+    if (adapt == 1) {
+      /* Adapt and balance the forest, such that leaves have up to two face neighbors. */
+      t8_forest_t forest_adapt = t8_forest_new_adapt (forest, t8_test_face_connectivity_adapt, 1, 0, NULL);
+      t8_forest_init (&forest);
+      t8_forest_set_balance (forest, forest_adapt, 0);
+      t8_forest_set_ghost (forest, 1, T8_GHOST_FACES);
+      t8_forest_commit (forest);
+    }
+    else if (adapt == 2) {
+      /* Adapt the forest without balancing, such that neighbor levels differ by up to two. */
+      forest = t8_forest_new_adapt (forest, t8_test_face_connectivity_adapt, 1, 1, NULL);
+    }
+    forest_is_balanced = adapt < 2;
+  }
+  void
+  TearDown () override
+  {
+    t8_forest_unref (&forest);
+  }
+  t8_forest_t forest;
+  int forest_is_balanced;
+};
+
+TEST_P (forest_face_connectivity, compare_with_leaf_face_neighbors)
+{
+  const t8_forest_face_connectivity_t *conn = t8_forest_get_face_connectivity (forest, forest_is_balanced);
+  /* The table is only computed once and does not depend on the balance flag */
+  EXPECT_EQ (conn, t8_forest_get_face_connectivity (forest, forest_is_balanced));
+  EXPECT_EQ (conn, t8_forest_get_face_connectivity (forest, 0));
+  ASSERT_EQ (t8_forest_get_local_num_elements (forest), conn->num_elements);
+  ASSERT_EQ (t8_forest_get_num_ghosts (forest), conn->num_ghosts);
+
+  for (t8_locidx_t itree = 0, ielement = 0; itree < t8_forest_get_num_local_trees (forest); itree++) {
+    const t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, t8_forest_get_tree_class (forest, itree));
+    for (t8_locidx_t ielem_tree = 0; ielem_tree < t8_forest_get_tree_num_elements (forest, itree);
+         ielem_tree++, ielement++) {
+      const t8_element_t *leaf = t8_forest_get_element_in_tree (forest, itree, ielem_tree);
+      const int num_faces = ts->t8_element_num_faces (leaf);
+      ASSERT_EQ (num_faces, conn->face_offsets[ielement + 1] - conn->face_offsets[ielement]);
+      for (int iface = 0; iface < num_faces; iface++) {
+        t8_element_t **neighbor_leaves;
+        int *dual_faces;
+        int num_neighbors;
+        int orientation;
+        t8_locidx_t *element_indices;
+        t8_eclass_scheme_c *neigh_scheme;
+        /* The search for unbalanced forests returns the neighbors sorted along the SFC, as the table. */
+        t8_forest_leaf_face_neighbors_ext (forest, itree, leaf, &neighbor_leaves, iface, &dual_faces, &num_neighbors,
+                                           &element_indices, &neigh_scheme, 0, NULL, &orientation);
+
+        const t8_locidx_t face_index = conn->face_offsets[ielement] + iface;
+        const t8_locidx_t first_neighbor = conn->neighbor_offsets[face_index];
+        ASSERT_EQ (num_neighbors, conn->neighbor_offsets[face_index + 1] - first_neighbor);
+        EXPECT_EQ (orientation, conn->orientations[face_index]);
+        for (int ineigh = 0; ineigh < num_neighbors; ineigh++) {
+          EXPECT_EQ (element_indices[ineigh], conn->neighbors[first_neighbor + ineigh]);
+          EXPECT_EQ (dual_faces[ineigh], conn->dual_faces[first_neighbor + ineigh]);
+        }
+        if (num_neighbors > 0) {
+          neigh_scheme->t8_element_destroy (num_neighbors, neighbor_leaves);
+          T8_FREE (element_indices);
+          T8_FREE (neighbor_leaves);
+          T8_FREE (dual_faces);
+        }
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_face_connectivity, forest_face_connectivity,
+                          testing::Combine (AllEclasses, testing::Range (0, 3)));
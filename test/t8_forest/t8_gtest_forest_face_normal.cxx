@@ -30,6 +30,8 @@ along with t8code; if not, write to the Free Software Foundation, Inc.,
 #include <t8_forest/t8_forest_geometrical.h>
 #include <test/t8_gtest_macros.hxx>
 
+#include <vector>
+
 /**
  * This file tests the face normal computation of elements.
  */
@@ -111,5 +113,28 @@ TEST_P (class_forest_face_normal, back_and_forth)
   }
 }
 
+TEST_P (class_forest_face_normal, batched_equals_single)
+{
+  /* Compute the facenormals of all elements of a tree at once and compare them to the single element computation. */
+  /* Pyramid trees also contain tetrahedra, so we only check the faces that all elements have. */
+  const int num_faces = eclass == T8_ECLASS_PYRAMID ? t8_eclass_num_faces[T8_ECLASS_TET] : t8_eclass_num_faces[eclass];
+  const t8_locidx_t local_num_trees = t8_forest_get_num_local_trees (forest);
+  for (t8_locidx_t itree = 0; itree < local_num_trees; itree++) {
+    const t8_locidx_t tree_elements = t8_forest_get_tree_num_elements (forest, itree);
+    std::vector<double> normals (3 * tree_elements);
+    for (int iface = 0; iface < num_faces; iface++) {
+      t8_forest_tree_elements_face_normal (forest, itree, 0, tree_elements, iface, normals.data ());
+      for (t8_locidx_t ielement = 0; ielement < tree_elements; ielement++) {
+        const t8_element_t *element = t8_forest_get_element_in_tree (forest, itree, ielement);
+        double face_normal[3];
+        t8_forest_element_face_normal (forest, itree, element, iface, face_normal);
+        for (int idim = 0; idim < 3; idim++) {
+          EXPECT_NEAR (face_normal[idim], normals[idim * tree_elements + ielement], T8_PRECISION_SQRT_EPS);
+        }
+      }
+    }
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P (t8_gtest_forest_face_normal, class_forest_face_normal,
                           testing::Combine (AllEclasses, testing::Range (0, 2)));
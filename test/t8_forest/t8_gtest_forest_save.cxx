@@ -0,0 +1,178 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we save an adapted forest together with per-element data to a
+ * checkpoint file and load it again, on the same processes with a replicated and with a
+ * partitioned cmesh and on each single process. We check that the loaded forests and
+ * data match the saved ones. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_cmesh.h>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_forest/t8_forest_general.h>
+#include <t8_forest/t8_forest_io.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <test/t8_gtest_macros.hxx>
+
+class forest_save: public testing::TestWithParam<t8_eclass_t> {
+ protected:
+  void
+  SetUp () override
+  {
+    eclass = GetParam ();
+    scheme = t8_scheme_new_default_cxx ();
+    t8_cmesh_t cmesh = t8_cmesh_new_hypercube (eclass, sc_MPI_COMM_WORLD, 0, 0, 0);
+    /* Create an adapted and partitioned forest */
+    t8_scheme_cxx_ref (scheme);
+    t8_forest_t forest_uniform = t8_forest_new_uniform (cmesh, scheme, 1, 0, sc_MPI_COMM_WORLD);
+    t8_forest_t forest_adapt = t8_forest_new_adapt (forest_uniform, t8_test_forest_save_adapt, 1, 0, &maxlevel);
+    t8_forest_init (&forest);
+    t8_forest_set_partition (forest, forest_adapt, 0);
+    t8_forest_commit (forest);
+
+    snprintf (filename, BUFSIZ, "t8_gtest_forest_save_%s.t8f", t8_eclass_to_string[eclass]);
+    /* Store the global element index of each element as data */
+    const t8_locidx_t num_local_elements = t8_forest_get_local_num_elements (forest);
+    const t8_gloidx_t first_element = t8_forest_get_first_local_element_id (forest);
+    sc_array_t *element_data = sc_array_new_count (sizeof (t8_gloidx_t), num_local_elements);
+    for (t8_locidx_t ielement = 0; ielement < num_local_elements; ielement++) {
+      *(t8_gloidx_t *) sc_array_index_int (element_data, ielement) = first_element + ielement;
+    }
+    t8_forest_save_ext (forest, filename, element_data);
+    sc_array_destroy (element_data);
+  }
+  void
+  TearDown () override
+  {
+    /* Remove the checkpoint once all processes are done reading it. */
+    int mpirank;
+    int mpiret = sc_MPI_Barrier (sc_MPI_COMM_WORLD);
+    SC_CHECK_MPI (mpiret);
+    mpiret = sc_MPI_Comm_rank (sc_MPI_COMM_WORLD, &mpirank);
+    SC_CHECK_MPI (mpiret);
+    if (mpirank == 0) {
+      remove (filename);
+    }
+    t8_forest_unref (&forest);
+    t8_scheme_cxx_unref (&scheme);
+  }
+
+  /* Refine every element with child id 1 up to the maximum level. */
+  static int
+  t8_test_forest_save_adapt (t8_forest_t forest, t8_forest_t forest_from, t8_locidx_t which_tree,
+                             t8_locidx_t lelement_id, t8_eclass_scheme_c *ts, const int is_family,
+                             const int num_elements, t8_element_t *elements[])
+  {
+    const int maxlevel = *(const int *) t8_forest_get_user_data (forest);
+    return ts->t8_element_child_id (elements[0]) == 1 && ts->t8_element_level (elements[0]) < maxlevel;
+  }
+
+  /* Load the checkpoint into a forest over comm. If do_partition is true, the cmesh is partitioned. */
+  t8_forest_t
+  load_forest (sc_MPI_Comm comm, const int do_partition = 0)
+  {
+    t8_forest_t forest_load;
+    t8_forest_init (&forest_load);
+    t8_forest_set_cmesh (forest_load, t8_cmesh_new_hypercube (eclass, comm, 0, do_partition, 0), comm);
+    t8_scheme_cxx_ref (scheme);
+    t8_forest_set_scheme (forest_load, scheme);
+    t8_forest_set_load (forest_load, filename);
+    t8_forest_commit (forest_load);
+    return forest_load;
+  }
+
+  t8_eclass_t eclass;
+  t8_scheme_cxx_t *scheme;
+  t8_forest_t forest;
+  int maxlevel = 4;
+  char filename[BUFSIZ];
+};
+
+/* Load the forest on the processes that saved it. The partition is restored. */
+TEST_P (forest_save, load_same_processes)
+{
+  t8_forest_t forest_load = load_forest (sc_MPI_COMM_WORLD);
+  EXPECT_EQ (t8_forest_get_local_num_elements (forest), t8_forest_get_local_num_elements (forest_load));
+  EXPECT_TRUE (t8_forest_is_equal (forest, forest_load)) << "The loaded forest does not match the saved forest.";
+
+  sc_array_t *element_data = sc_array_new (sizeof (t8_gloidx_t));
+  t8_forest_load_element_data (forest_load, filename, element_data);
+  ASSERT_EQ ((size_t) t8_forest_get_local_num_elements (forest_load), element_data->elem_count);
+  const t8_gloidx_t first_element = t8_forest_get_first_local_element_id (forest_load);
+  for (size_t ielement = 0; ielement < element_data->elem_count; ielement++) {
+    EXPECT_EQ (first_element + (t8_gloidx_t) ielement, *(t8_gloidx_t *) sc_array_index (element_data, ielement));
+  }
+  sc_array_destroy (element_data);
+  t8_forest_unref (&forest_load);
+}
+
+/* Load the forest on the processes that saved it onto a partitioned cmesh.
+ * The cmesh is repartitioned to match the loaded forest. */
+TEST_P (forest_save, load_partitioned_cmesh)
+{
+  t8_forest_t forest_load = load_forest (sc_MPI_COMM_WORLD, 1);
+  EXPECT_TRUE (t8_cmesh_is_partitioned (t8_forest_get_cmesh (forest_load)));
+  EXPECT_EQ (t8_forest_get_local_num_elements (forest), t8_forest_get_local_num_elements (forest_load));
+  EXPECT_TRUE (t8_forest_is_equal (forest, forest_load)) << "The loaded forest does not match the saved forest.";
+
+  sc_array_t *element_data = sc_array_new (sizeof (t8_gloidx_t));
+  t8_forest_load_element_data (forest_load, filename, element_data);
+  ASSERT_EQ ((size_t) t8_forest_get_local_num_elements (forest_load), element_data->elem_count);
+  const t8_gloidx_t first_element = t8_forest_get_first_local_element_id (forest_load);
+  for (size_t ielement = 0; ielement < element_data->elem_count; ielement++) {
+    EXPECT_EQ (first_element + (t8_gloidx_t) ielement, *(t8_gloidx_t *) sc_array_index (element_data, ielement));
+  }
+  sc_array_destroy (element_data);
+  t8_forest_unref (&forest_load);
+}
+
+/* Load the complete forest on each single process and compare it with the local part of the saved forest. */
+TEST_P (forest_save, load_single_process)
+{
+  t8_forest_t forest_load = load_forest (sc_MPI_COMM_SELF);
+  ASSERT_EQ (t8_forest_get_global_num_elements (forest), t8_forest_get_local_num_elements (forest_load));
+
+  const t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, eclass);
+  const t8_gloidx_t first_element = t8_forest_get_first_local_element_id (forest);
+  const t8_gloidx_t first_tree = t8_forest_get_first_local_tree_id (forest);
+  for (t8_locidx_t itree = 0, ielement = 0; itree < t8_forest_get_num_local_trees (forest); itree++) {
+    for (t8_locidx_t ielem_in_tree = 0; ielem_in_tree < t8_forest_get_tree_num_elements (forest, itree);
+         ielem_in_tree++, ielement++) {
+      t8_locidx_t ltree_load;
+      const t8_element_t *element = t8_forest_get_element_in_tree (forest, itree, ielem_in_tree);
+      const t8_element_t *element_load = t8_forest_get_element (forest_load, first_element + ielement, &ltree_load);
+      EXPECT_EQ (first_tree + itree, ltree_load);
+      EXPECT_TRUE (ts->t8_element_equal (element, element_load));
+    }
+  }
+
+  sc_array_t *element_data = sc_array_new (sizeof (t8_gloidx_t));
+  t8_forest_load_element_data (forest_load, filename, element_data);
+  for (size_t ielement = 0; ielement < element_data->elem_count; ielement++) {
+    EXPECT_EQ ((t8_gloidx_t) ielement, *(t8_gloidx_t *) sc_array_index (element_data, ielement));
+  }
+  sc_array_destroy (element_data);
+  t8_forest_unref (&forest_load);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_forest_save, forest_save, AllEclasses, print_eclass);
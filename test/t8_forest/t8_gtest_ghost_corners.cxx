@@ -0,0 +1,335 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we create the face, edge and vertex ghost layers of width 1, 2 and 3
+ * of an adapted forest on a grid of axis-aligned trees. In a second variant, every other tree
+ * of the grid is rotated, such that the trees are connected with different faces and orientations.
+ * We construct the same forest
+ * on each process without partitioning and compute all leaves that can be reached from
+ * a local leaf by a chain of leaves touching in a face, edge or vertex from their bounding boxes.
+ * These must be exactly the ghost elements of the partitioned forest. We also check that
+ * the ghost data exchange fills all ghost elements and that the profiled phases of
+ * the ghost creation add up to at most its runtime. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_cmesh.hxx>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_cmesh/t8_cmesh_helpers.h>
+#include <t8_forest/t8_forest_general.h>
+#include <t8_forest/t8_forest_geometrical.h>
+#include <t8_forest/t8_forest_ghost.h>
+#include <t8_forest/t8_forest_profiling.h>
+#include <t8_geometry/t8_geometry_implementations/t8_geometry_linear.hxx>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#define T8_GHOST_CORNERS_EPS 1e-10
+
+/* The lower and upper coordinates of an axis-aligned element */
+typedef std::array<double, 6> t8_ghost_box_t;
+
+class forest_ghost_corners: public testing::TestWithParam<std::tuple<t8_eclass_t, t8_ghost_type_t, int, int>> {
+ protected:
+  void
+  SetUp () override
+  {
+    eclass = std::get<0> (GetParam ());
+    ghost_type = std::get<1> (GetParam ());
+    ghost_width = std::get<2> (GetParam ());
+    rotated = std::get<3> (GetParam ());
+    dim = t8_eclass_to_dimension[eclass];
+    scheme = t8_scheme_new_default_cxx ();
+  }
+  void
+  TearDown () override
+  {
+    t8_scheme_cxx_unref (&scheme);
+  }
+
+  /* A grid of 3 x 2 x 2 unit cubes (3 lines in 1D, 3 x 2 quads in 2D).
+   * If rotated is true, the trees with odd id are rotated by 90 degrees in the xy-plane
+   * (lines are reversed) and the face connections are computed from the vertices. */
+  t8_cmesh_t
+  create_cmesh (sc_MPI_Comm comm)
+  {
+    if (!rotated) {
+      const double boundary[24] = { 0, 0, 0, 3, 0, 0, 0, 2, 0, 3, 2, 0, 0, 0, 2, 3, 0, 2, 0, 2, 2, 3, 2, 2 };
+      return t8_cmesh_new_hypercube_pad (eclass, comm, boundary, 3, 2, 2, 0);
+    }
+    const int num_trees_per_dim[3] = { 3, dim > 1 ? 2 : 1, dim > 2 ? 2 : 1 };
+    const int num_vertices = t8_eclass_num_vertices[eclass];
+    t8_cmesh_t cmesh;
+    t8_cmesh_init (&cmesh);
+    t8_cmesh_register_geometry<t8_geometry_linear> (cmesh, dim);
+    t8_gloidx_t itree = 0;
+    for (int z = 0; z < num_trees_per_dim[2]; z++) {
+      for (int y = 0; y < num_trees_per_dim[1]; y++) {
+        for (int x = 0; x < num_trees_per_dim[0]; x++, itree++) {
+          double vertices[3 * T8_ECLASS_MAX_CORNERS] = { 0 };
+          for (int ivertex = 0; ivertex < num_vertices; ivertex++) {
+            const int bits[3] = { ivertex & 1, (ivertex >> 1) & 1, (ivertex >> 2) & 1 };
+            if (itree % 2 == 0) {
+              vertices[3 * ivertex] = x + bits[0];
+              vertices[3 * ivertex + 1] = y + bits[1];
+            }
+            else if (dim == 1) {
+              vertices[3 * ivertex] = x + 1 - bits[0];
+            }
+            else {
+              /* The reference x-axis points in physical y-direction and the reference y-axis in -x-direction. */
+              vertices[3 * ivertex] = x + 1 - bits[1];
+              vertices[3 * ivertex + 1] = y + bits[0];
+            }
+            vertices[3 * ivertex + 2] = dim > 2 ? z + bits[2] : 0;
+          }
+          t8_cmesh_set_tree_class (cmesh, itree, eclass);
+          t8_cmesh_set_tree_vertices (cmesh, itree, vertices, num_vertices);
+        }
+      }
+    }
+    t8_cmesh_set_join_by_stash (cmesh, NULL, 0);
+    t8_cmesh_commit (cmesh, comm);
+    return cmesh;
+  }
+
+  t8_eclass_t eclass;
+  t8_ghost_type_t ghost_type;
+  int ghost_width;
+  int rotated;
+  int dim;
+  t8_scheme_cxx_t *scheme;
+};
+
+/* Refine every second element up to level 3 */
+static int
+t8_test_ghost_corners_adapt (t8_forest_t forest, t8_forest_t forest_from, t8_locidx_t which_tree,
+                             t8_locidx_t lelement_id, t8_eclass_scheme_c *ts, const int is_family,
+                             const int num_elements, t8_element_t *elements[])
+{
+  const int level = ts->t8_element_level (elements[0]);
+  const t8_linearidx_t eid = ts->t8_element_get_linear_id (elements[0], level);
+  const int maxlevel = ts->t8_element_num_corners (elements[0]) == 8 ? 2 : 3;
+
+  return (eid % 2 && level < maxlevel) ? 1 : 0;
+}
+
+/* Create an adapted forest with the given ghost type and width */
+static t8_forest_t
+t8_test_ghost_corners_forest (t8_cmesh_t cmesh, t8_scheme_cxx_t *scheme, sc_MPI_Comm comm, t8_ghost_type_t ghost_type,
+                              const int ghost_width)
+{
+  t8_forest_t forest_uniform = t8_forest_new_uniform (cmesh, scheme, 1, 0, comm);
+  t8_forest_t forest;
+
+  t8_forest_init (&forest);
+  t8_forest_set_adapt (forest, forest_uniform, t8_test_ghost_corners_adapt, 1);
+  t8_forest_set_partition (forest, NULL, 0);
+  t8_forest_set_ghost_ext (forest, ghost_type != T8_GHOST_NONE, ghost_type, 3, ghost_width);
+  t8_forest_set_profiling (forest, 1);
+  t8_forest_commit (forest);
+  return forest;
+}
+
+/* Compute the bounding box of an element */
+static t8_ghost_box_t
+t8_test_ghost_corners_box (t8_forest_t forest, t8_locidx_t ltreeid, const t8_element_t *element,
+                           t8_eclass_scheme_c *ts)
+{
+  t8_ghost_box_t box = { 0, 0, 0, 0, 0, 0 };
+  const int num_corners = ts->t8_element_num_corners (element);
+
+  for (int icorner = 0; icorner < num_corners; icorner++) {
+    double coords[3];
+    t8_forest_element_coordinate (forest, ltreeid, element, icorner, coords);
+    for (int idim = 0; idim < 3; idim++) {
+      box[idim] = icorner == 0 ? coords[idim] : SC_MIN (box[idim], coords[idim]);
+      box[3 + idim] = icorner == 0 ? coords[idim] : SC_MAX (box[3 + idim], coords[idim]);
+    }
+  }
+  return box;
+}
+
+/* Collect the bounding boxes of all local or all ghost elements of a forest */
+static std::vector<t8_ghost_box_t>
+t8_test_ghost_corners_boxes (t8_forest_t forest, t8_eclass_scheme_c *ts, const int ghosts)
+{
+  std::vector<t8_ghost_box_t> boxes;
+  const t8_locidx_t num_local_trees = t8_forest_get_num_local_trees (forest);
+
+  if (!ghosts) {
+    for (t8_locidx_t itree = 0; itree < num_local_trees; itree++) {
+      for (t8_locidx_t ielem = 0; ielem < t8_forest_get_tree_num_elements (forest, itree); ielem++) {
+        const t8_element_t *element = t8_forest_get_element_in_tree (forest, itree, ielem);
+        boxes.push_back (t8_test_ghost_corners_box (forest, itree, element, ts));
+      }
+    }
+    return boxes;
+  }
+  for (t8_locidx_t ighost_tree = 0; ighost_tree < t8_forest_get_num_ghost_trees (forest); ighost_tree++) {
+    for (t8_locidx_t ielem = 0; ielem < t8_forest_ghost_tree_num_elements (forest, ighost_tree); ielem++) {
+      const t8_element_t *element = t8_forest_ghost_get_element (forest, ighost_tree, ielem);
+      boxes.push_back (t8_test_ghost_corners_box (forest, num_local_trees + ighost_tree, element, ts));
+    }
+  }
+  return boxes;
+}
+
+/* Return the dimension of the intersection of two boxes, or -1 if they are disjoint */
+static int
+t8_test_ghost_corners_intersection_dim (const t8_ghost_box_t &box_a, const t8_ghost_box_t &box_b, const int dim)
+{
+  int intersection_dim = 0;
+
+  for (int idim = 0; idim < dim; idim++) {
+    const double overlap = SC_MIN (box_a[3 + idim], box_b[3 + idim]) - SC_MAX (box_a[idim], box_b[idim]);
+    if (overlap < -T8_GHOST_CORNERS_EPS) {
+      return -1;
+    }
+    if (overlap > T8_GHOST_CORNERS_EPS) {
+      intersection_dim++;
+    }
+  }
+  return intersection_dim;
+}
+
+static int
+t8_test_ghost_corners_contains (const std::vector<t8_ghost_box_t> &boxes, const t8_ghost_box_t &box)
+{
+  for (const t8_ghost_box_t &other : boxes) {
+    int equal = 1;
+    for (int icoord = 0; icoord < 6; icoord++) {
+      equal = equal && fabs (other[icoord] - box[icoord]) < T8_GHOST_CORNERS_EPS;
+    }
+    if (equal) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+TEST_P (forest_ghost_corners, test_ghost_corners)
+{
+  t8_eclass_scheme_c *ts = scheme->eclass_schemes[eclass];
+  const int codim = ghost_type == T8_GHOST_FACES ? 1 : ghost_type == T8_GHOST_EDGES ? 2 : 3;
+
+  /* The partitioned forest with ghosts */
+  t8_scheme_cxx_ref (scheme);
+  t8_forest_t forest = t8_test_ghost_corners_forest (create_cmesh (sc_MPI_COMM_WORLD), scheme, sc_MPI_COMM_WORLD,
+                                                     ghost_type, ghost_width);
+  /* The same forest with all elements on this process */
+  t8_scheme_cxx_ref (scheme);
+  t8_forest_t forest_serial
+    = t8_test_ghost_corners_forest (create_cmesh (sc_MPI_COMM_SELF), scheme, sc_MPI_COMM_SELF, T8_GHOST_NONE, 1);
+
+  if (rotated) {
+    /* Some trees are connected with a non-zero orientation */
+    t8_cmesh_t cmesh = t8_forest_get_cmesh (forest_serial);
+    int has_orientation = 0;
+    for (t8_locidx_t itree = 0; itree < t8_cmesh_get_num_local_trees (cmesh); itree++) {
+      for (int iface = 0; iface < t8_eclass_num_faces[eclass]; iface++) {
+        int orientation = 0;
+        if (t8_cmesh_get_face_neighbor (cmesh, itree, iface, NULL, &orientation) >= 0 && orientation != 0) {
+          has_orientation = 1;
+        }
+      }
+    }
+    EXPECT_TRUE (has_orientation);
+  }
+
+  const std::vector<t8_ghost_box_t> local_boxes = t8_test_ghost_corners_boxes (forest, ts, 0);
+  const std::vector<t8_ghost_box_t> ghost_boxes = t8_test_ghost_corners_boxes (forest, ts, 1);
+  const std::vector<t8_ghost_box_t> all_boxes = t8_test_ghost_corners_boxes (forest_serial, ts, 0);
+
+  /* Compute the distance of all leaves to the local leaves, where two leaves are
+   * neighbors if they touch in a subentity of codimension at most codim. */
+  std::vector<int> distance (all_boxes.size (), -1);
+  std::vector<size_t> queue;
+  for (size_t ibox = 0; ibox < all_boxes.size (); ibox++) {
+    if (t8_test_ghost_corners_contains (local_boxes, all_boxes[ibox])) {
+      distance[ibox] = 0;
+      queue.push_back (ibox);
+    }
+  }
+  for (size_t iqueue = 0; iqueue < queue.size (); iqueue++) {
+    const size_t ibox = queue[iqueue];
+    if (distance[ibox] == ghost_width) {
+      continue;
+    }
+    for (size_t ineigh = 0; ineigh < all_boxes.size (); ineigh++) {
+      if (distance[ineigh] < 0
+          && t8_test_ghost_corners_intersection_dim (all_boxes[ibox], all_boxes[ineigh], dim)
+               >= dim - SC_MIN (codim, dim)) {
+        distance[ineigh] = distance[ibox] + 1;
+        queue.push_back (ineigh);
+      }
+    }
+  }
+  /* The ghosts are all leaves with a positive distance of at most the ghost width */
+  std::vector<t8_ghost_box_t> expected_ghosts;
+  for (size_t ibox = 0; ibox < all_boxes.size (); ibox++) {
+    if (distance[ibox] > 0) {
+      expected_ghosts.push_back (all_boxes[ibox]);
+    }
+  }
+
+  ASSERT_EQ ((size_t) t8_forest_get_num_ghosts (forest), ghost_boxes.size ());
+  EXPECT_EQ (expected_ghosts.size (), ghost_boxes.size ());
+  for (const t8_ghost_box_t &ghost_box : ghost_boxes) {
+    EXPECT_TRUE (t8_test_ghost_corners_contains (expected_ghosts, ghost_box)) << "Unexpected ghost element.";
+  }
+
+  /* Exchange the lower corners of the boxes and compare them with the ghost boxes */
+  sc_array_t *element_data = sc_array_new_count (3 * sizeof (double), local_boxes.size () + ghost_boxes.size ());
+  for (size_t ibox = 0; ibox < local_boxes.size (); ibox++) {
+    memcpy (sc_array_index (element_data, ibox), local_boxes[ibox].data (), 3 * sizeof (double));
+  }
+  t8_forest_ghost_exchange_data (forest, element_data);
+  for (size_t ighost = 0; ighost < ghost_boxes.size (); ighost++) {
+    const double *lower = (const double *) sc_array_index (element_data, local_boxes.size () + ighost);
+    for (int idim = 0; idim < 3; idim++) {
+      EXPECT_NEAR (lower[idim], ghost_boxes[ighost][idim], T8_GHOST_CORNERS_EPS);
+    }
+  }
+  sc_array_destroy (element_data);
+
+  /* The phases of ghost creation add up to at most its runtime */
+  double search_time, pack_time, communicate_time, unpack_time;
+  const double ghost_time
+    = t8_forest_profile_get_ghost_phase_times (forest, &search_time, &pack_time, &communicate_time, &unpack_time);
+  EXPECT_GE (search_time, 0);
+  EXPECT_GE (pack_time, 0);
+  EXPECT_GE (communicate_time, 0);
+  EXPECT_GE (unpack_time, 0);
+  EXPECT_LE (search_time + pack_time + communicate_time + unpack_time, ghost_time + T8_GHOST_CORNERS_EPS);
+
+  t8_forest_unref (&forest);
+  t8_forest_unref (&forest_serial);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_ghost_corners, forest_ghost_corners,
+                          testing::Combine (testing::Values (T8_ECLASS_LINE, T8_ECLASS_QUAD, T8_ECLASS_HEX),
+                                            testing::Values (T8_GHOST_FACES, T8_GHOST_EDGES, T8_GHOST_VERTICES),
+                                            testing::Values (1, 2, 3), testing::Values (0, 1)));
@@ -168,6 +168,47 @@ t8_test_ghost_exchange_data_int (t8_forest_t forest)
   sc_array_reset (&element_data);
 }
 
+/* Construct two data arrays of ints for all elements and all ghosts and
+ * exchange them several times with the non-blocking begin/end interface.
+ * In each round the element's entries are set to a different value, such that
+ * we check that the reused persistent communication transfers the current data.
+ */
+static void
+t8_test_ghost_exchange_begin_end (t8_forest_t forest)
+{
+  sc_array_t element_data[2];
+  t8_forest_ghost_exchange_t exchange[2];
+
+  t8_locidx_t num_elements = t8_forest_get_local_num_elements (forest);
+  t8_locidx_t num_ghosts = t8_forest_get_num_ghosts (forest);
+  for (int iarray = 0; iarray < 2; iarray++) {
+    sc_array_init_size (&element_data[iarray], sizeof (int), num_elements + num_ghosts);
+  }
+
+  for (int round = 0; round < 3; round++) {
+    for (int iarray = 0; iarray < 2; iarray++) {
+      /* Fill the local element entries with a value depending on the round and the array */
+      for (t8_locidx_t ielem = 0; ielem < num_elements; ielem++) {
+        *(int *) t8_sc_array_index_locidx (&element_data[iarray], ielem) = 10 * round + iarray;
+      }
+      /* Start the exchange of this array */
+      exchange[iarray] = t8_forest_ghost_exchange_begin (forest, &element_data[iarray]);
+    }
+    for (int iarray = 0; iarray < 2; iarray++) {
+      t8_forest_ghost_exchange_end (exchange[iarray]);
+      /* Check for the ghosts that we received the correct data */
+      for (t8_locidx_t ielem = 0; ielem < num_ghosts; ielem++) {
+        int ghost_int = *(int *) t8_sc_array_index_locidx (&element_data[iarray], num_elements + ielem);
+        ASSERT_EQ (ghost_int, 10 * round + iarray) << "Error when exchanging ghost data. Received wrong data.\n";
+      }
+    }
+  }
+  /* clean-up */
+  for (int iarray = 0; iarray < 2; iarray++) {
+    sc_array_reset (&element_data[iarray]);
+  }
+}
+
 TEST_P (forest_ghost_exchange, test_ghost_exchange)
 {
 
@@ -185,11 +226,13 @@ TEST_P (forest_ghost_exchange, test_ghost_exchange)
     /* exchange ghost data */
     t8_test_ghost_exchange_data_int (forest);
     t8_test_ghost_exchange_data_id (forest);
+    t8_test_ghost_exchange_begin_end (forest);
     /* Adapt the forest and exchange data again */
     int maxlevel = level + 2;
     t8_forest_t forest_adapt = t8_forest_new_adapt (forest, t8_test_exchange_adapt, 1, 1, &maxlevel);
     t8_test_ghost_exchange_data_int (forest_adapt);
     t8_test_ghost_exchange_data_id (forest_adapt);
+    t8_test_ghost_exchange_begin_end (forest_adapt);
     t8_forest_unref (&forest_adapt);
   }
 }
@@ -0,0 +1,151 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we compute the leaf face neighbors without assuming that the forest is balanced.
+ * For a balanced forest, we compare the results with the balanced algorithm.
+ * For an unbalanced forest, we check that the neighbor relation is symmetric. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_cmesh.h>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_forest/t8_forest_general.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <test/t8_gtest_macros.hxx>
+
+#include <algorithm>
+#include <vector>
+
+/* Refine every element with child id 0 up to level 4, this creates level differences
+ * of more than one between face neighbors. */
+static int
+t8_test_leaf_face_neighbors_adapt (t8_forest_t forest, t8_forest_t forest_from, t8_locidx_t which_tree,
+                                   t8_locidx_t lelement_id, t8_eclass_scheme_c *ts, const int is_family,
+                                   const int num_elements, t8_element_t *elements[])
+{
+  return ts->t8_element_child_id (elements[0]) == 0 && ts->t8_element_level (elements[0]) < 4;
+}
+
+/* The element indices and dual faces of the face neighbors of a leaf, sorted by element index. */
+static std::vector<std::pair<t8_locidx_t, int>>
+t8_test_leaf_face_neighbors (t8_forest_t forest, t8_locidx_t itree, const t8_element_t *leaf, int face,
+                             int forest_is_balanced)
+{
+  t8_element_t **neighbor_leaves;
+  int *dual_faces;
+  int num_neighbors;
+  t8_locidx_t *element_indices;
+  t8_eclass_scheme_c *neigh_scheme;
+  std::vector<std::pair<t8_locidx_t, int>> neighbors;
+
+  t8_forest_leaf_face_neighbors (forest, itree, leaf, &neighbor_leaves, face, &dual_faces, &num_neighbors,
+                                 &element_indices, &neigh_scheme, forest_is_balanced);
+  for (int ineigh = 0; ineigh < num_neighbors; ineigh++) {
+    neighbors.push_back ({ element_indices[ineigh], dual_faces[ineigh] });
+  }
+  if (num_neighbors > 0) {
+    neigh_scheme->t8_element_destroy (num_neighbors, neighbor_leaves);
+    T8_FREE (element_indices);
+    T8_FREE (neighbor_leaves);
+    T8_FREE (dual_faces);
+  }
+  std::sort (neighbors.begin (), neighbors.end ());
+  return neighbors;
+}
+
+class forest_leaf_face_neighbors: public testing::TestWithParam<t8_eclass_t> {
+ protected:
+  void
+  SetUp () override
+  {
+    const t8_eclass_t eclass = GetParam ();
+    t8_cmesh_t cmesh = t8_cmesh_new_hypercube (eclass, sc_MPI_COMM_WORLD, 0, 0, 0);
+    t8_forest_t forest_uniform = t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), 1, 0, sc_MPI_COMM_WORLD);
+    t8_forest_t forest_adapt = t8_forest_new_adapt (forest_uniform, t8_test_leaf_face_neighbors_adapt, 1, 0, NULL);
+    /* The unbalanced forest, partitioned and with ghosts */
+    t8_forest_ref (forest_adapt);
+    t8_forest_init (&forest_unbalanced);
+    t8_forest_set_partition (forest_unbalanced, forest_adapt, 0);
+    t8_forest_set_ghost (forest_unbalanced, 1, T8_GHOST_FACES);
+    t8_forest_commit (forest_unbalanced);
+    /* The balanced forest */
+    t8_forest_init (&forest_balanced);
+    t8_forest_set_balance (forest_balanced, forest_adapt, 0);
+    t8_forest_set_ghost (forest_balanced, 1, T8_GHOST_FACES);
+    t8_forest_commit (forest_balanced);
+  }
+  void
+  TearDown () override
+  {
+    t8_forest_unref (&forest_unbalanced);
+    t8_forest_unref (&forest_balanced);
+  }
+  t8_forest_t forest_unbalanced;
+  t8_forest_t forest_balanced;
+};
+
+/* On a balanced forest both algorithms must find the same neighbors. */
+TEST_P (forest_leaf_face_neighbors, balanced_equals_unbalanced)
+{
+  for (t8_locidx_t itree = 0; itree < t8_forest_get_num_local_trees (forest_balanced); itree++) {
+    const t8_eclass_scheme_c *ts
+      = t8_forest_get_eclass_scheme (forest_balanced, t8_forest_get_tree_class (forest_balanced, itree));
+    for (t8_locidx_t ielement = 0; ielement < t8_forest_get_tree_num_elements (forest_balanced, itree); ielement++) {
+      const t8_element_t *leaf = t8_forest_get_element_in_tree (forest_balanced, itree, ielement);
+      for (int iface = 0; iface < ts->t8_element_num_faces (leaf); iface++) {
+        EXPECT_EQ (t8_test_leaf_face_neighbors (forest_balanced, itree, leaf, iface, 1),
+                   t8_test_leaf_face_neighbors (forest_balanced, itree, leaf, iface, 0));
+      }
+    }
+  }
+}
+
+/* If a local leaf B is a face neighbor of the local leaf A, then A is a face neighbor of B. */
+TEST_P (forest_leaf_face_neighbors, unbalanced_symmetric)
+{
+  const t8_locidx_t num_local_elements = t8_forest_get_local_num_elements (forest_unbalanced);
+  for (t8_locidx_t itree = 0, ielement = 0; itree < t8_forest_get_num_local_trees (forest_unbalanced); itree++) {
+    const t8_eclass_scheme_c *ts
+      = t8_forest_get_eclass_scheme (forest_unbalanced, t8_forest_get_tree_class (forest_unbalanced, itree));
+    for (t8_locidx_t ielem_tree = 0; ielem_tree < t8_forest_get_tree_num_elements (forest_unbalanced, itree);
+         ielem_tree++, ielement++) {
+      const t8_element_t *leaf = t8_forest_get_element_in_tree (forest_unbalanced, itree, ielem_tree);
+      for (int iface = 0; iface < ts->t8_element_num_faces (leaf); iface++) {
+        for (const auto &neighbor : t8_test_leaf_face_neighbors (forest_unbalanced, itree, leaf, iface, 0)) {
+          if (neighbor.first >= num_local_elements) {
+            /* We cannot check ghost neighbors */
+            continue;
+          }
+          t8_locidx_t neigh_tree;
+          const t8_element_t *neigh_leaf = t8_forest_get_element (forest_unbalanced, neighbor.first, &neigh_tree);
+          const auto back_neighbors
+            = t8_test_leaf_face_neighbors (forest_unbalanced, neigh_tree, neigh_leaf, neighbor.second, 0);
+          EXPECT_TRUE (std::find (back_neighbors.begin (), back_neighbors.end (), std::make_pair (ielement, iface))
+                       != back_neighbors.end ())
+            << "Element " << ielement << " is not a face neighbor of its face neighbor " << neighbor.first;
+        }
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_leaf_face_neighbors, forest_leaf_face_neighbors, AllEclasses, print_eclass);
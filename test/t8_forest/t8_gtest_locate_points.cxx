@@ -0,0 +1,156 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we locate the centroids of all leaves of a partitioned forest.
+ * Each process locates a share of the centroids of all processes and we check
+ * that the owning process, the element index and the reference coordinates are found. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_cmesh.h>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_forest/t8_forest_general.h>
+#include <t8_forest/t8_forest_geometrical.h>
+#include <t8_forest/t8_forest_point_location.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <test/t8_gtest_macros.hxx>
+
+#include <vector>
+
+class forest_locate_points: public testing::TestWithParam<t8_eclass_t> {
+ protected:
+  void
+  SetUp () override
+  {
+    const t8_eclass_t eclass = GetParam ();
+    t8_cmesh_t cmesh = t8_cmesh_new_hypercube (eclass, sc_MPI_COMM_WORLD, 0, 0, 0);
+    forest = t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), 2, 0, sc_MPI_COMM_WORLD);
+  }
+  void
+  TearDown () override
+  {
+    t8_forest_unref (&forest);
+  }
+  t8_forest_t forest;
+};
+
+/* Compute the centroids of all local leaves. */
+static std::vector<double>
+t8_test_locate_points_centroids (t8_forest_t forest)
+{
+  std::vector<double> centroids;
+  const t8_locidx_t num_local_trees = t8_forest_get_num_local_trees (forest);
+  for (t8_locidx_t itree = 0; itree < num_local_trees; itree++) {
+    const t8_locidx_t num_elements = t8_forest_get_tree_num_elements (forest, itree);
+    for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+      double centroid[3];
+      t8_forest_element_centroid (forest, itree, t8_forest_get_element_in_tree (forest, itree, ielement), centroid);
+      centroids.insert (centroids.end (), centroid, centroid + 3);
+    }
+  }
+  return centroids;
+}
+
+/* Locate the centroids of the own leaves and check the reference coordinates. */
+TEST_P (forest_locate_points, local_centroids)
+{
+  int mpirank;
+  int mpiret = sc_MPI_Comm_rank (sc_MPI_COMM_WORLD, &mpirank);
+  SC_CHECK_MPI (mpiret);
+
+  std::vector<double> centroids = t8_test_locate_points_centroids (forest);
+  const size_t num_points = centroids.size () / 3;
+  std::vector<t8_forest_point_location_t> locations (num_points);
+  t8_forest_locate_points (forest, centroids.data (), num_points, 1e-8, locations.data ());
+
+  for (size_t ipoint = 0; ipoint < num_points; ipoint++) {
+    ASSERT_EQ (locations[ipoint].rank, mpirank) << "Wrong process for point " << ipoint;
+    ASSERT_EQ (locations[ipoint].element_index, (t8_locidx_t) ipoint) << "Wrong element for point " << ipoint;
+    t8_locidx_t ltreeid;
+    const t8_element_t *element = t8_forest_get_element (forest, ipoint, &ltreeid);
+    double coords[3];
+    t8_forest_element_from_ref_coords (forest, ltreeid, element, locations[ipoint].ref_coords, 1, coords);
+    for (int i = 0; i < 3; i++) {
+      EXPECT_NEAR (coords[i], centroids[3 * ipoint + i], 1e-8);
+    }
+  }
+}
+
+/* Gather the centroids of all processes and let each process locate every mpisize-th of them. */
+TEST_P (forest_locate_points, remote_centroids)
+{
+  int mpirank, mpisize;
+  int mpiret = sc_MPI_Comm_rank (sc_MPI_COMM_WORLD, &mpirank);
+  SC_CHECK_MPI (mpiret);
+  mpiret = sc_MPI_Comm_size (sc_MPI_COMM_WORLD, &mpisize);
+  SC_CHECK_MPI (mpiret);
+
+  std::vector<double> local_centroids = t8_test_locate_points_centroids (forest);
+  int local_count = local_centroids.size ();
+  std::vector<int> counts (mpisize), displs (mpisize + 1, 0);
+  mpiret = sc_MPI_Allgather (&local_count, 1, sc_MPI_INT, counts.data (), 1, sc_MPI_INT, sc_MPI_COMM_WORLD);
+  SC_CHECK_MPI (mpiret);
+  for (int irank = 0; irank < mpisize; irank++) {
+    displs[irank + 1] = displs[irank] + counts[irank];
+  }
+  std::vector<double> centroids (displs[mpisize]);
+  mpiret = sc_MPI_Allgatherv (local_centroids.data (), local_count, sc_MPI_DOUBLE, centroids.data (), counts.data (),
+                              displs.data (), sc_MPI_DOUBLE, sc_MPI_COMM_WORLD);
+  SC_CHECK_MPI (mpiret);
+
+  /* Each process locates the centroids of the elements whose global id modulo mpisize is its rank. */
+  std::vector<double> points;
+  std::vector<int> expected_ranks;
+  std::vector<t8_locidx_t> expected_indices;
+  for (int irank = 0; irank < mpisize; irank++) {
+    for (int ielement = 0; ielement < counts[irank] / 3; ielement++) {
+      if ((displs[irank] / 3 + ielement) % mpisize == mpirank) {
+        points.insert (points.end (), centroids.begin () + displs[irank] + 3 * ielement,
+                       centroids.begin () + displs[irank] + 3 * ielement + 3);
+        expected_ranks.push_back (irank);
+        expected_indices.push_back (ielement);
+      }
+    }
+  }
+  const size_t num_points = expected_ranks.size ();
+  std::vector<t8_forest_point_location_t> locations (num_points);
+  t8_forest_locate_points (forest, points.data (), num_points, 1e-8, locations.data ());
+
+  for (size_t ipoint = 0; ipoint < num_points; ipoint++) {
+    EXPECT_EQ (locations[ipoint].rank, expected_ranks[ipoint]) << "Wrong process for point " << ipoint;
+    EXPECT_EQ (locations[ipoint].element_index, expected_indices[ipoint]) << "Wrong element for point " << ipoint;
+  }
+}
+
+/* Points outside of the domain are not found. */
+TEST_P (forest_locate_points, outside_points)
+{
+  const double points[6] = { -1, -1, -1, 2.5, 0.5, 0.5 };
+  t8_forest_point_location_t locations[2];
+  t8_forest_locate_points (forest, points, 2, 1e-8, locations);
+  for (int ipoint = 0; ipoint < 2; ipoint++) {
+    EXPECT_EQ (locations[ipoint].rank, -1);
+    EXPECT_EQ (locations[ipoint].element_index, -1);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_locate_points, forest_locate_points, AllEclasses, print_eclass);
@@ -0,0 +1,91 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we create a uniform forest once with one thread and once with
+ * multiple threads and check that the resulting forests are equal. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_cmesh.h>
+#include <t8_forest/t8_forest_general.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include "test/t8_cmesh_generator/t8_cmesh_example_sets.hxx"
+#include <test/t8_gtest_macros.hxx>
+
+class forest_new_uniform_threads: public testing::TestWithParam<cmesh_example_base *> {
+ protected:
+  void
+  SetUp () override
+  {
+    /* Construct a cmesh */
+    cmesh = GetParam ()->cmesh_create ();
+    if (t8_cmesh_is_empty (cmesh)) {
+      /* Empty cmeshes are not supported */
+      GTEST_SKIP ();
+    }
+  }
+  void
+  TearDown () override
+  {
+    t8_cmesh_destroy (&cmesh);
+  }
+  t8_cmesh_t cmesh;
+};
+
+TEST_P (forest_new_uniform_threads, test_new_uniform_threads)
+{
+  t8_scheme_cxx_t *scheme = t8_scheme_new_default_cxx ();
+
+  /* Compute the first level, such that no process is empty */
+  int min_level = t8_forest_min_nonempty_level (cmesh, scheme);
+  /* Use one level with empty processes */
+  min_level = SC_MAX (min_level - 1, 0);
+  for (int level = min_level; level < min_level + 3; level++) {
+    /* ref the cmesh and the scheme since we reuse them */
+    t8_cmesh_ref (cmesh);
+    t8_scheme_cxx_ref (scheme);
+    /* Create the elements with one thread */
+    t8_forest_t forest_serial = t8_forest_new_uniform (cmesh, scheme, level, 0, sc_MPI_COMM_WORLD);
+
+    /* Create the elements with multiple threads */
+    for (int num_threads = 2; num_threads <= 4; num_threads += 2) {
+      t8_forest_t forest_threads;
+      t8_cmesh_ref (cmesh);
+      t8_scheme_cxx_ref (scheme);
+      t8_forest_init (&forest_threads);
+      t8_forest_set_cmesh (forest_threads, cmesh, sc_MPI_COMM_WORLD);
+      t8_forest_set_scheme (forest_threads, scheme);
+      t8_forest_set_level (forest_threads, level);
+      t8_forest_set_num_threads (forest_threads, num_threads);
+      t8_forest_commit (forest_threads);
+
+      EXPECT_EQ (t8_forest_get_local_num_elements (forest_serial), t8_forest_get_local_num_elements (forest_threads));
+      EXPECT_TRUE (t8_forest_is_equal (forest_serial, forest_threads)) << "The forests are not equal";
+      t8_forest_unref (&forest_threads);
+    }
+    t8_forest_unref (&forest_serial);
+  }
+  t8_scheme_cxx_unref (&scheme);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_new_uniform_threads, forest_new_uniform_threads, AllCmeshsParam,
+                          pretty_print_base_example);
@@ -0,0 +1,174 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we partition an adapted forest with element weights.
+ * We check that the load is balanced up to the weight of one element, that equal
+ * weights lead to the same partition as the unweighted partition and that data
+ * can be partitioned along with the weighted forest. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_cmesh.h>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_forest/t8_forest_general.h>
+#include <t8_forest/t8_forest_partition.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <test/t8_gtest_macros.hxx>
+
+/* The maximum refinement level of the forest and thus the maximum weight of an element. */
+#define T8_TEST_PARTITION_WEIGHTS_MAXLEVEL 4
+
+/* Refine every element with child id 1 up to the maximum level. */
+static int
+t8_test_partition_weights_adapt (t8_forest_t forest, t8_forest_t forest_from, t8_locidx_t which_tree,
+                                 t8_locidx_t lelement_id, t8_eclass_scheme_c *ts, const int is_family,
+                                 const int num_elements, t8_element_t *elements[])
+{
+  return ts->t8_element_child_id (elements[0]) == 1
+         && ts->t8_element_level (elements[0]) < T8_TEST_PARTITION_WEIGHTS_MAXLEVEL;
+}
+
+/* Finer elements are more expensive, the weight of an element is its level. */
+static double
+t8_test_partition_weights_level (t8_forest_t forest_from, t8_locidx_t which_tree, const t8_element_t *element,
+                                 t8_locidx_t ielement)
+{
+  const t8_eclass_t tree_class = t8_forest_get_tree_class (forest_from, which_tree);
+  const t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest_from, tree_class);
+  return ts->t8_element_level (element);
+}
+
+/* Each element has the same weight. */
+static double
+t8_test_partition_weights_constant (t8_forest_t forest_from, t8_locidx_t which_tree, const t8_element_t *element,
+                                    t8_locidx_t ielement)
+{
+  return 2;
+}
+
+/* Sum up the weights of all local elements of a forest. */
+static double
+t8_test_partition_weights_local_weight (t8_forest_t forest)
+{
+  double local_weight = 0;
+  for (t8_locidx_t itree = 0, ielement = 0; itree < t8_forest_get_num_local_trees (forest); itree++) {
+    for (t8_locidx_t ielem_in_tree = 0; ielem_in_tree < t8_forest_get_tree_num_elements (forest, itree);
+         ielem_in_tree++, ielement++) {
+      const t8_element_t *element = t8_forest_get_element_in_tree (forest, itree, ielem_in_tree);
+      local_weight += t8_test_partition_weights_level (forest, itree, element, ielement);
+    }
+  }
+  return local_weight;
+}
+
+class forest_partition_weights: public testing::TestWithParam<t8_eclass_t> {
+ protected:
+  void
+  SetUp () override
+  {
+    eclass = GetParam ();
+    t8_cmesh_t cmesh = t8_cmesh_new_hypercube (eclass, sc_MPI_COMM_WORLD, 0, 0, 0);
+    t8_forest_t forest_uniform = t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), 1, 0, sc_MPI_COMM_WORLD);
+    forest = t8_forest_new_adapt (forest_uniform, t8_test_partition_weights_adapt, 1, 0, NULL);
+  }
+  void
+  TearDown () override
+  {
+    t8_forest_unref (&forest);
+  }
+
+  /* Partition the forest with the given weight function. */
+  t8_forest_t
+  partition_forest (t8_forest_partition_weight_t weight_fn)
+  {
+    t8_forest_t forest_partition;
+    t8_forest_ref (forest);
+    t8_forest_init (&forest_partition);
+    t8_forest_set_partition (forest_partition, forest, 0);
+    t8_forest_set_partition_weight_function (forest_partition, weight_fn);
+    t8_forest_commit (forest_partition);
+    return forest_partition;
+  }
+
+  t8_eclass_t eclass;
+  t8_forest_t forest;
+};
+
+/* The load of each process may only differ from the mean load by the weight of one element. */
+TEST_P (forest_partition_weights, balanced_load)
+{
+  t8_forest_t forest_partition = partition_forest (t8_test_partition_weights_level);
+  ASSERT_EQ (t8_forest_get_global_num_elements (forest), t8_forest_get_global_num_elements (forest_partition));
+
+  double local_weight = t8_test_partition_weights_local_weight (forest_partition);
+  double global_weight;
+  int mpisize;
+  int mpiret = sc_MPI_Allreduce (&local_weight, &global_weight, 1, sc_MPI_DOUBLE, sc_MPI_SUM, sc_MPI_COMM_WORLD);
+  SC_CHECK_MPI (mpiret);
+  mpiret = sc_MPI_Comm_size (sc_MPI_COMM_WORLD, &mpisize);
+  SC_CHECK_MPI (mpiret);
+  EXPECT_NEAR (local_weight, global_weight / mpisize, T8_TEST_PARTITION_WEIGHTS_MAXLEVEL);
+
+  t8_forest_unref (&forest_partition);
+}
+
+/* With equal weights we must obtain the same partition as without weights. */
+TEST_P (forest_partition_weights, equal_weights)
+{
+  t8_forest_t forest_weighted = partition_forest (t8_test_partition_weights_constant);
+  t8_forest_t forest_unweighted = partition_forest (NULL);
+
+  EXPECT_EQ (t8_forest_get_local_num_elements (forest_weighted), t8_forest_get_local_num_elements (forest_unweighted));
+  EXPECT_EQ (t8_forest_get_first_local_element_id (forest_weighted),
+             t8_forest_get_first_local_element_id (forest_unweighted));
+  EXPECT_TRUE (t8_forest_is_equal (forest_weighted, forest_unweighted));
+
+  t8_forest_unref (&forest_weighted);
+  t8_forest_unref (&forest_unweighted);
+}
+
+/* Element data is sent to the processes of the weighted partition. */
+TEST_P (forest_partition_weights, partition_data)
+{
+  t8_forest_t forest_partition = partition_forest (t8_test_partition_weights_level);
+
+  /* Store the global element index of each element as data */
+  const t8_locidx_t num_elements_from = t8_forest_get_local_num_elements (forest);
+  const t8_gloidx_t first_element_from = t8_forest_get_first_local_element_id (forest);
+  sc_array_t *data_in = sc_array_new_count (sizeof (t8_gloidx_t), num_elements_from);
+  for (t8_locidx_t ielement = 0; ielement < num_elements_from; ielement++) {
+    *(t8_gloidx_t *) sc_array_index_int (data_in, ielement) = first_element_from + ielement;
+  }
+  const t8_locidx_t num_elements_to = t8_forest_get_local_num_elements (forest_partition);
+  sc_array_t *data_out = sc_array_new_count (sizeof (t8_gloidx_t), num_elements_to);
+  t8_forest_partition_data (forest, forest_partition, data_in, data_out);
+
+  const t8_gloidx_t first_element_to = t8_forest_get_first_local_element_id (forest_partition);
+  for (t8_locidx_t ielement = 0; ielement < num_elements_to; ielement++) {
+    EXPECT_EQ (first_element_to + ielement, *(t8_gloidx_t *) sc_array_index_int (data_out, ielement));
+  }
+  sc_array_destroy (data_in);
+  sc_array_destroy (data_out);
+  t8_forest_unref (&forest_partition);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_partition_weights, forest_partition_weights, AllEclasses, print_eclass);
@@ -30,6 +30,8 @@
 #include <t8_schemes/t8_default/t8_default_cxx.hxx>
 #include <test/t8_gtest_macros.hxx>
 
+#include <vector>
+
 class forest_search: public testing::TestWithParam<std::tuple<t8_eclass, int>> {
  protected:
   void
@@ -155,4 +157,62 @@ TEST_P (forest_search, test_search_one_query_matches_all)
   sc_array_reset (&queries);
 }
 
+/* A query callback that matches all elements with all queries.
+ * This function assumes that the forest user pointer is an std::vector<int>
+ * with one int for each pair of query and local leaf.
+ * If this function is called for a leaf, it sets the corresponding entries to 1.
+ */
+static int
+t8_test_search_query_threads_fn (t8_forest_t forest, t8_locidx_t ltreeid, const t8_element_t *element,
+                                 const int is_leaf, const t8_element_array_t *leaf_elements,
+                                 const t8_locidx_t tree_leaf_index, void *queries, sc_array_t *query_indices,
+                                 int *query_matches, const size_t num_active_queries)
+{
+  std::vector<int> *matched = (std::vector<int> *) t8_forest_get_user_data (forest);
+  const t8_locidx_t num_elements = t8_forest_get_local_num_elements (forest);
+  for (size_t iactive = 0; iactive < num_active_queries; iactive++) {
+    const size_t iquery = *(size_t *) sc_array_index (query_indices, iactive);
+    if (is_leaf) {
+      const t8_locidx_t ielement = t8_forest_get_tree_element_offset (forest, ltreeid) + tree_leaf_index;
+      (*matched)[iquery * num_elements + ielement] = 1;
+    }
+    query_matches[iactive] = 1;
+  }
+  return 1;
+}
+
+static int
+t8_test_search_threads_fn (t8_forest_t forest, const t8_locidx_t ltreeid, const t8_element_t *element,
+                           const int is_leaf, const t8_element_array_t *leaf_elements,
+                           const t8_locidx_t tree_leaf_index, void *queries, sc_array_t *query_indices,
+                           int *query_matches, const size_t num_active_queries)
+{
+  return 1;
+}
+
+TEST_P (forest_search, test_search_threads_match_all)
+{
+  const size_t num_queries = 7;
+  sc_array_t queries;
+  sc_array_init_size (&queries, sizeof (int), num_queries);
+
+  const t8_locidx_t num_elements = t8_forest_get_local_num_elements (forest);
+  /* One flag for each pair of query and leaf. The queries of different threads
+   * write to different flags. */
+  std::vector<int> matched (num_queries * num_elements, 0);
+  t8_forest_set_user_data (forest, &matched);
+
+  t8_forest_search_ext (forest, t8_test_search_threads_fn, t8_test_search_query_threads_fn, &queries, 4);
+
+  for (size_t iquery = 0; iquery < num_queries; iquery++) {
+    for (t8_locidx_t ielement = 0; ielement < num_elements; ++ielement) {
+      ASSERT_TRUE (matched[iquery * num_elements + ielement])
+        << "Search did not match all leaves. First mismatch for query " << iquery << " at leaf " << ielement;
+    }
+  }
+
+  t8_forest_unref (&forest);
+  sc_array_reset (&queries);
+}
+
 INSTANTIATE_TEST_SUITE_P (t8_gtest_search, forest_search, testing::Combine (AllEclasses, testing::Range (0, 6)));
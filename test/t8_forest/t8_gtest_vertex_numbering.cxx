@@ -0,0 +1,183 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we compute the global vertex numbering of uniform and adapted forests.
+ * We check the number of vertices and of hanging vertices and that all processes
+ * agree on the position of each global vertex. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_cmesh.h>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_forest/t8_forest_general.h>
+#include <t8_forest/t8_forest_geometrical.h>
+#include <t8_forest/t8_forest_vertex_numbering.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <set>
+#include <vector>
+
+/* Check that the corners of the local leaves lie at their vertices, that the global ids are
+ * consistent with the ownership, and that all processes agree on the coordinates of each global id. */
+static void
+t8_test_vertex_numbering_consistency (t8_forest_t forest, const t8_forest_vertex_numbering_t *numbering)
+{
+  int mpirank, mpiret;
+  mpiret = sc_MPI_Comm_rank (sc_MPI_COMM_WORLD, &mpirank);
+  SC_CHECK_MPI (mpiret);
+  ASSERT_EQ (t8_forest_get_local_num_elements (forest), numbering->num_elements);
+
+  /* Each vertex is owned by exactly one process */
+  const t8_gloidx_t num_owned = numbering->num_owned_vertices;
+  t8_gloidx_t global_num_owned;
+  mpiret = sc_MPI_Allreduce ((void *) &num_owned, &global_num_owned, 1, T8_MPI_GLOIDX, sc_MPI_SUM, sc_MPI_COMM_WORLD);
+  SC_CHECK_MPI (mpiret);
+  EXPECT_EQ (global_num_owned, numbering->global_num_vertices);
+
+  /* Each process adds the coordinates of its owned vertices at their global ids */
+  const size_t num_global_coords = 3 * numbering->global_num_vertices;
+  std::vector<double> owned_coords (num_global_coords, 0), global_coords (num_global_coords);
+  std::set<t8_gloidx_t> global_ids;
+  for (t8_locidx_t ivertex = 0; ivertex < numbering->num_local_vertices; ivertex++) {
+    const t8_gloidx_t global_id = numbering->global_ids[ivertex];
+    ASSERT_TRUE (0 <= global_id && global_id < numbering->global_num_vertices);
+    EXPECT_TRUE (global_ids.insert (global_id).second) << "Two local vertices have the same global id";
+    if (ivertex < numbering->num_owned_vertices) {
+      EXPECT_EQ (numbering->first_owned_vertex + ivertex, global_id);
+      EXPECT_EQ (mpirank, numbering->owners[ivertex]);
+      for (int icoord = 0; icoord < 3; icoord++) {
+        owned_coords[3 * global_id + icoord] = numbering->coordinates[3 * ivertex + icoord];
+      }
+    }
+    else {
+      /* The owner is the lowest process with this vertex */
+      EXPECT_LT (numbering->owners[ivertex], mpirank);
+    }
+  }
+  mpiret = sc_MPI_Allreduce (owned_coords.data (), global_coords.data (), num_global_coords, sc_MPI_DOUBLE, sc_MPI_SUM,
+                             sc_MPI_COMM_WORLD);
+  SC_CHECK_MPI (mpiret);
+  for (t8_locidx_t ivertex = 0; ivertex < numbering->num_local_vertices; ivertex++) {
+    const t8_gloidx_t global_id = numbering->global_ids[ivertex];
+    for (int icoord = 0; icoord < 3; icoord++) {
+      EXPECT_NEAR (global_coords[3 * global_id + icoord], numbering->coordinates[3 * ivertex + icoord], 1e-12);
+    }
+  }
+
+  /* The corners of the leaves lie at their vertices */
+  for (t8_locidx_t itree = 0, ielement = 0; itree < t8_forest_get_num_local_trees (forest); itree++) {
+    const t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, t8_forest_get_tree_class (forest, itree));
+    for (t8_locidx_t ielem_tree = 0; ielem_tree < t8_forest_get_tree_num_elements (forest, itree);
+         ielem_tree++, ielement++) {
+      const t8_element_t *leaf = t8_forest_get_element_in_tree (forest, itree, ielem_tree);
+      const int num_corners = ts->t8_element_num_corners (leaf);
+      ASSERT_EQ (num_corners, numbering->element_offsets[ielement + 1] - numbering->element_offsets[ielement]);
+      for (int icorner = 0; icorner < num_corners; icorner++) {
+        double corner_coords[3];
+        t8_forest_element_coordinate (forest, itree, leaf, icorner, corner_coords);
+        const t8_locidx_t ivertex = numbering->element_vertices[numbering->element_offsets[ielement] + icorner];
+        ASSERT_TRUE (0 <= ivertex && ivertex < numbering->num_local_vertices);
+        for (int icoord = 0; icoord < 3; icoord++) {
+          EXPECT_NEAR (corner_coords[icoord], numbering->coordinates[3 * ivertex + icoord], 1e-12);
+        }
+      }
+    }
+  }
+}
+
+/* Count the hanging vertices on all processes. */
+static t8_gloidx_t
+t8_test_vertex_numbering_num_hanging (const t8_forest_vertex_numbering_t *numbering)
+{
+  t8_gloidx_t num_hanging = 0, global_num_hanging;
+  for (t8_locidx_t ivertex = 0; ivertex < numbering->num_owned_vertices; ivertex++) {
+    num_hanging += numbering->is_hanging[ivertex] != 0;
+  }
+  const int mpiret
+    = sc_MPI_Allreduce (&num_hanging, &global_num_hanging, 1, T8_MPI_GLOIDX, sc_MPI_SUM, sc_MPI_COMM_WORLD);
+  SC_CHECK_MPI (mpiret);
+  return global_num_hanging;
+}
+
+class forest_vertex_numbering: public testing::TestWithParam<t8_eclass_t> {
+};
+
+/* The vertices of a uniformly refined hypercube are the points of a regular grid. */
+TEST_P (forest_vertex_numbering, uniform_hypercube)
+{
+  const t8_eclass_t eclass = GetParam ();
+  const int level = 2;
+  t8_cmesh_t cmesh = t8_cmesh_new_hypercube (eclass, sc_MPI_COMM_WORLD, 0, 0, 0);
+  t8_forest_t forest = t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), level, 0, sc_MPI_COMM_WORLD);
+  t8_forest_vertex_numbering_t *numbering = t8_forest_vertex_numbering_new (forest, 1);
+
+  t8_gloidx_t num_grid_points = 1;
+  for (int idim = 0; idim < t8_eclass_to_dimension[eclass]; idim++) {
+    num_grid_points *= (1 << level) + 1;
+  }
+  EXPECT_EQ (num_grid_points, numbering->global_num_vertices);
+  t8_test_vertex_numbering_consistency (forest, numbering);
+  EXPECT_EQ (0, t8_test_vertex_numbering_num_hanging (numbering));
+
+  t8_forest_vertex_numbering_destroy (&numbering);
+  EXPECT_TRUE (numbering == NULL);
+  t8_forest_unref (&forest);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_vertex_numbering, forest_vertex_numbering,
+                          testing::Values (T8_ECLASS_LINE, T8_ECLASS_QUAD, T8_ECLASS_TRIANGLE, T8_ECLASS_HEX,
+                                           T8_ECLASS_TET, T8_ECLASS_PRISM));
+
+/* Refine the first leaf of a uniform level 1 forest. */
+static int
+t8_test_vertex_numbering_adapt (t8_forest_t forest, t8_forest_t forest_from, t8_locidx_t which_tree,
+                                t8_locidx_t lelement_id, t8_eclass_scheme_c *ts, const int is_family,
+                                const int num_elements, t8_element_t *elements[])
+{
+  return ts->t8_element_level (elements[0]) == 1 && ts->t8_element_child_id (elements[0]) == 0;
+}
+
+/* The parameters are the element class, the number of vertices and the number of hanging vertices
+ * of the unit hypercube, refined uniformly to level 1 and then once more in the corner at the origin. */
+class forest_vertex_numbering_hanging: public testing::TestWithParam<std::tuple<t8_eclass_t, int, int>> {
+};
+
+TEST_P (forest_vertex_numbering_hanging, refined_corner)
+{
+  const t8_eclass_t eclass = std::get<0> (GetParam ());
+  t8_cmesh_t cmesh = t8_cmesh_new_hypercube (eclass, sc_MPI_COMM_WORLD, 0, 0, 0);
+  t8_forest_t forest = t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), 1, 0, sc_MPI_COMM_WORLD);
+  forest = t8_forest_new_adapt (forest, t8_test_vertex_numbering_adapt, 0, 0, NULL);
+  t8_forest_vertex_numbering_t *numbering = t8_forest_vertex_numbering_new (forest, 1);
+
+  EXPECT_EQ (std::get<1> (GetParam ()), numbering->global_num_vertices);
+  t8_test_vertex_numbering_consistency (forest, numbering);
+  EXPECT_EQ (std::get<2> (GetParam ()), t8_test_vertex_numbering_num_hanging (numbering));
+
+  t8_forest_vertex_numbering_destroy (&numbering);
+  t8_forest_unref (&forest);
+}
+
+/* A quad has 2 hanging vertices on the edges to its unrefined neighbors, a hex has 12
+ * on the faces to its unrefined neighbors: 3 face centers and 9 edge midpoints. */
+INSTANTIATE_TEST_SUITE_P (t8_gtest_vertex_numbering, forest_vertex_numbering_hanging,
+                          testing::Values (std::make_tuple (T8_ECLASS_QUAD, 14, 2),
+                                           std::make_tuple (T8_ECLASS_HEX, 46, 12)));
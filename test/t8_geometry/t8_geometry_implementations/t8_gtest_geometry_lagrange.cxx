@@ -36,10 +36,12 @@ along with t8code; if not, write to the Free Software Foundation, Inc.,
 #include <t8_vec.h>
 #include <t8_element_cxx.hxx>
 #include <t8_cmesh.h>
+#include <t8_cmesh.hxx>
 #include <t8_cmesh_vtk_writer.h>
 #include <t8_schemes/t8_default/t8_default_cxx.hxx>
 #include <t8_forest/t8_forest.h>
 #include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_geometry/t8_geometry.h>
 #include <t8_geometry/t8_geometry_implementations/t8_geometry_lagrange.hxx>
 
 /**
@@ -111,6 +113,13 @@ sample (t8_eclass_t eclass, uint32_t n_point)
       pt[2] = 0;
     }
     break;
+  case T8_ECLASS_TRIANGLE:
+    for (auto &pt : points) {
+      pt[0] = random_number ();
+      pt[1] = random_number () * pt[0];
+      pt[2] = 0;
+    }
+    break;
   case T8_ECLASS_QUAD:
     for (auto &pt : points) {
       pt[0] = random_number ();
@@ -240,6 +249,79 @@ TEST_P (LagrangeCmesh, lagrange_mapping)
   }
 }
 
+/**
+ * Check that a batch of points is mapped as each point on its own and
+ * compare the Jacobian with central finite differences of the mapping.
+ */
+TEST_P (LagrangeCmesh, batched_evaluation_and_jacobian)
+{
+  const t8_lagrange_element lag = create_sample_element (eclass, degree);
+  const int dim = t8_eclass_to_dimension[eclass];
+  uint32_t num_nodes = 1;
+  for (int i_dim = 0; i_dim < dim; ++i_dim)
+    num_nodes *= degree + 1;
+  if (eclass == T8_ECLASS_TRIANGLE)
+    num_nodes = (degree + 1) * (degree + 2) / 2;
+  std::vector<double> vertices;
+  for (uint32_t i_node = 0; i_node < num_nodes; ++i_node) {
+    const std::vector<double> node = lag.get_node_coords (i_node);
+    vertices.insert (vertices.end (), node.begin (), node.end ());
+  }
+
+  t8_cmesh_t cmesh;
+  t8_cmesh_init (&cmesh);
+  t8_cmesh_set_attribute (cmesh, 0, t8_get_package_id (), T8_CMESH_LAGRANGE_POLY_DEGREE, &degree, sizeof (int), 1);
+  t8_cmesh_register_geometry<t8_geometry_lagrange> (cmesh, dim);
+  t8_cmesh_set_tree_class (cmesh, 0, eclass);
+  t8_cmesh_set_tree_vertices (cmesh, 0, vertices.data (), num_nodes);
+  t8_cmesh_commit (cmesh, sc_MPI_COMM_WORLD);
+
+  /* The reference coordinates of a batch have \a dim entries per point. */
+  const auto points = sample (eclass, T8_NUM_SAMPLE_POINTS);
+  const size_t num_points = points.size ();
+  std::vector<double> ref_coords (num_points * dim);
+  for (size_t i_point = 0; i_point < num_points; ++i_point)
+    for (int i_dim = 0; i_dim < dim; ++i_dim)
+      ref_coords[i_point * dim + i_dim] = points[i_point][i_dim];
+  std::vector<double> mapped (num_points * T8_ECLASS_MAX_DIM);
+  std::vector<double> jacobian (num_points * dim * T8_ECLASS_MAX_DIM);
+  t8_geometry_evaluate (cmesh, 0, ref_coords.data (), num_points, mapped.data ());
+  t8_geometry_jacobian (cmesh, 0, ref_coords.data (), num_points, jacobian.data ());
+
+  /* The re-entrant evaluation with a tree cache gives the same results. */
+  std::vector<double> mapped_threadsafe (num_points * T8_ECLASS_MAX_DIM);
+  std::vector<double> jacobian_threadsafe (num_points * dim * T8_ECLASS_MAX_DIM);
+  t8_geometry_tree_cache_t cache;
+  t8_geometry_tree_cache_init (&cache);
+  t8_geometry_evaluate_threadsafe (cmesh, 0, ref_coords.data (), num_points, mapped_threadsafe.data (), &cache);
+  t8_geometry_jacobian_threadsafe (cmesh, 0, ref_coords.data (), num_points, jacobian_threadsafe.data (), &cache);
+  EXPECT_EQ (mapped, mapped_threadsafe);
+  EXPECT_EQ (jacobian, jacobian_threadsafe);
+
+  const double h = 1e-6;
+  for (size_t i_point = 0; i_point < num_points; ++i_point) {
+    std::array<double, T8_ECLASS_MAX_DIM> single;
+    t8_geometry_evaluate (cmesh, 0, ref_coords.data () + i_point * dim, 1, single.data ());
+    for (int i_component = 0; i_component < T8_ECLASS_MAX_DIM; ++i_component)
+      EXPECT_NEAR (single[i_component], mapped[i_point * T8_ECLASS_MAX_DIM + i_component], T8_PRECISION_EPS);
+    for (int i_dim = 0; i_dim < dim; ++i_dim) {
+      std::array<double, T8_ECLASS_MAX_DIM> plus = points[i_point];
+      std::array<double, T8_ECLASS_MAX_DIM> minus = points[i_point];
+      plus[i_dim] += h;
+      minus[i_dim] -= h;
+      std::array<double, T8_ECLASS_MAX_DIM> mapped_plus, mapped_minus;
+      t8_geometry_evaluate (cmesh, 0, plus.data (), 1, mapped_plus.data ());
+      t8_geometry_evaluate (cmesh, 0, minus.data (), 1, mapped_minus.data ());
+      for (int i_component = 0; i_component < T8_ECLASS_MAX_DIM; ++i_component) {
+        const double finite_difference = (mapped_plus[i_component] - mapped_minus[i_component]) / (2 * h);
+        const double derivative = jacobian[(i_point * dim + i_dim) * T8_ECLASS_MAX_DIM + i_component];
+        EXPECT_NEAR (finite_difference, derivative, T8_PRECISION_SQRT_EPS);
+      }
+    }
+  }
+  t8_cmesh_destroy (&cmesh);
+}
+
 /* clang-format off */
 INSTANTIATE_TEST_SUITE_P (t8_gtest_geometry_lagrange, LagrangeCmesh,
   testing::Combine (AllEclasses, testing::Range (1, T8_GEOMETRY_MAX_POLYNOMIAL_DEGREE + 1)),
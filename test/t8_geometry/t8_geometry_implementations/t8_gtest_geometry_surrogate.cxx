@@ -0,0 +1,155 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/** \file t8_gtest_geometry_surrogate.cxx
+ * Compare the polynomial surrogates of the spherical example geometries
+ * with the exact geometries.
+ */
+
+#include <gtest/gtest.h>
+#include <t8_cmesh.h>
+#include <t8_cmesh.hxx>
+#include <t8_vec.h>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_geometry/t8_geometry.h>
+#include <t8_geometry/t8_geometry_implementations/t8_geometry_examples.hxx>
+#include <t8_geometry/t8_geometry_implementations/t8_geometry_surrogate.hxx>
+
+#define T8_SURROGATE_NUM_POINTS 50
+
+/* The parameters are whether the trees are the hexes of a spherical shell
+ * instead of the quads of a spherical surface, and the tolerance of the surrogates. */
+class geometry_surrogate: public testing::TestWithParam<std::tuple<int, double>> {
+ protected:
+  void
+  SetUp () override
+  {
+    const int shell = std::get<0> (GetParam ());
+    tolerance = std::get<1> (GetParam ());
+    /* The exact cmesh uses the example geometries. */
+    if (shell) {
+      cmesh_exact = t8_cmesh_new_cubed_spherical_shell (1.0, 0.5, 0, 1, sc_MPI_COMM_WORLD);
+    }
+    else {
+      cmesh_exact = t8_cmesh_new_quadrangulated_spherical_surface (1.0, sc_MPI_COMM_WORLD);
+    }
+    /* The same trees, mapped with the surrogate of the example geometry. */
+    t8_cmesh_init (&cmesh);
+    if (shell) {
+      surrogate = t8_cmesh_register_geometry<t8_geometry_surrogate> (
+        cmesh, std::make_unique<t8_geometry_cubed_spherical_shell> (), tolerance);
+    }
+    else {
+      surrogate = t8_cmesh_register_geometry<t8_geometry_surrogate> (
+        cmesh, std::make_unique<t8_geometry_quadrangulated_spherical_surface> (), tolerance);
+    }
+    const t8_locidx_t num_trees = t8_cmesh_get_num_local_trees (cmesh_exact);
+    for (t8_locidx_t itree = 0; itree < num_trees; itree++) {
+      const t8_eclass_t eclass = t8_cmesh_get_tree_class (cmesh_exact, itree);
+      t8_cmesh_set_tree_class (cmesh, itree, eclass);
+      t8_cmesh_set_tree_vertices (cmesh, itree, t8_cmesh_get_tree_vertices (cmesh_exact, itree),
+                                  t8_eclass_num_vertices[eclass]);
+    }
+    t8_cmesh_commit (cmesh, sc_MPI_COMM_WORLD);
+  }
+
+  void
+  TearDown () override
+  {
+    t8_cmesh_destroy (&cmesh);
+    t8_cmesh_destroy (&cmesh_exact);
+  }
+
+  t8_cmesh_t cmesh;
+  t8_cmesh_t cmesh_exact;
+  t8_geometry_surrogate *surrogate;
+  double tolerance;
+};
+
+TEST_P (geometry_surrogate, compare_with_exact_geometry)
+{
+  std::srand (0);
+  const t8_locidx_t num_trees = t8_cmesh_get_num_local_trees (cmesh);
+  for (t8_locidx_t itree = 0; itree < num_trees; itree++) {
+    const int dim = t8_eclass_to_dimension[t8_cmesh_get_tree_class (cmesh, itree)];
+    for (int ipoint = 0; ipoint < T8_SURROGATE_NUM_POINTS; ipoint++) {
+      /* The example geometries read 3 reference coordinates. */
+      double ref_coords[3] = { 0, 0, 0 };
+      for (int idim = 0; idim < dim; idim++) {
+        ref_coords[idim] = static_cast<double> (std::rand ()) / RAND_MAX;
+      }
+      double exact_coords[3], surrogate_coords[3];
+      t8_geometry_evaluate (cmesh_exact, itree, ref_coords, 1, exact_coords);
+      t8_geometry_evaluate (cmesh, itree, ref_coords, 1, surrogate_coords);
+      EXPECT_LE (t8_vec_dist (exact_coords, surrogate_coords), tolerance);
+
+      /* The jacobian of the surrogate approximates the one of the exact mapping. */
+      double jacobian[3 * 3];
+      t8_geometry_jacobian (cmesh, itree, ref_coords, 1, jacobian);
+      const double h = 1e-6;
+      for (int idim = 0; idim < dim; idim++) {
+        double plus[3] = { ref_coords[0], ref_coords[1], ref_coords[2] };
+        double minus[3] = { ref_coords[0], ref_coords[1], ref_coords[2] };
+        plus[idim] += h;
+        minus[idim] -= h;
+        double mapped_plus[3], mapped_minus[3];
+        t8_geometry_evaluate (cmesh_exact, itree, plus, 1, mapped_plus);
+        t8_geometry_evaluate (cmesh_exact, itree, minus, 1, mapped_minus);
+        for (int icomp = 0; icomp < 3; icomp++) {
+          const double finite_difference = (mapped_plus[icomp] - mapped_minus[icomp]) / (2 * h);
+          EXPECT_NEAR (jacobian[3 * idim + icomp], finite_difference, 100 * tolerance + 1e-6);
+        }
+      }
+    }
+    /* The tree is active in the surrogate geometry. */
+    EXPECT_GT (surrogate->t8_geom_get_active_surrogate_degree (), 0);
+  }
+}
+
+/* Without a degree that is accurate enough the exact geometry is used. */
+TEST (geometry_surrogate_fallback, uses_exact_geometry)
+{
+  t8_cmesh_t cmesh_exact = t8_cmesh_new_quadrangulated_spherical_surface (1.0, sc_MPI_COMM_WORLD);
+  t8_cmesh_t cmesh;
+  t8_cmesh_init (&cmesh);
+  t8_geometry_surrogate *surrogate = t8_cmesh_register_geometry<t8_geometry_surrogate> (
+    cmesh, std::make_unique<t8_geometry_quadrangulated_spherical_surface> (), 1e-12, 2);
+  for (t8_locidx_t itree = 0; itree < t8_cmesh_get_num_local_trees (cmesh_exact); itree++) {
+    t8_cmesh_set_tree_class (cmesh, itree, T8_ECLASS_QUAD);
+    t8_cmesh_set_tree_vertices (cmesh, itree, t8_cmesh_get_tree_vertices (cmesh_exact, itree), 4);
+  }
+  t8_cmesh_commit (cmesh, sc_MPI_COMM_WORLD);
+
+  const double ref_coords[3] = { 0.3, 0.6, 0 };
+  double exact_coords[3], surrogate_coords[3];
+  t8_geometry_evaluate (cmesh_exact, 0, ref_coords, 1, exact_coords);
+  t8_geometry_evaluate (cmesh, 0, ref_coords, 1, surrogate_coords);
+  EXPECT_EQ (surrogate->t8_geom_get_active_surrogate_degree (), 0);
+  for (int icomp = 0; icomp < 3; icomp++) {
+    EXPECT_EQ (exact_coords[icomp], surrogate_coords[icomp]);
+  }
+  t8_cmesh_destroy (&cmesh);
+  t8_cmesh_destroy (&cmesh_exact);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_geometry_surrogate, geometry_surrogate,
+                          testing::Combine (testing::Values (0, 1), testing::Values (1e-3, 1e-6)));
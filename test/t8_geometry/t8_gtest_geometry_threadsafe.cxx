@@ -0,0 +1,133 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2024 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we compute element geometry from multiple threads concurrently
+ * and check that the results match the serial computation. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_forest/t8_forest_general.h>
+#include <t8_forest/t8_forest_geometrical.h>
+#include <t8_geometry/t8_geometry.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <test/t8_gtest_macros.hxx>
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+#define T8_TEST_GEOMETRY_THREADSAFE_NUM_THREADS 4
+
+class geometry_threadsafe: public testing::TestWithParam<t8_eclass_t> {
+ protected:
+  void
+  SetUp () override
+  {
+    eclass = GetParam ();
+    t8_cmesh_t cmesh = t8_cmesh_new_hypercube (eclass, sc_MPI_COMM_WORLD, 0, 0, 0);
+    forest = t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), 3, 0, sc_MPI_COMM_WORLD);
+  }
+  void
+  TearDown () override
+  {
+    t8_forest_unref (&forest);
+  }
+  t8_forest_t forest;
+  t8_eclass_t eclass;
+};
+
+/* Compute the centroid and the volume of all local elements with index ielement % num_threads == ithread. */
+static void
+t8_test_geometry_threadsafe_compute (t8_forest_t forest, const int ithread, const int num_threads,
+                                     std::vector<double> &centroids, std::vector<double> &volumes)
+{
+  t8_locidx_t ielement = 0;
+  const t8_locidx_t num_local_trees = t8_forest_get_num_local_trees (forest);
+  for (t8_locidx_t itree = 0; itree < num_local_trees; itree++) {
+    const t8_locidx_t num_elements = t8_forest_get_tree_num_elements (forest, itree);
+    for (t8_locidx_t ielem_tree = 0; ielem_tree < num_elements; ielem_tree++, ielement++) {
+      if (ielement % num_threads != ithread) {
+        continue;
+      }
+      const t8_element_t *element = t8_forest_get_element_in_tree (forest, itree, ielem_tree);
+      t8_forest_element_centroid (forest, itree, element, &centroids[3 * ielement]);
+      volumes[ielement] = t8_forest_element_volume (forest, itree, element);
+    }
+  }
+}
+
+TEST_P (geometry_threadsafe, element_geometry_concurrent)
+{
+  const t8_locidx_t num_elements = t8_forest_get_local_num_elements (forest);
+  std::vector<double> centroids_serial (3 * num_elements), volumes_serial (num_elements);
+  std::vector<double> centroids_threads (3 * num_elements), volumes_threads (num_elements);
+
+  t8_test_geometry_threadsafe_compute (forest, 0, 1, centroids_serial, volumes_serial);
+
+  std::vector<std::thread> threads;
+  for (int ithread = 0; ithread < T8_TEST_GEOMETRY_THREADSAFE_NUM_THREADS; ithread++) {
+    threads.emplace_back (t8_test_geometry_threadsafe_compute, forest, ithread,
+                          T8_TEST_GEOMETRY_THREADSAFE_NUM_THREADS, std::ref (centroids_threads),
+                          std::ref (volumes_threads));
+  }
+  for (auto &thread : threads) {
+    thread.join ();
+  }
+
+  for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+    for (int dim = 0; dim < 3; dim++) {
+      EXPECT_EQ (centroids_serial[3 * ielement + dim], centroids_threads[3 * ielement + dim]);
+    }
+    EXPECT_EQ (volumes_serial[ielement], volumes_threads[ielement]);
+  }
+}
+
+TEST_P (geometry_threadsafe, evaluate_matches_stateful)
+{
+  /* Evaluate the tree corners with the stateful and the thread-safe evaluation and compare. */
+  t8_cmesh_t cmesh = t8_forest_get_cmesh (forest);
+  const int num_corners = t8_eclass_num_vertices[eclass];
+  const int dim = t8_eclass_to_dimension[eclass];
+  t8_geometry_tree_cache_t cache;
+  t8_geometry_tree_cache_init (&cache);
+
+  const t8_locidx_t num_local_trees = t8_forest_get_num_local_trees (forest);
+  for (t8_locidx_t itree = 0; itree < num_local_trees; itree++) {
+    const t8_gloidx_t gtreeid = t8_forest_global_tree_id (forest, itree);
+    for (int icorner = 0; icorner < num_corners; icorner++) {
+      const double *ref_coords = t8_element_corner_ref_coords[eclass][icorner];
+      double stateful[3], threadsafe[3];
+      double ref_coords_dim[3] = { 0 };
+      for (int idim = 0; idim < dim; idim++) {
+        ref_coords_dim[idim] = ref_coords[idim];
+      }
+      t8_geometry_evaluate (cmesh, gtreeid, ref_coords_dim, 1, stateful);
+      t8_geometry_evaluate_threadsafe (cmesh, gtreeid, ref_coords_dim, 1, threadsafe, &cache);
+      for (int idim = 0; idim < 3; idim++) {
+        EXPECT_EQ (stateful[idim], threadsafe[idim]);
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_geometry_threadsafe, geometry_threadsafe, AllEclasses, print_eclass);
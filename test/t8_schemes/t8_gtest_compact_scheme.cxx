@@ -0,0 +1,282 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element types in parallel.
+
+  Copyright (C) 2024 The University of Texas System
+  Written by Carsten Burstedde, Lucas C. Wilcox, and Tobin Isaac
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* Compare the compact quad and hex schemes to the default schemes.
+ * Each element of the compact scheme is compared to the element of the default
+ * scheme with the same level and linear id. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <test/t8_gtest_macros.hxx>
+
+class class_compact_scheme: public testing::TestWithParam<t8_eclass_t> {
+ protected:
+  void
+  SetUp () override
+  {
+    eclass = GetParam ();
+
+    default_scheme = t8_scheme_new_default_cxx ();
+    compact_scheme = t8_scheme_new_compact_cxx ();
+    ts = default_scheme->eclass_schemes[eclass];
+    cs = compact_scheme->eclass_schemes[eclass];
+    face_ts = default_scheme->eclass_schemes[eclass == T8_ECLASS_QUAD ? T8_ECLASS_LINE : T8_ECLASS_QUAD];
+    face_cs = compact_scheme->eclass_schemes[eclass == T8_ECLASS_QUAD ? T8_ECLASS_LINE : T8_ECLASS_QUAD];
+
+    ts->t8_element_new (4, default_elems);
+    cs->t8_element_new (4, compact_elems);
+    ts->t8_element_new (T8_ECLASS_MAX_CORNERS, default_children);
+    cs->t8_element_new (T8_ECLASS_MAX_CORNERS, compact_children);
+    face_ts->t8_element_new (1, &default_face);
+    face_cs->t8_element_new (1, &compact_face);
+  }
+  void
+  TearDown () override
+  {
+    ts->t8_element_destroy (4, default_elems);
+    cs->t8_element_destroy (4, compact_elems);
+    ts->t8_element_destroy (T8_ECLASS_MAX_CORNERS, default_children);
+    cs->t8_element_destroy (T8_ECLASS_MAX_CORNERS, compact_children);
+    face_ts->t8_element_destroy (1, &default_face);
+    face_cs->t8_element_destroy (1, &compact_face);
+    t8_scheme_cxx_unref (&default_scheme);
+    t8_scheme_cxx_unref (&compact_scheme);
+  }
+
+  /* Check that an element of the default scheme and of the compact scheme are the same. */
+  void
+  expect_same (const t8_element_t *default_elem, const t8_element_t *compact_elem)
+  {
+    const int level = ts->t8_element_level (default_elem);
+    ASSERT_EQ (level, cs->t8_element_level (compact_elem));
+    EXPECT_EQ (ts->t8_element_get_linear_id (default_elem, level), cs->t8_element_get_linear_id (compact_elem, level));
+  }
+
+  /* Compare all operations of the two schemes on the element with the given level and linear id. */
+  void
+  compare_element (const int level, const t8_linearidx_t id);
+
+  t8_eclass_t eclass;
+  t8_scheme_cxx *default_scheme;
+  t8_scheme_cxx *compact_scheme;
+  t8_eclass_scheme_c *ts;
+  t8_eclass_scheme_c *cs;
+  t8_eclass_scheme_c *face_ts;
+  t8_eclass_scheme_c *face_cs;
+  t8_element_t *default_elems[4];
+  t8_element_t *compact_elems[4];
+  t8_element_t *default_children[T8_ECLASS_MAX_CORNERS];
+  t8_element_t *compact_children[T8_ECLASS_MAX_CORNERS];
+  t8_element_t *default_face;
+  t8_element_t *compact_face;
+};
+
+void
+class_compact_scheme::compare_element (const int level, const t8_linearidx_t id)
+{
+  t8_element_t *delem = default_elems[0], *celem = compact_elems[0];
+  t8_element_t *daux = default_elems[1], *caux = compact_elems[1];
+  const int maxlevel = ts->t8_element_maxlevel ();
+
+  ts->t8_element_set_linear_id (delem, level, id);
+  cs->t8_element_set_linear_id (celem, level, id);
+  expect_same (delem, celem);
+  EXPECT_EQ (ts->t8_element_get_linear_id (delem, maxlevel), cs->t8_element_get_linear_id (celem, maxlevel));
+  EXPECT_EQ (ts->t8_element_child_id (delem), cs->t8_element_child_id (celem));
+  for (int ilevel = 0; ilevel <= level; ilevel++) {
+    EXPECT_EQ (ts->t8_element_ancestor_id (delem, ilevel), cs->t8_element_ancestor_id (celem, ilevel));
+  }
+
+  /* Anchor and vertex coordinates */
+  int danchor[3], canchor[3];
+  ts->t8_element_anchor (delem, danchor);
+  cs->t8_element_anchor (celem, canchor);
+  for (int idim = 0; idim < 3; idim++) {
+    EXPECT_EQ (danchor[idim], canchor[idim]);
+  }
+  for (int ivertex = 0; ivertex < ts->t8_element_num_corners (delem); ivertex++) {
+    double dcoords[3] = { 0 }, ccoords[3] = { 0 };
+    ts->t8_element_vertex_reference_coords (delem, ivertex, dcoords);
+    cs->t8_element_vertex_reference_coords (celem, ivertex, ccoords);
+    for (int idim = 0; idim < 3; idim++) {
+      EXPECT_EQ (dcoords[idim], ccoords[idim]);
+    }
+  }
+
+  /* Parent, siblings and family */
+  if (level > 0) {
+    ts->t8_element_parent (delem, daux);
+    cs->t8_element_parent (celem, caux);
+    expect_same (daux, caux);
+    for (int isib = 0; isib < ts->t8_element_num_children (daux); isib++) {
+      ts->t8_element_sibling (delem, isib, default_children[isib]);
+      cs->t8_element_sibling (celem, isib, compact_children[isib]);
+      expect_same (default_children[isib], compact_children[isib]);
+    }
+    EXPECT_TRUE (cs->t8_element_is_family (compact_children));
+  }
+
+  /* Children */
+  if (level < maxlevel) {
+    const int num_children = ts->t8_element_num_children (delem);
+    ASSERT_EQ (num_children, cs->t8_element_num_children (celem));
+    ts->t8_element_children (delem, num_children, default_children);
+    cs->t8_element_children (celem, num_children, compact_children);
+    for (int ichild = 0; ichild < num_children; ichild++) {
+      expect_same (default_children[ichild], compact_children[ichild]);
+      cs->t8_element_child (celem, ichild, caux);
+      EXPECT_TRUE (cs->t8_element_equal (caux, compact_children[ichild]));
+      EXPECT_LT (cs->t8_element_compare (celem, caux), 0);
+    }
+    EXPECT_TRUE (cs->t8_element_is_family (compact_children));
+  }
+
+  /* Descendants and successor */
+  const int desc_level = SC_MIN (maxlevel, level + 3);
+  ts->t8_element_first_descendant (delem, daux, desc_level);
+  cs->t8_element_first_descendant (celem, caux, desc_level);
+  expect_same (daux, caux);
+  ts->t8_element_last_descendant (delem, daux, desc_level);
+  cs->t8_element_last_descendant (celem, caux, desc_level);
+  expect_same (daux, caux);
+  ts->t8_element_nca (delem, daux, default_elems[2]);
+  cs->t8_element_nca (celem, caux, compact_elems[2]);
+  expect_same (default_elems[2], compact_elems[2]);
+  if (level > 0 && id + 1 < (((t8_linearidx_t) 1) << (t8_eclass_to_dimension[eclass] * level))) {
+    ts->t8_element_successor (delem, daux);
+    cs->t8_element_successor (celem, caux);
+    expect_same (daux, caux);
+    EXPECT_LT (cs->t8_element_compare (celem, caux), 0);
+    ts->t8_element_nca (delem, daux, default_elems[2]);
+    cs->t8_element_nca (celem, caux, compact_elems[2]);
+    expect_same (default_elems[2], compact_elems[2]);
+  }
+
+  /* Faces */
+  for (int iface = 0; iface < ts->t8_element_num_faces (delem); iface++) {
+    const int num_face_children = ts->t8_element_num_face_children (delem, iface);
+    int dindices[T8_ECLASS_MAX_CORNERS], cindices[T8_ECLASS_MAX_CORNERS];
+    int dneigh_face, cneigh_face;
+
+    EXPECT_EQ (ts->t8_element_face_parent_face (delem, iface), cs->t8_element_face_parent_face (celem, iface));
+    EXPECT_EQ (ts->t8_element_is_root_boundary (delem, iface), cs->t8_element_is_root_boundary (celem, iface));
+    const int dinside = ts->t8_element_face_neighbor_inside (delem, daux, iface, &dneigh_face);
+    const int cinside = cs->t8_element_face_neighbor_inside (celem, caux, iface, &cneigh_face);
+    EXPECT_EQ (dinside, cinside);
+    EXPECT_EQ (dneigh_face, cneigh_face);
+    if (dinside) {
+      expect_same (daux, caux);
+    }
+    ts->t8_element_first_descendant_face (delem, iface, daux, desc_level);
+    cs->t8_element_first_descendant_face (celem, iface, caux, desc_level);
+    expect_same (daux, caux);
+    ts->t8_element_last_descendant_face (delem, iface, daux, desc_level);
+    cs->t8_element_last_descendant_face (celem, iface, caux, desc_level);
+    expect_same (daux, caux);
+    if (level < maxlevel) {
+      ASSERT_EQ (num_face_children, cs->t8_element_num_face_children (celem, iface));
+      ts->t8_element_children_at_face (delem, iface, default_children, num_face_children, dindices);
+      cs->t8_element_children_at_face (celem, iface, compact_children, num_face_children, cindices);
+      for (int ichild = 0; ichild < num_face_children; ichild++) {
+        expect_same (default_children[ichild], compact_children[ichild]);
+        EXPECT_EQ (dindices[ichild], cindices[ichild]);
+      }
+    }
+    if (ts->t8_element_is_root_boundary (delem, iface)) {
+      /* The boundary face and its extrusion */
+      const int tree_face = ts->t8_element_tree_face (delem, iface);
+      ts->t8_element_boundary_face (delem, iface, default_face, face_ts);
+      cs->t8_element_boundary_face (celem, iface, compact_face, face_cs);
+      const int face_level = face_ts->t8_element_level (default_face);
+      ASSERT_EQ (face_level, face_cs->t8_element_level (compact_face));
+      EXPECT_EQ (face_ts->t8_element_get_linear_id (default_face, face_level),
+                 face_cs->t8_element_get_linear_id (compact_face, face_level));
+      ts->t8_element_extrude_face (default_face, face_ts, daux, tree_face);
+      cs->t8_element_extrude_face (compact_face, face_cs, caux, tree_face);
+      expect_same (daux, caux);
+      /* The extruded boundary face is the element itself. */
+      EXPECT_TRUE (cs->t8_element_equal (caux, celem));
+    }
+  }
+}
+
+TEST_P (class_compact_scheme, element_size)
+{
+  EXPECT_EQ (cs->t8_element_size (), sizeof (t8_linearidx_t));
+  EXPECT_LT (cs->t8_element_size (), ts->t8_element_size ());
+  EXPECT_EQ (ts->t8_element_maxlevel (), cs->t8_element_maxlevel ());
+}
+
+/* Compare all elements of the first levels. */
+TEST_P (class_compact_scheme, compare_uniform)
+{
+#ifdef T8_ENABLE_LESS_TESTS
+  const int maxlvl = 2;
+#else
+  const int maxlvl = 3;
+#endif
+  for (int level = 0; level <= maxlvl; level++) {
+    const t8_linearidx_t num_elements = ((t8_linearidx_t) 1) << (t8_eclass_to_dimension[eclass] * level);
+    for (t8_linearidx_t id = 0; id < num_elements; id++) {
+      compare_element (level, id);
+    }
+  }
+}
+
+/* Compare elements of the finest levels with pseudo-random linear ids. */
+TEST_P (class_compact_scheme, compare_deep)
+{
+  const int maxlevel = ts->t8_element_maxlevel ();
+  t8_linearidx_t seed = 1;
+
+  for (int level = maxlevel - 3; level <= maxlevel; level++) {
+    const t8_linearidx_t num_elements = ((t8_linearidx_t) 1) << (t8_eclass_to_dimension[eclass] * level);
+    for (int isample = 0; isample < 100; isample++) {
+      /* A linear congruential generator suffices to sample the linear ids. */
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      const t8_linearidx_t id = isample == 0 ? 0 : isample == 1 ? num_elements - 1 : (seed >> 5) % num_elements;
+      compare_element (level, id);
+    }
+  }
+}
+
+TEST_P (class_compact_scheme, pack_unpack)
+{
+  int pack_size, position = 0;
+
+  cs->t8_element_set_linear_id (compact_elems[0], cs->t8_element_maxlevel (), 42);
+  cs->t8_element_set_linear_id (compact_elems[1], 3, 5);
+  cs->t8_element_MPI_Pack_size (2, sc_MPI_COMM_WORLD, &pack_size);
+  char *buffer = T8_ALLOC (char, pack_size);
+  cs->t8_element_MPI_Pack (compact_elems, 2, buffer, pack_size, &position, sc_MPI_COMM_WORLD);
+  EXPECT_EQ (position, pack_size);
+  position = 0;
+  cs->t8_element_MPI_Unpack (buffer, pack_size, &position, compact_elems + 2, 2, sc_MPI_COMM_WORLD);
+  EXPECT_TRUE (cs->t8_element_equal (compact_elems[0], compact_elems[2]));
+  EXPECT_TRUE (cs->t8_element_equal (compact_elems[1], compact_elems[3]));
+  T8_FREE (buffer);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_compact_scheme, class_compact_scheme,
+                          testing::Values (T8_ECLASS_QUAD, T8_ECLASS_HEX), print_eclass);
@@ -267,7 +267,7 @@ t8_write_vtu (t8_forest_t forest, struct t8_step7_adapt_data *data, const char *
   int write_element_id = 1;
   int write_ghosts = 0;
   t8_forest_write_vtk_ext (forest, prefix, write_treeid, write_mpirank, write_level, write_element_id, write_ghosts, 0,
-                           0, num_data, &vtk_data);
+                           0, 0, num_data, &vtk_data);
   T8_FREE (element_data);
 }
 